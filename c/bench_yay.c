@@ -0,0 +1,348 @@
+/*
+ * YAY Parser Benchmark Harness
+ *
+ * Runs yay_parse, yay_to_string, and yay_equal over every fixture in
+ * test/yay/ plus synthetic scaling documents, reporting throughput and
+ * allocations per parse so regressions are visible per construct.
+ *
+ * Build with `make bench`. Allocation counts rely on the linker wrapping
+ * malloc/calloc/realloc (-Wl,--wrap=...), which the Makefile sets up.
+ *
+ * Usage: ./bench_yay [corpus-dir]   (default ../test/yay)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "yay.h"
+
+/* ============================================================================
+ * Allocation Counting
+ * ============================================================================ */
+
+static size_t alloc_count;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    alloc_count++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    alloc_count++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    alloc_count++;
+    return __real_realloc(ptr, size);
+}
+
+/* ============================================================================
+ * Timing
+ * ============================================================================ */
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Minimum wall time per measurement; short fixtures just iterate more */
+#define BENCH_SECONDS 0.05
+
+/* ============================================================================
+ * Per-Document Benchmark
+ * ============================================================================ */
+
+static bool bench_one(const char *name, const char *source, size_t length) {
+    yay_result_t first = yay_parse(source, length, name);
+    if (first.error) {
+        printf("%-44s SKIP (%s)\n", name, yay_error_message(first.error));
+        yay_result_free(&first);
+        return false;
+    }
+
+    /* Allocations for a single parse */
+    yay_result_free(&first);
+    size_t allocs_before = alloc_count;
+    first = yay_parse(source, length, name);
+    size_t allocs = alloc_count - allocs_before;
+
+    /* yay_parse throughput over the source bytes */
+    size_t iterations = 0;
+    double start = now();
+    double elapsed;
+    do {
+        yay_result_t result = yay_parse(source, length, name);
+        yay_result_free(&result);
+        iterations++;
+        elapsed = now() - start;
+    } while (elapsed < BENCH_SECONDS);
+    double parse_mbs = (double)length * (double)iterations / elapsed / 1e6;
+
+    /* yay_to_string throughput over the encoded bytes */
+    char *encoded = yay_to_string(first.value);
+    size_t encoded_length = encoded ? strlen(encoded) : 0;
+    iterations = 0;
+    start = now();
+    do {
+        char *str = yay_to_string(first.value);
+        free(str);
+        iterations++;
+        elapsed = now() - start;
+    } while (elapsed < BENCH_SECONDS);
+    double encode_mbs =
+        (double)encoded_length * (double)iterations / elapsed / 1e6;
+    free(encoded);
+
+    /* yay_equal against an independently parsed copy */
+    yay_result_t second = yay_parse(source, length, name);
+    iterations = 0;
+    start = now();
+    do {
+        if (!yay_equal(first.value, second.value)) {
+            printf("%-44s SKIP (equal disagrees with itself)\n", name);
+            yay_result_free(&first);
+            yay_result_free(&second);
+            return false;
+        }
+        iterations++;
+        elapsed = now() - start;
+    } while (elapsed < BENCH_SECONDS);
+    double equal_us = elapsed / (double)iterations * 1e6;
+
+    printf("%-44s parse %8.1f MB/s  encode %8.1f MB/s  "
+           "equal %9.2f us  allocs %7zu\n",
+           name, parse_mbs, encode_mbs, equal_us, allocs);
+
+    yay_result_free(&first);
+    yay_result_free(&second);
+    return true;
+}
+
+/* ============================================================================
+ * Fixture Corpus
+ * ============================================================================ */
+
+static int compare_names(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+static void bench_corpus(const char *dir_path) {
+    DIR *dir = opendir(dir_path);
+    if (!dir) {
+        fprintf(stderr, "cannot open corpus directory %s\n", dir_path);
+        return;
+    }
+
+    char **names = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        size_t name_length = strlen(entry->d_name);
+        if (name_length < 4 ||
+            strcmp(entry->d_name + name_length - 4, ".yay") != 0) {
+            continue;
+        }
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 128;
+            names = realloc(names, capacity * sizeof(*names));
+        }
+        names[count] = malloc(name_length + 1);
+        memcpy(names[count], entry->d_name, name_length + 1);
+        count++;
+    }
+    closedir(dir);
+    qsort(names, count, sizeof(*names), compare_names);
+
+    for (size_t i = 0; i < count; i++) {
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/%s", dir_path, names[i]);
+        FILE *file = fopen(path, "rb");
+        if (!file) {
+            free(names[i]);
+            continue;
+        }
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        char *source = malloc((size_t)size + 1);
+        size_t got = fread(source, 1, (size_t)size, file);
+        source[got] = '\0';
+        fclose(file);
+
+        bench_one(names[i], source, got);
+
+        free(source);
+        free(names[i]);
+    }
+    free(names);
+}
+
+/* ============================================================================
+ * Synthetic Scaling Documents
+ * ============================================================================ */
+
+static void bench_synthetic(const char *name, char *source) {
+    bench_one(name, source, strlen(source));
+    free(source);
+}
+
+/* 100,000 short properties in one flat object */
+static char *make_wide_object(void) {
+    yay_writer_t doc;
+    yay_writer_init(&doc);
+    char line[64];
+    for (int i = 0; i < 100000; i++) {
+        int n = snprintf(line, sizeof(line), "key%06d: %d\n", i, i);
+        yay_writer_write(&doc, line, (size_t)n);
+    }
+    return yay_writer_take(&doc);
+}
+
+/* 1,000 levels of nested inline arrays */
+static char *make_deep_nesting(void) {
+    enum { DEPTH = 1000 };
+    char *source = malloc(2 * DEPTH + 2);
+    memset(source, '[', DEPTH);
+    source[DEPTH] = '1';
+    memset(source + DEPTH + 1, ']', DEPTH);
+    source[2 * DEPTH + 1] = '\0';
+    return source;
+}
+
+/* A single one-megabyte byte block */
+static char *make_huge_bytes(void) {
+    enum { BYTES = 1 << 20 };
+    yay_writer_t doc;
+    yay_writer_init(&doc);
+    yay_writer_write(&doc, "blob: <", 7);
+    char hex[16];
+    for (int i = 0; i < BYTES; i++) {
+        snprintf(hex, sizeof(hex), "%02x", i & 0xff);
+        yay_writer_write(&doc, hex, 2);
+    }
+    yay_writer_write(&doc, ">\n", 2);
+    return yay_writer_take(&doc);
+}
+
+/* 100,000 floats in a multiline array */
+static char *make_float_array(void) {
+    yay_writer_t doc;
+    yay_writer_init(&doc);
+    char line[64];
+    for (int i = 0; i < 100000; i++) {
+        int n = snprintf(line, sizeof(line), "- %.9f\n", (double)i * 1.25e-3);
+        yay_writer_write(&doc, line, (size_t)n);
+    }
+    return yay_writer_take(&doc);
+}
+
+/* ============================================================================
+ * Cross-Implementation Throughput Mode
+ * ============================================================================ */
+
+/*
+ * Parse the whole corpus `reps` times and print one machine-readable
+ * line, "<bytes> <seconds>", for scripts/bench.sh to turn into a MB/s
+ * and peak-RSS table comparable across the language ports.
+ */
+static int run_throughput(const char *dir_path, long reps) {
+    DIR *dir = opendir(dir_path);
+    if (!dir) {
+        fprintf(stderr, "cannot open corpus directory %s\n", dir_path);
+        return 1;
+    }
+
+    char **sources = NULL;
+    size_t *lengths = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+    size_t total_bytes = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        size_t name_length = strlen(entry->d_name);
+        if (name_length < 4 ||
+            strcmp(entry->d_name + name_length - 4, ".yay") != 0) {
+            continue;
+        }
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/%s", dir_path, entry->d_name);
+        FILE *file = fopen(path, "rb");
+        if (!file) {
+            continue;
+        }
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        char *source = malloc((size_t)size + 1);
+        size_t got = fread(source, 1, (size_t)size, file);
+        source[got] = '\0';
+        fclose(file);
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 128;
+            sources = realloc(sources, capacity * sizeof(*sources));
+            lengths = realloc(lengths, capacity * sizeof(*lengths));
+        }
+        sources[count] = source;
+        lengths[count] = got;
+        total_bytes += got;
+        count++;
+    }
+    closedir(dir);
+
+    double start = now();
+    for (long rep = 0; rep < reps; rep++) {
+        for (size_t i = 0; i < count; i++) {
+            yay_result_t result = yay_parse(sources[i], lengths[i], NULL);
+            yay_result_free(&result);
+        }
+    }
+    double elapsed = now() - start;
+
+    printf("%zu %.6f\n", total_bytes * (size_t)reps, elapsed);
+
+    for (size_t i = 0; i < count; i++) {
+        free(sources[i]);
+    }
+    free(sources);
+    free(lengths);
+    return 0;
+}
+
+/* ============================================================================
+ * Main
+ * ============================================================================ */
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "--throughput") == 0) {
+        const char *dir = argc > 2 ? argv[2] : "../test/yay";
+        long reps = argc > 3 ? strtol(argv[3], NULL, 10) : 100;
+        return run_throughput(dir, reps);
+    }
+
+    const char *corpus = argc > 1 ? argv[1] : "../test/yay";
+
+    printf("\n--- Fixture Corpus (%s) ---\n\n", corpus);
+    bench_corpus(corpus);
+
+    printf("\n--- Synthetic Scaling Documents ---\n\n");
+    bench_synthetic("synthetic-wide-object-100k", make_wide_object());
+    bench_synthetic("synthetic-deep-nesting-1k", make_deep_nesting());
+    bench_synthetic("synthetic-huge-bytes-1mb", make_huge_bytes());
+    bench_synthetic("synthetic-float-array-100k", make_float_array());
+
+    printf("\n");
+    return 0;
+}
@@ -898,4 +898,196 @@ static error_fixture_t error_fixtures[] = {
 
 #define ERROR_FIXTURE_COUNT 91
 
+typedef struct {
+    const char *name;
+    const char *original_name;
+    const char *meh_source;
+    const char *expected;
+} meh_fixture_t;
+
+static meh_fixture_t meh_fixtures[] = {
+    {"blank_lines_multiple", "blank-lines.multiple.meh", "section1:\n  a: 1\n\n\n\nsection2:\n  b: 2\n", "section1:\n  a: 1\n\nsection2:\n  b: 2\n"},
+    {"block_bytes_leader_next_line_leader_next_line", "block-bytes-leader-next-line.leader-next-line.meh", "i:\n  >\n    cafe\n    babe\n", "i: >\n  ca fe\n  ba be\n"},
+    {"block_bytes_basic", "block-bytes.basic.meh", "data: >\n  f33df4ce\n", "data: >\n  f3 3d f4 ce\n"},
+    {"block_preserve_block", "block-preserve.block.meh", "items:\n- 1\n- 2\n- 3\n", "items:\n- 1\n- 2\n- 3\n"},
+    {"block_string_leader_next_line_leader_next_line", "block-string-leader-next-line.leader-next-line.meh", "i:\n  `\n    Should\n    not\n    be.\n", "i: `\n  Should\n  not\n  be.\n"},
+    {"block_string_basic", "block-string.basic.meh", "message: `\n  Hello\n  World\n", "message: `\n  Hello\n  World\n"},
+    {"block_to_inline_block", "block-to-inline.block.meh", "items:\n- 1\n- 2\n- 3\n", "items:\n- 1\n- 2\n- 3\n"},
+    {"bytes_balanced_unbalanced", "bytes-balanced.unbalanced.meh", "magic: >\n  ca fe ba be  # Java class file magic\n  de ad be ef\n  00 00 00 34  # Version 52.0\n", "magic: >\n  ca fe ba be  # Java class file magic\n  de ad be ef\n  00 00 00 34  # Version 52.0\n"},
+    {"bytes_comment_inline", "bytes-comment.inline.meh", "data: <cafebabe deadbeef 00112233 44556677 8899aabb ccddeeff>  # magic bytes\n", "data: <ca fe ba be  de ad be ef  00 11 22 33  44 55 66 77  88 99 aa bb  cc dd ee ff>  # magic bytes\n"},
+    {"bytes_long_inline", "bytes-long.inline.meh", "data: <cafebabe deadbeef 00112233 44556677 8899aabb ccddeeff>\n", "data: <ca fe ba be  de ad be ef  00 11 22 33  44 55 66 77  88 99 aa bb  cc dd ee ff>\n"},
+    {"bytes_long_nospaces", "bytes-long.nospaces.meh", "data: <cafebabedeadbeef00112233445566778899aabbccddeeff>\n", "data: <ca fe ba be  de ad be ef  00 11 22 33  44 55 66 77  88 99 aa bb  cc dd ee ff>\n"},
+    {"bytes_short_tight", "bytes-short.tight.meh", "data: <cafebabe>\n", "data: <ca fe ba be>\n"},
+    {"comment_alignment_unaligned", "comment-alignment.unaligned.meh", "# Header comment\nname: \"Alice\" # inline comment\nage: 30 # another comment\n", "# Header comment\nname: \"Alice\"  # inline comment\nage: 30        # another comment\n"},
+    {"comment_alignment_wide", "comment-alignment.wide.meh", "# Header comment\nname: \"Alice\"      # inline comment\nage: 30                # another comment\n", "# Header comment\nname: \"Alice\"  # inline comment\nage: 30        # another comment\n"},
+    {"comment_bullet_join_fragmented", "comment-bullet-join.fragmented.meh", "config: >\n  00 11 22 33  # - First bullet that\n               #   spans lines.\n  aa bb cc dd  # - Second bullet.\n", "config: >\n  00 11 22 33  # - First bullet that spans lines.\n  aa bb cc dd  # - Second bullet.\n"},
+    {"comment_bullet_wrap_long", "comment-bullet-wrap.long.meh", "config: >\n  00 11 22 33  # - This is a bullet item that is quite long and should wrap with a hanging indent on continuation.\n  aa bb cc dd  # - Short bullet.\n", "config: >\n  00 11 22 33  # - This is a bullet item that is quite long and should wrap with\n               #   a hanging indent on continuation.\n  aa bb cc dd  # - Short bullet.\n"},
+    {"comment_honorific_at_boundary_long", "comment-honorific-at-boundary.long.meh", "config: >\n  00 11 22 33  # For additional information about this matter, please contact Mr. Smith directly.\n", "config: >\n  00 11 22 33  # For additional information about this matter, please contact\n               # Mr. Smith directly.\n"},
+    {"comment_initialism_no_break_long", "comment-initialism-no-break.long.meh", "config: >\n  00 11 22 33  # The NASA and ESA programs collaborated on the ISS project successfully.\n", "config: >\n  00 11 22 33  # The NASA and ESA programs collaborated on the ISS project\n               # successfully.\n"},
+    {"comment_join_honorific_fragmented", "comment-join-honorific.fragmented.meh", "config: >\n  00 11 22 33  # Please contact Mr. Smith for more details.\n  aa bb cc dd  # Done.\n", "config: >\n  00 11 22 33  # Please contact Mr. Smith for more details.\n  aa bb cc dd  # Done.\n"},
+    {"comment_join_remove_empty_fragmented", "comment-join-remove-empty.fragmented.meh", "config: >\n  00 11 22 33  # This comment spans\n               # multiple lines and the\n               # continuation lines have no data.\n  aa bb cc dd  # Next item.\n", "config: >\n  00 11 22 33  # This comment spans multiple lines and the continuation lines\n               # have no data.\n  aa bb cc dd  # Next item.\n"},
+    {"comment_join_sentences_fragmented", "comment-join-sentences.fragmented.meh", "config: >\n  00 11 22 33  # This is the first\n               # sentence that continues.\n  aa bb cc dd  # Second sentence here.\n", "config: >\n  00 11 22 33  # This is the first sentence that continues.\n  aa bb cc dd  # Second sentence here.\n"},
+    {"comment_no_join_after_period_fragmented", "comment-no-join-after-period.fragmented.meh", "config: >\n  00 11 22 33  # First sentence ends here.\n               # Second sentence is separate.\n  aa bb cc dd  # Third.\n", "config: >\n  00 11 22 33  # First sentence ends here.\n               # Second sentence is separate.\n  aa bb cc dd  # Third.\n"},
+    {"comment_no_join_sentence_end_fragmented", "comment-no-join-sentence-end.fragmented.meh", "config: >\n  00 11 22 33  # Contact Smith.\n               # he knows the details.\n  aa bb cc dd  # Done.\n", "config: >\n  00 11 22 33  # Contact Smith.\n               # he knows the details.\n  aa bb cc dd  # Done.\n"},
+    {"comment_prose_capital_reflowed", "comment-prose-capital.reflowed.meh", "data: >\n  aa bb cc dd  # First line of comment. Second line starts with Capital.\n  ee ff 00 11  # Third line here.\n", "data: >\n  aa bb cc dd  # First line of comment. Second line starts with Capital.\n  ee ff 00 11  # Third line here.\n"},
+    {"comment_prose_honorific_split", "comment-prose-honorific.split.meh", "config: >\n  # Note that Rickman appeared over the 80th column.\n  00 11 22 33  # Please, if possible, expediently contact the honourable Mr. Rickman for details.\n", "config: >\n  # Note that Rickman appeared over the 80th column.\n  00 11 22 33  # Please, if possible, expediently contact the honourable\n               # Mr. Rickman for details.\n"},
+    {"comment_prose_sentence_joined", "comment-prose-sentence.joined.meh", "data: >\n  ca fe ba be  # First sentence ends here. Second sentence starts fresh.\n  de ad be ef  # More data follows.\n", "data: >\n  ca fe ba be  # First sentence ends here. Second sentence starts fresh.\n  de ad be ef  # More data follows.\n"},
+    {"comment_prose_wrap_long", "comment-prose-wrap.long.meh", "data: >\n  ca fe ba be  # This is a short comment\n  de ad be ef  # Another comment here that is very long and should wrap to the next line properly\n", "data: >\n  ca fe ba be  # This is a short comment\n  de ad be ef  # Another comment here that is very long and should wrap to the\n               # next line properly\n"},
+    {"comment_rewrap_long_joined", "comment-rewrap-long.joined.meh", "config: >\n  00 11 22 33  # This is a very long comment that was previously on one line and needs to be wrapped to fit within the column limit properly.\n  aa bb cc dd  # Short.\n", "config: >\n  00 11 22 33  # This is a very long comment that was previously on one line and\n               # needs to be wrapped to fit within the column limit properly.\n  aa bb cc dd  # Short.\n"},
+    {"comment_sentence_break_long", "comment-sentence-break.long.meh", "config: >\n  00 11 22 33  # First sentence here. The NASA program achieved great success in space exploration.\n", "config: >\n  00 11 22 33  # First sentence here.\n               # The NASA program achieved great success in space exploration.\n"},
+    {"inline_keywords_basic", "inline-keywords.basic.meh", "[null, true, false]\n", "[null, true, false]\n"},
+    {"inline_to_block_long_inline", "inline-to-block-long.inline.meh", "items: [\"alpha\", \"beta\", \"gamma\", \"delta\", \"epsilon\", \"zeta\", \"eta\", \"theta\", \"iota\", \"kappa\"]\n", "items:\n- \"alpha\"\n- \"beta\"\n- \"gamma\"\n- \"delta\"\n- \"epsilon\"\n- \"zeta\"\n- \"eta\"\n- \"theta\"\n- \"iota\"\n- \"kappa\"\n"},
+    {"inline_to_block_inline", "inline-to-block.inline.meh", "items: [\"alpha\", \"beta\", \"gamma\", \"delta\", \"epsilon\"]\n", "items: [\"alpha\", \"beta\", \"gamma\", \"delta\", \"epsilon\"]\n"},
+    {"nested_inline_to_block_inline", "nested-inline-to-block.inline.meh", "outer:\n  items: [\"alpha\", \"beta\", \"gamma\", \"delta\", \"epsilon\", \"zeta\", \"eta\", \"theta\", \"iota\", \"kappa\"]\n", "outer:\n  items:\n  - \"alpha\"\n  - \"beta\"\n  - \"gamma\"\n  - \"delta\"\n  - \"epsilon\"\n  - \"zeta\"\n  - \"eta\"\n  - \"theta\"\n  - \"iota\"\n  - \"kappa\"\n"},
+    {"nested_object_inline_to_block_inline", "nested-object-inline-to-block.inline.meh", "outer:\n  config: {name: \"Alice\", age: 30, city: \"New York\", country: \"USA\", occupation: \"Engineer\"}\n", "outer:\n  config:\n    name: \"Alice\"\n    age: 30\n    city: \"New York\"\n    country: \"USA\"\n    occupation: \"Engineer\"\n"},
+    {"number_spacing_tight_extra", "number-spacing-tight.extra.meh", "big: 1000000\n", "big: 1000000\n"},
+    {"number_spacing_wide_extra", "number-spacing-wide.extra.meh", "big: 1  000   000\n", "big: 1 000 000\n"},
+    {"object_inline_short_inline", "object-inline-short.inline.meh", "config: {name: \"Alice\", age: 30}\n", "config: {name: \"Alice\", age: 30}\n"},
+    {"object_inline_to_block_long_inline", "object-inline-to-block-long.inline.meh", "config: {name: \"Alice\", age: 30, city: \"New York\", country: \"USA\", occupation: \"Engineer\"}\n", "config:\n  name: \"Alice\"\n  age: 30\n  city: \"New York\"\n  country: \"USA\"\n  occupation: \"Engineer\"\n"},
+    {"space_after_comma_extra", "space-after-comma.extra.meh", "items: [1,  2,  3]\n", "items: [1, 2, 3]\n"},
+    {"space_after_open_angle_extra", "space-after-open-angle.extra.meh", "data: < ca fe>\n", "data: <ca fe>\n"},
+    {"space_after_open_brace_extra", "space-after-open-brace.extra.meh", "obj: { a: 1, b: 2}\n", "obj: {a: 1, b: 2}\n"},
+    {"space_after_open_bracket_extra", "space-after-open-bracket.extra.meh", "items: [ 1, 2, 3]\n", "items: [1, 2, 3]\n"},
+    {"space_around_colon_extra", "space-around-colon.extra.meh", "obj: {a : 1, b :  2}\n", "obj: {a: 1, b: 2}\n"},
+    {"space_before_close_angle_extra", "space-before-close-angle.extra.meh", "data: <ca fe >\n", "data: <ca fe>\n"},
+    {"space_before_close_brace_extra", "space-before-close-brace.extra.meh", "obj: {a: 1, b: 2 }\n", "obj: {a: 1, b: 2}\n"},
+    {"space_before_close_bracket_extra", "space-before-close-bracket.extra.meh", "items: [1, 2, 3 ]\n", "items: [1, 2, 3]\n"},
+    {"space_before_comma_extra", "space-before-comma.extra.meh", "items: [1 , 2 , 3]\n", "items: [1, 2, 3]\n"},
+    {"trailing_space_array_extra", "trailing-space-array.extra.meh", "items:\n- \"foo\" \n- \"bar\"\n", "items:\n- \"foo\"\n- \"bar\"\n"},
+    {"trailing_space_multiple", "trailing-space.multiple.meh", "name: \"Alice\"\nage: 30   \n", "name: \"Alice\"\nage: 30\n"},
+    {"trailing_space_value", "trailing-space.value.meh", "name: \"Alice\" \nage: 30\n", "name: \"Alice\"\nage: 30\n"},
+    {"uppercase_exponent_uppercase", "uppercase-exponent.uppercase.meh", "1.5E10\n", "1.5e10\n"},
+    {"uppercase_hex_uppercase", "uppercase-hex.uppercase.meh", "<DEADBEEF>\n", "<de ad be ef>\n"},
+    {NULL, NULL, NULL, NULL}
+};
+
+#define MEH_FIXTURE_COUNT 52
+
+typedef struct {
+    const char *name;
+    const char *yay_source;
+    const char *category;
+} bench_fixture_t;
+
+static bench_fixture_t bench_fixtures[] = {
+    {"array_inline_apostrophe", "[\"I'm getting better!\", \"No you're not.\", \"I feel happy!\"]\n", "string"},
+    {"array_inline_bytearray", "[<b0b5>, <cafe>]\n", "bytes"},
+    {"array_inline_doublequote_escapes", "[\"say \\\"hi\\\"\", \"x\"]\n", "string"},
+    {"array_inline_doublequote", "[\"And there was much rejoicing.\", \"yay.\"]\n", "string"},
+    {"array_inline_integers", "[42, 404, 418]\n", "number"},
+    {"array_inline_nested", "[[\"I feel happy!\", \"yay.\"], [\"And there was much rejoicing.\", \"yay.\"]]\n", "nesting"},
+    {"array_inline_singlequote", "['a', 'b']\n", "string"},
+    {"array_multiline_named", "complaints:\n- \"I didn't vote for you.\"\n- \"Help, help, I'm being repressed!\"\n", "nesting"},
+    {"array_multiline_nested_multiline_object", "- x: 10\n  y: 20\n- x: 30\n  y: 40\n", "nesting"},
+    {"array_multiline_nested", "- - \"a\"\n  - \"b\"\n- - 1\n  - 2\n", "nesting"},
+    {"array_multiline_triple_nested", "- - - 'hello'\n", "nesting"},
+    {"array_multiline", "- 5\n- 3\n", "nesting"},
+    {"at_a_glance", "roses-are-red: true      # There is no \"yes\" or \"on\".\nviolets-are-blue: false  # Violets are violet.\narrays:\n  - \"may\"\n  - \"have\"\n  - \"many\"\n  - \"values\"\nand-objects-too:\n  integers-are-distinct: 42\n  from-their-floating-friends: 6.283 185 307 179 586  # digit grouping\ninline:\n  string: \"is concise\"\n  array: [infinity, -infinity, nan]\n  object: {bigint: 1, float64: 2.0}\n  bytes: <f33d face>\nblock:\n  string: `\n    This is a string.\n    There are many like it.\n  array:\n    - \"But\"\n    - \"this\"\n    - \"one's\"\n  object:\n    mine: null\n  bytes: >\n    b0 b5  c0 ff  # Bob's Coffee\n    fe fa  ca de  # Facade.\nconcatenated:\n  \"I'm not dead yet. \"\n  \"I feel happy!\"\nunicode-code-point: \"\\u{1F600}\"  # UTF-16 surrogates are inexpressible\n\"name with spaces\": 'works too'\n", "other"},
+    {"bigint_one", "1\n", "number"},
+    {"boolean_false", "false\n", "other"},
+    {"boolean_true", "true\n", "other"},
+    {"bytearray_block_basic", "> b0b5\n  c0ff\n", "bytes"},
+    {"bytearray_block_comment_only", "> # header comment\n  b0b5 c0ff\n", "bytes"},
+    {"bytearray_block_deeply_nested", "level1:\n  level2:\n    data: >\n      b0b5 c0ff\n", "bytes"},
+    {"bytearray_block_hex_and_comment", "> b0b5 # first chunk\n  c0ff # second chunk\n", "bytes"},
+    {"bytearray_block_nested_property", "outer:\n  data: >\n    b0b5 c0ff\n    eefa cade\n", "bytes"},
+    {"bytearray_block_property_comment", "data: > # raw bytes\n  b0b5 c0ff\n", "bytes"},
+    {"bytearray_block_property", "data: >\n  b0b5 c0ff\n  eefa cade\n", "bytes"},
+    {"bytearray_in_array", "- <b0b5>\n- <cafe>\n", "bytes"},
+    {"bytearray_in_object", "a: <b0b5>\nb: <cafe>\n", "bytes"},
+    {"bytearray_inline_empty", "<>\n", "bytes"},
+    {"bytearray_inline_even", "<b0b5c0ffeefacade>\n", "bytes"},
+    {"bytearray_inline_named", "data: <b0b5c0ffeefacade>\n", "bytes"},
+    {"integer_big_basic", "42\n", "number"},
+    {"integer_big_negative", "-42\n", "number"},
+    {"integer_big", "867 5309\n", "number"},
+    {"mixed_depth_nesting_1", "root:\n  a:\n    - 1\n    - 2\n  b:\n    c:\n      - 3\n    d: 4\n", "nesting"},
+    {"mixed_depth_nesting_2", "- a:\n    b:\n      - 1\n      - 2\n  c: 3\n- - \"d\"\n  - e:\n      f: 4\n", "nesting"},
+    {"mixed_depth_nesting_3", "top:\n  list:\n    - bytes: <b0b5>\n      tag: \"x\"\n    - more:\n        inner: <0f0f>\n  solo: 1\n", "nesting"},
+    {"nesting_L0_bytes", "<b0b5>\n", "bytes"},
+    {"nesting_L0_false", "false\n", "nesting"},
+    {"nesting_L0_float", "3.14\n", "number"},
+    {"nesting_L0_int", "42\n", "nesting"},
+    {"nesting_L0_null", "null\n", "nesting"},
+    {"nesting_L0_strdq", "\"hello\"\n", "nesting"},
+    {"nesting_L0_strsq", "'world'\n", "nesting"},
+    {"nesting_L0_true", "true\n", "nesting"},
+    {"nesting_L1_arr_inline", "[42, \"hello\", <b0b5>]\n", "nesting"},
+    {"nesting_L1_arr_multi", "- 42\n- \"hello\"\n- <b0b5>\n", "nesting"},
+    {"nesting_L1_empty_arr", "[]\n", "nesting"},
+    {"nesting_L1_empty_obj", "{}\n", "nesting"},
+    {"nesting_L1_named_arr", "a:\n  - 42\n", "nesting"},
+    {"nesting_L1_obj_inline", "{a: 42, b: \"hello\"}\n", "nesting"},
+    {"nesting_L1_obj_multi", "a: 42\nb: \"hello\"\nc: <b0b5>\n", "nesting"},
+    {"nesting_L2_arr_in_arr_inline", "[[42, 42], [\"hello\", \"hello\"]]\n", "nesting"},
+    {"nesting_L2_arr_in_arr_multi", "- - 42\n  - 42\n- - \"hello\"\n  - \"hello\"\n", "nesting"},
+    {"nesting_L2_arr_in_obj_inline", "{a: [42, 42], b: [\"hello\", \"hello\"]}\n", "nesting"},
+    {"nesting_L2_arr_in_obj_multi", "items:\n  - 42\n  - \"hello\"\n", "nesting"},
+    {"nesting_L2_blockbytes_in_obj", "data: >\n  b0b5\n", "bytes"},
+    {"nesting_L2_blockstr_in_obj", "message: `\n  Hello\n", "nesting"},
+    {"nesting_L2_empty_nested", "a: {}\nb: []\n", "nesting"},
+    {"nesting_L2_obj_in_arr_multi", "- a: 42\n  b: \"hello\"\n- c: 42\n", "nesting"},
+    {"nesting_L2_obj_in_obj_inline", "{a: {x: 42}, b: {y: \"hello\"}}\n", "nesting"},
+    {"nesting_L2_obj_in_obj_multi", "a:\n  x: 42\n  y: \"hello\"\nb:\n  z: 42\n", "nesting"},
+    {"nesting_L3_arr_arr_arr_inline", "- - - 'hello'\n", "nesting"},
+    {"nesting_L3_arr_arr_arr", "- - [42, 42]\n", "nesting"},
+    {"nesting_L3_arr_arr_obj", "- - {a: 42, b: \"hello\"}\n", "nesting"},
+    {"nesting_L3_arr_obj_arr", "- data:\n    - 42\n    - 42\n- data:\n    - \"hello\"\n    - \"hello\"\n", "nesting"},
+    {"nesting_L3_arr_obj_obj", "- nested:\n    deep: 42\n", "nesting"},
+    {"nesting_L3_blockbytes_nested", "outer:\n  inner:\n    data: >\n      cafe\n", "bytes"},
+    {"nesting_L3_blockstr_nested", "outer:\n  inner:\n    text: `\n      Deep\n", "nesting"},
+    {"nesting_L3_mixed_inline_in_multi", "items:\n  - [42, 42]\n  - [\"hello\", \"hello\"]\n", "nesting"},
+    {"nesting_L3_obj_arr_arr", "matrix:\n  - - 42\n    - 42\n  - - \"hello\"\n    - \"hello\"\n", "nesting"},
+    {"nesting_L3_obj_arr_obj", "items:\n  - name: \"hello\"\n    value: 42\n  - name: \"hello\"\n    value: 42\n", "nesting"},
+    {"nesting_L3_obj_obj_arr", "outer:\n  inner:\n    - 42\n    - \"hello\"\n", "nesting"},
+    {"nesting_L3_obj_obj_obj", "a:\n  b:\n    c: 42\n    d: \"hello\"\n", "nesting"},
+    {"null_literal", "null\n", "other"},
+    {"number_float_avogadro", "6.022e23\n", "number"},
+    {"number_float_exponent", "scientific: 1.5e10\nnegative-exp: 3.14e-5\npositive-exp: 2.71e+8\nno-decimal: 6e23\nleading-dot: .5e2\n", "number"},
+    {"number_float_grouped", "6.283 185 307 179 586\n", "number"},
+    {"number_float_infinity", "infinity\n", "number"},
+    {"number_float_leading_dot", ".5\n", "number"},
+    {"number_float_nan", "nan\n", "number"},
+    {"number_float_negative_infinity", "-infinity\n", "number"},
+    {"number_float_negative_zero", "-0.0\n", "number"},
+    {"number_float_trailing_dot", "1.\n", "number"},
+    {"number_float", "6.283185307179586\n", "number"},
+    {"object_deeply_nested_empty", "level1:\n  level2:\n    level3: {}\n", "nesting"},
+    {"object_inline_doublequote_key", "\"*\": 1.0\n", "string"},
+    {"object_inline_empty", "empty: {}\n", "nesting"},
+    {"object_inline_integers", "{answer: 42, error: 404}\n", "number"},
+    {"object_inline_mixed", "{name: 'Marvin', mood: 'depressed'}\n", "nesting"},
+    {"object_inline_nested", "{luggage: {combination: 12345}, air: [\"canned\", \"Perri-Air\"]}\n", "nesting"},
+    {"object_inline_singlequote", "'*': 1.0\n", "string"},
+    {"object_multiline_doublequote_key", "\"key name\": 1\n", "string"},
+    {"object_multiline_nested", "parrot:\n  status: \"pining for the fjords\"\n  plumage: \"beautiful\"\n", "nesting"},
+    {"object_multiline_singlequote_key", "'key-name': 2\n", "string"},
+    {"object_multiline", "answer: 42\nerror: 404\n", "nesting"},
+    {"object_nested_empty_inline", "outer:\n  inner: {}\n", "nesting"},
+    {"object_nested_empty_property", "outer:\n  inner: {}\n", "nesting"},
+    {"string_block_deep_indent", "message: `\n    Line 1\n      Indented\n    Line 2\n", "string"},
+    {"string_block_deeply_nested", "level1:\n  level2:\n    text: `\n      Hello\n      World\n", "string"},
+    {"string_block_empty_middle", "`\n  I'm getting better!\n\n  No you're not.\n", "string"},
+    {"string_block_nested_in_object_and_array", "parrot:\n  condition: `\n    No, no, it's just resting!\n\n  remarks:\n  - ` Remarkable bird, the Norwegian Blue.\n      Beautiful plumage, innit?\n\n  - ` It's probably pining for the fjords.\n      Lovely plumage.\n", "string"},
+    {"string_block_property_empty_middle", "message: `\n  It's not pining!\n\n  It's passed on! This parrot is no more!\n", "string"},
+    {"string_block_property_trailing_empty", "message: `\n  By Grabthar's hammer... what a savings.\n\n\nnext: 1\n", "string"},
+    {"string_block_property", "message: `\n  By Grabthar's hammer, we live to tell the tale.\n", "string"},
+    {"string_block_root_hash", "` # this is not a comment\n  it is content\n", "string"},
+    {"string_block_root_next_line", "`\n  I've calculated your chance of survival,\n  but I don't think you'll like it.\n", "string"},
+    {"string_block_root_same_line", "` I think you ought to know I'm feeling very depressed.\n  This will all end in tears.\n", "string"},
+    {"string_block_trailing_empty", "`\n  Hello\n\n\n", "string"},
+    {"string_inline_doublequote_apostrophe", "\"I'm getting better!\"\n", "string"},
+    {"string_inline_doublequote_basic", "\"This will all end in tears.\"\n", "string"},
+    {"string_inline_doublequote_escaped_quote", "\"He said \\\"yay.\\\" and left.\"\n", "string"},
+    {"string_inline_doublequote_escapes", "\"\\\"\\\\\\/\\b\\f\\n\\r\\t\\u{263A}\"\n", "string"},
+    {"string_inline_doublequote_space", "\" \"\n", "string"},
+    {"string_inline_doublequote_unicode_emoji", "\"😀\"\n", "string"},
+    {"string_inline_doublequote_unicode_surrogate_pair", "\"\\u{1F600}\"\n", "string"},
+    {"string_inline_singlequote_basic", "'Are you suggesting coconuts migrate?'\n", "string"},
+    {"string_inline_singlequote_doublequote", "'He said \"yay.\" and left.'\n", "string"},
+    {"string_multiline_concat", "confession:\n  \"I'm not dead yet. \"\n  \"I feel happy!\"\n", "string"},
+    {"whitespace_leading_lines", "\n\n# Commentary here\n\n10\n\n\n# Comments there\n\n", "other"},
+    {NULL, NULL, NULL}
+};
+
 #endif /* FIXTURES_GEN_H */
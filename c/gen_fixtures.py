@@ -5,6 +5,7 @@ Generate C test fixtures header from fixture files.
 This script reads:
 - test/c/*.c files (C expressions using yay_* API) with matching test/yay/*.yay files
 - test/nay/*.nay files (invalid YAY) with matching test/nay/*.error files
+- test/meh/*.meh files (loose YAY) with matching test/meh/*.yay expected output
 """
 
 from pathlib import Path
@@ -104,16 +105,58 @@ def process_error_fixture(nay_path, error_path):
     }
 
 
+def process_meh_fixture(meh_path, yay_path):
+    """Process a reformat fixture pair (.meh + expected .yay)."""
+    with open(meh_path, 'r') as f:
+        meh_content = f.read()
+
+    with open(yay_path, 'r') as f:
+        yay_content = f.read()
+
+    name = meh_path.stem.replace('-', '_').replace('.', '_')
+
+    return {
+        'name': name,
+        'original_name': meh_path.name,
+        'meh_escaped': escape_c_string(meh_content),
+        'yay_escaped': escape_c_string(yay_content),
+    }
+
+
+BENCH_CATEGORIES = (
+    ('bytes', ('bytearray', 'bytes')),
+    ('number', ('integer', 'number', 'float', 'big')),
+    ('string', ('string', 'quote', 'apostrophe', 'text', 'escape')),
+    ('nesting', ('nested', 'nesting', 'array', 'object', 'outline',
+                 'multiline', 'inline', 'property')),
+)
+
+
+def categorize(name):
+    """Bucket a fixture by construct for the per-category benchmark report.
+
+    The first matching keyword in the fixture name wins, checked in a
+    fixed order so e.g. array-inline-bytearray counts as bytes, not
+    nesting.
+    """
+    for category, keywords in BENCH_CATEGORIES:
+        if any(k in name for k in keywords):
+            return category
+    return 'other'
+
+
 def main():
     script_dir = Path(__file__).parent
     test_root = script_dir.parent / 'test'
     c_dir = test_root / 'c'
     yay_dir = test_root / 'yay'
     nay_dir = test_root / 'nay'
+    meh_dir = test_root / 'meh'
     output_file = script_dir / 'fixtures_gen.h'
-    
+
     valid_fixtures = []
     error_fixtures = []
+    meh_fixtures = []
     
     # Process all .c files that have matching .yay files
     for c_file in sorted(c_dir.glob('*.c')):
@@ -148,7 +191,28 @@ def main():
                 print(f'SKIP: {nay_file.name} (empty)')
         except Exception as e:
             print(f'ERROR: {nay_file.name}: {e}')
-    
+
+    # Process all .meh files whose <test-name>.<variant>.meh stem has a
+    # matching <test-name>.yay expectation
+    for meh_file in sorted(meh_dir.glob('*.meh')):
+        stem = meh_file.stem
+        dot_idx = stem.rfind('.')
+        if dot_idx < 0:
+            print(f'SKIP: {meh_file.name} (no variant suffix)')
+            continue
+        expected_file = meh_dir / f'{stem[:dot_idx]}.yay'
+        if not expected_file.exists():
+            print(f'SKIP: {meh_file.name} (no .yay file)')
+            continue
+
+        try:
+            fixture = process_meh_fixture(meh_file, expected_file)
+            if fixture:
+                meh_fixtures.append(fixture)
+                print(f'OK: {meh_file.name}')
+        except Exception as e:
+            print(f'ERROR: {meh_file.name}: {e}')
+
     # Generate C header
     with open(output_file, 'w') as f:
         f.write('/*\n')
@@ -198,10 +262,44 @@ def main():
         f.write('};\n\n')
         
         f.write(f'#define ERROR_FIXTURE_COUNT {len(error_fixtures)}\n\n')
+
+        # Reformat fixture type
+        f.write('typedef struct {\n')
+        f.write('    const char *name;\n')
+        f.write('    const char *original_name;\n')
+        f.write('    const char *meh_source;\n')
+        f.write('    const char *expected;\n')
+        f.write('} meh_fixture_t;\n\n')
+
+        # Generate reformat fixture array
+        f.write('static meh_fixture_t meh_fixtures[] = {\n')
+        for fix in meh_fixtures:
+            f.write(f'    {{"{fix["name"]}", "{fix["original_name"]}", "{fix["meh_escaped"]}", "{fix["yay_escaped"]}"}},\n')
+        f.write('    {NULL, NULL, NULL, NULL}\n')
+        f.write('};\n\n')
+
+        f.write(f'#define MEH_FIXTURE_COUNT {len(meh_fixtures)}\n\n')
+
+
+        # Benchmark table: every valid fixture again, tagged by construct,
+        # so per-construct timing tracks the corpus with no extra upkeep
+        f.write('typedef struct {\n')
+        f.write('    const char *name;\n')
+        f.write('    const char *yay_source;\n')
+        f.write('    const char *category;\n')
+        f.write('} bench_fixture_t;\n\n')
+        
+        f.write('static bench_fixture_t bench_fixtures[] = {\n')
+        for fix in valid_fixtures:
+            category = categorize(fix['name'])
+            f.write(f'    {{"{fix["name"]}", "{fix["yay_escaped"]}", "{category}"}},\n')
+        f.write('    {NULL, NULL, NULL}\n')
+        f.write('};\n\n')
         
         f.write('#endif /* FIXTURES_GEN_H */\n')
     
-    print(f'\nGenerated {output_file} with {len(valid_fixtures)} valid fixtures and {len(error_fixtures)} error fixtures')
+    print(f'\nGenerated {output_file} with {len(valid_fixtures)} valid fixtures, '
+          f'{len(error_fixtures)} error fixtures, and {len(meh_fixtures)} reformat fixtures')
 
 
 if __name__ == '__main__':
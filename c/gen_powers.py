@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""
+Generate the cached powers-of-ten table for the Grisu2 float formatter.
+
+Each entry approximates 10^d (d from -348 to 340 in steps of 8) as a
+normalized 64-bit significand and binary exponent, rounded to nearest
+with exact integer arithmetic, and emits powers_gen.h. Eight-step
+spacing is enough because the formatter only needs some power that
+lands the scaled value's exponent inside its working window.
+
+The header is checked in so a plain build needs no python.
+"""
+
+from pathlib import Path
+
+OUT = Path(__file__).parent / "powers_gen.h"
+
+STEP = 8
+FIRST = -348
+LAST = 340
+
+
+def cached_power(d):
+    """Significand f and exponent e with 2^63 <= f < 2^64 and
+    f * 2^e ~= 10^d, rounded to nearest."""
+    if d >= 0:
+        num, den = 10**d, 1
+    else:
+        num, den = 1, 10 ** (-d)
+
+    def round_div(e):
+        if e >= 0:
+            divisor = den << e
+        else:
+            num_shifted = num << -e
+            divisor = den
+            return (num_shifted + divisor // 2) // divisor
+        return (num + divisor // 2) // divisor
+
+    e = num.bit_length() - den.bit_length() - 63
+    f = round_div(e)
+    while f >= 1 << 64:
+        e += 1
+        f = round_div(e)
+    while f < 1 << 63:
+        e -= 1
+        f = round_div(e)
+    assert 1 << 63 <= f < 1 << 64
+    return f, e
+
+
+def main():
+    entries = [cached_power(d) for d in range(FIRST, LAST + 1, STEP)]
+
+    lines = []
+    lines.append("/*")
+    lines.append(" * Generated by gen_powers.py - DO NOT EDIT")
+    lines.append(" *")
+    lines.append(" * Cached powers of ten for the Grisu2 shortest-round-trip")
+    lines.append(" * float formatter: 10^d for d = %d..%d step %d, each as a"
+                 % (FIRST, LAST, STEP))
+    lines.append(" * normalized 64-bit significand and binary exponent.")
+    lines.append(" */")
+    lines.append("")
+    lines.append("#ifndef POWERS_GEN_H")
+    lines.append("#define POWERS_GEN_H")
+    lines.append("")
+    lines.append("#include <stdint.h>")
+    lines.append("")
+    lines.append("#define YAY_POW10_FIRST (%d)" % FIRST)
+    lines.append("#define YAY_POW10_STEP %d" % STEP)
+    lines.append("#define YAY_POW10_COUNT %d" % len(entries))
+    lines.append("")
+    lines.append("static const uint64_t yay_pow10_f[YAY_POW10_COUNT] = {")
+    for i in range(0, len(entries), 3):
+        chunk = entries[i:i + 3]
+        lines.append("    " + " ".join("UINT64_C(0x%016x)," % f
+                                       for f, _ in chunk))
+    lines.append("};")
+    lines.append("")
+    lines.append("static const int16_t yay_pow10_e[YAY_POW10_COUNT] = {")
+    for i in range(0, len(entries), 8):
+        chunk = entries[i:i + 8]
+        lines.append("    " + " ".join("%d," % e for _, e in chunk))
+    lines.append("};")
+    lines.append("")
+    lines.append("#endif /* POWERS_GEN_H */")
+    lines.append("")
+
+    OUT.write_text("\n".join(lines))
+    print("wrote %s (%d entries)" % (OUT.name, len(entries)))
+
+
+if __name__ == "__main__":
+    main()
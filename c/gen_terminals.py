@@ -0,0 +1,182 @@
+#!/usr/bin/env python3
+"""
+Generate keyword and escape dispatch tables from GRAMMAR.md.
+
+This script reads the terminal sets of ../GRAMMAR.md (the source of
+truth for the language):
+- keyword spellings from the null, boolean, and special-float productions
+- single-character escapes from the dq-escape production
+
+and emits terminals_gen.h with a perfect-hash keyword table and a
+256-entry escape classification table, so scalar dispatch stays
+table-driven and new grammar terminals cannot silently diverge from the
+parser. The Rust parser derives the same tables in libyay's build.rs.
+"""
+
+import re
+import sys
+from pathlib import Path
+
+GRAMMAR = Path(__file__).parent.parent / "GRAMMAR.md"
+OUTPUT = Path(__file__).parent / "terminals_gen.h"
+
+# Grammar productions whose double-quoted alternatives are keywords.
+KEYWORD_PRODUCTIONS = ("null", "boolean", "special-float")
+
+# Replacement byte for each single-character dq-escape. The grammar
+# names the spellings; the semantics live here, and an unknown spelling
+# aborts generation so additions are made deliberately.
+ESCAPE_SEMANTICS = {
+    '"': 0x22,
+    "\\": 0x5C,
+    "/": 0x2F,
+    "b": 0x08,
+    "f": 0x0C,
+    "n": 0x0A,
+    "r": 0x0D,
+    "t": 0x09,
+}
+
+# Enum name for each keyword spelling; same deliberate-addition rule.
+KEYWORD_KINDS = {
+    "null": "YAY_KW_NULL",
+    "true": "YAY_KW_TRUE",
+    "false": "YAY_KW_FALSE",
+    "nan": "YAY_KW_NAN",
+    "infinity": "YAY_KW_INFINITY",
+    "-infinity": "YAY_KW_NEG_INFINITY",
+}
+
+
+def extract_keywords(grammar):
+    keywords = []
+    for name in KEYWORD_PRODUCTIONS:
+        match = re.search(
+            r"^%s\s*=\s*(.*?);" % re.escape(name), grammar, re.M | re.S
+        )
+        if not match:
+            sys.exit(f"gen_terminals: production {name!r} not found in GRAMMAR.md")
+        spellings = re.findall(r'"([^"]+)"', match.group(1))
+        if not spellings:
+            sys.exit(f"gen_terminals: no terminals in production {name!r}")
+        keywords.extend(spellings)
+    for kw in keywords:
+        if kw not in KEYWORD_KINDS:
+            sys.exit(
+                f"gen_terminals: keyword {kw!r} has no kind mapping; "
+                "add it to KEYWORD_KINDS"
+            )
+    return keywords
+
+
+def extract_escapes(grammar):
+    match = re.search(r"^dq-escape\s*=\s*(.*?);", grammar, re.M | re.S)
+    if not match:
+        sys.exit("gen_terminals: production 'dq-escape' not found in GRAMMAR.md")
+    escapes = []
+    for alt in re.findall(r"'\\\\?(.)'", match.group(1)):
+        escapes.append(alt)
+    if not escapes:
+        sys.exit("gen_terminals: no escapes in production 'dq-escape'")
+    for esc in escapes:
+        if esc not in ESCAPE_SEMANTICS:
+            sys.exit(
+                f"gen_terminals: escape {esc!r} has no replacement mapping; "
+                "add it to ESCAPE_SEMANTICS"
+            )
+    return escapes
+
+
+def perfect_hash(keywords):
+    """Find (multiplier, size) so (len * mul + first-byte) % size is
+    collision-free over the keyword set."""
+    for size in range(len(keywords), 64):
+        for mul in range(1, 128):
+            slots = {(len(kw) * mul + ord(kw[0])) % size for kw in keywords}
+            if len(slots) == len(keywords):
+                return mul, size
+    sys.exit("gen_terminals: no perfect hash parameters found")
+
+
+def c_char(ch):
+    if ch == "\\":
+        return "'\\\\'"
+    if ch == "'":
+        return "'\\''"
+    return f"'{ch}'"
+
+
+def main():
+    grammar = GRAMMAR.read_text()
+    keywords = extract_keywords(grammar)
+    escapes = extract_escapes(grammar)
+    mul, size = perfect_hash(keywords)
+    max_len = max(len(kw) for kw in keywords)
+
+    lines = []
+    out = lines.append
+    out("/*")
+    out(" * Generated by gen_terminals.py from ../GRAMMAR.md - DO NOT EDIT")
+    out(" *")
+    out(" * Keyword and dq-escape dispatch tables derived from the grammar's")
+    out(" * terminal sets. Keywords resolve through a perfect hash on")
+    out(" * (length, first byte); escapes through a 256-entry class table.")
+    out(" */")
+    out("")
+    out("#ifndef TERMINALS_GEN_H")
+    out("#define TERMINALS_GEN_H")
+    out("")
+    out("#include <string.h>")
+    out("")
+    out("enum {")
+    out("    YAY_KW_NONE = 0,")
+    for kind in KEYWORD_KINDS.values():
+        out(f"    {kind},")
+    out("};")
+    out("")
+    out(f"#define YAY_KW_MAX_LEN {max_len}")
+    out(f"#define YAY_KW_HASH(first, len) (((len) * {mul}u + (unsigned)(first)) % {size}u)")
+    out("")
+    out("typedef struct {")
+    out("    const char *spelling;")
+    out("    unsigned char len;")
+    out("    unsigned char kind;")
+    out("} yay_keyword_t;")
+    out("")
+    out(f"static const yay_keyword_t yay_keyword_table[{size}] = {{")
+    for kw in keywords:
+        slot = (len(kw) * mul + ord(kw[0])) % size
+        out(f'    [{slot}] = {{ "{kw}", {len(kw)}, {KEYWORD_KINDS[kw]} }},')
+    out("};")
+    out("")
+    out("/* Whole-string keyword lookup; returns YAY_KW_NONE for non-keywords. */")
+    out("static inline unsigned char yay_keyword_lookup(const char *s) {")
+    out("    size_t len = strnlen(s, YAY_KW_MAX_LEN + 1);")
+    out("    if (len == 0 || len > YAY_KW_MAX_LEN) return YAY_KW_NONE;")
+    out("    const yay_keyword_t *kw =")
+    out("        &yay_keyword_table[YAY_KW_HASH((unsigned char)s[0], len)];")
+    out("    if (kw->len == len && memcmp(kw->spelling, s, len) == 0) {")
+    out("        return kw->kind;")
+    out("    }")
+    out("    return YAY_KW_NONE;")
+    out("}")
+    out("")
+    out("/* dq-escape classification: the replacement byte for one-character")
+    out(" * escapes, YAY_ESC_UNICODE for the unicode-escape opener, 0 for")
+    out(" * invalid escapes. */")
+    out("#define YAY_ESC_UNICODE 1")
+    out("")
+    out("static const unsigned char yay_dq_escape_table[256] = {")
+    for esc in escapes:
+        out(f"    [{c_char(esc)}] = 0x{ESCAPE_SEMANTICS[esc]:02x},")
+    out("    ['u'] = YAY_ESC_UNICODE, /* unicode-escape */")
+    out("};")
+    out("")
+    out("#endif /* TERMINALS_GEN_H */")
+
+    OUTPUT.write_text("\n".join(lines) + "\n")
+    print(f"Generated {OUTPUT.name}: {len(keywords)} keywords, {len(escapes) + 1} escapes")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,71 @@
+/*
+ * Generated by gen_terminals.py from ../GRAMMAR.md - DO NOT EDIT
+ *
+ * Keyword and dq-escape dispatch tables derived from the grammar's
+ * terminal sets. Keywords resolve through a perfect hash on
+ * (length, first byte); escapes through a 256-entry class table.
+ */
+
+#ifndef TERMINALS_GEN_H
+#define TERMINALS_GEN_H
+
+#include <string.h>
+
+enum {
+    YAY_KW_NONE = 0,
+    YAY_KW_NULL,
+    YAY_KW_TRUE,
+    YAY_KW_FALSE,
+    YAY_KW_NAN,
+    YAY_KW_INFINITY,
+    YAY_KW_NEG_INFINITY,
+};
+
+#define YAY_KW_MAX_LEN 9
+#define YAY_KW_HASH(first, len) (((len) * 2u + (unsigned)(first)) % 10u)
+
+typedef struct {
+    const char *spelling;
+    unsigned char len;
+    unsigned char kind;
+} yay_keyword_t;
+
+static const yay_keyword_t yay_keyword_table[10] = {
+    [8] = { "null", 4, YAY_KW_NULL },
+    [4] = { "true", 4, YAY_KW_TRUE },
+    [2] = { "false", 5, YAY_KW_FALSE },
+    [6] = { "nan", 3, YAY_KW_NAN },
+    [1] = { "infinity", 8, YAY_KW_INFINITY },
+    [3] = { "-infinity", 9, YAY_KW_NEG_INFINITY },
+};
+
+/* Whole-string keyword lookup; returns YAY_KW_NONE for non-keywords. */
+static inline unsigned char yay_keyword_lookup(const char *s) {
+    size_t len = strnlen(s, YAY_KW_MAX_LEN + 1);
+    if (len == 0 || len > YAY_KW_MAX_LEN) return YAY_KW_NONE;
+    const yay_keyword_t *kw =
+        &yay_keyword_table[YAY_KW_HASH((unsigned char)s[0], len)];
+    if (kw->len == len && memcmp(kw->spelling, s, len) == 0) {
+        return kw->kind;
+    }
+    return YAY_KW_NONE;
+}
+
+/* dq-escape classification: the replacement byte for one-character
+ * escapes, YAY_ESC_UNICODE for the unicode-escape opener, 0 for
+ * invalid escapes. */
+#define YAY_ESC_UNICODE 1
+
+static const unsigned char yay_dq_escape_table[256] = {
+    ['"'] = 0x22,
+    ['\\'] = 0x5c,
+    ['/'] = 0x2f,
+    ['b'] = 0x08,
+    ['f'] = 0x0c,
+    ['n'] = 0x0a,
+    ['r'] = 0x0d,
+    ['t'] = 0x09,
+    ['u'] = YAY_ESC_UNICODE, /* unicode-escape */
+};
+
+#endif /* TERMINALS_GEN_H */
@@ -9,6 +9,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
 
 #include "yay.h"
 #include "fixtures_gen.h"
@@ -29,6 +31,105 @@ static int error_tests_run = 0;
 static int error_tests_passed = 0;
 static int error_tests_failed = 0;
 
+/* Rebuild a value tree from streaming events, for comparison against the
+ * tree-building parser */
+typedef struct {
+    yay_value_t *root;
+    yay_value_t *stack[64];
+    int depth;
+    char *key;
+} event_builder_t;
+
+static void builder_attach(event_builder_t *b, yay_value_t *v) {
+    if (b->depth == 0) {
+        b->root = v;
+        return;
+    }
+    yay_value_t *top = b->stack[b->depth - 1];
+    if (top->type == YAY_ARRAY) {
+        yay_array_push(top, v);
+    } else {
+        yay_object_set(top, b->key, v);
+        free(b->key);
+        b->key = NULL;
+    }
+}
+
+static bool builder_on_null(void *ud) {
+    builder_attach(ud, yay_null());
+    return true;
+}
+
+static bool builder_on_bool(bool value, void *ud) {
+    builder_attach(ud, yay_bool(value));
+    return true;
+}
+
+static bool builder_on_int(const char *digits, bool negative, void *ud) {
+    builder_attach(ud, yay_int_from_str(digits, negative));
+    return true;
+}
+
+static bool builder_on_float(double value, void *ud) {
+    builder_attach(ud, yay_float(value));
+    return true;
+}
+
+static bool builder_on_string(const char *str, size_t length, void *ud) {
+    builder_attach(ud, yay_string_len(str, length));
+    return true;
+}
+
+static bool builder_on_bytes(const uint8_t *data, size_t length, void *ud) {
+    builder_attach(ud, yay_bytes(data, length));
+    return true;
+}
+
+static bool builder_on_array_start(void *ud) {
+    event_builder_t *b = ud;
+    yay_value_t *arr = yay_array();
+    builder_attach(b, arr);
+    b->stack[b->depth++] = arr;
+    return true;
+}
+
+static bool builder_on_array_end(void *ud) {
+    event_builder_t *b = ud;
+    b->depth--;
+    return true;
+}
+
+static bool builder_on_object_start(void *ud) {
+    event_builder_t *b = ud;
+    yay_value_t *obj = yay_object();
+    builder_attach(b, obj);
+    b->stack[b->depth++] = obj;
+    return true;
+}
+
+static bool builder_on_object_key(const char *key, size_t length, void *ud) {
+    event_builder_t *b = ud;
+    free(b->key);
+    b->key = malloc(length + 1);
+    memcpy(b->key, key, length);
+    b->key[length] = '\0';
+    return true;
+}
+
+static const yay_callbacks_t builder_callbacks = {
+    .on_null = builder_on_null,
+    .on_bool = builder_on_bool,
+    .on_int = builder_on_int,
+    .on_float = builder_on_float,
+    .on_string = builder_on_string,
+    .on_bytes = builder_on_bytes,
+    .on_array_start = builder_on_array_start,
+    .on_array_end = builder_on_array_end,
+    .on_object_start = builder_on_object_start,
+    .on_object_key = builder_on_object_key,
+    .on_object_end = builder_on_array_end, /* same pop */
+};
+
 /* Print a value diff for debugging */
 static void print_value_diff(const char *label, const yay_value_t *v) {
     char *str = yay_to_string(v);
@@ -36,21 +137,15 @@ static void print_value_diff(const char *label, const yay_value_t *v) {
     free(str);
 }
 
-/* Run a single valid test fixture */
-static bool run_test(const test_fixture_t *fixture) {
-    tests_run++;
-    
-    printf("Testing: %s ... ", fixture->name);
-    fflush(stdout);
-    
+/* Check a single valid fixture across every parse mode. Quiet: failures
+ * come back as a reason string so shards can run this concurrently. */
+static bool check_test(const test_fixture_t *fixture, const char **why) {
     /* Parse the YAY source */
     yay_result_t result = yay_parse(fixture->yay_source, 0, fixture->name);
     
     if (result.error) {
-        printf(COLOR_RED "FAIL" COLOR_RESET " (parse error)\n");
-        printf("  Error: %s\n", result.error->message);
+        *why = "parse error";
         yay_result_free(&result);
-        tests_failed++;
         return false;
     }
     
@@ -59,59 +154,1420 @@ static bool run_test(const test_fixture_t *fixture) {
     
     /* Compare */
     bool equal = yay_equal(result.value, expected);
+
+    /* Equal values must hash identically */
+    bool hash_equal = yay_hash(result.value) == yay_hash(expected);
+
+    /* Arena mode must produce the same value */
+    yay_arena_t *arena = yay_arena_create(0);
+    yay_result_t arena_result = yay_parse_arena(fixture->yay_source, 0,
+                                                fixture->name, arena);
+    bool arena_equal = !arena_result.error &&
+                       yay_equal(arena_result.value, expected);
+    yay_error_free(arena_result.error);
+    yay_arena_destroy(arena);
+
+    /* Borrowed-string mode must produce the same value */
+    yay_arena_t *borrow_arena = yay_arena_create(0);
+    yay_result_t borrowed_result = yay_parse_borrowed(fixture->yay_source, 0,
+                                                      fixture->name,
+                                                      borrow_arena);
+    bool borrowed_equal = !borrowed_result.error &&
+                          yay_equal(borrowed_result.value, expected);
+    yay_error_free(borrowed_result.error);
+    yay_arena_destroy(borrow_arena);
+
+    /* Event replay must rebuild the same value */
+    event_builder_t builder = {0};
+    yay_error_t *event_error = yay_parse_events(fixture->yay_source, 0,
+                                                fixture->name,
+                                                &builder_callbacks, &builder);
+    bool events_equal = !event_error && yay_equal(builder.root, expected);
+    yay_error_free(event_error);
+    yay_free(builder.root);
+    free(builder.key);
+
+    /* CBOR transcoding must round-trip through the event pipeline */
+    yay_writer_t cbor;
+    yay_writer_init(&cbor);
+    yay_error_t *cbor_error = yay_to_cbor(fixture->yay_source, 0,
+                                          fixture->name, &cbor);
+    bool cbor_equal = !cbor_error;
+    if (cbor_equal) {
+        event_builder_t cbor_builder = {0};
+        cbor_error = yay_from_cbor((const uint8_t *)cbor.data, cbor.length,
+                                   &builder_callbacks, &cbor_builder);
+        cbor_equal = !cbor_error && yay_equal(cbor_builder.root, expected);
+        yay_free(cbor_builder.root);
+        free(cbor_builder.key);
+    }
+    yay_error_free(cbor_error);
+    yay_writer_free(&cbor);
+
+    /* Compact mode must produce the same value */
+    yay_result_t compact_result = yay_parse_compact(fixture->yay_source, 0,
+                                                    fixture->name);
+    bool compact_equal = !compact_result.error &&
+                         yay_equal(compact_result.value, expected);
+    yay_result_free(&compact_result);
+
+    /* Validation-only mode must agree */
+    bool valid = yay_validate(fixture->yay_source, 0, fixture->name, NULL);
+
+    /* A compiled YAYB image must relocate back to the same value */
+    yay_writer_t image;
+    yay_writer_init(&image);
+    bool mapped_equal = yay_compile(expected, &image);
+    if (mapped_equal) {
+        yay_value_t *mapped = yay_load_mapped(image.data, image.length);
+        mapped_equal = mapped && yay_equal(mapped, expected);
+    }
+    yay_writer_free(&image);
+
+    if (!equal) {
+        *why = "value mismatch";
+    } else if (!hash_equal) {
+        *why = "structural hash mismatch";
+    } else if (!arena_equal) {
+        *why = "arena value mismatch";
+    } else if (!borrowed_equal) {
+        *why = "borrowed value mismatch";
+    } else if (!events_equal) {
+        *why = "event replay mismatch";
+    } else if (!cbor_equal) {
+        *why = "CBOR round trip mismatch";
+    } else if (!compact_equal) {
+        *why = "compact value mismatch";
+    } else if (!valid) {
+        *why = "validate rejected valid input";
+    } else if (!mapped_equal) {
+        *why = "YAYB round trip mismatch";
+    }
+
+    /* Cleanup */
+    yay_free(expected);
+    yay_result_free(&result);
+
+    return equal && hash_equal && arena_equal && borrowed_equal && events_equal &&
+           cbor_equal && compact_equal && valid && mapped_equal;
+}
+
+/* Run a single valid test fixture */
+static bool run_test(const test_fixture_t *fixture) {
+    tests_run++;
     
-    if (equal) {
+    printf("Testing: %s ... ", fixture->name);
+    fflush(stdout);
+    
+    const char *why = NULL;
+    if (check_test(fixture, &why)) {
         printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
         tests_passed++;
-    } else {
-        printf(COLOR_RED "FAIL" COLOR_RESET " (value mismatch)\n");
+        return true;
+    }
+    
+    printf(COLOR_RED "FAIL" COLOR_RESET " (%s)\n", why);
+    /* Reparse for diagnostics; fixtures are tiny */
+    yay_result_t result = yay_parse(fixture->yay_source, 0, fixture->name);
+    if (result.error) {
+        printf("  Error: %s\n", yay_error_message(result.error));
+    } else if (strcmp(why, "value mismatch") == 0) {
+        yay_value_t *expected = fixture->make_expected();
         print_value_diff("Expected", expected);
         print_value_diff("Got     ", result.value);
-        tests_failed++;
+        yay_free(expected);
+    }
+    yay_result_free(&result);
+    tests_failed++;
+    return false;
+}
+
+/* Parse every valid fixture again through the batch API and check the
+ * results against the expected trees */
+static bool run_batch_test(void) {
+    size_t count = 0;
+    while (test_fixtures[count].name != NULL) count++;
+
+    yay_input_t *inputs = calloc(count, sizeof(yay_input_t));
+    yay_result_t *results = calloc(count, sizeof(yay_result_t));
+    for (size_t i = 0; i < count; i++) {
+        inputs[i].source = test_fixtures[i].yay_source;
+        inputs[i].filename = test_fixtures[i].name;
+    }
+
+    yay_parse_batch(inputs, count, 4, results);
+
+    bool all_equal = true;
+    for (size_t i = 0; i < count; i++) {
+        yay_value_t *expected = test_fixtures[i].make_expected();
+        if (results[i].error || !yay_equal(results[i].value, expected)) {
+            printf(COLOR_RED "FAIL" COLOR_RESET " (batch mismatch: %s)\n",
+                   test_fixtures[i].name);
+            all_equal = false;
+        }
+        yay_free(expected);
+        yay_result_free(&results[i]);
+    }
+    free(inputs);
+    free(results);
+    return all_equal;
+}
+
+/* Parse every valid fixture through the parallel entry point, plus a
+ * large synthetic outline array that actually splits, and check against
+ * the sequential parser */
+static bool run_parallel_test(void) {
+    bool all_equal = true;
+
+    for (int i = 0; test_fixtures[i].name != NULL; i++) {
+        yay_value_t *expected = test_fixtures[i].make_expected();
+        yay_result_t result = yay_parse_parallel(test_fixtures[i].yay_source, 0,
+                                                 test_fixtures[i].name, 4);
+        if (result.error || !yay_equal(result.value, expected)) {
+            printf(COLOR_RED "FAIL" COLOR_RESET " (parallel mismatch: %s)\n",
+                   test_fixtures[i].name);
+            all_equal = false;
+        }
+        yay_free(expected);
+        yay_result_free(&result);
+    }
+
+    /* Synthetic top-level array big enough to fan out */
+    yay_writer_t doc;
+    yay_writer_init(&doc);
+    for (int i = 0; i < 1000; i++) {
+        char line[64];
+        snprintf(line, sizeof(line), "- item: %d\n  flag: true\n", i);
+        yay_writer_write(&doc, line, strlen(line));
+    }
+    yay_result_t sequential = yay_parse(doc.data, doc.length, "synthetic");
+    yay_result_t parallel = yay_parse_parallel(doc.data, doc.length,
+                                               "synthetic", 4);
+    if (sequential.error || parallel.error ||
+        !yay_equal(sequential.value, parallel.value) ||
+        parallel.value->data.array.length != 1000) {
+        printf(COLOR_RED "FAIL" COLOR_RESET " (parallel synthetic array)\n");
+        all_equal = false;
+    }
+    yay_result_free(&sequential);
+    yay_result_free(&parallel);
+    yay_writer_free(&doc);
+
+    return all_equal;
+}
+
+/* Clone sharing and copy-on-write semantics */
+static bool run_clone_test(void) {
+    yay_value_t *original = yay_object();
+    yay_object_set(original, "a", yay_int(1));
+    yay_value_t *items = yay_array();
+    yay_array_push(items, yay_int(1));
+    yay_array_push(items, yay_int(2));
+    yay_object_set(original, "items", items);
+
+    bool ok = true;
+    int64_t n = 0;
+
+    /* Cloning shares the same node */
+    yay_value_t *shared = yay_clone(original);
+    ok = ok && shared == original;
+
+    /* Mutating the clone copies only the root; children stay shared */
+    yay_value_t *mutated = yay_object_set(shared, "a", yay_int(2));
+    ok = ok && mutated != original;
+    ok = ok && yay_object_get(mutated, "items") ==
+               yay_object_get(original, "items");
+    ok = ok && yay_int_value(yay_object_get(original, "a"), &n) && n == 1;
+    ok = ok && yay_int_value(yay_object_get(mutated, "a"), &n) && n == 2;
+
+    /* Releasing the mutated copy leaves the original intact */
+    yay_free(mutated);
+    yay_value_t *kept = yay_object_get(original, "items");
+    ok = ok && kept && kept->data.array.length == 2;
+    ok = ok && yay_int_value(kept->data.array.items[0], &n) && n == 1;
+
+    yay_free(original);
+    return ok;
+}
+
+/* String encoding escapes quotes, backslashes, and control bytes */
+static bool run_encode_escape_test(void) {
+    yay_value_t *v = yay_string("a\"b\\c\nd\te");
+    char *s = yay_to_string(v);
+    bool ok = s && strcmp(s, "\"a\\\"b\\\\c\\nd\\te\"") == 0;
+    free(s);
+    yay_free(v);
+    return ok;
+}
+
+/* Malformed YAYB images load as NULL rather than crashing: offsets that
+ * loop back on an ancestor, strings without a terminator inside the
+ * image, and truncated images are all refused by yay_load_mapped */
+static bool run_mapped_malformed_test(void) {
+    yay_value_t *value = yay_array();
+    yay_array_push(value, yay_string("x"));
+    yay_writer_t writer;
+    yay_writer_init(&writer);
+    bool ok = yay_compile(value, &writer);
+    yay_free(value);
+    if (!ok) {
+        yay_writer_free(&writer);
+        return false;
+    }
+
+    /* The root offset sits after magic, version, value_size, and
+     * pointer_size in the image header */
+    uint64_t root_offset;
+    memcpy(&root_offset, writer.data + 16, sizeof(root_offset));
+
+    /* Loop the array's first element offset back at the root node */
+    char *copy = malloc(writer.length);
+    ok = copy != NULL;
+    if (ok) {
+        memcpy(copy, writer.data, writer.length);
+        yay_value_t *root = (yay_value_t *)(void *)(copy + root_offset);
+        uintptr_t *items = (uintptr_t *)(void *)
+            (copy + (uintptr_t)root->data.array.items);
+        items[0] = (uintptr_t)root_offset;
+        ok = yay_load_mapped(copy, writer.length) == NULL;
+        free(copy);
+    }
+
+    /* Point the string at the image's final byte with no NUL after it */
+    if (ok) {
+        copy = malloc(writer.length);
+        ok = copy != NULL;
+    }
+    if (ok) {
+        memcpy(copy, writer.data, writer.length);
+        yay_value_t *root = (yay_value_t *)(void *)(copy + root_offset);
+        uintptr_t *items = (uintptr_t *)(void *)
+            (copy + (uintptr_t)root->data.array.items);
+        yay_value_t *element = (yay_value_t *)(void *)(copy + items[0]);
+        element->data.string = (char *)(uintptr_t)(writer.length - 1);
+        copy[writer.length - 1] = 'x';
+        ok = yay_load_mapped(copy, writer.length) == NULL;
+        free(copy);
+    }
+
+    /* Truncation clips the root node */
+    ok = ok && yay_load_mapped(writer.data, writer.length - 1) == NULL;
+
+    /* A corrupted bool payload is normalized during fixup rather than
+     * left to be read as an invalid _Bool */
+    if (ok) {
+        yay_value_t *flag = yay_bool(true);
+        yay_writer_t bool_writer;
+        yay_writer_init(&bool_writer);
+        ok = yay_compile(flag, &bool_writer);
+        yay_free(flag);
+        if (ok) {
+            uint64_t flag_offset;
+            memcpy(&flag_offset, bool_writer.data + 16, sizeof(flag_offset));
+            yay_value_t *node = (yay_value_t *)(void *)
+                (bool_writer.data + flag_offset);
+            memset(&node->data.boolean, 8, 1);
+            yay_value_t *mapped =
+                yay_load_mapped(bool_writer.data, bool_writer.length);
+            ok = mapped && mapped->type == YAY_BOOL &&
+                 mapped->data.boolean == true;
+        }
+        yay_writer_free(&bool_writer);
+    }
+
+    /* The pristine image still relocates (mutating it in place) */
+    if (ok) {
+        yay_value_t *mapped = yay_load_mapped(writer.data, writer.length);
+        ok = mapped && mapped->type == YAY_ARRAY &&
+             mapped->data.array.length == 1 &&
+             mapped->data.array.items[0]->type == YAY_STRING &&
+             strcmp(mapped->data.array.items[0]->data.string, "x") == 0;
+    }
+    yay_writer_free(&writer);
+    return ok;
+}
+
+/* Sorted index-less objects (mapped YAYB trees) answer lookups by
+ * binary search */
+static bool run_sorted_lookup_test(void) {
+    enum { KEYS = 32 };
+    char key[16];
+    yay_value_t *object = yay_object();
+    for (int i = 0; i < KEYS; i++) {
+        snprintf(key, sizeof(key), "key%03d", i);
+        yay_object_set(object, key, yay_int(i));
+    }
+
+    yay_writer_t writer;
+    yay_writer_init(&writer);
+    bool ok = yay_compile(object, &writer);
+    yay_value_t *mapped = ok ? yay_load_mapped(writer.data, writer.length)
+                             : NULL;
+    ok = ok && mapped != NULL;
+    for (int i = 0; ok && i < KEYS; i++) {
+        snprintf(key, sizeof(key), "key%03d", i);
+        int64_t n = -1;
+        ok = yay_int_value(yay_object_get(mapped, key), &n) && n == i;
+    }
+    ok = ok && yay_object_get(mapped, "missing") == NULL;
+
+    /* Out-of-order keys keep working through the linear fallback */
+    yay_value_t *unsorted = yay_object();
+    yay_object_set(unsorted, "zebra", yay_int(1));
+    yay_object_set(unsorted, "apple", yay_int(2));
+    int64_t n = -1;
+    ok = ok && yay_int_value(yay_object_get(unsorted, "apple"), &n) && n == 2;
+    yay_free(unsorted);
+
+    yay_writer_free(&writer);
+    yay_free(object);
+    return ok;
+}
+
+/* Limb-based bignum arithmetic: comparison, addition crossing the int64
+ * range, and the warm-cache fast path in yay_equal */
+static bool run_bigint_test(void) {
+    yay_value_t *big = yay_int_from_str("99999999999999999999", false);
+    yay_value_t *bigger = yay_int_from_str("100000000000000000001", false);
+    yay_value_t *neg = yay_int_from_str("99999999999999999999", true);
+    yay_value_t *two = yay_int(2);
+    bool ok = true;
+
+    /* Ordering: negative < small < big < bigger */
+    ok = ok && yay_bigint_cmp(&neg->data.bigint, &two->data.bigint) < 0;
+    ok = ok && yay_bigint_cmp(&two->data.bigint, &big->data.bigint) < 0;
+    ok = ok && yay_bigint_cmp(&big->data.bigint, &bigger->data.bigint) < 0;
+    ok = ok && yay_bigint_cmp(&big->data.bigint, &big->data.bigint) == 0;
+    ok = ok && yay_bigint_cmp(&big->data.bigint, &neg->data.bigint) > 0;
+
+    /* to_int64 succeeds exactly when the value fits */
+    int64_t small = 0;
+    ok = ok && yay_bigint_to_int64(&two->data.bigint, &small) && small == 2;
+    ok = ok && !yay_bigint_to_int64(&big->data.bigint, &small);
+
+    /* big + 2 crosses nothing; big + big crosses a limb boundary */
+    yay_bigint_t sum;
+    ok = ok && yay_bigint_add(&big->data.bigint, &two->data.bigint, &sum);
+    ok = ok && sum.digits && strcmp(sum.digits, "100000000000000000001") == 0;
+    ok = ok && !sum.negative;
+    yay_bigint_clear(&sum);
+
+    ok = ok && yay_bigint_add(&big->data.bigint, &big->data.bigint, &sum);
+    ok = ok && sum.digits && strcmp(sum.digits, "199999999999999999998") == 0;
+    yay_bigint_clear(&sum);
+
+    /* Opposite signs cancel back into the inline range */
+    ok = ok && yay_bigint_add(&big->data.bigint, &neg->data.bigint, &sum);
+    ok = ok && !sum.digits && sum.small == 0;
+    yay_bigint_clear(&sum);
+
+    /* A one-off cancellation leaves a small negative */
+    yay_value_t *neg_bigger = yay_int_from_str("100000000000000000001", true);
+    ok = ok && yay_bigint_add(&big->data.bigint, &neg_bigger->data.bigint,
+                              &sum);
+    ok = ok && !sum.digits && sum.small == -2 && sum.negative;
+    yay_bigint_clear(&sum);
+
+    /* The comparisons above warmed the limb caches; yay_equal must still
+     * agree, and leading zeros must stay significant */
+    ok = ok && yay_equal(big, big) && !yay_equal(big, bigger);
+    yay_value_t *padded = yay_int_from_str("007", false);
+    yay_value_t *plain = yay_int_from_str("7", false);
+    ok = ok && !yay_equal(padded, plain);
+
+    yay_free(big);
+    yay_free(bigger);
+    yay_free(neg);
+    yay_free(neg_bigger);
+    yay_free(two);
+    yay_free(padded);
+    yay_free(plain);
+    return ok;
+}
+
+/* Decode CBOR produced by the other implementations: fixed byte strings
+ * captured from test/from-cbor, checked against parses of the matching
+ * YAY documents, plus the decoder's error cases */
+static bool run_cbor_decode_test(void) {
+    /* test/from-cbor/scalars.cbor */
+    static const uint8_t scalars[] = {
+        0xa6, 0x6a, 0x62, 0x6f, 0x6f, 0x6c, 0x5f, 0x66, 0x61, 0x6c, 0x73,
+        0x65, 0xf4, 0x69, 0x62, 0x6f, 0x6f, 0x6c, 0x5f, 0x74, 0x72, 0x75,
+        0x65, 0xf5, 0x65, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0xfb, 0x40, 0x09,
+        0x1e, 0xb8, 0x51, 0xeb, 0x85, 0x1f, 0x67, 0x69, 0x6e, 0x74, 0x65,
+        0x67, 0x65, 0x72, 0x18, 0x2a, 0x68, 0x6e, 0x75, 0x6c, 0x6c, 0x5f,
+        0x76, 0x61, 0x6c, 0xf6, 0x66, 0x73, 0x74, 0x72, 0x69, 0x6e, 0x67,
+        0x65, 0x68, 0x65, 0x6c, 0x6c, 0x6f,
+    };
+    const char *scalars_yay =
+        "bool_false: false\n"
+        "bool_true: true\n"
+        "float: 3.14\n"
+        "integer: 42\n"
+        "null_val: null\n"
+        "string: \"hello\"\n";
+
+    event_builder_t builder = {0};
+    yay_error_t *error = yay_from_cbor(scalars, sizeof(scalars),
+                                       &builder_callbacks, &builder);
+    yay_result_t expected = yay_parse(scalars_yay, 0, NULL);
+    bool ok = !error && !expected.error &&
+              yay_equal(builder.root, expected.value);
+    if (error) {
+        printf("\n  scalars decode error: %s\n", yay_error_message(error));
+    } else if (!ok) {
+        printf("\n  scalars decode mismatch\n");
+    }
+    yay_error_free(error);
+    yay_free(builder.root);
+    free(builder.key);
+    yay_result_free(&expected);
+
+    /* test/from-cbor/big-integers.cbor: bignum tags 2 and 3 */
+    static const uint8_t bignums[] = {
+        0xa2, 0x63, 0x62, 0x69, 0x67, 0x1b, 0x8a, 0xc7, 0x23, 0x04, 0x89,
+        0xe7, 0xff, 0xff, 0x67, 0x6e, 0x65, 0x67, 0x5f, 0x62, 0x69, 0x67,
+        0x3b, 0x8a, 0xc7, 0x23, 0x04, 0x89, 0xe7, 0xff, 0xfe,
+    };
+    const char *bignums_yay =
+        "big: 9999999999999999999\n"
+        "neg_big: -9999999999999999999\n";
+    memset(&builder, 0, sizeof(builder));
+    error = yay_from_cbor(bignums, sizeof(bignums), &builder_callbacks,
+                          &builder);
+    expected = yay_parse(bignums_yay, 0, NULL);
+    if (ok) {
+        ok = !error && !expected.error &&
+             yay_equal(builder.root, expected.value);
+        if (!ok) printf("\n  bignum decode mismatch\n");
+    }
+    yay_error_free(error);
+    yay_free(builder.root);
+    free(builder.key);
+    yay_result_free(&expected);
+
+    /* A tag 2 bignum over 64 bits must survive the decimal conversion */
+    static const uint8_t wide[] = {
+        0xc2, 0x4a, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, /* 2^72 */
+    };
+    memset(&builder, 0, sizeof(builder));
+    error = yay_from_cbor(wide, sizeof(wide), &builder_callbacks, &builder);
+    expected = yay_parse("4722366482869645213696", 0, NULL);
+    if (ok) {
+        ok = !error && !expected.error &&
+             yay_equal(builder.root, expected.value);
+        if (!ok) printf("\n  wide bignum decode mismatch\n");
+    }
+    yay_error_free(error);
+    yay_free(builder.root);
+    free(builder.key);
+    yay_result_free(&expected);
+
+    /* Non-text map keys are rejected */
+    static const uint8_t int_key[] = {0xa1, 0x01, 0x02};
+    memset(&builder, 0, sizeof(builder));
+    error = yay_from_cbor(int_key, sizeof(int_key), &builder_callbacks,
+                          &builder);
+    if (ok) {
+        ok = error &&
+             strstr(yay_error_message(error), "map key must be a text string") != NULL;
+        if (!ok) printf("\n  missing map key error\n");
+    }
+    yay_error_free(error);
+    yay_free(builder.root);
+    free(builder.key);
+
+    /* Unsupported tags are rejected */
+    static const uint8_t tagged[] = {0xc1, 0x00};
+    error = yay_from_cbor(tagged, sizeof(tagged), NULL, NULL);
+    if (ok) {
+        ok = error && strstr(yay_error_message(error), "tag 1") != NULL;
+        if (!ok) printf("\n  missing tag error\n");
+    }
+    yay_error_free(error);
+
+    /* Truncated input and trailing bytes are rejected */
+    static const uint8_t truncated[] = {0x18};
+    error = yay_from_cbor(truncated, sizeof(truncated), NULL, NULL);
+    if (ok) {
+        ok = error && strstr(yay_error_message(error), "truncated") != NULL;
+        if (!ok) printf("\n  missing truncation error\n");
+    }
+    yay_error_free(error);
+
+    static const uint8_t trailing[] = {0xf6, 0x00};
+    error = yay_from_cbor(trailing, sizeof(trailing), NULL, NULL);
+    if (ok) {
+        ok = error && strstr(yay_error_message(error), "Trailing bytes") != NULL;
+        if (!ok) printf("\n  missing trailing bytes error\n");
+    }
+    yay_error_free(error);
+
+    return ok;
+}
+
+/* Streaming push parser: entries arrive as soon as they complete */
+static bool stream_collect(yay_value_t *value, void *user_data) {
+    yay_value_t *merged = user_data;
+    if (value && value->type == YAY_OBJECT) {
+        for (size_t i = 0; i < value->data.object.length; i++) {
+            yay_object_set(merged, value->data.object.pairs[i].key,
+                           yay_clone(value->data.object.pairs[i].value));
+        }
+    }
+    yay_free(value);
+    return true;
+}
+
+static bool run_stream_test(void) {
+    const char *source =
+        "alpha: 1\n"
+        "beta:\n"
+        "  nested: [1, 2, 3]\n"
+        "gamma: \"three\"\n";
+    size_t source_length = strlen(source);
+
+    /* Feed in 5-byte chunks and merge the emitted entries */
+    yay_value_t *merged = yay_object();
+    yay_stream_t *stream = yay_stream_create("stream.yay", stream_collect,
+                                             merged);
+    bool ok = stream != NULL;
+    for (size_t i = 0; ok && i < source_length; i += 5) {
+        size_t chunk = source_length - i < 5 ? source_length - i : 5;
+        ok = yay_feed(stream, source + i, chunk);
+    }
+    yay_error_t *error = yay_finish(stream);
+    ok = ok && !error;
+    yay_error_free(error);
+
+    yay_result_t full = yay_parse(source, 0, "stream.yay");
+    ok = ok && !full.error && yay_equal(merged, full.value);
+    yay_result_free(&full);
+    yay_free(merged);
+
+    /* Errors report absolute document positions */
+    stream = yay_stream_create("stream.yay", NULL, NULL);
+    const char *broken = "alpha: 1\nbeta: 2\ngamma: @\n";
+    yay_feed(stream, broken, strlen(broken));
+    error = yay_finish(stream);
+    ok = ok && error && error->line == 3 &&
+         strstr(yay_error_message(error), "at 3:") != NULL;
+    yay_error_free(error);
+    return ok;
+}
+
+/* Incremental reparse: edits inside one top-level entry reuse the rest */
+static bool run_reparse_test(void) {
+    const char *before =
+        "alpha: 1\n"
+        "beta:\n"
+        "  nested: [1, 2, 3]\n"
+        "gamma: \"three\"\n";
+    yay_result_t previous = yay_parse(before, 0, "reparse.yay");
+    if (previous.error) {
+        yay_result_free(&previous);
+        return false;
+    }
+
+    /* Replace "1" in "alpha: 1" with "42"; other subtrees are shared */
+    yay_result_t edited = yay_reparse(&previous, before, 0, 7, 8, "42", 2,
+                                      "reparse.yay");
+    int64_t n = 0;
+    bool ok = !edited.error && edited.value;
+    ok = ok && yay_int_value(yay_object_get(edited.value, "alpha"), &n) &&
+         n == 42;
+    ok = ok && yay_object_get(edited.value, "beta") ==
+               yay_object_get(previous.value, "beta");
+    ok = ok && yay_object_get(edited.value, "gamma") ==
+               yay_object_get(previous.value, "gamma");
+
+    /* Result matches a from-scratch parse of the edited document */
+    const char *after =
+        "alpha: 42\n"
+        "beta:\n"
+        "  nested: [1, 2, 3]\n"
+        "gamma: \"three\"\n";
+    yay_result_t full = yay_parse(after, 0, "reparse.yay");
+    ok = ok && !full.error && yay_equal(edited.value, full.value);
+    yay_result_free(&full);
+    yay_result_free(&edited);
+
+    /* A broken edit still reports the parser's error */
+    edited = yay_reparse(&previous, before, 0, 7, 8, "@", 1, "reparse.yay");
+    ok = ok && edited.error != NULL;
+    yay_result_free(&edited);
+
+    /* The previous tree survives its shared children being released */
+    yay_result_free(&previous);
+    return ok;
+}
+
+/* Stats surface: populated under -DYAY_STATS, all zeros otherwise */
+static bool run_stats_test(void) {
+    yay_result_t result = yay_parse("a: 1\nb: [true, false]\n", 0, "stats.yay");
+    bool ok = !result.error;
+    yay_result_free(&result);
+
+    yay_stats_t stats;
+    yay_parse_stats(&stats);
+#ifdef YAY_STATS
+    ok = ok && stats.lines >= 2 && stats.tokens > 0 && stats.nodes >= 4;
+    ok = ok && stats.scan_seconds >= 0 && stats.build_seconds >= 0;
+#else
+    ok = ok && stats.lines == 0 && stats.tokens == 0 && stats.nodes == 0;
+#endif
+    return ok;
+}
+
+/* Deep nesting must not exhaust the call stack in encode or free */
+static bool run_deep_nesting_test(void) {
+    enum { DEPTH = 200000 };
+    yay_value_t *root = yay_int(1);
+    for (int i = 0; i < DEPTH; i++) {
+        yay_value_t *wrapper = yay_array();
+        yay_array_push(wrapper, root);
+        root = wrapper;
+    }
+
+    char *str = yay_to_string(root);
+    bool ok = str && strlen(str) == 2 * DEPTH + 2 &&
+              str[0] == '[' && str[DEPTH] == '1';
+    free(str);
+    yay_free(root);
+    return ok;
+}
+
+/* Schema-driven decoding straight into a struct */
+static bool run_parse_into_test(void) {
+    typedef struct {
+        char *name;
+        int64_t port;
+        double ratio;
+        bool enabled;
+    } config_t;
+    config_t config = { NULL, 0, 0.0, false };
+    yay_field_t fields[] = {
+        { "name", offsetof(config_t, name), YAY_STRING },
+        { "port", offsetof(config_t, port), YAY_INT },
+        { "ratio", offsetof(config_t, ratio), YAY_FLOAT },
+        { "enabled", offsetof(config_t, enabled), YAY_BOOL },
+    };
+    const char *source =
+        "name: \"server\"\n"
+        "port: 8080\n"
+        "ratio: 0.5\n"
+        "enabled: true\n"
+        "extra: [1, 2]\n"
+        "port_label: \"ignored\"\n";
+
+    yay_error_t *error = yay_parse_into(source, 0, "parse_into.yay",
+                                        fields, 4, &config);
+    bool ok = !error;
+    if (error) yay_error_free(error);
+    ok = ok && config.name && strcmp(config.name, "server") == 0;
+    ok = ok && config.port == 8080;
+    ok = ok && config.ratio == 0.5;
+    ok = ok && config.enabled;
+    free(config.name);
+
+    /* Invalid input surfaces the parser's error */
+    error = yay_parse_into("port: @\n", 0, "parse_into.yay", fields, 4,
+                           &config);
+    ok = ok && error != NULL;
+    if (error) yay_error_free(error);
+    return ok;
+}
+
+/* Ownership-transfer parsing: the buffer is consumed and strings alias
+ * into it, escapes decoded in place */
+static bool run_owned_test(void) {
+    const char *source =
+        "name: \"line one\\nline two\"\n"
+        "plain: 'hello world'\n"
+        "count: 3\n";
+    size_t source_len = strlen(source);
+
+    yay_result_t expected = yay_parse(source, 0, "owned.yay");
+    if (expected.error) {
+        yay_result_free(&expected);
+        return false;
+    }
+
+    yay_arena_t *arena = yay_arena_create(0);
+    char *buffer = malloc(source_len + 1);
+    memcpy(buffer, source, source_len + 1);
+    yay_result_t owned = yay_parse_owned(buffer, source_len, "owned.yay",
+                                         arena);
+    bool ok = !owned.error && yay_equal(owned.value, expected.value);
+
+    /* The decoded escape must alias the adopted buffer, not a copy */
+    if (ok) {
+        const yay_value_t *name = yay_object_get(owned.value, "name");
+        ok = name && name->type == YAY_STRING &&
+             strcmp(name->data.string, "line one\nline two") == 0 &&
+             name->data.string >= buffer &&
+             name->data.string < buffer + source_len;
+    }
+    yay_error_free(owned.error);
+    yay_arena_destroy(arena);
+    yay_result_free(&expected);
+
+    /* A failing parse still consumes the buffer (leak checked under
+     * ASAN) */
+    yay_arena_t *bad_arena = yay_arena_create(0);
+    char *bad = malloc(8);
+    memcpy(bad, "- @\n", 5);
+    yay_result_t failed = yay_parse_owned(bad, 4, "owned.yay", bad_arena);
+    ok = ok && failed.error != NULL;
+    yay_error_free(failed.error);
+    yay_arena_destroy(bad_arena);
+
+    return ok;
+}
+
+/* Structural sharing: identical subtrees collapse to one shared node */
+static bool run_dedup_test(void) {
+    const char *source =
+        "- name: 'a'\n"
+        "  defaults: {retries: 3, timeout: 30}\n"
+        "- name: 'b'\n"
+        "  defaults: {retries: 3, timeout: 30}\n"
+        "- name: 'c'\n"
+        "  defaults: {retries: 3, timeout: 30}\n";
+
+    yay_result_t result = yay_parse(source, 0, "dedup.yay");
+    if (result.error) {
+        yay_result_free(&result);
+        return false;
+    }
+    yay_result_t reference = yay_parse(source, 0, "dedup.yay");
+
+    size_t collapsed = yay_dedup(result.value);
+    bool ok = collapsed > 0;
+
+    /* The repeated defaults blocks must share one node... */
+    yay_value_t *first =
+        yay_object_get(result.value->data.array.items[0], "defaults");
+    yay_value_t *second =
+        yay_object_get(result.value->data.array.items[1], "defaults");
+    yay_value_t *third =
+        yay_object_get(result.value->data.array.items[2], "defaults");
+    ok = ok && first && first == second && second == third;
+
+    /* ...while the tree still compares equal to a fresh parse */
+    ok = ok && yay_equal(result.value, reference.value);
+
+    /* A second pass finds nothing left to collapse */
+    ok = ok && yay_dedup(result.value) == 0;
+
+    yay_result_free(&result);
+    yay_result_free(&reference);
+    return ok;
+}
+
+/* Compiled path queries: one compile, O(1) hops per lookup */
+static bool run_path_test(void) {
+    const char *source =
+        "servers:\n"
+        "- name: 'alpha'\n"
+        "  listen: {port: 8080, 'bind addr': '127.0.0.1'}\n"
+        "- name: 'beta'\n"
+        "  listen: {port: 8081, 'bind addr': '0.0.0.0'}\n";
+
+    yay_result_t result = yay_parse(source, 0, "path.yay");
+    if (result.error) {
+        yay_result_free(&result);
+        return false;
+    }
+
+    bool ok = true;
+    int64_t port = 0;
+
+    /* A compiled path is reusable across lookups and documents */
+    yay_path_t *port_path = yay_path_compile("servers[1].listen.port");
+    yay_value_t *found = yay_get_path(result.value, port_path);
+    ok = ok && found && yay_int_value(found, &port) && port == 8081;
+    ok = ok && yay_get_path(result.value, port_path) == found;
+    yay_path_free(port_path);
+
+    /* Quoted segments reach keys that are not bare words */
+    yay_path_t *addr_path = yay_path_compile("servers[0].listen['bind addr']");
+    found = yay_get_path(result.value, addr_path);
+    ok = ok && found && found->type == YAY_STRING &&
+         strcmp(found->data.string, "127.0.0.1") == 0;
+    yay_path_free(addr_path);
+
+    /* Missing keys, out-of-range indexes, and type mismatches miss
+     * cleanly */
+    yay_path_t *misses[] = {
+        yay_path_compile("servers[2].name"),
+        yay_path_compile("servers[0].nope"),
+        yay_path_compile("servers[0].name[0]"),
+    };
+    for (size_t i = 0; i < sizeof(misses) / sizeof(misses[0]); i++) {
+        ok = ok && misses[i] && yay_get_path(result.value, misses[i]) == NULL;
+        yay_path_free(misses[i]);
+    }
+
+    /* Malformed expressions fail to compile */
+    ok = ok && yay_path_compile("") == NULL;
+    ok = ok && yay_path_compile("a..b") == NULL;
+    ok = ok && yay_path_compile("a[") == NULL;
+    ok = ok && yay_path_compile("a[x]") == NULL;
+    ok = ok && yay_path_compile("a['open") == NULL;
+    ok = ok && yay_path_compile("[0]") == NULL;
+
+    yay_result_free(&result);
+    return ok;
+}
+
+static bool run_json_test(void) {
+    const char *json =
+        "{\"name\": \"alpha\", \"port\": 8080, \"ratio\": 0.5,\n"
+        " \"ok\": true, \"extra\": null,\n"
+        " \"tags\": [\"a\", \"b\", -3, 1e2], \"empty\": [], \"none\": {}}";
+    const char *equivalent =
+        "name: 'alpha'\n"
+        "port: 8080\n"
+        "ratio: 0.5\n"
+        "ok: true\n"
+        "extra: null\n"
+        "tags: ['a', 'b', -3, 100.0]\n"
+        "empty: []\n"
+        "none: {}\n";
+
+    yay_result_t decoded = yay_from_json(json, 0);
+    yay_result_t expected = yay_parse(equivalent, 0, NULL);
+    bool ok = !decoded.error && !expected.error &&
+              yay_equal(decoded.value, expected.value);
+    if (decoded.error) {
+        printf("\n  decode error: %s\n", yay_error_message(decoded.error));
+    } else if (!ok) {
+        printf("\n  decode mismatch\n");
+    }
+    yay_result_free(&expected);
+
+    /* The streaming transcoder must match encoding the decoded tree */
+    yay_writer_t writer;
+    yay_writer_init(&writer);
+    yay_error_t *error = yay_json_to_yay(json, 0, &writer);
+    if (ok) {
+        char *via_tree = yay_to_string(decoded.value);
+        ok = !error && via_tree && strcmp(writer.data, via_tree) == 0;
+        if (!ok) {
+            printf("\n  transcode mismatch:\n    %s\n    %s\n",
+                   writer.data ? writer.data : "(null)",
+                   via_tree ? via_tree : "(null)");
+        }
+        free(via_tree);
+    }
+    yay_error_free(error);
+    yay_writer_free(&writer);
+    yay_result_free(&decoded);
+
+    /* Escapes, including a surrogate pair, unescape to UTF-8 */
+    decoded = yay_from_json("\"tab\\tquote\\\" \\u00e9 \\ud83d\\ude00\"", 0);
+    if (ok) {
+        ok = !decoded.error && decoded.value->type == YAY_STRING &&
+             strcmp(decoded.value->data.string,
+                    "tab\tquote\" \xc3\xa9 \xf0\x9f\x98\x80") == 0;
+        if (!ok) printf("\n  escape decode mismatch\n");
+    }
+    yay_result_free(&decoded);
+
+    /* Arena decoding frees with the arena, not yay_free */
+    yay_arena_t *arena = yay_arena_create(0);
+    decoded = yay_from_json_arena("[1, 2, 3]", 0, arena);
+    if (ok) {
+        int64_t n = 0;
+        ok = !decoded.error && decoded.value->type == YAY_ARRAY &&
+             decoded.value->data.array.length == 3 &&
+             yay_int_value(decoded.value->data.array.items[2], &n) && n == 3;
+        if (!ok) printf("\n  arena decode mismatch\n");
+    }
+    yay_arena_destroy(arena);
+
+    /* Malformed documents report positioned errors */
+    static const struct {
+        const char *json;
+        const char *pattern;
+    } bad[] = {
+        {"{\"a\": 1} x", "Trailing characters"},
+        {"nul", "Invalid JSON value"},
+        {"\"open", "Unterminated JSON string"},
+        {"[1, 2", "Unterminated JSON array"},
+        {"{\"a\" 1}", "Expected ':'"},
+        {"01", "Invalid JSON number"},
+        {"\"\\ud800x\"", "Unpaired JSON surrogate"},
+    };
+    for (size_t i = 0; ok && i < sizeof(bad) / sizeof(bad[0]); i++) {
+        decoded = yay_from_json(bad[i].json, 0);
+        ok = decoded.error &&
+             strstr(yay_error_message(decoded.error), bad[i].pattern) != NULL;
+        if (!ok) {
+            printf("\n  bad input %zu: %s\n", i,
+                   decoded.error ? yay_error_message(decoded.error)
+                                 : "(no error)");
+        }
+        yay_result_free(&decoded);
+    }
+    return ok;
+}
+
+static bool run_limits_test(void) {
+    /* A flood of tiny nodes trips the node budget */
+    char flood[4096];
+    size_t at = 0;
+    for (int i = 0; i < 500 && at < sizeof(flood) - 8; i++) {
+        at += (size_t)snprintf(flood + at, sizeof(flood) - at, "- %d\n", i);
+    }
+
+    yay_limits_t limits = {0};
+    limits.max_nodes = 100;
+    yay_result_t result = yay_parse_limited(flood, at, NULL, &limits);
+    bool ok = result.error &&
+              strstr(yay_error_message(result.error), "Node limit") != NULL;
+    if (!ok) {
+        printf("\n  node limit: %s\n",
+               result.error ? yay_error_message(result.error) : "(no error)");
+    }
+    yay_result_free(&result);
+
+    /* The same document parses under a sufficient budget, and a later
+     * unlimited parse is unaffected by the earlier trip */
+    limits.max_nodes = 1000;
+    result = yay_parse_limited(flood, at, NULL, &limits);
+    if (ok) {
+        ok = !result.error;
+        if (!ok) printf("\n  budgeted parse: %s\n",
+                        yay_error_message(result.error));
+    }
+    yay_result_free(&result);
+    result = yay_parse(flood, at, NULL);
+    if (ok) {
+        ok = !result.error;
+        if (!ok) printf("\n  unlimited parse after trip failed\n");
+    }
+    yay_result_free(&result);
+
+    /* Outline nesting deeper than the budget */
+    char deep[4096];
+    at = 0;
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < i; j++) {
+            deep[at++] = ' ';
+            deep[at++] = ' ';
+        }
+        at += (size_t)snprintf(deep + at, sizeof(deep) - at,
+                               i < 39 ? "a:\n" : "a: 1\n");
+    }
+    memset(&limits, 0, sizeof(limits));
+    limits.max_depth = 10;
+    result = yay_parse_limited(deep, at, NULL, &limits);
+    if (ok) {
+        ok = result.error &&
+             strstr(yay_error_message(result.error), "Depth limit") != NULL;
+        if (!ok) {
+            printf("\n  depth limit: %s\n",
+                   result.error ? yay_error_message(result.error)
+                                : "(no error)");
+        }
+    }
+    yay_result_free(&result);
+
+    /* Inline nesting counts against the same budget */
+    result = yay_parse_limited("[[[[[[[[[[[[1]]]]]]]]]]]]", 0, NULL, &limits);
+    if (ok) {
+        ok = result.error &&
+             strstr(yay_error_message(result.error), "Depth limit") != NULL;
+        if (!ok) printf("\n  inline depth limit not enforced\n");
+    }
+    yay_result_free(&result);
+
+    /* String bytes accumulate across values */
+    memset(&limits, 0, sizeof(limits));
+    limits.max_string_bytes = 32;
+    result = yay_parse_limited(
+        "a: 'aaaaaaaaaaaaaaaaaaaa'\n"
+        "b: 'bbbbbbbbbbbbbbbbbbbb'\n", 0, NULL, &limits);
+    if (ok) {
+        ok = result.error &&
+             strstr(yay_error_message(result.error), "String limit") != NULL;
+        if (!ok) {
+            printf("\n  string limit: %s\n",
+                   result.error ? yay_error_message(result.error)
+                                : "(no error)");
+        }
+    }
+    yay_result_free(&result);
+
+    /* NULL limits and zero fields mean unlimited */
+    result = yay_parse_limited(flood, 0, NULL, NULL);
+    if (ok) {
+        ok = !result.error;
+        if (!ok) printf("\n  NULL limits rejected input\n");
+    }
+    yay_result_free(&result);
+    return ok;
+}
+
+static bool run_float_format_test(void) {
+    /* Shortest forms, and integral floats keep a ".0" so they re-parse
+     * as floats */
+    static const struct {
+        double value;
+        const char *expect;
+    } cases[] = {
+        {0.0, "0.0"},          {1.0, "1.0"},
+        {-1.5, "-1.5"},        {0.1, "0.1"},
+        {3.14, "3.14"},        {100.0, "100.0"},
+        {1e6, "1000000.0"},    {1e21, "1e+21"},
+        {1e-6, "0.000001"},    {1e-7, "1e-7"},
+        {5e-324, "5e-324"},
+        {1.7976931348623157e308, "1.7976931348623157e+308"},
+    };
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        yay_value_t *v = yay_float(cases[i].value);
+        char *str = yay_to_string(v);
+        if (!str || strcmp(str, cases[i].expect) != 0) {
+            printf("\n  %.17g formatted as %s, expected %s\n",
+                   cases[i].value, str ? str : "(null)", cases[i].expect);
+            ok = false;
+        }
+        free(str);
+        yay_free(v);
+    }
+
+    /* Every formatted double must parse back bit-exact as a float */
+    static const double tricky[] = {
+        0.30000000000000004, 2.2250738585072014e-308, 9007199254740993.0,
+        123456789.12345679,  1.0 / 3.0,               -0.0,
+    };
+    for (size_t i = 0; ok && i < sizeof(tricky) / sizeof(tricky[0]); i++) {
+        yay_value_t *v = yay_float(tricky[i]);
+        char *str = yay_to_string(v);
+        yay_result_t back = yay_parse(str, 0, NULL);
+        uint64_t want, got = 0;
+        memcpy(&want, &tricky[i], sizeof(want));
+        ok = !back.error && back.value->type == YAY_FLOAT;
+        if (ok) {
+            memcpy(&got, &back.value->data.number, sizeof(got));
+            ok = got == want;
+        }
+        if (!ok) printf("\n  %.17g did not round-trip through %s\n",
+                        tricky[i], str ? str : "(null)");
+        yay_result_free(&back);
+        free(str);
+        yay_free(v);
+    }
+    return ok;
+}
+
+/* Counting allocator: delegates to the C library but tallies each hook */
+typedef struct {
+    size_t mallocs;
+    size_t reallocs;
+    size_t frees;
+} alloc_counts_t;
+
+static void *counting_malloc(size_t size, void *ctx) {
+    ((alloc_counts_t *)ctx)->mallocs++;
+    return malloc(size);
+}
+
+static void *counting_realloc(void *ptr, size_t size, void *ctx) {
+    ((alloc_counts_t *)ctx)->reallocs++;
+    return realloc(ptr, size);
+}
+
+static void counting_free(void *ptr, void *ctx) {
+    ((alloc_counts_t *)ctx)->frees++;
+    free(ptr);
+}
+
+static bool run_allocator_test(void) {
+    const char *source =
+        "name: 'custom allocator'\n"
+        "items: [1, 2, 3]\n"
+        "nested:\n"
+        "  deep: \"value with \\u{e9}scapes\"\n";
+
+    alloc_counts_t counts = {0};
+    yay_set_allocator(counting_malloc, counting_realloc, counting_free,
+                      &counts);
+
+    yay_result_t result = yay_parse(source, 0, NULL);
+    bool ok = !result.error;
+    char *encoded = NULL;
+    if (ok) {
+        encoded = yay_to_string(result.value);
+        ok = encoded != NULL;
+    }
+    free(encoded);
+    yay_result_free(&result);
+
+    /* Every allocation routes through the hooks, teardown included */
+    if (ok) {
+        ok = counts.mallocs > 0 && counts.frees > 0;
+        if (!ok) {
+            printf("\n  hooks not exercised: %zu mallocs, %zu frees\n",
+                   counts.mallocs, counts.frees);
+        }
+    }
+
+    /* NULL restores the defaults; the hooks see no further traffic */
+    yay_set_allocator(NULL, NULL, NULL, NULL);
+    size_t mallocs_before = counts.mallocs;
+    result = yay_parse(source, 0, NULL);
+    if (ok) {
+        ok = !result.error && counts.mallocs == mallocs_before;
+        if (!ok) printf("\n  defaults not restored\n");
+    }
+    yay_result_free(&result);
+    return ok;
+}
+
+static bool run_shrink_test(void) {
+    /* A builder array holds the default capacity of 8; three pushes
+     * leave five slots of slack that shrinking reclaims */
+    yay_value_t *arr = yay_array();
+    for (int i = 0; i < 3; i++) {
+        yay_array_push(arr, yay_int(i));
+    }
+    size_t before = yay_memory_usage(arr);
+    yay_shrink_to_fit(arr);
+    size_t after = yay_memory_usage(arr);
+    bool ok = after == before - 5 * sizeof(yay_value_t *);
+    if (!ok) {
+        printf("\n  array usage %zu -> %zu, expected -%zu bytes\n",
+               before, after, 5 * sizeof(yay_value_t *));
+    }
+    yay_free(arr);
+
+    /* A parsed tree shrinks without changing its content */
+    const char *source =
+        "servers:\n"
+        "  - host: 'alpha'\n"
+        "    port: 8080\n"
+        "  - host: 'beta'\n"
+        "    port: 8081\n"
+        "ratio: 0.75\n";
+    yay_result_t result = yay_parse(source, 0, NULL);
+    if (ok) {
+        ok = !result.error;
+        if (!ok) printf("\n  parse: %s\n", yay_error_message(result.error));
+    }
+    if (ok) {
+        char *want = yay_to_string(result.value);
+        before = yay_memory_usage(result.value);
+        yay_shrink_to_fit(result.value);
+        after = yay_memory_usage(result.value);
+        char *got = yay_to_string(result.value);
+        ok = after < before && want && got && strcmp(want, got) == 0;
+        if (!ok) {
+            printf("\n  parsed tree usage %zu -> %zu\n", before, after);
+        }
+        free(want);
+        free(got);
+    }
+    yay_result_free(&result);
+    return ok;
+}
+
+/* Reformat every test/meh fixture and compare byte-for-byte against its
+ * expected canonical output */
+static bool run_meh_test(void) {
+    bool ok = true;
+    for (int i = 0; meh_fixtures[i].name != NULL; i++) {
+        const meh_fixture_t *fixture = &meh_fixtures[i];
+        yay_writer_t writer;
+        yay_writer_init(&writer);
+        yay_error_t *error =
+            yay_format(fixture->meh_source, 0, NULL, &writer);
+        if (error) {
+            printf("\n  %s: %s\n", fixture->original_name,
+                   yay_error_message(error));
+            yay_error_free(error);
+            yay_writer_free(&writer);
+            ok = false;
+            continue;
+        }
+        char *got = yay_writer_take(&writer);
+        if (!got || strcmp(got, fixture->expected) != 0) {
+            printf("\n  %s: output mismatch\n  expected:\n%s  got:\n%s",
+                   fixture->original_name, fixture->expected,
+                   got ? got : "(null)\n");
+            ok = false;
+        }
+        free(got);
+    }
+    return ok;
+}
+
+/* Compact-format a source and require a single line that reparses to
+ * the expected value */
+/* The inline grammar has no production for a non-empty object inside an
+ * array, so such documents cannot go compact and must be refused */
+static bool has_object_in_array(const yay_value_t *v, bool in_array) {
+    if (!v) return false;
+    if (v->type == YAY_ARRAY) {
+        for (size_t i = 0; i < v->data.array.length; i++) {
+            if (has_object_in_array(v->data.array.items[i], true)) {
+                return true;
+            }
+        }
+    } else if (v->type == YAY_OBJECT) {
+        if (in_array && v->data.object.length) return true;
+        for (size_t i = 0; i < v->data.object.length; i++) {
+            if (has_object_in_array(v->data.object.pairs[i].value, false)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static bool check_compact_format(const char *name, const char *source,
+                                 yay_value_t *expected) {
+    yay_format_options_t options = {0};
+    options.compact = true;
+    yay_writer_t writer;
+    yay_writer_init(&writer);
+    yay_error_t *error = yay_format(source, 0, &options, &writer);
+    if (error) {
+        bool refused = has_object_in_array(expected, false) &&
+            strstr(yay_error_message(error), "No inline form") != NULL;
+        if (!refused) printf("\n  %s: %s\n", name, yay_error_message(error));
+        yay_error_free(error);
+        yay_writer_free(&writer);
+        return refused;
+    }
+    if (has_object_in_array(expected, false)) {
+        printf("\n  %s: expected compact mode to refuse an object in an "
+               "array\n", name);
+        yay_writer_free(&writer);
+        return false;
+    }
+    char *got = yay_writer_take(&writer);
+    bool ok = got != NULL;
+    if (ok && *got) {
+        const char *nl = strchr(got, '\n');
+        ok = nl && nl[1] == '\0';
+        if (!ok) printf("\n  %s: not a single line:\n%s", name, got);
+    }
+    if (ok && (*got || expected)) {
+        yay_result_t reparsed = yay_parse(got, 0, name);
+        ok = !reparsed.error && yay_equal(reparsed.value, expected);
+        if (!ok) {
+            printf("\n  %s: compact output mismatch:\n%s", name, got);
+            if (reparsed.error) {
+                printf("  %s\n", yay_error_message(reparsed.error));
+            }
+        }
+        yay_result_free(&reparsed);
+    }
+    free(got);
+    return ok;
+}
+
+/* Compact mode must turn every fixture, strict or loose, into one line
+ * of valid inline YAY denoting the same value */
+static bool run_compact_format_test(void) {
+    bool ok = true;
+    for (int i = 0; test_fixtures[i].name != NULL; i++) {
+        yay_value_t *expected = test_fixtures[i].make_expected();
+        if (!check_compact_format(test_fixtures[i].name,
+                                  test_fixtures[i].yay_source, expected)) {
+            ok = false;
+        }
+        yay_free(expected);
+    }
+    for (int i = 0; meh_fixtures[i].name != NULL; i++) {
+        const meh_fixture_t *fixture = &meh_fixtures[i];
+        yay_result_t canonical =
+            yay_parse(fixture->expected, 0, fixture->original_name);
+        if (canonical.error) {
+            yay_result_free(&canonical);
+            continue;
+        }
+        if (!check_compact_format(fixture->original_name,
+                                  fixture->meh_source, canonical.value)) {
+            ok = false;
+        }
+        yay_result_free(&canonical);
+    }
+    return ok;
+}
+
+/* Run a single error test fixture */
+/* Check a single error fixture. Quiet, for the same reason as check_test. */
+static bool check_error_test(const error_fixture_t *fixture, const char **why) {
+    /* Parse the invalid YAY source - should fail */
+    /* Use original_name to match expected error message format */
+    yay_result_t result = yay_parse(fixture->nay_source, fixture->nay_len, fixture->original_name);
+    
+    if (!result.error) {
+        *why = "expected error, got success";
+        yay_result_free(&result);
+        return false;
     }
     
-    /* Cleanup */
-    yay_free(expected);
+    /* Validation-only mode must report the same error */
+    yay_error_t *validate_error = NULL;
+    if (yay_validate(fixture->nay_source, fixture->nay_len,
+                     fixture->original_name, &validate_error)) {
+        *why = "validate accepted invalid input";
+        yay_error_free(validate_error);
+        yay_result_free(&result);
+        return false;
+    }
+    bool validate_match =
+        strstr(yay_error_message(validate_error), fixture->error_pattern) != NULL;
+    yay_error_free(validate_error);
+    if (!validate_match) {
+        *why = "validate error mismatch";
+        yay_result_free(&result);
+        return false;
+    }
+
+    /* Check if error message contains expected pattern */
+    bool match = strstr(yay_error_message(result.error),
+                        fixture->error_pattern) != NULL;
+    if (!match) *why = "error message mismatch";
     yay_result_free(&result);
-    
-    return equal;
+    return match;
 }
 
-/* Run a single error test fixture */
 static bool run_error_test(const error_fixture_t *fixture) {
     error_tests_run++;
     
     printf("Testing: %s ... ", fixture->name);
     fflush(stdout);
     
-    /* Parse the invalid YAY source - should fail */
-    /* Use original_name to match expected error message format */
-    yay_result_t result = yay_parse(fixture->nay_source, fixture->nay_len, fixture->original_name);
+    const char *why = NULL;
+    if (check_error_test(fixture, &why)) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        error_tests_passed++;
+        return true;
+    }
     
+    printf(COLOR_RED "FAIL" COLOR_RESET " (%s)\n", why);
+    /* Reparse for diagnostics */
+    yay_result_t result = yay_parse(fixture->nay_source, fixture->nay_len,
+                                    fixture->original_name);
     if (!result.error) {
-        printf(COLOR_RED "FAIL" COLOR_RESET " (expected error, got success)\n");
         char *str = yay_to_string(result.value);
         printf("  Got value: %s\n", str ? str : "(null)");
         free(str);
-        yay_result_free(&result);
-        error_tests_failed++;
-        return false;
-    }
-    
-    /* Check if error message contains expected pattern */
-    if (strstr(result.error->message, fixture->error_pattern) != NULL) {
-        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
-        error_tests_passed++;
-        yay_result_free(&result);
-        return true;
-    } else {
-        printf(COLOR_RED "FAIL" COLOR_RESET " (error message mismatch)\n");
+    } else if (strcmp(why, "error message mismatch") == 0) {
         printf("  Expected pattern: %s\n", fixture->error_pattern);
-        printf("  Got: %s\n", result.error->message);
-        yay_result_free(&result);
-        error_tests_failed++;
-        return false;
+        printf("  Got: %s\n", yay_error_message(result.error));
     }
+    yay_result_free(&result);
+    error_tests_failed++;
+    return false;
 }
 
 /* Run all tests */
@@ -126,6 +1582,235 @@ static void run_all_tests(void) {
         run_test(&test_fixtures[i]);
     }
     
+    printf("\n--- Batch Parsing ---\n\n");
+    tests_run++;
+    printf("Testing: parse_batch ... ");
+    if (run_batch_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: encode_escape ... ");
+    if (run_encode_escape_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: mapped_malformed ... ");
+    if (run_mapped_malformed_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: sorted_lookup ... ");
+    if (run_sorted_lookup_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: stream_feed ... ");
+    if (run_stream_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: bigint_math ... ");
+    if (run_bigint_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: cbor_decode ... ");
+    if (run_cbor_decode_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: reparse ... ");
+    if (run_reparse_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: parse_stats ... ");
+    if (run_stats_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: deep_nesting ... ");
+    if (run_deep_nesting_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: parse_into ... ");
+    if (run_parse_into_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: clone_cow ... ");
+    if (run_clone_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: dedup ... ");
+    if (run_dedup_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: path_query ... ");
+    if (run_path_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: json_decode ... ");
+    if (run_json_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: parse_limits ... ");
+    if (run_limits_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: float_format ... ");
+    if (run_float_format_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: allocator_hooks ... ");
+    if (run_allocator_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: shrink_to_fit ... ");
+    if (run_shrink_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: meh_format ... ");
+    if (run_meh_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: compact_format ... ");
+    if (run_compact_format_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: parse_owned ... ");
+    if (run_owned_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        printf(COLOR_RED "FAIL" COLOR_RESET "\n");
+        tests_failed++;
+    }
+
+    tests_run++;
+    printf("Testing: parse_parallel ... ");
+    if (run_parallel_test()) {
+        printf(COLOR_GREEN "PASS" COLOR_RESET "\n");
+        tests_passed++;
+    } else {
+        tests_failed++;
+    }
+
     printf("\n--- Error Tests (.nay) ---\n\n");
     for (int i = 0; error_fixtures[i].name != NULL; i++) {
         run_error_test(&error_fixtures[i]);
@@ -151,6 +1836,95 @@ static void run_all_tests(void) {
     printf("========================================\n\n");
 }
 
+/* ============================================================================
+ * Sharded Parallel Run
+ * ============================================================================ */
+
+typedef struct {
+    int id;                     /* shard index: takes fixtures id, id+jobs, ... */
+    int jobs;
+    int tests_passed;
+    int tests_failed;
+    int error_tests_passed;
+    int error_tests_failed;
+} test_shard_t;
+
+/* Each worker strides through both fixture tables running the quiet
+ * checks; one printf per failure keeps output whole lines. Doubles as a
+ * concurrency smoke test: every shard calls yay_parse at once. */
+static void *test_shard_worker(void *arg) {
+    test_shard_t *shard = arg;
+    const char *why;
+    for (int i = shard->id; i < TEST_FIXTURE_COUNT; i += shard->jobs) {
+        why = NULL;
+        if (check_test(&test_fixtures[i], &why)) {
+            shard->tests_passed++;
+        } else {
+            printf(COLOR_RED "FAIL" COLOR_RESET ": %s (%s)\n",
+                   test_fixtures[i].name, why);
+            shard->tests_failed++;
+        }
+    }
+    for (int i = shard->id; i < ERROR_FIXTURE_COUNT; i += shard->jobs) {
+        why = NULL;
+        if (check_error_test(&error_fixtures[i], &why)) {
+            shard->error_tests_passed++;
+        } else {
+            printf(COLOR_RED "FAIL" COLOR_RESET ": %s (%s)\n",
+                   error_fixtures[i].name, why);
+            shard->error_tests_failed++;
+        }
+    }
+    return NULL;
+}
+
+/* Run the generated fixtures sharded across worker threads. The
+ * standalone tests stay on the main thread afterwards; they exercise
+ * global state (allocation stats, streams) and are quick anyway. */
+static void run_sharded_tests(int jobs) {
+    if (jobs < 1) jobs = 1;
+    if (jobs > 64) jobs = 64;
+
+    printf("\n");
+    printf("========================================\n");
+    printf("  YAY Parser C Test Suite (-j %d)\n", jobs);
+    printf("========================================\n\n");
+
+    pthread_t threads[64];
+    test_shard_t shards[64];
+    for (int i = 0; i < jobs; i++) {
+        shards[i] = (test_shard_t){.id = i, .jobs = jobs};
+        pthread_create(&threads[i], NULL, test_shard_worker, &shards[i]);
+    }
+    for (int i = 0; i < jobs; i++) {
+        pthread_join(threads[i], NULL);
+        tests_passed += shards[i].tests_passed;
+        tests_failed += shards[i].tests_failed;
+        error_tests_passed += shards[i].error_tests_passed;
+        error_tests_failed += shards[i].error_tests_failed;
+    }
+    tests_run = TEST_FIXTURE_COUNT;
+    error_tests_run = ERROR_FIXTURE_COUNT;
+
+    printf("========================================\n");
+    printf("  Valid tests: %d/%d passed", tests_passed, tests_run);
+    if (tests_failed > 0) {
+        printf(" (" COLOR_RED "%d failed" COLOR_RESET ")", tests_failed);
+    }
+    printf("\n");
+    printf("  Error tests: %d/%d passed", error_tests_passed, error_tests_run);
+    if (error_tests_failed > 0) {
+        printf(" (" COLOR_RED "%d failed" COLOR_RESET ")", error_tests_failed);
+    }
+    printf("\n");
+    printf("  Total: %d/%d passed", tests_passed + error_tests_passed, tests_run + error_tests_run);
+    if (tests_failed + error_tests_failed > 0) {
+        printf(" (" COLOR_RED "%d failed" COLOR_RESET ")", tests_failed + error_tests_failed);
+    }
+    printf("\n");
+    printf("========================================\n\n");
+}
+
 /* Run a specific test by name */
 static bool run_named_test(const char *name) {
     for (int i = 0; test_fixtures[i].name != NULL; i++) {
@@ -192,7 +1966,7 @@ static void parse_file(const char *filename) {
     yay_result_t result = yay_parse(content, size, filename);
     
     if (result.error) {
-        fprintf(stderr, "Parse error: %s\n", result.error->message);
+        fprintf(stderr, "Parse error: %s\n", yay_error_message(result.error));
     } else {
         char *str = yay_to_string(result.value);
         printf("%s\n", str);
@@ -203,6 +1977,78 @@ static void parse_file(const char *filename) {
     free(content);
 }
 
+/* ============================================================================
+ * Fixture Benchmark
+ * ============================================================================ */
+
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Minimum wall time per fixture; short fixtures just iterate more */
+#define BENCH_FIXTURE_SECONDS 0.02
+
+/* Time yay_parse over every valid fixture, reporting ns/parse per
+ * fixture and aggregated per construct category. The corpus is the same
+ * one the tests use, so coverage tracks the fixtures for free. */
+static void run_benchmarks(void) {
+    const char *categories[16];
+    double category_ns[16];
+    long category_parses[16];
+    int category_count = 0;
+
+    printf("%-52s %-8s %12s\n", "fixture", "category", "ns/parse");
+    for (int i = 0; bench_fixtures[i].name != NULL; i++) {
+        bench_fixture_t *fix = &bench_fixtures[i];
+        size_t length = strlen(fix->yay_source);
+
+        /* Warm up and confirm the fixture still parses */
+        yay_result_t warm = yay_parse(fix->yay_source, length, fix->name);
+        bool failed = warm.error != NULL;
+        yay_result_free(&warm);
+        if (failed) {
+            printf("%-52s %-8s %12s\n", fix->name, fix->category, "SKIP");
+            continue;
+        }
+
+        long iterations = 0;
+        double start = bench_now();
+        double elapsed;
+        do {
+            for (int k = 0; k < 64; k++) {
+                yay_result_t r = yay_parse(fix->yay_source, length, fix->name);
+                yay_result_free(&r);
+            }
+            iterations += 64;
+            elapsed = bench_now() - start;
+        } while (elapsed < BENCH_FIXTURE_SECONDS);
+
+        double ns = elapsed * 1e9 / (double)iterations;
+        printf("%-52s %-8s %12.0f\n", fix->name, fix->category, ns);
+
+        int c = 0;
+        while (c < category_count && strcmp(categories[c], fix->category) != 0) {
+            c++;
+        }
+        if (c == category_count && category_count < 16) {
+            categories[category_count] = fix->category;
+            category_ns[category_count] = 0;
+            category_parses[category_count] = 0;
+            category_count++;
+        }
+        category_ns[c] += elapsed * 1e9;
+        category_parses[c] += iterations;
+    }
+
+    printf("\n%-16s %12s\n", "category", "ns/parse");
+    for (int c = 0; c < category_count; c++) {
+        printf("%-16s %12.0f\n", categories[c],
+               category_ns[c] / (double)category_parses[c]);
+    }
+}
+
 /* Print usage */
 static void usage(const char *prog) {
     printf("Usage: %s [options]\n", prog);
@@ -212,6 +2058,8 @@ static void usage(const char *prog) {
     printf("  -l, --list      List all available tests\n");
     printf("  -t, --test NAME Run a specific test by name\n");
     printf("  -f, --file FILE Parse a YAY file and print result\n");
+    printf("  -b, --bench     Time yay_parse over every valid fixture\n");
+    printf("  -j N            Run fixtures sharded across N worker threads\n");
     printf("  -h, --help      Show this help\n");
 }
 
@@ -239,6 +2087,18 @@ int main(int argc, char *argv[]) {
             bool passed = run_named_test(argv[++i]);
             return passed ? 0 : 1;
         }
+        else if (strcmp(argv[i], "-j") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Missing thread count\n");
+                return 1;
+            }
+            run_sharded_tests(atoi(argv[++i]));
+            return (tests_failed + error_tests_failed) > 0 ? 1 : 0;
+        }
+        else if (strcmp(argv[i], "-b") == 0 || strcmp(argv[i], "--bench") == 0) {
+            run_benchmarks();
+            return 0;
+        }
         else if (strcmp(argv[i], "-f") == 0 || strcmp(argv[i], "--file") == 0) {
             if (i + 1 >= argc) {
                 fprintf(stderr, "Missing filename\n");
@@ -2,7 +2,15 @@
  * YAY Parser - C Implementation
  */
 
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "yay.h"
+
+#ifdef YAY_STATS
+#include <time.h>
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -11,16 +19,35 @@
 #include <ctype.h>
 #include <math.h>
 
+#if !defined(_WIN32)
+#include <sys/mman.h>
+
+/* Keyword and escape dispatch tables generated from GRAMMAR.md */
+#include "terminals_gen.h"
+#include "powers_gen.h"
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 /* ============================================================================
  * Internal Types
  * ============================================================================ */
 
-/* Scan line from phase 1 */
+/* Scan line from phase 1. Lines borrow from the parse context's working
+ * copy of the source, so the scanner allocates nothing per line. */
 typedef struct {
-    char *line;         /* Content after indent and leader */
+    const char *line;   /* Content after indent and leader */
     int indent;         /* Number of leading spaces */
-    char *leader;       /* "- " for list items, "" otherwise */
-    int line_num;       /* Zero-based line number */
+    const char *leader; /* "- " for list items, "" otherwise */
+    const char *start;  /* Line start in the scratch copy, for positions */
 } scan_line_t;
 
 /* Token types for phase 2 */
@@ -31,43 +58,160 @@ typedef enum {
     TOKEN_BREAK         /* Blank line */
 } token_type_t;
 
-/* Token from phase 2 */
+/* Token from phase 2. Text borrows from the scan lines; colon is computed
+ * once at lex time so later phases do positional lookups instead of
+ * rescanning the line. */
+/* Tokens carry no line/column fields: their text points into the scratch
+ * copy of the source, so the rare error path reconstructs positions from
+ * the byte offset -- a third less token memory on the hot path. */
 typedef struct {
     token_type_t type;
-    char *text;
+    const char *text;
     int indent;
-    int line_num;
-    int col;
+    int colon;          /* ':' outside quotes in TEXT tokens, -1 if none */
 } token_t;
 
+/* Internal error carrier: the public yay_error_t first, so public error
+ * pointers alias it, plus the raw ingredients for rendering the message
+ * lazily. Parse-time errors live inline in the context (no allocation in
+ * speculative paths that may discard or overwrite them) and are copied to
+ * the heap only when a parse actually fails. */
+#define YAY_ERROR_BASE_MAX 512
+typedef struct {
+    yay_error_t error;              /* must be first */
+    char base[YAY_ERROR_BASE_MAX];  /* message before position decoration */
+    char *filename;                 /* owned copy, NULL when none applies */
+    bool located;                   /* decorate with "at line:col of <...>" */
+} yay_error_impl_t;
+
 /* Parse context */
 typedef struct {
     const char *filename;
     const char *source;
     size_t source_len;
+    char *scratch;      /* Mutable copy of source, split into lines in place */
+    bool adopt_source;  /* scratch is the caller's own buffer, not a copy */
     
     /* Scan lines */
     scan_line_t *lines;
     size_t line_count;
     size_t line_capacity;
-    
-    /* Tokens */
-    token_t *tokens;
-    size_t token_count;
-    size_t token_capacity;
-    
-    /* Error */
+
+    /* Byte offset of every source line's start, built once in scan();
+     * error positions are reconstructed from token text pointers by
+     * binary search instead of being carried on every token */
+    size_t *line_starts;
+    size_t line_start_count;
+    
+    /* Token window: chunked deque fed lazily by the outline lexer */
+    token_t **token_chunks;
+    size_t chunk_count;
+    size_t chunk_capacity;
+    size_t token_base;      /* absolute index of token_chunks[0][0] */
+    size_t token_limit;     /* one past the last lexed token */
+    token_t *spare_chunk;   /* recycled chunk awaiting reuse */
+
+    /* Incremental scanner state: the cursor trails the lexer by at most
+     * one chunk of lines */
+    size_t scan_offset;     /* next unscanned byte of scratch */
+    int scan_line_num;
+    bool scan_done;
+
+    /* Incremental lexer state */
+    size_t lex_line;        /* next scan line to lex */
+    int lex_stack[256];     /* indent stack */
+    int lex_stack_top;
+    int lex_top;
+    bool lex_broken;
+    bool lex_done;
+    
+    /* Streaming events (NULL for tree-building parses) */
+    const yay_callbacks_t *events;
+    void *user_data;
+    bool events_aborted;
+
+    /* Interned object keys: open-addressed table of key cells, one per
+     * distinct name seen during this parse */
+    char **intern;
+    size_t intern_count;
+    size_t intern_capacity;
+
+    /* Compact mode: null/true/false become shared singleton nodes */
+    bool compact;
+
+    /* Borrowed mode: escape-free strings view into scratch, whose
+     * lifetime is handed to the caller's arena */
+    bool borrow;
+
+    /* Open inline containers, checked against yay_parse_limited's depth
+     * budget (outline nesting is checked on the frame stack instead) */
+    int inline_depth;
+
+    /* Error: error points at error_box while parsing; the box is copied
+     * to the heap only when the error escapes to the caller */
     yay_error_t *error;
+    yay_error_impl_t error_box;
 } parse_ctx_t;
 
 /* ============================================================================
  * Memory Helpers
  * ============================================================================ */
 
+/* Every heap allocation in the library funnels through these hooks so
+ * embedders can route parser memory into their own allocator (per-request
+ * arenas, tenant accounting). The defaults are the C library's. */
+
+static void *default_malloc(size_t size, void *ctx) {
+    (void)ctx;
+    return malloc(size);
+}
+
+static void *default_realloc(void *ptr, size_t size, void *ctx) {
+    (void)ctx;
+    return realloc(ptr, size);
+}
+
+static void default_free(void *ptr, void *ctx) {
+    (void)ctx;
+    free(ptr);
+}
+
+static yay_malloc_fn allocator_malloc = default_malloc;
+static yay_realloc_fn allocator_realloc = default_realloc;
+static yay_free_fn allocator_free = default_free;
+static void *allocator_ctx = NULL;
+
+void yay_set_allocator(yay_malloc_fn malloc_fn, yay_realloc_fn realloc_fn,
+                       yay_free_fn free_fn, void *ctx) {
+    allocator_malloc = malloc_fn ? malloc_fn : default_malloc;
+    allocator_realloc = realloc_fn ? realloc_fn : default_realloc;
+    allocator_free = free_fn ? free_fn : default_free;
+    allocator_ctx = malloc_fn ? ctx : NULL;
+}
+
+static void *mem_alloc(size_t size) {
+    return allocator_malloc(size, allocator_ctx);
+}
+
+static void *mem_calloc(size_t count, size_t size) {
+    if (size && count > SIZE_MAX / size) return NULL;
+    void *p = allocator_malloc(count * size, allocator_ctx);
+    if (p) memset(p, 0, count * size);
+    return p;
+}
+
+static void *mem_realloc(void *ptr, size_t size) {
+    return allocator_realloc(ptr, size, allocator_ctx);
+}
+
+static void mem_free(void *ptr) {
+    if (ptr) allocator_free(ptr, allocator_ctx);
+}
+
 static char *str_dup(const char *s) {
     if (!s) return NULL;
     size_t len = strlen(s);
-    char *copy = malloc(len + 1);
+    char *copy = mem_alloc(len + 1);
     if (copy) {
         memcpy(copy, s, len + 1);
     }
@@ -76,7 +220,305 @@ static char *str_dup(const char *s) {
 
 static char *str_dup_len(const char *s, size_t len) {
     if (!s) return NULL;
-    char *copy = malloc(len + 1);
+    char *copy = mem_alloc(len + 1);
+    if (copy) {
+        memcpy(copy, s, len);
+        copy[len] = '\0';
+    }
+    return copy;
+}
+
+/* ============================================================================
+ * Arena Allocator
+ * ============================================================================ */
+
+#define YAY_ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+#define YAY_ARENA_ALIGN sizeof(max_align_t)
+
+typedef struct yay_arena_block {
+    struct yay_arena_block *next;
+    size_t used;
+    size_t capacity;
+    /* Slab data follows the header */
+} yay_arena_block_t;
+
+/* Foreign buffers whose lifetime is tied to the arena (borrowed-mode
+ * scratch copies that parsed strings point into) */
+typedef struct yay_arena_adopted {
+    struct yay_arena_adopted *next;
+    char *ptr;
+} yay_arena_adopted_t;
+
+struct yay_arena {
+    yay_arena_block_t *head;
+    size_t block_size;
+    yay_arena_adopted_t *adopted;
+};
+
+yay_arena_t *yay_arena_create(size_t block_size) {
+    yay_arena_t *arena = mem_calloc(1, sizeof(yay_arena_t));
+    if (arena) {
+        arena->block_size = block_size ? block_size : YAY_ARENA_DEFAULT_BLOCK_SIZE;
+    }
+    return arena;
+}
+
+void yay_arena_destroy(yay_arena_t *arena) {
+    if (!arena) return;
+    yay_arena_block_t *block = arena->head;
+    while (block) {
+        yay_arena_block_t *next = block->next;
+        mem_free(block);
+        block = next;
+    }
+    yay_arena_adopted_t *adopted = arena->adopted;
+    while (adopted) {
+        yay_arena_adopted_t *next = adopted->next;
+        mem_free(adopted->ptr);
+        mem_free(adopted);
+        adopted = next;
+    }
+    mem_free(arena);
+}
+
+static void arena_adopt(yay_arena_t *arena, char *ptr) {
+    yay_arena_adopted_t *node = mem_alloc(sizeof(yay_arena_adopted_t));
+    if (!node) return;
+    node->ptr = ptr;
+    node->next = arena->adopted;
+    arena->adopted = node;
+}
+
+static void *arena_alloc(yay_arena_t *arena, size_t size) {
+    size = (size + YAY_ARENA_ALIGN - 1) & ~(YAY_ARENA_ALIGN - 1);
+    yay_arena_block_t *block = arena->head;
+    if (!block || block->used + size > block->capacity) {
+        size_t capacity = arena->block_size;
+        if (size > capacity) capacity = size;
+        block = mem_alloc(sizeof(yay_arena_block_t) + capacity);
+        if (!block) return NULL;
+        block->next = arena->head;
+        block->used = 0;
+        block->capacity = capacity;
+        arena->head = block;
+    }
+    void *p = (char *)(block + 1) + block->used;
+    block->used += size;
+    return p;
+}
+
+/* Arena active for the duration of yay_parse_arena. While set, all value
+ * allocations are bump-allocated and individual frees become no-ops; the
+ * whole document is released by yay_arena_destroy. */
+static _Thread_local yay_arena_t *current_arena = NULL;
+
+/* Budgets active for the duration of yay_parse_limited. Spending is
+ * charged where resources are actually committed — nodes in node_alloc,
+ * string bytes in value_strdup — so a hostile document trips its budget
+ * at the first over-limit allocation instead of after a full parse; the
+ * parse loops notice the trip and abort. */
+static _Thread_local const yay_limits_t *current_limits = NULL;
+static _Thread_local size_t limit_nodes_spent;
+static _Thread_local size_t limit_string_bytes_spent;
+static _Thread_local const char *limit_exceeded;
+
+static bool limit_charge_node(void) {
+    if (!current_limits || current_limits->max_nodes == 0) return true;
+    if (limit_nodes_spent >= current_limits->max_nodes) {
+        limit_exceeded = "Node limit exceeded";
+        return false;
+    }
+    limit_nodes_spent++;
+    return true;
+}
+
+static bool limit_charge_string(size_t bytes) {
+    if (!current_limits || current_limits->max_string_bytes == 0) return true;
+    if (bytes > current_limits->max_string_bytes - limit_string_bytes_spent) {
+        limit_exceeded = "String limit exceeded";
+        return false;
+    }
+    limit_string_bytes_spent += bytes;
+    return true;
+}
+
+static bool limit_charge_depth(size_t depth) {
+    if (!current_limits || current_limits->max_depth == 0) return true;
+    if (depth >= current_limits->max_depth) {
+        limit_exceeded = "Depth limit exceeded";
+        return false;
+    }
+    return true;
+}
+
+/* ============================================================================
+ * Per-Phase Instrumentation (-DYAY_STATS)
+ * ============================================================================
+ *
+ * When the library is built with -DYAY_STATS, every parse records wall time
+ * and allocation counts per phase (scan, outline lex, tree build) plus
+ * line/token/node totals into thread-local storage, retrievable afterwards
+ * with yay_parse_stats. Without the flag the macros below compile to
+ * nothing and yay_parse_stats reports zeros.
+ */
+
+#ifdef YAY_STATS
+
+static _Thread_local yay_stats_t stats_current;
+
+/* Which phase's allocation counter is live; NULL outside a parse */
+static _Thread_local size_t *stats_alloc_slot;
+
+static double stats_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+#define STATS_COUNT(field, n) (stats_current.field += (n))
+#define STATS_ALLOC() \
+    do { \
+        if (stats_alloc_slot) (*stats_alloc_slot)++; \
+    } while (0)
+#define STATS_NODE(size) \
+    do { \
+        if (stats_alloc_slot && (size) == sizeof(yay_value_t)) \
+            stats_current.nodes++; \
+    } while (0)
+
+#else
+
+#define STATS_COUNT(field, n) ((void)0)
+#define STATS_ALLOC() ((void)0)
+#define STATS_NODE(size) ((void)0)
+
+#endif
+
+void yay_parse_stats(yay_stats_t *stats) {
+#ifdef YAY_STATS
+    *stats = stats_current;
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+static void *value_alloc(size_t size) {
+    STATS_ALLOC();
+    if (current_arena) return arena_alloc(current_arena, size);
+    return mem_alloc(size);
+}
+
+static void *value_zalloc(size_t size) {
+    STATS_ALLOC();
+    STATS_NODE(size);
+    if (current_arena) {
+        void *p = arena_alloc(current_arena, size);
+        if (p) memset(p, 0, size);
+        return p;
+    }
+    return mem_calloc(1, size);
+}
+
+static void *value_grow(void *p, size_t old_size, size_t new_size) {
+    STATS_ALLOC();
+    if (current_arena) {
+        void *q = arena_alloc(current_arena, new_size);
+        if (q && p) memcpy(q, p, old_size);
+        return q;
+    }
+    return mem_realloc(p, new_size);
+}
+
+static void value_free(void *p) {
+    if (current_arena) return;
+    mem_free(p);
+}
+
+/* Thread-local cache of yay_value_t-sized blocks. Build/destroy cycles
+ * recycle nodes within each thread instead of crossing the allocator's
+ * central lock on every constructor call. Bounded so idle threads do
+ * not pin memory; worker threads drain their cache on exit through a
+ * pthread key destructor. */
+#define NODE_CACHE_MAX 256
+
+typedef struct node_cache_entry {
+    struct node_cache_entry *next;
+} node_cache_entry_t;
+
+static _Thread_local node_cache_entry_t *node_cache;
+static _Thread_local size_t node_cache_count;
+
+static pthread_key_t node_cache_key;
+static pthread_once_t node_cache_once = PTHREAD_ONCE_INIT;
+
+static void node_cache_drain(void *unused) {
+    (void)unused;
+    while (node_cache) {
+        node_cache_entry_t *entry = node_cache;
+        node_cache = entry->next;
+        mem_free(entry);
+    }
+    node_cache_count = 0;
+}
+
+static void node_cache_register(void) {
+    pthread_key_create(&node_cache_key, node_cache_drain);
+}
+
+/* Allocate one zeroed value node, preferring the thread's cache */
+static yay_value_t *node_alloc(void) {
+    if (!limit_charge_node()) return NULL;
+    STATS_ALLOC();
+    STATS_NODE(sizeof(yay_value_t));
+    if (current_arena) {
+        void *p = arena_alloc(current_arena, sizeof(yay_value_t));
+        if (p) memset(p, 0, sizeof(yay_value_t));
+        return p;
+    }
+    if (node_cache) {
+        node_cache_entry_t *entry = node_cache;
+        node_cache = entry->next;
+        node_cache_count--;
+        memset(entry, 0, sizeof(yay_value_t));
+        return (yay_value_t *)entry;
+    }
+    return mem_calloc(1, sizeof(yay_value_t));
+}
+
+/* Release one value node into the thread's cache (or the heap when the
+ * cache is full). Nodes may be freed on a different thread than the one
+ * that allocated them; the blocks are plain heap blocks either way. */
+static void node_free(yay_value_t *v) {
+    if (current_arena) return;
+    if (node_cache_count < NODE_CACHE_MAX) {
+        node_cache_entry_t *entry = (node_cache_entry_t *)v;
+        if (!node_cache) {
+            pthread_once(&node_cache_once, node_cache_register);
+            pthread_setspecific(node_cache_key, (void *)1);
+        }
+        entry->next = node_cache;
+        node_cache = entry;
+        node_cache_count++;
+        return;
+    }
+    mem_free(v);
+}
+
+static char *value_strdup(const char *s) {
+    if (!s) return NULL;
+    size_t len = strlen(s);
+    if (!limit_charge_string(len)) return NULL;
+    char *copy = value_alloc(len + 1);
+    if (copy) {
+        memcpy(copy, s, len + 1);
+    }
+    return copy;
+}
+
+static char *value_strdup_len(const char *s, size_t len) {
+    if (!s) return NULL;
+    if (!limit_charge_string(len)) return NULL;
+    char *copy = value_alloc(len + 1);
     if (copy) {
         memcpy(copy, s, len);
         copy[len] = '\0';
@@ -84,18 +526,57 @@ static char *str_dup_len(const char *s, size_t len) {
     return copy;
 }
 
+/* ============================================================================
+ * Key Cells
+ * ============================================================================ */
+
+/* Object keys are refcounted cells so the parser's intern table can share
+ * one allocation across the thousands of records that repeat the same ~20
+ * key names. Callers only ever see the char* into the cell body. */
+typedef struct {
+    size_t refs;
+    char key[];
+} key_cell_t;
+
+static yay_value_t *value_unshare(yay_value_t *value);
+
+static char *key_cell_create(const char *key) {
+    key_cell_t *cell = value_alloc(sizeof(key_cell_t) + strlen(key) + 1);
+    if (!cell) return NULL;
+    cell->refs = 1;
+    strcpy(cell->key, key);
+    return cell->key;
+}
+
+static key_cell_t *key_cell_of(char *key) {
+    return (key_cell_t *)(key - offsetof(key_cell_t, key));
+}
+
+static char *key_retain(char *key) {
+    __atomic_fetch_add(&key_cell_of(key)->refs, 1, __ATOMIC_RELAXED);
+    return key;
+}
+
+static void key_release(char *key) {
+    if (!key) return;
+    key_cell_t *cell = key_cell_of(key);
+    if (__atomic_fetch_sub(&cell->refs, 1, __ATOMIC_ACQ_REL) == 1) {
+        value_free(cell);
+    }
+}
+
 /* ============================================================================
  * Value Constructors
  * ============================================================================ */
 
 yay_value_t *yay_null(void) {
-    yay_value_t *v = calloc(1, sizeof(yay_value_t));
+    yay_value_t *v = node_alloc();
     if (v) v->type = YAY_NULL;
     return v;
 }
 
 yay_value_t *yay_bool(bool value) {
-    yay_value_t *v = calloc(1, sizeof(yay_value_t));
+    yay_value_t *v = node_alloc();
     if (v) {
         v->type = YAY_BOOL;
         v->data.boolean = value;
@@ -103,26 +584,260 @@ yay_value_t *yay_bool(bool value) {
     return v;
 }
 
+/* Accumulate a digit string into an int64, rejecting overflow */
+static bool bigint_fits_int64(const char *digits, bool negative, int64_t *out) {
+    if (!digits || !*digits) return false;
+    uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    uint64_t acc = 0;
+    for (const char *p = digits; *p; p++) {
+        if (*p < '0' || *p > '9') return false;
+        unsigned d = (unsigned)(*p - '0');
+        if (acc > (limit - d) / 10) return false;
+        acc = acc * 10 + d;
+    }
+    *out = negative ? (int64_t)(0 - acc) : (int64_t)acc;
+    return true;
+}
+
 yay_value_t *yay_int_from_str(const char *digits, bool negative) {
-    yay_value_t *v = calloc(1, sizeof(yay_value_t));
+    yay_value_t *v = node_alloc();
     if (v) {
         v->type = YAY_INT;
-        v->data.bigint.digits = str_dup(digits);
         v->data.bigint.negative = negative;
+        /* Leading zeros must survive verbatim, so they stay on the heap */
+        int64_t small;
+        if (!(digits[0] == '0' && digits[1] != '\0') &&
+            bigint_fits_int64(digits, negative, &small)) {
+            v->data.bigint.small = small;
+        } else {
+            v->data.bigint.digits = value_strdup(digits);
+        }
     }
     return v;
 }
 
 yay_value_t *yay_int(int64_t value) {
-    char buf[32];
-    bool negative = value < 0;
-    if (negative) value = -value;
-    snprintf(buf, sizeof(buf), "%lld", (long long)value);
-    return yay_int_from_str(buf, negative);
+    yay_value_t *v = node_alloc();
+    if (v) {
+        v->type = YAY_INT;
+        v->data.bigint.small = value;
+        v->data.bigint.negative = value < 0;
+    }
+    return v;
+}
+
+bool yay_int_value(const yay_value_t *value, int64_t *out) {
+    if (!value || value->type != YAY_INT || !out) return false;
+    if (!value->data.bigint.digits) {
+        *out = value->data.bigint.small;
+        return true;
+    }
+    return bigint_fits_int64(value->data.bigint.digits,
+                             value->data.bigint.negative, out);
+}
+
+/* ============================================================================
+ * Bignum Arithmetic
+ * ============================================================================
+ *
+ * Magnitudes convert lazily from the decimal digit string to little-endian
+ * base-2^64 limbs, cached on the operand, so aggregation loops pay for the
+ * string conversion once and then run on machine words. All limb arrays
+ * are normalized: no leading zero limbs, and zero has count 0.
+ */
+
+/* Multiply limbs by 10 and add one decimal digit, in 32-bit halves so no
+ * 128-bit arithmetic is needed */
+static void limbs_mul10_add(uint64_t *limbs, size_t count, unsigned digit,
+                            uint64_t *carry_out) {
+    uint64_t carry = digit;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t lo = (limbs[i] & 0xffffffffu) * 10 + carry;
+        uint64_t hi = (limbs[i] >> 32) * 10 + (lo >> 32);
+        limbs[i] = (hi << 32) | (lo & 0xffffffffu);
+        carry = hi >> 32;
+    }
+    *carry_out = carry;
+}
+
+/* Ensure the operand's limb cache is populated. Returns false on OOM. */
+static bool bigint_limbs(yay_bigint_t *value) {
+    if (value->limbs) return true;
+    if (!value->digits) {
+        /* Inline value: at most one limb of magnitude */
+        uint64_t magnitude;
+        if (value->small < 0) {
+            magnitude = (uint64_t)(-(value->small + 1)) + 1;
+        } else {
+            magnitude = (uint64_t)value->small;
+        }
+        value->limbs = mem_alloc(sizeof(uint64_t));
+        if (!value->limbs) return false;
+        value->limbs[0] = magnitude;
+        value->limb_count = magnitude ? 1 : 0;
+        return true;
+    }
+    /* Each limb holds a bit over 19 decimal digits */
+    size_t capacity = strlen(value->digits) / 19 + 1;
+    uint64_t *limbs = mem_alloc(capacity * sizeof(uint64_t));
+    if (!limbs) return false;
+    size_t count = 0;
+    for (const char *p = value->digits; *p; p++) {
+        uint64_t carry;
+        limbs_mul10_add(limbs, count, (unsigned)(*p - '0'), &carry);
+        if (carry) limbs[count++] = carry;
+    }
+    value->limbs = limbs;
+    value->limb_count = count;
+    return true;
+}
+
+/* Render limbs back to a decimal digit string (malloc'd, no sign) */
+static char *limbs_to_decimal(const uint64_t *limbs, size_t count) {
+    if (count == 0) return str_dup("0");
+    /* Each limb contributes at most 20 decimal digits */
+    size_t capacity = count * 20 + 1;
+    char *digits = mem_alloc(capacity);
+    uint64_t *work = mem_alloc(count * sizeof(uint64_t));
+    if (!digits || !work) {
+        mem_free(digits);
+        mem_free(work);
+        return NULL;
+    }
+    memcpy(work, limbs, count * sizeof(uint64_t));
+    size_t length = 0;
+    while (count > 0) {
+        /* Divide the magnitude by 10, most significant limb first */
+        uint64_t remainder = 0;
+        for (size_t i = count; i > 0; i--) {
+            /* (remainder:work[i-1]) / 10 in 32-bit halves */
+            uint64_t part = remainder << 32 | work[i - 1] >> 32;
+            uint64_t hi = part / 10;
+            remainder = part % 10;
+            part = remainder << 32 | (work[i - 1] & 0xffffffffu);
+            uint64_t lo = part / 10;
+            remainder = part % 10;
+            work[i - 1] = hi << 32 | lo;
+        }
+        digits[length++] = (char)('0' + remainder);
+        while (count > 0 && work[count - 1] == 0) count--;
+    }
+    for (size_t i = 0; i < length / 2; i++) {
+        char tmp = digits[i];
+        digits[i] = digits[length - 1 - i];
+        digits[length - 1 - i] = tmp;
+    }
+    digits[length] = '\0';
+    mem_free(work);
+    return digits;
+}
+
+/* Compare magnitudes only */
+static int limbs_cmp(const uint64_t *a, size_t a_count,
+                     const uint64_t *b, size_t b_count) {
+    if (a_count != b_count) return a_count < b_count ? -1 : 1;
+    for (size_t i = a_count; i > 0; i--) {
+        if (a[i - 1] != b[i - 1]) return a[i - 1] < b[i - 1] ? -1 : 1;
+    }
+    return 0;
+}
+
+int yay_bigint_cmp(yay_bigint_t *a, yay_bigint_t *b) {
+    if (!bigint_limbs(a) || !bigint_limbs(b)) {
+        /* OOM: fall back to a sign-only comparison of what we know */
+        return 0;
+    }
+    bool a_negative = a->negative && a->limb_count > 0;
+    bool b_negative = b->negative && b->limb_count > 0;
+    if (a_negative != b_negative) return a_negative ? -1 : 1;
+    int magnitude = limbs_cmp(a->limbs, a->limb_count, b->limbs, b->limb_count);
+    return a_negative ? -magnitude : magnitude;
+}
+
+bool yay_bigint_to_int64(const yay_bigint_t *value, int64_t *out) {
+    if (!value->digits) {
+        *out = value->small;
+        return true;
+    }
+    return bigint_fits_int64(value->digits, value->negative, out);
+}
+
+void yay_bigint_clear(yay_bigint_t *value) {
+    if (!value) return;
+    mem_free(value->digits);
+    mem_free(value->limbs);
+    memset(value, 0, sizeof(*value));
+}
+
+bool yay_bigint_add(yay_bigint_t *a, yay_bigint_t *b, yay_bigint_t *out) {
+    memset(out, 0, sizeof(*out));
+    if (!bigint_limbs(a) || !bigint_limbs(b)) return false;
+
+    bool a_negative = a->negative && a->limb_count > 0;
+    bool b_negative = b->negative && b->limb_count > 0;
+    size_t capacity = (a->limb_count > b->limb_count ? a->limb_count
+                                                     : b->limb_count) + 1;
+    uint64_t *limbs = mem_calloc(capacity, sizeof(uint64_t));
+    if (!limbs) return false;
+    size_t count;
+
+    if (a_negative == b_negative) {
+        /* Same sign: add magnitudes */
+        uint64_t carry = 0;
+        for (size_t i = 0; i < capacity - 1; i++) {
+            uint64_t x = i < a->limb_count ? a->limbs[i] : 0;
+            uint64_t y = i < b->limb_count ? b->limbs[i] : 0;
+            uint64_t sum = x + y;
+            uint64_t with_carry = sum + carry;
+            carry = (sum < x) || (with_carry < sum);
+            limbs[i] = with_carry;
+        }
+        limbs[capacity - 1] = carry;
+        count = capacity;
+        out->negative = a_negative;
+    } else {
+        /* Opposite signs: subtract the smaller magnitude from the larger */
+        int magnitude = limbs_cmp(a->limbs, a->limb_count,
+                                  b->limbs, b->limb_count);
+        const yay_bigint_t *large = magnitude >= 0 ? a : b;
+        const yay_bigint_t *small = magnitude >= 0 ? b : a;
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < large->limb_count; i++) {
+            uint64_t x = large->limbs[i];
+            uint64_t y = i < small->limb_count ? small->limbs[i] : 0;
+            uint64_t diff = x - y;
+            uint64_t with_borrow = diff - borrow;
+            borrow = (diff > x) || (with_borrow > diff);
+            limbs[i] = with_borrow;
+        }
+        count = large->limb_count;
+        out->negative = magnitude >= 0 ? a_negative : b_negative;
+    }
+    while (count > 0 && limbs[count - 1] == 0) count--;
+    if (count == 0) out->negative = false;
+
+    /* Inline the result when it fits an int64 */
+    uint64_t limit = out->negative ? (uint64_t)INT64_MAX + 1
+                                   : (uint64_t)INT64_MAX;
+    if (count == 0 || (count == 1 && limbs[0] <= limit)) {
+        uint64_t magnitude = count ? limbs[0] : 0;
+        out->small = out->negative ? (int64_t)(0 - magnitude)
+                                   : (int64_t)magnitude;
+        mem_free(limbs);
+        return true;
+    }
+    out->digits = limbs_to_decimal(limbs, count);
+    if (!out->digits) {
+        mem_free(limbs);
+        return false;
+    }
+    out->limbs = limbs;
+    out->limb_count = count;
+    return true;
 }
 
 yay_value_t *yay_float(double value) {
-    yay_value_t *v = calloc(1, sizeof(yay_value_t));
+    yay_value_t *v = node_alloc();
     if (v) {
         v->type = YAY_FLOAT;
         v->data.number = value;
@@ -131,30 +846,30 @@ yay_value_t *yay_float(double value) {
 }
 
 yay_value_t *yay_string(const char *str) {
-    yay_value_t *v = calloc(1, sizeof(yay_value_t));
+    yay_value_t *v = node_alloc();
     if (v) {
         v->type = YAY_STRING;
-        v->data.string = str_dup(str);
+        v->data.string = value_strdup(str);
     }
     return v;
 }
 
 yay_value_t *yay_string_len(const char *str, size_t len) {
-    yay_value_t *v = calloc(1, sizeof(yay_value_t));
+    yay_value_t *v = node_alloc();
     if (v) {
         v->type = YAY_STRING;
-        v->data.string = str_dup_len(str, len);
+        v->data.string = value_strdup_len(str, len);
     }
     return v;
 }
 
 yay_value_t *yay_bytes(const uint8_t *data, size_t length) {
-    yay_value_t *v = calloc(1, sizeof(yay_value_t));
+    yay_value_t *v = node_alloc();
     if (v) {
         v->type = YAY_BYTES;
         v->data.bytes.length = length;
         if (length > 0) {
-            v->data.bytes.data = malloc(length);
+            v->data.bytes.data = value_alloc(length);
             if (v->data.bytes.data) {
                 memcpy(v->data.bytes.data, data, length);
             }
@@ -175,96 +890,459 @@ static int is_uppercase_hex(char c) {
     return c >= 'A' && c <= 'F';
 }
 
+/* Length of the leading run of lowercase hex digits. Byte blocks are
+ * dominated by long unbroken digit lines, so the gather loops memcpy clean
+ * runs wholesale and fall back to the per-character path only at spaces,
+ * comments, and invalid digits. */
+static size_t hex_clean_span(const char *s, size_t length) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    while (i + 16 <= length) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(s + i));
+        __m128i digit = _mm_and_si128(
+            _mm_cmpgt_epi8(chunk, _mm_set1_epi8('0' - 1)),
+            _mm_cmplt_epi8(chunk, _mm_set1_epi8('9' + 1)));
+        __m128i alpha = _mm_and_si128(
+            _mm_cmpgt_epi8(chunk, _mm_set1_epi8('a' - 1)),
+            _mm_cmplt_epi8(chunk, _mm_set1_epi8('f' + 1)));
+        int mask = _mm_movemask_epi8(_mm_or_si128(digit, alpha));
+        if (mask != 0xFFFF) {
+            return i + (size_t)__builtin_ctz(~(unsigned)mask);
+        }
+        i += 16;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    while (i + 16 <= length) {
+        uint8x16_t chunk = vld1q_u8((const uint8_t *)(s + i));
+        uint8x16_t digit = vandq_u8(vcgeq_u8(chunk, vdupq_n_u8('0')),
+                                    vcleq_u8(chunk, vdupq_n_u8('9')));
+        uint8x16_t alpha = vandq_u8(vcgeq_u8(chunk, vdupq_n_u8('a')),
+                                    vcleq_u8(chunk, vdupq_n_u8('f')));
+        if (vminvq_u8(vorrq_u8(digit, alpha)) != 0xFF) {
+            break;
+        }
+        i += 16;
+    }
+#endif
+    while (i < length &&
+           ((s[i] >= '0' && s[i] <= '9') || (s[i] >= 'a' && s[i] <= 'f'))) {
+        i++;
+    }
+    return i;
+}
+
+/* Decode validated hex pairs into bytes: 16 digits in, 8 bytes out per
+ * vector step. Callers have already rejected non-hex characters, so the
+ * nibble conversion is branch-free (low nibble, plus 9 for letters). */
+static void hex_decode(const char *hex, size_t length, uint8_t *out) {
+    size_t i = 0;
+    size_t j = 0;
+#if defined(__SSE2__)
+    while (i + 16 <= length) {
+        __m128i chars = _mm_loadu_si128((const __m128i *)(hex + i));
+        __m128i alpha = _mm_cmpgt_epi8(chars, _mm_set1_epi8('9'));
+        __m128i nib = _mm_add_epi8(
+            _mm_and_si128(chars, _mm_set1_epi8(0x0f)),
+            _mm_and_si128(alpha, _mm_set1_epi8(9)));
+        /* Each 16-bit lane holds [hi, lo] digit bytes; merge to hi<<4|lo
+         * and pack the lanes down to 8 output bytes */
+        __m128i hi = _mm_slli_epi16(_mm_and_si128(nib, _mm_set1_epi16(0x00ff)), 4);
+        __m128i lo = _mm_srli_epi16(nib, 8);
+        __m128i bytes = _mm_packus_epi16(_mm_or_si128(hi, lo), _mm_setzero_si128());
+        _mm_storel_epi64((__m128i *)(out + j), bytes);
+        i += 16;
+        j += 8;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    while (i + 16 <= length) {
+        /* vld2 deinterleaves straight into hi-digit and lo-digit lanes */
+        uint8x8x2_t pair = vld2_u8((const uint8_t *)(hex + i));
+        uint8x8_t nine = vdup_n_u8('9');
+        uint8x8_t hi = vadd_u8(vand_u8(pair.val[0], vdup_n_u8(0x0f)),
+                               vand_u8(vcgt_u8(pair.val[0], nine), vdup_n_u8(9)));
+        uint8x8_t lo = vadd_u8(vand_u8(pair.val[1], vdup_n_u8(0x0f)),
+                               vand_u8(vcgt_u8(pair.val[1], nine), vdup_n_u8(9)));
+        vst1_u8(out + j, vorr_u8(vshl_n_u8(hi, 4), lo));
+        i += 16;
+        j += 8;
+    }
+#endif
+    for (; i + 2 <= length; i += 2, j++) {
+        int hi = hex_digit(hex[i]);
+        int lo = hex_digit(hex[i + 1]);
+        out[j] = (hi << 4) | lo;
+    }
+}
+
 yay_value_t *yay_bytes_from_hex(const char *hex) {
     size_t len = strlen(hex);
     size_t byte_len = len / 2;
-    uint8_t *data = malloc(byte_len);
+    uint8_t *data = mem_alloc(byte_len);
     if (!data) return yay_bytes(NULL, 0);
-    
-    for (size_t i = 0; i < byte_len; i++) {
-        int hi = hex_digit(hex[i * 2]);
-        int lo = hex_digit(hex[i * 2 + 1]);
-        data[i] = (hi << 4) | lo;
-    }
-    
+
+    hex_decode(hex, len, data);
+
     yay_value_t *v = yay_bytes(data, byte_len);
-    free(data);
+    mem_free(data);
     return v;
 }
 
 yay_value_t *yay_array(void) {
-    yay_value_t *v = calloc(1, sizeof(yay_value_t));
+    yay_value_t *v = node_alloc();
     if (v) {
         v->type = YAY_ARRAY;
         v->data.array.capacity = 8;
-        v->data.array.items = calloc(8, sizeof(yay_value_t*));
+        v->data.array.items = value_zalloc(8 * sizeof(yay_value_t*));
     }
     return v;
 }
 
 yay_value_t *yay_object(void) {
-    yay_value_t *v = calloc(1, sizeof(yay_value_t));
+    yay_value_t *v = node_alloc();
     if (v) {
         v->type = YAY_OBJECT;
         v->data.object.capacity = 8;
-        v->data.object.pairs = calloc(8, sizeof(yay_pair_t));
+        v->data.object.pairs = value_zalloc(8 * sizeof(yay_pair_t));
+        v->data.object.sorted = true;
     }
     return v;
 }
 
+yay_value_t *yay_array_reserve(yay_value_t *array, size_t capacity) {
+    if (!array || array->type != YAY_ARRAY) return array;
+    array = value_unshare(array);
+    if (!array) return NULL;
+    if (capacity <= array->data.array.capacity) return array;
+    yay_value_t **new_items = value_grow(array->data.array.items,
+                                         array->data.array.capacity * sizeof(yay_value_t*),
+                                         capacity * sizeof(yay_value_t*));
+    if (!new_items) return array;
+    array->data.array.items = new_items;
+    array->data.array.capacity = capacity;
+    return array;
+}
+
 yay_value_t *yay_array_push(yay_value_t *array, yay_value_t *item) {
     if (!array || array->type != YAY_ARRAY) return array;
+    array = value_unshare(array);
+    if (!array) return NULL;
     
     if (array->data.array.length >= array->data.array.capacity) {
-        size_t new_cap = array->data.array.capacity * 2;
-        yay_value_t **new_items = realloc(array->data.array.items, 
-                                          new_cap * sizeof(yay_value_t*));
-        if (!new_items) return array;
-        array->data.array.items = new_items;
-        array->data.array.capacity = new_cap;
+        yay_array_reserve(array, array->data.array.capacity * 2);
+        if (array->data.array.length >= array->data.array.capacity) return array;
     }
     
     array->data.array.items[array->data.array.length++] = item;
     return array;
 }
 
-yay_value_t *yay_object_set(yay_value_t *object, const char *key, yay_value_t *value) {
-    if (!object || object->type != YAY_OBJECT) return object;
-    
-    /* Check for existing key */
+/* FNV-1a hash for object keys */
+static size_t key_hash(const char *key) {
+    uint64_t h = 14695981039346656037ULL;
+    for (const unsigned char *p = (const unsigned char *)key; *p; p++) {
+        h ^= *p;
+        h *= 1099511628211ULL;
+    }
+    return (size_t)h;
+}
+
+/* Objects below this size are scanned linearly; the hash index only pays
+ * for itself once duplicate-key probes stop fitting in a cache line. */
+#define YAY_OBJECT_INDEX_MIN 8
+
+static void object_index_insert(yay_value_t *object, size_t pair_idx) {
+    size_t mask = object->data.object.index_capacity - 1;
+    size_t *index = object->data.object.index;
+    size_t slot = key_hash(object->data.object.pairs[pair_idx].key) & mask;
+    while (index[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    index[slot] = pair_idx + 1;
+}
+
+static void object_index_rebuild(yay_value_t *object) {
+    size_t want = YAY_OBJECT_INDEX_MIN * 2;
+    while (want < object->data.object.length * 2) {
+        want *= 2;
+    }
+    value_free(object->data.object.index);
+    object->data.object.index = value_zalloc(want * sizeof(size_t));
+    if (!object->data.object.index) {
+        object->data.object.index_capacity = 0;
+        return;
+    }
+    object->data.object.index_capacity = want;
+    for (size_t i = 0; i < object->data.object.length; i++) {
+        object_index_insert(object, i);
+    }
+}
+
+/* Find the pair index for a key, or -1 if absent */
+static long object_find(const yay_value_t *object, const char *key) {
+    if (object->data.object.index) {
+        size_t mask = object->data.object.index_capacity - 1;
+        const size_t *index = object->data.object.index;
+        size_t slot = key_hash(key) & mask;
+        while (index[slot] != 0) {
+            size_t pair_idx = index[slot] - 1;
+            if (strcmp(object->data.object.pairs[pair_idx].key, key) == 0) {
+                return (long)pair_idx;
+            }
+            slot = (slot + 1) & mask;
+        }
+        return -1;
+    }
+    if (object->data.object.sorted &&
+        object->data.object.length >= YAY_OBJECT_INDEX_MIN) {
+        /* Index-less but sorted (e.g. a mapped YAYB tree): binary search */
+        size_t lo = 0;
+        size_t hi = object->data.object.length;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            int cmp = strcmp(object->data.object.pairs[mid].key, key);
+            if (cmp == 0) return (long)mid;
+            if (cmp < 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return -1;
+    }
     for (size_t i = 0; i < object->data.object.length; i++) {
         if (strcmp(object->data.object.pairs[i].key, key) == 0) {
-            yay_free(object->data.object.pairs[i].value);
-            object->data.object.pairs[i].value = value;
-            return object;
+            return (long)i;
         }
     }
+    return -1;
+}
+
+yay_value_t *yay_object_reserve(yay_value_t *object, size_t capacity) {
+    if (!object || object->type != YAY_OBJECT) return object;
+    object = value_unshare(object);
+    if (!object) return NULL;
+    if (capacity <= object->data.object.capacity) return object;
+    yay_pair_t *new_pairs = value_grow(object->data.object.pairs,
+                                   object->data.object.capacity * sizeof(yay_pair_t),
+                                   capacity * sizeof(yay_pair_t));
+    if (!new_pairs) return object;
+    object->data.object.pairs = new_pairs;
+    object->data.object.capacity = capacity;
+    return object;
+}
+
+/* Insert a value under an already-built key cell (retains the cell) */
+static yay_value_t *object_set_cell(yay_value_t *object, char *key, yay_value_t *value) {
+    if (!object || object->type != YAY_OBJECT) return object;
+    
+    /* Check for existing key */
+    long existing = object_find(object, key);
+    if (existing >= 0) {
+        yay_free(object->data.object.pairs[existing].value);
+        object->data.object.pairs[existing].value = value;
+        return object;
+    }
     
     if (object->data.object.length >= object->data.object.capacity) {
-        size_t new_cap = object->data.object.capacity * 2;
-        yay_pair_t *new_pairs = realloc(object->data.object.pairs,
-                                        new_cap * sizeof(yay_pair_t));
-        if (!new_pairs) return object;
-        object->data.object.pairs = new_pairs;
-        object->data.object.capacity = new_cap;
+        yay_object_reserve(object, object->data.object.capacity * 2);
+        if (object->data.object.length >= object->data.object.capacity) return object;
     }
     
     size_t idx = object->data.object.length++;
-    object->data.object.pairs[idx].key = str_dup(key);
+    object->data.object.pairs[idx].key = key_retain(key);
     object->data.object.pairs[idx].value = value;
+    if (idx > 0 && object->data.object.sorted &&
+        strcmp(object->data.object.pairs[idx - 1].key, key) >= 0) {
+        object->data.object.sorted = false;
+    }
+    
+    /* Maintain the hash index once the object is big enough */
+    if (object->data.object.index) {
+        if (object->data.object.length * 4 > object->data.object.index_capacity * 3) {
+            object_index_rebuild(object);
+        } else {
+            object_index_insert(object, idx);
+        }
+    } else if (object->data.object.length >= YAY_OBJECT_INDEX_MIN) {
+        object_index_rebuild(object);
+    }
     return object;
 }
 
-yay_value_t *yay_array_of(yay_value_t **items, size_t count) {
-    yay_value_t *arr = yay_array();
-    for (size_t i = 0; i < count; i++) {
-        yay_array_push(arr, items[i]);
-    }
-    return arr;
-}
+yay_value_t *yay_object_set(yay_value_t *object, const char *key, yay_value_t *value) {
+    if (!object || object->type != YAY_OBJECT) return object;
+    object = value_unshare(object);
+    if (!object) return NULL;
+    char *cell = key_cell_create(key);
+    object_set_cell(object, cell, value);
+    key_release(cell);
+    return object;
+}
+
+yay_value_t *yay_object_get(const yay_value_t *object, const char *key) {
+    if (!object || object->type != YAY_OBJECT || !key) return NULL;
+    long idx = object_find(object, key);
+    return idx >= 0 ? object->data.object.pairs[idx].value : NULL;
+}
+
+/* ============================================================================
+ * Path Queries
+ * ============================================================================ */
+
+/* One hop of a compiled path: an object property when key is non-NULL,
+ * an array index otherwise. */
+typedef struct {
+    char *key;
+    size_t index;
+} yay_path_step_t;
+
+struct yay_path {
+    yay_path_step_t *steps;
+    size_t count;
+};
+
+static bool path_key_char(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') || c == '_' || c == '-';
+}
+
+/* Append a step, growing the array; takes ownership of key. */
+static bool path_push(yay_path_t *path, size_t *capacity, char *key,
+                      size_t index) {
+    if (path->count == *capacity) {
+        size_t grown = *capacity ? *capacity * 2 : 4;
+        yay_path_step_t *steps =
+            mem_realloc(path->steps, grown * sizeof(yay_path_step_t));
+        if (!steps) {
+            mem_free(key);
+            return false;
+        }
+        path->steps = steps;
+        *capacity = grown;
+    }
+    path->steps[path->count].key = key;
+    path->steps[path->count].index = index;
+    path->count++;
+    return true;
+}
+
+yay_path_t *yay_path_compile(const char *expression) {
+    if (!expression || !*expression) return NULL;
+
+    yay_path_t *path = mem_calloc(1, sizeof(yay_path_t));
+    if (!path) return NULL;
+    size_t capacity = 0;
+
+    const char *p = expression;
+    bool first = true;
+    while (*p) {
+        if (!first && *p == '.') {
+            p++;
+            if (!*p) goto fail; /* trailing dot */
+        }
+        if (*p == '[') {
+            if (first) goto fail; /* paths start with a property name */
+            p++;
+            if (*p == '\'') {
+                /* Quoted key: '' is a literal quote, as in YAY */
+                p++;
+                size_t len = 0;
+                const char *scan = p;
+                while (*scan) {
+                    if (*scan == '\'') {
+                        if (scan[1] != '\'') break;
+                        scan += 2;
+                    } else {
+                        scan++;
+                    }
+                    len++;
+                }
+                if (*scan != '\'') goto fail; /* unterminated quote */
+                char *key = mem_alloc(len + 1);
+                if (!key) goto fail;
+                size_t at = 0;
+                while (p < scan) {
+                    if (*p == '\'') p++; /* second quote of a '' pair */
+                    key[at++] = *p++;
+                }
+                key[at] = '\0';
+                p = scan + 1;
+                if (*p != ']') {
+                    mem_free(key);
+                    goto fail;
+                }
+                p++;
+                if (!path_push(path, &capacity, key, 0)) goto fail;
+            } else {
+                if (*p < '0' || *p > '9') goto fail;
+                size_t index = 0;
+                while (*p >= '0' && *p <= '9') {
+                    index = index * 10 + (size_t)(*p - '0');
+                    p++;
+                }
+                if (*p != ']') goto fail;
+                p++;
+                if (!path_push(path, &capacity, NULL, index)) goto fail;
+            }
+        } else if (path_key_char(*p)) {
+            const char *start = p;
+            while (path_key_char(*p)) p++;
+            char *key = mem_alloc((size_t)(p - start) + 1);
+            if (!key) goto fail;
+            memcpy(key, start, (size_t)(p - start));
+            key[p - start] = '\0';
+            if (!path_push(path, &capacity, key, 0)) goto fail;
+        } else {
+            goto fail;
+        }
+        first = false;
+    }
+
+    return path;
+
+fail:
+    yay_path_free(path);
+    return NULL;
+}
+
+yay_value_t *yay_get_path(const yay_value_t *value, const yay_path_t *path) {
+    if (!path) return NULL;
+    const yay_value_t *current = value;
+    for (size_t i = 0; i < path->count && current; i++) {
+        const yay_path_step_t *step = &path->steps[i];
+        if (step->key) {
+            current = yay_object_get(current, step->key);
+        } else if (current->type == YAY_ARRAY &&
+                   step->index < current->data.array.length) {
+            current = current->data.array.items[step->index];
+        } else {
+            return NULL;
+        }
+    }
+    return (yay_value_t *)current;
+}
+
+void yay_path_free(yay_path_t *path) {
+    if (!path) return;
+    for (size_t i = 0; i < path->count; i++) {
+        mem_free(path->steps[i].key);
+    }
+    mem_free(path->steps);
+    mem_free(path);
+}
+
+yay_value_t *yay_array_of(yay_value_t **items, size_t count) {
+    yay_value_t *arr = yay_array();
+    yay_array_reserve(arr, count);
+    for (size_t i = 0; i < count; i++) {
+        yay_array_push(arr, items[i]);
+    }
+    return arr;
+}
 
 yay_value_t *yay_object_of(void **kvs, size_t count) {
     yay_value_t *obj = yay_object();
+    yay_object_reserve(obj, count / 2);
     for (size_t i = 0; i + 1 < count; i += 2) {
         yay_object_set(obj, (const char *)kvs[i], (yay_value_t *)kvs[i + 1]);
     }
@@ -275,43 +1353,241 @@ yay_value_t *yay_object_of(void **kvs, size_t count) {
  * Value Destructor
  * ============================================================================ */
 
+/* Placeholder returned by container parsers in events mode, where no tree
+ * is built. Never allocated, never freed. */
+static yay_value_t event_sentinel;
+
+/* ============================================================================
+ * Compact Value Mode
+ * ============================================================================ */
+
+/* Shared immutable nodes for null/true/false: in compact mode every such
+ * scalar in a document points at one of these instead of a heap node.
+ * yay_free recognizes and skips them, so compact trees release normally. */
+static yay_value_t compact_null = { YAY_NULL, 0, { .boolean = false } };
+static yay_value_t compact_true = { YAY_BOOL, 0, { .boolean = true } };
+static yay_value_t compact_false = { YAY_BOOL, 0, { .boolean = false } };
+
+static bool is_shared_value(const yay_value_t *v) {
+    return v == &event_sentinel || v == &compact_null ||
+           v == &compact_true || v == &compact_false;
+}
+
+/* Add a shared owner. Nodes start with refs == 0, which also means
+ * uniquely owned, so the first clone jumps the count to two. */
+static void value_retain(yay_value_t *value) {
+    size_t refs = __atomic_load_n(&value->refs, __ATOMIC_RELAXED);
+    for (;;) {
+        size_t want = refs ? refs + 1 : 2;
+        if (__atomic_compare_exchange_n(&value->refs, &refs, want, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            return;
+        }
+    }
+}
+
+/* Make room to push extra pointers onto the destruction stack, moving off
+ * the caller's inline buffer on first growth. Returns false on OOM. */
+static bool free_stack_reserve(yay_value_t ***stack, size_t *capacity,
+                               size_t length, size_t extra,
+                               yay_value_t **inline_stack) {
+    if (length + extra <= *capacity) return true;
+    size_t cap = *capacity;
+    while (length + extra > cap) cap *= 2;
+    yay_value_t **grown;
+    if (*stack == inline_stack) {
+        grown = mem_alloc(cap * sizeof(*grown));
+        if (grown) memcpy(grown, *stack, length * sizeof(*grown));
+    } else {
+        grown = mem_realloc(*stack, cap * sizeof(*grown));
+    }
+    if (!grown) return false;
+    *stack = grown;
+    *capacity = cap;
+    return true;
+}
+
 void yay_free(yay_value_t *value) {
-    if (!value) return;
-    
+    if (!value || is_shared_value(value)) return;
+
+    /* Iterate with an explicit stack: recursion per nesting level would
+     * overflow on deeply nested documents. Sibling children land on the
+     * stack together, so leaf nodes come off in contiguous free bursts
+     * instead of interleaving with their parents' teardown. */
+    yay_value_t *inline_stack[64];
+    yay_value_t **stack = inline_stack;
+    size_t length = 0;
+    size_t capacity = 64;
+
+    stack[length++] = value;
+    while (length > 0) {
+        yay_value_t *v = stack[--length];
+        if (!v || is_shared_value(v)) continue;
+
+        /* Drop one shared owner; the last one tears the node down */
+        size_t refs = __atomic_load_n(&v->refs, __ATOMIC_ACQUIRE);
+        if (refs > 1 &&
+            __atomic_fetch_sub(&v->refs, 1, __ATOMIC_ACQ_REL) > 1) {
+            continue;
+        }
+
+        switch (v->type) {
+            case YAY_INT:
+                value_free(v->data.bigint.digits);
+                mem_free(v->data.bigint.limbs);
+                break;
+            case YAY_STRING:
+                value_free(v->data.string);
+                break;
+            case YAY_BYTES:
+                value_free(v->data.bytes.data);
+                break;
+            case YAY_ARRAY: {
+                size_t count = v->data.array.length;
+                if (free_stack_reserve(&stack, &capacity, length, count,
+                                       inline_stack)) {
+                    memcpy(stack + length, v->data.array.items,
+                           count * sizeof(*stack));
+                    length += count;
+                } else {
+                    /* OOM growing the stack: fall back to recursion for
+                     * this node's children only */
+                    for (size_t i = 0; i < count; i++) {
+                        yay_free(v->data.array.items[i]);
+                    }
+                }
+                value_free(v->data.array.items);
+                break;
+            }
+            case YAY_OBJECT: {
+                size_t count = v->data.object.length;
+                bool pushed = free_stack_reserve(&stack, &capacity, length,
+                                                 count, inline_stack);
+                for (size_t i = 0; i < count; i++) {
+                    key_release(v->data.object.pairs[i].key);
+                    if (pushed) {
+                        stack[length++] = v->data.object.pairs[i].value;
+                    } else {
+                        yay_free(v->data.object.pairs[i].value);
+                    }
+                }
+                value_free(v->data.object.pairs);
+                value_free(v->data.object.index);
+                break;
+            }
+            default:
+                break;
+        }
+
+        node_free(v);
+    }
+    if (stack != inline_stack) mem_free(stack);
+}
+
+yay_value_t *yay_clone(const yay_value_t *value) {
+    if (!value || is_shared_value(value)) return (yay_value_t *)value;
+    value_retain((yay_value_t *)value);
+    return (yay_value_t *)value;
+}
+
+/* Copy-on-write: give the caller a uniquely owned copy of a shared node.
+ * Children stay shared (their counts are bumped); owned scalar buffers
+ * are duplicated. Releases the caller's ownership of the original. */
+static yay_value_t *value_unshare(yay_value_t *value) {
+    if (__atomic_load_n(&value->refs, __ATOMIC_ACQUIRE) <= 1) return value;
+
+    yay_value_t *copy = node_alloc();
+    if (!copy) return NULL;
+    copy->type = value->type;
     switch (value->type) {
+        case YAY_BOOL:
+            copy->data.boolean = value->data.boolean;
+            break;
         case YAY_INT:
-            free(value->data.bigint.digits);
+            copy->data.bigint = value->data.bigint;
+            /* The limb cache belongs to the original; recompute lazily */
+            copy->data.bigint.limbs = NULL;
+            copy->data.bigint.limb_count = 0;
+            if (value->data.bigint.digits) {
+                copy->data.bigint.digits = value_strdup(value->data.bigint.digits);
+            }
+            break;
+        case YAY_FLOAT:
+            copy->data.number = value->data.number;
             break;
         case YAY_STRING:
-            free(value->data.string);
+            copy->data.string = value_strdup(value->data.string);
             break;
         case YAY_BYTES:
-            free(value->data.bytes.data);
+            copy->data.bytes.length = value->data.bytes.length;
+            if (value->data.bytes.length) {
+                copy->data.bytes.data = value_alloc(value->data.bytes.length);
+                if (copy->data.bytes.data) {
+                    memcpy(copy->data.bytes.data, value->data.bytes.data,
+                           value->data.bytes.length);
+                }
+            }
             break;
-        case YAY_ARRAY:
-            for (size_t i = 0; i < value->data.array.length; i++) {
-                yay_free(value->data.array.items[i]);
+        case YAY_ARRAY: {
+            size_t count = value->data.array.length;
+            copy->data.array.items = count
+                ? value_alloc(count * sizeof(yay_value_t *))
+                : NULL;
+            copy->data.array.length = count;
+            copy->data.array.capacity = count;
+            for (size_t i = 0; i < count; i++) {
+                copy->data.array.items[i] = yay_clone(value->data.array.items[i]);
             }
-            free(value->data.array.items);
             break;
-        case YAY_OBJECT:
-            for (size_t i = 0; i < value->data.object.length; i++) {
-                free(value->data.object.pairs[i].key);
-                yay_free(value->data.object.pairs[i].value);
+        }
+        case YAY_OBJECT: {
+            size_t count = value->data.object.length;
+            copy->data.object.pairs = count
+                ? value_alloc(count * sizeof(yay_pair_t))
+                : NULL;
+            copy->data.object.length = count;
+            copy->data.object.capacity = count;
+            copy->data.object.sorted = value->data.object.sorted;
+            for (size_t i = 0; i < count; i++) {
+                copy->data.object.pairs[i].key =
+                    key_retain(value->data.object.pairs[i].key);
+                copy->data.object.pairs[i].value =
+                    yay_clone(value->data.object.pairs[i].value);
             }
-            free(value->data.object.pairs);
+            /* The hash index is rebuilt on the next insert */
             break;
+        }
         default:
             break;
     }
-    
-    free(value);
+
+    yay_free(value);
+    return copy;
 }
 
 void yay_error_free(yay_error_t *error) {
     if (!error) return;
-    free(error->message);
-    free(error);
+    yay_error_impl_t *impl = (yay_error_impl_t *)error;
+    mem_free(error->message);
+    mem_free(impl->filename);
+    mem_free(error);
+}
+
+const char *yay_error_message(yay_error_t *error) {
+    if (!error) return NULL;
+    if (error->message) return error->message;
+    yay_error_impl_t *impl = (yay_error_impl_t *)error;
+    if (impl->located && impl->filename) {
+        size_t total = strlen(impl->base) + strlen(impl->filename) + 32;
+        error->message = mem_alloc(total);
+        if (error->message) {
+            snprintf(error->message, total, "%s at %d:%d of <%s>",
+                     impl->base, error->line, error->column, impl->filename);
+        }
+    } else {
+        error->message = str_dup(impl->base);
+    }
+    return error->message;
 }
 
 void yay_result_free(yay_result_t *result) {
@@ -319,10 +1595,340 @@ void yay_result_free(yay_result_t *result) {
     yay_error_free(result->error);
 }
 
+/* ============================================================================
+ * Memory Introspection
+ * ============================================================================ */
+
+size_t yay_memory_usage(const yay_value_t *value) {
+    if (!value || is_shared_value(value)) return 0;
+
+    /* Same explicit-stack walk as yay_free, for the same reason */
+    yay_value_t *inline_stack[64];
+    yay_value_t **stack = inline_stack;
+    size_t length = 0;
+    size_t capacity = 64;
+    size_t total = 0;
+
+    stack[length++] = (yay_value_t *)value;
+    while (length > 0) {
+        const yay_value_t *v = stack[--length];
+        if (!v || is_shared_value(v)) continue;
+
+        total += sizeof(yay_value_t);
+        switch (v->type) {
+            case YAY_INT:
+                if (v->data.bigint.digits) {
+                    total += strlen(v->data.bigint.digits) + 1;
+                }
+                total += v->data.bigint.limb_count * sizeof(uint64_t);
+                break;
+            case YAY_STRING:
+                if (v->data.string) total += strlen(v->data.string) + 1;
+                break;
+            case YAY_BYTES:
+                total += v->data.bytes.length;
+                break;
+            case YAY_ARRAY: {
+                size_t count = v->data.array.length;
+                total += v->data.array.capacity * sizeof(yay_value_t *);
+                if (free_stack_reserve(&stack, &capacity, length, count,
+                                       inline_stack)) {
+                    memcpy(stack + length, v->data.array.items,
+                           count * sizeof(*stack));
+                    length += count;
+                } else {
+                    for (size_t i = 0; i < count; i++) {
+                        total += yay_memory_usage(v->data.array.items[i]);
+                    }
+                }
+                break;
+            }
+            case YAY_OBJECT: {
+                size_t count = v->data.object.length;
+                total += v->data.object.capacity * sizeof(yay_pair_t);
+                total += v->data.object.index_capacity * sizeof(size_t);
+                bool pushed = free_stack_reserve(&stack, &capacity, length,
+                                                 count, inline_stack);
+                for (size_t i = 0; i < count; i++) {
+                    total += sizeof(key_cell_t) +
+                             strlen(v->data.object.pairs[i].key) + 1;
+                    if (pushed) {
+                        stack[length++] = v->data.object.pairs[i].value;
+                    } else {
+                        total += yay_memory_usage(v->data.object.pairs[i].value);
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    if (stack != inline_stack) mem_free(stack);
+    return total;
+}
+
+void yay_shrink_to_fit(yay_value_t *value) {
+    if (!value || is_shared_value(value)) return;
+
+    yay_value_t *inline_stack[64];
+    yay_value_t **stack = inline_stack;
+    size_t length = 0;
+    size_t capacity = 64;
+
+    stack[length++] = value;
+    while (length > 0) {
+        yay_value_t *v = stack[--length];
+        if (!v || is_shared_value(v)) continue;
+
+        switch (v->type) {
+            case YAY_ARRAY: {
+                size_t count = v->data.array.length;
+                if (count == 0 && v->data.array.capacity > 0) {
+                    value_free(v->data.array.items);
+                    v->data.array.items = NULL;
+                    v->data.array.capacity = 0;
+                } else if (v->data.array.capacity > count) {
+                    yay_value_t **trimmed =
+                        mem_realloc(v->data.array.items,
+                                    count * sizeof(yay_value_t *));
+                    if (trimmed) {
+                        v->data.array.items = trimmed;
+                        v->data.array.capacity = count;
+                    }
+                }
+                if (free_stack_reserve(&stack, &capacity, length, count,
+                                       inline_stack)) {
+                    memcpy(stack + length, v->data.array.items,
+                           count * sizeof(*stack));
+                    length += count;
+                } else {
+                    for (size_t i = 0; i < count; i++) {
+                        yay_shrink_to_fit(v->data.array.items[i]);
+                    }
+                }
+                break;
+            }
+            case YAY_OBJECT: {
+                size_t count = v->data.object.length;
+                if (count == 0 && v->data.object.capacity > 0) {
+                    value_free(v->data.object.pairs);
+                    v->data.object.pairs = NULL;
+                    v->data.object.capacity = 0;
+                } else if (v->data.object.capacity > count) {
+                    yay_pair_t *trimmed =
+                        mem_realloc(v->data.object.pairs,
+                                    count * sizeof(yay_pair_t));
+                    if (trimmed) {
+                        v->data.object.pairs = trimmed;
+                        v->data.object.capacity = count;
+                    }
+                }
+                bool pushed = free_stack_reserve(&stack, &capacity, length,
+                                                 count, inline_stack);
+                for (size_t i = 0; i < count; i++) {
+                    if (pushed) {
+                        stack[length++] = v->data.object.pairs[i].value;
+                    } else {
+                        yay_shrink_to_fit(v->data.object.pairs[i].value);
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    if (stack != inline_stack) mem_free(stack);
+}
+
+/* ============================================================================
+ * Subtree Deduplication
+ * ============================================================================ */
+
+/* Open-addressed table of canonical nodes keyed by structural hash */
+typedef struct {
+    yay_value_t **slots;
+    uint64_t *hashes;
+    size_t count;
+    size_t capacity;
+    size_t collapsed;
+    bool failed;
+} dedup_table_t;
+
+static bool dedup_grow(dedup_table_t *table) {
+    size_t cap = table->capacity ? table->capacity * 2 : 256;
+    yay_value_t **slots = mem_calloc(cap, sizeof(yay_value_t *));
+    uint64_t *hashes = mem_alloc(cap * sizeof(uint64_t));
+    if (!slots || !hashes) {
+        mem_free(slots);
+        mem_free(hashes);
+        table->failed = true;
+        return false;
+    }
+    for (size_t i = 0; i < table->capacity; i++) {
+        if (!table->slots[i]) continue;
+        size_t j = (size_t)table->hashes[i] & (cap - 1);
+        while (slots[j]) j = (j + 1) & (cap - 1);
+        slots[j] = table->slots[i];
+        hashes[j] = table->hashes[i];
+    }
+    mem_free(table->slots);
+    mem_free(table->hashes);
+    table->slots = slots;
+    table->hashes = hashes;
+    table->capacity = cap;
+    return true;
+}
+
+/* Dedup a uniquely owned node: children first, then the node itself is
+ * either registered as the canonical copy of its shape or released in
+ * favor of an existing equal subtree. Returns the surviving node. */
+static yay_value_t *dedup_node(dedup_table_t *table, yay_value_t *v) {
+    if (!v || is_shared_value(v) || table->failed) return v;
+
+    /* A node that already has shared owners is either a canonical
+     * survivor from this pass or shared by the caller; its subtree is
+     * final either way */
+    if (__atomic_load_n(&v->refs, __ATOMIC_ACQUIRE) <= 1) {
+        if (v->type == YAY_ARRAY) {
+            for (size_t i = 0; i < v->data.array.length; i++) {
+                v->data.array.items[i] =
+                    dedup_node(table, v->data.array.items[i]);
+            }
+        } else if (v->type == YAY_OBJECT) {
+            for (size_t i = 0; i < v->data.object.length; i++) {
+                v->data.object.pairs[i].value =
+                    dedup_node(table, v->data.object.pairs[i].value);
+            }
+        }
+    }
+
+    if (table->count * 2 >= table->capacity && !dedup_grow(table)) return v;
+
+    uint64_t h = yay_hash(v);
+    size_t i = (size_t)h & (table->capacity - 1);
+    while (table->slots[i]) {
+        if (table->hashes[i] == h && yay_equal(table->slots[i], v)) {
+            yay_value_t *canonical = table->slots[i];
+            if (canonical == v) return v;
+            table->collapsed++;
+            yay_free(v);
+            return yay_clone(canonical);
+        }
+        i = (i + 1) & (table->capacity - 1);
+    }
+    table->slots[i] = v;
+    table->hashes[i] = h;
+    table->count++;
+    return v;
+}
+
+size_t yay_dedup(yay_value_t *value) {
+    if (!value || is_shared_value(value)) return 0;
+
+    dedup_table_t table = {0};
+    if (value->type == YAY_ARRAY) {
+        for (size_t i = 0; i < value->data.array.length; i++) {
+            value->data.array.items[i] =
+                dedup_node(&table, value->data.array.items[i]);
+        }
+    } else if (value->type == YAY_OBJECT) {
+        for (size_t i = 0; i < value->data.object.length; i++) {
+            value->data.object.pairs[i].value =
+                dedup_node(&table, value->data.object.pairs[i].value);
+        }
+    }
+    mem_free(table.slots);
+    mem_free(table.hashes);
+    return table.collapsed;
+}
+
 /* ============================================================================
  * Value Comparison
  * ============================================================================ */
 
+/* FNV-1a combining for structural hashes */
+#define YAY_HASH_SEED 14695981039346656037ULL
+#define YAY_HASH_PRIME 1099511628211ULL
+
+static uint64_t hash_mix(uint64_t h, uint64_t v) {
+    h ^= v;
+    h *= YAY_HASH_PRIME;
+    return h;
+}
+
+static uint64_t hash_bytes(uint64_t h, const void *data, size_t length) {
+    const uint8_t *p = data;
+    for (size_t i = 0; i < length; i++) {
+        h = hash_mix(h, p[i]);
+    }
+    return h;
+}
+
+uint64_t yay_hash(const yay_value_t *value) {
+    if (!value) return 0;
+    uint64_t h = hash_mix(YAY_HASH_SEED, (uint64_t)value->type);
+    switch (value->type) {
+        case YAY_NULL:
+            break;
+        case YAY_BOOL:
+            h = hash_mix(h, value->data.boolean ? 1 : 0);
+            break;
+        case YAY_INT:
+            h = hash_mix(h, value->data.bigint.negative ? 1 : 0);
+            if (value->data.bigint.digits) {
+                h = hash_bytes(h, value->data.bigint.digits,
+                               strlen(value->data.bigint.digits));
+            } else {
+                /* Mixed small/digit representations compare unequal in
+                 * yay_equal, so hashing them differently is fine */
+                h = hash_mix(h, (uint64_t)value->data.bigint.small);
+            }
+            break;
+        case YAY_FLOAT: {
+            double d = value->data.number;
+            if (isnan(d)) {
+                h = hash_mix(h, 1);
+            } else {
+                if (d == 0.0) d = 0.0; /* fold -0.0 onto 0.0, they are equal */
+                uint64_t bits;
+                memcpy(&bits, &d, sizeof(bits));
+                h = hash_mix(h, bits);
+            }
+            break;
+        }
+        case YAY_STRING:
+            h = hash_bytes(h, value->data.string, strlen(value->data.string));
+            break;
+        case YAY_BYTES:
+            h = hash_bytes(h, value->data.bytes.data, value->data.bytes.length);
+            break;
+        case YAY_ARRAY:
+            h = hash_mix(h, (uint64_t)value->data.array.length);
+            for (size_t i = 0; i < value->data.array.length; i++) {
+                h = hash_mix(h, yay_hash(value->data.array.items[i]));
+            }
+            break;
+        case YAY_OBJECT: {
+            /* Key order is insignificant to yay_equal, so combine the pair
+             * hashes commutatively */
+            h = hash_mix(h, (uint64_t)value->data.object.length);
+            uint64_t pairs = 0;
+            for (size_t i = 0; i < value->data.object.length; i++) {
+                uint64_t ph = hash_bytes(YAY_HASH_SEED,
+                                         value->data.object.pairs[i].key,
+                                         strlen(value->data.object.pairs[i].key));
+                ph = hash_mix(ph, yay_hash(value->data.object.pairs[i].value));
+                pairs += ph;
+            }
+            h = hash_mix(h, pairs);
+            break;
+        }
+    }
+    return h;
+}
+
 bool yay_equal(const yay_value_t *a, const yay_value_t *b) {
     if (a == b) return true;
     if (!a || !b) return false;
@@ -334,8 +1940,23 @@ bool yay_equal(const yay_value_t *a, const yay_value_t *b) {
         case YAY_BOOL:
             return a->data.boolean == b->data.boolean;
         case YAY_INT:
-            return a->data.bigint.negative == b->data.bigint.negative &&
-                   strcmp(a->data.bigint.digits, b->data.bigint.digits) == 0;
+            if (a->data.bigint.negative != b->data.bigint.negative) return false;
+            if (!a->data.bigint.digits && !b->data.bigint.digits) {
+                return a->data.bigint.small == b->data.bigint.small;
+            }
+            /* Warm limb caches reject unequal magnitudes on machine words
+             * before any digit-string walk (equal limbs still defer to the
+             * strings: leading zeros are significant) */
+            if (a->data.bigint.limbs && b->data.bigint.limbs &&
+                limbs_cmp(a->data.bigint.limbs, a->data.bigint.limb_count,
+                          b->data.bigint.limbs,
+                          b->data.bigint.limb_count) != 0) {
+                return false;
+            }
+            /* Mixed representations differ: heap digits are only kept for
+             * out-of-range values and leading-zero strings */
+            if (!a->data.bigint.digits || !b->data.bigint.digits) return false;
+            return strcmp(a->data.bigint.digits, b->data.bigint.digits) == 0;
         case YAY_FLOAT:
             /* Handle NaN */
             if (isnan(a->data.number) && isnan(b->data.number)) return true;
@@ -344,7 +1965,9 @@ bool yay_equal(const yay_value_t *a, const yay_value_t *b) {
             return strcmp(a->data.string, b->data.string) == 0;
         case YAY_BYTES:
             if (a->data.bytes.length != b->data.bytes.length) return false;
-            return memcmp(a->data.bytes.data, b->data.bytes.data, 
+            /* Empty byte arrays have NULL data, which memcmp rejects */
+            if (a->data.bytes.length == 0) return true;
+            return memcmp(a->data.bytes.data, b->data.bytes.data,
                          a->data.bytes.length) == 0;
         case YAY_ARRAY:
             if (a->data.array.length != b->data.array.length) return false;
@@ -358,19 +1981,12 @@ bool yay_equal(const yay_value_t *a, const yay_value_t *b) {
             if (a->data.object.length != b->data.object.length) return false;
             for (size_t i = 0; i < a->data.object.length; i++) {
                 /* Find matching key in b */
-                bool found = false;
-                for (size_t j = 0; j < b->data.object.length; j++) {
-                    if (strcmp(a->data.object.pairs[i].key, 
-                              b->data.object.pairs[j].key) == 0) {
-                        if (!yay_equal(a->data.object.pairs[i].value,
-                                      b->data.object.pairs[j].value)) {
-                            return false;
-                        }
-                        found = true;
-                        break;
-                    }
+                long idx = object_find(b, a->data.object.pairs[i].key);
+                if (idx < 0) return false;
+                if (!yay_equal(a->data.object.pairs[i].value,
+                               b->data.object.pairs[idx].value)) {
+                    return false;
                 }
-                if (!found) return false;
             }
             return true;
     }
@@ -381,2729 +1997,9151 @@ bool yay_equal(const yay_value_t *a, const yay_value_t *b) {
  * Value to String (for debugging)
  * ============================================================================ */
 
-static void append_str(char **buf, size_t *len, size_t *cap, const char *s) {
-    size_t slen = strlen(s);
-    while (*len + slen + 1 > *cap) {
-        *cap *= 2;
-        *buf = realloc(*buf, *cap);
+void yay_writer_init(yay_writer_t *writer) {
+    memset(writer, 0, sizeof(*writer));
+}
+
+void yay_writer_init_stream(yay_writer_t *writer, FILE *stream) {
+    memset(writer, 0, sizeof(*writer));
+    writer->stream = stream;
+}
+
+static bool writer_reserve(yay_writer_t *writer, size_t extra) {
+    if (writer->length + extra + 1 <= writer->capacity) return true;
+    size_t cap = writer->capacity ? writer->capacity : 256;
+    while (writer->length + extra + 1 > cap) {
+        cap *= 2;
+    }
+    char *data = mem_realloc(writer->data, cap);
+    if (!data) {
+        writer->failed = true;
+        return false;
     }
-    memcpy(*buf + *len, s, slen);
-    *len += slen;
-    (*buf)[*len] = '\0';
+    writer->data = data;
+    writer->capacity = cap;
+    return true;
 }
 
-static void value_to_string_impl(const yay_value_t *v, char **buf, 
-                                  size_t *len, size_t *cap) {
-    char tmp[64];
-    
-    if (!v) {
-        append_str(buf, len, cap, "null");
-        return;
-    }
-    
-    switch (v->type) {
-        case YAY_NULL:
-            append_str(buf, len, cap, "null");
-            break;
-        case YAY_BOOL:
-            append_str(buf, len, cap, v->data.boolean ? "true" : "false");
-            break;
-        case YAY_INT:
-            if (v->data.bigint.negative) {
-                append_str(buf, len, cap, "-");
-            }
-            append_str(buf, len, cap, v->data.bigint.digits);
-            append_str(buf, len, cap, "n");
-            break;
-        case YAY_FLOAT:
-            if (isnan(v->data.number)) {
-                append_str(buf, len, cap, "NaN");
-            } else if (isinf(v->data.number)) {
-                append_str(buf, len, cap, v->data.number > 0 ? "Infinity" : "-Infinity");
-            } else {
-                snprintf(tmp, sizeof(tmp), "%g", v->data.number);
-                append_str(buf, len, cap, tmp);
-            }
-            break;
-        case YAY_STRING:
-            append_str(buf, len, cap, "\"");
-            append_str(buf, len, cap, v->data.string);
-            append_str(buf, len, cap, "\"");
-            break;
-        case YAY_BYTES:
-            append_str(buf, len, cap, "<");
-            for (size_t i = 0; i < v->data.bytes.length; i++) {
-                snprintf(tmp, sizeof(tmp), "%02x", v->data.bytes.data[i]);
-                append_str(buf, len, cap, tmp);
-            }
-            append_str(buf, len, cap, ">");
-            break;
-        case YAY_ARRAY:
-            append_str(buf, len, cap, "[");
-            for (size_t i = 0; i < v->data.array.length; i++) {
-                if (i > 0) append_str(buf, len, cap, ", ");
-                value_to_string_impl(v->data.array.items[i], buf, len, cap);
-            }
-            append_str(buf, len, cap, "]");
-            break;
-        case YAY_OBJECT:
-            append_str(buf, len, cap, "{");
-            for (size_t i = 0; i < v->data.object.length; i++) {
-                if (i > 0) append_str(buf, len, cap, ", ");
-                append_str(buf, len, cap, v->data.object.pairs[i].key);
-                append_str(buf, len, cap, ": ");
-                value_to_string_impl(v->data.object.pairs[i].value, buf, len, cap);
-            }
-            append_str(buf, len, cap, "}");
-            break;
+bool yay_writer_write(yay_writer_t *writer, const char *data, size_t length) {
+    if (writer->failed) return false;
+    /* Empty writes may carry NULL (e.g. an empty byte array's data
+     * pointer); passing that to memcpy/fwrite is undefined */
+    if (length == 0) return true;
+    if (writer->stream) {
+        if (fwrite(data, 1, length, writer->stream) != length) {
+            writer->failed = true;
+            return false;
+        }
+        writer->length += length;
+        return true;
     }
+    if (!writer_reserve(writer, length)) return false;
+    memcpy(writer->data + writer->length, data, length);
+    writer->length += length;
+    writer->data[writer->length] = '\0';
+    return true;
 }
 
-char *yay_to_string(const yay_value_t *value) {
-    size_t cap = 256;
-    size_t len = 0;
-    char *buf = malloc(cap);
-    if (!buf) return NULL;
-    buf[0] = '\0';
-    
-    value_to_string_impl(value, &buf, &len, &cap);
-    return buf;
+char *yay_writer_take(yay_writer_t *writer) {
+    if (writer->stream) return NULL;
+    char *data = writer->data;
+    if (!data) {
+        data = mem_alloc(1);
+        if (data) data[0] = '\0';
+    }
+    memset(writer, 0, sizeof(*writer));
+    return data;
 }
 
-/* ============================================================================
- * Error Helpers
- * ============================================================================ */
-
-static yay_error_t *make_error(parse_ctx_t *ctx, int line, int col, 
-                               const char *fmt, ...) {
-    yay_error_t *err = calloc(1, sizeof(yay_error_t));
-    if (!err) return NULL;
-    
-    char msg[512];
-    va_list args;
-    va_start(args, fmt);
-    vsnprintf(msg, sizeof(msg), fmt, args);
-    va_end(args);
-    
-    size_t msg_len = strlen(msg);
-    if (ctx->filename) {
-        size_t total = msg_len + strlen(ctx->filename) + 32;
-        err->message = malloc(total);
-        snprintf(err->message, total, "%s at %d:%d of <%s>", 
-                 msg, line + 1, col + 1, ctx->filename);
-    } else {
-        err->message = str_dup(msg);
-    }
-    
-    err->line = line + 1;
-    err->column = col + 1;
-    
-    return err;
+void yay_writer_free(yay_writer_t *writer) {
+    mem_free(writer->data);
+    memset(writer, 0, sizeof(*writer));
 }
 
-/* ============================================================================
- * Phase 1: Scanner
- * ============================================================================ */
+/* Append a NUL-terminated fragment (length computed once here, not per
+ * accumulated buffer) */
+static void writer_puts(yay_writer_t *writer, const char *s) {
+    yay_writer_write(writer, s, strlen(s));
+}
 
-static void add_scan_line(parse_ctx_t *ctx, const char *line, int indent,
-                          const char *leader, int line_num) {
-    if (ctx->line_count >= ctx->line_capacity) {
-        ctx->line_capacity *= 2;
-        ctx->lines = realloc(ctx->lines, ctx->line_capacity * sizeof(scan_line_t));
-    }
-    
-    scan_line_t *sl = &ctx->lines[ctx->line_count++];
-    sl->line = str_dup(line);
-    sl->indent = indent;
-    sl->leader = str_dup(leader);
-    sl->line_num = line_num;
+static void writer_putc(yay_writer_t *writer, char c) {
+    yay_writer_write(writer, &c, 1);
 }
 
-static bool scan(parse_ctx_t *ctx) {
-    const char *src = ctx->source;
-    size_t len = ctx->source_len;
-    
-    /* Check for BOM */
-    if (len >= 3 && (unsigned char)src[0] == 0xEF && 
-        (unsigned char)src[1] == 0xBB && (unsigned char)src[2] == 0xBF) {
-        ctx->error = make_error(ctx, 0, 0, "Illegal BOM");
-        return false;
-    }
-    
-    /* Check for forbidden code points */
-    {
-        int line = 0, col = 0;
-        size_t i = 0;
-        while (i < len) {
-            unsigned char c = src[i];
-            uint32_t cp;
-            size_t seq_len;
-            /* Decode UTF-8 */
-            if (c < 0x80) {
-                cp = c;
-                seq_len = 1;
-            } else if ((c & 0xE0) == 0xC0 && i + 1 < len) {
-                cp = ((uint32_t)(c & 0x1F) << 6) | (src[i+1] & 0x3F);
-                seq_len = 2;
-            } else if ((c & 0xF0) == 0xE0 && i + 2 < len) {
-                cp = ((uint32_t)(c & 0x0F) << 12) | ((uint32_t)(src[i+1] & 0x3F) << 6) | (src[i+2] & 0x3F);
-                seq_len = 3;
-            } else if ((c & 0xF8) == 0xF0 && i + 3 < len) {
-                cp = ((uint32_t)(c & 0x07) << 18) | ((uint32_t)(src[i+1] & 0x3F) << 12) | ((uint32_t)(src[i+2] & 0x3F) << 6) | (src[i+3] & 0x3F);
-                seq_len = 4;
-            } else {
-                cp = c;
-                seq_len = 1;
-            }
-            /* Check if allowed */
-            int allowed = (cp == 0x000A)
-                || (0x0020 <= cp && cp <= 0x007E)
-                || (0x00A0 <= cp && cp <= 0xD7FF)
-                || (0xE000 <= cp && cp <= 0xFFFD && !(0xFDD0 <= cp && cp <= 0xFDEF))
-                || (0x10000 <= cp && cp <= 0x10FFFF && (cp & 0xFFFF) < 0xFFFE);
-            if (!allowed) {
-                if (cp == 0x09) {
-                    ctx->error = make_error(ctx, line, col, "Tab not allowed (use spaces)");
-                    return false;
-                }
-                if (cp >= 0xD800 && cp <= 0xDFFF) {
-                    ctx->error = make_error(ctx, line, col, "Illegal surrogate");
-                    return false;
-                }
-                ctx->error = make_error(ctx, line, col, "Forbidden code point U+%04X", cp);
-                return false;
-            }
-            if (cp == 0x0A) {
-                line++;
-                col = 0;
-            } else {
-                col++;
-            }
-            i += seq_len;
-        }
-    }
-    
-    /* Process lines */
-    const char *line_start = src;
-    int line_num = 0;
-    
-    while (line_start <= src + len) {
-        /* Find end of line */
-        const char *line_end = line_start;
-        while (line_end < src + len && *line_end != '\n') {
-            line_end++;
-        }
-        
-        size_t line_len = line_end - line_start;
-        
-        /* Check for trailing space */
-        if (line_len > 0 && line_start[line_len - 1] == ' ') {
-            ctx->error = make_error(ctx, line_num, (int)line_len - 1, 
-                                    "Unexpected trailing space");
-            return false;
-        }
-        
-        /* Count indent */
-        int indent = 0;
-        while (indent < (int)line_len && line_start[indent] == ' ') {
-            indent++;
-        }
-        
-        const char *rest = line_start + indent;
-        size_t rest_len = line_len - indent;
-        
-        /* Skip top-level comments */
-        if (rest_len > 0 && rest[0] == '#' && indent == 0) {
-            line_start = line_end + 1;
-            line_num++;
+/* 256-entry classification for string encoding: 0 passes through
+ * unescaped, 'u' becomes \u00XX, anything else is the letter written
+ * after a backslash */
+static const unsigned char string_escape_table[256] = {
+    [0x00] = 'u', [0x01] = 'u', [0x02] = 'u', [0x03] = 'u',
+    [0x04] = 'u', [0x05] = 'u', [0x06] = 'u', [0x07] = 'u',
+    [0x08] = 'u', [0x09] = 't', [0x0a] = 'n', [0x0b] = 'u',
+    [0x0c] = 'u', [0x0d] = 'r', [0x0e] = 'u', [0x0f] = 'u',
+    [0x10] = 'u', [0x11] = 'u', [0x12] = 'u', [0x13] = 'u',
+    [0x14] = 'u', [0x15] = 'u', [0x16] = 'u', [0x17] = 'u',
+    [0x18] = 'u', [0x19] = 'u', [0x1a] = 'u', [0x1b] = 'u',
+    [0x1c] = 'u', [0x1d] = 'u', [0x1e] = 'u', [0x1f] = 'u',
+    ['"'] = '"', ['\\'] = '\\',
+};
+
+/* Write a double-quoted string, bulk-appending every span of bytes that
+ * needs no escaping instead of inspecting characters one at a time */
+static void encode_string_len(yay_writer_t *writer, const char *s,
+                              size_t length) {
+    writer_putc(writer, '"');
+    const char *p = s;
+    const char *end = s + length;
+    const char *clean = p;
+    while (p < end) {
+        unsigned char escape = string_escape_table[(unsigned char)*p];
+        if (!escape) {
+            p++;
             continue;
         }
-        
-        /* Extract leader and content */
-        const char *leader = "";
-        const char *content = rest;
-        size_t content_len = rest_len;
-        
-        if (rest_len >= 2 && rest[0] == '-' && rest[1] == ' ') {
-            leader = "- ";
-            content = rest + 2;
-            content_len = rest_len - 2;
-        } else if (rest_len == 1 && rest[0] == '-') {
-            leader = "- ";
-            content = "";
-            content_len = 0;
-        } else if (rest_len >= 2 && rest[0] == '-' && rest[1] != ' ' && 
-                   rest[1] != '.' && !(rest[1] >= '0' && rest[1] <= '9') &&
-                   strncmp(rest, "-infinity", 9) != 0) {
-            /* Compact list syntax (-value without space) is not allowed */
-            ctx->error = make_error(ctx, line_num, indent + 1, 
-                                    "Expected space after \"-\"");
-            return false;
-        } else if (rest_len >= 1 && rest[0] == '*' && 
-                   (rest_len == 1 || rest[1] == ' ')) {
-            ctx->error = make_error(ctx, line_num, indent, 
-                                    "Unexpected character \"*\"");
-            return false;
+        if (p > clean) {
+            yay_writer_write(writer, clean, (size_t)(p - clean));
         }
-        
-        /* Add the line */
-        char *content_str = str_dup_len(content, content_len);
-        add_scan_line(ctx, content_str, indent, leader, line_num);
-        free(content_str);
-        
-        if (line_end >= src + len) break;
-        line_start = line_end + 1;
-        line_num++;
+        if (escape == 'u') {
+            char buf[8];
+            int n = snprintf(buf, sizeof(buf), "\\u%04x",
+                             (unsigned char)*p);
+            yay_writer_write(writer, buf, (size_t)n);
+        } else {
+            char pair[2] = { '\\', (char)escape };
+            yay_writer_write(writer, pair, 2);
+        }
+        p++;
+        clean = p;
     }
-    
-    return true;
+    if (p > clean) {
+        yay_writer_write(writer, clean, (size_t)(p - clean));
+    }
+    writer_putc(writer, '"');
 }
 
-/* ============================================================================
- * Phase 2: Outline Lexer
- * ============================================================================ */
+static void encode_string(yay_writer_t *writer, const char *s) {
+    encode_string_len(writer, s, strlen(s));
+}
 
-static void add_token(parse_ctx_t *ctx, token_type_t type, const char *text,
-                      int indent, int line_num, int col) {
-    if (ctx->token_count >= ctx->token_capacity) {
-        ctx->token_capacity *= 2;
-        ctx->tokens = realloc(ctx->tokens, ctx->token_capacity * sizeof(token_t));
-    }
-    
-    token_t *t = &ctx->tokens[ctx->token_count++];
-    t->type = type;
-    t->text = str_dup(text);
-    t->indent = indent;
-    t->line_num = line_num;
-    t->col = col;
+/* Hex-encode a span: 16 input bytes become 32 hex characters per SIMD
+ * step, nibbles mapped to ASCII arithmetically so there is no table
+ * lookup inside the loop. Returns characters written (always 2 * len). */
+static size_t hex_encode_span(char *out, const uint8_t *in, size_t len) {
+    size_t i = 0;
+    size_t o = 0;
+#if defined(__SSE2__)
+    __m128i mask = _mm_set1_epi8(0x0F);
+    __m128i zero_ch = _mm_set1_epi8('0');
+    __m128i nine = _mm_set1_epi8(9);
+    __m128i gap = _mm_set1_epi8('a' - '0' - 10);
+    while (i + 16 <= len) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(chunk, 4), mask);
+        __m128i lo = _mm_and_si128(chunk, mask);
+        hi = _mm_add_epi8(hi, _mm_add_epi8(zero_ch,
+                 _mm_and_si128(_mm_cmpgt_epi8(hi, nine), gap)));
+        lo = _mm_add_epi8(lo, _mm_add_epi8(zero_ch,
+                 _mm_and_si128(_mm_cmpgt_epi8(lo, nine), gap)));
+        _mm_storeu_si128((__m128i *)(out + o), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(out + o + 16), _mm_unpackhi_epi8(hi, lo));
+        i += 16;
+        o += 32;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    uint8x16_t mask = vdupq_n_u8(0x0F);
+    uint8x16_t zero_ch = vdupq_n_u8('0');
+    uint8x16_t nine = vdupq_n_u8(9);
+    uint8x16_t gap = vdupq_n_u8('a' - '0' - 10);
+    while (i + 16 <= len) {
+        uint8x16_t chunk = vld1q_u8(in + i);
+        uint8x16_t hi = vshrq_n_u8(chunk, 4);
+        uint8x16_t lo = vandq_u8(chunk, mask);
+        hi = vaddq_u8(hi, vaddq_u8(zero_ch,
+                 vandq_u8(vcgtq_u8(hi, nine), gap)));
+        lo = vaddq_u8(lo, vaddq_u8(zero_ch,
+                 vandq_u8(vcgtq_u8(lo, nine), gap)));
+        uint8x16x2_t zipped = vzipq_u8(hi, lo);
+        vst1q_u8((uint8_t *)(out + o), zipped.val[0]);
+        vst1q_u8((uint8_t *)(out + o + 16), zipped.val[1]);
+        i += 16;
+        o += 32;
+    }
+#endif
+    for (; i < len; i++) {
+        static const char digits[] = "0123456789abcdef";
+        out[o++] = digits[in[i] >> 4];
+        out[o++] = digits[in[i] & 0x0F];
+    }
+    return o;
 }
 
-static void outline_lex(parse_ctx_t *ctx) {
-    int stack[256];
-    int stack_top = 0;
-    stack[0] = 0;
-    int top = 0;
-    bool broken = false;
-    
-    for (size_t i = 0; i < ctx->line_count; i++) {
-        scan_line_t *sl = &ctx->lines[i];
-        
-        /* Emit stops for dedent */
-        while (sl->indent < top) {
-            add_token(ctx, TOKEN_STOP, "", 0, 0, 0);
-            stack_top--;
-            top = stack[stack_top];
-        }
-        
-        /* Emit start for list items */
-        if (strlen(sl->leader) > 0) {
-            if (sl->indent > top) {
-                add_token(ctx, TOKEN_START, sl->leader, sl->indent, 
-                         sl->line_num, sl->indent);
-                stack[++stack_top] = sl->indent;
-                top = sl->indent;
-                broken = false;
-            } else if (sl->indent == top) {
-                add_token(ctx, TOKEN_STOP, "", 0, 0, 0);
-                add_token(ctx, TOKEN_START, sl->leader, sl->indent,
-                         sl->line_num, sl->indent);
-                broken = false;
-            }
-        }
-        
-        /* Emit text or break */
-        if (strlen(sl->line) > 0) {
-            add_token(ctx, TOKEN_TEXT, sl->line, sl->indent, 
-                     sl->line_num, sl->indent);
-            broken = false;
-        } else if (!broken) {
-            add_token(ctx, TOKEN_BREAK, "", sl->line_num, sl->indent, 0);
-            broken = true;
-        }
+/* Hex-encode bytes into the writer. Buffered writers reserve the whole
+ * 2 * len span once and encode straight into the output buffer; stream
+ * writers go through a block buffer. */
+static void encode_hex(yay_writer_t *writer, const uint8_t *data, size_t len) {
+    if (writer->failed) return;
+    if (!writer->stream) {
+        if (!writer_reserve(writer, len * 2)) return;
+        writer->length += hex_encode_span(writer->data + writer->length,
+                                          data, len);
+        writer->data[writer->length] = '\0';
+        return;
     }
-    
-    /* Close remaining blocks */
-    while (stack_top > 0) {
-        add_token(ctx, TOKEN_STOP, "", 0, 0, 0);
-        stack_top--;
+    char block[512];
+    size_t i = 0;
+    while (i < len) {
+        size_t take = len - i;
+        if (take > sizeof(block) / 2) take = sizeof(block) / 2;
+        size_t out = hex_encode_span(block, data + i, take);
+        if (!yay_writer_write(writer, block, out)) return;
+        i += take;
     }
 }
 
 /* ============================================================================
- * Phase 3: Value Parser - Forward Declarations
- * ============================================================================ */
-
-static yay_value_t *parse_value(parse_ctx_t *ctx, size_t *idx);
-static yay_value_t *parse_multiline_array(parse_ctx_t *ctx, size_t *idx);
-static yay_value_t *parse_multiline_array_impl(parse_ctx_t *ctx, size_t *idx, int min_indent);
-static yay_value_t *parse_scalar(parse_ctx_t *ctx, const char *s, 
-                                  int line_num, int col);
-static yay_value_t *parse_concatenated_strings(parse_ctx_t *ctx, size_t *idx, int base_indent);
+ * Number Formatting
+ * ============================================================================
+ *
+ * Integers are rendered two digits at a time from a pair table, and
+ * floats through Grisu2 (Loitsch, "Printing Floating-Point Numbers
+ * Quickly and Accurately with Integers"): the value and its neighbor
+ * boundaries are scaled by a cached power of ten (powers_gen.h) into a
+ * window where digits can be cut with 64-bit arithmetic, producing the
+ * shortest digit string that still round-trips exactly — without
+ * snprintf's per-value cost or its occasional non-shortest output.
+ * Formatted floats always carry a '.' or an exponent so they re-parse
+ * as floats, never as integers.
+ */
 
-/* ============================================================================
- * Helper Functions
- * ============================================================================ */
+static const char digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324"
+    "25262728293031323334353637383940414243444546474849"
+    "50515253545556575859606162636465666768697071727374"
+    "75767778798081828384858687888990919293949596979899";
 
-static size_t skip_breaks_and_stops(parse_ctx_t *ctx, size_t i) {
-    while (i < ctx->token_count && 
-           (ctx->tokens[i].type == TOKEN_STOP || 
-            ctx->tokens[i].type == TOKEN_BREAK)) {
-        i++;
+/* Render value into out (no NUL); out must hold 20 bytes */
+static size_t format_uint64(uint64_t value, char *out) {
+    char tmp[20];
+    size_t i = sizeof(tmp);
+    while (value >= 100) {
+        unsigned pair = (unsigned)(value % 100) * 2;
+        value /= 100;
+        tmp[--i] = digit_pairs[pair + 1];
+        tmp[--i] = digit_pairs[pair];
+    }
+    if (value >= 10) {
+        unsigned pair = (unsigned)value * 2;
+        tmp[--i] = digit_pairs[pair + 1];
+        tmp[--i] = digit_pairs[pair];
+    } else {
+        tmp[--i] = (char)('0' + value);
     }
-    return i;
+    memcpy(out, tmp + i, sizeof(tmp) - i);
+    return sizeof(tmp) - i;
 }
 
-static size_t skip_breaks(parse_ctx_t *ctx, size_t i) {
-    while (i < ctx->token_count && ctx->tokens[i].type == TOKEN_BREAK) {
-        i++;
+typedef struct {
+    uint64_t f;
+    int e;
+} diy_fp_t;
+
+#define DIY_SIGNIFICAND_SIZE 52
+#define DIY_EXPONENT_BIAS (0x3FF + DIY_SIGNIFICAND_SIZE)
+#define DIY_EXPONENT_MASK UINT64_C(0x7FF0000000000000)
+#define DIY_SIGNIFICAND_MASK UINT64_C(0x000FFFFFFFFFFFFF)
+#define DIY_HIDDEN_BIT UINT64_C(0x0010000000000000)
+
+static diy_fp_t diy_from_double(double d) {
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    int biased = (int)((bits & DIY_EXPONENT_MASK) >> DIY_SIGNIFICAND_SIZE);
+    diy_fp_t fp;
+    if (biased != 0) {
+        fp.f = (bits & DIY_SIGNIFICAND_MASK) + DIY_HIDDEN_BIT;
+        fp.e = biased - DIY_EXPONENT_BIAS;
+    } else {
+        fp.f = bits & DIY_SIGNIFICAND_MASK;
+        fp.e = 1 - DIY_EXPONENT_BIAS;
     }
-    return i;
+    return fp;
 }
 
-static size_t skip_stops(parse_ctx_t *ctx, size_t i) {
-    while (i < ctx->token_count && ctx->tokens[i].type == TOKEN_STOP) {
-        i++;
+static diy_fp_t diy_normalize(diy_fp_t fp) {
+    while (!(fp.f & UINT64_C(0x8000000000000000))) {
+        fp.f <<= 1;
+        fp.e--;
     }
-    return i;
+    return fp;
 }
 
-/* Find colon outside quotes */
-static int find_colon_outside_quotes(const char *s) {
-    bool in_double = false;
-    bool in_single = false;
-    bool escape = false;
-    
-    for (int i = 0; s[i]; i++) {
-        char c = s[i];
-        
-        if (escape) {
-            escape = false;
-            continue;
-        }
-        
-        if (c == '\\' && (in_double || in_single)) {
-            escape = true;
-            continue;
-        }
-        
-        if (c == '"' && !in_single) {
-            in_double = !in_double;
-        } else if (c == '\'' && !in_double) {
-            in_single = !in_single;
-        } else if (c == ':' && !in_double && !in_single) {
-            return i;
-        }
-    }
-    
-    return -1;
+/* Full 64x64 -> high-64 multiply with rounding of the dropped half */
+static diy_fp_t diy_mul(diy_fp_t x, diy_fp_t y) {
+    const uint64_t mask32 = UINT64_C(0xFFFFFFFF);
+    uint64_t a = x.f >> 32, b = x.f & mask32;
+    uint64_t c = y.f >> 32, d = y.f & mask32;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t mid = (bd >> 32) + (ad & mask32) + (bc & mask32);
+    mid += UINT64_C(1) << 31;
+    diy_fp_t r;
+    r.f = ac + (ad >> 32) + (bc >> 32) + (mid >> 32);
+    r.e = x.e + y.e + 64;
+    return r;
 }
 
-/* Parse key name (handles quoted keys) */
-static char *parse_key_name(const char *s) {
-    /* Skip leading whitespace */
-    while (*s == ' ') s++;
-    
-    size_t len = strlen(s);
-    
-    /* Double-quoted key */
-    if (len >= 2 && s[0] == '"' && s[len-1] == '"') {
-        return str_dup_len(s + 1, len - 2);
-    }
-    
-    /* Single-quoted key */
-    if (len >= 2 && s[0] == '\'' && s[len-1] == '\'') {
-        return str_dup_len(s + 1, len - 2);
+/* The normalized neighbor midpoints of v: every double between them
+ * rounds back to v, so any digit string inside is round-trip exact */
+static void diy_boundaries(diy_fp_t v, diy_fp_t *minus, diy_fp_t *plus) {
+    diy_fp_t pl, mi;
+    pl.f = (v.f << 1) + 1;
+    pl.e = v.e - 1;
+    pl = diy_normalize(pl);
+    if (v.f == DIY_HIDDEN_BIT) {
+        /* The gap below the smallest normalized significand is halved */
+        mi.f = (v.f << 2) - 1;
+        mi.e = v.e - 2;
+    } else {
+        mi.f = (v.f << 1) - 1;
+        mi.e = v.e - 1;
     }
-    
-    /* Trim trailing whitespace */
-    while (len > 0 && s[len-1] == ' ') len--;
-    
-    return str_dup_len(s, len);
+    mi.f <<= mi.e - pl.e;
+    mi.e = pl.e;
+    *plus = pl;
+    *minus = mi;
 }
 
-/* ============================================================================
- * Number Parsing
- * ============================================================================ */
+/* Pick the cached power of ten that scales a value with binary exponent
+ * e into the digit generator's working window */
+static diy_fp_t diy_cached_power(int e, int *K) {
+    double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int k = (int)dk;
+    if (dk - k > 0.0) k++;
+    unsigned index = (unsigned)((k >> 3) + 1);
+    *K = -(YAY_POW10_FIRST + (int)(index * YAY_POW10_STEP));
+    diy_fp_t power;
+    power.f = yay_pow10_f[index];
+    power.e = yay_pow10_e[index];
+    return power;
+}
+
+static const uint32_t pow10_32[] = {
+    1, 10, 100, 1000, 10000, 100000,
+    1000000, 10000000, 100000000, 1000000000,
+};
+
+/* 10^n for the fractional digit loop's rounding nudge: -kappa counts
+ * fractional digits and runs past the 32-bit table (formatting 0.1
+ * already reaches 13) */
+static const uint64_t pow10_64[] = {
+    UINT64_C(1),
+    UINT64_C(10),
+    UINT64_C(100),
+    UINT64_C(1000),
+    UINT64_C(10000),
+    UINT64_C(100000),
+    UINT64_C(1000000),
+    UINT64_C(10000000),
+    UINT64_C(100000000),
+    UINT64_C(1000000000),
+    UINT64_C(10000000000),
+    UINT64_C(100000000000),
+    UINT64_C(1000000000000),
+    UINT64_C(10000000000000),
+    UINT64_C(100000000000000),
+    UINT64_C(1000000000000000),
+    UINT64_C(10000000000000000),
+    UINT64_C(100000000000000000),
+    UINT64_C(1000000000000000000),
+    UINT64_C(10000000000000000000),
+};
+
+static int count_digits32(uint32_t n) {
+    int count = 1;
+    while (count < 10 && n >= pow10_32[count]) count++;
+    return count;
+}
 
-static bool is_integer_str(const char *s) {
-    if (*s == '-') s++;
-    if (!*s) return false;
-    while (*s) {
-        if (*s != ' ' && (*s < '0' || *s > '9')) return false;
-        s++;
+/* Nudge the last digit toward the actual value while staying inside the
+ * rounding boundary, so the shortest form is also the closest */
+static void grisu_round(char *digits, int len, uint64_t delta, uint64_t rest,
+                        uint64_t ten_kappa, uint64_t wp_w) {
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w ||
+            wp_w - rest > rest + ten_kappa - wp_w)) {
+        digits[len - 1]--;
+        rest += ten_kappa;
     }
-    return true;
 }
 
-static bool is_float_str(const char *s) {
-    bool has_dot = false;
-    bool has_exponent = false;
-    bool has_digit = false;
-    
-    if (*s == '-') s++;
-    
-    while (*s) {
-        if (*s == '.') {
-            if (has_dot || has_exponent) return false;
-            has_dot = true;
-        } else if (*s == 'e' || *s == 'E') {
-            if (has_exponent || !has_digit) return false;
-            has_exponent = true;
-            s++;
-            /* Allow optional +/- after exponent */
-            if (*s == '+' || *s == '-') s++;
-            continue;
-        } else if (*s >= '0' && *s <= '9') {
-            has_digit = true;
-        } else if (*s != ' ') {
-            return false;
+/* Cut decimal digits from the scaled value until the remainder fits
+ * inside the boundary gap, then stop: the digits emitted so far are the
+ * shortest string that identifies this double */
+static void grisu_digits(diy_fp_t w, diy_fp_t mp, uint64_t delta,
+                         char *digits, int *len, int *K) {
+    uint64_t one_f = UINT64_C(1) << -mp.e;
+    uint64_t wp_w = mp.f - w.f;
+    uint32_t p1 = (uint32_t)(mp.f >> -mp.e);
+    uint64_t p2 = mp.f & (one_f - 1);
+    int kappa = count_digits32(p1);
+    *len = 0;
+    while (kappa > 0) {
+        uint32_t div = pow10_32[kappa - 1];
+        uint32_t d = p1 / div;
+        p1 %= div;
+        if (d || *len) digits[(*len)++] = (char)('0' + d);
+        kappa--;
+        uint64_t rest = ((uint64_t)p1 << -mp.e) + p2;
+        if (rest <= delta) {
+            *K += kappa;
+            grisu_round(digits, *len, delta, rest,
+                        (uint64_t)pow10_32[kappa] << -mp.e, wp_w);
+            return;
+        }
+    }
+    for (;;) {
+        p2 *= 10;
+        delta *= 10;
+        char d = (char)(p2 >> -mp.e);
+        if (d || *len) digits[(*len)++] = (char)('0' + d);
+        p2 &= one_f - 1;
+        kappa--;
+        if (p2 < delta) {
+            *K += kappa;
+            grisu_round(digits, *len, delta, p2, one_f,
+                        wp_w * pow10_64[-kappa]);
+            return;
         }
-        s++;
     }
-    
-    return (has_dot || has_exponent) && has_digit;
 }
 
-static bool has_exponent(const char *s) {
-    while (*s) {
-        if (*s == 'e' || *s == 'E') return true;
-        s++;
-    }
-    return false;
+static void grisu2(double value, char *digits, int *len, int *K) {
+    diy_fp_t v = diy_from_double(value);
+    diy_fp_t w_m, w_p;
+    diy_boundaries(v, &w_m, &w_p);
+    diy_fp_t c_mk = diy_cached_power(w_p.e, K);
+    diy_fp_t w = diy_mul(diy_normalize(v), c_mk);
+    diy_fp_t wp = diy_mul(w_p, c_mk);
+    diy_fp_t wm = diy_mul(w_m, c_mk);
+    wm.f++;
+    wp.f--;
+    grisu_digits(w, wp, wp.f - wm.f, digits, len, K);
 }
 
-static yay_value_t *parse_number_with_validation(parse_ctx_t *ctx, const char *s,
-                                                  int line_num, int col) {
-    /* Check for uppercase E in exponent */
-    const char *e_pos = strchr(s, 'E');
-    if (e_pos) {
-        ctx->error = make_error(ctx, line_num, col + (int)(e_pos - s),
-                               "Uppercase exponent (use lowercase 'e')");
-        return NULL;
+/* Render a finite double into out (no NUL); out must hold 32 bytes.
+ * Callers handle NaN and the infinities. */
+static size_t format_double(double value, char *out) {
+    char *p = out;
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if (bits >> 63) {
+        *p++ = '-';
+        value = -value;
+    }
+    if (value == 0) {
+        memcpy(p, "0.0", 3);
+        return (size_t)(p - out) + 3;
     }
-    
-    /* Validate spaces are not around decimal point */
-    const char *dot = strchr(s, '.');
-    if (dot) {
-        /* Check for space before dot */
-        if (dot > s && *(dot - 1) == ' ') {
-            ctx->error = make_error(ctx, line_num, col + (int)(dot - s - 1),
-                                   "Unexpected space in number");
-            return NULL;
+
+    char digits[18];
+    int len, K;
+    grisu2(value, digits, &len, &K);
+    int kk = len + K; /* 10^(kk-1) <= value < 10^kk */
+
+    if (K >= 0 && kk <= 21) {
+        /* Integral: digits, trailing zeros, and a ".0" to stay a float */
+        memcpy(p, digits, (size_t)len);
+        p += len;
+        for (int i = 0; i < K; i++) *p++ = '0';
+        *p++ = '.';
+        *p++ = '0';
+    } else if (0 < kk && kk <= 21) {
+        /* Decimal point inside the digits */
+        memcpy(p, digits, (size_t)kk);
+        p += kk;
+        *p++ = '.';
+        memcpy(p, digits + kk, (size_t)(len - kk));
+        p += len - kk;
+    } else if (-6 < kk && kk <= 0) {
+        /* Leading zeros after the point */
+        *p++ = '0';
+        *p++ = '.';
+        for (int i = 0; i < -kk; i++) *p++ = '0';
+        memcpy(p, digits, (size_t)len);
+        p += len;
+    } else {
+        /* Exponent form */
+        *p++ = digits[0];
+        if (len > 1) {
+            *p++ = '.';
+            memcpy(p, digits + 1, (size_t)(len - 1));
+            p += len - 1;
         }
-        /* Check for space after dot */
-        if (*(dot + 1) == ' ') {
-            ctx->error = make_error(ctx, line_num, col + (int)(dot - s + 1),
-                                   "Unexpected space in number");
-            return NULL;
+        *p++ = 'e';
+        int e10 = kk - 1;
+        if (e10 < 0) {
+            *p++ = '-';
+            e10 = -e10;
+        } else {
+            *p++ = '+';
         }
+        p += format_uint64((uint64_t)e10, p);
     }
-    
-    /* Remove spaces */
-    char *compact = malloc(strlen(s) + 1);
-    char *p = compact;
-    for (const char *q = s; *q; q++) {
-        if (*q != ' ') *p++ = *q;
-    }
-    *p = '\0';
-    
-    /* Check for float (has decimal point or exponent) */
-    if (strchr(compact, '.') || has_exponent(compact)) {
-        double val = atof(compact);
-        free(compact);
-        return yay_float(val);
-    }
-    
-    /* Integer */
-    bool negative = compact[0] == '-';
-    char *digits = negative ? compact + 1 : compact;
-    
-    yay_value_t *v = yay_int_from_str(digits, negative);
-    free(compact);
-    return v;
+    return (size_t)(p - out);
 }
 
-/* ============================================================================
- * String Parsing
- * ============================================================================ */
+static void encode_scalar(const yay_value_t *v, yay_writer_t *writer) {
+    char tmp[64];
 
-static yay_value_t *parse_double_quoted_string(parse_ctx_t *ctx, const char *s,
-                                                int line_num, int col) {
-    size_t len = strlen(s);
-    if (len < 2 || s[0] != '"' || s[len-1] != '"') {
-        return yay_string(s);
+    if (!v) {
+        yay_writer_write(writer, "null", 4);
+        return;
     }
-    
-    char *out = malloc(len);
-    size_t out_len = 0;
-    
-    for (size_t i = 1; i < len - 1; i++) {
+
+    switch (v->type) {
+        case YAY_NULL:
+            yay_writer_write(writer, "null", 4);
+            break;
+        case YAY_BOOL:
+            if (v->data.boolean) {
+                yay_writer_write(writer, "true", 4);
+            } else {
+                yay_writer_write(writer, "false", 5);
+            }
+            break;
+        case YAY_INT:
+            if (v->data.bigint.negative) {
+                writer_putc(writer, '-');
+            }
+            if (v->data.bigint.digits) {
+                writer_puts(writer, v->data.bigint.digits);
+            } else {
+                int64_t small = v->data.bigint.small;
+                uint64_t mag = small < 0 ? -(uint64_t)small : (uint64_t)small;
+                yay_writer_write(writer, tmp, format_uint64(mag, tmp));
+            }
+            writer_putc(writer, 'n');
+            break;
+        case YAY_FLOAT:
+            if (isnan(v->data.number)) {
+                yay_writer_write(writer, "NaN", 3);
+            } else if (isinf(v->data.number)) {
+                if (v->data.number > 0) {
+                    yay_writer_write(writer, "Infinity", 8);
+                } else {
+                    yay_writer_write(writer, "-Infinity", 9);
+                }
+            } else {
+                yay_writer_write(writer, tmp,
+                                 format_double(v->data.number, tmp));
+            }
+            break;
+        case YAY_STRING:
+            encode_string(writer, v->data.string);
+            break;
+        case YAY_BYTES:
+            writer_putc(writer, '<');
+            encode_hex(writer, v->data.bytes.data, v->data.bytes.length);
+            writer_putc(writer, '>');
+            break;
+        default:
+            break;
+    }
+}
+
+/* One open container on the encoding stack, remembering which child is
+ * emitted next */
+typedef struct {
+    const yay_value_t *value;
+    size_t next;
+} encode_frame_t;
+
+static void encode_value(const yay_value_t *v, yay_writer_t *writer) {
+    /* Iterate with an explicit frame stack so nesting depth is limited by
+     * the heap, not the call stack */
+    encode_frame_t inline_frames[64];
+    encode_frame_t *frames = inline_frames;
+    size_t depth = 0;
+    size_t capacity = 64;
+
+    for (;;) {
+        if (v && (v->type == YAY_ARRAY || v->type == YAY_OBJECT)) {
+            if (depth == capacity) {
+                size_t cap = capacity * 2;
+                encode_frame_t *grown;
+                if (frames == inline_frames) {
+                    grown = mem_alloc(cap * sizeof(*grown));
+                    if (grown) memcpy(grown, frames, depth * sizeof(*grown));
+                } else {
+                    grown = mem_realloc(frames, cap * sizeof(*grown));
+                }
+                if (!grown) {
+                    writer->failed = true;
+                    break;
+                }
+                frames = grown;
+                capacity = cap;
+            }
+            writer_putc(writer, v->type == YAY_ARRAY ? '[' : '{');
+            frames[depth].value = v;
+            frames[depth].next = 0;
+            depth++;
+        } else {
+            encode_scalar(v, writer);
+        }
+
+        /* Close finished containers, then descend into the next child */
+        while (depth > 0) {
+            encode_frame_t *top = &frames[depth - 1];
+            const yay_value_t *parent = top->value;
+            size_t count = parent->type == YAY_ARRAY
+                ? parent->data.array.length
+                : parent->data.object.length;
+            if (top->next < count) {
+                if (top->next > 0) yay_writer_write(writer, ", ", 2);
+                if (parent->type == YAY_OBJECT) {
+                    writer_puts(writer, parent->data.object.pairs[top->next].key);
+                    yay_writer_write(writer, ": ", 2);
+                    v = parent->data.object.pairs[top->next].value;
+                } else {
+                    v = parent->data.array.items[top->next];
+                }
+                top->next++;
+                break;
+            }
+            writer_putc(writer, parent->type == YAY_ARRAY ? ']' : '}');
+            depth--;
+        }
+        if (depth == 0) break;
+    }
+    if (frames != inline_frames) mem_free(frames);
+}
+
+bool yay_encode(const yay_value_t *value, yay_writer_t *writer) {
+    encode_value(value, writer);
+    return !writer->failed;
+}
+
+char *yay_to_string(const yay_value_t *value) {
+    yay_writer_t writer;
+    yay_writer_init(&writer);
+    encode_value(value, &writer);
+    if (writer.failed) {
+        yay_writer_free(&writer);
+        return NULL;
+    }
+    return yay_writer_take(&writer);
+}
+
+/* ============================================================================
+ * Binary YAYB Format
+ * ============================================================================
+ *
+ * A YAYB image is a small header followed by the nodes of a value tree laid
+ * out post-order. Every pointer field holds an offset from the start of the
+ * image instead of an address, so a compiled file can be written to disk
+ * once and mmap'd back at every later start; yay_load_mapped relocates the
+ * offsets into real pointers in place, after which the tree is traversed
+ * with the ordinary accessors.
+ */
+
+#define YAYB_MAGIC   "YAYB"
+#define YAYB_VERSION 1u
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t value_size;    /* sizeof(yay_value_t) of the producer */
+    uint32_t pointer_size;  /* sizeof(void *) of the producer */
+    uint64_t root;          /* offset of the root node */
+} yayb_header_t;
+
+/* Growable image buffer; the header occupies offset 0, so an offset of 0
+ * doubles as NULL */
+typedef struct {
+    uint8_t *data;
+    size_t length;
+    size_t capacity;
+    bool failed;
+} yayb_image_t;
+
+static size_t image_append(yayb_image_t *image, const void *data, size_t length) {
+    if (image->failed) return 0;
+    if (image->length + length > image->capacity) {
+        size_t want = image->capacity ? image->capacity * 2 : 256;
+        while (image->length + length > want) want *= 2;
+        uint8_t *grown = mem_realloc(image->data, want);
+        if (!grown) {
+            image->failed = true;
+            return 0;
+        }
+        image->data = grown;
+        image->capacity = want;
+    }
+    size_t offset = image->length;
+    if (data) {
+        memcpy(image->data + offset, data, length);
+    } else {
+        memset(image->data + offset, 0, length);
+    }
+    image->length += length;
+    return offset;
+}
+
+/* Pad the image so the next record is aligned for yay_value_t */
+static void image_align(yayb_image_t *image) {
+    size_t rem = image->length % _Alignof(yay_value_t);
+    if (rem) image_append(image, NULL, _Alignof(yay_value_t) - rem);
+}
+
+/* Stash an image offset in a pointer slot of a node being compiled */
+#define IMAGE_REF(offset) ((void *)(uintptr_t)(offset))
+
+/* Append a value post-order: children and owned buffers first, then the
+ * node referencing them by offset. Returns the node's offset, or 0 on
+ * failure. */
+static size_t image_value(yayb_image_t *image, const yay_value_t *value) {
+    yay_value_t node = *value;
+    switch (value->type) {
+        case YAY_NULL:
+        case YAY_BOOL:
+        case YAY_FLOAT:
+            break;
+        case YAY_INT:
+            /* The limb cache is process-local, never part of the image */
+            node.data.bigint.limbs = NULL;
+            node.data.bigint.limb_count = 0;
+            if (value->data.bigint.digits) {
+                size_t off = image_append(image, value->data.bigint.digits,
+                                          strlen(value->data.bigint.digits) + 1);
+                node.data.bigint.digits = IMAGE_REF(off);
+            }
+            break;
+        case YAY_STRING: {
+            size_t off = image_append(image, value->data.string,
+                                      strlen(value->data.string) + 1);
+            node.data.string = IMAGE_REF(off);
+            break;
+        }
+        case YAY_BYTES:
+            if (value->data.bytes.length) {
+                size_t off = image_append(image, value->data.bytes.data,
+                                          value->data.bytes.length);
+                node.data.bytes.data = IMAGE_REF(off);
+            } else {
+                node.data.bytes.data = NULL;
+            }
+            break;
+        case YAY_ARRAY: {
+            size_t count = value->data.array.length;
+            uintptr_t *items = count ? mem_alloc(count * sizeof(uintptr_t)) : NULL;
+            if (count && !items) {
+                image->failed = true;
+                return 0;
+            }
+            for (size_t i = 0; i < count; i++) {
+                items[i] = image_value(image, value->data.array.items[i]);
+            }
+            image_align(image);
+            size_t off = count
+                ? image_append(image, items, count * sizeof(uintptr_t))
+                : 0;
+            mem_free(items);
+            node.data.array.items = IMAGE_REF(off);
+            node.data.array.capacity = count;
+            break;
+        }
+        case YAY_OBJECT: {
+            size_t count = value->data.object.length;
+            yay_pair_t *pairs = count ? mem_alloc(count * sizeof(yay_pair_t)) : NULL;
+            if (count && !pairs) {
+                image->failed = true;
+                return 0;
+            }
+            for (size_t i = 0; i < count; i++) {
+                const yay_pair_t *pair = &value->data.object.pairs[i];
+                pairs[i].key = IMAGE_REF(image_append(image, pair->key,
+                                                      strlen(pair->key) + 1));
+                pairs[i].value = IMAGE_REF(image_value(image, pair->value));
+            }
+            image_align(image);
+            size_t off = count
+                ? image_append(image, pairs, count * sizeof(yay_pair_t))
+                : 0;
+            mem_free(pairs);
+            node.data.object.pairs = IMAGE_REF(off);
+            node.data.object.capacity = count;
+            /* The hash index is rebuilt lazily by mutators; mapped trees
+             * are read-only and use object_find's linear fallback */
+            node.data.object.index = NULL;
+            node.data.object.index_capacity = 0;
+            break;
+        }
+    }
+    image_align(image);
+    return image_append(image, &node, sizeof(node));
+}
+
+bool yay_compile(const yay_value_t *value, yay_writer_t *writer) {
+    if (!value || !writer) return false;
+    yayb_image_t image = {0};
+    yayb_header_t header = {0};
+    memcpy(header.magic, YAYB_MAGIC, 4);
+    header.version = YAYB_VERSION;
+    header.value_size = (uint32_t)sizeof(yay_value_t);
+    header.pointer_size = (uint32_t)sizeof(void *);
+    image_append(&image, &header, sizeof(header));
+    size_t root = image_value(&image, value);
+    bool ok = root != 0 && !image.failed;
+    if (ok) {
+        ((yayb_header_t *)(void *)image.data)->root = root;
+        ok = yay_writer_write(writer, (const char *)image.data, image.length);
+    }
+    mem_free(image.data);
+    return ok;
+}
+
+/* Turn an offset stored in a pointer slot back into a bounds-checked
+ * pointer; width is the minimum number of addressable bytes */
+static void *mapped_ref(uint8_t *base, size_t length, uintptr_t offset,
+                        size_t width) {
+    if (offset == 0 || offset > length || width > length - offset) return NULL;
+    return base + offset;
+}
+
+/* Turn an offset stored in a char * slot back into a pointer, requiring a
+ * NUL terminator inside the image so the strlen/strcmp the accessors run
+ * later cannot read past the end of the mapping */
+static char *mapped_str(uint8_t *base, size_t length, uintptr_t offset) {
+    if (offset == 0 || offset >= length) return NULL;
+    if (!memchr(base + offset, 0, length - offset)) return NULL;
+    return (char *)(base + offset);
+}
+
+/* Worklist of pointer slots still holding offsets; failure is sticky,
+ * like yayb_image_t on the compile side */
+typedef struct {
+    yay_value_t ***slots;
+    size_t depth;
+    size_t capacity;
+    bool failed;
+} mapped_stack_t;
+
+static void mapped_push(mapped_stack_t *stack, yay_value_t **slot) {
+    if (stack->failed) return;
+    if (stack->depth == stack->capacity) {
+        size_t want = stack->capacity * 2;
+        yay_value_t ***grown = mem_realloc(stack->slots,
+                                           want * sizeof(*grown));
+        if (!grown) {
+            stack->failed = true;
+            return;
+        }
+        stack->slots = grown;
+        stack->capacity = want;
+    }
+    stack->slots[stack->depth++] = slot;
+}
+
+/* Relocate the tree hanging off *root_slot in place. The worklist keeps
+ * the walk iterative, and the node budget — no well-formed image holds
+ * more nodes than fit in its bytes — turns an offset cycle into a clean
+ * failure instead of unbounded recursion. */
+static bool mapped_fixup(uint8_t *base, size_t length,
+                         yay_value_t **root_slot) {
+    mapped_stack_t stack = {0};
+    stack.capacity = 16;
+    stack.slots = mem_alloc(stack.capacity * sizeof(*stack.slots));
+    if (!stack.slots) return false;
+    mapped_push(&stack, root_slot);
+    size_t budget = length / sizeof(yay_value_t);
+    bool ok = true;
+    while (ok && !stack.failed && stack.depth > 0) {
+        yay_value_t **slot = stack.slots[--stack.depth];
+        uintptr_t offset = (uintptr_t)*slot;
+        if (budget == 0 || offset == 0 ||
+            offset % _Alignof(yay_value_t) != 0 || offset > length ||
+            sizeof(yay_value_t) > length - offset) {
+            ok = false;
+            break;
+        }
+        budget--;
+        yay_value_t *node = (yay_value_t *)(void *)(base + offset);
+        *slot = node;
+        switch (node->type) {
+            case YAY_NULL:
+            case YAY_FLOAT:
+                break;
+            case YAY_BOOL: {
+                /* Normalize through unsigned char: a corrupt image can
+                 * carry a byte that is not a valid _Bool, and reading
+                 * that directly is undefined */
+                unsigned char raw;
+                memcpy(&raw, &node->data.boolean, 1);
+                node->data.boolean = raw != 0;
+                break;
+            }
+            case YAY_INT:
+                node->data.bigint.limbs = NULL;
+                node->data.bigint.limb_count = 0;
+                if (node->data.bigint.digits) {
+                    node->data.bigint.digits =
+                        mapped_str(base, length,
+                                   (uintptr_t)node->data.bigint.digits);
+                    ok = node->data.bigint.digits != NULL;
+                }
+                break;
+            case YAY_STRING:
+                node->data.string =
+                    mapped_str(base, length, (uintptr_t)node->data.string);
+                ok = node->data.string != NULL;
+                break;
+            case YAY_BYTES:
+                if (node->data.bytes.length) {
+                    node->data.bytes.data =
+                        mapped_ref(base, length,
+                                   (uintptr_t)node->data.bytes.data,
+                                   node->data.bytes.length);
+                    ok = node->data.bytes.data != NULL;
+                } else {
+                    node->data.bytes.data = NULL;
+                }
+                break;
+            case YAY_ARRAY: {
+                size_t count = node->data.array.length;
+                if (count == 0) {
+                    node->data.array.items = NULL;
+                    break;
+                }
+                if (count > length / sizeof(yay_value_t *)) {
+                    ok = false;
+                    break;
+                }
+                yay_value_t **items =
+                    mapped_ref(base, length,
+                               (uintptr_t)node->data.array.items,
+                               count * sizeof(yay_value_t *));
+                if (!items) {
+                    ok = false;
+                    break;
+                }
+                node->data.array.items = items;
+                for (size_t i = 0; i < count; i++) {
+                    mapped_push(&stack, &items[i]);
+                }
+                break;
+            }
+            case YAY_OBJECT: {
+                size_t count = node->data.object.length;
+                node->data.object.index = NULL;
+                node->data.object.index_capacity = 0;
+                if (count == 0) {
+                    node->data.object.pairs = NULL;
+                    break;
+                }
+                if (count > length / sizeof(yay_pair_t)) {
+                    ok = false;
+                    break;
+                }
+                yay_pair_t *pairs =
+                    mapped_ref(base, length,
+                               (uintptr_t)node->data.object.pairs,
+                               count * sizeof(yay_pair_t));
+                if (!pairs) {
+                    ok = false;
+                    break;
+                }
+                node->data.object.pairs = pairs;
+                node->data.object.sorted = true;
+                for (size_t i = 0; ok && i < count; i++) {
+                    pairs[i].key = mapped_str(base, length,
+                                              (uintptr_t)pairs[i].key);
+                    if (!pairs[i].key) {
+                        ok = false;
+                        break;
+                    }
+                    mapped_push(&stack, &pairs[i].value);
+                    /* Recompute sortedness from the actual keys instead
+                     * of trusting the file's flag */
+                    if (i > 0 && node->data.object.sorted &&
+                        strcmp(pairs[i - 1].key, pairs[i].key) >= 0) {
+                        node->data.object.sorted = false;
+                    }
+                }
+                break;
+            }
+            default:
+                ok = false;
+                break;
+        }
+    }
+    ok = ok && !stack.failed;
+    mem_free(stack.slots);
+    return ok;
+}
+
+yay_value_t *yay_load_mapped(void *data, size_t length) {
+    if (!data || length < sizeof(yayb_header_t)) return NULL;
+    if ((uintptr_t)data % _Alignof(yay_value_t) != 0) return NULL;
+    yayb_header_t *header = data;
+    if (memcmp(header->magic, YAYB_MAGIC, 4) != 0 ||
+        header->version != YAYB_VERSION ||
+        header->value_size != sizeof(yay_value_t) ||
+        header->pointer_size != sizeof(void *)) {
+        return NULL;
+    }
+    yay_value_t *root = (yay_value_t *)(uintptr_t)header->root;
+    if (!mapped_fixup(data, length, &root)) return NULL;
+    return root;
+}
+
+/* ============================================================================
+ * Error Helpers
+ * ============================================================================ */
+
+/* Record an error in the context's inline box. Nothing is allocated and
+ * nothing is formatted beyond the base message: callers on speculative
+ * paths can discard or overwrite the error for free, and the decorated
+ * human-readable message is rendered only if yay_error_message is ever
+ * called on the published error. */
+static yay_error_t *make_error_v(parse_ctx_t *ctx, int line, int col,
+                                 const char *fmt, va_list args) {
+    yay_error_impl_t *box = &ctx->error_box;
+    /* First error wins: with the phases pipelined, a scan error parks in
+     * the box while the parser winds down, and must not be replaced by
+     * the truncated stream's follow-on complaints */
+    if (ctx->error) return ctx->error;
+    vsnprintf(box->base, sizeof(box->base), fmt, args);
+    box->error.message = NULL;
+    box->error.line = line + 1;
+    box->error.column = col + 1;
+    box->filename = NULL;
+    box->located = true;
+    return &box->error;
+}
+
+static yay_error_t *make_error(parse_ctx_t *ctx, int line, int col, 
+                               const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    yay_error_t *err = make_error_v(ctx, line, col, fmt, args);
+    va_end(args);
+    return err;
+}
+
+/* Record an error at a byte offset in the source, reconstructing the
+ * line and column by binary search over the line-start index -- this is
+ * the only place positions are materialized, so tokens do not carry them */
+static yay_error_t *make_error_at(parse_ctx_t *ctx, size_t at,
+                                  const char *fmt, ...) {
+    int line = 0;
+    int col = 0;
+    if (at <= ctx->source_len && ctx->line_start_count > 0) {
+        size_t lo = 0;
+        size_t hi = ctx->line_start_count - 1;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo + 1) / 2;
+            if (ctx->line_starts[mid] <= at) {
+                lo = mid;
+            } else {
+                hi = mid - 1;
+            }
+        }
+        line = (int)lo;
+        col = (int)(at - ctx->line_starts[lo]);
+    }
+    va_list args;
+    va_start(args, fmt);
+    yay_error_t *err = make_error_v(ctx, line, col, fmt, args);
+    va_end(args);
+    return err;
+}
+
+/* Byte offset of the start of a token's line in the scratch copy of the
+ * source, found by binary search over the line-start index, or SIZE_MAX
+ * for synthetic tokens whose text is a static string */
+static size_t token_line_start(const parse_ctx_t *ctx, const token_t *t) {
+    uintptr_t text = (uintptr_t)t->text;
+    uintptr_t base = (uintptr_t)ctx->scratch;
+    if (text < base || text > base + ctx->source_len) return SIZE_MAX;
+    if (ctx->line_start_count == 0) return SIZE_MAX;
+    size_t raw = (size_t)(text - base);
+    size_t lo = 0;
+    size_t hi = ctx->line_start_count - 1;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo + 1) / 2;
+        if (ctx->line_starts[mid] <= raw) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return ctx->line_starts[lo];
+}
+
+/* Offset of a token's indent column. Token text for list items excludes
+ * the "- " leader, so columns have always counted from the indent, not
+ * from where the text happens to begin in the line. */
+static size_t token_offset(const parse_ctx_t *ctx, const token_t *t) {
+    size_t start = token_line_start(ctx, t);
+    return start == SIZE_MAX ? start : start + (size_t)t->indent;
+}
+
+/* Offset of the start of the line a token sits on (column zero) */
+static size_t token_offset0(const parse_ctx_t *ctx, const token_t *t) {
+    return token_line_start(ctx, t);
+}
+
+/* Like make_error, but the message is complete as-is and carries no
+ * position (matching the historical errors that never had one) */
+static yay_error_t *make_error_plain(parse_ctx_t *ctx, const char *message) {
+    yay_error_impl_t *box = &ctx->error_box;
+    if (ctx->error) return ctx->error;
+    snprintf(box->base, sizeof(box->base), "%s", message);
+    box->error.message = NULL;
+    box->error.line = 0;
+    box->error.column = 0;
+    box->filename = NULL;
+    box->located = false;
+    return &box->error;
+}
+
+/* Heap error sized for lazy rendering; message may be filled eagerly by
+ * cold-path callers */
+static yay_error_t *error_alloc(void) {
+    yay_error_impl_t *err = mem_calloc(1, sizeof(yay_error_impl_t));
+    return err ? &err->error : NULL;
+}
+
+/* Copy the context's inline error to the heap so it can outlive the parse */
+static yay_error_t *error_publish(parse_ctx_t *ctx) {
+    yay_error_impl_t *heap = mem_alloc(sizeof(yay_error_impl_t));
+    if (!heap) return NULL;
+    *heap = ctx->error_box;
+    if (heap->located && ctx->filename) {
+        heap->filename = str_dup(ctx->filename);
+    }
+    return &heap->error;
+}
+
+/* ============================================================================
+ * Event Emission
+ * ============================================================================ */
+
+/* Each emitter checks for events mode, a registered callback, and whether a
+ * previous callback asked to stop. */
+#define EMIT(ctx, cb, ...) \
+    do { \
+        if ((ctx)->events && !(ctx)->events_aborted && (ctx)->events->cb) { \
+            if (!(ctx)->events->cb(__VA_ARGS__)) { \
+                (ctx)->events_aborted = true; \
+            } \
+        } \
+    } while (0)
+
+static void emit_array_start(parse_ctx_t *ctx) {
+    EMIT(ctx, on_array_start, ctx->user_data);
+}
+
+static void emit_array_end(parse_ctx_t *ctx) {
+    EMIT(ctx, on_array_end, ctx->user_data);
+}
+
+static void emit_object_start(parse_ctx_t *ctx) {
+    EMIT(ctx, on_object_start, ctx->user_data);
+}
+
+static void emit_object_end(parse_ctx_t *ctx) {
+    EMIT(ctx, on_object_end, ctx->user_data);
+}
+
+static void emit_object_key(parse_ctx_t *ctx, const char *key) {
+    EMIT(ctx, on_object_key, key, strlen(key), ctx->user_data);
+}
+
+/* Emit events for a completed value. Leaf scalars arrive here directly;
+ * inline arrays/objects are parsed into small transient trees and then
+ * replayed recursively. */
+static void emit_tree(parse_ctx_t *ctx, const yay_value_t *v) {
+    if (!v) return;
+    switch (v->type) {
+        case YAY_NULL:
+            EMIT(ctx, on_null, ctx->user_data);
+            break;
+        case YAY_BOOL:
+            EMIT(ctx, on_bool, v->data.boolean, ctx->user_data);
+            break;
+        case YAY_INT:
+            if (v->data.bigint.digits) {
+                EMIT(ctx, on_int, v->data.bigint.digits,
+                     v->data.bigint.negative, ctx->user_data);
+            } else {
+                char digits[24];
+                int64_t small = v->data.bigint.small;
+                uint64_t mag = small < 0 ? -(uint64_t)small : (uint64_t)small;
+                digits[format_uint64(mag, digits)] = '\0';
+                EMIT(ctx, on_int, digits, v->data.bigint.negative,
+                     ctx->user_data);
+            }
+            break;
+        case YAY_FLOAT:
+            EMIT(ctx, on_float, v->data.number, ctx->user_data);
+            break;
+        case YAY_STRING:
+            EMIT(ctx, on_string, v->data.string, strlen(v->data.string),
+                 ctx->user_data);
+            break;
+        case YAY_BYTES:
+            EMIT(ctx, on_bytes, v->data.bytes.data, v->data.bytes.length,
+                 ctx->user_data);
+            break;
+        case YAY_ARRAY:
+            emit_array_start(ctx);
+            for (size_t i = 0; i < v->data.array.length; i++) {
+                emit_tree(ctx, v->data.array.items[i]);
+            }
+            emit_array_end(ctx);
+            break;
+        case YAY_OBJECT:
+            emit_object_start(ctx);
+            for (size_t i = 0; i < v->data.object.length; i++) {
+                emit_object_key(ctx, v->data.object.pairs[i].key);
+                emit_tree(ctx, v->data.object.pairs[i].value);
+            }
+            emit_object_end(ctx);
+            break;
+    }
+}
+
+/* Consume a child value in events mode: containers have already emitted
+ * their own events and return the sentinel; anything else is replayed and
+ * released immediately. */
+static void emit_child(parse_ctx_t *ctx, yay_value_t *v) {
+    if (v == &event_sentinel) return;
+    emit_tree(ctx, v);
+    yay_free(v);
+}
+
+/* Attach a parsed child to its container, or emit it in events mode */
+static void array_attach(parse_ctx_t *ctx, yay_value_t *arr, yay_value_t *item) {
+    if (ctx->events) {
+        emit_child(ctx, item);
+    } else {
+        yay_array_push(arr, item);
+    }
+}
+
+static void object_attach(parse_ctx_t *ctx, yay_value_t *obj, char *key,
+                          yay_value_t *value) {
+    if (ctx->events) {
+        emit_child(ctx, value);
+    } else {
+        object_set_cell(obj, key, value);
+    }
+}
+
+/* ============================================================================
+ * Phase 1: Scanner
+ * ============================================================================ */
+
+static void add_scan_line(parse_ctx_t *ctx, const char *line, int indent,
+                          const char *leader, const char *start) {
+    if (ctx->line_count >= ctx->line_capacity) {
+        ctx->line_capacity *= 2;
+        ctx->lines = mem_realloc(ctx->lines, ctx->line_capacity * sizeof(scan_line_t));
+    }
+
+    scan_line_t *sl = &ctx->lines[ctx->line_count++];
+    sl->line = line;
+    sl->indent = indent;
+    sl->leader = leader;
+    sl->start = start;
+}
+
+/* Fast-forward over whole 16-byte blocks that contain only printable ASCII
+ * and newlines, updating line/col as it goes. Returns the new position;
+ * callers fall back to the scalar UTF-8 decoder for anything else. */
+static size_t skip_clean_blocks(const char *src, size_t i, size_t len,
+                                int *line, int *col) {
+#if defined(__SSE2__)
+    while (i + 16 <= len) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(src + i));
+        /* Signed compares: bytes >= 0x80 are negative, so the < 0x20 test
+         * also catches high bytes and routes them to the slow decoder. */
+        __m128i below = _mm_cmplt_epi8(chunk, _mm_set1_epi8(0x20));
+        __m128i above = _mm_cmpgt_epi8(chunk, _mm_set1_epi8(0x7E));
+        __m128i newline = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n'));
+        __m128i bad = _mm_andnot_si128(newline, _mm_or_si128(below, above));
+        if (_mm_movemask_epi8(bad) != 0) break;
+        for (size_t j = 0; j < 16; j++) {
+            if (src[i + j] == '\n') {
+                (*line)++;
+                *col = 0;
+            } else {
+                (*col)++;
+            }
+        }
+        i += 16;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    while (i + 16 <= len) {
+        uint8x16_t chunk = vld1q_u8((const uint8_t *)(src + i));
+        uint8x16_t ok = vandq_u8(vcgeq_u8(chunk, vdupq_n_u8(0x20)),
+                                 vcleq_u8(chunk, vdupq_n_u8(0x7E)));
+        ok = vorrq_u8(ok, vceqq_u8(chunk, vdupq_n_u8('\n')));
+        if (vminvq_u8(ok) != 0xFF) break;
+        for (size_t j = 0; j < 16; j++) {
+            if (src[i + j] == '\n') {
+                (*line)++;
+                *col = 0;
+            } else {
+                (*col)++;
+            }
+        }
+        i += 16;
+    }
+#else
+    /* Scalar fallback: classify small blocks so the all-ASCII case still
+     * skips the full UTF-8 decoder */
+    while (i + 8 <= len) {
+        bool clean = true;
+        for (size_t j = 0; j < 8; j++) {
+            unsigned char c = src[i + j];
+            if ((c < 0x20 || c > 0x7E) && c != '\n') {
+                clean = false;
+                break;
+            }
+        }
+        if (!clean) break;
+        for (size_t j = 0; j < 8; j++) {
+            if (src[i + j] == '\n') {
+                (*line)++;
+                *col = 0;
+            } else {
+                (*col)++;
+            }
+        }
+        i += 8;
+    }
+#endif
+    (void)len;
+    return i;
+}
+
+/* Count leading spaces a 16-byte block at a time: compare the whole block
+ * against ' ' and locate the first mismatch in the movemask, so deep
+ * indentation costs one branch per block instead of one per column. */
+static size_t count_leading_spaces(const char *s, size_t len) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    __m128i sp = _mm_set1_epi8(' ');
+    while (i + 16 <= len) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(s + i));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, sp));
+        if (mask != 0xFFFF) {
+            return i + (size_t)__builtin_ctz(~mask);
+        }
+        i += 16;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    uint8x16_t sp = vdupq_n_u8(' ');
+    while (i + 16 <= len) {
+        uint8x16_t chunk = vld1q_u8((const uint8_t *)(s + i));
+        if (vminvq_u8(vceqq_u8(chunk, sp)) != 0xFF) break;
+        i += 16;
+    }
+#endif
+    while (i < len && s[i] == ' ') i++;
+    return i;
+}
+
+/* Count newlines so scan lines and lexer tokens can be sized exactly once
+ * up front instead of doubling through realloc copies. */
+static size_t count_newlines(const char *src, size_t len) {
+    size_t count = 0;
+    size_t i = 0;
+#if defined(__SSE2__)
+    __m128i nl = _mm_set1_epi8('\n');
+    while (i + 16 <= len) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(src + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, nl));
+        count += (size_t)__builtin_popcount((unsigned)mask);
+        i += 16;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    uint8x16_t nl = vdupq_n_u8('\n');
+    uint8x16_t one = vdupq_n_u8(1);
+    while (i + 16 <= len) {
+        uint8x16_t chunk = vld1q_u8((const uint8_t *)(src + i));
+        count += vaddvq_u8(vandq_u8(vceqq_u8(chunk, nl), one));
+        i += 16;
+    }
+#endif
+    for (; i < len; i++) {
+        if (src[i] == '\n') count++;
+    }
+    return count;
+}
+
+/* Validate one line's code points against the grammar's allowed set */
+static bool scan_validate_line(parse_ctx_t *ctx, const char *line_s,
+                               size_t line_len, int line_num) {
+    int line = line_num, col = 0;
+    size_t i = 0;
+    while (i < line_len) {
+        /* Vectorized fast path over printable-ASCII blocks */
+        i = skip_clean_blocks(line_s, i, line_len, &line, &col);
+        if (i >= line_len) break;
+        unsigned char c = line_s[i];
+        uint32_t cp;
+        size_t seq_len;
+        /* Decode UTF-8 */
+        if (c < 0x80) {
+            cp = c;
+            seq_len = 1;
+        } else if ((c & 0xE0) == 0xC0 && i + 1 < line_len) {
+            cp = ((uint32_t)(c & 0x1F) << 6) | (line_s[i+1] & 0x3F);
+            seq_len = 2;
+        } else if ((c & 0xF0) == 0xE0 && i + 2 < line_len) {
+            cp = ((uint32_t)(c & 0x0F) << 12) | ((uint32_t)(line_s[i+1] & 0x3F) << 6) | (line_s[i+2] & 0x3F);
+            seq_len = 3;
+        } else if ((c & 0xF8) == 0xF0 && i + 3 < line_len) {
+            cp = ((uint32_t)(c & 0x07) << 18) | ((uint32_t)(line_s[i+1] & 0x3F) << 12) | ((uint32_t)(line_s[i+2] & 0x3F) << 6) | (line_s[i+3] & 0x3F);
+            seq_len = 4;
+        } else {
+            cp = c;
+            seq_len = 1;
+        }
+        /* Check if allowed */
+        int allowed = (cp == 0x000A)
+            || (0x0020 <= cp && cp <= 0x007E)
+            || (0x00A0 <= cp && cp <= 0xD7FF)
+            || (0xE000 <= cp && cp <= 0xFFFD && !(0xFDD0 <= cp && cp <= 0xFDEF))
+            || (0x10000 <= cp && cp <= 0x10FFFF && (cp & 0xFFFF) < 0xFFFE);
+        if (!allowed) {
+            if (cp == 0x09) {
+                ctx->error = make_error(ctx, line, col, "Tab not allowed (use spaces)");
+                return false;
+            }
+            if (cp >= 0xD800 && cp <= 0xDFFF) {
+                ctx->error = make_error(ctx, line, col, "Illegal surrogate");
+                return false;
+            }
+            ctx->error = make_error(ctx, line, col, "Forbidden code point U+%04X", cp);
+            return false;
+        }
+        col++;
+        i += seq_len;
+    }
+    return true;
+}
+
+/* Reject the BOM and set up the scratch copy and scan cursor. Lines are
+ * produced on demand by scan_pump, so scanning, lexing, and parsing
+ * stream the document through one cache-resident window instead of each
+ * making its own full pass. */
+static bool scan_init(parse_ctx_t *ctx) {
+    const char *src = ctx->source;
+    size_t len = ctx->source_len;
+
+    /* Check for BOM */
+    if (len >= 3 && (unsigned char)src[0] == 0xEF &&
+        (unsigned char)src[1] == 0xBB && (unsigned char)src[2] == 0xBF) {
+        ctx->error = make_error(ctx, 0, 0, "Illegal BOM");
+        return false;
+    }
+
+    /* The source is split in place on a single mutable copy by replacing
+     * newlines with NULs, so scan lines borrow slices instead of
+     * allocating per line. */
+    if (ctx->adopt_source) {
+        ctx->scratch = (char *)src;
+    } else {
+        ctx->scratch = str_dup_len(src, len);
+        STATS_ALLOC();
+    }
+    ctx->line_starts = mem_alloc(ctx->line_capacity * sizeof(size_t));
+    STATS_ALLOC();
+    ctx->scan_offset = 0;
+    ctx->scan_line_num = 0;
+    return true;
+}
+
+/* Produce the next batch of scan lines, validating code points line by
+ * line as they stream past. A scan error parks the cursor: scan_done is
+ * set so the pull loops wind down, and the error survives because later
+ * phases never overwrite an earlier one. */
+#define SCAN_CHUNK 64
+
+static void scan_pump_impl(parse_ctx_t *ctx) {
+    char *scratch = ctx->scratch;
+    size_t len = ctx->source_len;
+
+    for (int produced = 0; produced < SCAN_CHUNK;) {
+        if (ctx->scan_offset > len) {
+            ctx->scan_done = true;
+            return;
+        }
+        char *line_start = scratch + ctx->scan_offset;
+        int line_num = ctx->scan_line_num;
+        ctx->line_starts[ctx->line_start_count++] = ctx->scan_offset;
+        /* Find end of line */
+        char *line_end = memchr(line_start, '\n',
+                                (size_t)(scratch + len - line_start));
+        if (!line_end) line_end = scratch + len;
+
+        size_t line_len = line_end - line_start;
+
+        if (!scan_validate_line(ctx, line_start, line_len, line_num)) {
+            ctx->scan_done = true;
+            return;
+        }
+        *line_end = '\0';
+
+        /* Check for trailing space */
+        if (line_len > 0 && line_start[line_len - 1] == ' ') {
+            ctx->error = make_error(ctx, line_num, (int)line_len - 1,
+                                    "Unexpected trailing space");
+            ctx->scan_done = true;
+            return;
+        }
+
+        /* Count indent */
+        int indent = (int)count_leading_spaces(line_start, line_len);
+
+        const char *rest = line_start + indent;
+        size_t rest_len = line_len - indent;
+
+        /* Skip top-level comments */
+        if (rest_len > 0 && rest[0] == '#' && indent == 0) {
+            ctx->scan_offset = (size_t)(line_end - scratch) + 1;
+            ctx->scan_line_num++;
+            continue;
+        }
+
+        /* Extract leader and content. Most lines open with neither "-"
+         * nor "*": one test routes them around leader classification. */
+        const char *leader = "";
+        const char *content = rest;
+
+        if (rest_len > 0 && (rest[0] == '-' || rest[0] == '*')) {
+            if (rest_len >= 2 && rest[0] == '-' && rest[1] == ' ') {
+                leader = "- ";
+                content = rest + 2;
+            } else if (rest_len == 1 && rest[0] == '-') {
+                leader = "- ";
+                content = rest + 1;
+            } else if (rest_len >= 2 && rest[0] == '-' && rest[1] != ' ' &&
+                       rest[1] != '.' && !(rest[1] >= '0' && rest[1] <= '9') &&
+                       strncmp(rest, "-infinity", 9) != 0) {
+                /* Compact list syntax (-value without space) is not allowed */
+                ctx->error = make_error(ctx, line_num, indent + 1,
+                                        "Expected space after \"-\"");
+                ctx->scan_done = true;
+                return;
+            } else if (rest[0] == '*' && (rest_len == 1 || rest[1] == ' ')) {
+                ctx->error = make_error(ctx, line_num, indent,
+                                        "Unexpected character \"*\"");
+                ctx->scan_done = true;
+                return;
+            }
+        }
+
+        /* Add the line */
+        add_scan_line(ctx, content, indent, leader, line_start);
+        produced++;
+
+        if (line_end >= scratch + len) {
+            ctx->scan_done = true;
+            return;
+        }
+        ctx->scan_offset = (size_t)(line_end - scratch) + 1;
+        ctx->scan_line_num++;
+    }
+}
+
+#ifdef YAY_STATS
+static void scan_pump(parse_ctx_t *ctx) {
+    double start = stats_now();
+    size_t *saved = stats_alloc_slot;
+    stats_alloc_slot = &stats_current.scan_allocations;
+    scan_pump_impl(ctx);
+    stats_alloc_slot = saved;
+    stats_current.scan_seconds += stats_now() - start;
+}
+#else
+#define scan_pump scan_pump_impl
+#endif
+
+/* ============================================================================
+ * Phase 2: Outline Lexer
+ * ============================================================================
+ *
+ * Tokens are pulled lazily: the parser asks for an absolute token index and
+ * the lexer advances one scan line at a time until that token exists. The
+ * window is a deque of fixed-size chunks, so token pointers stay stable as
+ * the window grows, and chunks behind the parser's cursor are recycled --
+ * the full token stream for a large document never exists at once.
+ */
+
+#define TOKEN_CHUNK 256
+
+static int find_colon_outside_quotes(const char *s);
+
+static void add_token(parse_ctx_t *ctx, token_type_t type, const char *text,
+                      int indent) {
+    size_t slot = ctx->token_limit - ctx->token_base;
+    if (slot == ctx->chunk_count * TOKEN_CHUNK) {
+        if (ctx->chunk_count >= ctx->chunk_capacity) {
+            size_t want = ctx->chunk_capacity ? ctx->chunk_capacity * 2 : 8;
+            ctx->token_chunks = mem_realloc(ctx->token_chunks,
+                                        want * sizeof(token_t *));
+            ctx->chunk_capacity = want;
+        }
+        token_t *chunk = ctx->spare_chunk;
+        ctx->spare_chunk = NULL;
+        if (!chunk) {
+            chunk = mem_alloc(TOKEN_CHUNK * sizeof(token_t));
+            STATS_ALLOC();
+        }
+        ctx->token_chunks[ctx->chunk_count++] = chunk;
+    }
+
+    token_t *t = &ctx->token_chunks[slot / TOKEN_CHUNK][slot % TOKEN_CHUNK];
+    t->type = type;
+    t->text = text;
+    t->indent = indent;
+    t->colon = type == TOKEN_TEXT ? find_colon_outside_quotes(text) : -1;
+    ctx->token_limit++;
+    STATS_COUNT(tokens, 1);
+}
+
+/* Lex one scan line's worth of tokens; the indent stack and blank-line
+ * state persist in the context between calls. */
+static void lex_pump_impl(parse_ctx_t *ctx) {
+    if (ctx->lex_line >= ctx->line_count) {
+        /* The pull loops pump the scanner before the lexer, so running
+         * out of lines here means the document is fully scanned */
+        if (!ctx->scan_done) return;
+        /* Close remaining blocks */
+        while (ctx->lex_stack_top > 0) {
+            add_token(ctx, TOKEN_STOP, "", 0);
+            ctx->lex_stack_top--;
+        }
+        ctx->lex_done = true;
+        return;
+    }
+
+    scan_line_t *sl = &ctx->lines[ctx->lex_line++];
+
+    /* Emit stops for dedent */
+    while (sl->indent < ctx->lex_top) {
+        add_token(ctx, TOKEN_STOP, "", 0);
+        ctx->lex_stack_top--;
+        ctx->lex_top = ctx->lex_stack[ctx->lex_stack_top];
+    }
+
+    /* Emit start for list items */
+    if (strlen(sl->leader) > 0) {
+        if (sl->indent > ctx->lex_top) {
+            /* Point at the leader in scratch so the position survives */
+            add_token(ctx, TOKEN_START, sl->start + sl->indent, sl->indent);
+            ctx->lex_stack[++ctx->lex_stack_top] = sl->indent;
+            ctx->lex_top = sl->indent;
+            ctx->lex_broken = false;
+        } else if (sl->indent == ctx->lex_top) {
+            add_token(ctx, TOKEN_STOP, "", 0);
+            add_token(ctx, TOKEN_START, sl->start + sl->indent, sl->indent);
+            ctx->lex_broken = false;
+        }
+    }
+
+    /* Emit text or break */
+    if (strlen(sl->line) > 0) {
+        add_token(ctx, TOKEN_TEXT, sl->line, sl->indent);
+        ctx->lex_broken = false;
+    } else if (!ctx->lex_broken) {
+        add_token(ctx, TOKEN_BREAK, sl->line, sl->indent);
+        ctx->lex_broken = true;
+    }
+}
+
+#ifdef YAY_STATS
+static void lex_pump(parse_ctx_t *ctx) {
+    double start = stats_now();
+    size_t *saved = stats_alloc_slot;
+    stats_alloc_slot = &stats_current.lex_allocations;
+    lex_pump_impl(ctx);
+    stats_alloc_slot = saved;
+    stats_current.lex_seconds += stats_now() - start;
+}
+#else
+#define lex_pump lex_pump_impl
+#endif
+
+/* Pull tokens until the absolute index exists or the stream ends,
+ * streaming the scanner and lexer forward together */
+static bool token_avail(parse_ctx_t *ctx, size_t idx) {
+    while (idx >= ctx->token_limit && !ctx->lex_done) {
+        if (ctx->lex_line >= ctx->line_count && !ctx->scan_done) {
+            scan_pump(ctx);
+        }
+        lex_pump(ctx);
+    }
+    return idx < ctx->token_limit;
+}
+
+/* Fetch a token the caller knows to exist (or is about to check) */
+static token_t *token_at(parse_ctx_t *ctx, size_t idx) {
+    while (idx >= ctx->token_limit && !ctx->lex_done) {
+        if (ctx->lex_line >= ctx->line_count && !ctx->scan_done) {
+            scan_pump(ctx);
+        }
+        lex_pump(ctx);
+    }
+    size_t slot = idx - ctx->token_base;
+    return &ctx->token_chunks[slot / TOKEN_CHUNK][slot % TOKEN_CHUNK];
+}
+
+/* Recycle window chunks wholly behind the parser's cursor */
+static void token_discard(parse_ctx_t *ctx, size_t idx) {
+    while (ctx->chunk_count > 0 && ctx->token_base + TOKEN_CHUNK <= idx) {
+        token_t *chunk = ctx->token_chunks[0];
+        ctx->chunk_count--;
+        memmove(ctx->token_chunks, ctx->token_chunks + 1,
+                ctx->chunk_count * sizeof(token_t *));
+        ctx->token_base += TOKEN_CHUNK;
+        if (!ctx->spare_chunk) {
+            ctx->spare_chunk = chunk;
+        } else {
+            mem_free(chunk);
+        }
+    }
+}
+
+/* ============================================================================
+ * Phase 3: Value Parser - Forward Declarations
+ * ============================================================================ */
+
+static yay_value_t *parse_value(parse_ctx_t *ctx, size_t *idx);
+static yay_value_t *parse_scalar(parse_ctx_t *ctx, const char *s, 
+                                  size_t at);
+static yay_value_t *parse_concatenated_strings(parse_ctx_t *ctx, size_t *idx, int base_indent);
+
+/* ============================================================================
+ * Helper Functions
+ * ============================================================================ */
+
+static size_t skip_breaks_and_stops(parse_ctx_t *ctx, size_t i) {
+    while (token_avail(ctx, i) && 
+           (token_at(ctx, i)->type == TOKEN_STOP || 
+            token_at(ctx, i)->type == TOKEN_BREAK)) {
+        i++;
+    }
+    return i;
+}
+
+static size_t skip_breaks(parse_ctx_t *ctx, size_t i) {
+    while (token_avail(ctx, i) && token_at(ctx, i)->type == TOKEN_BREAK) {
+        i++;
+    }
+    return i;
+}
+
+static size_t skip_stops(parse_ctx_t *ctx, size_t i) {
+    while (token_avail(ctx, i) && token_at(ctx, i)->type == TOKEN_STOP) {
+        i++;
+    }
+    return i;
+}
+
+/* Find colon outside quotes */
+static int find_colon_outside_quotes(const char *s) {
+    bool in_double = false;
+    bool in_single = false;
+    bool escape = false;
+    
+    for (int i = 0; s[i]; i++) {
+        char c = s[i];
+        
+        if (escape) {
+            escape = false;
+            continue;
+        }
+        
+        if (c == '\\' && (in_double || in_single)) {
+            escape = true;
+            continue;
+        }
+        
+        if (c == '"' && !in_single) {
+            in_double = !in_double;
+        } else if (c == '\'' && !in_double) {
+            in_single = !in_single;
+        } else if (c == ':' && !in_double && !in_single) {
+            return i;
+        }
+    }
+    
+    return -1;
+}
+
+/* Parse key name (handles quoted keys) */
+static char *parse_key_name(const char *s) {
+    /* Skip leading whitespace */
+    while (*s == ' ') s++;
+    
+    size_t len = strlen(s);
+    
+    /* Double-quoted key */
+    if (len >= 2 && s[0] == '"' && s[len-1] == '"') {
+        return str_dup_len(s + 1, len - 2);
+    }
+    
+    /* Single-quoted key */
+    if (len >= 2 && s[0] == '\'' && s[len-1] == '\'') {
+        return str_dup_len(s + 1, len - 2);
+    }
+    
+    /* Trim trailing whitespace */
+    while (len > 0 && s[len-1] == ' ') len--;
+    
+    return str_dup_len(s, len);
+}
+
+static void intern_rehash(parse_ctx_t *ctx) {
+    size_t old_capacity = ctx->intern_capacity;
+    char **old = ctx->intern;
+    ctx->intern_capacity *= 2;
+    ctx->intern = mem_calloc(ctx->intern_capacity, sizeof(char *));
+    size_t mask = ctx->intern_capacity - 1;
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (!old[i]) continue;
+        size_t slot = key_hash(old[i]) & mask;
+        while (ctx->intern[slot]) slot = (slot + 1) & mask;
+        ctx->intern[slot] = old[i];
+    }
+    mem_free(old);
+}
+
+/* Return a retained key cell for key, sharing one cell per distinct name.
+ * Documents that repeat the same keys across thousands of records pay one
+ * allocation per name instead of one per record. */
+static char *intern_key(parse_ctx_t *ctx, const char *key) {
+    if (!ctx->intern) {
+        ctx->intern_capacity = 64;
+        ctx->intern = mem_calloc(ctx->intern_capacity, sizeof(char *));
+    }
+    size_t mask = ctx->intern_capacity - 1;
+    size_t slot = key_hash(key) & mask;
+    while (ctx->intern[slot]) {
+        if (strcmp(ctx->intern[slot], key) == 0) {
+            return key_retain(ctx->intern[slot]);
+        }
+        slot = (slot + 1) & mask;
+    }
+    char *cell = key_cell_create(key);
+    ctx->intern[slot] = cell;
+    ctx->intern_count++;
+    if (ctx->intern_count * 4 > ctx->intern_capacity * 3) {
+        intern_rehash(ctx);
+    }
+    return key_retain(cell);
+}
+
+/* Null/bool constructors that honor compact mode */
+static yay_value_t *ctx_null(parse_ctx_t *ctx) {
+    return ctx->compact ? &compact_null : yay_null();
+}
+
+static yay_value_t *ctx_bool(parse_ctx_t *ctx, bool value) {
+    if (ctx->compact) {
+        return value ? &compact_true : &compact_false;
+    }
+    return yay_bool(value);
+}
+
+/* ============================================================================
+ * Number Parsing
+ * ============================================================================ */
+
+/* Result of the single-pass number scan: classification plus everything
+ * validation and normalization need, so the token is never walked again. */
+typedef struct {
+    bool is_float;       /* has a decimal point or exponent */
+    bool negative;       /* leading '-' */
+    size_t spaces;       /* digit-group spaces to strip */
+    long bad_exponent;   /* offset of an uppercase 'E', or -1 */
+    long bad_space;      /* offset of a space next to the '.', or -1 */
+} number_scan_t;
+
+/* Scan a scalar token once. Returns false if it is not a number at all
+ * (the caller falls through to string handling); on true, *scan carries
+ * the classification and any deferred validation errors. */
+static bool scan_number(const char *s, number_scan_t *scan) {
+    memset(scan, 0, sizeof(*scan));
+    scan->bad_exponent = -1;
+    scan->bad_space = -1;
+
+    const char *p = s;
+    bool has_dot = false;
+    bool has_exp = false;
+    bool has_digit = false;
+    bool int_ok = true;
+
+    if (*p == '-') {
+        scan->negative = true;
+        p++;
+    }
+    if (!*p) return false;
+
+    for (; *p; p++) {
+        char c = *p;
+        if (c >= '0' && c <= '9') {
+            has_digit = true;
+        } else if (c == ' ') {
+            scan->spaces++;
+            if (p[1] == '.' && scan->bad_space < 0) {
+                scan->bad_space = p - s;
+            }
+        } else if (c == '.') {
+            if (has_dot || has_exp) return false;
+            has_dot = true;
+            int_ok = false;
+            if (p[1] == ' ' && scan->bad_space < 0) {
+                scan->bad_space = p + 1 - s;
+            }
+        } else if (c == 'e' || c == 'E') {
+            if (has_exp || !has_digit) return false;
+            has_exp = true;
+            int_ok = false;
+            if (c == 'E' && scan->bad_exponent < 0) {
+                scan->bad_exponent = p - s;
+            }
+            /* Allow optional +/- after exponent */
+            if (p[1] == '+' || p[1] == '-') p++;
+        } else {
+            return false;
+        }
+    }
+
+    scan->is_float = has_dot || has_exp;
+    if (scan->is_float) return has_digit;
+    return int_ok;
+}
+
+/* Powers of ten that are exactly representable as doubles */
+static const double exact_pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10,
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Fast exact float conversion (Clinger's fast path): when the mantissa
+ * fits in 53 bits and the decimal exponent stays within the range where
+ * powers of ten are exact doubles, a single multiply or divide produces
+ * the correctly rounded result. Operates directly on the digit-grouped
+ * token, skipping spaces; returns false to defer to strtod. The token
+ * has already been validated by scan_number. */
+static bool parse_float_fast(const char *s, double *out) {
+    const char *p = s;
+    bool negative = false;
+    if (*p == '-') {
+        negative = true;
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exp10 = 0;
+    bool seen_dot = false;
+
+    for (; *p; p++) {
+        char c = *p;
+        if (c == ' ') continue;
+        if (c == '.') {
+            seen_dot = true;
+            continue;
+        }
+        if (c == 'e') {
+            p++;
+            bool exp_negative = false;
+            if (*p == '+') {
+                p++;
+            } else if (*p == '-') {
+                exp_negative = true;
+                p++;
+            }
+            int e = 0;
+            for (; *p; p++) {
+                if (*p == ' ') continue;
+                if (e > 400) return false;
+                e = e * 10 + (*p - '0');
+            }
+            exp10 += exp_negative ? -e : e;
+            break;
+        }
+        /* Leading zeros carry no significance */
+        if (mantissa == 0 && c == '0') {
+            if (seen_dot) exp10--;
+            continue;
+        }
+        if (digits >= 19) return false;
+        mantissa = mantissa * 10 + (uint64_t)(c - '0');
+        digits++;
+        if (seen_dot) exp10--;
+    }
+
+    if (mantissa >= (1ULL << 53)) return false;
+    double value = (double)mantissa;
+    if (exp10 > 0) {
+        if (exp10 > 22) return false;
+        value *= exact_pow10[exp10];
+    } else if (exp10 < 0) {
+        if (exp10 < -22) return false;
+        value /= exact_pow10[-exp10];
+    }
+    *out = negative ? -value : value;
+    return true;
+}
+
+static yay_value_t *parse_number(parse_ctx_t *ctx, const char *s,
+                                 size_t at, const number_scan_t *scan) {
+    if (scan->bad_exponent >= 0) {
+        ctx->error = make_error_at(ctx, at + (size_t)scan->bad_exponent,
+                                   "Uppercase exponent (use lowercase 'e')");
+        return NULL;
+    }
+    if (scan->bad_space >= 0) {
+        ctx->error = make_error_at(ctx, at + (size_t)scan->bad_space,
+                                   "Unexpected space in number");
+        return NULL;
+    }
+
+    /* Fast paths straight off the token, spaces and all */
+    if (scan->is_float) {
+        double value;
+        if (parse_float_fast(s, &value)) return yay_float(value);
+    } else if (scan->spaces == 0) {
+        return yay_int_from_str(s + (scan->negative ? 1 : 0), scan->negative);
+    }
+
+    /* Strip digit-group spaces; small numbers compact on the stack */
+    char stack_buf[128];
+    size_t len = strlen(s);
+    char *compact = len < sizeof(stack_buf) ? stack_buf : mem_alloc(len + 1);
+    if (!compact) return NULL;
+    char *p = compact;
+    for (const char *q = s; *q; q++) {
+        if (*q != ' ') *p++ = *q;
+    }
+    *p = '\0';
+
+    yay_value_t *v;
+    if (scan->is_float) {
+        v = yay_float(strtod(compact, NULL));
+    } else {
+        v = yay_int_from_str(compact + (scan->negative ? 1 : 0),
+                             scan->negative);
+    }
+    if (compact != stack_buf) mem_free(compact);
+    return v;
+}
+
+/* ============================================================================
+ * String Parsing
+ * ============================================================================ */
+
+/* Build a string value over [start, start + len): in borrowed mode, when
+ * the span lives in this parse's scratch copy, the value views it in
+ * place (the terminating NUL lands over a quote or trimmed space that is
+ * never revisited); otherwise an owning copy. */
+static yay_value_t *ctx_string_view(parse_ctx_t *ctx, const char *start,
+                                    size_t len) {
+    if (ctx->borrow && start >= ctx->scratch &&
+        start + len < ctx->scratch + ctx->source_len + 1) {
+        char *view = (char *)start;
+        view[len] = '\0';
+        yay_value_t *v = node_alloc();
+        if (v) {
+            v->type = YAY_STRING;
+            v->data.string = view;
+        }
+        return v;
+    }
+    return yay_string_len(start, len);
+}
+
+/* Length of the prefix free of escapes and control characters, i.e. the
+ * bytes a quoted string can bulk-copy verbatim */
+static size_t string_clean_span(const char *s, size_t length) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    while (i + 16 <= length) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(s + i));
+        /* min(c, 0x1F) == c catches controls without signed-compare trouble
+         * for UTF-8 continuation bytes */
+        __m128i control = _mm_cmpeq_epi8(
+            _mm_min_epu8(chunk, _mm_set1_epi8(0x1F)), chunk);
+        __m128i escape = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\'));
+        int mask = _mm_movemask_epi8(_mm_or_si128(control, escape));
+        if (mask != 0) {
+            return i + (size_t)__builtin_ctz((unsigned)mask);
+        }
+        i += 16;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    while (i + 16 <= length) {
+        uint8x16_t chunk = vld1q_u8((const uint8_t *)(s + i));
+        uint8x16_t bad = vorrq_u8(vcltq_u8(chunk, vdupq_n_u8(0x20)),
+                                  vceqq_u8(chunk, vdupq_n_u8('\\')));
+        if (vmaxvq_u8(bad) != 0) {
+            break;
+        }
+        i += 16;
+    }
+#endif
+    while (i < length && (unsigned char)s[i] >= 0x20 && s[i] != '\\') {
+        i++;
+    }
+    return i;
+}
+
+static yay_value_t *parse_double_quoted_string(parse_ctx_t *ctx, const char *s,
+                                                size_t at) {
+    size_t len = strlen(s);
+    if (len < 2 || s[0] != '"' || s[len-1] != '"') {
+        return yay_string(s);
+    }
+    
+    /* Escape-free strings need no decoding at all */
+    if (string_clean_span(s + 1, len - 2) == len - 2) {
+        return ctx_string_view(ctx, s + 1, len - 2);
+    }
+
+    /* Borrowed mode decodes escapes in place: every escape resolves to
+     * no more bytes than it occupies, so the write cursor never overtakes
+     * the read cursor */
+    bool in_place = ctx->borrow && s >= ctx->scratch &&
+                    s + len < ctx->scratch + ctx->source_len + 1;
+    char *out = in_place ? (char *)s + 1 : mem_alloc(len);
+    size_t out_len = 0;
+    
+    for (size_t i = 1; i < len - 1; i++) {
+        /* Bulk-copy the span up to the next escape or control character;
+         * escape-free strings take this path exactly once (memmove: the
+         * in-place spans overlap their source) */
+        size_t span = string_clean_span(s + i, len - 1 - i);
+        if (span > 0) {
+            memmove(out + out_len, s + i, span);
+            out_len += span;
+            i += span;
+            if (i >= len - 1) break;
+        }
+
         char c = s[i];
         
-        if (c == '\\') {
-            if (i + 1 >= len - 1) {
-                ctx->error = make_error(ctx, line_num, col + i + 1,
-                                       "Bad escaped character");
-                free(out);
+        if (c == '\\') {
+            if (i + 1 >= len - 1) {
+                ctx->error = make_error_at(ctx, at + i + 1,
+                                           "Bad escaped character");
+                if (!in_place) mem_free(out);
+                return NULL;
+            }
+            
+            char esc = s[++i];
+            unsigned char esc_class = yay_dq_escape_table[(unsigned char)esc];
+            switch (esc_class) {
+                default: out[out_len++] = (char)esc_class; break;
+                case YAY_ESC_UNICODE: {
+                    /* Expect \u{XXXXXX} format */
+                    /* Old-style \uXXXX is not supported - report at 'u' column */
+                    if (i + 1 >= len - 1 || s[i+1] != '{') {
+                        ctx->error = make_error_at(ctx, at + i,
+                                                   "Bad escaped character");
+                        if (!in_place) mem_free(out);
+                        return NULL;
+                    }
+                    
+                    /* Offset of '{' for subsequent errors */
+                    size_t brace_at = at + i + 1;
+                    
+                    /* Find closing brace */
+                    size_t brace_end = i + 2;
+                    while (brace_end < len - 1 && s[brace_end] != '}') {
+                        brace_end++;
+                    }
+                    
+                    if (brace_end >= len - 1 || s[brace_end] != '}') {
+                        ctx->error = make_error_at(ctx, brace_at,
+                                                   "Bad Unicode escape");
+                        if (!in_place) mem_free(out);
+                        return NULL;
+                    }
+                    
+                    size_t hex_start = i + 2;
+                    size_t hex_len_u = brace_end - hex_start;
+                    
+                    if (hex_len_u == 0 || hex_len_u > 6) {
+                        ctx->error = make_error_at(ctx, brace_at,
+                                                   "Bad Unicode escape");
+                        if (!in_place) mem_free(out);
+                        return NULL;
+                    }
+                    
+                    /* Validate hex digits */
+                    for (size_t j = hex_start; j < brace_end; j++) {
+                        if (!isxdigit((unsigned char)s[j])) {
+                            ctx->error = make_error_at(ctx, brace_at,
+                                                       "Bad Unicode escape");
+                            if (!in_place) mem_free(out);
+                            return NULL;
+                        }
+                    }
+                    
+                    char hex[7];
+                    memcpy(hex, s + hex_start, hex_len_u);
+                    hex[hex_len_u] = '\0';
+                    
+                    unsigned int code;
+                    if (sscanf(hex, "%x", &code) != 1) {
+                        ctx->error = make_error_at(ctx, brace_at,
+                                                   "Bad Unicode escape");
+                        if (!in_place) mem_free(out);
+                        return NULL;
+                    }
+                    
+                    /* Check for surrogates */
+                    if (code >= 0xD800 && code <= 0xDFFF) {
+                        ctx->error = make_error_at(ctx, brace_at,
+                                                   "Illegal surrogate");
+                        if (!in_place) mem_free(out);
+                        return NULL;
+                    }
+                    
+                    /* Check for out of range */
+                    if (code > 0x10FFFF) {
+                        ctx->error = make_error_at(ctx, brace_at,
+                                                   "Unicode code point out of range");
+                        if (!in_place) mem_free(out);
+                        return NULL;
+                    }
+                    
+                    /* Encode as UTF-8 */
+                    if (code < 0x80) {
+                        out[out_len++] = code;
+                    } else if (code < 0x800) {
+                        out[out_len++] = 0xC0 | (code >> 6);
+                        out[out_len++] = 0x80 | (code & 0x3F);
+                    } else if (code < 0x10000) {
+                        out[out_len++] = 0xE0 | (code >> 12);
+                        out[out_len++] = 0x80 | ((code >> 6) & 0x3F);
+                        out[out_len++] = 0x80 | (code & 0x3F);
+                    } else {
+                        out[out_len++] = 0xF0 | (code >> 18);
+                        out[out_len++] = 0x80 | ((code >> 12) & 0x3F);
+                        out[out_len++] = 0x80 | ((code >> 6) & 0x3F);
+                        out[out_len++] = 0x80 | (code & 0x3F);
+                    }
+                    
+                    i = brace_end;
+                    break;
+                }
+                case 0:
+                    ctx->error = make_error_at(ctx, at + i,
+                                               "Bad escaped character");
+                    if (!in_place) mem_free(out);
+                    return NULL;
+            }
+        } else if ((unsigned char)c < 0x20) {
+            ctx->error = make_error_at(ctx, at + i,
+                                       "Bad character in string");
+            if (!in_place) mem_free(out);
+            return NULL;
+        } else {
+            out[out_len++] = c;
+        }
+    }
+    
+    out[out_len] = '\0';
+    if (in_place) {
+        return ctx_string_view(ctx, out, out_len);
+    }
+    yay_value_t *v = yay_string(out);
+    mem_free(out);
+    return v;
+}
+
+static yay_value_t *parse_single_quoted_string(parse_ctx_t *ctx, const char *s) {
+    size_t len = strlen(s);
+    if (len < 2 || s[0] != '\'' || s[len-1] != '\'') {
+        return yay_string(s);
+    }
+    return ctx_string_view(ctx, s + 1, len - 2);
+}
+
+/* ============================================================================
+ * Concatenated String Parsing
+ * ============================================================================ */
+
+/**
+ * Parse concatenated quoted strings (multiple quoted strings on consecutive lines).
+ * Returns NULL if there's only one string (single string on new line is invalid).
+ */
+static yay_value_t *parse_concatenated_strings(parse_ctx_t *ctx, size_t *idx, int base_indent) {
+    /* Collect all parts */
+    size_t parts_cap = 8;
+    size_t parts_count = 0;
+    yay_value_t **parts = mem_alloc(parts_cap * sizeof(yay_value_t *));
+    size_t *part_lens = mem_alloc(parts_cap * sizeof(size_t));
+    
+    while (token_avail(ctx, *idx)) {
+        token_t *t = token_at(ctx, *idx);
+        
+        if (t->type == TOKEN_BREAK || t->type == TOKEN_STOP) {
+            (*idx)++;
+            continue;
+        }
+        
+        if (t->type != TOKEN_TEXT || t->indent < base_indent) {
+            break;
+        }
+        
+        /* Trim leading spaces */
+        const char *trimmed = t->text;
+        while (*trimmed == ' ') trimmed++;
+        size_t trimmed_len = strlen(trimmed);
+        
+        /* Check if this line is a quoted string */
+        bool is_double_quoted = trimmed_len >= 2 && trimmed[0] == '"' && trimmed[trimmed_len-1] == '"';
+        bool is_single_quoted = trimmed_len >= 2 && trimmed[0] == '\'' && trimmed[trimmed_len-1] == '\'';
+        
+        if (!is_double_quoted && !is_single_quoted) {
+            break;
+        }
+        
+        /* Parse the quoted string */
+        yay_value_t *parsed;
+        if (is_double_quoted) {
+            parsed = parse_double_quoted_string(ctx, trimmed, token_offset(ctx, t));
+        } else {
+            parsed = parse_single_quoted_string(ctx, trimmed);
+        }
+        
+        if (parsed == NULL) {
+            /* Error already set */
+            for (size_t i = 0; i < parts_count; i++) {
+                yay_free(parts[i]);
+            }
+            mem_free(parts);
+            mem_free(part_lens);
+            return NULL;
+        }
+        
+        /* Keep the parsed value; its string is concatenated directly */
+        if (parts_count >= parts_cap) {
+            parts_cap *= 2;
+            parts = mem_realloc(parts, parts_cap * sizeof(yay_value_t *));
+            part_lens = mem_realloc(part_lens, parts_cap * sizeof(size_t));
+        }
+        parts[parts_count] = parsed;
+        part_lens[parts_count] = strlen(parsed->data.string);
+        parts_count++;
+        
+        (*idx)++;
+    }
+    
+    /* Require at least 2 strings for concatenation */
+    /* A single string on a new line is invalid (use inline syntax instead) */
+    if (parts_count < 2) {
+        for (size_t i = 0; i < parts_count; i++) {
+            yay_free(parts[i]);
+        }
+        mem_free(parts);
+        mem_free(part_lens);
+        return NULL;
+    }
+    
+    /* Calculate total length */
+    size_t total_len = 0;
+    for (size_t i = 0; i < parts_count; i++) {
+        total_len += part_lens[i];
+    }
+    
+    /* Concatenate all parts */
+    char *result = mem_alloc(total_len + 1);
+    size_t pos = 0;
+    for (size_t i = 0; i < parts_count; i++) {
+        memcpy(result + pos, parts[i]->data.string, part_lens[i]);
+        pos += part_lens[i];
+        yay_free(parts[i]);
+    }
+    result[total_len] = '\0';
+    
+    mem_free(parts);
+    mem_free(part_lens);
+    
+    yay_value_t *val = yay_string_len(result, total_len);
+    mem_free(result);
+    return val;
+}
+
+/* ============================================================================
+ * Block String Parsing
+ * ============================================================================ */
+
+static yay_value_t *parse_block_string_impl(parse_ctx_t *ctx, size_t *idx, 
+                                             const char *first_line,
+                                             int base_indent) {
+    size_t i = *idx + 1;
+    bool is_property = (base_indent >= 0);
+    
+    /* Collect continuation lines (borrowed from the token text) */
+    size_t line_cap = 16;
+    size_t line_count = 0;
+    const char **lines = mem_alloc(line_cap * sizeof(char *));
+    size_t *lens = mem_alloc(line_cap * sizeof(size_t));
+    int *indents = mem_alloc(line_cap * sizeof(int));
+    
+    if (first_line && strlen(first_line) > 0) {
+        lines[line_count] = first_line;
+        lens[line_count] = strlen(first_line);
+        indents[line_count] = -1; /* Mark as first line */
+        line_count++;
+    }
+    
+    while (token_avail(ctx, i) && 
+           (token_at(ctx, i)->type == TOKEN_TEXT || 
+            token_at(ctx, i)->type == TOKEN_BREAK)) {
+        /* For property context, stop at lines at or below base indent */
+        if (is_property && token_at(ctx, i)->type == TOKEN_TEXT &&
+            token_at(ctx, i)->indent <= base_indent) {
+            break;
+        }
+        
+        if (line_count >= line_cap) {
+            line_cap *= 2;
+            lines = mem_realloc(lines, line_cap * sizeof(char *));
+            lens = mem_realloc(lens, line_cap * sizeof(size_t));
+            indents = mem_realloc(indents, line_cap * sizeof(int));
+        }
+        
+        if (token_at(ctx, i)->type == TOKEN_BREAK) {
+            lines[line_count] = "";
+            lens[line_count] = 0;
+            indents[line_count] = -2; /* Mark as break */
+        } else {
+            lines[line_count] = token_at(ctx, i)->text;
+            lens[line_count] = strlen(token_at(ctx, i)->text);
+            indents[line_count] = token_at(ctx, i)->indent;
+        }
+        line_count++;
+        i++;
+    }
+    
+    *idx = i;
+    
+    /* Find minimum indent */
+    int min_indent = INT32_MAX;
+    for (size_t j = 0; j < line_count; j++) {
+        if (indents[j] >= 0 && indents[j] < min_indent) {
+            min_indent = indents[j];
+        }
+    }
+    if (min_indent == INT32_MAX) min_indent = 0;
+    
+    /* Leading newline if first_line was empty AND not a property */
+    bool leading_newline = (!first_line || strlen(first_line) == 0) && 
+                           line_count > 0 && !is_property;
+    
+    /* Skip leading empty lines */
+    size_t start = 0;
+    if (!(first_line && strlen(first_line) > 0)) {
+        while (start < line_count && lens[start] == 0) start++;
+    }
+    
+    /* Skip trailing empty lines */
+    size_t end = line_count;
+    while (end > start && lens[end-1] == 0) end--;
+    
+    /* First pass: sum the exact result size (newlines, re-indent, lines) */
+    size_t total_len = 0;
+    if (leading_newline && end > start) total_len++;
+    for (size_t j = start; j < end; j++) {
+        if (j > start) total_len++;
+        if (indents[j] >= 0) total_len += (size_t)(indents[j] - min_indent);
+        total_len += lens[j];
+    }
+    if (end > start) total_len++; /* trailing newline */
+    
+    /* Check for empty block string */
+    if (total_len == 0) {
+        mem_free(lines);
+        mem_free(lens);
+        mem_free(indents);
+        ctx->error = make_error_plain(ctx,
+            "Empty block string not allowed (use \"\" or \"\\n\" explicitly)");
+        return NULL;
+    }
+    
+    /* Second pass: assemble into a single allocation */
+    char *result = mem_alloc(total_len + 1);
+    size_t result_len = 0;
+    
+    if (leading_newline && end > start) {
+        result[result_len++] = '\n';
+    }
+    
+    for (size_t j = start; j < end; j++) {
+        if (j > start) {
+            result[result_len++] = '\n';
+        }
+        
+        /* Add extra indent */
+        if (indents[j] >= 0 && indents[j] > min_indent) {
+            size_t extra = (size_t)(indents[j] - min_indent);
+            memset(result + result_len, ' ', extra);
+            result_len += extra;
+        }
+        
+        /* Add line content */
+        memcpy(result + result_len, lines[j], lens[j]);
+        result_len += lens[j];
+    }
+    
+    /* Trailing newline */
+    if (end > start) {
+        result[result_len++] = '\n';
+    }
+    result[result_len] = '\0';
+    
+    mem_free(lines);
+    mem_free(lens);
+    mem_free(indents);
+    
+    yay_value_t *v = yay_string_len(result, total_len);
+    mem_free(result);
+    return v;
+}
+
+/* Wrapper for standalone block strings */
+static yay_value_t *parse_block_string(parse_ctx_t *ctx, size_t *idx, 
+                                        const char *first_line) {
+    return parse_block_string_impl(ctx, idx, first_line, -1);
+}
+
+/* Wrapper for property block strings (with base indent) */
+static yay_value_t *parse_property_block_string_indent(parse_ctx_t *ctx, size_t *idx, 
+                                                        const char *first_line,
+                                                        int base_indent) {
+    return parse_block_string_impl(ctx, idx, first_line, base_indent);
+}
+
+/* ============================================================================
+ * Block Bytes Parsing (> hex)
+ * ============================================================================ */
+
+/* Parse block bytes starting with > */
+static yay_value_t *parse_block_bytes(parse_ctx_t *ctx, size_t *idx) {
+    token_t *t = token_at(ctx, *idx);
+    const char *s = t->text;
+    int base_indent = t->indent;
+    
+    /* Extract hex from first line (after >) */
+    const char *hex_start = s + 1;
+    int hex_col_offset = 1;
+    if (*hex_start == ' ') {
+        hex_start++;
+        hex_col_offset = 2;
+    }
+    
+    /* Strip comment */
+    char *first_hex = str_dup(hex_start);
+    char *comment = strchr(first_hex, '#');
+    if (comment) *comment = '\0';
+    
+    /* Trim whitespace from first_hex */
+    char *trimmed = first_hex;
+    while (*trimmed == ' ') trimmed++;
+    size_t trimmed_len = strlen(trimmed);
+    while (trimmed_len > 0 && trimmed[trimmed_len - 1] == ' ') {
+        trimmed[--trimmed_len] = '\0';
+    }
+    
+    /* Check for empty leader (just ">" with no hex or comment) */
+    if (*trimmed == '\0' && comment == NULL) {
+        ctx->error = make_error_plain(ctx, "Expected hex or comment in hex block");
+        mem_free(first_hex);
+        return NULL;
+    }
+    
+    size_t hex_cap = 256;
+    size_t hex_len = 0;
+    char *hex = mem_alloc(hex_cap);
+    
+    /* Add hex from first line, checking for uppercase */
+    size_t first_len = strlen(first_hex);
+    for (size_t k = 0; k < first_len; ) {
+        size_t run = hex_clean_span(first_hex + k, first_len - k);
+        if (run > 0) {
+            if (hex_len + run >= hex_cap) {
+                while (hex_len + run >= hex_cap) hex_cap *= 2;
+                hex = mem_realloc(hex, hex_cap);
+            }
+            memcpy(hex + hex_len, first_hex + k, run);
+            hex_len += run;
+            k += run;
+            continue;
+        }
+        char c = first_hex[k];
+        if (c != ' ') {
+            if (is_uppercase_hex(c)) {
+                ctx->error = make_error_at(ctx, token_offset(ctx, t) + hex_col_offset + (int)k,
+                                       "Uppercase hex digit (use lowercase)");
+                mem_free(first_hex);
+                mem_free(hex);
+                return NULL;
+            }
+            if (hex_len >= hex_cap - 1) {
+                hex_cap *= 2;
+                hex = mem_realloc(hex, hex_cap);
+            }
+            hex[hex_len++] = c;
+        }
+        k++;
+    }
+    mem_free(first_hex);
+    
+    (*idx)++;
+    
+    /* Collect continuation lines */
+    while (token_avail(ctx, *idx) && 
+           token_at(ctx, *idx)->type == TOKEN_TEXT &&
+           token_at(ctx, *idx)->indent > base_indent) {
+        token_t *line_tok = token_at(ctx, *idx);
+        char *line = str_dup(line_tok->text);
+        char *line_comment = strchr(line, '#');
+        if (line_comment) *line_comment = '\0';
+
+        size_t line_len = strlen(line);
+        for (size_t k = 0; k < line_len; ) {
+            size_t run = hex_clean_span(line + k, line_len - k);
+            if (run > 0) {
+                if (hex_len + run >= hex_cap) {
+                    while (hex_len + run >= hex_cap) hex_cap *= 2;
+                    hex = mem_realloc(hex, hex_cap);
+                }
+                memcpy(hex + hex_len, line + k, run);
+                hex_len += run;
+                k += run;
+                continue;
+            }
+            char c = line[k];
+            if (c != ' ') {
+                if (is_uppercase_hex(c)) {
+                    ctx->error = make_error_at(ctx, token_offset(ctx, line_tok) + (int)k,
+                                           "Uppercase hex digit (use lowercase)");
+                    mem_free(line);
+                    mem_free(hex);
+                    return NULL;
+                }
+                if (hex_len >= hex_cap - 1) {
+                    hex_cap *= 2;
+                    hex = mem_realloc(hex, hex_cap);
+                }
+                hex[hex_len++] = c;
+            }
+            k++;
+        }
+        mem_free(line);
+        (*idx)++;
+    }
+    
+    hex[hex_len] = '\0';
+    
+    if (hex_len % 2 != 0) {
+        ctx->error = make_error_at(ctx, token_offset(ctx, t),
+                               "Odd number of hex digits in byte literal");
+        mem_free(hex);
+        return NULL;
+    }
+    
+    yay_value_t *v = yay_bytes_from_hex(hex);
+    mem_free(hex);
+    return v;
+}
+
+/* Parse block bytes in property context (key: > hex) */
+static yay_value_t *parse_property_block_bytes(parse_ctx_t *ctx, size_t *idx, 
+                                                const char *v_part) {
+    token_t *t = token_at(ctx, *idx);
+    int base_indent = t->indent;
+    
+    /* Extract hex from first line (after >) */
+    const char *hex_start = v_part + 1;
+    if (*hex_start == ' ') hex_start++;
+    
+    /* Strip comment */
+    char *first_hex = str_dup(hex_start);
+    char *comment = strchr(first_hex, '#');
+    if (comment) *comment = '\0';
+    
+    size_t hex_cap = 256;
+    size_t hex_len = 0;
+    char *hex = mem_alloc(hex_cap);
+    
+    /* Add hex from first line */
+    size_t first_len = strlen(first_hex);
+    for (size_t k = 0; k < first_len; ) {
+        size_t run = hex_clean_span(first_hex + k, first_len - k);
+        if (run > 0) {
+            if (hex_len + run >= hex_cap) {
+                while (hex_len + run >= hex_cap) hex_cap *= 2;
+                hex = mem_realloc(hex, hex_cap);
+            }
+            memcpy(hex + hex_len, first_hex + k, run);
+            hex_len += run;
+            k += run;
+            continue;
+        }
+        if (first_hex[k] != ' ') {
+            if (hex_len >= hex_cap - 1) {
+                hex_cap *= 2;
+                hex = mem_realloc(hex, hex_cap);
+            }
+            hex[hex_len++] = tolower(first_hex[k]);
+        }
+        k++;
+    }
+    mem_free(first_hex);
+    
+    (*idx)++;
+    
+    /* Collect continuation lines */
+    while (token_avail(ctx, *idx) && 
+           token_at(ctx, *idx)->type == TOKEN_TEXT &&
+           token_at(ctx, *idx)->indent > base_indent) {
+        char *line = str_dup(token_at(ctx, *idx)->text);
+        char *line_comment = strchr(line, '#');
+        if (line_comment) *line_comment = '\0';
+
+        size_t line_len = strlen(line);
+        for (size_t k = 0; k < line_len; ) {
+            size_t run = hex_clean_span(line + k, line_len - k);
+            if (run > 0) {
+                if (hex_len + run >= hex_cap) {
+                    while (hex_len + run >= hex_cap) hex_cap *= 2;
+                    hex = mem_realloc(hex, hex_cap);
+                }
+                memcpy(hex + hex_len, line + k, run);
+                hex_len += run;
+                k += run;
+                continue;
+            }
+            if (line[k] != ' ') {
+                if (hex_len >= hex_cap - 1) {
+                    hex_cap *= 2;
+                    hex = mem_realloc(hex, hex_cap);
+                }
+                hex[hex_len++] = tolower(line[k]);
+            }
+            k++;
+        }
+        mem_free(line);
+        (*idx)++;
+    }
+    
+    hex[hex_len] = '\0';
+    
+    if (hex_len % 2 != 0) {
+        ctx->error = make_error_at(ctx, token_offset(ctx, t),
+                               "Odd number of hex digits in byte literal");
+        mem_free(hex);
+        return NULL;
+    }
+    
+    yay_value_t *v = yay_bytes_from_hex(hex);
+    mem_free(hex);
+    return v;
+}
+
+/* ============================================================================
+ * Inline Array Parsing
+ * ============================================================================ */
+
+static yay_value_t *parse_inline_value(parse_ctx_t *ctx, const char *s, 
+                                        size_t *consumed, size_t at);
+
+static yay_value_t *parse_inline_string(parse_ctx_t *ctx __attribute__((unused)),
+                                         const char *s, 
+                                         size_t *consumed,
+                                         size_t at __attribute__((unused))) {
+    char quote = s[0];
+    size_t i = 1;
+    size_t cap = 64;
+    size_t len = 0;
+    char *out = mem_alloc(cap);
+    bool escape = false;
+    
+    while (s[i]) {
+        if (escape) {
+            /* An escape may expand to four bytes of UTF-8 */
+            if (len + 4 >= cap) {
+                cap *= 2;
+                out = mem_realloc(out, cap);
+            }
+            if (quote == '"') {
+                switch (yay_dq_escape_table[(unsigned char)s[i]]) {
+                    default: out[len++] = (char)yay_dq_escape_table[(unsigned char)s[i]]; break;
+                    case YAY_ESC_UNICODE: {
+                        /* \u{XXXXXX}: one to six hex digits */
+                        if (s[i+1] != '{') {
+                            mem_free(out);
+                            return NULL;
+                        }
+                        size_t hex_start = i + 2;
+                        size_t hex_end = hex_start;
+                        while (s[hex_end] && s[hex_end] != '}') hex_end++;
+                        size_t hex_len = hex_end - hex_start;
+                        if (s[hex_end] != '}' || hex_len == 0 || hex_len > 6) {
+                            mem_free(out);
+                            return NULL;
+                        }
+                        unsigned int code = 0;
+                        for (size_t j = hex_start; j < hex_end; j++) {
+                            if (!isxdigit((unsigned char)s[j])) {
+                                mem_free(out);
+                                return NULL;
+                            }
+                            char h = tolower(s[j]);
+                            code = code * 16 +
+                                (unsigned int)(h <= '9' ? h - '0' : h - 'a' + 10);
+                        }
+                        if ((code >= 0xD800 && code <= 0xDFFF) ||
+                            code > 0x10FFFF) {
+                            mem_free(out);
+                            return NULL;
+                        }
+                        if (code < 0x80) {
+                            out[len++] = code;
+                        } else if (code < 0x800) {
+                            out[len++] = 0xC0 | (code >> 6);
+                            out[len++] = 0x80 | (code & 0x3F);
+                        } else if (code < 0x10000) {
+                            out[len++] = 0xE0 | (code >> 12);
+                            out[len++] = 0x80 | ((code >> 6) & 0x3F);
+                            out[len++] = 0x80 | (code & 0x3F);
+                        } else {
+                            out[len++] = 0xF0 | (code >> 18);
+                            out[len++] = 0x80 | ((code >> 12) & 0x3F);
+                            out[len++] = 0x80 | ((code >> 6) & 0x3F);
+                            out[len++] = 0x80 | (code & 0x3F);
+                        }
+                        i = hex_end;
+                        break;
+                    }
+                    case 0: out[len++] = s[i]; break;
+                }
+            } else {
+                /* Single quote - only \' and \\ are escapes */
+                if (s[i] == '\'' || s[i] == '\\') {
+                    out[len++] = s[i];
+                } else {
+                    out[len++] = '\\';
+                    out[len++] = s[i];
+                }
+            }
+            escape = false;
+            i++;
+            continue;
+        }
+        
+        if (s[i] == '\\') {
+            escape = true;
+            i++;
+            continue;
+        }
+        
+        if (s[i] == quote) {
+            *consumed = i + 1;
+            out[len] = '\0';
+            yay_value_t *v = yay_string(out);
+            mem_free(out);
+            return v;
+        }
+        
+        if (len + 4 >= cap) {
+            cap *= 2;
+            out = mem_realloc(out, cap);
+        }
+        out[len++] = s[i++];
+    }
+    
+    mem_free(out);
+    return NULL;
+}
+
+static yay_value_t *parse_inline_number(const char *s, size_t *consumed) {
+    size_t i = 0;
+    bool has_decimal = false;
+    
+    if (s[i] == '-') i++;
+    
+    while (s[i] && (isdigit(s[i]) || s[i] == '.')) {
+        if (s[i] == '.') has_decimal = true;
+        i++;
+    }
+
+    if (i == 0 || (i == 1 && s[0] == '-')) {
+        return NULL;
+    }
+
+    /* Optional lowercase exponent makes the literal a float */
+    if (s[i] == 'e') {
+        size_t e = i + 1;
+        if (s[e] == '+' || s[e] == '-') e++;
+        if (isdigit(s[e])) {
+            while (isdigit(s[e])) e++;
+            i = e;
+            has_decimal = true;
+        }
+    }
+    
+    char *num_str = str_dup_len(s, i);
+    *consumed = i;
+    
+    if (has_decimal) {
+        double val = atof(num_str);
+        mem_free(num_str);
+        return yay_float(val);
+    } else {
+        bool negative = num_str[0] == '-';
+        char *digits = negative ? num_str + 1 : num_str;
+        yay_value_t *v = yay_int_from_str(digits, negative);
+        mem_free(num_str);
+        return v;
+    }
+}
+
+static yay_value_t *parse_inline_bytes(parse_ctx_t *ctx, const char *s, 
+                                        size_t *consumed, size_t at) {
+    /* Find closing > */
+    const char *end = strchr(s + 1, '>');
+    if (!end) return NULL;
+    
+    /* Validate whitespace in byte literal */
+    if (s[1] == ' ') {
+        ctx->error = make_error_at(ctx, at + 1, 
+                                   "Unexpected space after \"<\"");
+        return NULL;
+    }
+    if (end > s + 1 && *(end - 1) == ' ') {
+        ctx->error = make_error_at(ctx, at + (size_t)(end - s - 1), 
+                                   "Unexpected space before \">\"");
+        return NULL;
+    }
+    
+    size_t hex_len = end - s - 1;
+    char *hex = mem_alloc(hex_len + 1);
+    size_t hex_out = 0;
+    
+    for (size_t i = 1; i < (size_t)(end - s); i++) {
+        if (s[i] != ' ' && s[i] != '\t') {
+            hex[hex_out++] = tolower(s[i]);
+        }
+    }
+    hex[hex_out] = '\0';
+    
+    if (hex_out % 2 != 0) {
+        ctx->error = make_error_at(ctx, at, 
+                                   "Odd number of hex digits in byte literal");
+        mem_free(hex);
+        return NULL;
+    }
+    
+    yay_value_t *v = yay_bytes_from_hex(hex);
+    mem_free(hex);
+    *consumed = end - s + 1;
+    return v;
+}
+
+static yay_value_t *parse_inline_value_impl(parse_ctx_t *ctx, const char *s, 
+                                             size_t *consumed, size_t at);
+
+static yay_value_t *parse_inline_value(parse_ctx_t *ctx, const char *s, 
+                                        size_t *consumed, size_t at) {
+    return parse_inline_value_impl(ctx, s, consumed, at);
+}
+
+/* Scan forward from a comma missing its following space to decide which
+ * whitespace error to report: if the matching close of the current container
+ * has a space before it, "Unexpected space before close" wins over
+ * "Expected space after comma". */
+static bool next_close_has_space(const char *s) {
+    int depth = 0;
+    bool in_string = false;
+    char string_char = 0;
+    bool escape = false;
+    
+    for (int j = 0; s[j]; j++) {
+        if (escape) {
+            escape = false;
+            continue;
+        }
+        if (in_string) {
+            if (s[j] == '\\') escape = true;
+            else if (s[j] == string_char) {
+                in_string = false;
+                string_char = 0;
+            }
+            continue;
+        }
+        if (s[j] == '"' || s[j] == '\'') {
+            in_string = true;
+            string_char = s[j];
+            continue;
+        }
+        if (s[j] == '[' || s[j] == '{') {
+            depth++;
+            continue;
+        }
+        if (s[j] == ']' || s[j] == '}') {
+            if (depth == 0) {
+                return j > 0 && s[j-1] == ' ';
+            }
+            depth--;
+            continue;
+        }
+        if (s[j] == ',' && depth == 0) {
+            return false;
+        }
+    }
+    return false;
+}
+
+/* Consume separators between inline items, enforcing the spacing rules in
+ * the same pass that builds the value. Returns false (with ctx->error set)
+ * on a spacing violation; otherwise leaves *pp at the next item or close. */
+static bool consume_inline_separators(parse_ctx_t *ctx, const char **pp,
+                                      size_t *pat, char close) {
+    const char *p = *pp;
+    size_t pc = *pat;
+    
+    for (;;) {
+        if (*p == ' ') {
+            const char *q = p;
+            size_t qc = pc;
+            while (*q == ' ') { q++; qc++; }
+            if (*q == close) {
+                ctx->error = make_error_at(ctx, qc - 1,
+                                           "Unexpected space before \"%c\"", close);
+                return false;
+            }
+            if (*q == ',') {
+                ctx->error = make_error_at(ctx, qc - 1,
+                                           "Unexpected space before \",\"");
+                return false;
+            }
+            /* Space-separated items are tolerated */
+            p = q;
+            pc = qc;
+            break;
+        }
+        if (*p == ',') {
+            size_t comma_at = pc;
+            p++;
+            pc++;
+            if (*p == ' ') {
+                if (p[1] == ' ') {
+                    ctx->error = make_error_at(ctx, comma_at + 2,
+                                               "Unexpected space after \",\"");
+                    return false;
+                }
+                p++;
+                pc++;
+                if (*p == close) {
+                    ctx->error = make_error_at(ctx, pc - 1,
+                                               "Unexpected space before \"%c\"", close);
+                    return false;
+                }
+                if (*p == ',') {
+                    ctx->error = make_error_at(ctx, pc - 1,
+                                               "Unexpected space before \",\"");
+                    return false;
+                }
+                continue;
+            }
+            if (*p == ']' || *p == '}' || *p == '\0') {
+                /* Trailing comma before close */
+                continue;
+            }
+            if (!next_close_has_space(p)) {
+                ctx->error = make_error_at(ctx, comma_at,
+                                           "Expected space after \",\"");
+                return false;
+            }
+            /* Suppressed: the space-before-close error is reported when the
+             * close is reached */
+            continue;
+        }
+        break;
+    }
+    
+    *pp = p;
+    *pat = pc;
+    return true;
+}
+
+/* First-byte scalar dispatch: one table lookup routes each inline value
+ * instead of re-testing every leading character and keyword in turn */
+enum {
+    INLINE_NUMBER = 0,  /* digits, '.', and anything else: number fallback */
+    INLINE_BYTES,
+    INLINE_STRING,
+    INLINE_TRUE,
+    INLINE_FALSE,
+    INLINE_NULL,        /* "null" or "nan" */
+    INLINE_INFINITY,
+    INLINE_MINUS        /* "-infinity" or a negative number */
+};
+
+static const unsigned char inline_dispatch[256] = {
+    ['<'] = INLINE_BYTES,
+    ['"'] = INLINE_STRING, ['\''] = INLINE_STRING,
+    ['t'] = INLINE_TRUE, ['f'] = INLINE_FALSE, ['n'] = INLINE_NULL,
+    ['i'] = INLINE_INFINITY, ['-'] = INLINE_MINUS,
+};
+
+/* Word-sized keyword test (n <= 8): one integer compare against the
+ * packed keyword bytes instead of a strncmp, with the byte after the
+ * keyword required to be non-alphanumeric. strnlen bounds the load so
+ * it never reads past the terminator. */
+static bool inline_keyword(const char *s, const char *kw, size_t n) {
+    if (strnlen(s, n) < n) return false;
+    uint64_t word = 0;
+    uint64_t key = 0;
+    memcpy(&word, s, n);
+    memcpy(&key, kw, n);
+    return word == key && !isalnum((unsigned char)s[n]);
+}
+
+static yay_value_t *parse_inline_value_impl(parse_ctx_t *ctx, const char *s, 
+                                             size_t *consumed, size_t at) {
+    /* Skip whitespace */
+    while (*s == ' ') { s++; at++; }
+    
+    if (s[0] == '[') {
+        if (!limit_charge_depth((size_t)ctx->inline_depth)) {
+            ctx->error = make_error_at(ctx, at, "Depth limit exceeded");
+            return NULL;
+        }
+        ctx->inline_depth++;
+        yay_value_t *arr = yay_array();
+        const char *inner = s + 1;
+        size_t inner_at = at + 1;
+        
+        if (*inner == ' ') {
+            ctx->error = make_error_at(ctx, inner_at,
+                                       "Unexpected space after \"[\"");
+            yay_free(arr);
+            return NULL;
+        }
+        
+        for (;;) {
+            if (!consume_inline_separators(ctx, &inner, &inner_at, ']')) {
+                yay_free(arr);
+                return NULL;
+            }
+            if (*inner == '\0') {
+                /* Unmatched bracket */
+                yay_free(arr);
+                return NULL;
+            }
+            if (*inner == ']') {
+                inner++;
+                inner_at++;
+                break;
+            }
+            
+            size_t item_consumed;
+            yay_value_t *item = parse_inline_value_impl(ctx, inner, &item_consumed, 
+                                                         inner_at);
+            if (!item) {
+                yay_free(arr);
+                return NULL;
+            }
+            yay_array_push(arr, item);
+            inner += item_consumed;
+            inner_at += item_consumed;
+        }
+        
+        *consumed = inner - s;
+        ctx->inline_depth--;
+        return arr;
+    }
+    
+    if (s[0] == '{') {
+        if (!limit_charge_depth((size_t)ctx->inline_depth)) {
+            ctx->error = make_error_at(ctx, at, "Depth limit exceeded");
+            return NULL;
+        }
+        ctx->inline_depth++;
+        yay_value_t *obj = yay_object();
+        const char *inner = s + 1;
+        size_t inner_at = at + 1;
+        
+        if (*inner == ' ') {
+            ctx->error = make_error_at(ctx, inner_at,
+                                       "Unexpected space after \"{\"");
+            yay_free(obj);
+            return NULL;
+        }
+        
+        for (;;) {
+            if (!consume_inline_separators(ctx, &inner, &inner_at, '}')) {
+                yay_free(obj);
+                return NULL;
+            }
+            if (*inner == '\0') {
+                /* Unmatched brace */
+                yay_free(obj);
+                return NULL;
+            }
+            if (*inner == '}') {
+                inner++;
+                inner_at++;
+                break;
+            }
+            
+            /* Parse key */
+            char *key = NULL;
+            if (*inner == '"' || *inner == '\'') {
+                size_t key_consumed;
+                yay_value_t *key_val = parse_inline_string(ctx, inner, &key_consumed,
+                                                           inner_at);
+                if (!key_val) {
+                    yay_free(obj);
+                    return NULL;
+                }
+                key = str_dup(key_val->data.string);
+                yay_free(key_val);
+                inner += key_consumed;
+                inner_at += key_consumed;
+            } else {
+                /* Unquoted key - must start with alphanumeric or underscore */
+                const char *key_start = inner;
+                if (!isalnum(*inner) && *inner != '_') {
+                    /* Invalid key character at start */
+                    ctx->error = make_error_at(ctx, at, "Invalid key");
+                    yay_free(obj);
+                    return NULL;
+                }
+                while (*inner && (isalnum(*inner) || *inner == '_' || *inner == '-')) { inner++; inner_at++; }
+                key = str_dup_len(key_start, inner - key_start);
+            }
+            
+            /* Colon, with spacing rules checked in the same pass */
+            if (*inner == ' ') {
+                const char *q = inner;
+                size_t qc = inner_at;
+                while (*q == ' ') { q++; qc++; }
+                if (*q == ':') {
+                    ctx->error = make_error_at(ctx, qc - 1,
+                                               "Unexpected space before \":\"");
+                    mem_free(key);
+                    yay_free(obj);
+                    return NULL;
+                }
+                inner = q;
+                inner_at = qc;
+            }
+            if (*inner != ':') {
+                ctx->error = make_error_at(ctx, at, "Expected colon after key");
+                mem_free(key);
+                yay_free(obj);
+                return NULL;
+            }
+            size_t colon_at = inner_at;
+            inner++; inner_at++;
+            if (*inner != ' ') {
+                ctx->error = make_error_at(ctx, colon_at,
+                                           "Expected space after \":\"");
+                mem_free(key);
+                yay_free(obj);
+                return NULL;
+            }
+            if (inner[1] == ' ') {
+                ctx->error = make_error_at(ctx, colon_at + 2,
+                                           "Unexpected space after \":\"");
+                mem_free(key);
+                yay_free(obj);
+                return NULL;
+            }
+            inner++; inner_at++;
+            
+            /* Parse value */
+            size_t val_consumed;
+            yay_value_t *val = parse_inline_value_impl(ctx, inner, &val_consumed,
+                                                       inner_at);
+            if (!val) {
+                mem_free(key);
+                yay_free(obj);
+                return NULL;
+            }
+            
+            yay_object_set(obj, key, val);
+            mem_free(key);
+            inner += val_consumed;
+            inner_at += val_consumed;
+        }
+        
+        *consumed = inner - s;
+        ctx->inline_depth--;
+        return obj;
+    }
+    
+    switch (inline_dispatch[(unsigned char)s[0]]) {
+        case INLINE_BYTES:
+            return parse_inline_bytes(ctx, s, consumed, at);
+        case INLINE_STRING:
+            return parse_inline_string(ctx, s, consumed, at);
+        case INLINE_TRUE:
+            if (inline_keyword(s, "true", 4)) {
+                *consumed = 4;
+                return ctx_bool(ctx, true);
+            }
+            break;
+        case INLINE_FALSE:
+            if (inline_keyword(s, "false", 5)) {
+                *consumed = 5;
+                return ctx_bool(ctx, false);
+            }
+            break;
+        case INLINE_NULL:
+            if (inline_keyword(s, "null", 4)) {
+                *consumed = 4;
+                return ctx_null(ctx);
+            }
+            if (inline_keyword(s, "nan", 3)) {
+                *consumed = 3;
+                return yay_float(NAN);
+            }
+            break;
+        case INLINE_INFINITY:
+            if (inline_keyword(s, "infinity", 8)) {
+                *consumed = 8;
+                return yay_float(INFINITY);
+            }
+            break;
+        case INLINE_MINUS:
+            if (s[1] == 'i' && inline_keyword(s + 1, "infinity", 8)) {
+                *consumed = 9;
+                return yay_float(-INFINITY);
+            }
+            break;
+        default:
+            break;
+    }
+    
+    /* Try number */
+    return parse_inline_number(s, consumed);
+}
+
+static yay_value_t *parse_inline_array(parse_ctx_t *ctx, const char *s,
+                                        size_t at) {
+    size_t consumed;
+    return parse_inline_value(ctx, s, &consumed, at);
+}
+
+/* ============================================================================
+ * Byte Array Parsing
+ * ============================================================================ */
+
+static yay_value_t *parse_angle_bytes(parse_ctx_t *ctx, const char *s,
+                                       size_t at) {
+    if (strcmp(s, "<>") == 0) {
+        return yay_bytes(NULL, 0);
+    }
+    
+    size_t len = strlen(s);
+    if (s[0] != '<') {
+        return NULL;
+    }
+    
+    /* Check for unclosed angle bracket */
+    if (len < 2 || s[len-1] != '>') {
+        ctx->error = make_error_at(ctx, at,
+                               "Unmatched angle bracket");
+        return NULL;
+    }
+    
+    /* Validate whitespace */
+    if (s[1] == ' ') {
+        ctx->error = make_error_at(ctx, at + 1,
+                               "Unexpected space after \"<\"");
+        return NULL;
+    }
+    if (len > 2 && s[len-2] == ' ') {
+        ctx->error = make_error_at(ctx, at + (int)len - 2,
+                               "Unexpected space before \">\"");
+        return NULL;
+    }
+    
+    /* Extract hex, removing spaces, and validate hex digits */
+    char *hex = mem_alloc(len);
+    size_t hex_len = 0;
+
+    for (size_t i = 1; i < len - 1; ) {
+        size_t run = hex_clean_span(s + i, len - 1 - i);
+        if (run > 0) {
+            memcpy(hex + hex_len, s + i, run);
+            hex_len += run;
+            i += run;
+            continue;
+        }
+        if (s[i] != ' ') {
+            char c = s[i];
+            /* Reject uppercase hex digits */
+            if (c >= 'A' && c <= 'F') {
+                ctx->error = make_error_at(ctx, at + (int)i,
+                                       "Uppercase hex digit (use lowercase)");
+                mem_free(hex);
+                return NULL;
+            }
+            /* Validate hex digit */
+            if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+                ctx->error = make_error_at(ctx, at, "Invalid hex digit");
+                mem_free(hex);
+                return NULL;
+            }
+            hex[hex_len++] = c;
+        }
+        i++;
+    }
+    hex[hex_len] = '\0';
+    
+    if (hex_len % 2 != 0) {
+        ctx->error = make_error_at(ctx, at,
+                               "Odd number of hex digits in byte literal");
+        mem_free(hex);
+        return NULL;
+    }
+    
+    yay_value_t *v = yay_bytes_from_hex(hex);
+    mem_free(hex);
+    return v;
+}
+
+/* ============================================================================
+ * Comment Handling
+ * ============================================================================ */
+
+/* Strip inline comment from a string (modifies in place, returns pointer to start) */
+static char *strip_inline_comment(char *s) {
+    int in_double = 0;
+    int in_single = 0;
+    int escape = 0;
+    
+    for (char *p = s; *p; p++) {
+        if (escape) {
+            escape = 0;
+            continue;
+        }
+        if (*p == '\\') {
+            escape = 1;
+            continue;
+        }
+        if (*p == '"' && !in_single) {
+            in_double = !in_double;
+        } else if (*p == '\'' && !in_double) {
+            in_single = !in_single;
+        } else if (*p == '#' && !in_double && !in_single) {
+            /* Trim trailing whitespace before comment */
+            char *end = p;
+            while (end > s && *(end-1) == ' ') end--;
+            *end = '\0';
+            return s;
+        }
+    }
+    return s;
+}
+
+/* ============================================================================
+ * Scalar Parsing
+ * ============================================================================ */
+
+static yay_value_t *parse_scalar_impl(parse_ctx_t *ctx, const char *s,
+                                       size_t at);
+
+static yay_value_t *parse_scalar(parse_ctx_t *ctx, const char *s,
+                                  size_t at) {
+    /* Strip inline comments first. Scalar text always lives in the
+     * scratch copy and is never revisited once its token is consumed, so
+     * borrowed mode strips in place and lets the string parsers slice
+     * the buffer instead of copying. */
+    if (ctx->borrow) {
+        char *in_place = (char *)s;
+        strip_inline_comment(in_place);
+        return parse_scalar_impl(ctx, in_place, at);
+    }
+    char *s_copy = str_dup(s);
+    strip_inline_comment(s_copy);
+    yay_value_t *result = parse_scalar_impl(ctx, s_copy, at);
+    mem_free(s_copy);
+    return result;
+}
+
+static yay_value_t *parse_scalar_impl(parse_ctx_t *ctx, const char *s,
+                                       size_t at) {
+    /* Keywords, resolved through the perfect-hash table generated from
+     * the grammar's terminal sets */
+    switch (yay_keyword_lookup(s)) {
+        case YAY_KW_NULL: return ctx_null(ctx);
+        case YAY_KW_NAN: return yay_float(NAN);
+        case YAY_KW_TRUE: return ctx_bool(ctx, true);
+        case YAY_KW_FALSE: return ctx_bool(ctx, false);
+        case YAY_KW_INFINITY: return yay_float(INFINITY);
+        case YAY_KW_NEG_INFINITY: return yay_float(-INFINITY);
+        default: break;
+    }
+    
+    /* Numbers */
+    number_scan_t scan;
+    if (scan_number(s, &scan)) {
+        return parse_number(ctx, s, at, &scan);
+    }
+    
+    /* Double-quoted string */
+    if (s[0] == '"') {
+        size_t slen = strlen(s);
+        if (slen < 2 || s[slen-1] != '"') {
+            /* Unterminated string - report at end of string */
+            ctx->error = make_error_at(ctx, at + (int)(slen > 0 ? slen - 1 : 0),
+                                   "Unterminated string");
+            return NULL;
+        }
+        return parse_double_quoted_string(ctx, s, at);
+    }
+    
+    /* Single-quoted string */
+    if (s[0] == '\'') {
+        size_t slen = strlen(s);
+        if (slen < 2 || s[slen-1] != '\'') {
+            /* Unterminated string - report at end of string */
+            ctx->error = make_error_at(ctx, at + (int)(slen > 0 ? slen - 1 : 0),
+                                   "Unterminated string");
+            return NULL;
+        }
+        return parse_single_quoted_string(ctx, s);
+    }
+    
+    /* Inline array - must close on same line */
+    if (s[0] == '[') {
+        if (!strchr(s, ']')) {
+            ctx->error = make_error_at(ctx, at,
+                                   "Unexpected newline in inline array");
+            return NULL;
+        }
+        return parse_inline_array(ctx, s, at);
+    }
+    
+    /* Inline object - must close on same line */
+    if (s[0] == '{') {
+        if (!strchr(s, '}')) {
+            ctx->error = make_error_at(ctx, at,
+                                   "Unexpected newline in inline object");
+            return NULL;
+        }
+        size_t consumed;
+        return parse_inline_value_impl(ctx, s, &consumed, at);
+    }
+    
+    /* Inline bytes */
+    if (s[0] == '<') {
+        yay_value_t *bytes = parse_angle_bytes(ctx, s, at);
+        if (ctx->error) {
+            return NULL;
+        }
+        return bytes;
+    }
+    
+    /* Bare words are not valid - strings must be quoted */
+    char first_char = s[0] ? s[0] : '?';
+    char msg[64];
+    snprintf(msg, sizeof(msg), "Unexpected character \"%c\"", first_char);
+    ctx->error = make_error_at(ctx, at, msg);
+    return NULL;
+}
+
+/* ============================================================================
+ * Object Parsing
+ * ============================================================================ */
+
+/* The outline parser runs as an explicit work-stack state machine rather
+ * than mutual recursion, so nesting depth is bounded by heap, not by the C
+ * call stack. Leaf dispatchers parse scalars and blocks directly; when they
+ * meet a nested container they describe the frame the engine should push
+ * instead of recursing. */
+typedef enum {
+    PENDING_NONE,
+    PENDING_ARRAY,      /* multiline array (indent = minimum item indent) */
+    PENDING_OBJECT,     /* nested object (indent = base indent) */
+    PENDING_ROOT,       /* root object */
+    PENDING_PAIR        /* single key whose value is a nested container */
+} pending_kind_t;
+
+typedef struct {
+    pending_kind_t kind;
+    pending_kind_t pair_kind;   /* container kind under a PENDING_PAIR */
+    int indent;
+    char *key;                  /* owned, PENDING_PAIR only */
+    yay_value_t *container;     /* owned, PENDING_PAIR only (start emitted) */
+} pending_t;
+
+static yay_value_t *parse_object_property_leaf(parse_ctx_t *ctx, size_t *idx,
+                                               token_t *t, const char *v_part,
+                                               size_t v_at, pending_t *pending) {
+    /* Empty object */
+    if (strcmp(v_part, "{}") == 0) {
+        (*idx)++;
+        return yay_object();
+    }
+    
+    /* Block string starting on same line: key: ` content */
+    if (v_part[0] == '`') {
+        /* In property context, block leader must be alone or followed by newline */
+        if (strlen(v_part) > 1) {
+            ctx->error = make_error_plain(ctx,
+                "Expected newline after block leader in property");
+            return NULL;
+        }
+        /* Block leader alone - content starts on next line */
+        return parse_property_block_string_indent(ctx, idx, "", t->indent);
+    }
+    
+    /* Block bytes starting on same line: key: > hex */
+    if (v_part[0] == '>' && !strchr(v_part, '<')) {
+        /* In property context, block leader can be followed by comment but not hex */
+        if (strlen(v_part) > 1) {
+            /* Check if it's just whitespace and/or comment */
+            const char *after_leader = v_part + 1;
+            while (*after_leader == ' ') after_leader++;
+            if (*after_leader != '\0' && *after_leader != '#') {
+                /* Has non-comment content on same line */
+                ctx->error = make_error_plain(ctx,
+                    "Expected newline after block leader in property");
+                return NULL;
+            }
+        }
+        return parse_property_block_bytes(ctx, idx, v_part);
+    }
+    
+    /* Note: "key: <" without closing ">" is invalid - inline byte arrays must be closed on the same line */
+    
+    /* Inline value */
+    if (strlen(v_part) > 0) {
+        (*idx)++;
+        yay_value_t *value = parse_scalar(ctx, v_part, v_at);
+        if (ctx->error) {
+            return NULL;
+        }
+        return value;
+    }
+    
+    /* Nested content */
+    int colon_idx = t->colon;
+    (*idx)++;
+    size_t j = skip_breaks_and_stops(ctx, *idx);
+    
+    if (!token_avail(ctx, j)) {
+        /* Empty property with no nested content is invalid */
+        ctx->error = make_error_at(ctx, token_offset(ctx, t) + colon_idx + 1,
+                               "Expected value after property");
+        return NULL;
+    }
+    
+    token_t *next_t = token_at(ctx, j);
+    
+    /* Named array - pass next_t->indent so array stops at items below this level */
+    if (next_t->type == TOKEN_START) {
+        *idx = j;
+        pending->kind = PENDING_ARRAY;
+        pending->indent = next_t->indent;
+        return NULL;
+    }
+    
+    /* Note: Block string/bytes leaders must be on the same line as the property key */
+    /* Block string leader on next line is invalid */
+    if (next_t->type == TOKEN_TEXT && strcmp(next_t->text, "`") == 0) {
+        ctx->error = make_error_at(ctx, token_offset0(ctx, next_t), "Unexpected indent");
+        return NULL;
+    }
+    
+    /* Block bytes leader on next line is invalid */
+    if (next_t->type == TOKEN_TEXT && next_t->text[0] == '>' && 
+        !strchr(next_t->text, '<')) {
+        ctx->error = make_error_at(ctx, token_offset0(ctx, next_t), "Unexpected indent");
+        return NULL;
+    }
+    
+    /* Note: "key: <" without closing ">" is invalid - inline byte arrays must be closed on the same line */
+    
+    /* Reject inline values on separate line (they look like keys starting with special chars) */
+    if (next_t->type == TOKEN_TEXT && next_t->indent > t->indent) {
+        const char *trimmed = next_t->text;
+        while (*trimmed == ' ') trimmed++;
+        if (trimmed[0] == '[' || trimmed[0] == '{' || trimmed[0] == '<') {
+            ctx->error = make_error_at(ctx, token_offset0(ctx, next_t), "Unexpected indent");
+            return NULL;
+        }
+        /* Reject numbers on separate line */
+        if ((trimmed[0] >= '0' && trimmed[0] <= '9') || 
+            (trimmed[0] == '-' && trimmed[1] >= '0' && trimmed[1] <= '9') ||
+            (trimmed[0] == '.' && trimmed[1] >= '0' && trimmed[1] <= '9')) {
+            ctx->error = make_error_at(ctx, token_offset0(ctx, next_t), "Unexpected indent");
+            return NULL;
+        }
+    }
+    
+    /* Concatenated quoted strings (multiple quoted strings on consecutive lines) */
+    if (next_t->type == TOKEN_TEXT && next_t->indent > t->indent) {
+        const char *trimmed = next_t->text;
+        while (*trimmed == ' ') trimmed++;
+        size_t trimmed_len = strlen(trimmed);
+        bool is_double_quoted = trimmed_len >= 2 && trimmed[0] == '"' && trimmed[trimmed_len-1] == '"';
+        bool is_single_quoted = trimmed_len >= 2 && trimmed[0] == '\'' && trimmed[trimmed_len-1] == '\'';
+        
+        if (is_double_quoted || is_single_quoted) {
+            *idx = j;
+            yay_value_t *result = parse_concatenated_strings(ctx, idx, next_t->indent);
+            if (result != NULL) {
+                return result;
+            }
+            /* Single string on new line is invalid - fall through to error */
+            ctx->error = make_error_at(ctx, token_offset0(ctx, next_t), "Unexpected indent");
+            return NULL;
+        }
+    }
+    
+    /* Nested object */
+    if (next_t->type == TOKEN_TEXT && next_t->indent > t->indent) {
+        *idx = j;
+        pending->kind = PENDING_OBJECT;
+        pending->indent = next_t->indent;
+        return NULL;
+    }
+    
+    /* Empty property with no nested content is invalid */
+    ctx->error = make_error_at(ctx, token_offset(ctx, t) + colon_idx + 1,
+                           "Expected value after property");
+    return NULL;
+}
+
+/* Validate object property syntax (whitespace around colon, key characters) */
+static bool validate_object_property(parse_ctx_t *ctx, const char *text, 
+                                      int colon_idx, size_t at) {
+    /* Check for space before colon */
+    if (colon_idx > 0 && text[colon_idx - 1] == ' ') {
+        ctx->error = make_error_at(ctx, at + colon_idx - 1,
+                               "Unexpected space before \":\"");
+        return false;
+    }
+    
+    /* Check for space after colon */
+    const char *after_colon = text + colon_idx + 1;
+    if (*after_colon == '\0') {
+        /* Colon at end of line - that's ok (block value follows) */
+    } else if (*after_colon != ' ') {
+        ctx->error = make_error_at(ctx, at + colon_idx,
+                               "Expected space after \":\"");
+        return false;
+    } else if (after_colon[0] == ' ' && after_colon[1] == ' ') {
+        ctx->error = make_error_at(ctx, at + colon_idx + 2,
+                               "Unexpected space after \":\"");
+        return false;
+    }
+    
+    /* Validate key characters for unquoted keys */
+    if (text[0] != '"' && text[0] != '\'') {
+        for (int ki = 0; ki < colon_idx; ki++) {
+            char kc = text[ki];
+            if (!isalnum(kc) && kc != '_' && kc != '-') {
+                ctx->error = make_error_at(ctx, at + ki,
+                                       "Invalid key character");
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
+
+/* ============================================================================
+ * Multiline Array Helpers
+ * ============================================================================ */
+
+/* Check if text starts with "- " (inline bullet) */
+static bool is_inline_bullet(const char *text) {
+    int i = 0;
+    while (text[i] == ' ') i++;
+    return text[i] == '-' && text[i + 1] == ' ';
+}
+
+/* Validate inline bullet has exactly one space after "-" */
+static bool validate_inline_bullet(parse_ctx_t *ctx, const char *text, size_t at) {
+    int i = 0;
+    while (text[i] == ' ') i++;
+    if (text[i] == '-' && text[i + 1] == ' ' && text[i + 2] == ' ') {
+        ctx->error = make_error_at(ctx, at + i + 2,
+                               "Unexpected space after \"-\"");
+        return false;
+    }
+    return true;
+}
+
+/* Parse inline bullet value (extract content after "- ") */
+static const char *get_inline_bullet_value(const char *text) {
+    int i = 0;
+    while (text[i] == ' ') i++;
+    if (text[i] == '-' && text[i + 1] == ' ') {
+        return text + i + 2;
+    }
+    return text;
+}
+
+/* Parse nested inline bullets like "- - - value": strip the bullet prefixes,
+ * parse the scalar once, then wrap it in one array per bullet */
+static yay_value_t *parse_nested_inline_bullet(parse_ctx_t *ctx, const char *text,
+                                                size_t at) {
+    int depth = 0;
+    while (is_inline_bullet(text)) {
+        text = get_inline_bullet_value(text);
+        at += 2;
+        depth++;
+    }
+    yay_value_t *value = parse_scalar(ctx, text, at);
+    if (ctx->error) {
+        return NULL;
+    }
+    for (int d = 0; d < depth; d++) {
+        yay_value_t *arr = yay_array();
+        yay_array_push(arr, value);
+        value = arr;
+    }
+    return value;
+}
+
+/* ============================================================================
+ * Value Parsing
+ * ============================================================================ */
+
+static yay_value_t *parse_value_leaf(parse_ctx_t *ctx, size_t *idx,
+                                     pending_t *pending) {
+    if (!token_avail(ctx, *idx)) {
+        return ctx_null(ctx);
+    }
+    
+    token_t *t = token_at(ctx, *idx);
+    
+    /* Validate text tokens */
+    if (t->type == TOKEN_TEXT) {
+        if (t->text[0] == ' ') {
+            ctx->error = make_error_at(ctx, token_offset(ctx, t),
+                                   "Unexpected leading space");
+            return NULL;
+        }
+        if (strcmp(t->text, "$") == 0) {
+            ctx->error = make_error_at(ctx, token_offset(ctx, t),
+                                   "Unexpected character \"$\"");
+            return NULL;
+        }
+    }
+    
+    /* Block starts (list items) */
+    if (t->type == TOKEN_START) {
+        pending->kind = PENDING_ARRAY;
+        pending->indent = -1;
+        return NULL;
+    }
+    
+    /* Text content */
+    if (t->type == TOKEN_TEXT) {
+        const char *s = t->text;
+        
+        /* Keywords */
+        if (strcmp(s, "null") == 0) { (*idx)++; return ctx_null(ctx); }
+        if (strcmp(s, "true") == 0) { (*idx)++; return ctx_bool(ctx, true); }
+        if (strcmp(s, "false") == 0) { (*idx)++; return ctx_bool(ctx, false); }
+        if (strcmp(s, "nan") == 0) { (*idx)++; return yay_float(NAN); }
+        if (strcmp(s, "infinity") == 0) { (*idx)++; return yay_float(INFINITY); }
+        if (strcmp(s, "-infinity") == 0) { (*idx)++; return yay_float(-INFINITY); }
+        
+        /* Numbers */
+        number_scan_t scan;
+        if (scan_number(s, &scan)) {
+            yay_value_t *v = parse_number(ctx, s, token_offset(ctx, t), &scan);
+            if (ctx->error) return NULL;
+            (*idx)++;
+            return v;
+        }
+        
+        /* Block string (backtick) */
+        if (strcmp(s, "`") == 0 || (s[0] == '`' && strlen(s) >= 2 && s[1] == ' ')) {
+            const char *first_line = strlen(s) > 2 ? s + 2 : "";
+            return parse_block_string(ctx, idx, first_line);
+        }
+        
+        /* Block bytes (>) */
+        if (s[0] == '>' && !strchr(s, '<')) {
+            return parse_block_bytes(ctx, idx);
+        }
+        
+        /* Quoted string */
+        if (s[0] == '"' && strlen(s) > 1) {
+            size_t slen = strlen(s);
+            if (s[slen-1] != '"') {
+                /* Unterminated string - report at end of string */
+                ctx->error = make_error_at(ctx, token_offset(ctx, t) + (int)(slen > 0 ? slen - 1 : 0),
+                                       "Unterminated string");
+                return NULL;
+            }
+            (*idx)++;
+            return parse_double_quoted_string(ctx, s, token_offset(ctx, t));
+        }
+        if (s[0] == '\'' && strlen(s) > 1) {
+            size_t slen = strlen(s);
+            if (s[slen-1] != '\'') {
+                /* Unterminated string - report at end of string */
+                ctx->error = make_error_at(ctx, token_offset(ctx, t) + (int)(slen > 0 ? slen - 1 : 0),
+                                       "Unterminated string");
+                return NULL;
+            }
+            (*idx)++;
+            return parse_single_quoted_string(ctx, s);
+        }
+        
+        /* Inline array - must close on same line */
+        if (s[0] == '[') {
+            if (!strchr(s, ']')) {
+                ctx->error = make_error_at(ctx, token_offset(ctx, t),
+                                       "Unexpected newline in inline array");
+                return NULL;
+            }
+            (*idx)++;
+            return parse_inline_array(ctx, s, token_offset(ctx, t));
+        }
+        
+        /* Inline object - must close on same line */
+        if (s[0] == '{') {
+            if (!strchr(s, '}')) {
+                ctx->error = make_error_at(ctx, token_offset(ctx, t),
+                                       "Unexpected newline in inline object");
+                return NULL;
+            }
+            size_t consumed;
+            (*idx)++;
+            return parse_inline_value(ctx, s, &consumed, token_offset(ctx, t));
+        }
+        
+        /* Inline bytes */
+        if (s[0] == '<') {
+            (*idx)++;
+            yay_value_t *bytes = parse_angle_bytes(ctx, s, token_offset(ctx, t));
+            if (ctx->error) {
                 return NULL;
             }
+            return bytes;
+        }
+        
+        /* Key:value pair */
+        int colon_idx = t->colon;
+        if (colon_idx >= 0) {
+            char *k_raw = str_dup_len(s, colon_idx);
+            char *plain = parse_key_name(k_raw);
+            mem_free(k_raw);
+            char *key = intern_key(ctx, plain);
+            mem_free(plain);
             
-            char esc = s[++i];
-            switch (esc) {
-                case '"': out[out_len++] = '"'; break;
-                case '\\': out[out_len++] = '\\'; break;
-                case '/': out[out_len++] = '/'; break;
-                case 'b': out[out_len++] = '\b'; break;
-                case 'f': out[out_len++] = '\f'; break;
-                case 'n': out[out_len++] = '\n'; break;
-                case 'r': out[out_len++] = '\r'; break;
-                case 't': out[out_len++] = '\t'; break;
-                case 'u': {
-                    /* Expect \u{XXXXXX} format */
-                    /* Old-style \uXXXX is not supported - report at 'u' column */
-                    if (i + 1 >= len - 1 || s[i+1] != '{') {
-                        ctx->error = make_error(ctx, line_num, col + i,
-                                               "Bad escaped character");
-                        free(out);
-                        return NULL;
-                    }
-                    
-                    /* Column of '{' for subsequent errors */
-                    int brace_col = col + i + 1;
-                    
-                    /* Find closing brace */
-                    size_t brace_end = i + 2;
-                    while (brace_end < len - 1 && s[brace_end] != '}') {
-                        brace_end++;
-                    }
-                    
-                    if (brace_end >= len - 1 || s[brace_end] != '}') {
-                        ctx->error = make_error(ctx, line_num, brace_col,
-                                               "Bad Unicode escape");
-                        free(out);
-                        return NULL;
-                    }
-                    
-                    size_t hex_start = i + 2;
-                    size_t hex_len_u = brace_end - hex_start;
-                    
-                    if (hex_len_u == 0 || hex_len_u > 6) {
-                        ctx->error = make_error(ctx, line_num, brace_col,
-                                               "Bad Unicode escape");
-                        free(out);
-                        return NULL;
-                    }
-                    
-                    /* Validate hex digits */
-                    for (size_t j = hex_start; j < brace_end; j++) {
-                        if (!isxdigit((unsigned char)s[j])) {
-                            ctx->error = make_error(ctx, line_num, brace_col,
-                                                   "Bad Unicode escape");
-                            free(out);
-                            return NULL;
-                        }
-                    }
-                    
-                    char hex[7];
-                    memcpy(hex, s + hex_start, hex_len_u);
-                    hex[hex_len_u] = '\0';
-                    
-                    unsigned int code;
-                    if (sscanf(hex, "%x", &code) != 1) {
-                        ctx->error = make_error(ctx, line_num, brace_col,
-                                               "Bad Unicode escape");
-                        free(out);
-                        return NULL;
-                    }
-                    
-                    /* Check for surrogates */
-                    if (code >= 0xD800 && code <= 0xDFFF) {
-                        ctx->error = make_error(ctx, line_num, brace_col,
-                                               "Illegal surrogate");
-                        free(out);
-                        return NULL;
-                    }
-                    
-                    /* Check for out of range */
-                    if (code > 0x10FFFF) {
-                        ctx->error = make_error(ctx, line_num, brace_col,
-                                               "Unicode code point out of range");
-                        free(out);
-                        return NULL;
+            const char *v_part = s + colon_idx + 1;
+            size_t v_at = token_offset(ctx, t) + (size_t)colon_idx + 1;
+            while (*v_part == ' ') { v_part++; v_at++; }
+            
+            yay_value_t *obj = ctx->events ? &event_sentinel : yay_object();
+            emit_object_start(ctx);
+            emit_object_key(ctx, key);
+            pending_t prop = {0};
+            yay_value_t *value = parse_object_property_leaf(ctx, idx, t, v_part, v_at, &prop);
+            if (ctx->error) {
+                key_release(key);
+                yay_free(obj);
+                return NULL;
+            }
+            if (prop.kind != PENDING_NONE) {
+                /* Hand the single-pair wrap to the engine */
+                pending->kind = PENDING_PAIR;
+                pending->pair_kind = prop.kind;
+                pending->indent = prop.indent;
+                pending->key = key;
+                pending->container = obj;
+                return NULL;
+            }
+            
+            object_attach(ctx, obj, key, value);
+            key_release(key);
+            emit_object_end(ctx);
+            return obj;
+        }
+        
+        /* Fall back to scalar */
+        (*idx)++;
+        return parse_scalar(ctx, s, token_offset(ctx, t));
+    }
+    
+    (*idx)++;
+    return ctx_null(ctx);
+}
+
+/* ============================================================================
+ * Outline Parsing Engine
+ * ============================================================================ */
+
+typedef enum {
+    FRAME_ARRAY,        /* multiline array */
+    FRAME_OBJECT,       /* nested object, bounded by base_indent */
+    FRAME_ROOT,         /* root object, consumes all indent-0 properties */
+    FRAME_PAIR          /* single key: value wrapper from parse_value_leaf */
+} frame_kind_t;
+
+enum {
+    STAGE_LOOP,         /* at the top of the frame's item loop */
+    STAGE_BULLETS,      /* array: continuing an inline-bullet group */
+    STAGE_AFTER_ITEM,   /* array: child result attaches to container */
+    STAGE_AFTER_BULLET  /* array: child result attaches to bullet group */
+};
+
+typedef struct {
+    frame_kind_t kind;
+    int stage;
+    yay_value_t *container;
+    yay_value_t *nested;    /* inline-bullet sub-array (arrays only) */
+    char *key;              /* pending property key (objects, pairs) */
+    int min_indent;         /* arrays */
+    int list_indent;        /* arrays: indent of the current item */
+    int base_indent;        /* objects */
+} parse_frame_t;
+
+/* Open the container a leaf dispatcher asked for, emitting its start event */
+static parse_frame_t frame_open(parse_ctx_t *ctx, pending_kind_t kind, int indent) {
+    parse_frame_t f = {0};
+    if (kind == PENDING_ARRAY) {
+        f.kind = FRAME_ARRAY;
+        f.min_indent = indent;
+        f.container = ctx->events ? &event_sentinel : yay_array();
+        emit_array_start(ctx);
+    } else {
+        f.kind = kind == PENDING_ROOT ? FRAME_ROOT : FRAME_OBJECT;
+        f.base_indent = indent;
+        f.container = ctx->events ? &event_sentinel : yay_object();
+        emit_object_start(ctx);
+    }
+    return f;
+}
+
+static void frame_destroy(parse_frame_t *f) {
+    yay_free(f->container);
+    yay_free(f->nested);
+    if (f->key) key_release(f->key);
+}
+
+static yay_value_t *parse_outline(parse_ctx_t *ctx, size_t *idx,
+                                  const pending_t *first) {
+    size_t cap = 16;
+    size_t depth = 0;
+    parse_frame_t *stack = mem_alloc(cap * sizeof(parse_frame_t));
+    yay_value_t *result = NULL;
+    bool have_result = false;
+
+#define PUSH_FRAME(fr) do { \
+        parse_frame_t opened = (fr); \
+        if (!limit_charge_depth(depth)) { \
+            frame_destroy(&opened); \
+            ctx->error = make_error_plain(ctx, limit_exceeded); \
+            goto fail; \
+        } \
+        if (depth >= cap) { \
+            cap *= 2; \
+            stack = mem_realloc(stack, cap * sizeof(parse_frame_t)); \
+        } \
+        stack[depth++] = opened; \
+    } while (0)
+
+#define PUSH_PENDING(p) do { \
+        if ((p).kind == PENDING_PAIR) { \
+            parse_frame_t pair_frame = {0}; \
+            pair_frame.kind = FRAME_PAIR; \
+            pair_frame.container = (p).container; \
+            pair_frame.key = (p).key; \
+            PUSH_FRAME(pair_frame); \
+            PUSH_FRAME(frame_open(ctx, (p).pair_kind, (p).indent)); \
+        } else { \
+            PUSH_FRAME(frame_open(ctx, (p).kind, (p).indent)); \
+        } \
+    } while (0)
+
+    PUSH_PENDING(*first);
+
+    while (depth > 0) {
+        /* A budget tripped inside a constructor surfaces here as an
+         * ordinary parse error instead of chewing through the rest of
+         * the document */
+        if (current_limits && limit_exceeded && !ctx->error) {
+            ctx->error = make_error_plain(ctx, limit_exceeded);
+            goto fail;
+        }
+
+        /* Tokens behind the cursor are never revisited; recycle their
+         * window chunks so the whole stream never exists at once */
+        token_discard(ctx, *idx);
+
+        parse_frame_t *f = &stack[depth - 1];
+
+        /* Deliver a completed child to the frame that was waiting on it */
+        if (have_result) {
+            have_result = false;
+            if (f->kind == FRAME_ARRAY) {
+                if (f->stage == STAGE_AFTER_BULLET) {
+                    array_attach(ctx, f->nested, result);
+                    *idx = skip_stops(ctx, *idx);
+                    f->stage = STAGE_BULLETS;
+                } else {
+                    array_attach(ctx, f->container, result);
+                    *idx = skip_stops(ctx, *idx);
+                    *idx = skip_breaks(ctx, *idx);
+                    f->stage = STAGE_LOOP;
+                }
+            } else if (f->kind == FRAME_PAIR) {
+                object_attach(ctx, f->container, f->key, result);
+                key_release(f->key);
+                f->key = NULL;
+                emit_object_end(ctx);
+                result = f->container;
+                have_result = true;
+                depth--;
+                continue;
+            } else {
+                object_attach(ctx, f->container, f->key, result);
+                key_release(f->key);
+                f->key = NULL;
+            }
+        }
+
+        if (f->kind == FRAME_ARRAY && f->stage == STAGE_BULLETS) {
+            /* Continue a bullet group with nested START tokens at deeper
+             * indent */
+            if (token_avail(ctx, *idx) &&
+                token_at(ctx, *idx)->type == TOKEN_START &&
+                token_at(ctx, *idx)->indent > f->list_indent) {
+                (*idx)++;
+                *idx = skip_breaks(ctx, *idx);
+                if (token_avail(ctx, *idx)) {
+                    pending_t p = {0};
+                    yay_value_t *sub_val = parse_value_leaf(ctx, idx, &p);
+                    if (ctx->error) goto fail;
+                    if (p.kind != PENDING_NONE) {
+                        f->stage = STAGE_AFTER_BULLET;
+                        PUSH_PENDING(p);
+                        continue;
                     }
-                    
-                    /* Encode as UTF-8 */
-                    if (code < 0x80) {
-                        out[out_len++] = code;
-                    } else if (code < 0x800) {
-                        out[out_len++] = 0xC0 | (code >> 6);
-                        out[out_len++] = 0x80 | (code & 0x3F);
-                    } else if (code < 0x10000) {
-                        out[out_len++] = 0xE0 | (code >> 12);
-                        out[out_len++] = 0x80 | ((code >> 6) & 0x3F);
-                        out[out_len++] = 0x80 | (code & 0x3F);
-                    } else {
-                        out[out_len++] = 0xF0 | (code >> 18);
-                        out[out_len++] = 0x80 | ((code >> 12) & 0x3F);
-                        out[out_len++] = 0x80 | ((code >> 6) & 0x3F);
-                        out[out_len++] = 0x80 | (code & 0x3F);
+                    array_attach(ctx, f->nested, sub_val);
+                    *idx = skip_stops(ctx, *idx);
+                    continue;
+                }
+            }
+            /* Bullet group finished */
+            emit_array_end(ctx);
+            array_attach(ctx, f->container, f->nested);
+            f->nested = NULL;
+            *idx = skip_stops(ctx, *idx);
+            *idx = skip_breaks(ctx, *idx);
+            f->stage = STAGE_LOOP;
+            continue;
+        }
+
+        if (f->kind == FRAME_ARRAY) {
+            if (!(token_avail(ctx, *idx) &&
+                  token_at(ctx, *idx)->type == TOKEN_START) ||
+                (f->min_indent >= 0 &&
+                 token_at(ctx, *idx)->indent < f->min_indent)) {
+                emit_array_end(ctx);
+                result = f->container;
+                have_result = true;
+                depth--;
+                continue;
+            }
+            f->list_indent = token_at(ctx, *idx)->indent;
+            (*idx)++;
+            
+            *idx = skip_breaks(ctx, *idx);
+            if (!token_avail(ctx, *idx)) {
+                emit_array_end(ctx);
+                result = f->container;
+                have_result = true;
+                depth--;
+                continue;
+            }
+            
+            token_t *next = token_at(ctx, *idx);
+            
+            /* Nested array - START token */
+            if (next->type == TOKEN_START) {
+                pending_t p = {0};
+                p.kind = PENDING_ARRAY;
+                p.indent = -1;
+                f->stage = STAGE_AFTER_ITEM;
+                PUSH_PENDING(p);
+                continue;
+            }
+            /* Inline bullet (text starts with "- ") - creates nested array */
+            else if (next->type == TOKEN_TEXT && is_inline_bullet(next->text)) {
+                /* Validate the first inline bullet */
+                if (!validate_inline_bullet(ctx, next->text, token_offset(ctx, next))) {
+                    goto fail;
+                }
+                
+                f->nested = ctx->events ? &event_sentinel : yay_array();
+                emit_array_start(ctx);
+                
+                /* Collect all inline bullets at this level */
+                while (token_avail(ctx, *idx) && 
+                       token_at(ctx, *idx)->type == TOKEN_TEXT &&
+                       is_inline_bullet(token_at(ctx, *idx)->text)) {
+                    /* Validate each inline bullet */
+                    if (!validate_inline_bullet(ctx, token_at(ctx, *idx)->text,
+                                                token_offset(ctx, token_at(ctx, *idx)))) {
+                        goto fail;
                     }
                     
-                    i = brace_end;
-                    break;
+                    const char *val_str = get_inline_bullet_value(token_at(ctx, *idx)->text);
+                    yay_value_t *item = parse_nested_inline_bullet(ctx, val_str, 
+                                                      token_offset(ctx, token_at(ctx, *idx)) + 2);
+                    if (ctx->error) goto fail;
+                    array_attach(ctx, f->nested, item);
+                    (*idx)++;
+                }
+                
+                f->stage = STAGE_BULLETS;
+                continue;
+            }
+            /* Object in array - use list_indent as base so sibling
+             * properties at higher indent are included */
+            else if (next->type == TOKEN_TEXT && next->colon >= 0) {
+                pending_t p = {0};
+                p.kind = PENDING_OBJECT;
+                p.indent = f->list_indent;
+                f->stage = STAGE_AFTER_ITEM;
+                PUSH_PENDING(p);
+                continue;
+            }
+            /* Regular value */
+            else if (next->type == TOKEN_TEXT) {
+                const char *s = next->text;
+                /* Block string in array context - use list_indent as base */
+                if (strcmp(s, "`") == 0 || (s[0] == '`' && strlen(s) >= 2 && s[1] == ' ')) {
+                    const char *first_line = strlen(s) > 2 ? s + 2 : "";
+                    yay_value_t *value = parse_block_string_impl(ctx, idx, first_line, f->list_indent);
+                    if (ctx->error) goto fail;
+                    array_attach(ctx, f->container, value);
+                } else {
+                    pending_t p = {0};
+                    yay_value_t *value = parse_value_leaf(ctx, idx, &p);
+                    if (ctx->error) goto fail;
+                    if (p.kind != PENDING_NONE) {
+                        f->stage = STAGE_AFTER_ITEM;
+                        PUSH_PENDING(p);
+                        continue;
+                    }
+                    array_attach(ctx, f->container, value);
+                }
+            }
+            else {
+                (*idx)++;
+            }
+            
+            /* Skip stops and breaks between items */
+            *idx = skip_stops(ctx, *idx);
+            *idx = skip_breaks(ctx, *idx);
+            continue;
+        }
+
+        if (f->kind == FRAME_OBJECT || f->kind == FRAME_ROOT) {
+            if (!token_avail(ctx, *idx)) {
+                emit_object_end(ctx);
+                result = f->container;
+                have_result = true;
+                depth--;
+                continue;
+            }
+            
+            token_t *t = token_at(ctx, *idx);
+            
+            if (t->type == TOKEN_STOP || t->type == TOKEN_BREAK) {
+                (*idx)++;
+                continue;
+            }
+            
+            if (f->kind == FRAME_ROOT) {
+                if (t->type != TOKEN_TEXT || t->indent != 0) {
+                    (*idx)++;
+                    continue;
+                }
+            } else if (t->type != TOKEN_TEXT) {
+                /* START tokens indicate a new list item - break out */
+                emit_object_end(ctx);
+                result = f->container;
+                have_result = true;
+                depth--;
+                continue;
+            }
+            
+            int colon_idx = t->colon;
+            if (f->kind == FRAME_ROOT) {
+                if (colon_idx < 0) {
+                    (*idx)++;
+                    continue;
+                }
+            } else if (colon_idx < 0 || t->indent < f->base_indent) {
+                emit_object_end(ctx);
+                result = f->container;
+                have_result = true;
+                depth--;
+                continue;
+            }
+            
+            /* Validate object property syntax */
+            if (!validate_object_property(ctx, t->text, colon_idx, token_offset(ctx, t))) {
+                goto fail;
+            }
+            
+            char *k_raw = str_dup_len(t->text, colon_idx);
+            char *plain = parse_key_name(k_raw);
+            mem_free(k_raw);
+            char *key = intern_key(ctx, plain);
+            mem_free(plain);
+            
+            const char *v_part = t->text + colon_idx + 1;
+            size_t v_at = token_offset(ctx, t) + (size_t)colon_idx + 1;
+            while (*v_part == ' ') { v_part++; v_at++; }
+            
+            if (f->kind == FRAME_OBJECT && strlen(key) == 0) {
+                key_release(key);
+                (*idx)++;
+                continue;
+            }
+            
+            emit_object_key(ctx, key);
+            pending_t p = {0};
+            yay_value_t *value = parse_object_property_leaf(ctx, idx, t, v_part, v_at, &p);
+            if (ctx->error) {
+                key_release(key);
+                goto fail;
+            }
+            if (p.kind != PENDING_NONE) {
+                f->key = key;
+                PUSH_PENDING(p);
+                continue;
+            }
+            
+            object_attach(ctx, f->container, key, value);
+            key_release(key);
+            continue;
+        }
+
+        /* FRAME_PAIR only ever waits beneath its pushed child */
+        goto fail;
+    }
+
+#undef PUSH_PENDING
+#undef PUSH_FRAME
+
+    mem_free(stack);
+    return result;
+
+fail:
+    while (depth > 0) {
+        frame_destroy(&stack[--depth]);
+    }
+    mem_free(stack);
+    return NULL;
+}
+
+static yay_value_t *parse_value(parse_ctx_t *ctx, size_t *idx) {
+    pending_t pending = {0};
+    yay_value_t *value = parse_value_leaf(ctx, idx, &pending);
+    if (ctx->error) {
+        return NULL;
+    }
+    if (pending.kind == PENDING_NONE) {
+        return value;
+    }
+    return parse_outline(ctx, idx, &pending);
+}
+
+/* ============================================================================
+ * Root Parsing
+ * ============================================================================ */
+
+static yay_value_t *parse_root_object(parse_ctx_t *ctx, size_t *idx) {
+    pending_t pending = {0};
+    pending.kind = PENDING_ROOT;
+    return parse_outline(ctx, idx, &pending);
+}
+
+static yay_value_t *parse_root(parse_ctx_t *ctx) {
+    size_t i = skip_breaks_and_stops(ctx, 0);
+    
+    if (!token_avail(ctx, i)) {
+        /* No value found - this is an error */
+        if (ctx->filename) {
+            char buf[512];
+            snprintf(buf, sizeof(buf), "No value found in document <%s>", ctx->filename);
+            ctx->error = make_error_plain(ctx, buf);
+        } else {
+            ctx->error = make_error_plain(ctx, "No value found in document");
+        }
+        return NULL;
+    }
+    
+    token_t *t = token_at(ctx, i);
+    
+    /* Check for unexpected indent at root */
+    if (t->type == TOKEN_TEXT && t->indent > 0) {
+        ctx->error = make_error_at(ctx, token_offset0(ctx, t), "Unexpected indent");
+        return NULL;
+    }
+    
+    /* Detect root object (key: value at indent 0, not inline object) */
+    if (t->type == TOKEN_TEXT && t->text[0] != '{' &&
+        t->colon >= 0 && t->indent == 0) {
+        yay_value_t *value = parse_root_object(ctx, &i);
+        if (ctx->error) {
+            return NULL;
+        }
+        
+        /* Check for extra content */
+        size_t j = skip_breaks_and_stops(ctx, i);
+        if (token_avail(ctx, j)) {
+            token_t *extra = token_at(ctx, j);
+            ctx->error = make_error_at(ctx, token_offset(ctx, extra),
+                                   "Unexpected extra content");
+            yay_free(value);
+            return NULL;
+        }
+        
+        return value;
+    }
+    
+    /* Parse as single value */
+    yay_value_t *value = parse_value(ctx, &i);
+    if (ctx->error) {
+        return NULL;
+    }
+    
+    /* Check for extra content */
+    size_t j = skip_breaks_and_stops(ctx, i);
+    if (token_avail(ctx, j)) {
+        token_t *extra = token_at(ctx, j);
+        ctx->error = make_error_at(ctx, token_offset(ctx, extra),
+                               "Unexpected extra content");
+        yay_free(value);
+        return NULL;
+    }
+    
+    if (ctx->events) {
+        emit_child(ctx, value);
+        return &event_sentinel;
+    }
+    return value;
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================ */
+
+static yay_result_t parse_document(const char *source, size_t length,
+                                   const char *filename,
+                                   const yay_callbacks_t *callbacks,
+                                   void *user_data, bool compact,
+                                   yay_arena_t *borrow_arena,
+                                   bool adopt_source) {
+    yay_result_t result = {NULL, NULL};
+    
+    if (!source) {
+        result.error = error_alloc();
+        result.error->message = str_dup("NULL source");
+        return result;
+    }
+    
+    if (length == 0) {
+        length = strlen(source);
+    }
+    
+    /* Initialize context */
+    parse_ctx_t ctx = {0};
+    ctx.filename = filename;
+    ctx.source = source;
+    ctx.source_len = length;
+    ctx.events = callbacks;
+    ctx.user_data = user_data;
+    ctx.compact = compact;
+    ctx.borrow = borrow_arena != NULL;
+    ctx.adopt_source = adopt_source;
+    /* Scan lines are bounded by the newline count, so the array is sized
+     * exactly once up front. Tokens are lexed lazily into the chunked
+     * window as the parser pulls them. */
+    size_t newlines = count_newlines(source, length);
+    ctx.line_capacity = newlines + 2;
+#ifdef YAY_STATS
+    memset(&stats_current, 0, sizeof(stats_current));
+    stats_alloc_slot = &stats_current.scan_allocations;
+    double stats_start = stats_now();
+#endif
+    ctx.lines = mem_calloc(ctx.line_capacity, sizeof(scan_line_t));
+    STATS_ALLOC();
+    
+    /* Phase 1: Scan setup; lines are produced on demand as the parser
+     * pulls tokens, so all three phases stream the document together */
+    bool scanned = scan_init(&ctx);
+#ifdef YAY_STATS
+    stats_current.scan_seconds = stats_now() - stats_start;
+    stats_alloc_slot = &stats_current.build_allocations;
+#endif
+    if (!scanned) {
+        result.error = error_publish(&ctx);
+        goto cleanup;
+    }
+    
+    /* Phases 2 and 3: the parser pulls tokens from the lexer on demand */
+    result.value = parse_root(&ctx);
+    if (!ctx.error && current_limits && limit_exceeded) {
+        ctx.error = make_error_plain(&ctx, limit_exceeded);
+    }
+    if (ctx.error) {
+        result.error = error_publish(&ctx);
+        yay_free(result.value);
+        result.value = NULL;
+    }
+    
+cleanup:
+#ifdef YAY_STATS
+    stats_current.build_seconds = stats_now() - stats_start -
+        stats_current.scan_seconds - stats_current.lex_seconds;
+    stats_current.lines = ctx.line_count;
+    stats_alloc_slot = NULL;
+#endif
+    /* Scan lines and tokens borrow from the scratch copy of the source.
+     * In borrowed mode the result's strings view into scratch, so its
+     * lifetime passes to the caller's arena. */
+    mem_free(ctx.lines);
+    mem_free(ctx.line_starts);
+    for (size_t i = 0; i < ctx.chunk_count; i++) {
+        mem_free(ctx.token_chunks[i]);
+    }
+    mem_free(ctx.token_chunks);
+    mem_free(ctx.spare_chunk);
+    if (borrow_arena && result.value && !result.error) {
+        arena_adopt(borrow_arena, ctx.scratch);
+        ctx.scratch = NULL;
+    } else if (adopt_source && !ctx.scratch) {
+        /* scan() rejected the source before taking it over as scratch;
+         * the adopted buffer is still consumed */
+        mem_free((char *)source);
+    }
+    mem_free(ctx.scratch);
+    if (ctx.intern) {
+        for (size_t i = 0; i < ctx.intern_capacity; i++) {
+            if (ctx.intern[i]) key_release(ctx.intern[i]);
+        }
+        mem_free(ctx.intern);
+    }
+
+    return result;
+}
+
+yay_result_t yay_parse(const char *source, size_t length, const char *filename) {
+    return parse_document(source, length, filename, NULL, NULL, false, NULL,
+                          false);
+}
+
+yay_result_t yay_parse_compact(const char *source, size_t length,
+                               const char *filename) {
+    return parse_document(source, length, filename, NULL, NULL, true, NULL,
+                          false);
+}
+
+yay_result_t yay_parse_limited(const char *source, size_t length,
+                               const char *filename,
+                               const yay_limits_t *limits) {
+    current_limits = limits;
+    limit_nodes_spent = 0;
+    limit_string_bytes_spent = 0;
+    limit_exceeded = NULL;
+    yay_result_t result = yay_parse(source, length, filename);
+    current_limits = NULL;
+    return result;
+}
+
+/* ============================================================================
+ * Schema-Driven Decoding
+ * ============================================================================ */
+
+typedef struct {
+    const yay_field_t *fields;
+    size_t field_count;
+    char *out;
+    int depth;                  /* container nesting; the root object is 1 */
+    const yay_field_t *pending; /* matched field awaiting its value */
+} into_state_t;
+
+static const yay_field_t *into_match(into_state_t *state, const char *key,
+                                     size_t length) {
+    for (size_t i = 0; i < state->field_count; i++) {
+        const char *name = state->fields[i].name;
+        if (strncmp(name, key, length) == 0 && name[length] == '\0') {
+            return &state->fields[i];
+        }
+    }
+    return NULL;
+}
+
+/* Claim the pending field if the arriving value has the expected type */
+static void *into_claim(into_state_t *state, yay_type_t type) {
+    const yay_field_t *field = state->pending;
+    state->pending = NULL;
+    if (state->depth != 1 || !field || field->type != type) return NULL;
+    return state->out + field->offset;
+}
+
+static bool into_on_null(void *ud) {
+    into_state_t *state = ud;
+    state->pending = NULL;
+    return true;
+}
+
+static bool into_on_bool(bool value, void *ud) {
+    bool *slot = into_claim(ud, YAY_BOOL);
+    if (slot) *slot = value;
+    return true;
+}
+
+static bool into_on_int(const char *digits, bool negative, void *ud) {
+    int64_t *slot = into_claim(ud, YAY_INT);
+    if (slot) {
+        int64_t magnitude = strtoll(digits, NULL, 10);
+        *slot = negative ? -magnitude : magnitude;
+    }
+    return true;
+}
+
+static bool into_on_float(double value, void *ud) {
+    double *slot = into_claim(ud, YAY_FLOAT);
+    if (slot) *slot = value;
+    return true;
+}
+
+static bool into_on_string(const char *str, size_t length, void *ud) {
+    char **slot = into_claim(ud, YAY_STRING);
+    if (slot) {
+        char *copy = mem_alloc(length + 1);
+        if (copy) {
+            memcpy(copy, str, length);
+            copy[length] = '\0';
+        }
+        mem_free(*slot);
+        *slot = copy;
+    }
+    return true;
+}
+
+static bool into_on_bytes(const uint8_t *data, size_t length, void *ud) {
+    (void)data;
+    (void)length;
+    into_state_t *state = ud;
+    state->pending = NULL;
+    return true;
+}
+
+static bool into_on_container_start(void *ud) {
+    into_state_t *state = ud;
+    state->pending = NULL;
+    state->depth++;
+    return true;
+}
+
+static bool into_on_container_end(void *ud) {
+    into_state_t *state = ud;
+    state->depth--;
+    return true;
+}
+
+static bool into_on_object_key(const char *key, size_t length, void *ud) {
+    into_state_t *state = ud;
+    state->pending = state->depth == 1 ? into_match(state, key, length) : NULL;
+    return true;
+}
+
+yay_error_t *yay_parse_into(const char *source, size_t length,
+                            const char *filename,
+                            const yay_field_t *fields, size_t field_count,
+                            void *out) {
+    into_state_t state = { fields, field_count, out, 0, NULL };
+    yay_callbacks_t callbacks = {
+        .on_null = into_on_null,
+        .on_bool = into_on_bool,
+        .on_int = into_on_int,
+        .on_float = into_on_float,
+        .on_string = into_on_string,
+        .on_bytes = into_on_bytes,
+        .on_array_start = into_on_container_start,
+        .on_array_end = into_on_container_end,
+        .on_object_start = into_on_container_start,
+        .on_object_end = into_on_container_end,
+        .on_object_key = into_on_object_key,
+    };
+    return yay_parse_events(source, length, filename, &callbacks, &state);
+}
+
+/* ============================================================================
+ * Batch Parsing
+ * ============================================================================ */
+
+typedef struct {
+    const yay_input_t *inputs;
+    size_t count;
+    yay_result_t *results;
+    size_t next;    /* claimed atomically by workers */
+} batch_state_t;
+
+static void batch_run(batch_state_t *state) {
+    for (;;) {
+        size_t i = __atomic_fetch_add(&state->next, 1, __ATOMIC_RELAXED);
+        if (i >= state->count) return;
+        const yay_input_t *input = &state->inputs[i];
+        if (input->arena) {
+            state->results[i] = yay_parse_arena(input->source, input->length,
+                                                input->filename, input->arena);
+        } else {
+            state->results[i] = yay_parse(input->source, input->length,
+                                          input->filename);
+        }
+    }
+}
+
+#if !defined(_WIN32)
+static void *batch_worker(void *arg) {
+    batch_run(arg);
+    return NULL;
+}
+#endif
+
+void yay_parse_batch(const yay_input_t *inputs, size_t count, int threads,
+                     yay_result_t *results) {
+    if (!inputs || !results || count == 0) return;
+
+    batch_state_t state = { inputs, count, results, 0 };
+
+#if !defined(_WIN32)
+    if (threads <= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (int)online : 1;
+    }
+    if ((size_t)threads > count) threads = (int)count;
+
+    pthread_t *pool = NULL;
+    int started = 0;
+    if (threads > 1) {
+        pool = mem_alloc((size_t)(threads - 1) * sizeof(pthread_t));
+        if (pool) {
+            while (started < threads - 1 &&
+                   pthread_create(&pool[started], NULL, batch_worker,
+                                  &state) == 0) {
+                started++;
+            }
+        }
+    }
+    /* The calling thread is always one of the workers */
+    batch_run(&state);
+    for (int i = 0; i < started; i++) {
+        pthread_join(pool[i], NULL);
+    }
+    mem_free(pool);
+#else
+    (void)threads;
+    batch_run(&state);
+#endif
+}
+
+/* A document whose top level is an outline array can be split at its item
+ * boundaries: every item starts with "- " at column zero, and every other
+ * line belonging to the array is indented, blank, or a comment. Records
+ * the byte offset of each item (the first item claims offset zero so any
+ * leading blank or comment lines stay with the first chunk) and returns
+ * the item count, or 0 if the document has some other shape. */
+static size_t parallel_split(const char *source, size_t length,
+                             size_t **offsets_out) {
+    size_t capacity = 64;
+    size_t count = 0;
+    size_t *offsets = mem_alloc(capacity * sizeof(size_t));
+    if (!offsets) return 0;
+
+    size_t i = 0;
+    if (length >= 3 && memcmp(source, "\xEF\xBB\xBF", 3) == 0) i = 3;
+
+    while (i < length) {
+        const char *eol = memchr(source + i, '\n', length - i);
+        size_t next = eol ? (size_t)(eol - source) + 1 : length;
+        char c = source[i];
+        if (c == '-' && i + 1 < length &&
+            (source[i + 1] == ' ' || source[i + 1] == '\n')) {
+            if (count >= capacity) {
+                capacity *= 2;
+                size_t *grown = mem_realloc(offsets, capacity * sizeof(size_t));
+                if (!grown) {
+                    mem_free(offsets);
+                    return 0;
                 }
-                default:
-                    ctx->error = make_error(ctx, line_num, col + i,
-                                           "Bad escaped character");
-                    free(out);
-                    return NULL;
+                offsets = grown;
             }
-        } else if ((unsigned char)c < 0x20) {
-            ctx->error = make_error(ctx, line_num, col + i,
-                                   "Bad character in string");
-            free(out);
-            return NULL;
-        } else {
-            out[out_len++] = c;
+            offsets[count] = count == 0 ? 0 : i;
+            count++;
+        } else if (count == 0 && c == ' ') {
+            /* Indented content before any item: not an array document */
+            mem_free(offsets);
+            return 0;
+        } else if (c != '\n' && c != '#' && c != ' ' && c != '\r') {
+            mem_free(offsets);
+            return 0;
         }
+        i = next;
     }
-    
-    out[out_len] = '\0';
-    yay_value_t *v = yay_string(out);
-    free(out);
-    return v;
+
+    if (count == 0) {
+        mem_free(offsets);
+        return 0;
+    }
+    *offsets_out = offsets;
+    return count;
 }
 
-static yay_value_t *parse_single_quoted_string(const char *s) {
-    size_t len = strlen(s);
-    if (len < 2 || s[0] != '\'' || s[len-1] != '\'') {
-        return yay_string(s);
+yay_result_t yay_parse_parallel(const char *source, size_t length,
+                                const char *filename, int threads) {
+    if (source && length == 0) length = strlen(source);
+
+#if !defined(_WIN32)
+    if (threads <= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (int)online : 1;
+    }
+
+    size_t *offsets = NULL;
+    size_t items = source && threads > 1
+        ? parallel_split(source, length, &offsets)
+        : 0;
+
+    if (items >= 2) {
+        size_t chunks = (size_t)threads < items ? (size_t)threads : items;
+        yay_input_t *inputs = mem_calloc(chunks, sizeof(yay_input_t));
+        yay_result_t *results = mem_calloc(chunks, sizeof(yay_result_t));
+        if (inputs && results) {
+            for (size_t c = 0; c < chunks; c++) {
+                size_t first = c * items / chunks;
+                size_t last = (c + 1) * items / chunks;
+                size_t begin = offsets[first];
+                size_t end = last < items ? offsets[last] : length;
+                inputs[c].source = source + begin;
+                inputs[c].length = end - begin;
+                inputs[c].filename = filename;
+            }
+            yay_parse_batch(inputs, chunks, (int)chunks, results);
+
+            bool ok = true;
+            size_t total = 0;
+            for (size_t c = 0; c < chunks; c++) {
+                if (results[c].error || !results[c].value ||
+                    results[c].value->type != YAY_ARRAY) {
+                    ok = false;
+                } else {
+                    total += results[c].value->data.array.length;
+                }
+            }
+
+            yay_value_t *spliced = NULL;
+            if (ok) {
+                spliced = yay_array();
+                yay_array_reserve(spliced, total);
+                for (size_t c = 0; c < chunks; c++) {
+                    yay_value_t *chunk = results[c].value;
+                    for (size_t k = 0; k < chunk->data.array.length; k++) {
+                        yay_array_push(spliced, chunk->data.array.items[k]);
+                    }
+                    /* Items moved into the spliced array; free the shell */
+                    chunk->data.array.length = 0;
+                    yay_free(chunk);
+                    results[c].value = NULL;
+                }
+            } else {
+                for (size_t c = 0; c < chunks; c++) {
+                    yay_result_free(&results[c]);
+                }
+            }
+
+            mem_free(inputs);
+            mem_free(results);
+            mem_free(offsets);
+            if (spliced) {
+                yay_result_t result = { spliced, NULL };
+                return result;
+            }
+            /* A chunk failed: re-parse sequentially so error positions
+             * refer to the whole document */
+            return yay_parse(source, length, filename);
+        }
+        mem_free(inputs);
+        mem_free(results);
     }
-    return yay_string_len(s + 1, len - 2);
+    mem_free(offsets);
+#else
+    (void)threads;
+#endif
+
+    return yay_parse(source, length, filename);
 }
 
 /* ============================================================================
- * Concatenated String Parsing
- * ============================================================================ */
-
-/**
- * Parse concatenated quoted strings (multiple quoted strings on consecutive lines).
- * Returns NULL if there's only one string (single string on new line is invalid).
+ * Incremental Reparse
+ * ============================================================================
+ *
+ * The outline structure localizes edits: every column-0 line starts a new
+ * top-level entry, and an edit confined to one entry cannot change how any
+ * other entry parses. yay_reparse exploits that by reparsing only the
+ * entry whose bytes changed and splicing the fresh subtree into a new root
+ * alongside clones of the untouched subtrees (a clone is a reference-count
+ * bump, not a copy). Anything that breaks the one-changed-entry invariant
+ * falls back to a full parse, which also keeps error positions exact.
  */
-static yay_value_t *parse_concatenated_strings(parse_ctx_t *ctx, size_t *idx, int base_indent) {
-    /* Collect all parts */
-    size_t parts_cap = 8;
-    size_t parts_count = 0;
-    char **parts = malloc(parts_cap * sizeof(char *));
-    size_t *part_lens = malloc(parts_cap * sizeof(size_t));
-    
-    while (*idx < ctx->token_count) {
-        token_t *t = &ctx->tokens[*idx];
-        
-        if (t->type == TOKEN_BREAK || t->type == TOKEN_STOP) {
-            (*idx)++;
+
+typedef struct {
+    size_t start;
+    size_t end;
+} entry_span_t;
+
+/* Split a document into top-level entry byte ranges. An entry begins at
+ * every column-0 line whose first character is not a space, comment, or
+ * line break; it runs to the start of the next entry. Returns false when
+ * the document has no such outline (content before the first entry). */
+static bool reparse_entries(const char *source, size_t length,
+                            entry_span_t **entries_out, size_t *count_out) {
+    entry_span_t *entries = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+    size_t i = 0;
+    /* BOM would have been rejected by scan; no need to skip one */
+    while (i < length) {
+        char c = source[i];
+        bool blank = c == ' ' || c == '\n' || c == '\r' || c == '#';
+        if (!blank) {
+            if (count == capacity) {
+                capacity = capacity ? capacity * 2 : 16;
+                entry_span_t *grown =
+                    mem_realloc(entries, capacity * sizeof(*entries));
+                if (!grown) {
+                    mem_free(entries);
+                    return false;
+                }
+                entries = grown;
+            }
+            if (count > 0) entries[count - 1].end = i;
+            entries[count].start = i;
+            entries[count].end = length;
+            count++;
+        } else if (count == 0 && c == ' ') {
+            /* Indented content before any entry: no usable outline */
+            const char *eol = memchr(source + i, '\n', length - i);
+            size_t line_end = eol ? (size_t)(eol - source) : length;
+            for (size_t j = i; j < line_end; j++) {
+                if (source[j] != ' ' && source[j] != '\r') {
+                    mem_free(entries);
+                    return false;
+                }
+            }
+        }
+        const char *newline = memchr(source + i, '\n', length - i);
+        if (!newline) break;
+        i = (size_t)(newline - source) + 1;
+    }
+    *entries_out = entries;
+    *count_out = count;
+    return true;
+}
+
+/* Splice attempt; returns false to request a full fallback parse */
+static bool reparse_splice(const yay_result_t *previous,
+                           const char *previous_source,
+                           size_t previous_length, const char *source,
+                           size_t length, const char *filename,
+                           yay_result_t *out) {
+    const yay_value_t *root = previous->value;
+    bool is_object = root->type == YAY_OBJECT;
+    size_t root_length = is_object ? root->data.object.length
+                                   : root->data.array.length;
+    if (root_length == 0) return false;
+
+    entry_span_t *old_entries = NULL;
+    entry_span_t *new_entries = NULL;
+    size_t old_count = 0;
+    size_t new_count = 0;
+    bool ok = false;
+    if (!reparse_entries(previous_source, previous_length, &old_entries,
+                         &old_count)) {
+        goto done;
+    }
+    if (!reparse_entries(source, length, &new_entries, &new_count)) {
+        goto done;
+    }
+    if (old_count != new_count || old_count != root_length) goto done;
+
+    /* Exactly one entry may differ */
+    size_t changed = old_count;
+    for (size_t i = 0; i < old_count; i++) {
+        size_t old_size = old_entries[i].end - old_entries[i].start;
+        size_t new_size = new_entries[i].end - new_entries[i].start;
+        if (old_size == new_size &&
+            memcmp(previous_source + old_entries[i].start,
+                   source + new_entries[i].start, old_size) == 0) {
             continue;
         }
-        
-        if (t->type != TOKEN_TEXT || t->indent < base_indent) {
-            break;
+        if (changed != old_count) goto done;
+        changed = i;
+    }
+    if (changed == old_count) {
+        /* Nothing changed structurally: the whole previous tree stands */
+        out->value = yay_clone((yay_value_t *)root);
+        out->error = NULL;
+        ok = true;
+        goto done;
+    }
+
+    /* Reparse the changed entry in isolation; it is a top-level fragment,
+     * so it is itself a complete document */
+    yay_result_t sub = yay_parse(source + new_entries[changed].start,
+                                 new_entries[changed].end -
+                                     new_entries[changed].start,
+                                 filename);
+    if (sub.error || !sub.value || sub.value->type != root->type) {
+        yay_result_free(&sub);
+        goto done;
+    }
+    size_t sub_length = is_object ? sub.value->data.object.length
+                                  : sub.value->data.array.length;
+    if (sub_length != 1) {
+        yay_result_free(&sub);
+        goto done;
+    }
+
+    if (is_object) {
+        /* A renamed key must not collide with an unchanged one */
+        const char *new_key = sub.value->data.object.pairs[0].key;
+        for (size_t i = 0; i < root_length; i++) {
+            if (i != changed &&
+                strcmp(root->data.object.pairs[i].key, new_key) == 0) {
+                yay_result_free(&sub);
+                goto done;
+            }
         }
-        
-        /* Trim leading spaces */
-        const char *trimmed = t->text;
-        while (*trimmed == ' ') trimmed++;
-        size_t trimmed_len = strlen(trimmed);
-        
-        /* Check if this line is a quoted string */
-        bool is_double_quoted = trimmed_len >= 2 && trimmed[0] == '"' && trimmed[trimmed_len-1] == '"';
-        bool is_single_quoted = trimmed_len >= 2 && trimmed[0] == '\'' && trimmed[trimmed_len-1] == '\'';
-        
-        if (!is_double_quoted && !is_single_quoted) {
-            break;
+        yay_value_t *object = yay_object();
+        yay_object_reserve(object, root_length);
+        for (size_t i = 0; i < root_length; i++) {
+            if (i == changed) {
+                yay_object_set(object, new_key,
+                               yay_clone(sub.value->data.object.pairs[0].value));
+            } else {
+                yay_object_set(object, root->data.object.pairs[i].key,
+                               yay_clone(root->data.object.pairs[i].value));
+            }
         }
-        
-        /* Parse the quoted string */
-        yay_value_t *parsed;
-        if (is_double_quoted) {
-            parsed = parse_double_quoted_string(ctx, trimmed, t->line_num, t->col);
-        } else {
-            parsed = parse_single_quoted_string(trimmed);
+        out->value = object;
+    } else {
+        yay_value_t *array = yay_array();
+        yay_array_reserve(array, root_length);
+        for (size_t i = 0; i < root_length; i++) {
+            yay_array_push(array,
+                           yay_clone(i == changed
+                                         ? sub.value->data.array.items[0]
+                                         : root->data.array.items[i]));
         }
-        
-        if (parsed == NULL) {
-            /* Error already set */
-            for (size_t i = 0; i < parts_count; i++) {
-                free(parts[i]);
+        out->value = array;
+    }
+    yay_result_free(&sub);
+    out->error = NULL;
+    ok = true;
+
+done:
+    mem_free(old_entries);
+    mem_free(new_entries);
+    return ok;
+}
+
+yay_result_t yay_reparse(const yay_result_t *previous,
+                         const char *previous_source, size_t previous_length,
+                         size_t edit_start, size_t edit_end,
+                         const char *new_text, size_t new_text_length,
+                         const char *filename) {
+    if (previous_length == 0 && previous_source) {
+        previous_length = strlen(previous_source);
+    }
+    if (new_text_length == 0 && new_text) {
+        new_text_length = strlen(new_text);
+    }
+    if (edit_end > previous_length) edit_end = previous_length;
+    if (edit_start > edit_end) edit_start = edit_end;
+
+    /* Compose the post-edit document */
+    size_t length =
+        previous_length - (edit_end - edit_start) + new_text_length;
+    char *source = mem_alloc(length + 1);
+    if (!source) {
+        yay_result_t result = {0};
+        return result;
+    }
+    if (edit_start) memcpy(source, previous_source, edit_start);
+    if (new_text_length) memcpy(source + edit_start, new_text, new_text_length);
+    if (previous_length > edit_end) {
+        memcpy(source + edit_start + new_text_length,
+               previous_source + edit_end, previous_length - edit_end);
+    }
+    source[length] = '\0';
+
+    yay_result_t result = {0};
+    bool spliced = previous && previous->value && !previous->error &&
+                   (previous->value->type == YAY_OBJECT ||
+                    previous->value->type == YAY_ARRAY) &&
+                   reparse_splice(previous, previous_source, previous_length,
+                                  source, length, filename, &result);
+    if (!spliced) {
+        result = yay_parse(source, length, filename);
+    }
+    mem_free(source);
+    return result;
+}
+
+/* ============================================================================
+ * Streaming Chunked Input
+ * ============================================================================
+ *
+ * A push-mode front end for network feeds: chunks arrive in any sizes, and
+ * every completed top-level entry (delimited by the next column-0 line, the
+ * same outline property yay_reparse relies on) is parsed and handed to the
+ * caller as soon as its last byte is in. Memory is bounded by the largest
+ * single entry, not the whole document. Error positions are rebased onto
+ * absolute document lines before they are reported.
+ */
+
+struct yay_stream {
+    char *filename;
+    yay_emit_t emit;
+    void *user_data;
+    char *buffer;          /* the current (incomplete) entry plus unscanned
+                              bytes of the next */
+    size_t length;
+    size_t capacity;
+    size_t scanned;        /* bytes of buffer already examined */
+    size_t line_offset;    /* absolute 0-based line number of buffer[0] */
+    bool at_line_start;    /* scanner state across feeds */
+    bool have_entry;       /* current segment contains an entry start */
+    bool emitted_any;
+    bool stopped;          /* the callback asked to stop */
+    yay_error_t *error;
+};
+
+yay_stream_t *yay_stream_create(const char *filename, yay_emit_t emit,
+                                void *user_data) {
+    yay_stream_t *stream = mem_calloc(1, sizeof(*stream));
+    if (!stream) return NULL;
+    stream->filename = filename ? str_dup(filename) : NULL;
+    stream->emit = emit;
+    stream->user_data = user_data;
+    stream->at_line_start = true;
+    return stream;
+}
+
+/* Parse buffer[0..entry_length) as a standalone document and emit its
+ * value. Returns false when the entry fails to parse or the callback asks
+ * to stop. */
+static bool stream_emit_entry(yay_stream_t *stream, size_t entry_length) {
+    size_t lines = count_newlines(stream->buffer, entry_length);
+    yay_result_t result = yay_parse(stream->buffer, entry_length, NULL);
+    if (result.error) {
+        /* Rebase the entry-relative position onto the whole feed; the
+         * message has not been rendered yet, so only the ingredients move */
+        yay_error_t *error = result.error;
+        yay_error_impl_t *impl = (yay_error_impl_t *)error;
+        result.error = NULL;
+        error->line = (int)stream->line_offset + error->line;
+        if (stream->filename) {
+            mem_free(impl->filename);
+            impl->filename = str_dup(stream->filename);
+            impl->located = true;
+        }
+        stream->error = error;
+        yay_result_free(&result);
+        return false;
+    }
+    stream->line_offset += lines;
+    stream->emitted_any = true;
+    if (!stream->emit) {
+        yay_free(result.value);
+        return true;
+    }
+    if (!stream->emit(result.value, stream->user_data)) {
+        stream->stopped = true;
+        return false;
+    }
+    return true;
+}
+
+/* Scan newly buffered bytes for entry boundaries, emitting every entry
+ * that is now complete */
+static bool stream_pump(yay_stream_t *stream) {
+    while (stream->scanned < stream->length) {
+        if (stream->at_line_start) {
+            char c = stream->buffer[stream->scanned];
+            bool blank = c == ' ' || c == '\n' || c == '\r' || c == '#';
+            if (!blank) {
+                if (stream->have_entry && stream->scanned > 0) {
+                    size_t entry_length = stream->scanned;
+                    if (!stream_emit_entry(stream, entry_length)) {
+                        return false;
+                    }
+                    memmove(stream->buffer, stream->buffer + entry_length,
+                            stream->length - entry_length);
+                    stream->length -= entry_length;
+                    stream->scanned = 0;
+                }
+                stream->have_entry = true;
             }
-            free(parts);
-            free(part_lens);
-            return NULL;
+            stream->at_line_start = false;
         }
-        
-        /* Store the parsed string */
-        if (parts_count >= parts_cap) {
-            parts_cap *= 2;
-            parts = realloc(parts, parts_cap * sizeof(char *));
-            part_lens = realloc(part_lens, parts_cap * sizeof(size_t));
+        const char *newline = memchr(stream->buffer + stream->scanned, '\n',
+                                     stream->length - stream->scanned);
+        if (!newline) {
+            stream->scanned = stream->length;
+            break;
         }
-        parts[parts_count] = str_dup(parsed->data.string);
-        part_lens[parts_count] = strlen(parsed->data.string);
-        parts_count++;
-        
-        yay_free(parsed);
-        (*idx)++;
+        stream->scanned = (size_t)(newline - stream->buffer) + 1;
+        stream->at_line_start = true;
     }
-    
-    /* Require at least 2 strings for concatenation */
-    /* A single string on a new line is invalid (use inline syntax instead) */
-    if (parts_count < 2) {
-        for (size_t i = 0; i < parts_count; i++) {
-            free(parts[i]);
+    return true;
+}
+
+bool yay_feed(yay_stream_t *stream, const char *chunk, size_t length) {
+    if (!stream || stream->error || stream->stopped) return false;
+    if (stream->length + length > stream->capacity) {
+        size_t capacity = stream->capacity ? stream->capacity : 4096;
+        while (stream->length + length > capacity) capacity *= 2;
+        char *grown = mem_realloc(stream->buffer, capacity);
+        if (!grown) return false;
+        stream->buffer = grown;
+        stream->capacity = capacity;
+    }
+    memcpy(stream->buffer + stream->length, chunk, length);
+    stream->length += length;
+    return stream_pump(stream);
+}
+
+yay_error_t *yay_finish(yay_stream_t *stream) {
+    if (!stream) return NULL;
+    if (!stream->error && !stream->stopped &&
+        (stream->length > 0 || !stream->emitted_any)) {
+        stream_emit_entry(stream, stream->length);
+    }
+    yay_error_t *error = stream->error;
+    mem_free(stream->filename);
+    mem_free(stream->buffer);
+    mem_free(stream);
+    return error;
+}
+
+/* ============================================================================
+ * CBOR Transcoding
+ * ============================================================================
+ *
+ * Both directions run at stream speed without materializing a value tree:
+ * yay_to_cbor drives the streaming event parser straight into a writer,
+ * and yay_from_cbor decodes CBOR into the same event callbacks the parser
+ * emits. Containers are encoded with indefinite lengths because an event
+ * stream does not know element counts up front; the decoder accepts both
+ * definite- and indefinite-length containers, so output round-trips and
+ * CBOR from other producers (including the Rust CLI) decodes fine.
+ * Integers beyond 64 bits use the standard bignum tags 2 and 3.
+ */
+
+/* Write a CBOR head: 3-bit major type plus minimally encoded argument */
+static void cbor_head(yay_writer_t *writer, uint8_t major, uint64_t value) {
+    uint8_t buf[9];
+    size_t n;
+    if (value < 24) {
+        buf[0] = (uint8_t)(major << 5 | value);
+        n = 1;
+    } else if (value <= UINT8_MAX) {
+        buf[0] = (uint8_t)(major << 5 | 24);
+        buf[1] = (uint8_t)value;
+        n = 2;
+    } else if (value <= UINT16_MAX) {
+        buf[0] = (uint8_t)(major << 5 | 25);
+        buf[1] = (uint8_t)(value >> 8);
+        buf[2] = (uint8_t)value;
+        n = 3;
+    } else if (value <= UINT32_MAX) {
+        buf[0] = (uint8_t)(major << 5 | 26);
+        for (int i = 0; i < 4; i++) {
+            buf[1 + i] = (uint8_t)(value >> (24 - 8 * i));
+        }
+        n = 5;
+    } else {
+        buf[0] = (uint8_t)(major << 5 | 27);
+        for (int i = 0; i < 8; i++) {
+            buf[1 + i] = (uint8_t)(value >> (56 - 8 * i));
         }
-        free(parts);
-        free(part_lens);
+        n = 9;
+    }
+    yay_writer_write(writer, (const char *)buf, n);
+}
+
+/* Decimal digit string -> big-endian magnitude bytes (malloc'd) */
+static uint8_t *cbor_decimal_to_bytes(const char *digits, size_t *length_out) {
+    size_t digit_count = strlen(digits);
+    char *work = mem_alloc(digit_count + 1);
+    /* Worst case: every ~2.4 decimal digits make one byte */
+    uint8_t *bytes = mem_alloc(digit_count / 2 + 2);
+    if (!work || !bytes) {
+        mem_free(work);
+        mem_free(bytes);
         return NULL;
     }
-    
-    /* Calculate total length */
-    size_t total_len = 0;
-    for (size_t i = 0; i < parts_count; i++) {
-        total_len += part_lens[i];
+    memcpy(work, digits, digit_count + 1);
+    size_t count = 0;
+    size_t start = 0;
+    while (start < digit_count) {
+        /* Long division of the decimal string by 256 */
+        unsigned remainder = 0;
+        for (size_t i = start; i < digit_count; i++) {
+            unsigned value = remainder * 10 + (unsigned)(work[i] - '0');
+            work[i] = (char)('0' + value / 256);
+            remainder = value % 256;
+        }
+        bytes[count++] = (uint8_t)remainder;
+        while (start < digit_count && work[start] == '0') start++;
+    }
+    if (count == 0) bytes[count++] = 0;
+    /* Remainders came out least significant first */
+    for (size_t i = 0; i < count / 2; i++) {
+        uint8_t tmp = bytes[i];
+        bytes[i] = bytes[count - 1 - i];
+        bytes[count - 1 - i] = tmp;
+    }
+    mem_free(work);
+    *length_out = count;
+    return bytes;
+}
+
+/* Big-endian magnitude bytes -> decimal digit string (malloc'd) */
+static char *cbor_bytes_to_decimal(const uint8_t *bytes, size_t length) {
+    /* Each byte contributes at most log10(256) ~ 2.41 decimal digits */
+    size_t capacity = length * 3 + 2;
+    char *digits = mem_alloc(capacity);
+    if (!digits) return NULL;
+    size_t count = 0;
+    digits[count++] = 0;
+    for (size_t i = 0; i < length; i++) {
+        /* digits = digits * 256 + byte, least significant digit first */
+        unsigned carry = bytes[i];
+        for (size_t j = 0; j < count; j++) {
+            unsigned value = (unsigned)digits[j] * 256 + carry;
+            digits[j] = (char)(value % 10);
+            carry = value / 10;
+        }
+        while (carry) {
+            digits[count++] = (char)(carry % 10);
+            carry /= 10;
+        }
     }
-    
-    /* Concatenate all parts */
-    char *result = malloc(total_len + 1);
-    size_t pos = 0;
-    for (size_t i = 0; i < parts_count; i++) {
-        memcpy(result + pos, parts[i], part_lens[i]);
-        pos += part_lens[i];
-        free(parts[i]);
+    while (count > 1 && digits[count - 1] == 0) count--;
+    for (size_t i = 0; i < count / 2; i++) {
+        char tmp = digits[i];
+        digits[i] = digits[count - 1 - i];
+        digits[count - 1 - i] = tmp;
     }
-    result[total_len] = '\0';
-    
-    free(parts);
-    free(part_lens);
-    
-    yay_value_t *val = yay_string_len(result, total_len);
-    free(result);
-    return val;
+    for (size_t i = 0; i < count; i++) digits[i] = (char)('0' + digits[i]);
+    digits[count] = '\0';
+    return digits;
+}
+
+/* Encoding callbacks: user_data is the destination writer */
+
+static bool cbor_on_null(void *ud) {
+    uint8_t byte = 0xf6;
+    yay_writer_write(ud, (const char *)&byte, 1);
+    return true;
+}
+
+static bool cbor_on_bool(bool value, void *ud) {
+    uint8_t byte = value ? 0xf5 : 0xf4;
+    yay_writer_write(ud, (const char *)&byte, 1);
+    return true;
+}
+
+static bool cbor_on_int(const char *digits, bool negative, void *ud) {
+    yay_writer_t *writer = ud;
+    /* Fits in the 64-bit head? (Negative range extends one further) */
+    uint64_t value = 0;
+    bool overflow = false;
+    for (const char *p = digits; *p; p++) {
+        if (value > (UINT64_MAX - (uint64_t)(*p - '0')) / 10) {
+            overflow = true;
+            break;
+        }
+        value = value * 10 + (uint64_t)(*p - '0');
+    }
+    if (!overflow) {
+        if (!negative) {
+            cbor_head(writer, 0, value);
+            return true;
+        }
+        if (value != 0) {
+            cbor_head(writer, 1, value - 1);
+            return true;
+        }
+        cbor_head(writer, 0, 0); /* -0 normalizes to 0 */
+        return true;
+    }
+    /* Bignum: tag 2 (positive) or 3 (negative, encoding magnitude - 1) */
+    size_t length = 0;
+    uint8_t *bytes = cbor_decimal_to_bytes(digits, &length);
+    if (!bytes) {
+        writer->failed = true;
+        return false;
+    }
+    if (negative) {
+        /* Subtract one from the big-endian magnitude */
+        size_t i = length;
+        while (i > 0 && bytes[--i] == 0) bytes[i] = 0xff;
+        bytes[i]--;
+        if (length > 1 && bytes[0] == 0) {
+            memmove(bytes, bytes + 1, --length);
+        }
+    }
+    cbor_head(writer, 6, negative ? 3 : 2);
+    cbor_head(writer, 2, length);
+    yay_writer_write(writer, (const char *)bytes, length);
+    mem_free(bytes);
+    return true;
+}
+
+static bool cbor_on_float(double value, void *ud) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint8_t buf[9];
+    buf[0] = 0xfb;
+    for (int i = 0; i < 8; i++) {
+        buf[1 + i] = (uint8_t)(bits >> (56 - 8 * i));
+    }
+    yay_writer_write(ud, (const char *)buf, 9);
+    return true;
+}
+
+static bool cbor_on_string(const char *str, size_t length, void *ud) {
+    cbor_head(ud, 3, length);
+    yay_writer_write(ud, str, length);
+    return true;
+}
+
+static bool cbor_on_bytes(const uint8_t *data, size_t length, void *ud) {
+    cbor_head(ud, 2, length);
+    yay_writer_write(ud, (const char *)data, length);
+    return true;
+}
+
+static bool cbor_on_array_start(void *ud) {
+    uint8_t byte = 0x9f;
+    yay_writer_write(ud, (const char *)&byte, 1);
+    return true;
+}
+
+static bool cbor_on_container_end(void *ud) {
+    uint8_t byte = 0xff;
+    yay_writer_write(ud, (const char *)&byte, 1);
+    return true;
+}
+
+static bool cbor_on_object_start(void *ud) {
+    uint8_t byte = 0xbf;
+    yay_writer_write(ud, (const char *)&byte, 1);
+    return true;
+}
+
+static bool cbor_on_object_key(const char *key, size_t length, void *ud) {
+    return cbor_on_string(key, length, ud);
+}
+
+yay_error_t *yay_to_cbor(const char *source, size_t length,
+                         const char *filename, yay_writer_t *writer) {
+    yay_callbacks_t callbacks = {
+        .on_null = cbor_on_null,
+        .on_bool = cbor_on_bool,
+        .on_int = cbor_on_int,
+        .on_float = cbor_on_float,
+        .on_string = cbor_on_string,
+        .on_bytes = cbor_on_bytes,
+        .on_array_start = cbor_on_array_start,
+        .on_array_end = cbor_on_container_end,
+        .on_object_start = cbor_on_object_start,
+        .on_object_key = cbor_on_object_key,
+        .on_object_end = cbor_on_container_end,
+    };
+    return yay_parse_events(source, length, filename, &callbacks, writer);
+}
+
+/* Decoder */
+
+typedef struct {
+    const uint8_t *data;
+    size_t length;
+    size_t offset;
+    const yay_callbacks_t *callbacks;
+    void *user_data;
+    bool aborted;       /* a callback asked to stop */
+    yay_error_t *error;
+} cbor_decoder_t;
+
+static yay_error_t *cbor_error(cbor_decoder_t *decoder, const char *fmt, ...) {
+    yay_error_t *err = error_alloc();
+    if (!err) return NULL;
+    char msg[256];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(msg, sizeof(msg), fmt, args);
+    va_end(args);
+    char full[320];
+    snprintf(full, sizeof(full), "%s at byte %zu", msg, decoder->offset);
+    err->message = str_dup(full);
+    err->line = 1;
+    err->column = (int)decoder->offset + 1;
+    return err;
+}
+
+static bool cbor_need(cbor_decoder_t *decoder, size_t count) {
+    if (decoder->length - decoder->offset >= count) return true;
+    decoder->error = cbor_error(decoder, "CBOR input truncated");
+    return false;
+}
+
+/* Read a head's argument; *indefinite is set for additional info 31 */
+static bool cbor_read_argument(cbor_decoder_t *decoder, uint8_t info,
+                               uint64_t *value, bool *indefinite) {
+    *indefinite = false;
+    if (info < 24) {
+        *value = info;
+        return true;
+    }
+    if (info == 31) {
+        *indefinite = true;
+        *value = 0;
+        return true;
+    }
+    if (info > 27) {
+        decoder->error = cbor_error(decoder, "Malformed CBOR head");
+        return false;
+    }
+    size_t count = (size_t)1 << (info - 24);
+    if (!cbor_need(decoder, count)) return false;
+    uint64_t v = 0;
+    for (size_t i = 0; i < count; i++) {
+        v = v << 8 | decoder->data[decoder->offset++];
+    }
+    *value = v;
+    return true;
 }
 
-/* ============================================================================
- * Block String Parsing
- * ============================================================================ */
+#define CBOR_EMIT(decoder, cb, ...) \
+    do { \
+        if ((decoder)->callbacks->cb && \
+            !(decoder)->callbacks->cb(__VA_ARGS__)) { \
+            (decoder)->aborted = true; \
+            return false; \
+        } \
+    } while (0)
 
-static yay_value_t *parse_block_string_impl(parse_ctx_t *ctx, size_t *idx, 
-                                             const char *first_line,
-                                             int base_indent) {
-    size_t i = *idx + 1;
-    bool is_property = (base_indent >= 0);
-    
-    /* Collect continuation lines */
-    size_t line_cap = 16;
-    size_t line_count = 0;
-    char **lines = malloc(line_cap * sizeof(char*));
-    int *indents = malloc(line_cap * sizeof(int));
-    
-    if (first_line && strlen(first_line) > 0) {
-        lines[line_count] = str_dup(first_line);
-        indents[line_count] = -1; /* Mark as first line */
-        line_count++;
-    }
-    
-    while (i < ctx->token_count && 
-           (ctx->tokens[i].type == TOKEN_TEXT || 
-            ctx->tokens[i].type == TOKEN_BREAK)) {
-        /* For property context, stop at lines at or below base indent */
-        if (is_property && ctx->tokens[i].type == TOKEN_TEXT &&
-            ctx->tokens[i].indent <= base_indent) {
-            break;
-        }
-        
-        if (line_count >= line_cap) {
-            line_cap *= 2;
-            lines = realloc(lines, line_cap * sizeof(char*));
-            indents = realloc(indents, line_cap * sizeof(int));
-        }
-        
-        if (ctx->tokens[i].type == TOKEN_BREAK) {
-            lines[line_count] = str_dup("");
-            indents[line_count] = -2; /* Mark as break */
+static bool cbor_decode_item(cbor_decoder_t *decoder);
+
+/* Decode one integer item, including bignum tags, and emit on_int */
+static bool cbor_emit_uint(cbor_decoder_t *decoder, uint64_t value,
+                           bool negative) {
+    char digits[24];
+    if (negative) {
+        /* CBOR encodes -1 - value; the magnitude is value + 1 */
+        if (value == UINT64_MAX) {
+            memcpy(digits, "18446744073709551616", 21);
         } else {
-            lines[line_count] = str_dup(ctx->tokens[i].text);
-            indents[line_count] = ctx->tokens[i].indent;
-        }
-        line_count++;
-        i++;
-    }
-    
-    *idx = i;
-    
-    /* Find minimum indent */
-    int min_indent = INT32_MAX;
-    for (size_t j = 0; j < line_count; j++) {
-        if (indents[j] >= 0 && indents[j] < min_indent) {
-            min_indent = indents[j];
+            digits[format_uint64(value + 1, digits)] = '\0';
         }
-    }
-    if (min_indent == INT32_MAX) min_indent = 0;
-    
-    /* Build result */
-    size_t result_cap = 256;
-    size_t result_len = 0;
-    char *result = malloc(result_cap);
-    result[0] = '\0';
-    
-    /* Leading newline if first_line was empty AND not a property */
-    bool leading_newline = (!first_line || strlen(first_line) == 0) && 
-                           line_count > 0 && !is_property;
-    
-    /* Skip leading empty lines */
-    size_t start = 0;
-    if (first_line && strlen(first_line) > 0) {
-        start = 0;
     } else {
-        while (start < line_count && strlen(lines[start]) == 0) start++;
+        digits[format_uint64(value, digits)] = '\0';
     }
-    
-    /* Skip trailing empty lines */
-    size_t end = line_count;
-    while (end > start && strlen(lines[end-1]) == 0) end--;
-    
-    if (leading_newline && end > start) {
-        result[result_len++] = '\n';
+    CBOR_EMIT(decoder, on_int, digits, negative, decoder->user_data);
+    return true;
+}
+
+static bool cbor_decode_bignum(cbor_decoder_t *decoder, bool negative) {
+    if (!cbor_need(decoder, 1)) return false;
+    uint8_t head = decoder->data[decoder->offset++];
+    if (head >> 5 != 2) {
+        decoder->error =
+            cbor_error(decoder, "CBOR bignum content must be a byte string");
+        return false;
     }
-    
-    for (size_t j = start; j < end; j++) {
-        if (j > start) {
-            result[result_len++] = '\n';
+    uint64_t length;
+    bool indefinite;
+    if (!cbor_read_argument(decoder, head & 0x1f, &length, &indefinite)) {
+        return false;
+    }
+    if (indefinite || !cbor_need(decoder, length)) {
+        if (indefinite) {
+            decoder->error =
+                cbor_error(decoder, "CBOR bignum content must be definite");
         }
-        
-        /* Add extra indent */
-        int extra = (indents[j] >= 0) ? indents[j] - min_indent : 0;
-        while (extra-- > 0) {
-            if (result_len + 1 >= result_cap) {
-                result_cap *= 2;
-                result = realloc(result, result_cap);
+        return false;
+    }
+    char *digits = cbor_bytes_to_decimal(decoder->data + decoder->offset,
+                                         (size_t)length);
+    decoder->offset += length;
+    if (!digits) return false;
+    if (negative) {
+        /* Tag 3 stores magnitude - 1: add one back in decimal */
+        size_t count = strlen(digits);
+        size_t i = count;
+        while (i > 0 && digits[i - 1] == '9') digits[--i] = '0';
+        if (i == 0) {
+            /* All nines: grow by one digit */
+            char *grown = mem_alloc(count + 2);
+            if (!grown) {
+                mem_free(digits);
+                return false;
             }
-            result[result_len++] = ' ';
-        }
-        
-        /* Add line content */
-        size_t line_len = strlen(lines[j]);
-        while (result_len + line_len + 1 >= result_cap) {
-            result_cap *= 2;
-            result = realloc(result, result_cap);
+            grown[0] = '1';
+            memcpy(grown + 1, digits, count + 1);
+            mem_free(digits);
+            digits = grown;
+        } else {
+            digits[i - 1]++;
         }
-        memcpy(result + result_len, lines[j], line_len);
-        result_len += line_len;
-    }
-    
-    /* Trailing newline */
-    if (end > start) {
-        result[result_len++] = '\n';
-    }
-    result[result_len] = '\0';
-    
-    /* Check for empty block string */
-    if (result_len == 0) {
-        /* Cleanup */
-        for (size_t j = 0; j < line_count; j++) {
-            free(lines[j]);
-        }
-        free(lines);
-        free(indents);
-        free(result);
-        ctx->error = calloc(1, sizeof(yay_error_t));
-        ctx->error->message = str_dup("Empty block string not allowed (use \"\" or \"\\n\" explicitly)");
-        return NULL;
     }
-    
-    /* Cleanup */
-    for (size_t j = 0; j < line_count; j++) {
-        free(lines[j]);
+    bool zero = strcmp(digits, "0") == 0;
+    bool ok = true;
+    if (decoder->callbacks->on_int &&
+        !decoder->callbacks->on_int(digits, negative && !zero,
+                                    decoder->user_data)) {
+        decoder->aborted = true;
+        ok = false;
     }
-    free(lines);
-    free(indents);
-    
-    yay_value_t *v = yay_string(result);
-    free(result);
-    return v;
-}
-
-/* Wrapper for standalone block strings */
-static yay_value_t *parse_block_string(parse_ctx_t *ctx, size_t *idx, 
-                                        const char *first_line) {
-    return parse_block_string_impl(ctx, idx, first_line, -1);
-}
-
-/* Wrapper for property block strings (with base indent) */
-static yay_value_t *parse_property_block_string_indent(parse_ctx_t *ctx, size_t *idx, 
-                                                        const char *first_line,
-                                                        int base_indent) {
-    return parse_block_string_impl(ctx, idx, first_line, base_indent);
+    mem_free(digits);
+    return ok;
 }
 
-/* ============================================================================
- * Block Bytes Parsing (> hex)
- * ============================================================================ */
-
-/* Parse block bytes starting with > */
-static yay_value_t *parse_block_bytes(parse_ctx_t *ctx, size_t *idx) {
-    token_t *t = &ctx->tokens[*idx];
-    const char *s = t->text;
-    int base_indent = t->indent;
-    
-    /* Extract hex from first line (after >) */
-    const char *hex_start = s + 1;
-    int hex_col_offset = 1;
-    if (*hex_start == ' ') {
-        hex_start++;
-        hex_col_offset = 2;
+static bool cbor_decode_container(cbor_decoder_t *decoder, bool map,
+                                  uint64_t count, bool indefinite) {
+    if (map) {
+        CBOR_EMIT(decoder, on_object_start, decoder->user_data);
+    } else {
+        CBOR_EMIT(decoder, on_array_start, decoder->user_data);
+    }
+    for (uint64_t i = 0; indefinite || i < count; i++) {
+        if (indefinite) {
+            if (!cbor_need(decoder, 1)) return false;
+            if (decoder->data[decoder->offset] == 0xff) {
+                decoder->offset++;
+                break;
+            }
+        }
+        if (map) {
+            if (!cbor_need(decoder, 1)) return false;
+            if (decoder->data[decoder->offset] >> 5 != 3) {
+                decoder->error = cbor_error(
+                    decoder, "CBOR map key must be a text string");
+                return false;
+            }
+            uint8_t head = decoder->data[decoder->offset++];
+            uint64_t length;
+            bool key_indefinite;
+            if (!cbor_read_argument(decoder, head & 0x1f, &length,
+                                    &key_indefinite)) {
+                return false;
+            }
+            if (key_indefinite || !cbor_need(decoder, length)) {
+                if (key_indefinite) {
+                    decoder->error = cbor_error(
+                        decoder, "CBOR map key must be definite");
+                }
+                return false;
+            }
+            CBOR_EMIT(decoder, on_object_key,
+                      (const char *)decoder->data + decoder->offset,
+                      (size_t)length, decoder->user_data);
+            decoder->offset += length;
+        }
+        if (!cbor_decode_item(decoder)) return false;
     }
-    
-    /* Strip comment */
-    char *first_hex = str_dup(hex_start);
-    char *comment = strchr(first_hex, '#');
-    if (comment) *comment = '\0';
-    
-    /* Trim whitespace from first_hex */
-    char *trimmed = first_hex;
-    while (*trimmed == ' ') trimmed++;
-    size_t trimmed_len = strlen(trimmed);
-    while (trimmed_len > 0 && trimmed[trimmed_len - 1] == ' ') {
-        trimmed[--trimmed_len] = '\0';
+    if (map) {
+        CBOR_EMIT(decoder, on_object_end, decoder->user_data);
+    } else {
+        CBOR_EMIT(decoder, on_array_end, decoder->user_data);
     }
-    
-    /* Check for empty leader (just ">" with no hex or comment) */
-    if (*trimmed == '\0' && comment == NULL) {
-        ctx->error = calloc(1, sizeof(yay_error_t));
-        ctx->error->message = str_dup("Expected hex or comment in hex block");
-        free(first_hex);
-        return NULL;
+    return true;
+}
+
+static bool cbor_decode_item(cbor_decoder_t *decoder) {
+    if (!cbor_need(decoder, 1)) return false;
+    uint8_t head = decoder->data[decoder->offset++];
+    uint8_t major = head >> 5;
+    uint64_t value;
+    bool indefinite;
+    if (!cbor_read_argument(decoder, head & 0x1f, &value, &indefinite)) {
+        return false;
     }
-    
-    size_t hex_cap = 256;
-    size_t hex_len = 0;
-    char *hex = malloc(hex_cap);
-    
-    /* Add hex from first line, checking for uppercase */
-    for (char *p = first_hex; *p; p++) {
-        if (*p != ' ') {
-            if (is_uppercase_hex(*p)) {
-                ctx->error = make_error(ctx, t->line_num, t->col + hex_col_offset + (int)(p - first_hex),
-                                       "Uppercase hex digit (use lowercase)");
-                free(first_hex);
-                free(hex);
-                return NULL;
+
+    switch (major) {
+        case 0:
+            return cbor_emit_uint(decoder, value, false);
+        case 1:
+            return cbor_emit_uint(decoder, value, true);
+        case 2:
+        case 3: {
+            if (indefinite) {
+                decoder->error = cbor_error(
+                    decoder, "Indefinite CBOR strings are not supported");
+                return false;
             }
-            if (hex_len >= hex_cap - 1) {
-                hex_cap *= 2;
-                hex = realloc(hex, hex_cap);
+            if (!cbor_need(decoder, value)) return false;
+            if (major == 3) {
+                CBOR_EMIT(decoder, on_string,
+                          (const char *)decoder->data + decoder->offset,
+                          (size_t)value, decoder->user_data);
+            } else {
+                CBOR_EMIT(decoder, on_bytes,
+                          decoder->data + decoder->offset, (size_t)value,
+                          decoder->user_data);
             }
-            hex[hex_len++] = *p;
+            decoder->offset += value;
+            return true;
         }
-    }
-    free(first_hex);
-    
-    (*idx)++;
-    
-    /* Collect continuation lines */
-    while (*idx < ctx->token_count && 
-           ctx->tokens[*idx].type == TOKEN_TEXT &&
-           ctx->tokens[*idx].indent > base_indent) {
-        token_t *line_tok = &ctx->tokens[*idx];
-        char *line = str_dup(line_tok->text);
-        char *line_comment = strchr(line, '#');
-        if (line_comment) *line_comment = '\0';
-        
-        for (char *p = line; *p; p++) {
-            if (*p != ' ') {
-                if (is_uppercase_hex(*p)) {
-                    ctx->error = make_error(ctx, line_tok->line_num, line_tok->col + (int)(p - line),
-                                           "Uppercase hex digit (use lowercase)");
-                    free(line);
-                    free(hex);
-                    return NULL;
+        case 4:
+            return cbor_decode_container(decoder, false, value, indefinite);
+        case 5:
+            return cbor_decode_container(decoder, true, value, indefinite);
+        case 6:
+            if (value == 2 || value == 3) {
+                return cbor_decode_bignum(decoder, value == 3);
+            }
+            decoder->error = cbor_error(
+                decoder, "CBOR tagged value (tag %llu) has no YAY equivalent",
+                (unsigned long long)value);
+            return false;
+        case 7:
+            switch (head & 0x1f) {
+                case 20:
+                    CBOR_EMIT(decoder, on_bool, false, decoder->user_data);
+                    return true;
+                case 21:
+                    CBOR_EMIT(decoder, on_bool, true, decoder->user_data);
+                    return true;
+                case 22:
+                    CBOR_EMIT(decoder, on_null, decoder->user_data);
+                    return true;
+                case 25: { /* half precision */
+                    uint16_t h = (uint16_t)value;
+                    unsigned exponent = (h >> 10) & 0x1f;
+                    unsigned mantissa = h & 0x3ff;
+                    double d;
+                    if (exponent == 0) {
+                        d = ldexp(mantissa, -24);
+                    } else if (exponent != 31) {
+                        d = ldexp(mantissa + 1024, (int)exponent - 25);
+                    } else {
+                        d = mantissa ? NAN : INFINITY;
+                    }
+                    if (h & 0x8000) d = -d;
+                    CBOR_EMIT(decoder, on_float, d, decoder->user_data);
+                    return true;
                 }
-                if (hex_len >= hex_cap - 1) {
-                    hex_cap *= 2;
-                    hex = realloc(hex, hex_cap);
+                case 26: { /* single precision */
+                    uint32_t bits = (uint32_t)value;
+                    float f;
+                    memcpy(&f, &bits, sizeof(f));
+                    CBOR_EMIT(decoder, on_float, (double)f,
+                              decoder->user_data);
+                    return true;
                 }
-                hex[hex_len++] = *p;
+                case 27: { /* double precision */
+                    double d;
+                    memcpy(&d, &value, sizeof(d));
+                    CBOR_EMIT(decoder, on_float, d, decoder->user_data);
+                    return true;
+                }
+                default:
+                    decoder->error = cbor_error(
+                        decoder, "CBOR simple value %u has no YAY equivalent",
+                        (unsigned)(head & 0x1f));
+                    return false;
             }
+    }
+    decoder->error = cbor_error(decoder, "Malformed CBOR item");
+    return false;
+}
+
+yay_error_t *yay_from_cbor(const uint8_t *data, size_t length,
+                           const yay_callbacks_t *callbacks,
+                           void *user_data) {
+    static const yay_callbacks_t no_callbacks = {0};
+    cbor_decoder_t decoder = {
+        data, length, 0, callbacks ? callbacks : &no_callbacks, user_data,
+        false, NULL,
+    };
+    if (!cbor_decode_item(&decoder)) {
+        if (decoder.aborted) return NULL;
+        if (!decoder.error) {
+            decoder.error = cbor_error(&decoder, "CBOR decode failed");
         }
-        free(line);
-        (*idx)++;
+        return decoder.error;
     }
-    
-    hex[hex_len] = '\0';
-    
-    if (hex_len % 2 != 0) {
-        ctx->error = make_error(ctx, t->line_num, t->col,
-                               "Odd number of hex digits in byte literal");
-        free(hex);
-        return NULL;
+    if (decoder.offset != decoder.length) {
+        return cbor_error(&decoder, "Trailing bytes after CBOR item");
     }
-    
-    yay_value_t *v = yay_bytes_from_hex(hex);
-    free(hex);
-    return v;
+    return NULL;
 }
 
-/* Parse block bytes in property context (key: > hex) */
-static yay_value_t *parse_property_block_bytes(parse_ctx_t *ctx, size_t *idx, 
-                                                const char *v_part) {
-    token_t *t = &ctx->tokens[*idx];
-    int base_indent = t->indent;
-    
-    /* Extract hex from first line (after >) */
-    const char *hex_start = v_part + 1;
-    if (*hex_start == ' ') hex_start++;
-    
-    /* Strip comment */
-    char *first_hex = str_dup(hex_start);
-    char *comment = strchr(first_hex, '#');
-    if (comment) *comment = '\0';
-    
-    size_t hex_cap = 256;
-    size_t hex_len = 0;
-    char *hex = malloc(hex_cap);
-    
-    /* Add hex from first line */
-    for (char *p = first_hex; *p; p++) {
-        if (*p != ' ') {
-            if (hex_len >= hex_cap - 1) {
-                hex_cap *= 2;
-                hex = realloc(hex, hex_cap);
+/* ============================================================================
+ * JSON Transcoding
+ * ============================================================================
+ *
+ * yay_from_json_events decodes JSON into the same event callbacks the
+ * parser emits, so everything built on events — tree building, schema
+ * decoding, CBOR or YAY output — consumes JSON unchanged. Strings free
+ * of escapes are reported as slices borrowed from the source, so
+ * string-dense archives decode without per-scalar copies. yay_from_json
+ * builds a value tree through the ordinary constructors (and therefore
+ * honors arenas), and yay_json_to_yay streams decode events straight
+ * into a writer in yay_encode's output format, so JSON-to-YAY migration
+ * never materializes a tree.
+ */
+
+#define JSON_MAX_DEPTH 512
+
+typedef struct {
+    const char *data;
+    size_t length;
+    size_t offset;
+    const yay_callbacks_t *callbacks;
+    void *user_data;
+    size_t depth;
+    bool aborted;       /* a callback asked to stop */
+    yay_error_t *error;
+} json_decoder_t;
+
+static yay_error_t *json_error(json_decoder_t *decoder, const char *fmt, ...) {
+    yay_error_t *err = error_alloc();
+    if (!err) return NULL;
+    char msg[256];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(msg, sizeof(msg), fmt, args);
+    va_end(args);
+    int line = 1, column = 1;
+    for (size_t i = 0; i < decoder->offset && i < decoder->length; i++) {
+        if (decoder->data[i] == '\n') {
+            line++;
+            column = 1;
+        } else {
+            column++;
+        }
+    }
+    char full[320];
+    snprintf(full, sizeof(full), "%s at %d:%d", msg, line, column);
+    err->message = str_dup(full);
+    err->line = line;
+    err->column = column;
+    return err;
+}
+
+#define JSON_EMIT(decoder, cb, ...) \
+    do { \
+        if ((decoder)->callbacks->cb && \
+            !(decoder)->callbacks->cb(__VA_ARGS__)) { \
+            (decoder)->aborted = true; \
+            return false; \
+        } \
+    } while (0)
+
+static void json_skip_ws(json_decoder_t *decoder) {
+    while (decoder->offset < decoder->length) {
+        char c = decoder->data[decoder->offset];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') break;
+        decoder->offset++;
+    }
+}
+
+static bool json_literal(json_decoder_t *decoder, const char *word,
+                         size_t word_length) {
+    if (decoder->length - decoder->offset < word_length ||
+        memcmp(decoder->data + decoder->offset, word, word_length) != 0) {
+        decoder->error = json_error(decoder, "Invalid JSON value");
+        return false;
+    }
+    decoder->offset += word_length;
+    return true;
+}
+
+/* Append a code point to a growable UTF-8 buffer */
+static bool json_append_utf8(char **buffer, size_t *used, size_t *capacity,
+                             uint32_t cp) {
+    if (*used + 4 > *capacity) {
+        size_t grown = *capacity * 2 + 16;
+        char *data = mem_realloc(*buffer, grown);
+        if (!data) return false;
+        *buffer = data;
+        *capacity = grown;
+    }
+    char *out = *buffer + *used;
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        *used += 1;
+    } else if (cp < 0x800) {
+        out[0] = (char)(0xC0 | cp >> 6);
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        *used += 2;
+    } else if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | cp >> 12);
+        out[1] = (char)(0x80 | (cp >> 6 & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        *used += 3;
+    } else {
+        out[0] = (char)(0xF0 | cp >> 18);
+        out[1] = (char)(0x80 | (cp >> 12 & 0x3F));
+        out[2] = (char)(0x80 | (cp >> 6 & 0x3F));
+        out[3] = (char)(0x80 | (cp & 0x3F));
+        *used += 4;
+    }
+    return true;
+}
+
+/* Read the four hex digits of a \u escape */
+static bool json_hex4(json_decoder_t *decoder, uint32_t *out) {
+    if (decoder->length - decoder->offset < 4) {
+        decoder->error = json_error(decoder, "Bad JSON unicode escape");
+        return false;
+    }
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = decoder->data[decoder->offset + i];
+        uint32_t nibble;
+        if (c >= '0' && c <= '9') nibble = (uint32_t)(c - '0');
+        else if (c >= 'a' && c <= 'f') nibble = (uint32_t)(c - 'a') + 10;
+        else if (c >= 'A' && c <= 'F') nibble = (uint32_t)(c - 'A') + 10;
+        else {
+            decoder->error = json_error(decoder, "Bad JSON unicode escape");
+            return false;
+        }
+        value = value << 4 | nibble;
+    }
+    decoder->offset += 4;
+    *out = value;
+    return true;
+}
+
+/* Decode a string, emitting on_object_key or on_string. Escape-free
+ * strings are emitted as borrowed slices of the source. */
+static bool json_decode_string(json_decoder_t *decoder, bool is_key) {
+    decoder->offset++; /* opening quote */
+    size_t start = decoder->offset;
+
+    /* Fast path: scan for the closing quote with no escapes */
+    while (decoder->offset < decoder->length) {
+        unsigned char c = (unsigned char)decoder->data[decoder->offset];
+        if (c == '"') {
+            const char *str = decoder->data + start;
+            size_t str_length = decoder->offset - start;
+            decoder->offset++;
+            if (is_key) {
+                JSON_EMIT(decoder, on_object_key, str, str_length,
+                          decoder->user_data);
+            } else {
+                JSON_EMIT(decoder, on_string, str, str_length,
+                          decoder->user_data);
             }
-            hex[hex_len++] = tolower(*p);
+            return true;
         }
+        if (c == '\\') break;
+        if (c < 0x20) {
+            decoder->error =
+                json_error(decoder, "Control character in JSON string");
+            return false;
+        }
+        decoder->offset++;
     }
-    free(first_hex);
-    
-    (*idx)++;
-    
-    /* Collect continuation lines */
-    while (*idx < ctx->token_count && 
-           ctx->tokens[*idx].type == TOKEN_TEXT &&
-           ctx->tokens[*idx].indent > base_indent) {
-        char *line = str_dup(ctx->tokens[*idx].text);
-        char *line_comment = strchr(line, '#');
-        if (line_comment) *line_comment = '\0';
-        
-        for (char *p = line; *p; p++) {
-            if (*p != ' ') {
-                if (hex_len >= hex_cap - 1) {
-                    hex_cap *= 2;
-                    hex = realloc(hex, hex_cap);
-                }
-                hex[hex_len++] = tolower(*p);
+    if (decoder->offset >= decoder->length) {
+        decoder->error = json_error(decoder, "Unterminated JSON string");
+        return false;
+    }
+
+    /* Slow path: copy the clean prefix, then unescape */
+    size_t used = decoder->offset - start;
+    size_t capacity = used + 16;
+    char *buffer = mem_alloc(capacity);
+    if (!buffer) return false;
+    memcpy(buffer, decoder->data + start, used);
+
+    while (decoder->offset < decoder->length &&
+           decoder->data[decoder->offset] != '"') {
+        unsigned char c = (unsigned char)decoder->data[decoder->offset];
+        uint32_t cp;
+        if (c == '\\') {
+            decoder->offset++;
+            if (decoder->offset >= decoder->length) break;
+            char esc = decoder->data[decoder->offset++];
+            switch (esc) {
+                case '"': cp = '"'; break;
+                case '\\': cp = '\\'; break;
+                case '/': cp = '/'; break;
+                case 'b': cp = '\b'; break;
+                case 'f': cp = '\f'; break;
+                case 'n': cp = '\n'; break;
+                case 'r': cp = '\r'; break;
+                case 't': cp = '\t'; break;
+                case 'u':
+                    if (!json_hex4(decoder, &cp)) {
+                        mem_free(buffer);
+                        return false;
+                    }
+                    if (cp >= 0xD800 && cp <= 0xDBFF) {
+                        /* High surrogate: pair with the following \u */
+                        uint32_t low;
+                        if (decoder->length - decoder->offset < 2 ||
+                            decoder->data[decoder->offset] != '\\' ||
+                            decoder->data[decoder->offset + 1] != 'u') {
+                            decoder->error = json_error(
+                                decoder, "Unpaired JSON surrogate");
+                            mem_free(buffer);
+                            return false;
+                        }
+                        decoder->offset += 2;
+                        if (!json_hex4(decoder, &low)) {
+                            mem_free(buffer);
+                            return false;
+                        }
+                        if (low < 0xDC00 || low > 0xDFFF) {
+                            decoder->error = json_error(
+                                decoder, "Unpaired JSON surrogate");
+                            mem_free(buffer);
+                            return false;
+                        }
+                        cp = 0x10000 +
+                             ((cp - 0xD800) << 10 | (low - 0xDC00));
+                    } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                        decoder->error =
+                            json_error(decoder, "Unpaired JSON surrogate");
+                        mem_free(buffer);
+                        return false;
+                    }
+                    break;
+                default:
+                    decoder->error =
+                        json_error(decoder, "Bad JSON escape '\\%c'", esc);
+                    mem_free(buffer);
+                    return false;
             }
+        } else if (c < 0x20) {
+            decoder->error =
+                json_error(decoder, "Control character in JSON string");
+            mem_free(buffer);
+            return false;
+        } else {
+            cp = c;
+            decoder->offset++;
+        }
+        if (!json_append_utf8(&buffer, &used, &capacity, cp)) {
+            mem_free(buffer);
+            return false;
         }
-        free(line);
-        (*idx)++;
     }
-    
-    hex[hex_len] = '\0';
-    
-    if (hex_len % 2 != 0) {
-        ctx->error = make_error(ctx, t->line_num, t->col,
-                               "Odd number of hex digits in byte literal");
-        free(hex);
-        return NULL;
+    if (decoder->offset >= decoder->length) {
+        decoder->error = json_error(decoder, "Unterminated JSON string");
+        mem_free(buffer);
+        return false;
     }
-    
-    yay_value_t *v = yay_bytes_from_hex(hex);
-    free(hex);
-    return v;
+    decoder->offset++; /* closing quote */
+
+    bool keep;
+    if (is_key) {
+        keep = !decoder->callbacks->on_object_key ||
+               decoder->callbacks->on_object_key(buffer, used,
+                                                 decoder->user_data);
+    } else {
+        keep = !decoder->callbacks->on_string ||
+               decoder->callbacks->on_string(buffer, used,
+                                             decoder->user_data);
+    }
+    mem_free(buffer);
+    if (!keep) {
+        decoder->aborted = true;
+        return false;
+    }
+    return true;
 }
 
-/* ============================================================================
- * Inline Syntax Validation
- * ============================================================================ */
+static bool json_decode_number(json_decoder_t *decoder) {
+    size_t start = decoder->offset;
+    bool negative = false;
+    if (decoder->data[decoder->offset] == '-') {
+        negative = true;
+        decoder->offset++;
+    }
+    size_t digits_start = decoder->offset;
+    while (decoder->offset < decoder->length &&
+           decoder->data[decoder->offset] >= '0' &&
+           decoder->data[decoder->offset] <= '9') {
+        decoder->offset++;
+    }
+    size_t digits_length = decoder->offset - digits_start;
+    if (digits_length == 0 ||
+        (digits_length > 1 && decoder->data[digits_start] == '0')) {
+        decoder->error = json_error(decoder, "Invalid JSON number");
+        return false;
+    }
 
-/* Validate inline array/object syntax for whitespace rules.
- * Returns true if valid, false and sets error if invalid.
- * Rules:
- * - No space after [ or {
- * - No space before ] or }
- * - No space before ,
- * - Exactly one space after , (unless followed by ] or })
- * - No tabs
- * - Exactly one space after : in objects
- * - No space before : in objects
- */
-static bool validate_inline_syntax(parse_ctx_t *ctx, const char *s, 
-                                   int line_num, int col) {
-    bool in_string = false;
-    char string_char = 0;
-    bool escape = false;
-    int depth_bracket = 0;
-    int depth_brace = 0;
-    
-    for (int i = 0; s[i]; i++) {
-        char c = s[i];
-        
-        /* Handle escape sequences in strings */
-        if (escape) {
-            escape = false;
-            continue;
+    bool is_float = false;
+    if (decoder->offset < decoder->length &&
+        decoder->data[decoder->offset] == '.') {
+        is_float = true;
+        decoder->offset++;
+        size_t frac_start = decoder->offset;
+        while (decoder->offset < decoder->length &&
+               decoder->data[decoder->offset] >= '0' &&
+               decoder->data[decoder->offset] <= '9') {
+            decoder->offset++;
         }
-        
-        /* Handle strings */
-        if (in_string) {
-            if (c == '\\') {
-                escape = true;
-            } else if (c == string_char) {
-                in_string = false;
-                string_char = 0;
-            }
-            continue;
+        if (decoder->offset == frac_start) {
+            decoder->error = json_error(decoder, "Invalid JSON number");
+            return false;
         }
-        
-        if (c == '"' || c == '\'') {
-            in_string = true;
-            string_char = c;
-            continue;
+    }
+    if (decoder->offset < decoder->length &&
+        (decoder->data[decoder->offset] == 'e' ||
+         decoder->data[decoder->offset] == 'E')) {
+        is_float = true;
+        decoder->offset++;
+        if (decoder->offset < decoder->length &&
+            (decoder->data[decoder->offset] == '+' ||
+             decoder->data[decoder->offset] == '-')) {
+            decoder->offset++;
         }
-        
-        /* Check for newlines */
-        if (c == '\n') {
-            if (depth_bracket > 0) {
-                ctx->error = make_error(ctx, line_num, col, 
-                                       "Unexpected newline in inline array");
+        size_t exp_start = decoder->offset;
+        while (decoder->offset < decoder->length &&
+               decoder->data[decoder->offset] >= '0' &&
+               decoder->data[decoder->offset] <= '9') {
+            decoder->offset++;
+        }
+        if (decoder->offset == exp_start) {
+            decoder->error = json_error(decoder, "Invalid JSON number");
+            return false;
+        }
+    }
+
+    /* The token needs NUL termination for strtod / on_int */
+    char inline_buf[32];
+    size_t token_length =
+        is_float ? decoder->offset - start : digits_length;
+    size_t token_start = is_float ? start : digits_start;
+    char *token = inline_buf;
+    if (token_length + 1 > sizeof(inline_buf)) {
+        token = mem_alloc(token_length + 1);
+        if (!token) return false;
+    }
+    memcpy(token, decoder->data + token_start, token_length);
+    token[token_length] = '\0';
+
+    bool keep = true;
+    if (is_float) {
+        double value = strtod(token, NULL);
+        keep = !decoder->callbacks->on_float ||
+               decoder->callbacks->on_float(value, decoder->user_data);
+    } else {
+        keep = !decoder->callbacks->on_int ||
+               decoder->callbacks->on_int(token, negative,
+                                          decoder->user_data);
+    }
+    if (token != inline_buf) mem_free(token);
+    if (!keep) {
+        decoder->aborted = true;
+        return false;
+    }
+    return true;
+}
+
+static bool json_decode_value(json_decoder_t *decoder);
+
+static bool json_decode_array(json_decoder_t *decoder) {
+    decoder->offset++; /* '[' */
+    if (++decoder->depth > JSON_MAX_DEPTH) {
+        decoder->error = json_error(decoder, "JSON nesting too deep");
+        return false;
+    }
+    JSON_EMIT(decoder, on_array_start, decoder->user_data);
+    json_skip_ws(decoder);
+    if (decoder->offset < decoder->length &&
+        decoder->data[decoder->offset] == ']') {
+        decoder->offset++;
+    } else {
+        for (;;) {
+            if (!json_decode_value(decoder)) return false;
+            json_skip_ws(decoder);
+            if (decoder->offset >= decoder->length) {
+                decoder->error =
+                    json_error(decoder, "Unterminated JSON array");
                 return false;
             }
-            if (depth_brace > 0) {
-                ctx->error = make_error(ctx, line_num, col, 
-                                       "Unexpected newline in inline object");
+            char c = decoder->data[decoder->offset++];
+            if (c == ']') break;
+            if (c != ',') {
+                decoder->offset--;
+                decoder->error =
+                    json_error(decoder, "Expected ',' or ']' in JSON array");
                 return false;
             }
-            continue;
         }
-        
-        /* Check [ */
-        if (c == '[') {
-            depth_bracket++;
-            if (s[i+1] == ' ') {
-                ctx->error = make_error(ctx, line_num, col + i + 1, 
-                                       "Unexpected space after \"[\"");
+    }
+    JSON_EMIT(decoder, on_array_end, decoder->user_data);
+    decoder->depth--;
+    return true;
+}
+
+static bool json_decode_object(json_decoder_t *decoder) {
+    decoder->offset++; /* '{' */
+    if (++decoder->depth > JSON_MAX_DEPTH) {
+        decoder->error = json_error(decoder, "JSON nesting too deep");
+        return false;
+    }
+    JSON_EMIT(decoder, on_object_start, decoder->user_data);
+    json_skip_ws(decoder);
+    if (decoder->offset < decoder->length &&
+        decoder->data[decoder->offset] == '}') {
+        decoder->offset++;
+    } else {
+        for (;;) {
+            json_skip_ws(decoder);
+            if (decoder->offset >= decoder->length ||
+                decoder->data[decoder->offset] != '"') {
+                decoder->error =
+                    json_error(decoder, "Expected JSON object key");
                 return false;
             }
-            continue;
-        }
-        
-        /* Check ] */
-        if (c == ']') {
-            if (i > 0 && s[i-1] == ' ') {
-                ctx->error = make_error(ctx, line_num, col + i - 1, 
-                                       "Unexpected space before \"]\"");
+            if (!json_decode_string(decoder, true)) return false;
+            json_skip_ws(decoder);
+            if (decoder->offset >= decoder->length ||
+                decoder->data[decoder->offset] != ':') {
+                decoder->error =
+                    json_error(decoder, "Expected ':' in JSON object");
                 return false;
             }
-            depth_bracket--;
-            continue;
-        }
-        
-        /* Check { */
-        if (c == '{') {
-            depth_brace++;
-            if (s[i+1] == ' ') {
-                ctx->error = make_error(ctx, line_num, col + i + 1, 
-                                       "Unexpected space after \"{\"");
+            decoder->offset++;
+            if (!json_decode_value(decoder)) return false;
+            json_skip_ws(decoder);
+            if (decoder->offset >= decoder->length) {
+                decoder->error =
+                    json_error(decoder, "Unterminated JSON object");
                 return false;
             }
-            continue;
-        }
-        
-        /* Check } */
-        if (c == '}') {
-            if (i > 0 && s[i-1] == ' ') {
-                ctx->error = make_error(ctx, line_num, col + i - 1, 
-                                       "Unexpected space before \"}\"");
+            char c = decoder->data[decoder->offset++];
+            if (c == '}') break;
+            if (c != ',') {
+                decoder->offset--;
+                decoder->error =
+                    json_error(decoder, "Expected ',' or '}' in JSON object");
                 return false;
             }
-            depth_brace--;
-            continue;
         }
-        
-        /* Check < for byte arrays */
-        if (c == '<') {
-            if (s[i+1] == ' ') {
-                ctx->error = make_error(ctx, line_num, col + i + 1, 
-                                       "Unexpected space after \"<\"");
-                return false;
+    }
+    JSON_EMIT(decoder, on_object_end, decoder->user_data);
+    decoder->depth--;
+    return true;
+}
+
+static bool json_decode_value(json_decoder_t *decoder) {
+    json_skip_ws(decoder);
+    if (decoder->offset >= decoder->length) {
+        decoder->error = json_error(decoder, "Unexpected end of JSON");
+        return false;
+    }
+    char c = decoder->data[decoder->offset];
+    switch (c) {
+        case '{':
+            return json_decode_object(decoder);
+        case '[':
+            return json_decode_array(decoder);
+        case '"':
+            return json_decode_string(decoder, false);
+        case 't':
+            if (!json_literal(decoder, "true", 4)) return false;
+            JSON_EMIT(decoder, on_bool, true, decoder->user_data);
+            return true;
+        case 'f':
+            if (!json_literal(decoder, "false", 5)) return false;
+            JSON_EMIT(decoder, on_bool, false, decoder->user_data);
+            return true;
+        case 'n':
+            if (!json_literal(decoder, "null", 4)) return false;
+            JSON_EMIT(decoder, on_null, decoder->user_data);
+            return true;
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                return json_decode_number(decoder);
             }
-            continue;
+            decoder->error =
+                json_error(decoder, "Unexpected character '%c' in JSON", c);
+            return false;
+    }
+}
+
+yay_error_t *yay_from_json_events(const char *source, size_t length,
+                                  const yay_callbacks_t *callbacks,
+                                  void *user_data) {
+    static const yay_callbacks_t no_callbacks = {0};
+    if (length == 0 && source) length = strlen(source);
+    json_decoder_t decoder = {
+        source, length, 0, callbacks ? callbacks : &no_callbacks, user_data,
+        0, false, NULL,
+    };
+    if (!json_decode_value(&decoder)) {
+        if (decoder.aborted) return NULL;
+        if (!decoder.error) {
+            decoder.error = json_error(&decoder, "JSON decode failed");
         }
-        
-        /* Check > */
-        if (c == '>') {
-            if (i > 0 && s[i-1] == ' ') {
-                ctx->error = make_error(ctx, line_num, col + i - 1, 
-                                       "Unexpected space before \">\"");
-                return false;
-            }
-            continue;
+        return decoder.error;
+    }
+    json_skip_ws(&decoder);
+    if (decoder.offset != decoder.length) {
+        return json_error(&decoder, "Trailing characters after JSON value");
+    }
+    return NULL;
+}
+
+/* Event-to-tree builder backing yay_from_json */
+typedef struct {
+    yay_value_t *root;
+    yay_value_t **stack;
+    size_t depth;
+    size_t capacity;
+    char *key;
+    bool failed;
+} json_builder_t;
+
+static void json_builder_attach(json_builder_t *builder, yay_value_t *value) {
+    if (!value) {
+        builder->failed = true;
+        return;
+    }
+    if (builder->depth == 0) {
+        builder->root = value;
+        return;
+    }
+    yay_value_t *top = builder->stack[builder->depth - 1];
+    if (top->type == YAY_OBJECT) {
+        yay_object_set(top, builder->key, value);
+    } else {
+        yay_array_push(top, value);
+    }
+}
+
+static bool json_builder_push(json_builder_t *builder, yay_value_t *value) {
+    json_builder_attach(builder, value);
+    if (builder->failed) return false;
+    if (builder->depth == builder->capacity) {
+        size_t grown = builder->capacity ? builder->capacity * 2 : 16;
+        yay_value_t **stack =
+            mem_realloc(builder->stack, grown * sizeof(yay_value_t *));
+        if (!stack) {
+            builder->failed = true;
+            return false;
         }
-        
-        /* Check , */
-        if (c == ',') {
-            if (i > 0 && s[i-1] == ' ') {
-                ctx->error = make_error(ctx, line_num, col + i - 1, 
-                                       "Unexpected space before \",\"");
-                return false;
-            }
-            /* Check for space after comma */
-            if (s[i+1] && s[i+1] != ' ' && s[i+1] != ']' && s[i+1] != '}') {
-                /* Lookahead to see if next closing bracket has space before it */
-                /* If so, don't report "Expected space after comma" - let the
-                 * "Unexpected space before ]" error be reported instead */
-                bool next_close_has_space = false;
-                int la_depth = depth_bracket + depth_brace;
-                bool la_in_string = false;
-                char la_string_char = 0;
-                bool la_escape = false;
-                for (int j = i + 1; s[j]; j++) {
-                    if (la_escape) {
-                        la_escape = false;
-                        continue;
-                    }
-                    if (la_in_string) {
-                        if (s[j] == '\\') la_escape = true;
-                        else if (s[j] == la_string_char) {
-                            la_in_string = false;
-                            la_string_char = 0;
-                        }
-                        continue;
-                    }
-                    if (s[j] == '"' || s[j] == '\'') {
-                        la_in_string = true;
-                        la_string_char = s[j];
-                        continue;
-                    }
-                    if (s[j] == '[' || s[j] == '{') {
-                        la_depth++;
-                        continue;
-                    }
-                    if (s[j] == ']' || s[j] == '}') {
-                        if (la_depth == depth_bracket + depth_brace) {
-                            /* Found matching close at same depth */
-                            next_close_has_space = (j > 0 && s[j-1] == ' ');
-                            break;
-                        }
-                        la_depth--;
-                        continue;
-                    }
-                    if (s[j] == ',' && la_depth == depth_bracket + depth_brace) {
-                        /* Found another comma at same depth - stop lookahead */
-                        break;
-                    }
-                }
-                if (!next_close_has_space) {
-                    ctx->error = make_error(ctx, line_num, col + i, 
-                                           "Expected space after \",\"");
-                    return false;
-                }
-            }
-            /* Check for double space after comma */
-            if (s[i+1] == ' ' && s[i+2] == ' ') {
-                ctx->error = make_error(ctx, line_num, col + i + 2, 
-                                       "Unexpected space after \",\"");
-                return false;
-            }
-            continue;
+        builder->stack = stack;
+        builder->capacity = grown;
+    }
+    builder->stack[builder->depth++] = value;
+    return true;
+}
+
+static bool json_builder_on_null(void *ud) {
+    json_builder_attach(ud, yay_null());
+    return !((json_builder_t *)ud)->failed;
+}
+
+static bool json_builder_on_bool(bool value, void *ud) {
+    json_builder_attach(ud, yay_bool(value));
+    return !((json_builder_t *)ud)->failed;
+}
+
+static bool json_builder_on_int(const char *digits, bool negative, void *ud) {
+    json_builder_attach(ud, yay_int_from_str(digits, negative));
+    return !((json_builder_t *)ud)->failed;
+}
+
+static bool json_builder_on_float(double value, void *ud) {
+    json_builder_attach(ud, yay_float(value));
+    return !((json_builder_t *)ud)->failed;
+}
+
+static bool json_builder_on_string(const char *str, size_t length, void *ud) {
+    json_builder_attach(ud, yay_string_len(str, length));
+    return !((json_builder_t *)ud)->failed;
+}
+
+static bool json_builder_on_array_start(void *ud) {
+    return json_builder_push(ud, yay_array());
+}
+
+static bool json_builder_on_object_start(void *ud) {
+    return json_builder_push(ud, yay_object());
+}
+
+static bool json_builder_on_container_end(void *ud) {
+    json_builder_t *builder = ud;
+    builder->depth--;
+    return true;
+}
+
+static bool json_builder_on_object_key(const char *key, size_t length,
+                                       void *ud) {
+    json_builder_t *builder = ud;
+    mem_free(builder->key);
+    builder->key = mem_alloc(length + 1);
+    if (!builder->key) {
+        builder->failed = true;
+        return false;
+    }
+    memcpy(builder->key, key, length);
+    builder->key[length] = '\0';
+    return true;
+}
+
+yay_result_t yay_from_json(const char *source, size_t length) {
+    static const yay_callbacks_t builder_callbacks = {
+        .on_null = json_builder_on_null,
+        .on_bool = json_builder_on_bool,
+        .on_int = json_builder_on_int,
+        .on_float = json_builder_on_float,
+        .on_string = json_builder_on_string,
+        .on_array_start = json_builder_on_array_start,
+        .on_array_end = json_builder_on_container_end,
+        .on_object_start = json_builder_on_object_start,
+        .on_object_key = json_builder_on_object_key,
+        .on_object_end = json_builder_on_container_end,
+    };
+
+    json_builder_t builder = {NULL, NULL, 0, 0, NULL, false};
+    yay_result_t result = {NULL, NULL};
+    result.error =
+        yay_from_json_events(source, length, &builder_callbacks, &builder);
+    mem_free(builder.key);
+    mem_free(builder.stack);
+    if (!result.error && builder.failed) {
+        result.error = error_alloc();
+        if (result.error) {
+            result.error->message = str_dup("JSON decode out of memory");
         }
-        
-        /* Check : in objects (only at depth > 0) */
-        if (c == ':' && depth_brace > 0) {
-            if (i > 0 && s[i-1] == ' ') {
-                ctx->error = make_error(ctx, line_num, col + i - 1, 
-                                       "Unexpected space before \":\"");
-                return false;
-            }
-            if (s[i+1] != ' ') {
-                ctx->error = make_error(ctx, line_num, col + i, 
-                                       "Expected space after \":\"");
-                return false;
-            }
-            if (s[i+1] == ' ' && s[i+2] == ' ') {
-                ctx->error = make_error(ctx, line_num, col + i + 2, 
-                                       "Unexpected space after \":\"");
-                return false;
-            }
-            continue;
+    }
+    if (result.error) {
+        yay_free(builder.root);
+    } else {
+        result.value = builder.root;
+    }
+    return result;
+}
+
+yay_result_t yay_from_json_arena(const char *source, size_t length,
+                                 yay_arena_t *arena) {
+    current_arena = arena;
+    yay_result_t result = yay_from_json(source, length);
+    current_arena = NULL;
+    return result;
+}
+
+/* Streaming JSON-to-YAY emitter: just enough context to place commas,
+ * colons, and brackets exactly as encode_value would for the same tree */
+typedef struct {
+    yay_writer_t *writer;
+    size_t counts[JSON_MAX_DEPTH];
+    size_t depth;
+    bool after_key;
+} json_emit_t;
+
+static void json_emit_separate(json_emit_t *emit) {
+    if (emit->after_key) {
+        emit->after_key = false;
+        return;
+    }
+    if (emit->depth > 0 && emit->counts[emit->depth - 1]++ > 0) {
+        yay_writer_write(emit->writer, ", ", 2);
+    }
+}
+
+static bool json_emit_null(void *ud) {
+    json_emit_t *emit = ud;
+    json_emit_separate(emit);
+    yay_writer_write(emit->writer, "null", 4);
+    return true;
+}
+
+static bool json_emit_bool(bool value, void *ud) {
+    json_emit_t *emit = ud;
+    json_emit_separate(emit);
+    if (value) {
+        yay_writer_write(emit->writer, "true", 4);
+    } else {
+        yay_writer_write(emit->writer, "false", 5);
+    }
+    return true;
+}
+
+static bool json_emit_int(const char *digits, bool negative, void *ud) {
+    json_emit_t *emit = ud;
+    json_emit_separate(emit);
+    if (negative) writer_putc(emit->writer, '-');
+    writer_puts(emit->writer, digits);
+    writer_putc(emit->writer, 'n');
+    return true;
+}
+
+static bool json_emit_float(double value, void *ud) {
+    json_emit_t *emit = ud;
+    json_emit_separate(emit);
+    if (isnan(value)) {
+        yay_writer_write(emit->writer, "NaN", 3);
+    } else if (isinf(value)) {
+        if (value > 0) {
+            yay_writer_write(emit->writer, "Infinity", 8);
+        } else {
+            yay_writer_write(emit->writer, "-Infinity", 9);
         }
+    } else {
+        char tmp[64];
+        yay_writer_write(emit->writer, tmp, format_double(value, tmp));
     }
-    
     return true;
 }
 
+static bool json_emit_string(const char *str, size_t length, void *ud) {
+    json_emit_t *emit = ud;
+    json_emit_separate(emit);
+    encode_string_len(emit->writer, str, length);
+    return true;
+}
+
+static bool json_emit_array_start(void *ud) {
+    json_emit_t *emit = ud;
+    json_emit_separate(emit);
+    writer_putc(emit->writer, '[');
+    emit->counts[emit->depth++] = 0;
+    return true;
+}
+
+static bool json_emit_array_end(void *ud) {
+    json_emit_t *emit = ud;
+    writer_putc(emit->writer, ']');
+    emit->depth--;
+    return true;
+}
+
+static bool json_emit_object_start(void *ud) {
+    json_emit_t *emit = ud;
+    json_emit_separate(emit);
+    writer_putc(emit->writer, '{');
+    emit->counts[emit->depth++] = 0;
+    return true;
+}
+
+static bool json_emit_object_end(void *ud) {
+    json_emit_t *emit = ud;
+    writer_putc(emit->writer, '}');
+    emit->depth--;
+    return true;
+}
+
+static bool json_emit_object_key(const char *key, size_t length, void *ud) {
+    json_emit_t *emit = ud;
+    if (emit->counts[emit->depth - 1]++ > 0) {
+        yay_writer_write(emit->writer, ", ", 2);
+    }
+    yay_writer_write(emit->writer, key, length);
+    yay_writer_write(emit->writer, ": ", 2);
+    emit->after_key = true;
+    return true;
+}
+
+yay_error_t *yay_json_to_yay(const char *source, size_t length,
+                             yay_writer_t *writer) {
+    yay_callbacks_t callbacks = {
+        .on_null = json_emit_null,
+        .on_bool = json_emit_bool,
+        .on_int = json_emit_int,
+        .on_float = json_emit_float,
+        .on_string = json_emit_string,
+        .on_array_start = json_emit_array_start,
+        .on_array_end = json_emit_array_end,
+        .on_object_start = json_emit_object_start,
+        .on_object_key = json_emit_object_key,
+        .on_object_end = json_emit_object_end,
+    };
+    json_emit_t emit;
+    memset(&emit, 0, sizeof(emit));
+    emit.writer = writer;
+    return yay_from_json_events(source, length, &callbacks, &emit);
+}
+
+yay_error_t *yay_parse_events(const char *source, size_t length,
+                              const char *filename,
+                              const yay_callbacks_t *callbacks,
+                              void *user_data) {
+    yay_result_t result = parse_document(source, length, filename,
+                                         callbacks, user_data, false, NULL,
+                                         false);
+    yay_free(result.value);
+    return result.error;
+}
+
+bool yay_validate(const char *source, size_t length, const char *filename,
+                  yay_error_t **error) {
+    /* Event mode with no callbacks runs every structural check but never
+     * materializes a document tree */
+    static const yay_callbacks_t no_callbacks = {0};
+    yay_error_t *err = yay_parse_events(source, length, filename,
+                                        &no_callbacks, NULL);
+    if (error) {
+        *error = err;
+    } else {
+        yay_error_free(err);
+    }
+    return err == NULL;
+}
+
+yay_result_t yay_parse_arena(const char *source, size_t length,
+                             const char *filename, yay_arena_t *arena) {
+    current_arena = arena;
+    yay_result_t result = yay_parse(source, length, filename);
+    current_arena = NULL;
+    return result;
+}
+
+yay_result_t yay_parse_borrowed(const char *source, size_t length,
+                                const char *filename, yay_arena_t *arena) {
+    if (!arena) return yay_parse(source, length, filename);
+    current_arena = arena;
+    yay_result_t result = parse_document(source, length, filename,
+                                         NULL, NULL, false, arena, false);
+    current_arena = NULL;
+    return result;
+}
+
+yay_result_t yay_parse_owned(char *source, size_t length,
+                             const char *filename, yay_arena_t *arena) {
+    if (!arena) {
+        yay_result_t result = yay_parse(source, length, filename);
+        mem_free(source);
+        return result;
+    }
+    current_arena = arena;
+    yay_result_t result = parse_document(source, length, filename,
+                                         NULL, NULL, false, arena, true);
+    current_arena = NULL;
+    return result;
+}
+
+static yay_result_t parse_file_error(const char *path, const char *what) {
+    yay_result_t result = {NULL, NULL};
+    result.error = error_alloc();
+    size_t total = strlen(what) + strlen(path) + 32;
+    result.error->message = mem_alloc(total);
+    snprintf(result.error->message, total, "%s <%s>", what, path);
+    return result;
+}
+
+/* Plain-read fallback when mmap is unavailable or fails */
+static yay_result_t parse_file_stdio(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return parse_file_error(path, "Cannot open file");
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(f);
+        return parse_file_error(path, "Cannot read file");
+    }
+    char *content = mem_alloc((size_t)size + 1);
+    size_t nread = fread(content, 1, (size_t)size, f);
+    fclose(f);
+    content[nread] = '\0';
+    yay_result_t result = yay_parse(content, nread, path);
+    mem_free(content);
+    return result;
+}
+
+yay_result_t yay_parse_file(const char *path) {
+#if !defined(_WIN32)
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return parse_file_error(path, "Cannot open file");
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return parse_file_error(path, "Cannot read file");
+    }
+    size_t len = (size_t)st.st_size;
+    if (len == 0) {
+        close(fd);
+        return yay_parse("", 0, path);
+    }
+    void *map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return parse_file_stdio(path);
+    }
+    yay_result_t result = yay_parse(map, len, path);
+    munmap(map, len);
+    return result;
+#else
+    return parse_file_stdio(path);
+#endif
+}
+
 /* ============================================================================
- * Inline Array Parsing
+ * MEH Formatter
  * ============================================================================ */
 
-static yay_value_t *parse_inline_value(parse_ctx_t *ctx, const char *s, 
-                                        size_t *consumed, int line_num, int col);
+/* Comment-preserving reformatter. MEH is a loose concrete-syntax-tree
+ * reading of YAY that tolerates extra whitespace, keeps comments with
+ * their line associations, and keeps key order and blank lines. The
+ * pipeline runs in three phases: parse the source into a CST, normalize
+ * it (blank-line collapsing, number and hex respacing, comment
+ * alignment, joining, and rewrapping, inline-to-block conversion at the
+ * wrap column), then serialize it back out through a writer. All CST
+ * nodes live in a private arena for the duration of the call, and text
+ * that needs no rewriting is carried as slices of the source, never
+ * copied. */
+
+#define MEH_DEFAULT_WRAP 80
+
+/* Width sentinel for values that cannot be rendered on one line */
+#define MEH_MULTILINE SIZE_MAX
+
+/* Borrowed span of the source (or of arena-built replacement text) */
+typedef struct {
+    const char *ptr;
+    size_t len;
+} meh_str_t;
+
+/* A comment's text (everything after '#') plus the column its '#' should
+ * land on once alignment has run (0 = unaligned, two-space default) */
+typedef struct {
+    meh_str_t text;
+    size_t align_column;
+    bool present;
+} meh_comment_t;
+
+typedef enum {
+    MEH_NULL,
+    MEH_BOOL,
+    MEH_INT,           /* Source text; spacing normalized by the transform */
+    MEH_FLOAT,         /* Source text; canonicalized by the transform */
+    MEH_STRING,        /* Quoted string, text includes the quotes */
+    MEH_BLOCK_STRING,
+    MEH_BYTES,         /* Inline bytes, text is the span between < and > */
+    MEH_BLOCK_BYTES,
+    MEH_ARRAY,
+    MEH_OBJECT,
+} meh_value_kind_t;
+
+typedef struct {
+    size_t indent;
+    meh_str_t content;
+} meh_text_line_t;
+
+typedef struct {
+    size_t indent;
+    meh_str_t hex;
+    meh_comment_t comment;
+} meh_hex_line_t;
+
+typedef struct meh_value meh_value_t;
+
+typedef struct {
+    meh_str_t key;
+    meh_value_t *value;
+} meh_entry_t;
+
+struct meh_value {
+    meh_value_kind_t kind;
+    bool boolean;
+    meh_str_t text;
+    struct {
+        bool has_first;         /* Text followed the backtick */
+        meh_str_t first;
+        meh_text_line_t *lines;
+        size_t count;
+        size_t capacity;
+    } block_string;
+    struct {
+        meh_comment_t first_comment;   /* Comment on the '>' line itself */
+        meh_hex_line_t *lines;
+        size_t count;
+        size_t capacity;
+    } block_bytes;
+    struct {
+        meh_value_t **items;
+        size_t count;
+        size_t capacity;
+    } array;
+    struct {
+        meh_entry_t *entries;
+        size_t count;
+        size_t capacity;
+    } object;
+};
+
+typedef enum {
+    MEH_ITEM_BLANK,
+    MEH_ITEM_COMMENT,
+    MEH_ITEM_VALUE,
+    MEH_ITEM_PROPERTY,
+    MEH_ITEM_ARRAY_ITEM,
+} meh_item_kind_t;
 
-static int find_matching_bracket(const char *s) {
+typedef struct meh_item meh_item_t;
+
+typedef struct {
+    meh_item_t **items;
+    size_t count;
+    size_t capacity;
+} meh_block_t;
+
+/* One line-level construct. A property or array item carries at most one
+ * of an inline value or an indented block of child items. */
+struct meh_item {
+    meh_item_kind_t kind;
+    meh_str_t key;             /* MEH_ITEM_PROPERTY, verbatim (may be quoted) */
+    meh_value_t *value;
+    meh_block_t *block;
+    meh_comment_t comment;     /* Standalone text or trailing inline comment */
+};
+
+typedef struct {
+    yay_arena_t *arena;
+    meh_str_t *lines;
+    size_t line_count;
+    size_t line_idx;
+    size_t wrap;
+    bool oom;      /* Sticky; the walk winds down and the caller reports */
+} meh_ctx_t;
+
+static void *meh_alloc(meh_ctx_t *ctx, size_t size) {
+    void *p = arena_alloc(ctx->arena, size);
+    if (!p) ctx->oom = true;
+    return p;
+}
+
+/* Ensure room for one more element in a doubling arena array. Old blocks
+ * are abandoned to the arena; they are all freed together at the end. */
+static bool meh_reserve(meh_ctx_t *ctx, void *items, size_t elem_size,
+                        size_t count, size_t *capacity) {
+    void **slot = (void **)items;
+    if (count < *capacity) return true;
+    size_t grown = *capacity ? *capacity * 2 : 4;
+    void *p = arena_alloc(ctx->arena, grown * elem_size);
+    if (!p) {
+        ctx->oom = true;
+        return false;
+    }
+    if (count) memcpy(p, *slot, count * elem_size);
+    *slot = p;
+    *capacity = grown;
+    return true;
+}
+
+static meh_str_t meh_slice(const char *ptr, size_t len) {
+    meh_str_t s = {ptr, len};
+    return s;
+}
+
+static meh_str_t meh_empty(void) {
+    return meh_slice(NULL, 0);
+}
+
+static bool meh_eq(meh_str_t s, const char *lit) {
+    size_t n = strlen(lit);
+    return s.len == n && memcmp(s.ptr, lit, n) == 0;
+}
+
+static bool meh_starts(meh_str_t s, const char *lit) {
+    size_t n = strlen(lit);
+    return s.len >= n && memcmp(s.ptr, lit, n) == 0;
+}
+
+static bool meh_is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static meh_str_t meh_drop(meh_str_t s, size_t n) {
+    return meh_slice(s.ptr + n, s.len - n);
+}
+
+static meh_str_t meh_trim_start(meh_str_t s) {
+    while (s.len && meh_is_space(s.ptr[0])) {
+        s.ptr++;
+        s.len--;
+    }
+    return s;
+}
+
+static meh_str_t meh_trim_end(meh_str_t s) {
+    while (s.len && meh_is_space(s.ptr[s.len - 1])) s.len--;
+    return s;
+}
+
+static meh_str_t meh_trim(meh_str_t s) {
+    return meh_trim_end(meh_trim_start(s));
+}
+
+static size_t meh_indent_of(meh_str_t line) {
+    size_t i = 0;
+    while (i < line.len && line.ptr[i] == ' ') i++;
+    return i;
+}
+
+/* Find the first ':' outside quotes and outside bracket nesting, or -1 */
+static long meh_find_colon(meh_str_t s) {
+    bool in_double = false, in_single = false, escape = false;
     int depth = 0;
-    bool in_string = false;
-    char string_char = 0;
-    bool escape = false;
-    
-    for (int i = 0; s[i]; i++) {
+    for (size_t i = 0; i < s.len; i++) {
+        char c = s.ptr[i];
         if (escape) {
             escape = false;
             continue;
         }
-        if (s[i] == '\\' && in_string) {
+        if (c == '\\' && (in_double || in_single)) {
             escape = true;
             continue;
         }
-        if ((s[i] == '"' || s[i] == '\'') && (!in_string || s[i] == string_char)) {
-            if (in_string) {
-                in_string = false;
-                string_char = 0;
-            } else {
-                in_string = true;
-                string_char = s[i];
+        if (c == '"' && !in_single) {
+            in_double = !in_double;
+        } else if (c == '\'' && !in_double) {
+            in_single = !in_single;
+        } else if (!in_double && !in_single) {
+            switch (c) {
+                case '[': case '{': case '<': depth++; break;
+                case ']': case '}': case '>': depth--; break;
+                case ':': if (depth == 0) return (long)i; break;
+                default: break;
             }
-            continue;
-        }
-        if (in_string) continue;
-        
-        if (s[i] == '[') depth++;
-        else if (s[i] == ']') {
-            depth--;
-            if (depth == 0) return i;
         }
     }
     return -1;
 }
 
-static int find_matching_brace(const char *s) {
-    int depth = 0;
-    bool in_string = false;
-    char string_char = 0;
-    bool escape = false;
-    
-    for (int i = 0; s[i]; i++) {
+/* Split "value  # comment" at the first unquoted '#'. The value part is
+ * trimmed on the right; the comment keeps its leading spaces. */
+static meh_str_t meh_split_comment(meh_str_t s, meh_comment_t *comment) {
+    memset(comment, 0, sizeof(*comment));
+    bool in_double = false, in_single = false, escape = false;
+    for (size_t i = 0; i < s.len; i++) {
+        char c = s.ptr[i];
         if (escape) {
             escape = false;
             continue;
         }
-        if (s[i] == '\\' && in_string) {
+        if (c == '\\') {
             escape = true;
             continue;
         }
-        if ((s[i] == '"' || s[i] == '\'') && (!in_string || s[i] == string_char)) {
-            if (in_string) {
-                in_string = false;
-                string_char = 0;
-            } else {
-                in_string = true;
-                string_char = s[i];
-            }
-            continue;
-        }
-        if (in_string) continue;
-        
-        if (s[i] == '{') depth++;
-        else if (s[i] == '}') {
-            depth--;
-            if (depth == 0) return i;
+        if (c == '"' && !in_single) {
+            in_double = !in_double;
+        } else if (c == '\'' && !in_double) {
+            in_single = !in_single;
+        } else if (c == '#' && !in_double && !in_single) {
+            comment->present = true;
+            comment->text = meh_drop(s, i + 1);
+            return meh_trim_end(meh_slice(s.ptr, i));
         }
     }
-    return -1;
+    return s;
 }
 
-static yay_value_t *parse_inline_string(parse_ctx_t *ctx __attribute__((unused)),
-                                         const char *s, 
-                                         size_t *consumed,
-                                         int line_num __attribute__((unused)),
-                                         int col __attribute__((unused))) {
-    char quote = s[0];
-    size_t i = 1;
-    size_t cap = 64;
-    size_t len = 0;
-    char *out = malloc(cap);
-    bool escape = false;
-    
-    while (s[i]) {
+/* Split the next comma-separated element of an inline container; *rest
+ * receives the remainder starting at the comma */
+static meh_str_t meh_split_element(meh_str_t s, meh_str_t *rest) {
+    bool in_double = false, in_single = false, escape = false;
+    int depth = 0;
+    for (size_t i = 0; i < s.len; i++) {
+        char c = s.ptr[i];
         if (escape) {
-            if (quote == '"') {
-                switch (s[i]) {
-                    case '"': out[len++] = '"'; break;
-                    case '\\': out[len++] = '\\'; break;
-                    case '/': out[len++] = '/'; break;
-                    case 'b': out[len++] = '\b'; break;
-                    case 'f': out[len++] = '\f'; break;
-                    case 'n': out[len++] = '\n'; break;
-                    case 'r': out[len++] = '\r'; break;
-                    case 't': out[len++] = '\t'; break;
-                    case 'u': {
-                        if (!s[i+1] || !s[i+2] || !s[i+3] || !s[i+4]) {
-                            free(out);
-                            return NULL;
-                        }
-                        char hex[5] = {s[i+1], s[i+2], s[i+3], s[i+4], 0};
-                        unsigned int code;
-                        sscanf(hex, "%x", &code);
-                        if (code < 0x80) {
-                            out[len++] = code;
-                        } else if (code < 0x800) {
-                            out[len++] = 0xC0 | (code >> 6);
-                            out[len++] = 0x80 | (code & 0x3F);
-                        } else {
-                            out[len++] = 0xE0 | (code >> 12);
-                            out[len++] = 0x80 | ((code >> 6) & 0x3F);
-                            out[len++] = 0x80 | (code & 0x3F);
-                        }
-                        i += 4;
-                        break;
-                    }
-                    default: out[len++] = s[i]; break;
-                }
-            } else {
-                /* Single quote - only \' and \\ are escapes */
-                if (s[i] == '\'' || s[i] == '\\') {
-                    out[len++] = s[i];
-                } else {
-                    out[len++] = '\\';
-                    out[len++] = s[i];
-                }
-            }
             escape = false;
-            i++;
             continue;
         }
-        
-        if (s[i] == '\\') {
+        if (c == '\\' && (in_double || in_single)) {
             escape = true;
-            i++;
             continue;
         }
-        
-        if (s[i] == quote) {
-            *consumed = i + 1;
-            out[len] = '\0';
-            yay_value_t *v = yay_string(out);
-            free(out);
-            return v;
-        }
-        
-        if (len + 4 >= cap) {
-            cap *= 2;
-            out = realloc(out, cap);
+        if (c == '"' && !in_single) {
+            in_double = !in_double;
+        } else if (c == '\'' && !in_double) {
+            in_single = !in_single;
+        } else if (!in_double && !in_single) {
+            switch (c) {
+                case '[': case '{': case '<': depth++; break;
+                case ']': case '}': case '>': depth--; break;
+                case ',':
+                    if (depth == 0) {
+                        *rest = meh_drop(s, i);
+                        return meh_slice(s.ptr, i);
+                    }
+                    break;
+                default: break;
+            }
         }
-        out[len++] = s[i++];
-    }
-    
-    free(out);
-    return NULL;
-}
-
-static yay_value_t *parse_inline_number(const char *s, size_t *consumed) {
-    size_t i = 0;
-    bool has_decimal = false;
-    
-    if (s[i] == '-') i++;
-    
-    while (s[i] && (isdigit(s[i]) || s[i] == '.')) {
-        if (s[i] == '.') has_decimal = true;
-        i++;
-    }
-    
-    if (i == 0 || (i == 1 && s[0] == '-')) {
-        return NULL;
-    }
-    
-    char *num_str = str_dup_len(s, i);
-    *consumed = i;
-    
-    if (has_decimal) {
-        double val = atof(num_str);
-        free(num_str);
-        return yay_float(val);
-    } else {
-        bool negative = num_str[0] == '-';
-        char *digits = negative ? num_str + 1 : num_str;
-        yay_value_t *v = yay_int_from_str(digits, negative);
-        free(num_str);
-        return v;
-    }
-}
-
-static yay_value_t *parse_inline_bytes(parse_ctx_t *ctx, const char *s, 
-                                        size_t *consumed, int line_num, int col) {
-    /* Find closing > */
-    const char *end = strchr(s + 1, '>');
-    if (!end) return NULL;
-    
-    /* Validate whitespace in byte literal */
-    if (s[1] == ' ') {
-        ctx->error = make_error(ctx, line_num, col + 1, 
-                               "Unexpected space after \"<\"");
-        return NULL;
-    }
-    if (end > s + 1 && *(end - 1) == ' ') {
-        ctx->error = make_error(ctx, line_num, col + (int)(end - s - 1), 
-                               "Unexpected space before \">\"");
-        return NULL;
     }
-    
-    size_t hex_len = end - s - 1;
-    char *hex = malloc(hex_len + 1);
-    size_t hex_out = 0;
-    
-    for (size_t i = 1; i < (size_t)(end - s); i++) {
-        if (s[i] != ' ' && s[i] != '\t') {
-            hex[hex_out++] = tolower(s[i]);
+    *rest = meh_empty();
+    return s;
+}
+
+/* Digits with optional sign, dots, exponent marks, and space grouping */
+static bool meh_looks_like_number(meh_str_t s) {
+    s = meh_trim(s);
+    if (!s.len) return false;
+    size_t i = 0;
+    if (s.ptr[0] == '-') i++;
+    if (i >= s.len) return false;
+    bool has_digit = false;
+    for (; i < s.len; i++) {
+        char c = s.ptr[i];
+        if (c >= '0' && c <= '9') {
+            has_digit = true;
+        } else if (c != '.' && c != ' ' && c != 'e' && c != 'E' &&
+                   c != '+' && c != '-') {
+            return false;
         }
     }
-    hex[hex_out] = '\0';
-    
-    if (hex_out % 2 != 0) {
-        ctx->error = make_error(ctx, line_num, col, 
-                               "Odd number of hex digits in byte literal");
-        free(hex);
-        return NULL;
+    return has_digit;
+}
+
+static meh_value_t *meh_value_new(meh_ctx_t *ctx, meh_value_kind_t kind) {
+    meh_value_t *v = meh_alloc(ctx, sizeof(meh_value_t));
+    if (v) {
+        memset(v, 0, sizeof(*v));
+        v->kind = kind;
     }
-    
-    yay_value_t *v = yay_bytes_from_hex(hex);
-    free(hex);
-    *consumed = end - s + 1;
     return v;
 }
 
-static yay_value_t *parse_inline_value_impl(parse_ctx_t *ctx, const char *s, 
-                                             size_t *consumed, int line_num, int col);
+static meh_item_t *meh_item_new(meh_ctx_t *ctx, meh_item_kind_t kind) {
+    meh_item_t *item = meh_alloc(ctx, sizeof(meh_item_t));
+    if (item) {
+        memset(item, 0, sizeof(*item));
+        item->kind = kind;
+    }
+    return item;
+}
 
-static yay_value_t *parse_inline_value(parse_ctx_t *ctx, const char *s, 
-                                        size_t *consumed, int line_num, int col) {
-    /* Skip whitespace */
-    while (*s == ' ') { s++; col++; }
-    
-    /* Validate syntax before parsing (only for top-level arrays/objects) */
-    if (s[0] == '[' || s[0] == '{') {
-        if (!validate_inline_syntax(ctx, s, line_num, col)) {
+static meh_block_t *meh_block_new(meh_ctx_t *ctx) {
+    meh_block_t *block = meh_alloc(ctx, sizeof(meh_block_t));
+    if (block) memset(block, 0, sizeof(*block));
+    return block;
+}
+
+static bool meh_block_push(meh_ctx_t *ctx, meh_block_t *block,
+                           meh_item_t *item) {
+    if (!item) return false;
+    if (!meh_reserve(ctx, &block->items, sizeof(meh_item_t *), block->count,
+                     &block->capacity)) {
+        return false;
+    }
+    block->items[block->count++] = item;
+    return true;
+}
+
+static bool meh_bytes_push(meh_ctx_t *ctx, meh_value_t *v,
+                           meh_hex_line_t line) {
+    if (!meh_reserve(ctx, &v->block_bytes.lines, sizeof(meh_hex_line_t),
+                     v->block_bytes.count, &v->block_bytes.capacity)) {
+        return false;
+    }
+    v->block_bytes.lines[v->block_bytes.count++] = line;
+    return true;
+}
+
+/* ---- MEH parser ---- */
+
+static meh_value_t *meh_parse_inline_value(meh_ctx_t *ctx, meh_str_t raw);
+static meh_item_t *meh_parse_item(meh_ctx_t *ctx, size_t min_indent);
+
+static meh_value_t *meh_parse_inline_array(meh_ctx_t *ctx, meh_str_t s) {
+    meh_value_t *v = meh_value_new(ctx, MEH_ARRAY);
+    if (!v) return NULL;
+    meh_str_t remaining = meh_trim(meh_slice(s.ptr + 1, s.len - 2));
+    while (remaining.len) {
+        meh_str_t rest;
+        meh_str_t elem = meh_split_element(remaining, &rest);
+        meh_value_t *item = meh_parse_inline_value(ctx, meh_trim(elem));
+        if (!item) return NULL;
+        if (!meh_reserve(ctx, &v->array.items, sizeof(meh_value_t *),
+                         v->array.count, &v->array.capacity)) {
             return NULL;
         }
+        v->array.items[v->array.count++] = item;
+        remaining = meh_trim_start(rest);
+        if (remaining.len && remaining.ptr[0] == ',') {
+            remaining = meh_trim_start(meh_drop(remaining, 1));
+        }
     }
-    
-    return parse_inline_value_impl(ctx, s, consumed, line_num, col);
+    return v;
 }
 
-static yay_value_t *parse_inline_value_impl(parse_ctx_t *ctx, const char *s, 
-                                             size_t *consumed, int line_num, int col) {
-    /* Skip whitespace */
-    while (*s == ' ') { s++; col++; }
-    
-    if (s[0] == '[') {
-        int end = find_matching_bracket(s);
-        if (end < 0) return NULL;
-        
-        yay_value_t *arr = yay_array();
-        const char *inner = s + 1;
-        int inner_col = col + 1;
-        
-        while (*inner && *inner != ']') {
-            while (*inner == ' ' || *inner == ',') { inner++; inner_col++; }
-            if (*inner == ']') break;
-            
-            size_t item_consumed;
-            yay_value_t *item = parse_inline_value_impl(ctx, inner, &item_consumed, 
-                                                         line_num, inner_col);
-            if (!item) {
-                yay_free(arr);
+static meh_value_t *meh_parse_inline_object(meh_ctx_t *ctx, meh_str_t s) {
+    meh_value_t *v = meh_value_new(ctx, MEH_OBJECT);
+    if (!v) return NULL;
+    meh_str_t remaining = meh_trim(meh_slice(s.ptr + 1, s.len - 2));
+    while (remaining.len) {
+        meh_str_t rest;
+        meh_str_t elem = meh_split_element(remaining, &rest);
+        long colon = meh_find_colon(elem);
+        if (colon >= 0) {
+            meh_str_t key = meh_trim(meh_slice(elem.ptr, (size_t)colon));
+            meh_value_t *value =
+                meh_parse_inline_value(ctx, meh_drop(elem, (size_t)colon + 1));
+            if (!value) return NULL;
+            if (!meh_reserve(ctx, &v->object.entries, sizeof(meh_entry_t),
+                             v->object.count, &v->object.capacity)) {
                 return NULL;
             }
-            yay_array_push(arr, item);
-            inner += item_consumed;
-            inner_col += item_consumed;
+            v->object.entries[v->object.count].key = key;
+            v->object.entries[v->object.count].value = value;
+            v->object.count++;
         }
-        
-        *consumed = end + 1;
-        return arr;
-    }
-    
-    if (s[0] == '{') {
-        int end = find_matching_brace(s);
-        if (end < 0) return NULL;
-        
-        yay_value_t *obj = yay_object();
-        const char *inner = s + 1;
-        int inner_col = col + 1;
-        
-        while (*inner && *inner != '}') {
-            while (*inner == ' ' || *inner == ',') { inner++; inner_col++; }
-            if (*inner == '}') break;
-            
-            /* Parse key */
-            char *key = NULL;
-            if (*inner == '"' || *inner == '\'') {
-                size_t key_consumed;
-                yay_value_t *key_val = parse_inline_string(ctx, inner, &key_consumed,
-                                                           line_num, inner_col);
-                if (!key_val) {
-                    yay_free(obj);
-                    return NULL;
-                }
-                key = str_dup(key_val->data.string);
-                yay_free(key_val);
-                inner += key_consumed;
-                inner_col += key_consumed;
-            } else {
-                /* Unquoted key - must start with alphanumeric or underscore */
-                const char *key_start = inner;
-                if (!isalnum(*inner) && *inner != '_') {
-                    /* Invalid key character at start */
-                    ctx->error = make_error(ctx, line_num, col, "Invalid key");
-                    yay_free(obj);
-                    return NULL;
-                }
-                while (*inner && (isalnum(*inner) || *inner == '_' || *inner == '-')) { inner++; inner_col++; }
-                key = str_dup_len(key_start, inner - key_start);
-            }
-            
-            /* Skip colon */
-            while (*inner == ' ') { inner++; inner_col++; }
-            if (*inner != ':') {
-                ctx->error = make_error(ctx, line_num, col, "Expected colon after key");
-                free(key);
-                yay_free(obj);
-                return NULL;
-            }
-            inner++; inner_col++;
-            while (*inner == ' ') { inner++; inner_col++; }
-            
-            /* Parse value */
-            size_t val_consumed;
-            yay_value_t *val = parse_inline_value(ctx, inner, &val_consumed,
-                                                   line_num, inner_col);
-            if (!val) {
-                free(key);
-                yay_free(obj);
-                return NULL;
-            }
-            
-            yay_object_set(obj, key, val);
-            free(key);
-            inner += val_consumed;
-            inner_col += val_consumed;
+        remaining = meh_trim_start(rest);
+        if (remaining.len && remaining.ptr[0] == ',') {
+            remaining = meh_trim_start(meh_drop(remaining, 1));
         }
-        
-        *consumed = end + 1;
-        return obj;
-    }
-    
-    if (s[0] == '<') {
-        return parse_inline_bytes(ctx, s, consumed, line_num, col);
-    }
-    
-    if (s[0] == '"' || s[0] == '\'') {
-        return parse_inline_string(ctx, s, consumed, line_num, col);
-    }
-    
-    if (strncmp(s, "true", 4) == 0 && !isalnum(s[4])) {
-        *consumed = 4;
-        return yay_bool(true);
-    }
-    
-    if (strncmp(s, "false", 5) == 0 && !isalnum(s[5])) {
-        *consumed = 5;
-        return yay_bool(false);
-    }
-    
-    if (strncmp(s, "null", 4) == 0 && !isalnum(s[4])) {
-        *consumed = 4;
-        return yay_null();
-    }
-    
-    if (strncmp(s, "nan", 3) == 0 && !isalnum(s[3])) {
-        *consumed = 3;
-        return yay_float(NAN);
-    }
-    
-    if (strncmp(s, "infinity", 8) == 0 && !isalnum(s[8])) {
-        *consumed = 8;
-        return yay_float(INFINITY);
-    }
-    
-    if (strncmp(s, "-infinity", 9) == 0 && !isalnum(s[9])) {
-        *consumed = 9;
-        return yay_float(-INFINITY);
     }
-    
-    /* Try number */
-    return parse_inline_number(s, consumed);
-}
-
-static yay_value_t *parse_inline_array(parse_ctx_t *ctx, const char *s,
-                                        int line_num, int col) {
-    size_t consumed;
-    return parse_inline_value(ctx, s, &consumed, line_num, col);
+    return v;
 }
 
-/* ============================================================================
- * Byte Array Parsing
- * ============================================================================ */
+static meh_value_t *meh_parse_inline_value(meh_ctx_t *ctx, meh_str_t raw) {
+    meh_str_t s = meh_trim(raw);
 
-static yay_value_t *parse_angle_bytes(parse_ctx_t *ctx, const char *s,
-                                       int line_num, int col) {
-    if (strcmp(s, "<>") == 0) {
-        return yay_bytes(NULL, 0);
+    if (!s.len || meh_eq(s, "null")) return meh_value_new(ctx, MEH_NULL);
+    if (meh_eq(s, "true") || meh_eq(s, "false")) {
+        meh_value_t *v = meh_value_new(ctx, MEH_BOOL);
+        if (v) v->boolean = s.ptr[0] == 't';
+        return v;
     }
-    
-    size_t len = strlen(s);
-    if (s[0] != '<') {
-        return NULL;
+    if (s.ptr[0] == '"' || s.ptr[0] == '\'') {
+        meh_value_t *v = meh_value_new(ctx, MEH_STRING);
+        if (v) v->text = s;
+        return v;
     }
-    
-    /* Check for unclosed angle bracket */
-    if (len < 2 || s[len-1] != '>') {
-        ctx->error = make_error(ctx, line_num, col,
-                               "Unmatched angle bracket");
-        return NULL;
+    if (s.len >= 2 && s.ptr[0] == '<' && s.ptr[s.len - 1] == '>') {
+        meh_value_t *v = meh_value_new(ctx, MEH_BYTES);
+        if (v) v->text = meh_slice(s.ptr + 1, s.len - 2);
+        return v;
     }
-    
-    /* Validate whitespace */
-    if (s[1] == ' ') {
-        ctx->error = make_error(ctx, line_num, col + 1,
-                               "Unexpected space after \"<\"");
-        return NULL;
+    if (s.len >= 2 && s.ptr[0] == '[' && s.ptr[s.len - 1] == ']') {
+        return meh_parse_inline_array(ctx, s);
     }
-    if (len > 2 && s[len-2] == ' ') {
-        ctx->error = make_error(ctx, line_num, col + (int)len - 2,
-                               "Unexpected space before \">\"");
-        return NULL;
+    if (s.len >= 2 && s.ptr[0] == '{' && s.ptr[s.len - 1] == '}') {
+        return meh_parse_inline_object(ctx, s);
     }
-    
-    /* Extract hex, removing spaces, and validate hex digits */
-    char *hex = malloc(len);
-    size_t hex_len = 0;
-    
-    for (size_t i = 1; i < len - 1; i++) {
-        if (s[i] != ' ') {
-            char c = s[i];
-            /* Reject uppercase hex digits */
-            if (c >= 'A' && c <= 'F') {
-                ctx->error = make_error(ctx, line_num, col + (int)i,
-                                       "Uppercase hex digit (use lowercase)");
-                free(hex);
-                return NULL;
-            }
-            /* Validate hex digit */
-            if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
-                ctx->error = make_error(ctx, line_num, col, "Invalid hex digit");
-                free(hex);
-                return NULL;
+    if (meh_looks_like_number(s)) {
+        bool is_float = false;
+        for (size_t i = 0; i < s.len; i++) {
+            char c = s.ptr[i];
+            if (c == '.' || c == 'e' || c == 'E') {
+                is_float = true;
+                break;
             }
-            hex[hex_len++] = c;
         }
+        meh_value_t *v = meh_value_new(ctx, is_float ? MEH_FLOAT : MEH_INT);
+        if (v) v->text = s;
+        return v;
     }
-    hex[hex_len] = '\0';
-    
-    if (hex_len % 2 != 0) {
-        ctx->error = make_error(ctx, line_num, col,
-                               "Odd number of hex digits in byte literal");
-        free(hex);
-        return NULL;
+    if (meh_eq(s, "nan") || meh_eq(s, "infinity") || meh_eq(s, "-infinity")) {
+        meh_value_t *v = meh_value_new(ctx, MEH_FLOAT);
+        if (v) v->text = s;
+        return v;
     }
-    
-    yay_value_t *v = yay_bytes_from_hex(hex);
-    free(hex);
+
+    /* Bare identifier: carry it as a double-quoted string */
+    char *quoted = meh_alloc(ctx, s.len + 2);
+    if (!quoted) return NULL;
+    quoted[0] = '"';
+    memcpy(quoted + 1, s.ptr, s.len);
+    quoted[s.len + 1] = '"';
+    meh_value_t *v = meh_value_new(ctx, MEH_STRING);
+    if (v) v->text = meh_slice(quoted, s.len + 2);
     return v;
 }
 
-/* ============================================================================
- * Comment Handling
- * ============================================================================ */
-
-/* Strip inline comment from a string (modifies in place, returns pointer to start) */
-static char *strip_inline_comment(char *s) {
-    int in_double = 0;
-    int in_single = 0;
-    int escape = 0;
-    
-    for (char *p = s; *p; p++) {
-        if (escape) {
-            escape = 0;
-            continue;
-        }
-        if (*p == '\\') {
-            escape = 1;
+static meh_block_t *meh_parse_block(meh_ctx_t *ctx, size_t parent_indent) {
+    meh_block_t *block = meh_block_new(ctx);
+    if (!block) return NULL;
+    while (ctx->line_idx < ctx->line_count) {
+        meh_str_t line = ctx->lines[ctx->line_idx];
+        if (!meh_trim(line).len) {
+            /* Keep interior blank lines, but leave boundary blanks to the
+             * parent: peek at the next non-blank line's indent */
+            size_t peek = ctx->line_idx + 1;
+            while (peek < ctx->line_count &&
+                   !meh_trim(ctx->lines[peek]).len) {
+                peek++;
+            }
+            if (peek < ctx->line_count &&
+                meh_indent_of(ctx->lines[peek]) <= parent_indent) {
+                break;
+            }
+            ctx->line_idx++;
+            if (!meh_block_push(ctx, block,
+                                meh_item_new(ctx, MEH_ITEM_BLANK))) {
+                break;
+            }
             continue;
         }
-        if (*p == '"' && !in_single) {
-            in_double = !in_double;
-        } else if (*p == '\'' && !in_double) {
-            in_single = !in_single;
-        } else if (*p == '#' && !in_double && !in_single) {
-            /* Trim trailing whitespace before comment */
-            char *end = p;
-            while (end > s && *(end-1) == ' ') end--;
-            *end = '\0';
-            return s;
-        }
+        if (meh_indent_of(line) <= parent_indent) break;
+        meh_item_t *item = meh_parse_item(ctx, meh_indent_of(line));
+        if (!item || !meh_block_push(ctx, block, item)) break;
     }
-    return s;
-}
-
-/* ============================================================================
- * Scalar Parsing
- * ============================================================================ */
-
-static yay_value_t *parse_scalar_impl(parse_ctx_t *ctx, const char *s,
-                                       int line_num, int col);
-
-static yay_value_t *parse_scalar(parse_ctx_t *ctx, const char *s,
-                                  int line_num, int col) {
-    /* Strip inline comments first */
-    char *s_copy = str_dup(s);
-    strip_inline_comment(s_copy);
-    yay_value_t *result = parse_scalar_impl(ctx, s_copy, line_num, col);
-    free(s_copy);
-    return result;
+    return block;
 }
 
-static yay_value_t *parse_scalar_impl(parse_ctx_t *ctx, const char *s,
-                                       int line_num, int col) {
-    /* Keywords */
-    if (strcmp(s, "null") == 0) return yay_null();
-    if (strcmp(s, "true") == 0) return yay_bool(true);
-    if (strcmp(s, "false") == 0) return yay_bool(false);
-    if (strcmp(s, "nan") == 0) return yay_float(NAN);
-    if (strcmp(s, "infinity") == 0) return yay_float(INFINITY);
-    if (strcmp(s, "-infinity") == 0) return yay_float(-INFINITY);
-    
-    /* Numbers */
-    if (is_float_str(s)) {
-        return parse_number_with_validation(ctx, s, line_num, col);
-    }
-    if (is_integer_str(s)) {
-        return parse_number_with_validation(ctx, s, line_num, col);
-    }
-    
-    /* Double-quoted string */
-    if (s[0] == '"') {
-        size_t slen = strlen(s);
-        if (slen < 2 || s[slen-1] != '"') {
-            /* Unterminated string - report at end of string */
-            ctx->error = make_error(ctx, line_num, col + (int)(slen > 0 ? slen - 1 : 0),
-                                   "Unterminated string");
-            return NULL;
+static void meh_parse_block_string_lines(meh_ctx_t *ctx, meh_value_t *v,
+                                         size_t parent_indent) {
+    while (ctx->line_idx < ctx->line_count) {
+        meh_str_t line = ctx->lines[ctx->line_idx];
+        meh_text_line_t entry;
+        if (!meh_trim(line).len) {
+            entry.indent = 0;
+            entry.content = meh_empty();
+        } else {
+            size_t indent = meh_indent_of(line);
+            if (indent <= parent_indent) break;
+            entry.indent = indent;
+            entry.content = meh_drop(line, indent);
         }
-        return parse_double_quoted_string(ctx, s, line_num, col);
-    }
-    
-    /* Single-quoted string */
-    if (s[0] == '\'') {
-        size_t slen = strlen(s);
-        if (slen < 2 || s[slen-1] != '\'') {
-            /* Unterminated string - report at end of string */
-            ctx->error = make_error(ctx, line_num, col + (int)(slen > 0 ? slen - 1 : 0),
-                                   "Unterminated string");
-            return NULL;
+        if (!meh_reserve(ctx, &v->block_string.lines, sizeof(meh_text_line_t),
+                         v->block_string.count, &v->block_string.capacity)) {
+            break;
         }
-        return parse_single_quoted_string(s);
+        v->block_string.lines[v->block_string.count++] = entry;
+        ctx->line_idx++;
     }
-    
-    /* Inline array - must close on same line */
-    if (s[0] == '[') {
-        if (!strchr(s, ']')) {
-            ctx->error = make_error(ctx, line_num, col,
-                                   "Unexpected newline in inline array");
-            return NULL;
+}
+
+static meh_value_t *meh_parse_block_string(meh_ctx_t *ctx, bool has_first,
+                                           meh_str_t first, size_t indent) {
+    meh_value_t *v = meh_value_new(ctx, MEH_BLOCK_STRING);
+    if (!v) return NULL;
+    v->block_string.has_first = has_first;
+    v->block_string.first = first;
+    meh_parse_block_string_lines(ctx, v, indent);
+    return v;
+}
+
+static void meh_parse_block_bytes_lines(meh_ctx_t *ctx, meh_value_t *v,
+                                        size_t parent_indent) {
+    while (ctx->line_idx < ctx->line_count) {
+        meh_str_t line = ctx->lines[ctx->line_idx];
+        if (!meh_trim(line).len) break;
+        size_t indent = meh_indent_of(line);
+        if (indent <= parent_indent) break;
+        meh_str_t content = meh_drop(line, indent);
+        meh_hex_line_t entry;
+        memset(&entry, 0, sizeof(entry));
+        entry.indent = indent;
+        if (content.ptr[0] == '#') {
+            /* Standalone comment: an empty-hex line carrying the text */
+            entry.comment.present = true;
+            entry.comment.text = meh_drop(content, 1);
+        } else {
+            entry.hex = meh_split_comment(content, &entry.comment);
         }
-        return parse_inline_array(ctx, s, line_num, col);
+        if (!meh_bytes_push(ctx, v, entry)) break;
+        ctx->line_idx++;
     }
-    
-    /* Inline object - must close on same line */
-    if (s[0] == '{') {
-        if (!strchr(s, '}')) {
-            ctx->error = make_error(ctx, line_num, col,
-                                   "Unexpected newline in inline object");
-            return NULL;
+}
+
+/* Parse a '>' block. The caller has consumed the opener line; after is
+ * everything following "> " on it (empty when the '>' stood alone). Hex
+ * on the opener line becomes the block's first line so the formatter can
+ * choose where to put it. */
+static meh_value_t *meh_parse_block_bytes(meh_ctx_t *ctx, meh_str_t after,
+                                          size_t indent) {
+    meh_value_t *v = meh_value_new(ctx, MEH_BLOCK_BYTES);
+    if (!v) return NULL;
+    bool first_hex = false;
+    meh_str_t hex = meh_empty();
+    meh_comment_t first_comment;
+    memset(&first_comment, 0, sizeof(first_comment));
+    if (after.len) {
+        meh_str_t lead = meh_trim_start(after);
+        if (lead.len && lead.ptr[0] == '#') {
+            first_comment.present = true;
+            first_comment.text = meh_drop(lead, 1);
+        } else if (meh_trim(after).len) {
+            hex = meh_trim(meh_split_comment(after, &first_comment));
+            first_hex = true;
         }
-        /* Validate inline syntax first */
-        if (!validate_inline_syntax(ctx, s, line_num, col)) {
-            return NULL;
+    }
+    v->block_bytes.first_comment = first_comment;
+    meh_parse_block_bytes_lines(ctx, v, indent);
+    if (first_hex) {
+        if (!meh_reserve(ctx, &v->block_bytes.lines, sizeof(meh_hex_line_t),
+                         v->block_bytes.count, &v->block_bytes.capacity)) {
+            return v;
         }
-        size_t consumed;
-        return parse_inline_value_impl(ctx, s, &consumed, line_num, col);
+        memmove(v->block_bytes.lines + 1, v->block_bytes.lines,
+                v->block_bytes.count * sizeof(meh_hex_line_t));
+        v->block_bytes.lines[0].indent = indent;
+        v->block_bytes.lines[0].hex = hex;
+        v->block_bytes.lines[0].comment = first_comment;
+        v->block_bytes.count++;
+        memset(&v->block_bytes.first_comment, 0,
+               sizeof(v->block_bytes.first_comment));
     }
-    
-    /* Inline bytes */
-    if (s[0] == '<') {
-        yay_value_t *bytes = parse_angle_bytes(ctx, s, line_num, col);
-        if (ctx->error) {
-            return NULL;
+    return v;
+}
+
+/* Parse an array item nested on a dash line (e.g. the "- a" of "- - a");
+ * consumes no source lines */
+static meh_item_t *meh_parse_nested_array_item(meh_ctx_t *ctx,
+                                               meh_str_t content) {
+    meh_str_t after_dash =
+        meh_starts(content, "- ") ? meh_drop(content, 2) : meh_empty();
+    meh_item_t *item = meh_item_new(ctx, MEH_ITEM_ARRAY_ITEM);
+    if (!item) return NULL;
+    meh_str_t value_part = meh_split_comment(after_dash, &item->comment);
+    if (!value_part.len) return item;
+
+    meh_item_t *nested = NULL;
+    if (meh_eq(value_part, "-") || meh_starts(value_part, "- ")) {
+        nested = meh_parse_nested_array_item(ctx, value_part);
+    } else if (meh_find_colon(value_part) < 0) {
+        item->value = meh_parse_inline_value(ctx, value_part);
+        return item;
+    }
+    if (!nested) {
+        long colon = meh_find_colon(value_part);
+        nested = meh_item_new(ctx, MEH_ITEM_PROPERTY);
+        if (!nested || colon < 0) return item;
+        nested->key = meh_trim(meh_slice(value_part.ptr, (size_t)colon));
+        meh_str_t rest =
+            meh_trim_start(meh_drop(value_part, (size_t)colon + 1));
+        meh_str_t value_str = meh_split_comment(rest, &nested->comment);
+        if (value_str.len) {
+            nested->value = meh_parse_inline_value(ctx, value_str);
         }
-        return bytes;
     }
-    
-    /* Bare words are not valid - strings must be quoted */
-    char first_char = s[0] ? s[0] : '?';
-    char msg[64];
-    snprintf(msg, sizeof(msg), "Unexpected character \"%c\"", first_char);
-    ctx->error = make_error(ctx, line_num, col, msg);
-    return NULL;
+    meh_block_t *block = meh_block_new(ctx);
+    if (block && meh_block_push(ctx, block, nested)) item->block = block;
+    return item;
 }
 
-/* ============================================================================
- * Object Parsing
- * ============================================================================ */
+static meh_item_t *meh_parse_array_item(meh_ctx_t *ctx, size_t indent) {
+    meh_str_t content = meh_drop(ctx->lines[ctx->line_idx], indent);
+    meh_str_t after_dash =
+        meh_starts(content, "- ") ? meh_drop(content, 2) : meh_empty();
+    meh_item_t *item = meh_item_new(ctx, MEH_ITEM_ARRAY_ITEM);
+    if (!item) return NULL;
+    meh_str_t value_part = meh_split_comment(after_dash, &item->comment);
+    ctx->line_idx++;
+
+    if (!value_part.len) {
+        meh_block_t *block = meh_parse_block(ctx, indent);
+        if (block && block->count) item->block = block;
+    } else if (meh_eq(value_part, "`") || meh_starts(value_part, "` ")) {
+        bool has_first = meh_starts(value_part, "` ");
+        item->value = meh_parse_block_string(
+            ctx, has_first, has_first ? meh_drop(value_part, 2) : meh_empty(),
+            indent);
+    } else if (meh_eq(value_part, "-") || meh_starts(value_part, "- ")) {
+        /* Nested array item on the same line ("- - a"); siblings of the
+         * nested item continue on the following lines */
+        meh_item_t *nested = meh_parse_nested_array_item(ctx, value_part);
+        meh_block_t *block = meh_block_new(ctx);
+        if (!block || !meh_block_push(ctx, block, nested)) return item;
+        meh_block_t *siblings = meh_parse_block(ctx, indent);
+        if (siblings) {
+            for (size_t i = 0; i < siblings->count; i++) {
+                meh_block_push(ctx, block, siblings->items[i]);
+            }
+        }
+        item->block = block;
+    } else {
+        long colon = meh_find_colon(value_part);
+        if (colon >= 0) {
+            /* Nested property on the same line ("- a: 1") */
+            meh_item_t *nested = meh_item_new(ctx, MEH_ITEM_PROPERTY);
+            if (!nested) return item;
+            nested->key = meh_trim(meh_slice(value_part.ptr, (size_t)colon));
+            meh_str_t rest =
+                meh_trim_start(meh_drop(value_part, (size_t)colon + 1));
+            meh_str_t value_str = meh_split_comment(rest, &nested->comment);
+            if (value_str.len) {
+                nested->value = meh_parse_inline_value(ctx, value_str);
+            } else {
+                meh_block_t *prop_block = meh_parse_block(ctx, indent + 2);
+                if (prop_block && prop_block->count) {
+                    nested->block = prop_block;
+                }
+            }
+            meh_block_t *block = meh_block_new(ctx);
+            if (!block || !meh_block_push(ctx, block, nested)) return item;
+            meh_block_t *siblings = meh_parse_block(ctx, indent);
+            if (siblings) {
+                for (size_t i = 0; i < siblings->count; i++) {
+                    meh_block_push(ctx, block, siblings->items[i]);
+                }
+            }
+            item->block = block;
+        } else {
+            item->value = meh_parse_inline_value(ctx, value_part);
+        }
+    }
+    return item;
+}
 
-static yay_value_t *parse_nested_object(parse_ctx_t *ctx, size_t *idx, 
-                                         int base_indent);
+static meh_item_t *meh_parse_property(meh_ctx_t *ctx, size_t indent,
+                                      size_t colon_idx) {
+    meh_str_t content = meh_drop(ctx->lines[ctx->line_idx], indent);
+    meh_item_t *item = meh_item_new(ctx, MEH_ITEM_PROPERTY);
+    if (!item) return NULL;
+    item->key = meh_trim(meh_slice(content.ptr, colon_idx));
+    meh_str_t value_part =
+        meh_trim_start(meh_drop(content, colon_idx + 1));
+    meh_str_t value_str = meh_split_comment(value_part, &item->comment);
+    ctx->line_idx++;
 
-static yay_value_t *parse_object_property_value(parse_ctx_t *ctx, size_t *idx,
-                                                 token_t *t, const char *v_part,
-                                                 int v_col) {
-    /* Empty object */
-    if (strcmp(v_part, "{}") == 0) {
-        (*idx)++;
-        return yay_object();
+    if (!value_str.len) {
+        meh_block_t *block = meh_parse_block(ctx, indent);
+        if (block && block->count) item->block = block;
+    } else if (meh_eq(value_str, "`")) {
+        item->value = meh_parse_block_string(ctx, false, meh_empty(), indent);
+    } else if (meh_eq(value_str, ">") || meh_starts(value_str, "> ")) {
+        meh_str_t after = meh_starts(value_str, "> ") ? meh_drop(value_str, 2)
+                                                      : meh_empty();
+        item->value = meh_parse_block_bytes(ctx, after, indent);
+    } else {
+        item->value = meh_parse_inline_value(ctx, value_str);
     }
-    
-    /* Block string starting on same line: key: ` content */
-    if (v_part[0] == '`') {
-        /* In property context, block leader must be alone or followed by newline */
-        if (strlen(v_part) > 1) {
-            ctx->error = calloc(1, sizeof(yay_error_t));
-            ctx->error->message = str_dup("Expected newline after block leader in property");
-            return NULL;
+    return item;
+}
+
+static meh_item_t *meh_parse_item(meh_ctx_t *ctx, size_t min_indent) {
+    if (ctx->line_idx >= ctx->line_count) return NULL;
+    meh_str_t line = ctx->lines[ctx->line_idx];
+    if (!meh_trim(line).len) {
+        ctx->line_idx++;
+        return meh_item_new(ctx, MEH_ITEM_BLANK);
+    }
+    size_t indent = meh_indent_of(line);
+    if (indent < min_indent) return NULL;
+    meh_str_t content = meh_drop(line, indent);
+
+    if (content.ptr[0] == '#') {
+        meh_item_t *item = meh_item_new(ctx, MEH_ITEM_COMMENT);
+        if (item) {
+            item->comment.present = true;
+            item->comment.text = meh_drop(content, 1);
+        }
+        ctx->line_idx++;
+        return item;
+    }
+    if (meh_starts(content, "- ") || meh_eq(content, "-")) {
+        return meh_parse_array_item(ctx, indent);
+    }
+    long colon = meh_find_colon(content);
+    if (colon >= 0) return meh_parse_property(ctx, indent, (size_t)colon);
+    if (meh_eq(content, "`") || meh_starts(content, "` ")) {
+        bool has_first = meh_starts(content, "` ");
+        ctx->line_idx++;
+        meh_item_t *item = meh_item_new(ctx, MEH_ITEM_VALUE);
+        meh_value_t *v = meh_parse_block_string(
+            ctx, has_first, has_first ? meh_drop(content, 2) : meh_empty(),
+            indent);
+        if (item) item->value = v;
+        return item;
+    }
+    if (meh_eq(content, ">") || meh_starts(content, "> ")) {
+        meh_str_t after =
+            meh_starts(content, "> ") ? meh_drop(content, 2) : meh_empty();
+        ctx->line_idx++;
+        meh_item_t *item = meh_item_new(ctx, MEH_ITEM_VALUE);
+        meh_value_t *v = meh_parse_block_bytes(ctx, after, indent);
+        if (item) item->value = v;
+        return item;
+    }
+    meh_item_t *item = meh_item_new(ctx, MEH_ITEM_VALUE);
+    if (item) item->value = meh_parse_inline_value(ctx, content);
+    ctx->line_idx++;
+    return item;
+}
+
+static meh_block_t *meh_parse_meh(meh_ctx_t *ctx) {
+    meh_block_t *doc = meh_block_new(ctx);
+    if (!doc) return NULL;
+    while (ctx->line_idx < ctx->line_count && !ctx->oom) {
+        meh_item_t *item = meh_parse_item(ctx, 0);
+        if (!item || !meh_block_push(ctx, doc, item)) break;
+    }
+    return doc;
+}
+
+/* ---- Normalization ---- */
+
+/* Width of a number once space runs collapse to one and ends are trimmed */
+static size_t meh_number_width(meh_str_t s) {
+    size_t len = 0, trailing = 0;
+    bool prev_space = false;
+    for (size_t i = 0; i < s.len; i++) {
+        if (s.ptr[i] == ' ') {
+            if (!prev_space && len) {
+                len++;
+                trailing++;
+                prev_space = true;
+            }
+        } else {
+            len++;
+            trailing = 0;
+            prev_space = false;
         }
-        /* Block leader alone - content starts on next line */
-        return parse_property_block_string_indent(ctx, idx, "", t->indent);
     }
-    
-    /* Block bytes starting on same line: key: > hex */
-    if (v_part[0] == '>' && !strchr(v_part, '<')) {
-        /* In property context, block leader can be followed by comment but not hex */
-        if (strlen(v_part) > 1) {
-            /* Check if it's just whitespace and/or comment */
-            const char *after_leader = v_part + 1;
-            while (*after_leader == ' ') after_leader++;
-            if (*after_leader != '\0' && *after_leader != '#') {
-                /* Has non-comment content on same line */
-                ctx->error = calloc(1, sizeof(yay_error_t));
-                ctx->error->message = str_dup("Expected newline after block leader in property");
-                return NULL;
+    return len - trailing;
+}
+
+static meh_str_t meh_normalize_number(meh_ctx_t *ctx, meh_str_t s) {
+    size_t width = meh_number_width(s);
+    char *out = meh_alloc(ctx, width ? width : 1);
+    if (!out) return s;
+    size_t len = 0;
+    bool prev_space = false;
+    for (size_t i = 0; i < s.len && len < width; i++) {
+        char c = s.ptr[i];
+        if (c == ' ') {
+            if (!prev_space && len) {
+                out[len++] = ' ';
+                prev_space = true;
             }
+        } else {
+            out[len++] = c;
+            prev_space = false;
         }
-        return parse_property_block_bytes(ctx, idx, v_part);
     }
-    
-    /* Note: "key: <" without closing ">" is invalid - inline byte arrays must be closed on the same line */
-    
-    /* Inline value */
-    if (strlen(v_part) > 0) {
-        (*idx)++;
-        yay_value_t *value = parse_scalar(ctx, v_part, t->line_num, v_col);
-        if (ctx->error) {
-            return NULL;
+    while (len && out[len - 1] == ' ') len--;
+    return meh_slice(out, len);
+}
+
+/* Width of hex content once regrouped: space between bytes, double space
+ * between four-byte words */
+static size_t meh_hex_width(meh_str_t s) {
+    size_t digits = 0;
+    for (size_t i = 0; i < s.len; i++) {
+        if (!meh_is_space(s.ptr[i])) digits++;
+    }
+    if (!digits) return 0;
+    size_t pairs = (digits + 1) / 2;
+    size_t width = digits;
+    for (size_t i = 1; i < pairs; i++) width += (i % 4 == 0) ? 2 : 1;
+    return width;
+}
+
+static meh_str_t meh_normalize_hex(meh_ctx_t *ctx, meh_str_t s) {
+    size_t width = meh_hex_width(s);
+    if (!width) return meh_empty();
+    char *out = meh_alloc(ctx, width);
+    if (!out) return meh_empty();
+    size_t len = 0, pair = 0, in_pair = 0;
+    for (size_t i = 0; i < s.len; i++) {
+        char c = s.ptr[i];
+        if (meh_is_space(c)) continue;
+        if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+        if (!in_pair && pair) {
+            out[len++] = ' ';
+            if (pair % 4 == 0) out[len++] = ' ';
+        }
+        out[len++] = c;
+        if (++in_pair == 2) {
+            in_pair = 0;
+            pair++;
         }
-        return value;
     }
-    
-    /* Nested content */
-    int colon_idx = find_colon_outside_quotes(t->text);
-    (*idx)++;
-    size_t j = skip_breaks_and_stops(ctx, *idx);
-    
-    if (j >= ctx->token_count) {
-        /* Empty property with no nested content is invalid */
-        ctx->error = make_error(ctx, t->line_num, t->col + colon_idx + 1,
-                               "Expected value after property");
-        return NULL;
+    return meh_slice(out, len);
+}
+
+/* Render a finite double the way the reference formatter does: shortest
+ * Grisu2 digits placed positionally and exponentially (bare exponent, no
+ * '+' or zero padding), the shorter form wins with ties going to the
+ * positional one, and a trailing ".0" marks integral values as floats. */
+static meh_str_t meh_float_text(meh_ctx_t *ctx, double value) {
+    char positional[352];   /* Densest case: ~0.<323 zeros><17 digits> */
+    char exponential[32];
+    char digits[18];
+    int len = 1, kk = 1;
+
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bool negative = bits >> 63;
+    if (negative) value = -value;
+
+    digits[0] = '0';
+    if (value != 0) {
+        int K = 0;
+        grisu2(value, digits, &len, &K);
+        kk = len + K;
     }
-    
-    token_t *next_t = &ctx->tokens[j];
-    
-    /* Named array - pass next_t->indent so array stops at items below this level */
-    if (next_t->type == TOKEN_START && strcmp(next_t->text, "- ") == 0) {
-        *idx = j;
-        return parse_multiline_array_impl(ctx, idx, next_t->indent);
+
+    char *p = positional;
+    if (negative) *p++ = '-';
+    if (value == 0) {
+        *p++ = '0';
+    } else if (kk <= 0) {
+        *p++ = '0';
+        *p++ = '.';
+        for (int i = 0; i < -kk; i++) *p++ = '0';
+        memcpy(p, digits, (size_t)len);
+        p += len;
+    } else if (kk >= len) {
+        memcpy(p, digits, (size_t)len);
+        p += len;
+        for (int i = len; i < kk; i++) *p++ = '0';
+    } else {
+        memcpy(p, digits, (size_t)kk);
+        p += kk;
+        *p++ = '.';
+        memcpy(p, digits + kk, (size_t)(len - kk));
+        p += len - kk;
     }
-    
-    /* Note: Block string/bytes leaders must be on the same line as the property key */
-    /* Block string leader on next line is invalid */
-    if (next_t->type == TOKEN_TEXT && strcmp(next_t->text, "`") == 0) {
-        ctx->error = make_error(ctx, next_t->line_num, 0, "Unexpected indent");
-        return NULL;
+    size_t positional_len = (size_t)(p - positional);
+
+    char *x = exponential;
+    if (negative) *x++ = '-';
+    *x++ = digits[0];
+    if (len > 1) {
+        *x++ = '.';
+        memcpy(x, digits + 1, (size_t)(len - 1));
+        x += len - 1;
+    }
+    *x++ = 'e';
+    int e10 = kk - 1;
+    if (e10 < 0) {
+        *x++ = '-';
+        e10 = -e10;
+    }
+    x += format_uint64((uint64_t)e10, x);
+    size_t exponential_len = (size_t)(x - exponential);
+
+    const char *chosen = positional;
+    size_t chosen_len = positional_len;
+    if (exponential_len < positional_len) {
+        chosen = exponential;
+        chosen_len = exponential_len;
     }
-    
-    /* Block bytes leader on next line is invalid */
-    if (next_t->type == TOKEN_TEXT && next_t->text[0] == '>' && 
-        !strchr(next_t->text, '<')) {
-        ctx->error = make_error(ctx, next_t->line_num, 0, "Unexpected indent");
-        return NULL;
+
+    bool marked = false;
+    for (size_t i = 0; i < chosen_len; i++) {
+        if (chosen[i] == '.' || chosen[i] == 'e') {
+            marked = true;
+            break;
+        }
     }
-    
-    /* Note: "key: <" without closing ">" is invalid - inline byte arrays must be closed on the same line */
-    
-    /* Reject inline values on separate line (they look like keys starting with special chars) */
-    if (next_t->type == TOKEN_TEXT && next_t->indent > t->indent) {
-        const char *trimmed = next_t->text;
-        while (*trimmed == ' ') trimmed++;
-        if (trimmed[0] == '[' || trimmed[0] == '{' || trimmed[0] == '<') {
-            ctx->error = make_error(ctx, next_t->line_num, 0, "Unexpected indent");
-            return NULL;
+    char *out = meh_alloc(ctx, chosen_len + 2);
+    if (!out) return meh_slice("0.0", 3);
+    memcpy(out, chosen, chosen_len);
+    if (!marked) {
+        out[chosen_len++] = '.';
+        out[chosen_len++] = '0';
+    }
+    return meh_slice(out, chosen_len);
+}
+
+static meh_str_t meh_canonical_float(meh_ctx_t *ctx, meh_str_t s) {
+    if (meh_eq(s, "nan") || meh_eq(s, "infinity") || meh_eq(s, "-infinity")) {
+        return s;
+    }
+    /* Strip digit-group spaces and reparse; unparseable text survives
+     * untouched */
+    char *compact = meh_alloc(ctx, s.len + 1);
+    if (!compact) return s;
+    size_t n = 0;
+    for (size_t i = 0; i < s.len; i++) {
+        if (s.ptr[i] != ' ') compact[n++] = s.ptr[i];
+    }
+    compact[n] = '\0';
+    char *end = NULL;
+    double value = strtod(compact, &end);
+    if (!n || !end || *end != '\0') return s;
+    if (isnan(value)) return meh_slice("nan", 3);
+    if (isinf(value)) {
+        return value > 0 ? meh_slice("infinity", 8)
+                         : meh_slice("-infinity", 9);
+    }
+    return meh_float_text(ctx, value);
+}
+
+/* ---- Canonical transform ---- */
+
+static size_t meh_measure_value(const meh_value_t *v);
+
+static size_t meh_measure_array(const meh_value_t *v) {
+    size_t total = 2;   /* [ and ] */
+    for (size_t i = 0; i < v->array.count; i++) {
+        if (i) total += 2;
+        size_t width = meh_measure_value(v->array.items[i]);
+        if (width == MEH_MULTILINE) return MEH_MULTILINE;
+        total += width;
+    }
+    return total;
+}
+
+static size_t meh_measure_object(const meh_value_t *v) {
+    size_t total = 2;   /* { and } */
+    for (size_t i = 0; i < v->object.count; i++) {
+        if (i) total += 2;
+        size_t width = meh_measure_value(v->object.entries[i].value);
+        if (width == MEH_MULTILINE) return MEH_MULTILINE;
+        total += v->object.entries[i].key.len + 2 + width;
+    }
+    return total;
+}
+
+static size_t meh_measure_value(const meh_value_t *v) {
+    switch (v->kind) {
+        case MEH_NULL: return 4;
+        case MEH_BOOL: return v->boolean ? 4 : 5;
+        case MEH_INT: return meh_number_width(v->text);
+        case MEH_FLOAT: return v->text.len;
+        case MEH_STRING: return v->text.len;
+        case MEH_BYTES: return meh_hex_width(v->text) + 2;
+        case MEH_BLOCK_STRING:
+        case MEH_BLOCK_BYTES: return MEH_MULTILINE;
+        case MEH_ARRAY: return meh_measure_array(v);
+        case MEH_OBJECT: return meh_measure_object(v);
+    }
+    return 0;
+}
+
+static meh_str_t meh_word_first(meh_str_t s) {
+    s = meh_trim_start(s);
+    size_t i = 0;
+    while (i < s.len && !meh_is_space(s.ptr[i])) i++;
+    return meh_slice(s.ptr, i);
+}
+
+static meh_str_t meh_word_last(meh_str_t s) {
+    s = meh_trim_end(s);
+    size_t i = s.len;
+    while (i > 0 && !meh_is_space(s.ptr[i - 1])) i--;
+    return meh_drop(s, i);
+}
+
+static bool meh_word_capital(meh_str_t word) {
+    return word.len && word.ptr[0] >= 'A' && word.ptr[0] <= 'Z';
+}
+
+/* Join heuristic shared by comment merging and wrapping: continue unless
+ * the previous text ends a sentence, where a period between two
+ * capitalized words ("Mr. Smith") does not count as one */
+static bool meh_should_join(meh_str_t prev, meh_str_t next) {
+    prev = meh_trim_end(prev);
+    if (!prev.len) return false;
+    char last = prev.ptr[prev.len - 1];
+    if (last != '.' && last != '!' && last != '?') return true;
+    return last == '.' && meh_word_capital(meh_word_last(prev)) &&
+           meh_word_capital(meh_word_first(next));
+}
+
+/* Merge continuation comment lines (no hex) into the comment above */
+static void meh_join_hex_comments(meh_ctx_t *ctx, meh_value_t *v) {
+    meh_hex_line_t *lines = v->block_bytes.lines;
+    size_t count = v->block_bytes.count;
+    size_t out = 0;
+    for (size_t i = 0; i < count; i++) {
+        meh_hex_line_t line = lines[i];
+        bool join = !line.hex.len && line.comment.present && out &&
+                    lines[out - 1].comment.present &&
+                    meh_should_join(lines[out - 1].comment.text,
+                                    line.comment.text);
+        if (join) {
+            meh_str_t prev = meh_trim_end(lines[out - 1].comment.text);
+            meh_str_t next = meh_trim(line.comment.text);
+            char *joined = meh_alloc(ctx, prev.len + 1 + next.len);
+            if (!joined) {
+                lines[out++] = line;
+                continue;
+            }
+            memcpy(joined, prev.ptr, prev.len);
+            joined[prev.len] = ' ';
+            memcpy(joined + prev.len + 1, next.ptr, next.len);
+            lines[out - 1].comment.text =
+                meh_slice(joined, prev.len + 1 + next.len);
+        } else {
+            lines[out++] = line;
         }
-        /* Reject numbers on separate line */
-        if ((trimmed[0] >= '0' && trimmed[0] <= '9') || 
-            (trimmed[0] == '-' && trimmed[1] >= '0' && trimmed[1] <= '9') ||
-            (trimmed[0] == '.' && trimmed[1] >= '0' && trimmed[1] <= '9')) {
-            ctx->error = make_error(ctx, next_t->line_num, 0, "Unexpected indent");
-            return NULL;
+    }
+    v->block_bytes.count = out;
+}
+
+/* Align comments to two past the widest commented hex line; standalone
+ * comments inherit the column of the comment above them */
+static void meh_align_hex_comments(meh_value_t *v, size_t indent) {
+    size_t max_hex = 0;
+    for (size_t i = 0; i < v->block_bytes.count; i++) {
+        meh_hex_line_t *line = &v->block_bytes.lines[i];
+        if (line->comment.present && line->hex.len > max_hex) {
+            max_hex = line->hex.len;
         }
     }
-    
-    /* Concatenated quoted strings (multiple quoted strings on consecutive lines) */
-    if (next_t->type == TOKEN_TEXT && next_t->indent > t->indent) {
-        const char *trimmed = next_t->text;
-        while (*trimmed == ' ') trimmed++;
-        size_t trimmed_len = strlen(trimmed);
-        bool is_double_quoted = trimmed_len >= 2 && trimmed[0] == '"' && trimmed[trimmed_len-1] == '"';
-        bool is_single_quoted = trimmed_len >= 2 && trimmed[0] == '\'' && trimmed[trimmed_len-1] == '\'';
-        
-        if (is_double_quoted || is_single_quoted) {
-            *idx = j;
-            yay_value_t *result = parse_concatenated_strings(ctx, idx, next_t->indent);
-            if (result != NULL) {
-                return result;
+    if (!max_hex) return;
+    size_t align_col = (indent + 1) * 2 + max_hex + 2;
+    size_t last = 0;
+    for (size_t i = 0; i < v->block_bytes.count; i++) {
+        meh_hex_line_t *line = &v->block_bytes.lines[i];
+        if (line->hex.len) {
+            if (line->comment.present) {
+                line->comment.align_column = align_col;
+                last = align_col;
             }
-            /* Single string on new line is invalid - fall through to error */
-            ctx->error = make_error(ctx, next_t->line_num, 0, "Unexpected indent");
-            return NULL;
+        } else if (line->comment.present && last) {
+            line->comment.align_column = last;
         }
     }
-    
-    /* Nested object */
-    if (next_t->type == TOKEN_TEXT && next_t->indent > t->indent) {
-        *idx = j;
-        return parse_nested_object(ctx, idx, next_t->indent);
-    }
-    
-    /* Empty property with no nested content is invalid */
-    ctx->error = make_error(ctx, t->line_num, t->col + colon_idx + 1,
-                           "Expected value after property");
-    return NULL;
 }
 
-/* Validate object property syntax (whitespace around colon, key characters) */
-static bool validate_object_property(parse_ctx_t *ctx, const char *text, 
-                                      int colon_idx, int line_num, int col) {
-    /* Check for space before colon */
-    if (colon_idx > 0 && text[colon_idx - 1] == ' ') {
-        ctx->error = make_error(ctx, line_num, col + colon_idx - 1,
-                               "Unexpected space before \":\"");
-        return false;
-    }
-    
-    /* Check for space after colon */
-    const char *after_colon = text + colon_idx + 1;
-    if (*after_colon == '\0') {
-        /* Colon at end of line - that's ok (block value follows) */
-    } else if (*after_colon != ' ') {
-        ctx->error = make_error(ctx, line_num, col + colon_idx,
-                               "Expected space after \":\"");
-        return false;
-    } else if (after_colon[0] == ' ' && after_colon[1] == ' ') {
-        ctx->error = make_error(ctx, line_num, col + colon_idx + 2,
-                               "Unexpected space after \":\"");
-        return false;
+/* Wrap comment text at word boundaries. Sentence ends are the preferred
+ * break points, abbreviation pairs travel together, and "- " bullets get
+ * a hanging indent. Returns the number of lines written to *out. */
+static size_t meh_wrap_comment(meh_ctx_t *ctx, meh_str_t text,
+                               size_t max_width, meh_str_t **out) {
+    meh_str_t *lines = NULL;
+    size_t count = 0, capacity = 0;
+    *out = NULL;
+
+    bool leading_space = text.len && text.ptr[0] == ' ';
+    meh_str_t trimmed = meh_trim(text);
+    if (trimmed.len <= max_width) {
+        if (!meh_reserve(ctx, &lines, sizeof(meh_str_t), count, &capacity)) {
+            return 0;
+        }
+        lines[count++] = text;
+        *out = lines;
+        return count;
     }
-    
-    /* Validate key characters for unquoted keys */
-    if (text[0] != '"' && text[0] != '\'') {
-        for (int ki = 0; ki < colon_idx; ki++) {
-            char kc = text[ki];
-            if (!isalnum(kc) && kc != '_' && kc != '-') {
-                ctx->error = make_error(ctx, line_num, col + ki,
-                                       "Invalid key character");
-                return false;
+
+    bool bullet = meh_starts(trimmed, "- ");
+    meh_str_t content = bullet ? meh_drop(trimmed, 2) : trimmed;
+    size_t prefix = bullet ? 2 : 0;
+
+    /* Word list */
+    meh_str_t *words = NULL;
+    size_t word_count = 0, word_capacity = 0;
+    for (size_t i = 0; i < content.len;) {
+        while (i < content.len && meh_is_space(content.ptr[i])) i++;
+        size_t start = i;
+        while (i < content.len && !meh_is_space(content.ptr[i])) i++;
+        if (i > start) {
+            if (!meh_reserve(ctx, &words, sizeof(meh_str_t), word_count,
+                             &word_capacity)) {
+                return 0;
             }
+            words[word_count++] = meh_slice(content.ptr + start, i - start);
         }
     }
-    
-    return true;
-}
+    if (!word_count) {
+        if (!meh_reserve(ctx, &lines, sizeof(meh_str_t), count, &capacity)) {
+            return 0;
+        }
+        lines[count++] = meh_empty();
+        *out = lines;
+        return count;
+    }
 
-static yay_value_t *parse_nested_object(parse_ctx_t *ctx, size_t *idx, 
-                                         int base_indent) {
-    yay_value_t *obj = yay_object();
-    
-    while (*idx < ctx->token_count) {
-        token_t *t = &ctx->tokens[*idx];
-        
-        if (t->type == TOKEN_STOP || t->type == TOKEN_BREAK) {
-            (*idx)++;
-            continue;
+    char *current = meh_alloc(ctx, content.len);
+    if (!current) return 0;
+    size_t current_len = 0;
+    size_t current_max = max_width > prefix ? max_width - prefix : 0;
+    meh_str_t break_line = meh_empty();
+    size_t break_idx = 0;
+    bool have_break = false;
+
+    size_t i = 0;
+    while (i < word_count) {
+        meh_str_t word = words[i];
+        bool has_next = i + 1 < word_count;
+        meh_str_t next = has_next ? words[i + 1] : meh_empty();
+        bool abbrev = word.len && word.ptr[word.len - 1] == '.' &&
+                      meh_word_capital(word) && has_next &&
+                      meh_word_capital(next);
+        size_t combined = abbrev ? word.len + 1 + next.len : word.len;
+        size_t addition = current_len ? combined + 1 : combined;
+
+        if (current_len + addition <= current_max || !current_len) {
+            if (current_len) current[current_len++] = ' ';
+            memcpy(current + current_len, word.ptr, word.len);
+            current_len += word.len;
+            if (abbrev) {
+                current[current_len++] = ' ';
+                memcpy(current + current_len, next.ptr, next.len);
+                current_len += next.len;
+            }
+            i += abbrev ? 2 : 1;
+
+            /* Snapshot sentence boundaries as preferred break points */
+            meh_str_t added = abbrev ? next : word;
+            char last = added.len ? added.ptr[added.len - 1] : '\0';
+            bool punct = last == '.' || last == '!' || last == '?';
+            bool pair = last == '.' && meh_word_capital(added) &&
+                        i < word_count && meh_word_capital(words[i]);
+            if (punct && !pair) {
+                char *snap = meh_alloc(ctx, current_len ? current_len : 1);
+                if (snap) {
+                    memcpy(snap, current, current_len);
+                    break_line = meh_slice(snap, current_len);
+                    break_idx = i;
+                    have_break = true;
+                }
+            }
+        } else {
+            meh_str_t done;
+            if (have_break) {
+                done = break_line;
+                i = break_idx;
+                have_break = false;
+            } else {
+                char *copy = meh_alloc(ctx, current_len ? current_len : 1);
+                if (!copy) return 0;
+                memcpy(copy, current, current_len);
+                done = meh_slice(copy, current_len);
+            }
+            if (!meh_reserve(ctx, &lines, sizeof(meh_str_t), count,
+                             &capacity)) {
+                return 0;
+            }
+            lines[count++] = done;
+            current_len = 0;
+            current_max = max_width > prefix ? max_width - prefix : 0;
+        }
+    }
+    if (current_len) {
+        char *copy = meh_alloc(ctx, current_len);
+        if (!copy) return 0;
+        memcpy(copy, current, current_len);
+        if (!meh_reserve(ctx, &lines, sizeof(meh_str_t), count, &capacity)) {
+            return 0;
         }
-        
-        if (t->type != TOKEN_TEXT) {
-            /* START tokens indicate a new list item - break out */
-            break;
+        lines[count++] = meh_slice(copy, current_len);
+    }
+    if (!count) {
+        if (!meh_reserve(ctx, &lines, sizeof(meh_str_t), count, &capacity)) {
+            return 0;
         }
-        
-        int colon_idx = find_colon_outside_quotes(t->text);
-        if (colon_idx < 0 || t->indent < base_indent) {
-            break;
+        lines[count++] = content;
+    }
+
+    /* Re-attach the bullet, hanging indents, and the leading space */
+    for (size_t idx = 0; idx < count; idx++) {
+        size_t lead = (idx == 0 && leading_space) ? 1 : 0;
+        if (!prefix && !lead) continue;
+        meh_str_t line = lines[idx];
+        char *rebuilt = meh_alloc(ctx, lead + prefix + line.len);
+        if (!rebuilt) continue;
+        char *q = rebuilt;
+        if (lead) *q++ = ' ';
+        if (prefix) {
+            memcpy(q, idx == 0 ? "- " : "  ", prefix);
+            q += prefix;
         }
-        
-        /* Validate object property syntax */
-        if (!validate_object_property(ctx, t->text, colon_idx, t->line_num, t->col)) {
-            yay_free(obj);
-            return NULL;
+        memcpy(q, line.ptr, line.len);
+        lines[idx] = meh_slice(rebuilt, lead + prefix + line.len);
+    }
+    *out = lines;
+    return count;
+}
+
+/* Re-split comments that overflow the wrap column onto continuation
+ * lines aligned under the '#' above */
+static void meh_wrap_hex_comments(meh_ctx_t *ctx, meh_value_t *v,
+                                  size_t indent) {
+    size_t indent_width = (indent + 1) * 2;
+    meh_hex_line_t *old = v->block_bytes.lines;
+    size_t count = v->block_bytes.count;
+    meh_hex_line_t *lines = NULL;
+    size_t out = 0, capacity = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        meh_hex_line_t line = old[i];
+        bool wrap = line.hex.len && line.comment.present;
+        size_t align_col = 0;
+        if (wrap) {
+            align_col = line.comment.align_column
+                            ? line.comment.align_column
+                            : indent_width + line.hex.len + 2;
+            wrap = align_col + 1 + line.comment.text.len > ctx->wrap;
         }
-        
-        char *k_raw = str_dup_len(t->text, colon_idx);
-        char *key = parse_key_name(k_raw);
-        free(k_raw);
-        
-        const char *v_part = t->text + colon_idx + 1;
-        int v_col = t->col + colon_idx + 1;
-        while (*v_part == ' ') { v_part++; v_col++; }
-        
-        if (strlen(key) == 0) {
-            free(key);
-            (*idx)++;
-            continue;
+        if (wrap) {
+            size_t available =
+                ctx->wrap > align_col + 1 ? ctx->wrap - (align_col + 1) : 0;
+            meh_str_t *pieces;
+            size_t piece_count =
+                meh_wrap_comment(ctx, line.comment.text, available, &pieces);
+            if (piece_count) {
+                line.comment.text = pieces[0];
+                if (!meh_reserve(ctx, &lines, sizeof(meh_hex_line_t), out,
+                                 &capacity)) {
+                    return;
+                }
+                lines[out++] = line;
+                for (size_t j = 1; j < piece_count; j++) {
+                    char *text = meh_alloc(ctx, pieces[j].len + 1);
+                    if (!text) continue;
+                    text[0] = ' ';
+                    memcpy(text + 1, pieces[j].ptr, pieces[j].len);
+                    meh_hex_line_t continuation;
+                    memset(&continuation, 0, sizeof(continuation));
+                    continuation.indent = line.indent;
+                    continuation.comment.present = true;
+                    continuation.comment.text =
+                        meh_slice(text, pieces[j].len + 1);
+                    continuation.comment.align_column = align_col;
+                    if (!meh_reserve(ctx, &lines, sizeof(meh_hex_line_t),
+                                     out, &capacity)) {
+                        return;
+                    }
+                    lines[out++] = continuation;
+                }
+                continue;
+            }
         }
-        
-        yay_value_t *value = parse_object_property_value(ctx, idx, t, v_part, v_col);
-        if (ctx->error) {
-            free(key);
-            yay_free(obj);
-            return NULL;
+        if (!meh_reserve(ctx, &lines, sizeof(meh_hex_line_t), out,
+                         &capacity)) {
+            return;
         }
-        
-        yay_object_set(obj, key, value);
-        free(key);
+        lines[out++] = line;
     }
-    
-    return obj;
+    v->block_bytes.lines = lines;
+    v->block_bytes.count = out;
+    v->block_bytes.capacity = capacity;
 }
 
-/* ============================================================================
- * Multiline Array Parsing
- * ============================================================================ */
+static meh_value_t *meh_transform_value(meh_ctx_t *ctx, const meh_value_t *v,
+                                        size_t indent);
+static meh_block_t *meh_transform_items(meh_ctx_t *ctx,
+                                        const meh_block_t *src,
+                                        size_t base_indent);
 
-/* Check if text starts with "- " (inline bullet) */
-static bool is_inline_bullet(const char *text) {
-    int i = 0;
-    while (text[i] == ' ') i++;
-    return text[i] == '-' && text[i + 1] == ' ';
+/* Split inline hex that overflows the wrap column into 16-byte block
+ * lines */
+static meh_value_t *meh_hex_to_block(meh_ctx_t *ctx, meh_str_t normalized,
+                                     size_t indent) {
+    meh_value_t *out = meh_value_new(ctx, MEH_BLOCK_BYTES);
+    if (!out) return NULL;
+    char *raw = meh_alloc(ctx, normalized.len ? normalized.len : 1);
+    if (!raw) return out;
+    size_t digits = 0;
+    for (size_t i = 0; i < normalized.len; i++) {
+        if (!meh_is_space(normalized.ptr[i])) raw[digits++] = normalized.ptr[i];
+    }
+    for (size_t at = 0; at < digits; at += 32) {
+        size_t take = digits - at < 32 ? digits - at : 32;
+        meh_hex_line_t line;
+        memset(&line, 0, sizeof(line));
+        line.indent = indent + 1;
+        line.hex = meh_normalize_hex(ctx, meh_slice(raw + at, take));
+        if (!meh_bytes_push(ctx, out, line)) break;
+    }
+    return out;
 }
 
-/* Validate inline bullet has exactly one space after "-" */
-static bool validate_inline_bullet(parse_ctx_t *ctx, const char *text, int line_num, int col) {
-    int i = 0;
-    while (text[i] == ' ') i++;
-    if (text[i] == '-' && text[i + 1] == ' ' && text[i + 2] == ' ') {
-        ctx->error = make_error(ctx, line_num, col + i + 2,
-                               "Unexpected space after \"-\"");
-        return false;
-    }
-    return true;
+static meh_value_t *meh_transform_bytes(meh_ctx_t *ctx, const meh_value_t *v,
+                                        size_t indent) {
+    if (v->kind == MEH_BYTES) {
+        meh_str_t normalized = meh_normalize_hex(ctx, v->text);
+        if (indent * 2 + normalized.len + 2 > ctx->wrap) {
+            return meh_hex_to_block(ctx, normalized, indent);
+        }
+        meh_value_t *out = meh_value_new(ctx, MEH_BYTES);
+        if (out) out->text = normalized;
+        return out;
+    }
+    meh_value_t *out = meh_value_new(ctx, MEH_BLOCK_BYTES);
+    if (!out) return NULL;
+    out->block_bytes.first_comment = v->block_bytes.first_comment;
+    for (size_t i = 0; i < v->block_bytes.count; i++) {
+        meh_hex_line_t line = v->block_bytes.lines[i];
+        line.hex = meh_normalize_hex(ctx, line.hex);
+        if (!meh_bytes_push(ctx, out, line)) break;
+    }
+    meh_join_hex_comments(ctx, out);
+    meh_align_hex_comments(out, indent);
+    meh_wrap_hex_comments(ctx, out, indent);
+    return out;
 }
 
-/* Parse inline bullet value (extract content after "- ") */
-static const char *get_inline_bullet_value(const char *text) {
-    int i = 0;
-    while (text[i] == ' ') i++;
-    if (text[i] == '-' && text[i + 1] == ' ') {
-        return text + i + 2;
+static meh_value_t *meh_transform_value(meh_ctx_t *ctx, const meh_value_t *v,
+                                        size_t indent) {
+    if (!v) return NULL;
+    switch (v->kind) {
+        case MEH_INT: {
+            meh_value_t *out = meh_value_new(ctx, MEH_INT);
+            if (out) out->text = meh_normalize_number(ctx, v->text);
+            return out;
+        }
+        case MEH_FLOAT: {
+            meh_value_t *out = meh_value_new(ctx, MEH_FLOAT);
+            if (out) out->text = meh_canonical_float(ctx, v->text);
+            return out;
+        }
+        case MEH_BYTES:
+        case MEH_BLOCK_BYTES:
+            return meh_transform_bytes(ctx, v, indent);
+        case MEH_ARRAY: {
+            meh_value_t *out = meh_value_new(ctx, MEH_ARRAY);
+            if (!out) return NULL;
+            for (size_t i = 0; i < v->array.count; i++) {
+                meh_value_t *item =
+                    meh_transform_value(ctx, v->array.items[i], indent);
+                if (!item ||
+                    !meh_reserve(ctx, &out->array.items,
+                                 sizeof(meh_value_t *), out->array.count,
+                                 &out->array.capacity)) {
+                    break;
+                }
+                out->array.items[out->array.count++] = item;
+            }
+            return out;
+        }
+        case MEH_OBJECT: {
+            meh_value_t *out = meh_value_new(ctx, MEH_OBJECT);
+            if (!out) return NULL;
+            for (size_t i = 0; i < v->object.count; i++) {
+                meh_value_t *value = meh_transform_value(
+                    ctx, v->object.entries[i].value, indent);
+                if (!value ||
+                    !meh_reserve(ctx, &out->object.entries,
+                                 sizeof(meh_entry_t), out->object.count,
+                                 &out->object.capacity)) {
+                    break;
+                }
+                out->object.entries[out->object.count].key =
+                    v->object.entries[i].key;
+                out->object.entries[out->object.count].value = value;
+                out->object.count++;
+            }
+            return out;
+        }
+        default:
+            /* Null, booleans, strings, and block strings pass through;
+             * the tree is read-only after the transform so sharing the
+             * node is safe */
+            return (meh_value_t *)v;
     }
-    return text;
 }
 
-/* Recursively parse nested inline bullets like "- - - value" */
-static yay_value_t *parse_nested_inline_bullet(parse_ctx_t *ctx, const char *text,
-                                                int line_num, int col) {
-    if (is_inline_bullet(text)) {
-        const char *inner_text = get_inline_bullet_value(text);
-        yay_value_t *inner_val = parse_nested_inline_bullet(ctx, inner_text, line_num, col + 2);
-        if (ctx->error) {
-            return NULL;
+static meh_item_t *meh_transform_property(meh_ctx_t *ctx,
+                                          const meh_item_t *prop,
+                                          size_t indent) {
+    meh_item_t *out = meh_item_new(ctx, MEH_ITEM_PROPERTY);
+    if (!out) return NULL;
+    out->key = prop->key;
+    out->comment = prop->comment;
+    if (prop->value) {
+        out->value = meh_transform_value(ctx, prop->value, indent);
+    } else if (prop->block) {
+        /* A block holding one lone standalone value rides up onto the
+         * property line ("key:" + indented backtick becomes "key: `") */
+        if (prop->block->count == 1 &&
+            prop->block->items[0]->kind == MEH_ITEM_VALUE) {
+            out->value = meh_transform_value(
+                ctx, prop->block->items[0]->value, indent);
+        } else {
+            out->block = meh_transform_items(ctx, prop->block, indent + 1);
         }
-        yay_value_t *arr = yay_array();
-        yay_array_push(arr, inner_val);
-        return arr;
     }
-    return parse_scalar(ctx, text, line_num, col);
+    return out;
 }
 
-/* Forward declaration with min_indent parameter */
-static yay_value_t *parse_multiline_array_impl(parse_ctx_t *ctx, size_t *idx, int min_indent);
-
-static yay_value_t *parse_multiline_array(parse_ctx_t *ctx, size_t *idx) {
-    return parse_multiline_array_impl(ctx, idx, -1);
-}
-
-static yay_value_t *parse_multiline_array_impl(parse_ctx_t *ctx, size_t *idx, int min_indent) {
-    yay_value_t *arr = yay_array();
-    
-    while (*idx < ctx->token_count && 
-           ctx->tokens[*idx].type == TOKEN_START &&
-           strcmp(ctx->tokens[*idx].text, "- ") == 0) {
-        int list_indent = ctx->tokens[*idx].indent;
-        /* Stop if we encounter a list item at a lower indent than expected */
-        if (min_indent >= 0 && list_indent < min_indent) {
-            break;
-        }
-        (*idx)++;
-        
-        *idx = skip_breaks(ctx, *idx);
-        if (*idx >= ctx->token_count) break;
-        
-        token_t *next = &ctx->tokens[*idx];
-        
-        /* Nested array - START token */
-        if (next->type == TOKEN_START && strcmp(next->text, "- ") == 0) {
-            yay_value_t *nested = parse_multiline_array_impl(ctx, idx, -1);
-            if (ctx->error) {
-                yay_free(arr);
-                return NULL;
+static meh_item_t *meh_transform_item(meh_ctx_t *ctx, const meh_item_t *item,
+                                      size_t indent) {
+    switch (item->kind) {
+        case MEH_ITEM_PROPERTY:
+            return meh_transform_property(ctx, item, indent);
+        case MEH_ITEM_ARRAY_ITEM: {
+            meh_item_t *out = meh_item_new(ctx, MEH_ITEM_ARRAY_ITEM);
+            if (!out) return NULL;
+            out->comment = item->comment;
+            if (item->value) {
+                out->value = meh_transform_value(ctx, item->value, indent);
+            } else if (item->block) {
+                out->block =
+                    meh_transform_items(ctx, item->block, indent + 1);
             }
-            yay_array_push(arr, nested);
+            return out;
         }
-        /* Inline bullet (text starts with "- ") - creates nested array */
-        else if (next->type == TOKEN_TEXT && is_inline_bullet(next->text)) {
-            /* Validate the first inline bullet */
-            if (!validate_inline_bullet(ctx, next->text, next->line_num, next->col)) {
-                yay_free(arr);
-                return NULL;
+        case MEH_ITEM_VALUE: {
+            meh_item_t *out = meh_item_new(ctx, MEH_ITEM_VALUE);
+            if (out) {
+                out->value = meh_transform_value(ctx, item->value, indent);
             }
-            
-            yay_value_t *nested = yay_array();
-            
-            /* Collect all inline bullets at this level */
-            while (*idx < ctx->token_count && 
-                   ctx->tokens[*idx].type == TOKEN_TEXT &&
-                   is_inline_bullet(ctx->tokens[*idx].text)) {
-                /* Validate each inline bullet */
-                if (!validate_inline_bullet(ctx, ctx->tokens[*idx].text,
-                                            ctx->tokens[*idx].line_num,
-                                            ctx->tokens[*idx].col)) {
-                    yay_free(nested);
-                    yay_free(arr);
-                    return NULL;
+            return out;
+        }
+        default: {
+            meh_item_t *out = meh_item_new(ctx, item->kind);
+            if (out) out->comment = item->comment;
+            return out;
+        }
+    }
+}
+
+/* Inline containers that overflow the wrap column expand to block form:
+ * an array becomes sibling dash items after a bare key, an object
+ * becomes an indented property block */
+static void meh_expand_property(meh_ctx_t *ctx, meh_block_t *out,
+                                const meh_item_t *prop, size_t indent) {
+    const meh_value_t *value = prop->value;
+    if (value && (value->kind == MEH_ARRAY || value->kind == MEH_OBJECT)) {
+        size_t prefix = indent * 2 + prop->key.len + 2;
+        size_t width = value->kind == MEH_ARRAY ? meh_measure_array(value)
+                                                : meh_measure_object(value);
+        if (width == MEH_MULTILINE || prefix + width > ctx->wrap) {
+            meh_item_t *head = meh_item_new(ctx, MEH_ITEM_PROPERTY);
+            if (!head) return;
+            head->key = prop->key;
+            head->comment = prop->comment;
+            if (value->kind == MEH_ARRAY) {
+                meh_block_push(ctx, out, head);
+                for (size_t i = 0; i < value->array.count; i++) {
+                    meh_item_t *entry =
+                        meh_item_new(ctx, MEH_ITEM_ARRAY_ITEM);
+                    if (!entry) return;
+                    entry->value = meh_transform_value(
+                        ctx, value->array.items[i], indent);
+                    if (!meh_block_push(ctx, out, entry)) return;
                 }
-                
-                const char *val_str = get_inline_bullet_value(ctx->tokens[*idx].text);
-                yay_value_t *item = parse_nested_inline_bullet(ctx, val_str, 
-                                                  ctx->tokens[*idx].line_num,
-                                                  ctx->tokens[*idx].col + 2);
-                if (ctx->error) {
-                    yay_free(nested);
-                    yay_free(arr);
-                    return NULL;
+            } else {
+                meh_block_t *nested = meh_block_new(ctx);
+                if (!nested) return;
+                for (size_t i = 0; i < value->object.count; i++) {
+                    meh_item_t *entry = meh_item_new(ctx, MEH_ITEM_PROPERTY);
+                    if (!entry) return;
+                    entry->key = value->object.entries[i].key;
+                    entry->value = meh_transform_value(
+                        ctx, value->object.entries[i].value, indent + 1);
+                    if (!meh_block_push(ctx, nested, entry)) return;
                 }
-                yay_array_push(nested, item);
-                (*idx)++;
+                head->block = nested;
+                meh_block_push(ctx, out, head);
             }
-            
-            /* Continue with nested START tokens at deeper indent */
-            while (*idx < ctx->token_count &&
-                   ctx->tokens[*idx].type == TOKEN_START &&
-                   strcmp(ctx->tokens[*idx].text, "- ") == 0 &&
-                   ctx->tokens[*idx].indent > list_indent) {
-                (*idx)++;
-                *idx = skip_breaks(ctx, *idx);
-                if (*idx >= ctx->token_count) break;
-                
-                yay_value_t *sub_val = parse_value(ctx, idx);
-                if (ctx->error) {
-                    yay_free(nested);
-                    yay_free(arr);
-                    return NULL;
-                }
-                yay_array_push(nested, sub_val);
-                *idx = skip_stops(ctx, *idx);
+            return;
+        }
+    }
+    meh_block_push(ctx, out, meh_transform_property(ctx, prop, indent));
+}
+
+/* Width an item occupies before any inline comment, or false when the
+ * value cannot sit on one line */
+static bool meh_item_width(const meh_item_t *item, size_t *width) {
+    switch (item->kind) {
+        case MEH_ITEM_PROPERTY: {
+            size_t value_width =
+                item->value ? meh_measure_value(item->value) : 0;
+            if (value_width == MEH_MULTILINE) return false;
+            *width = value_width ? item->key.len + 2 + value_width
+                                 : item->key.len + 1;
+            return true;
+        }
+        case MEH_ITEM_ARRAY_ITEM: {
+            if (!item->value) {
+                *width = 1;
+                return true;
             }
-            
-            yay_array_push(arr, nested);
+            size_t value_width = meh_measure_value(item->value);
+            if (value_width == MEH_MULTILINE) return false;
+            *width = 2 + value_width;
+            return true;
         }
-        /* Object in array */
-        else if (next->type == TOKEN_TEXT && find_colon_outside_quotes(next->text) >= 0) {
-            /* Use list_indent as base so sibling properties at higher indent are included */
-            yay_value_t *obj = parse_nested_object(ctx, idx, list_indent);
-            if (ctx->error) {
-                yay_free(arr);
-                return NULL;
+        default:
+            return false;
+    }
+}
+
+/* Align inline comments within contiguous runs of properties and array
+ * items (blank lines and standalone comments bound the runs) */
+static void meh_align_items(meh_block_t *block, size_t base_indent) {
+    size_t indent_width = base_indent * 2;
+    size_t start = 0;
+    while (start < block->count) {
+        meh_item_kind_t kind = block->items[start]->kind;
+        if (kind == MEH_ITEM_BLANK || kind == MEH_ITEM_COMMENT) {
+            start++;
+            continue;
+        }
+        size_t end = start + 1;
+        while (end < block->count) {
+            kind = block->items[end]->kind;
+            if (kind == MEH_ITEM_BLANK || kind == MEH_ITEM_COMMENT) break;
+            end++;
+        }
+        size_t max_width = 0;
+        for (size_t i = start; i < end; i++) {
+            size_t width;
+            if (block->items[i]->comment.present &&
+                meh_item_width(block->items[i], &width) &&
+                width > max_width) {
+                max_width = width;
             }
-            yay_array_push(arr, obj);
-        }
-        /* Regular value */
-        else if (next->type == TOKEN_TEXT) {
-            const char *s = next->text;
-            /* Block string in array context - use list_indent as base */
-            if (strcmp(s, "`") == 0 || (s[0] == '`' && strlen(s) >= 2 && s[1] == ' ')) {
-                const char *first_line = strlen(s) > 2 ? s + 2 : "";
-                yay_value_t *value = parse_block_string_impl(ctx, idx, first_line, list_indent);
-                if (ctx->error) {
-                    yay_free(arr);
-                    return NULL;
-                }
-                yay_array_push(arr, value);
-            } else {
-                yay_value_t *value = parse_value(ctx, idx);
-                if (ctx->error) {
-                    yay_free(arr);
-                    return NULL;
+        }
+        if (max_width) {
+            size_t align_col = indent_width + max_width + 2;
+            for (size_t i = start; i < end; i++) {
+                meh_item_t *item = block->items[i];
+                if ((item->kind == MEH_ITEM_PROPERTY ||
+                     item->kind == MEH_ITEM_ARRAY_ITEM) &&
+                    item->comment.present) {
+                    item->comment.align_column = align_col;
                 }
-                yay_array_push(arr, value);
             }
         }
-        else {
-            (*idx)++;
+        start = end;
+    }
+}
+
+static meh_block_t *meh_transform_items(meh_ctx_t *ctx,
+                                        const meh_block_t *src,
+                                        size_t base_indent) {
+    meh_block_t *out = meh_block_new(ctx);
+    if (!out || !src) return out;
+    bool prev_blank = false;
+    for (size_t i = 0; i < src->count; i++) {
+        const meh_item_t *item = src->items[i];
+        if (item->kind == MEH_ITEM_BLANK) {
+            /* Collapse runs and drop leading blanks */
+            if (!prev_blank && out->count) {
+                meh_block_push(ctx, out, meh_item_new(ctx, MEH_ITEM_BLANK));
+                prev_blank = true;
+            }
+            continue;
+        }
+        prev_blank = false;
+        if (item->kind == MEH_ITEM_PROPERTY) {
+            meh_expand_property(ctx, out, item, base_indent);
+        } else {
+            meh_block_push(ctx, out,
+                           meh_transform_item(ctx, item, base_indent));
         }
-        
-        /* Skip stops and breaks between items */
-        *idx = skip_stops(ctx, *idx);
-        *idx = skip_breaks(ctx, *idx);
     }
-    
-    return arr;
+    while (out->count &&
+           out->items[out->count - 1]->kind == MEH_ITEM_BLANK) {
+        out->count--;
+    }
+    meh_align_items(out, base_indent);
+    return out;
 }
 
-/* ============================================================================
- * Value Parsing
- * ============================================================================ */
+/* ---- Canonical serializer ---- */
 
-static yay_value_t *parse_value(parse_ctx_t *ctx, size_t *idx) {
-    if (*idx >= ctx->token_count) {
-        return yay_null();
-    }
-    
-    token_t *t = &ctx->tokens[*idx];
-    
-    /* Validate text tokens */
-    if (t->type == TOKEN_TEXT) {
-        if (t->text[0] == ' ') {
-            ctx->error = make_error(ctx, t->line_num, t->col,
-                                   "Unexpected leading space");
-            return NULL;
-        }
-        if (strcmp(t->text, "$") == 0) {
-            ctx->error = make_error(ctx, t->line_num, t->col,
-                                   "Unexpected character \"$\"");
-            return NULL;
+typedef struct {
+    yay_writer_t *writer;
+    size_t indent;
+    size_t column;
+    bool in_property_value;   /* '>' must stand alone in a property value */
+    char *spaces;             /* Lazily grown all-spaces run, so any
+                               * indentation is one memcpy per line */
+    size_t spaces_len;
+    /* Compact mode: whether the value being emitted sits inside an
+     * inline array, and the first structural error encountered */
+    bool compact_in_array;
+    const char *compact_error;
+} meh_fmt_t;
+
+static void meh_emit(meh_fmt_t *fmt, const char *data, size_t length) {
+    yay_writer_write(fmt->writer, data, length);
+    fmt->column += length;
+}
+
+static void meh_emit_str(meh_fmt_t *fmt, meh_str_t s) {
+    meh_emit(fmt, s.ptr, s.len);
+}
+
+static void meh_emit_char(meh_fmt_t *fmt, char c) {
+    meh_emit(fmt, &c, 1);
+}
+
+static void meh_emit_newline(meh_fmt_t *fmt) {
+    yay_writer_write(fmt->writer, "\n", 1);
+    fmt->column = 0;
+}
+
+static void meh_emit_spaces(meh_fmt_t *fmt, size_t n) {
+    static const char spaces[32] = "                                ";
+    if (n > fmt->spaces_len) {
+        size_t grown = fmt->spaces_len ? fmt->spaces_len : sizeof(spaces);
+        while (grown < n) grown *= 2;
+        char *run = mem_alloc(grown);
+        if (run) {
+            memset(run, ' ', grown);
+            mem_free(fmt->spaces);
+            fmt->spaces = run;
+            fmt->spaces_len = grown;
         }
     }
-    
-    /* Block starts (list items) */
-    if (t->type == TOKEN_START && strcmp(t->text, "- ") == 0) {
-        return parse_multiline_array(ctx, idx);
+    if (n <= fmt->spaces_len) {
+        meh_emit(fmt, fmt->spaces, n);
+        return;
     }
-    
-    /* Text content */
-    if (t->type == TOKEN_TEXT) {
-        const char *s = t->text;
-        
-        /* Keywords */
-        if (strcmp(s, "null") == 0) { (*idx)++; return yay_null(); }
-        if (strcmp(s, "true") == 0) { (*idx)++; return yay_bool(true); }
-        if (strcmp(s, "false") == 0) { (*idx)++; return yay_bool(false); }
-        if (strcmp(s, "nan") == 0) { (*idx)++; return yay_float(NAN); }
-        if (strcmp(s, "infinity") == 0) { (*idx)++; return yay_float(INFINITY); }
-        if (strcmp(s, "-infinity") == 0) { (*idx)++; return yay_float(-INFINITY); }
-        
-        /* Numbers */
-        if (is_float_str(s)) {
-            yay_value_t *v = parse_number_with_validation(ctx, s, t->line_num, t->col);
-            if (ctx->error) return NULL;
-            (*idx)++;
-            return v;
+    /* Growing the run failed; fall back to the static block */
+    while (n) {
+        size_t take = n < sizeof(spaces) ? n : sizeof(spaces);
+        meh_emit(fmt, spaces, take);
+        n -= take;
+    }
+}
+
+static void meh_emit_indent(meh_fmt_t *fmt) {
+    meh_emit_spaces(fmt, fmt->indent * 2);
+}
+
+static void meh_emit_comment(meh_fmt_t *fmt, const meh_comment_t *comment) {
+    if (comment->align_column) {
+        meh_emit_spaces(fmt, fmt->column < comment->align_column
+                                 ? comment->align_column - fmt->column
+                                 : 2);
+    } else {
+        meh_emit(fmt, "  ", 2);
+    }
+    meh_emit_char(fmt, '#');
+    meh_emit_str(fmt, comment->text);
+}
+
+static bool meh_is_block_value(const meh_value_t *v) {
+    return v && (v->kind == MEH_BLOCK_STRING || v->kind == MEH_BLOCK_BYTES);
+}
+
+static void meh_format_value(meh_fmt_t *fmt, const meh_value_t *v);
+static void meh_format_item(meh_fmt_t *fmt, const meh_item_t *item);
+static void meh_format_array_item_inline(meh_fmt_t *fmt,
+                                         const meh_item_t *item);
+static void meh_format_property_inline(meh_fmt_t *fmt,
+                                       const meh_item_t *prop);
+
+static void meh_format_block_string(meh_fmt_t *fmt, const meh_value_t *v) {
+    meh_emit_char(fmt, '`');
+    if (v->block_string.has_first) {
+        meh_emit_char(fmt, ' ');
+        meh_emit_str(fmt, v->block_string.first);
+    }
+    meh_emit_newline(fmt);
+    /* Indentation is re-based on the shallowest non-empty line */
+    size_t min_indent = SIZE_MAX;
+    for (size_t i = 0; i < v->block_string.count; i++) {
+        const meh_text_line_t *line = &v->block_string.lines[i];
+        if (line->content.len && line->indent < min_indent) {
+            min_indent = line->indent;
         }
-        if (is_integer_str(s)) {
-            yay_value_t *v = parse_number_with_validation(ctx, s, t->line_num, t->col);
-            if (ctx->error) return NULL;
-            (*idx)++;
-            return v;
+    }
+    if (min_indent == SIZE_MAX) min_indent = 0;
+    for (size_t i = 0; i < v->block_string.count; i++) {
+        const meh_text_line_t *line = &v->block_string.lines[i];
+        if (!line->content.len) {
+            meh_emit_newline(fmt);
+            continue;
         }
-        
-        /* Block string (backtick) */
-        if (strcmp(s, "`") == 0 || (s[0] == '`' && strlen(s) >= 2 && s[1] == ' ')) {
-            const char *first_line = strlen(s) > 2 ? s + 2 : "";
-            return parse_block_string(ctx, idx, first_line);
+        meh_emit_spaces(fmt, (fmt->indent + 1) * 2 + line->indent - min_indent);
+        meh_emit_str(fmt, line->content);
+        meh_emit_newline(fmt);
+    }
+}
+
+static void meh_format_block_bytes(meh_fmt_t *fmt, const meh_value_t *v) {
+    meh_emit_char(fmt, '>');
+    const meh_hex_line_t *lines = v->block_bytes.lines;
+    size_t count = v->block_bytes.count;
+    size_t start = 0;
+    if (!fmt->in_property_value && count && lines[0].hex.len) {
+        /* Root level: the first hex line shares the '>' line */
+        meh_emit_char(fmt, ' ');
+        meh_emit_str(fmt, lines[0].hex);
+        if (lines[0].comment.present) {
+            meh_emit_comment(fmt, &lines[0].comment);
         }
-        
-        /* Block bytes (>) */
-        if (s[0] == '>' && !strchr(s, '<')) {
-            return parse_block_bytes(ctx, idx);
+        meh_emit_newline(fmt);
+        start = 1;
+    } else {
+        if (v->block_bytes.first_comment.present) {
+            meh_emit_comment(fmt, &v->block_bytes.first_comment);
         }
-        
-        /* Quoted string */
-        if (s[0] == '"' && strlen(s) > 1) {
-            size_t slen = strlen(s);
-            if (s[slen-1] != '"') {
-                /* Unterminated string - report at end of string */
-                ctx->error = make_error(ctx, t->line_num, t->col + (int)(slen > 0 ? slen - 1 : 0),
-                                       "Unterminated string");
-                return NULL;
+        meh_emit_newline(fmt);
+    }
+    for (size_t i = start; i < count; i++) {
+        meh_emit_spaces(fmt, (fmt->indent + 1) * 2);
+        if (!lines[i].hex.len) {
+            if (lines[i].comment.present) {
+                if (lines[i].comment.align_column > fmt->column) {
+                    meh_emit_spaces(
+                        fmt, lines[i].comment.align_column - fmt->column);
+                }
+                meh_emit_char(fmt, '#');
+                meh_emit_str(fmt, lines[i].comment.text);
             }
-            (*idx)++;
-            return parse_double_quoted_string(ctx, s, t->line_num, t->col);
-        }
-        if (s[0] == '\'' && strlen(s) > 1) {
-            size_t slen = strlen(s);
-            if (s[slen-1] != '\'') {
-                /* Unterminated string - report at end of string */
-                ctx->error = make_error(ctx, t->line_num, t->col + (int)(slen > 0 ? slen - 1 : 0),
-                                       "Unterminated string");
-                return NULL;
+        } else {
+            meh_emit_str(fmt, lines[i].hex);
+            if (lines[i].comment.present) {
+                meh_emit_comment(fmt, &lines[i].comment);
             }
-            (*idx)++;
-            return parse_single_quoted_string(s);
         }
-        
-        /* Inline array - must close on same line */
-        if (s[0] == '[') {
-            if (!strchr(s, ']')) {
-                ctx->error = make_error(ctx, t->line_num, t->col,
-                                       "Unexpected newline in inline array");
-                return NULL;
+        meh_emit_newline(fmt);
+    }
+}
+
+static void meh_format_value(meh_fmt_t *fmt, const meh_value_t *v) {
+    if (!v) {
+        meh_emit(fmt, "null", 4);
+        return;
+    }
+    switch (v->kind) {
+        case MEH_NULL:
+            meh_emit(fmt, "null", 4);
+            break;
+        case MEH_BOOL:
+            if (v->boolean) meh_emit(fmt, "true", 4);
+            else meh_emit(fmt, "false", 5);
+            break;
+        case MEH_INT:
+        case MEH_FLOAT:
+        case MEH_STRING:
+            meh_emit_str(fmt, v->text);
+            break;
+        case MEH_BYTES:
+            meh_emit_char(fmt, '<');
+            meh_emit_str(fmt, v->text);
+            meh_emit_char(fmt, '>');
+            break;
+        case MEH_BLOCK_STRING:
+            meh_format_block_string(fmt, v);
+            break;
+        case MEH_BLOCK_BYTES:
+            meh_format_block_bytes(fmt, v);
+            break;
+        case MEH_ARRAY:
+            meh_emit_char(fmt, '[');
+            for (size_t i = 0; i < v->array.count; i++) {
+                if (i) meh_emit(fmt, ", ", 2);
+                meh_format_value(fmt, v->array.items[i]);
+            }
+            meh_emit_char(fmt, ']');
+            break;
+        case MEH_OBJECT:
+            meh_emit_char(fmt, '{');
+            for (size_t i = 0; i < v->object.count; i++) {
+                if (i) meh_emit(fmt, ", ", 2);
+                meh_emit_str(fmt, v->object.entries[i].key);
+                meh_emit(fmt, ": ", 2);
+                meh_format_value(fmt, v->object.entries[i].value);
             }
-            (*idx)++;
-            return parse_inline_array(ctx, s, t->line_num, t->col);
-        }
-        
-        /* Inline object - must close on same line */
-        if (s[0] == '{') {
-            if (!strchr(s, '}')) {
-                ctx->error = make_error(ctx, t->line_num, t->col,
-                                       "Unexpected newline in inline object");
-                return NULL;
+            meh_emit_char(fmt, '}');
+            break;
+    }
+}
+
+/* Shared by the indent-writing and dash-line forms of a property; nested
+ * blocks step by one level normally and by two from a dash line so
+ * children clear the dash */
+static void meh_format_property_body(meh_fmt_t *fmt, const meh_item_t *prop,
+                                     size_t block_step) {
+    meh_emit_str(fmt, prop->key);
+    meh_emit_char(fmt, ':');
+    if (prop->value) {
+        bool block_value = meh_is_block_value(prop->value);
+        meh_emit_char(fmt, ' ');
+        fmt->in_property_value = true;
+        meh_format_value(fmt, prop->value);
+        fmt->in_property_value = false;
+        if (!block_value) {
+            if (prop->comment.present) {
+                meh_emit_comment(fmt, &prop->comment);
             }
-            size_t consumed;
-            (*idx)++;
-            return parse_inline_value(ctx, s, &consumed, t->line_num, t->col);
+            meh_emit_newline(fmt);
         }
-        
-        /* Inline bytes */
-        if (s[0] == '<') {
-            (*idx)++;
-            yay_value_t *bytes = parse_angle_bytes(ctx, s, t->line_num, t->col);
-            if (ctx->error) {
-                return NULL;
+    } else if (prop->block) {
+        if (prop->comment.present) meh_emit_comment(fmt, &prop->comment);
+        meh_emit_newline(fmt);
+        fmt->indent += block_step;
+        for (size_t i = 0; i < prop->block->count; i++) {
+            meh_format_item(fmt, prop->block->items[i]);
+        }
+        fmt->indent -= block_step;
+    } else {
+        if (prop->comment.present) meh_emit_comment(fmt, &prop->comment);
+        meh_emit_newline(fmt);
+    }
+}
+
+static void meh_format_property_inline(meh_fmt_t *fmt,
+                                       const meh_item_t *prop) {
+    meh_format_property_body(fmt, prop, 2);
+}
+
+static void meh_format_array_item(meh_fmt_t *fmt, const meh_item_t *item) {
+    meh_emit_indent(fmt);
+    if (item->value) {
+        meh_emit(fmt, "- ", 2);
+        meh_format_value(fmt, item->value);
+        if (!meh_is_block_value(item->value)) {
+            if (item->comment.present) {
+                meh_emit_comment(fmt, &item->comment);
             }
-            return bytes;
+            meh_emit_newline(fmt);
         }
-        
-        /* Key:value pair */
-        int colon_idx = find_colon_outside_quotes(s);
-        if (colon_idx >= 0) {
-            char *k_raw = str_dup_len(s, colon_idx);
-            char *key = parse_key_name(k_raw);
-            free(k_raw);
-            
-            const char *v_part = s + colon_idx + 1;
-            int v_col = t->col + colon_idx + 1;
-            while (*v_part == ' ') { v_part++; v_col++; }
-            
-            yay_value_t *obj = yay_object();
-            yay_value_t *value = parse_object_property_value(ctx, idx, t, v_part, v_col);
-            if (ctx->error) {
-                free(key);
-                yay_free(obj);
-                return NULL;
+        return;
+    }
+    if (!item->block || !item->block->count) {
+        meh_emit_char(fmt, '-');
+        if (item->comment.present) meh_emit_comment(fmt, &item->comment);
+        meh_emit_newline(fmt);
+        return;
+    }
+    /* The first child rides the dash line when it can */
+    const meh_item_t *first = item->block->items[0];
+    if (first->kind == MEH_ITEM_ARRAY_ITEM) {
+        meh_emit(fmt, "- ", 2);
+        meh_format_array_item_inline(fmt, first);
+    } else if (first->kind == MEH_ITEM_PROPERTY) {
+        meh_emit(fmt, "- ", 2);
+        meh_format_property_inline(fmt, first);
+    } else {
+        meh_emit_char(fmt, '-');
+        if (item->comment.present) meh_emit_comment(fmt, &item->comment);
+        meh_emit_newline(fmt);
+        fmt->indent++;
+        for (size_t i = 0; i < item->block->count; i++) {
+            meh_format_item(fmt, item->block->items[i]);
+        }
+        fmt->indent--;
+        return;
+    }
+    fmt->indent++;
+    for (size_t i = 1; i < item->block->count; i++) {
+        meh_format_item(fmt, item->block->items[i]);
+    }
+    fmt->indent--;
+}
+
+static void meh_format_array_item_inline(meh_fmt_t *fmt,
+                                         const meh_item_t *item) {
+    if (item->value) {
+        meh_emit(fmt, "- ", 2);
+        meh_format_value(fmt, item->value);
+        if (item->comment.present) meh_emit_comment(fmt, &item->comment);
+        meh_emit_newline(fmt);
+        return;
+    }
+    if (!item->block || !item->block->count) {
+        meh_emit_char(fmt, '-');
+        if (!item->block) {
+            if (item->comment.present) {
+                meh_emit_comment(fmt, &item->comment);
             }
-            
-            yay_object_set(obj, key, value);
-            free(key);
-            return obj;
         }
-        
-        /* Fall back to scalar */
-        (*idx)++;
-        return parse_scalar(ctx, s, t->line_num, t->col);
+        meh_emit_newline(fmt);
+        return;
     }
-    
-    (*idx)++;
-    return yay_null();
+    const meh_item_t *first = item->block->items[0];
+    if (first->kind == MEH_ITEM_ARRAY_ITEM) {
+        meh_emit(fmt, "- ", 2);
+        meh_format_array_item_inline(fmt, first);
+    } else if (first->kind == MEH_ITEM_PROPERTY) {
+        meh_emit(fmt, "- ", 2);
+        meh_format_property_inline(fmt, first);
+    } else {
+        meh_emit_char(fmt, '-');
+        meh_emit_newline(fmt);
+        fmt->indent++;
+        for (size_t i = 0; i < item->block->count; i++) {
+            meh_format_item(fmt, item->block->items[i]);
+        }
+        fmt->indent--;
+        return;
+    }
+    fmt->indent++;
+    for (size_t i = 1; i < item->block->count; i++) {
+        meh_format_item(fmt, item->block->items[i]);
+    }
+    fmt->indent--;
 }
 
-/* ============================================================================
- * Root Parsing
- * ============================================================================ */
+static void meh_format_item(meh_fmt_t *fmt, const meh_item_t *item) {
+    switch (item->kind) {
+        case MEH_ITEM_BLANK:
+            meh_emit_newline(fmt);
+            break;
+        case MEH_ITEM_COMMENT:
+            meh_emit_indent(fmt);
+            meh_emit_char(fmt, '#');
+            meh_emit_str(fmt, item->comment.text);
+            meh_emit_newline(fmt);
+            break;
+        case MEH_ITEM_VALUE:
+            meh_emit_indent(fmt);
+            meh_format_value(fmt, item->value);
+            if (!meh_is_block_value(item->value)) meh_emit_newline(fmt);
+            break;
+        case MEH_ITEM_PROPERTY:
+            meh_emit_indent(fmt);
+            meh_format_property_body(fmt, item, 1);
+            break;
+        case MEH_ITEM_ARRAY_ITEM:
+            meh_format_array_item(fmt, item);
+            break;
+    }
+}
 
-static yay_value_t *parse_root_object(parse_ctx_t *ctx, size_t *idx) {
-    yay_value_t *obj = yay_object();
-    
-    while (*idx < ctx->token_count) {
-        token_t *t = &ctx->tokens[*idx];
-        
-        if (t->type == TOKEN_STOP || t->type == TOKEN_BREAK) {
-            (*idx)++;
-            continue;
+/* ---- Compact serializer ----
+ *
+ * Single-line minimal-whitespace output for machine producers, where
+ * payload size and serialization speed outrank readability. Comments
+ * cannot survive on one line and are dropped; block strings re-escape
+ * into quoted strings, block bytes collapse into inline hex, and the
+ * grouping spaces inside numbers and hex spans are stripped. The ": "
+ * and ", " separators stay because they are the smallest forms the
+ * inline grammar admits. */
+
+static void meh_compact_value(meh_fmt_t *fmt, const meh_value_t *v,
+                              bool at_root);
+static void meh_compact_block(meh_fmt_t *fmt, const meh_block_t *block,
+                              bool at_root);
+
+/* Emit a span minus its spaces (digit grouping, hex pair spacing) */
+static void meh_compact_squeeze(meh_fmt_t *fmt, meh_str_t s) {
+    size_t start = 0;
+    for (size_t i = 0; i <= s.len; i++) {
+        if (i == s.len || s.ptr[i] == ' ') {
+            if (i > start) meh_emit(fmt, s.ptr + start, i - start);
+            start = i + 1;
         }
-        
-        if (t->type != TOKEN_TEXT || t->indent != 0) {
-            (*idx)++;
-            continue;
+    }
+}
+
+/* Inline keys are restricted to word characters; block form admits
+ * bare keys (spaces, dots) that must be re-quoted to survive inline */
+static bool meh_compact_key_is_bare(meh_str_t key) {
+    if (!key.len) return false;
+    if (!isalnum((unsigned char)key.ptr[0]) && key.ptr[0] != '_') return false;
+    for (size_t i = 1; i < key.len; i++) {
+        char c = key.ptr[i];
+        if (!isalnum((unsigned char)c) && c != '_' && c != '-') return false;
+    }
+    return true;
+}
+
+static void meh_compact_key(meh_fmt_t *fmt, meh_str_t key) {
+    if (key.len && (key.ptr[0] == '"' || key.ptr[0] == '\'')) {
+        meh_emit_str(fmt, key);
+    } else if (meh_compact_key_is_bare(key)) {
+        meh_emit_str(fmt, key);
+    } else {
+        encode_string_len(fmt->writer, key.ptr, key.len);
+    }
+}
+
+/* Append one quoted piece's content to a double-quoted string under
+ * construction. Double-quoted content splices verbatim; single-quoted
+ * content first resolves its two escapes (\' and \\) and then
+ * re-escapes as double-quoted content. */
+static void meh_compact_concat_piece(meh_fmt_t *fmt, meh_str_t piece) {
+    if (piece.len < 2) return;
+    if (piece.ptr[0] == '"') {
+        meh_emit(fmt, piece.ptr + 1, piece.len - 2);
+        return;
+    }
+    const char *inner = piece.ptr + 1;
+    size_t inner_len = piece.len - 2;
+    char *raw = mem_alloc(inner_len ? inner_len : 1);
+    if (!raw) {
+        fmt->writer->failed = true;
+        return;
+    }
+    size_t n = 0;
+    for (size_t i = 0; i < inner_len; i++) {
+        if (inner[i] == '\\' && i + 1 < inner_len &&
+            (inner[i + 1] == '\'' || inner[i + 1] == '\\')) {
+            i++;
         }
-        
-        int colon_idx = find_colon_outside_quotes(t->text);
-        if (colon_idx < 0) {
-            (*idx)++;
-            continue;
+        raw[n++] = inner[i];
+    }
+    yay_writer_t tmp;
+    yay_writer_init(&tmp);
+    encode_string_len(&tmp, raw, n);
+    mem_free(raw);
+    if (!tmp.failed && tmp.length >= 2) {
+        meh_emit(fmt, tmp.data + 1, tmp.length - 2);
+    }
+    yay_writer_free(&tmp);
+}
+
+/* A block string becomes an escaped inline string: lines re-based on
+ * the shallowest one, each newline-terminated, matching what the
+ * strict parser reads the block as. Trailing blank lines separate the
+ * block from what follows and are not content; a root-level block with
+ * no text after the backtick reads as starting with a newline. */
+static void meh_compact_block_string(meh_fmt_t *fmt, const meh_value_t *v,
+                                     bool at_root) {
+    size_t count = v->block_string.count;
+    while (count && !v->block_string.lines[count - 1].content.len) {
+        count--;
+    }
+    size_t min_indent = SIZE_MAX;
+    for (size_t i = 0; i < count; i++) {
+        const meh_text_line_t *line = &v->block_string.lines[i];
+        if (line->content.len && line->indent < min_indent) {
+            min_indent = line->indent;
         }
-        
-        /* Validate object property syntax */
-        if (!validate_object_property(ctx, t->text, colon_idx, t->line_num, t->col)) {
-            yay_free(obj);
-            return NULL;
+    }
+    if (min_indent == SIZE_MAX) min_indent = 0;
+    bool leading = at_root && !v->block_string.has_first;
+    size_t total = leading ? 1 : 0;
+    if (v->block_string.has_first) total += v->block_string.first.len + 1;
+    for (size_t i = 0; i < count; i++) {
+        const meh_text_line_t *line = &v->block_string.lines[i];
+        if (line->content.len) {
+            total += line->indent - min_indent + line->content.len;
         }
-        
-        char *k_raw = str_dup_len(t->text, colon_idx);
-        char *key = parse_key_name(k_raw);
-        free(k_raw);
-        
-        const char *v_part = t->text + colon_idx + 1;
-        int v_col = t->col + colon_idx + 1;
-        while (*v_part == ' ') { v_part++; v_col++; }
-        
-        yay_value_t *value = parse_object_property_value(ctx, idx, t, v_part, v_col);
-        if (ctx->error) {
-            free(key);
-            yay_free(obj);
-            return NULL;
+        total += 1;
+    }
+    char *raw = mem_alloc(total ? total : 1);
+    if (!raw) {
+        fmt->writer->failed = true;
+        return;
+    }
+    size_t n = 0;
+    if (leading) raw[n++] = '\n';
+    if (v->block_string.has_first) {
+        memcpy(raw + n, v->block_string.first.ptr, v->block_string.first.len);
+        n += v->block_string.first.len;
+        raw[n++] = '\n';
+    }
+    for (size_t i = 0; i < count; i++) {
+        const meh_text_line_t *line = &v->block_string.lines[i];
+        if (line->content.len) {
+            memset(raw + n, ' ', line->indent - min_indent);
+            n += line->indent - min_indent;
+            memcpy(raw + n, line->content.ptr, line->content.len);
+            n += line->content.len;
         }
-        
-        yay_object_set(obj, key, value);
-        free(key);
+        raw[n++] = '\n';
     }
-    
-    return obj;
+    encode_string_len(fmt->writer, raw, n);
+    mem_free(raw);
 }
 
-static yay_value_t *parse_root(parse_ctx_t *ctx) {
-    size_t i = skip_breaks_and_stops(ctx, 0);
-    
-    if (i >= ctx->token_count) {
-        /* No value found - this is an error */
-        ctx->error = calloc(1, sizeof(yay_error_t));
-        if (ctx->filename) {
-            char buf[512];
-            snprintf(buf, sizeof(buf), "No value found in document <%s>", ctx->filename);
-            ctx->error->message = str_dup(buf);
-        } else {
-            ctx->error->message = str_dup("No value found in document");
-        }
-        return NULL;
+static void meh_compact_block_bytes(meh_fmt_t *fmt, const meh_value_t *v) {
+    meh_emit_char(fmt, '<');
+    for (size_t i = 0; i < v->block_bytes.count; i++) {
+        meh_compact_squeeze(fmt, v->block_bytes.lines[i].hex);
     }
-    
-    token_t *t = &ctx->tokens[i];
-    
-    /* Check for unexpected indent at root */
-    if (t->type == TOKEN_TEXT && t->indent > 0) {
-        ctx->error = make_error(ctx, t->line_num, 0, "Unexpected indent");
-        return NULL;
+    meh_emit_char(fmt, '>');
+}
+
+/* Emit one array element (an item's inline value or nested block) with
+ * the in-array flag raised, so nested objects can be rejected: the
+ * inline grammar has no form for a non-empty object inside an array */
+static void meh_compact_element(meh_fmt_t *fmt, const meh_item_t *item) {
+    bool saved = fmt->compact_in_array;
+    fmt->compact_in_array = true;
+    if (item->value) {
+        meh_compact_value(fmt, item->value, false);
+    } else if (item->block) {
+        meh_compact_block(fmt, item->block, false);
+    } else {
+        meh_emit(fmt, "null", 4);
     }
-    
-    /* Detect root object (key: value at indent 0, not inline object) */
-    if (t->type == TOKEN_TEXT && t->text[0] != '{' &&
-        find_colon_outside_quotes(t->text) >= 0 && t->indent == 0) {
-        yay_value_t *value = parse_root_object(ctx, &i);
-        if (ctx->error) {
-            return NULL;
+    fmt->compact_in_array = saved;
+}
+
+static void meh_compact_value(meh_fmt_t *fmt, const meh_value_t *v,
+                              bool at_root) {
+    if (!v) {
+        meh_emit(fmt, "null", 4);
+        return;
+    }
+    switch (v->kind) {
+        case MEH_NULL:
+            meh_emit(fmt, "null", 4);
+            break;
+        case MEH_BOOL:
+            if (v->boolean) meh_emit(fmt, "true", 4);
+            else meh_emit(fmt, "false", 5);
+            break;
+        case MEH_INT:
+        case MEH_FLOAT:
+            meh_compact_squeeze(fmt, v->text);
+            break;
+        case MEH_STRING:
+            meh_emit_str(fmt, v->text);
+            break;
+        case MEH_BYTES:
+            meh_emit_char(fmt, '<');
+            meh_compact_squeeze(fmt, v->text);
+            meh_emit_char(fmt, '>');
+            break;
+        case MEH_BLOCK_STRING:
+            meh_compact_block_string(fmt, v, at_root);
+            break;
+        case MEH_BLOCK_BYTES:
+            meh_compact_block_bytes(fmt, v);
+            break;
+        case MEH_ARRAY: {
+            bool saved = fmt->compact_in_array;
+            fmt->compact_in_array = true;
+            meh_emit_char(fmt, '[');
+            for (size_t i = 0; i < v->array.count; i++) {
+                if (i) meh_emit(fmt, ", ", 2);
+                meh_compact_value(fmt, v->array.items[i], false);
+            }
+            meh_emit_char(fmt, ']');
+            fmt->compact_in_array = saved;
+            break;
         }
-        
-        /* Check for extra content */
-        size_t j = skip_breaks_and_stops(ctx, i);
-        if (j < ctx->token_count) {
-            token_t *extra = &ctx->tokens[j];
-            ctx->error = make_error(ctx, extra->line_num, extra->col,
-                                   "Unexpected extra content");
-            yay_free(value);
-            return NULL;
+        case MEH_OBJECT: {
+            if (v->object.count && fmt->compact_in_array &&
+                !fmt->compact_error) {
+                fmt->compact_error =
+                    "No inline form for an object in an array";
+            }
+            bool saved = fmt->compact_in_array;
+            fmt->compact_in_array = false;
+            meh_emit_char(fmt, '{');
+            for (size_t i = 0; i < v->object.count; i++) {
+                if (i) meh_emit(fmt, ", ", 2);
+                meh_compact_key(fmt, v->object.entries[i].key);
+                meh_emit(fmt, ": ", 2);
+                meh_compact_value(fmt, v->object.entries[i].value, false);
+            }
+            meh_emit_char(fmt, '}');
+            fmt->compact_in_array = saved;
+            break;
         }
-        
-        return value;
     }
-    
-    /* Parse as single value */
-    yay_value_t *value = parse_value(ctx, &i);
-    if (ctx->error) {
-        return NULL;
+}
+
+/* Emit a block of items as the inline value it denotes: properties as
+ * an object, array items as an array, adjacent strings as their
+ * concatenation, a lone value as itself. A property with no value of
+ * its own names the run of sibling array items that follows it. */
+static void meh_compact_block(meh_fmt_t *fmt, const meh_block_t *block,
+                              bool at_root) {
+    size_t props = 0, list_items = 0, values = 0, strings = 0;
+    for (size_t i = 0; block && i < block->count; i++) {
+        const meh_item_t *item = block->items[i];
+        switch (item->kind) {
+            case MEH_ITEM_PROPERTY:
+                props++;
+                break;
+            case MEH_ITEM_ARRAY_ITEM:
+                list_items++;
+                break;
+            case MEH_ITEM_VALUE:
+                values++;
+                if (item->value && item->value->kind == MEH_STRING) {
+                    strings++;
+                }
+                break;
+            default:
+                break;
+        }
     }
-    
-    /* Check for extra content */
-    size_t j = skip_breaks_and_stops(ctx, i);
-    if (j < ctx->token_count) {
-        token_t *extra = &ctx->tokens[j];
-        ctx->error = make_error(ctx, extra->line_num, extra->col,
-                               "Unexpected extra content");
-        yay_free(value);
-        return NULL;
+    if (props) {
+        if (fmt->compact_in_array && !fmt->compact_error) {
+            fmt->compact_error =
+                "No inline form for an object in an array";
+        }
+        bool saved = fmt->compact_in_array;
+        fmt->compact_in_array = false;
+        meh_emit_char(fmt, '{');
+        size_t emitted = 0;
+        for (size_t i = 0; i < block->count; i++) {
+            const meh_item_t *item = block->items[i];
+            if (item->kind != MEH_ITEM_PROPERTY) continue;
+            if (emitted++) meh_emit(fmt, ", ", 2);
+            meh_compact_key(fmt, item->key);
+            meh_emit(fmt, ": ", 2);
+            if (item->value) {
+                meh_compact_value(fmt, item->value, false);
+            } else if (item->block) {
+                meh_compact_block(fmt, item->block, false);
+            } else {
+                /* Named array: the items sit at the same depth as the
+                 * key, as following siblings */
+                size_t end = i + 1;
+                size_t named = 0;
+                while (end < block->count) {
+                    meh_item_kind_t kind = block->items[end]->kind;
+                    if (kind == MEH_ITEM_ARRAY_ITEM) {
+                        named++;
+                    } else if (kind != MEH_ITEM_BLANK &&
+                               kind != MEH_ITEM_COMMENT) {
+                        break;
+                    }
+                    end++;
+                }
+                if (named) {
+                    meh_emit_char(fmt, '[');
+                    size_t nth = 0;
+                    for (size_t j = i + 1; j < end; j++) {
+                        if (block->items[j]->kind != MEH_ITEM_ARRAY_ITEM) {
+                            continue;
+                        }
+                        if (nth++) meh_emit(fmt, ", ", 2);
+                        meh_compact_element(fmt, block->items[j]);
+                    }
+                    meh_emit_char(fmt, ']');
+                    i = end - 1;
+                } else {
+                    meh_emit(fmt, "null", 4);
+                }
+            }
+        }
+        meh_emit_char(fmt, '}');
+        fmt->compact_in_array = saved;
+    } else if (list_items) {
+        meh_emit_char(fmt, '[');
+        size_t emitted = 0;
+        for (size_t i = 0; i < block->count; i++) {
+            const meh_item_t *item = block->items[i];
+            if (item->kind != MEH_ITEM_ARRAY_ITEM) continue;
+            if (emitted++) meh_emit(fmt, ", ", 2);
+            meh_compact_element(fmt, item);
+        }
+        meh_emit_char(fmt, ']');
+    } else if (values > 1 && strings == values) {
+        meh_emit_char(fmt, '"');
+        for (size_t i = 0; i < block->count; i++) {
+            if (block->items[i]->kind != MEH_ITEM_VALUE) continue;
+            meh_compact_concat_piece(fmt, block->items[i]->value->text);
+        }
+        meh_emit_char(fmt, '"');
+    } else if (values) {
+        for (size_t i = 0; i < block->count; i++) {
+            if (block->items[i]->kind != MEH_ITEM_VALUE) continue;
+            meh_compact_value(fmt, block->items[i]->value, at_root);
+            break;
+        }
+    } else {
+        meh_emit(fmt, "null", 4);
     }
-    
-    return value;
 }
 
-/* ============================================================================
- * Public API
- * ============================================================================ */
-
-yay_result_t yay_parse(const char *source, size_t length, const char *filename) {
-    yay_result_t result = {NULL, NULL};
-    
+yay_error_t *yay_format(const char *source, size_t length,
+                        const yay_format_options_t *options,
+                        yay_writer_t *writer) {
     if (!source) {
-        result.error = calloc(1, sizeof(yay_error_t));
-        result.error->message = str_dup("NULL source");
-        return result;
+        yay_error_t *error = error_alloc();
+        if (error) error->message = str_dup("NULL source");
+        return error;
     }
-    
-    if (length == 0) {
-        length = strlen(source);
+    if (length == 0) length = strlen(source);
+
+    meh_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.wrap = options && options->wrap ? options->wrap : MEH_DEFAULT_WRAP;
+    ctx.arena = yay_arena_create(0);
+    if (!ctx.arena) {
+        yay_error_t *error = error_alloc();
+        if (error) error->message = str_dup("Format out of memory");
+        return error;
     }
-    
-    /* Initialize context */
-    parse_ctx_t ctx = {0};
-    ctx.filename = filename;
-    ctx.source = source;
-    ctx.source_len = length;
-    ctx.line_capacity = 64;
-    ctx.lines = calloc(ctx.line_capacity, sizeof(scan_line_t));
-    ctx.token_capacity = 64;
-    ctx.tokens = calloc(ctx.token_capacity, sizeof(token_t));
-    
-    /* Phase 1: Scan */
-    if (!scan(&ctx)) {
-        result.error = ctx.error;
-        goto cleanup;
+
+    /* Split into line slices; a trailing '\r' per line is dropped the
+     * way the strict scanner drops it */
+    size_t line_count = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (source[i] == '\n') line_count++;
+    }
+    if (length && source[length - 1] != '\n') line_count++;
+    if (line_count) {
+        ctx.lines = arena_alloc(ctx.arena, line_count * sizeof(meh_str_t));
+        if (!ctx.lines) ctx.oom = true;
+    }
+    if (ctx.lines) {
+        size_t at = 0, idx = 0;
+        while (at < length) {
+            const char *nl = memchr(source + at, '\n', length - at);
+            size_t end = nl ? (size_t)(nl - source) : length;
+            size_t len = end - at;
+            if (len && source[end - 1] == '\r') len--;
+            ctx.lines[idx++] = meh_slice(source + at, len);
+            at = end + 1;
+        }
+        ctx.line_count = idx;
     }
-    
-    /* Phase 2: Outline lex */
-    outline_lex(&ctx);
-    
-    /* Phase 3: Parse */
-    result.value = parse_root(&ctx);
-    if (ctx.error) {
-        result.error = ctx.error;
-        yay_free(result.value);
-        result.value = NULL;
+
+    meh_block_t *canonical = NULL;
+    if (!ctx.oom) {
+        meh_block_t *doc = meh_parse_meh(&ctx);
+        if (doc && !ctx.oom) canonical = meh_transform_items(&ctx, doc, 0);
     }
-    
-cleanup:
-    /* Free scan lines */
-    for (size_t i = 0; i < ctx.line_count; i++) {
-        free(ctx.lines[i].line);
-        free(ctx.lines[i].leader);
+    if (!canonical || ctx.oom) {
+        yay_arena_destroy(ctx.arena);
+        yay_error_t *error = error_alloc();
+        if (error) error->message = str_dup("Format out of memory");
+        return error;
     }
-    free(ctx.lines);
-    
-    /* Free tokens */
-    for (size_t i = 0; i < ctx.token_count; i++) {
-        free(ctx.tokens[i].text);
+
+    meh_fmt_t fmt;
+    memset(&fmt, 0, sizeof(fmt));
+    fmt.writer = writer;
+    if (options && options->compact) {
+        bool any = false;
+        for (size_t i = 0; i < canonical->count; i++) {
+            meh_item_kind_t kind = canonical->items[i]->kind;
+            if (kind != MEH_ITEM_BLANK && kind != MEH_ITEM_COMMENT) {
+                any = true;
+                break;
+            }
+        }
+        if (any) {
+            meh_compact_block(&fmt, canonical, true);
+            meh_emit_newline(&fmt);
+        }
+        if (fmt.compact_error) {
+            mem_free(fmt.spaces);
+            yay_arena_destroy(ctx.arena);
+            yay_error_t *error = error_alloc();
+            if (error) error->message = str_dup(fmt.compact_error);
+            return error;
+        }
+    } else {
+        for (size_t i = 0; i < canonical->count; i++) {
+            meh_format_item(&fmt, canonical->items[i]);
+        }
+        if (fmt.column) meh_emit_newline(&fmt);
     }
-    free(ctx.tokens);
-    
-    return result;
+    mem_free(fmt.spaces);
+
+    yay_arena_destroy(ctx.arena);
+    return NULL;
 }
@@ -11,6 +11,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -34,10 +35,19 @@ typedef enum {
 /* Forward declaration */
 typedef struct yay_value yay_value_t;
 
-/* Big integer representation (simple string-based for arbitrary precision) */
+/* Big integer representation. Values that fit in an int64 are stored
+ * inline with digits == NULL; heap digit strings are kept only for true
+ * bignums (and for digit strings with leading zeros, which must round-trip
+ * verbatim). */
 typedef struct {
-    char *digits;   /* String of digits (without sign) */
+    char *digits;   /* Digit string (without sign), or NULL when inlined */
+    int64_t small;  /* Value (with sign) when digits == NULL */
     bool negative;  /* true if negative */
+    /* Magnitude as little-endian base-2^64 limbs, computed lazily on the
+     * first arithmetic call and cached for reuse; NULL until then (and
+     * count 0 means the value is zero once computed) */
+    uint64_t *limbs;
+    size_t limb_count;
 } yay_bigint_t;
 
 /* Object key-value pair */
@@ -49,6 +59,8 @@ typedef struct {
 /* YAY value structure */
 struct yay_value {
     yay_type_t type;
+    /* Shared-owner count for yay_clone; 0 and 1 both mean uniquely owned */
+    size_t refs;
     union {
         bool boolean;
         yay_bigint_t bigint;
@@ -67,6 +79,15 @@ struct yay_value {
             yay_pair_t *pairs;
             size_t length;
             size_t capacity;
+            /* Open-addressing hash index over keys: slot holds pair index
+             * plus one, 0 means empty. Built once objects grow large enough
+             * that linear scans stop being the fastest option. */
+            size_t *index;
+            size_t index_capacity;
+            /* Whether pairs are in strictly ascending key order, as
+             * canonically formatted documents are; enables binary search
+             * when no hash index exists (e.g. mapped YAYB trees) */
+            bool sorted;
         } object;
     } data;
 };
@@ -76,11 +97,24 @@ struct yay_value {
  * ============================================================================ */
 
 typedef struct {
-    char *message;
+    char *message;  /* Rendered lazily: read through yay_error_message */
     int line;       /* 1-based line number */
     int column;     /* 1-based column number */
 } yay_error_t;
 
+/**
+ * Get an error's human-readable message.
+ *
+ * Parsing records only the error ingredients (base message and position);
+ * the full "... at line:column of <filename>" string is rendered on the
+ * first call and cached in the message field, so errors that are created
+ * and discarded never pay for formatting.
+ *
+ * @param error     The error (can be NULL)
+ * @return          The message, owned by the error (do not free)
+ */
+const char *yay_error_message(yay_error_t *error);
+
 /* ============================================================================
  * Parse Result
  * ============================================================================ */
@@ -104,13 +138,493 @@ typedef struct {
  */
 yay_result_t yay_parse(const char *source, size_t length, const char *filename);
 
+/**
+ * Parse a YAY document using the compact value representation.
+ *
+ * Identical to yay_parse except that every null, true, and false in the
+ * document is represented by a shared immutable singleton node instead of
+ * a heap allocation, roughly halving per-node memory for documents dense
+ * in those scalars. The resulting tree is freed normally with yay_free or
+ * yay_result_free; the singletons are recognized and skipped.
+ *
+ * @param source    The YAY source string (UTF-8)
+ * @param length    Length of the source string (or 0 for null-terminated)
+ * @param filename  Optional filename for error messages (can be NULL)
+ * @return          Parse result containing either value or error
+ */
+yay_result_t yay_parse_compact(const char *source, size_t length,
+                               const char *filename);
+
+/* ============================================================================
+ * Allocator Hooks
+ * ============================================================================ */
+
+/* Allocation hooks mirroring malloc, realloc, and free, each receiving the
+ * context registered alongside them. The free hook is never called with
+ * NULL. */
+typedef void *(*yay_malloc_fn)(size_t size, void *ctx);
+typedef void *(*yay_realloc_fn)(void *ptr, size_t size, void *ctx);
+typedef void (*yay_free_fn)(void *ptr, void *ctx);
+
+/**
+ * Route every heap allocation in the library through custom hooks.
+ *
+ * Affects all allocations — value nodes, strings, scratch buffers, errors,
+ * arena slabs — so embedders can direct parser memory into a dedicated
+ * allocator or account it against a budget. Memory that crosses the API
+ * boundary crosses in both directions: buffers returned to the caller
+ * (yay_to_string, yay_writer_take) come from these hooks and must be
+ * released compatibly, and buffers handed to the library (yay_parse_owned)
+ * must have been allocated compatibly. Set the hooks once at startup,
+ * before any other call and never while parser memory is live; passing
+ * NULL for malloc_fn restores the C library defaults.
+ *
+ * @param malloc_fn   Replacement for malloc (NULL restores defaults)
+ * @param realloc_fn  Replacement for realloc
+ * @param free_fn     Replacement for free
+ * @param ctx         Opaque pointer passed to every hook
+ */
+void yay_set_allocator(yay_malloc_fn malloc_fn, yay_realloc_fn realloc_fn,
+                       yay_free_fn free_fn, void *ctx);
+
+/* ============================================================================
+ * Arena Allocation
+ * ============================================================================ */
+
+/* Opaque arena: values are bump-allocated from large slabs and released all
+ * at once, so document teardown is O(1) instead of a recursive free walk. */
+typedef struct yay_arena yay_arena_t;
+
+/**
+ * Create an arena for arena-mode parsing.
+ *
+ * @param block_size  Slab size in bytes (0 for the default)
+ * @return            New arena, or NULL on allocation failure
+ */
+yay_arena_t *yay_arena_create(size_t block_size);
+
+/**
+ * Destroy an arena, releasing every value parsed into it.
+ *
+ * @param arena     The arena to destroy (can be NULL)
+ */
+void yay_arena_destroy(yay_arena_t *arena);
+
+/**
+ * Parse a YAY document, allocating all values from an arena.
+ *
+ * The resulting value tree is owned by the arena: do not pass it to
+ * yay_free or yay_result_free. Errors are still heap-allocated and must
+ * be released with yay_error_free.
+ *
+ * @param source    The YAY source string (UTF-8)
+ * @param length    Length of the source string (or 0 for null-terminated)
+ * @param filename  Optional filename for error messages (can be NULL)
+ * @param arena     Arena that will own all parsed values
+ * @return          Parse result containing either value or error
+ */
+yay_result_t yay_parse_arena(const char *source, size_t length,
+                             const char *filename, yay_arena_t *arena);
+
+/**
+ * Parse a YAY document with borrowed string values.
+ *
+ * Like yay_parse_arena, but string values that need no unescaping view
+ * into a buffer owned by the arena instead of being copied, so
+ * string-dense documents parse with almost no per-scalar allocation.
+ * Strings containing escapes are decoded into arena copies as usual.
+ * Every string (borrowed or not) remains valid until the arena is
+ * destroyed; the same ownership rules as yay_parse_arena apply.
+ *
+ * @param source    The YAY source string (UTF-8)
+ * @param length    Length of the source string (or 0 for null-terminated)
+ * @param filename  Optional filename for error messages (can be NULL)
+ * @param arena     Arena that will own all parsed values and the buffer
+ * @return          Parse result containing either value or error
+ */
+yay_result_t yay_parse_borrowed(const char *source, size_t length,
+                                const char *filename, yay_arena_t *arena);
+
+/**
+ * Parse a YAY document, consuming the caller's source buffer.
+ *
+ * Like yay_parse_borrowed, but instead of copying the source the parser
+ * takes ownership of the buffer and uses it as its working copy: string
+ * values alias straight into it and escapes are decoded in place, so the
+ * raw document and the parsed tree never both exist in full. The buffer
+ * must be heap-allocated and hold length + 1 bytes (or be NUL-terminated
+ * when length is 0). On success the arena owns the buffer; on failure it
+ * is freed. Either way the caller must not touch it again. Passing a
+ * NULL arena falls back to a copying parse and frees the buffer.
+ *
+ * @param source    Heap-allocated YAY source, ownership transfers
+ * @param length    Length of the source string (or 0 for null-terminated)
+ * @param filename  Optional filename for error messages (can be NULL)
+ * @param arena     Arena that will own all parsed values and the buffer
+ * @return          Parse result containing either value or error
+ */
+yay_result_t yay_parse_owned(char *source, size_t length,
+                             const char *filename, yay_arena_t *arena);
+
+/**
+ * Parse a YAY document directly from a file.
+ *
+ * The file is memory-mapped where the platform supports it (with a plain
+ * read fallback), so the scanner consumes the mapping without an extra
+ * read-and-copy pass. The mapping is released before returning; parsed
+ * values own their own memory.
+ *
+ * @param path      Path to the file to parse
+ * @return          Parse result containing either value or error
+ */
+yay_result_t yay_parse_file(const char *path);
+
+/* Resource budgets for parsing untrusted input. A zero field leaves that
+ * budget unlimited. */
+typedef struct {
+    size_t max_nodes;        /* value nodes allocated */
+    size_t max_depth;        /* container nesting depth, per engine */
+    size_t max_string_bytes; /* total bytes across all string values */
+} yay_limits_t;
+
+/**
+ * Parse a YAY document under resource budgets.
+ *
+ * Budgets are charged incrementally as the parse commits resources, so a
+ * hostile document — a billion tiny nodes, pathological nesting, or one
+ * enormous string — aborts at the first allocation over its limit rather
+ * than after being parsed in full. A tripped budget is reported as an
+ * ordinary parse error naming the exceeded limit. The limits struct is
+ * only read for the duration of the call.
+ *
+ * @param source    The YAY source string (UTF-8)
+ * @param length    Length of the source string (or 0 for null-terminated)
+ * @param filename  Optional filename for error messages (can be NULL)
+ * @param limits    Budgets to enforce (NULL parses without limits)
+ * @return          Parse result containing either value or error
+ */
+yay_result_t yay_parse_limited(const char *source, size_t length,
+                               const char *filename,
+                               const yay_limits_t *limits);
+
+/* ============================================================================
+ * Streaming Chunked Input
+ * ============================================================================ */
+
+/* Opaque push-mode parser for data that arrives in chunks */
+typedef struct yay_stream yay_stream_t;
+
+/**
+ * Receives each completed top-level entry of a streamed document: a
+ * one-property object, a one-element array, or a scalar, depending on the
+ * document's root. The receiver owns the value and must release it with
+ * yay_free. Return false to stop the stream.
+ */
+typedef bool (*yay_emit_t)(yay_value_t *value, void *user_data);
+
+/**
+ * Create a push-mode parser. Feed it chunks with yay_feed; each top-level
+ * entry is parsed and emitted as soon as its last byte arrives, so memory
+ * use is bounded by the largest single entry rather than the document.
+ *
+ * @param filename  Optional filename for error messages (can be NULL)
+ * @param emit      Called with each completed top-level value
+ * @param user_data Opaque pointer passed to the callback
+ * @return          The parser, to be released with yay_finish
+ */
+yay_stream_t *yay_stream_create(const char *filename, yay_emit_t emit,
+                                void *user_data);
+
+/**
+ * Feed the next chunk of the document.
+ *
+ * @return false when the stream has already failed or been stopped
+ */
+bool yay_feed(yay_stream_t *stream, const char *chunk, size_t length);
+
+/**
+ * Flush the final entry and destroy the parser.
+ *
+ * @return NULL on success, or the first parse error, positioned on
+ *         absolute document lines; free with yay_error_free
+ */
+yay_error_t *yay_finish(yay_stream_t *stream);
+
+/* ============================================================================
+ * Incremental Reparse
+ * ============================================================================ */
+
+/**
+ * Reparse a document after an edit, reusing the previous result.
+ *
+ * The bytes [edit_start, edit_end) of previous_source are replaced with
+ * new_text. When the edit is confined to a single top-level entry (one
+ * column-0 property or array item), only that entry is reparsed and the
+ * untouched subtrees of previous->value are shared into the new result;
+ * otherwise the composed document is parsed from scratch. Either way the
+ * returned result is independent of the previous one and both must be
+ * released with yay_result_free.
+ *
+ * @param previous        Result of parsing previous_source (may be NULL)
+ * @param previous_source The document as previously parsed
+ * @param previous_length Length of previous_source (or 0 for null-terminated)
+ * @param edit_start      Start of the replaced byte range
+ * @param edit_end        End of the replaced byte range (exclusive)
+ * @param new_text        Replacement text
+ * @param new_text_length Length of new_text (or 0 for null-terminated)
+ * @param filename        Optional filename for error messages (can be NULL)
+ * @return                The parse result for the edited document
+ */
+yay_result_t yay_reparse(const yay_result_t *previous,
+                         const char *previous_source, size_t previous_length,
+                         size_t edit_start, size_t edit_end,
+                         const char *new_text, size_t new_text_length,
+                         const char *filename);
+
+/* ============================================================================
+ * Parse Statistics
+ * ============================================================================ */
+
+/* Per-phase measurements for the most recent parse on this thread.
+ * Populated only when the library is built with -DYAY_STATS; otherwise
+ * yay_parse_stats reports zeros and the counters cost nothing. */
+typedef struct {
+    double scan_seconds;      /* phase 1: source scan and line split */
+    double lex_seconds;       /* phase 2: outline lexing */
+    double build_seconds;     /* phase 3: parsing and tree building */
+    size_t scan_allocations;  /* heap allocations per phase */
+    size_t lex_allocations;
+    size_t build_allocations;
+    size_t lines;             /* scan lines produced */
+    size_t tokens;            /* outline tokens produced */
+    size_t nodes;             /* value nodes allocated */
+} yay_stats_t;
+
+/**
+ * Retrieve statistics for the most recent parse on the calling thread.
+ *
+ * @param stats Filled with the last parse's measurements, or zeros when
+ *              the library was built without -DYAY_STATS
+ */
+void yay_parse_stats(yay_stats_t *stats);
+
+/* ============================================================================
+ * Schema-Driven Decoding
+ * ============================================================================ */
+
+/* One field of a destination struct: a top-level property name, the
+ * field's byte offset (use offsetof), and the expected value type.
+ * Supported types and their field representations:
+ *   YAY_BOOL   -> bool
+ *   YAY_INT    -> int64_t
+ *   YAY_FLOAT  -> double
+ *   YAY_STRING -> char * (heap copy, freed by the caller)
+ * Other types are not decoded; their descriptors are ignored. */
+typedef struct {
+    const char *name;
+    size_t offset;
+    yay_type_t type;
+} yay_field_t;
+
+/**
+ * Decode a document's top-level object straight into a C struct.
+ *
+ * Drives the streaming event parser and writes matching scalar
+ * properties directly into *out, so no yay_value_t tree is built or
+ * traversed. Unknown properties, nested containers, and properties
+ * whose value type differs from the descriptor are skipped, leaving the
+ * corresponding fields untouched.
+ *
+ * @param source      The YAY source string (UTF-8)
+ * @param length      Length of the source string (or 0 for null-terminated)
+ * @param filename    Optional filename for error messages (can be NULL)
+ * @param fields      Field descriptors
+ * @param field_count Number of descriptors
+ * @param out         Destination struct
+ * @return            NULL on success, or an error to free with
+ *                    yay_error_free
+ */
+yay_error_t *yay_parse_into(const char *source, size_t length,
+                            const char *filename,
+                            const yay_field_t *fields, size_t field_count,
+                            void *out);
+
+/* ============================================================================
+ * Batch Parsing
+ * ============================================================================ */
+
+/* One document in a batch. Set arena to parse into a caller-owned arena
+ * (each input needs its own arena — inputs are scheduled dynamically, so
+ * two inputs sharing an arena may be parsed concurrently); leave it NULL
+ * for individually freeable heap values. */
+typedef struct {
+    const char *source;     /* YAY source string (UTF-8) */
+    size_t length;          /* length, or 0 for null-terminated */
+    const char *filename;   /* optional, for error messages */
+    yay_arena_t *arena;     /* optional arena to own the parsed values */
+} yay_input_t;
+
+/**
+ * Parse a batch of independent documents across a worker pool.
+ *
+ * results[i] receives the outcome for inputs[i], with the same ownership
+ * rules as yay_parse or yay_parse_arena depending on whether the input
+ * carries an arena. Pass threads <= 0 to use one worker per online core;
+ * the calling thread always participates, so threads == 1 parses inline.
+ *
+ * @param inputs    The documents to parse
+ * @param count     Number of documents
+ * @param threads   Worker count, or <= 0 for the core count
+ * @param results   Receives one parse result per input
+ */
+void yay_parse_batch(const yay_input_t *inputs, size_t count, int threads,
+                     yay_result_t *results);
+
+/**
+ * Parse one large document across a worker pool.
+ *
+ * When the document's top level is an outline array, its "- " item
+ * boundaries are found with a cheap structural scan, contiguous runs of
+ * items are parsed as independent chunks on the batch pool, and the
+ * resulting arrays are spliced back together. Documents with any other
+ * top-level shape — and documents where a chunk fails to parse, so that
+ * error positions stay exact — are parsed sequentially instead; the
+ * result is always identical to yay_parse.
+ *
+ * @param source    The YAY source string (UTF-8)
+ * @param length    Length of the source string (or 0 for null-terminated)
+ * @param filename  Optional filename for error messages (can be NULL)
+ * @param threads   Worker count, or <= 0 for the core count
+ * @return          Parse result containing either value or error
+ */
+yay_result_t yay_parse_parallel(const char *source, size_t length,
+                                const char *filename, int threads);
+
+/* ============================================================================
+ * Streaming Events API
+ * ============================================================================ */
+
+/* Callbacks for event-driven parsing. Any callback may be NULL to skip that
+ * event. A callback returning false stops further event delivery (parsing
+ * still completes so syntax errors are reported either way). */
+typedef struct {
+    bool (*on_null)(void *user_data);
+    bool (*on_bool)(bool value, void *user_data);
+    bool (*on_int)(const char *digits, bool negative, void *user_data);
+    bool (*on_float)(double value, void *user_data);
+    bool (*on_string)(const char *str, size_t length, void *user_data);
+    bool (*on_bytes)(const uint8_t *data, size_t length, void *user_data);
+    bool (*on_array_start)(void *user_data);
+    bool (*on_array_end)(void *user_data);
+    bool (*on_object_start)(void *user_data);
+    bool (*on_object_key)(const char *key, size_t length, void *user_data);
+    bool (*on_object_end)(void *user_data);
+} yay_callbacks_t;
+
+/**
+ * Parse a YAY document, delivering events instead of building a tree.
+ *
+ * Runs the same scanner, lexer, and parser phases as yay_parse, but no
+ * document tree is materialized: values are reported to the callbacks as
+ * they are parsed, so filtering pipelines run with zero tree allocation.
+ *
+ * @param source    The YAY source string (UTF-8)
+ * @param length    Length of the source string (or 0 for null-terminated)
+ * @param filename  Optional filename for error messages (can be NULL)
+ * @param callbacks Event callbacks (individual entries can be NULL)
+ * @param user_data Opaque pointer passed to every callback
+ * @return          NULL on success, or an error (free with yay_error_free)
+ */
+yay_error_t *yay_parse_events(const char *source, size_t length,
+                              const char *filename,
+                              const yay_callbacks_t *callbacks,
+                              void *user_data);
+
+/**
+ * Check a YAY document for syntax errors without building a tree.
+ *
+ * Runs the full scanner, lexer, and structural checks but materializes no
+ * document values, so batch gating over many files pays only for parsing.
+ *
+ * @param source    The YAY source string (UTF-8)
+ * @param length    Length of the source string (or 0 for null-terminated)
+ * @param filename  Optional filename for error messages (can be NULL)
+ * @param error     Receives the error on failure (can be NULL; free with
+ *                  yay_error_free)
+ * @return          true if the document is valid
+ */
+bool yay_validate(const char *source, size_t length, const char *filename,
+                  yay_error_t **error);
 /**
  * Free a YAY value and all its children.
  *
+ * Cloned values are released: the tree is destroyed only when the last
+ * owner frees it.
+ *
  * @param value     The value to free (can be NULL)
  */
 void yay_free(yay_value_t *value);
 
+/**
+ * Share a value tree by reference.
+ *
+ * Returns the same node with its owner count atomically incremented, so
+ * sharing a tree of any size costs one increment. Release each clone
+ * with yay_free as usual. Mutating a shared node through yay_object_set
+ * or yay_array_push copies just that node first (children stay shared)
+ * and returns the copy, so use those functions' return values whenever
+ * clones may exist.
+ *
+ * @param value     The value to share (can be NULL)
+ * @return          The shared value
+ */
+yay_value_t *yay_clone(const yay_value_t *value);
+
+/**
+ * Collapse identical subtrees into shared nodes.
+ *
+ * Walks the tree bottom-up and replaces every subtree that is
+ * structurally equal to an earlier one with a yay_clone of the first
+ * occurrence, so documents full of repeated blocks keep a single copy
+ * of each distinct shape. The tree is rewritten in place; treat it as
+ * immutable afterwards, or mutate only through the copy-on-write
+ * accessors (yay_object_set, yay_array_push), which unshare first.
+ * Subtrees that already have shared owners are left as they are. Not
+ * for arena- or mapped-backed trees, whose nodes cannot be released
+ * individually.
+ *
+ * @param value     Root of the tree to deduplicate
+ * @return          Number of subtrees collapsed into shared nodes
+ */
+size_t yay_dedup(yay_value_t *value);
+
+/**
+ * Report a tree's exact heap footprint in bytes.
+ *
+ * Counts every node plus the buffers it owns: digit strings and limb
+ * caches, string and byte payloads, container storage at its current
+ * capacity (including doubling-growth slack), object hash indexes, and
+ * key cells. Interned keys and cloned subtrees are charged once per
+ * occurrence.
+ *
+ * @param value     Root of the tree to measure (can be NULL)
+ * @return          Total footprint in bytes
+ */
+size_t yay_memory_usage(const yay_value_t *value);
+
+/**
+ * Trim container storage to exactly the elements held.
+ *
+ * Arrays and objects grow by doubling, so a long-lived tree can retain
+ * substantial slack in its items and pairs allocations. Call once after
+ * parse on trees kept resident; later pushes simply grow again. Not for
+ * arena- or mapped-backed trees, whose storage cannot be reallocated
+ * individually.
+ *
+ * @param value     Root of the tree to trim (can be NULL)
+ */
+void yay_shrink_to_fit(yay_value_t *value);
+
 /**
  * Free a YAY error.
  *
@@ -144,9 +658,121 @@ yay_value_t *yay_object(void);
 /* Array operations - returns array for chaining */
 yay_value_t *yay_array_push(yay_value_t *array, yay_value_t *item);
 
+/* Pre-size an array so builders with known element counts allocate once */
+yay_value_t *yay_array_reserve(yay_value_t *array, size_t capacity);
+
 /* Object operations - returns object for chaining */
 yay_value_t *yay_object_set(yay_value_t *object, const char *key, yay_value_t *value);
 
+/* Pre-size an object's pair storage, like yay_array_reserve */
+yay_value_t *yay_object_reserve(yay_value_t *object, size_t capacity);
+
+/* Object lookup - returns the value for key, or NULL if absent */
+yay_value_t *yay_object_get(const yay_value_t *object, const char *key);
+
+/**
+ * Read an integer value as an int64.
+ *
+ * @param value     The value to read
+ * @param out       Receives the integer on success
+ * @return          true if value is an integer that fits in int64_t
+ */
+bool yay_int_value(const yay_value_t *value, int64_t *out);
+
+/* ============================================================================
+ * Path Queries
+ * ============================================================================ */
+
+/* Opaque compiled path: a fixed sequence of object-key and array-index
+ * hops, parsed once and reusable across any number of documents. */
+typedef struct yay_path yay_path_t;
+
+/**
+ * Compile a path expression.
+ *
+ * The expression is a dot-separated chain of property names with
+ * bracketed array indexes, e.g. "servers[2].listen.port". Names use the
+ * same characters as unquoted YAY keys (letters, digits, '_', '-');
+ * other keys are written single-quoted inside brackets, with '' for a
+ * literal quote, e.g. "servers[2]['bind addr']".
+ *
+ * @param expression  The path expression
+ * @return            The compiled path (free with yay_path_free), or
+ *                    NULL if the expression is malformed
+ */
+yay_path_t *yay_path_compile(const char *expression);
+
+/**
+ * Walk a compiled path from a value.
+ *
+ * Each hop is an object property lookup (hash-indexed once objects grow
+ * large) or a direct array index, so repeated extraction avoids
+ * handwritten scans over pairs.
+ *
+ * @param value     The value to start from
+ * @param path      The compiled path
+ * @return          The value at the path, borrowed from the tree, or
+ *                  NULL when any hop is missing or mistyped
+ */
+yay_value_t *yay_get_path(const yay_value_t *value, const yay_path_t *path);
+
+/**
+ * Free a compiled path.
+ *
+ * @param path      The path to free (can be NULL)
+ */
+void yay_path_free(yay_path_t *path);
+
+/* ============================================================================
+ * Bignum Arithmetic
+ * ============================================================================ */
+
+/**
+ * Compare two integers numerically.
+ *
+ * The first call converts each operand's decimal digits to limbs and
+ * caches them on the operand, so repeated comparisons run on word-sized
+ * machine integers instead of digit strings.
+ *
+ * @param a         First operand
+ * @param b         Second operand
+ * @return          negative, zero, or positive as a is <, ==, or > b
+ */
+int yay_bigint_cmp(yay_bigint_t *a, yay_bigint_t *b);
+
+/**
+ * Add two integers of arbitrary magnitude.
+ *
+ * The result is written to out: inline when it fits in an int64, with
+ * heap digits (and a warm limb cache) otherwise. Release a non-inline
+ * result with yay_bigint_clear unless it is handed to a value.
+ *
+ * @param a         First operand
+ * @param b         Second operand
+ * @param out       Receives the sum
+ * @return          true on success, false on allocation failure
+ */
+bool yay_bigint_add(yay_bigint_t *a, yay_bigint_t *b, yay_bigint_t *out);
+
+/**
+ * Extract an integer's value when it fits in an int64.
+ *
+ * @param value     The integer
+ * @param out       Receives the value
+ * @return          true if the value fits, false otherwise
+ */
+bool yay_bigint_to_int64(const yay_bigint_t *value, int64_t *out);
+
+/**
+ * Release a standalone integer's heap digits and limb cache.
+ *
+ * Integers embedded in values are released by yay_free; this is only for
+ * results produced directly by yay_bigint_add.
+ *
+ * @param value     The integer to clear (fields are reset)
+ */
+void yay_bigint_clear(yay_bigint_t *value);
+
 /* Batch constructors (backing functions for macros below) */
 yay_value_t *yay_array_of(yay_value_t **items, size_t count);
 yay_value_t *yay_object_of(void **kvs, size_t count);
@@ -179,6 +805,18 @@ yay_value_t *yay_object_of(void **kvs, size_t count);
  */
 bool yay_equal(const yay_value_t *a, const yay_value_t *b);
 
+/**
+ * Compute a structural hash of a YAY value.
+ *
+ * Values that compare equal under yay_equal hash identically (object key
+ * order is insignificant), so hashes can key dedup tables and reject
+ * unequal documents in O(1) before a deep comparison.
+ *
+ * @param value     The value to hash
+ * @return          64-bit structural hash
+ */
+uint64_t yay_hash(const yay_value_t *value);
+
 /**
  * Convert a YAY value to a string representation (for debugging).
  *
@@ -187,6 +825,245 @@ bool yay_equal(const yay_value_t *a, const yay_value_t *b);
  */
 char *yay_to_string(const yay_value_t *value);
 
+/* ============================================================================
+ * Output Writer
+ * ============================================================================ */
+
+/* Length-tracked output sink: either an amortized-growth memory buffer or a
+ * FILE* stream. Appends are memcpy-sized, never strlen-rescanned. */
+typedef struct {
+    char *data;         /* Buffer sink (NUL-terminated), NULL for streams */
+    size_t length;
+    size_t capacity;
+    FILE *stream;       /* Stream sink, NULL for buffers */
+    bool failed;        /* Sticky write-failure flag */
+} yay_writer_t;
+
+/**
+ * Initialize a writer backed by a growable memory buffer.
+ *
+ * @param writer    The writer to initialize
+ */
+void yay_writer_init(yay_writer_t *writer);
+
+/**
+ * Initialize a writer that appends directly to a stream.
+ *
+ * @param writer    The writer to initialize
+ * @param stream    Destination stream (e.g. stdout or an open file)
+ */
+void yay_writer_init_stream(yay_writer_t *writer, FILE *stream);
+
+/**
+ * Append bytes to a writer.
+ *
+ * @param writer    The writer
+ * @param data      Bytes to append
+ * @param length    Number of bytes
+ * @return          true on success, false after any write failure
+ */
+bool yay_writer_write(yay_writer_t *writer, const char *data, size_t length);
+
+/**
+ * Take ownership of a buffer writer's contents.
+ *
+ * @param writer    The writer (reset to empty)
+ * @return          NUL-terminated string (caller must free), NULL for streams
+ */
+char *yay_writer_take(yay_writer_t *writer);
+
+/**
+ * Release a writer's buffer (streams are not closed).
+ *
+ * @param writer    The writer to release
+ */
+void yay_writer_free(yay_writer_t *writer);
+
+/**
+ * Serialize a value into a writer.
+ *
+ * @param value     The value to encode
+ * @param writer    Destination writer
+ * @return          true on success, false after any write failure
+ */
+bool yay_encode(const yay_value_t *value, yay_writer_t *writer);
+
+/* ============================================================================
+ * CBOR Transcoding
+ * ============================================================================ */
+
+/**
+ * Transcode a YAY document to CBOR (RFC 8949).
+ *
+ * Drives the streaming event parser straight into the writer, so conversion
+ * runs at I/O speed without materializing a value tree. Arrays and objects
+ * are encoded with indefinite lengths (element counts are unknown mid-stream)
+ * and integers beyond 64 bits use bignum tags 2 and 3.
+ *
+ * @param source    The YAY source string (UTF-8)
+ * @param length    Length of the source string (or 0 for null-terminated)
+ * @param filename  Optional filename for error messages (can be NULL)
+ * @param writer    Destination writer (receives binary CBOR)
+ * @return          NULL on success, or an error (free with yay_error_free)
+ */
+yay_error_t *yay_to_cbor(const char *source, size_t length,
+                         const char *filename, yay_writer_t *writer);
+
+/**
+ * Decode a CBOR item, delivering the same events yay_parse_events emits.
+ *
+ * Accepts definite- and indefinite-length containers, half, single, and
+ * double precision floats, and bignum tags 2 and 3 (reported as decimal
+ * digit strings through on_int). Map keys must be text strings; other tags
+ * and simple values are rejected as having no YAY equivalent. The error
+ * position reports the byte offset in the column field.
+ *
+ * @param data      CBOR bytes (exactly one item)
+ * @param length    Number of bytes
+ * @param callbacks Event callbacks (individual entries can be NULL)
+ * @param user_data Opaque pointer passed to every callback
+ * @return          NULL on success, or an error (free with yay_error_free)
+ */
+yay_error_t *yay_from_cbor(const uint8_t *data, size_t length,
+                           const yay_callbacks_t *callbacks, void *user_data);
+
+/* ============================================================================
+ * JSON Transcoding
+ * ============================================================================ */
+
+/**
+ * Decode a JSON text, delivering the same events yay_parse_events emits.
+ *
+ * Strings without escape sequences are reported as slices borrowed from the
+ * source, so string-dense documents decode without per-scalar copies;
+ * escaped strings are unescaped (including \uXXXX surrogate pairs) into a
+ * scratch buffer that is only valid for the duration of the callback.
+ * Numbers without a fraction or exponent are reported through on_int as
+ * decimal digit strings; all others go through on_float.
+ *
+ * @param source    The JSON text (UTF-8)
+ * @param length    Length of the text (or 0 for null-terminated)
+ * @param callbacks Event callbacks (individual entries can be NULL)
+ * @param user_data Opaque pointer passed to every callback
+ * @return          NULL on success, or an error (free with yay_error_free)
+ */
+yay_error_t *yay_from_json_events(const char *source, size_t length,
+                                  const yay_callbacks_t *callbacks,
+                                  void *user_data);
+
+/**
+ * Parse a JSON text into a value tree.
+ *
+ * The tree is built through the ordinary constructors, so the result is
+ * interchangeable with yay_parse output: query it, encode it, or free it
+ * with yay_free the same way.
+ *
+ * @param source    The JSON text (UTF-8)
+ * @param length    Length of the text (or 0 for null-terminated)
+ * @return          A result holding either the value or an error
+ */
+yay_result_t yay_from_json(const char *source, size_t length);
+
+/**
+ * Parse a JSON text with all values allocated from an arena.
+ *
+ * Like yay_parse_arena: release the whole tree at once by destroying the
+ * arena; do not call yay_free on the result.
+ *
+ * @param source    The JSON text (UTF-8)
+ * @param length    Length of the text (or 0 for null-terminated)
+ * @param arena     The arena to allocate from
+ * @return          A result holding either the value or an error
+ */
+yay_result_t yay_from_json_arena(const char *source, size_t length,
+                                 yay_arena_t *arena);
+
+/**
+ * Transcode a JSON text to YAY.
+ *
+ * Drives the JSON decode events straight into the writer, producing exactly
+ * what yay_to_string would for the parsed tree, so migration runs at I/O
+ * speed without materializing a value tree.
+ *
+ * @param source    The JSON text (UTF-8)
+ * @param length    Length of the text (or 0 for null-terminated)
+ * @param writer    Destination writer (receives inline YAY)
+ * @return          NULL on success, or an error (free with yay_error_free)
+ */
+yay_error_t *yay_json_to_yay(const char *source, size_t length,
+                             yay_writer_t *writer);
+
+/* ============================================================================
+ * MEH Formatter
+ * ============================================================================ */
+
+/* Formatting knobs; zeroed fields take the defaults noted per field */
+typedef struct {
+    size_t wrap;    /* Line wrap column (default 80) */
+    bool compact;   /* Emit the document inline on one line with minimal
+                     * whitespace, for machine producers; comments are
+                     * dropped and wrap is ignored */
+} yay_format_options_t;
+
+/**
+ * Reformat a YAY document to canonical form, preserving comments.
+ *
+ * Parses loose YAY (MEH) into a concrete syntax tree that keeps comments,
+ * blank lines, and key order, normalizes it — collapsing blank-line runs,
+ * canonicalizing number and hex spacing, aligning inline comments within
+ * groups, rewrapping long comments, and converting inline containers that
+ * overflow the wrap column to block form — and writes the result. The tree
+ * borrows slices of the source, so reformatting does not copy unchanged
+ * text into intermediate strings.
+ *
+ * @param source    The YAY source string (UTF-8)
+ * @param length    Length of the source string (or 0 for null-terminated)
+ * @param options   Formatting options (NULL for defaults)
+ * @param writer    Destination writer (receives canonical YAY)
+ * @return          NULL on success, or an error (free with yay_error_free)
+ */
+yay_error_t *yay_format(const char *source, size_t length,
+                        const yay_format_options_t *options,
+                        yay_writer_t *writer);
+
+/* ============================================================================
+ * Binary YAYB Format
+ * ============================================================================ */
+
+/**
+ * Compile a value tree into the YAYB binary format.
+ *
+ * The image is position independent: every pointer field is stored as an
+ * offset from the start of the image, with strings, bytes, and tables laid
+ * out inline. A compiled file can be written to disk once and then loaded
+ * with yay_load_mapped at every subsequent start without re-parsing. Images
+ * are tied to the producing build's value layout and pointer size; the
+ * loader rejects mismatches.
+ *
+ * @param value     The value to compile
+ * @param writer    Destination writer
+ * @return          true on success, false after any write failure
+ */
+bool yay_compile(const yay_value_t *value, yay_writer_t *writer);
+
+/**
+ * Load a YAYB image in place.
+ *
+ * Relocates the image's offsets into pointers and returns the root value,
+ * with zero parsing and zero per-node allocation. The memory must be
+ * writable (e.g. mmap with MAP_PRIVATE), aligned for yay_value_t, must
+ * outlive the returned tree, and must be relocated at most once per
+ * mapping. The returned tree is read-only: traverse it with the ordinary
+ * accessors, but do not pass it to yay_free, yay_array_push, or
+ * yay_object_set.
+ *
+ * @param data      Start of the image
+ * @param length    Image size in bytes
+ * @return          The root value, or NULL if the image is malformed or
+ *                  was produced by an incompatible build
+ */
+yay_value_t *yay_load_mapped(void *data, size_t length);
+
 #ifdef __cplusplus
 }
 #endif
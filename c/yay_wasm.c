@@ -0,0 +1,135 @@
+/*
+ * Linear-Memory Accessor Layer for the WebAssembly Build
+ *
+ * Build with `make wasm` (requires emscripten's emcc); the module lands in
+ * js/libyay/yay.wasm where the JavaScript package picks it up. WebAssembly
+ * callers cannot receive C structs by value or read them portably, so every
+ * export here traffics in pointers and scalars: parse once, then walk the
+ * tree through the accessor calls below and copy strings and byte spans out
+ * of linear memory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "yay.h"
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#define YAYW_EXPORT EMSCRIPTEN_KEEPALIVE
+#else
+#define YAYW_EXPORT
+#endif
+
+/* Buffer management for marshalling sources in and strings out */
+
+YAYW_EXPORT void *yayw_alloc(size_t size) {
+    return malloc(size);
+}
+
+YAYW_EXPORT void yayw_free(void *ptr) {
+    free(ptr);
+}
+
+/* Parsing */
+
+YAYW_EXPORT yay_result_t *yayw_parse(const char *source, size_t length,
+                                     const char *filename) {
+    yay_result_t *result = malloc(sizeof(*result));
+    if (result) *result = yay_parse(source, length, filename);
+    return result;
+}
+
+YAYW_EXPORT const char *yayw_error_message(const yay_result_t *result) {
+    return result && result->error ? yay_error_message(result->error) : NULL;
+}
+
+YAYW_EXPORT yay_value_t *yayw_result_value(const yay_result_t *result) {
+    return result ? result->value : NULL;
+}
+
+YAYW_EXPORT void yayw_result_free(yay_result_t *result) {
+    if (!result) return;
+    yay_result_free(result);
+    free(result);
+}
+
+/* Value accessors */
+
+YAYW_EXPORT int yayw_type(const yay_value_t *value) {
+    return value ? (int)value->type : -1;
+}
+
+YAYW_EXPORT int yayw_bool(const yay_value_t *value) {
+    return value->data.boolean ? 1 : 0;
+}
+
+YAYW_EXPORT double yayw_float(const yay_value_t *value) {
+    return value->data.number;
+}
+
+/* Decimal text of an integer, without the 'n' suffix; release the buffer
+ * with yayw_free */
+YAYW_EXPORT char *yayw_int_text(const yay_value_t *value) {
+    if (value->data.bigint.digits) {
+        const char *digits = value->data.bigint.digits;
+        size_t length = strlen(digits);
+        bool negative = value->data.bigint.negative;
+        char *text = malloc(length + (negative ? 1 : 0) + 1);
+        if (!text) return NULL;
+        if (negative) text[0] = '-';
+        memcpy(text + (negative ? 1 : 0), digits, length + 1);
+        return text;
+    }
+    char *text = malloc(24);
+    if (text) {
+        snprintf(text, 24, "%lld", (long long)value->data.bigint.small);
+    }
+    return text;
+}
+
+YAYW_EXPORT const char *yayw_string(const yay_value_t *value) {
+    return value->data.string;
+}
+
+YAYW_EXPORT size_t yayw_string_length(const yay_value_t *value) {
+    return strlen(value->data.string);
+}
+
+YAYW_EXPORT const uint8_t *yayw_bytes(const yay_value_t *value) {
+    return value->data.bytes.data;
+}
+
+YAYW_EXPORT size_t yayw_bytes_length(const yay_value_t *value) {
+    return value->data.bytes.length;
+}
+
+YAYW_EXPORT size_t yayw_array_length(const yay_value_t *value) {
+    return value->data.array.length;
+}
+
+YAYW_EXPORT yay_value_t *yayw_array_item(const yay_value_t *value, size_t i) {
+    return i < value->data.array.length ? value->data.array.items[i] : NULL;
+}
+
+YAYW_EXPORT size_t yayw_object_length(const yay_value_t *value) {
+    return value->data.object.length;
+}
+
+YAYW_EXPORT const char *yayw_object_key(const yay_value_t *value, size_t i) {
+    return i < value->data.object.length ? value->data.object.pairs[i].key
+                                         : NULL;
+}
+
+YAYW_EXPORT yay_value_t *yayw_object_value(const yay_value_t *value,
+                                           size_t i) {
+    return i < value->data.object.length ? value->data.object.pairs[i].value
+                                         : NULL;
+}
+
+/* Encoding; release the returned string with yayw_free */
+
+YAYW_EXPORT char *yayw_to_string(const yay_value_t *value) {
+    return yay_to_string(value);
+}
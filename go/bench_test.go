@@ -0,0 +1,151 @@
+package yay
+
+import (
+	"fmt"
+	"os"
+	"path/filepath"
+	"strings"
+	"testing"
+)
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+//
+// Run with scripts/test-go.sh --bench, or directly:
+//
+//	go test -run '^$' -bench . -benchmem
+//
+// The corpus benchmark parses every document under test/yay so numbers
+// are comparable against the C implementation's bench_yay and across
+// commits; the synthetic benchmarks isolate wide, deep, and
+// number-dense shapes; the phase benchmarks split the scanner, outline
+// lexer, and parser.
+
+// loadCorpus reads every document in the shared test/yay corpus.
+func loadCorpus(b *testing.B) ([][]byte, int64) {
+	b.Helper()
+	paths, err := filepath.Glob(filepath.Join("..", "test", "yay", "*.yay"))
+	if err != nil || len(paths) == 0 {
+		b.Fatalf("no corpus documents: %v", err)
+	}
+	var docs [][]byte
+	var total int64
+	for _, path := range paths {
+		data, err := os.ReadFile(path)
+		if err != nil {
+			b.Fatalf("failed to read %s: %v", path, err)
+		}
+		docs = append(docs, data)
+		total += int64(len(data))
+	}
+	return docs, total
+}
+
+func BenchmarkCorpus(b *testing.B) {
+	docs, total := loadCorpus(b)
+	b.ReportAllocs()
+	b.SetBytes(total)
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		for _, doc := range docs {
+			if _, err := Unmarshal(doc); err != nil {
+				b.Fatal(err)
+			}
+		}
+	}
+}
+
+// wideDocument is one object with many scalar properties.
+func wideDocument() []byte {
+	var doc strings.Builder
+	for i := 0; i < 1000; i++ {
+		fmt.Fprintf(&doc, "key%04d: \"value %d\"\n", i, i)
+	}
+	return []byte(doc.String())
+}
+
+// deepDocument nests one object per indent level.
+func deepDocument() []byte {
+	var doc strings.Builder
+	const depth = 64
+	for i := 0; i < depth; i++ {
+		doc.WriteString(strings.Repeat("  ", i))
+		doc.WriteString("a:\n")
+	}
+	doc.WriteString(strings.Repeat("  ", depth))
+	doc.WriteString("b: 1\n")
+	return []byte(doc.String())
+}
+
+// numberDocument is a long list of mixed integers and floats.
+func numberDocument() []byte {
+	var doc strings.Builder
+	for i := 0; i < 2000; i++ {
+		if i%2 == 0 {
+			fmt.Fprintf(&doc, "- %d\n", i*7919)
+		} else {
+			fmt.Fprintf(&doc, "- %d.%d\n", i, i%100)
+		}
+	}
+	return []byte(doc.String())
+}
+
+func BenchmarkSynthetic(b *testing.B) {
+	for _, c := range []struct {
+		name string
+		data []byte
+	}{
+		{"wide", wideDocument()},
+		{"deep", deepDocument()},
+		{"numbers", numberDocument()},
+	} {
+		b.Run(c.name, func(b *testing.B) {
+			b.ReportAllocs()
+			b.SetBytes(int64(len(c.data)))
+			for i := 0; i < b.N; i++ {
+				if _, err := Unmarshal(c.data); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
+
+func BenchmarkPhases(b *testing.B) {
+	source := string(wideDocument())
+	ctx := &parseContext{}
+
+	lines, err := scan(source, ctx, nil)
+	if err != nil {
+		b.Fatal(err)
+	}
+	tokens := outlineLex(lines, nil)
+
+	b.Run("scan", func(b *testing.B) {
+		b.ReportAllocs()
+		b.SetBytes(int64(len(source)))
+		var buf []scanLine
+		for i := 0; i < b.N; i++ {
+			buf, err = scan(source, ctx, buf[:0])
+			if err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+	b.Run("outlineLex", func(b *testing.B) {
+		b.ReportAllocs()
+		var buf []token
+		for i := 0; i < b.N; i++ {
+			buf = outlineLex(lines, buf[:0])
+		}
+	})
+	b.Run("parseRoot", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			if _, err := parseRoot(tokens, ctx); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+}
@@ -0,0 +1,68 @@
+// bench_corpus parses every .yay file in a corpus directory a number of
+// times and prints one machine-readable line, "<bytes> <seconds>", for
+// scripts/bench.sh to turn into a cross-implementation MB/s and
+// peak-RSS table.
+//
+// Usage: bench_corpus [corpus-dir] [reps]   (default ../test/yay, 100)
+package main
+
+import (
+	"fmt"
+	"os"
+	"path/filepath"
+	"sort"
+	"strconv"
+	"strings"
+	"time"
+
+	yay "kriskowal.com/go/yay"
+)
+
+func main() {
+	dir := "../test/yay"
+	if len(os.Args) > 1 {
+		dir = os.Args[1]
+	}
+	reps := 100
+	if len(os.Args) > 2 {
+		n, err := strconv.Atoi(os.Args[2])
+		if err != nil {
+			fmt.Fprintf(os.Stderr, "bad rep count %q\n", os.Args[2])
+			os.Exit(1)
+		}
+		reps = n
+	}
+
+	entries, err := os.ReadDir(dir)
+	if err != nil {
+		fmt.Fprintf(os.Stderr, "cannot open corpus directory %s: %v\n", dir, err)
+		os.Exit(1)
+	}
+	var sources [][]byte
+	var totalBytes int
+	var names []string
+	for _, entry := range entries {
+		if strings.HasSuffix(entry.Name(), ".yay") {
+			names = append(names, entry.Name())
+		}
+	}
+	sort.Strings(names)
+	for _, name := range names {
+		data, err := os.ReadFile(filepath.Join(dir, name))
+		if err != nil {
+			continue
+		}
+		sources = append(sources, data)
+		totalBytes += len(data)
+	}
+
+	start := time.Now()
+	for rep := 0; rep < reps; rep++ {
+		for _, source := range sources {
+			_, _ = yay.Unmarshal(source)
+		}
+	}
+	elapsed := time.Since(start).Seconds()
+
+	fmt.Printf("%d %.6f\n", totalBytes*reps, elapsed)
+}
@@ -18,13 +18,25 @@
 package yay
 
 import (
+	"bufio"
+	"bytes"
 	"encoding/hex"
 	"fmt"
+	"io"
 	"math"
 	"math/big"
+	"os"
+	"reflect"
 	"regexp"
+	"runtime"
+	"sort"
 	"strconv"
 	"strings"
+	"sync"
+	"sync/atomic"
+	"unicode"
+	"unicode/utf8"
+	"unsafe"
 )
 
 // ============================================================================
@@ -36,7 +48,7 @@ import (
 // The mapping between YAY and Go values is:
 //   - null -> nil
 //   - boolean -> bool
-//   - integer -> *big.Int
+//   - integer -> int64, or *big.Int beyond the int64 range
 //   - float -> float64 (including NaN, Infinity, -Infinity)
 //   - string -> string
 //   - array -> []any
@@ -51,10 +63,871 @@ func UnmarshalFile(data []byte, filename string) (any, error) {
 	return unmarshal(data, filename)
 }
 
+// UnmarshalNoCopy is like Unmarshal, but skips the defensive copy of
+// data: strings in the result alias the caller's buffer whenever their
+// source text needed no escape processing. Only strings with escapes,
+// block strings, and bytes values are materialized separately, so
+// string allocation for clean documents drops to near zero.
+//
+// The caller must not modify data while the result is in use; mutating
+// the buffer mutates the aliased strings. Intended for read-once scans
+// of documents the caller owns.
+func UnmarshalNoCopy(data []byte) (any, error) {
+	return unmarshalNoCopy(data, "")
+}
+
+// UnmarshalFileNoCopy is UnmarshalNoCopy with a filename for error
+// messages.
+func UnmarshalFileNoCopy(data []byte, filename string) (any, error) {
+	return unmarshalNoCopy(data, filename)
+}
+
+// A FileResult is one file's outcome from UnmarshalFiles.
+type FileResult struct {
+	Path  string
+	Value any
+	Err   error
+}
+
+// UnmarshalFiles reads and parses the named files with bounded
+// concurrency, returning results in path order. parallelism limits the
+// number of worker goroutines; values below one use GOMAXPROCS. Each
+// worker pipelines its own reads and parses, and the parser's pooled
+// scratch buffers are reused within a worker, so directory-scale
+// workloads need no hand-rolled pool around UnmarshalFile.
+//
+// Failures are reported per file in FileResult.Err; one bad file does
+// not stop the batch.
+func UnmarshalFiles(paths []string, parallelism int) []FileResult {
+	results := make([]FileResult, len(paths))
+	if parallelism < 1 {
+		parallelism = runtime.GOMAXPROCS(0)
+	}
+	if parallelism > len(paths) {
+		parallelism = len(paths)
+	}
+
+	var next atomic.Int64
+	var wg sync.WaitGroup
+	for w := 0; w < parallelism; w++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			for {
+				i := int(next.Add(1)) - 1
+				if i >= len(paths) {
+					return
+				}
+				path := paths[i]
+				results[i].Path = path
+				data, err := os.ReadFile(path)
+				if err != nil {
+					results[i].Err = err
+					continue
+				}
+				results[i].Value, results[i].Err = unmarshal(data, path)
+			}
+		}()
+	}
+	wg.Wait()
+	return results
+}
+
+// A Decoder reads and decodes YAY documents from an input stream.
+//
+// The stream holds one or more documents separated by blank lines, the
+// shape produced by concatenating canonically encoded documents with a
+// blank line between them. Within a document, blank lines may appear
+// only inside block strings; a blank line at the top level ends the
+// document. The decoder reads line by line, so memory is bounded by
+// the largest single document rather than the stream.
+type Decoder struct {
+	r        *bufio.Reader
+	filename string
+	pending  string // next non-blank line, already read by More
+	readErr  error  // sticky read error (including io.EOF)
+}
+
+// NewDecoder returns a new decoder that reads from r.
+func NewDecoder(r io.Reader) *Decoder {
+	return &Decoder{r: bufio.NewReader(r)}
+}
+
+// NewDecoderFile returns a new decoder with a filename for error
+// messages.
+func NewDecoderFile(r io.Reader, filename string) *Decoder {
+	return &Decoder{r: bufio.NewReader(r), filename: filename}
+}
+
+// More reports whether there is another document in the stream. It
+// skips separator blank lines, reading ahead at most one content line.
+func (d *Decoder) More() bool {
+	for d.pending == "" && d.readErr == nil {
+		line, err := d.r.ReadString('\n')
+		if err != nil && (err != io.EOF || line == "") {
+			d.readErr = err
+			break
+		}
+		if strings.TrimRight(line, " \n") != "" {
+			d.pending = line
+		}
+		if err == io.EOF {
+			d.readErr = err
+			break
+		}
+	}
+	return d.pending != ""
+}
+
+// Decode reads the next document from the stream and returns its
+// value. It returns io.EOF when the stream holds no further documents.
+func (d *Decoder) Decode() (any, error) {
+	if !d.More() {
+		if d.readErr != nil && d.readErr != io.EOF {
+			return nil, d.readErr
+		}
+		return nil, io.EOF
+	}
+
+	var doc strings.Builder
+	doc.WriteString(d.pending)
+	// A backtick on a line may open a block string whose body owns any
+	// blank lines that follow, so track the opener's indent and only
+	// treat a blank line as the document boundary while no block string
+	// can be open. Blank lines seen while a block string may be open
+	// are held back: a following line at indent zero closes the string,
+	// making them the boundary after all; a deeper line keeps them as
+	// string content. The backtick test over-approximates, which can
+	// only extend a document, never truncate one.
+	openStringIndent := blockStringIndent(d.pending, -1)
+	d.pending = ""
+
+	var heldBlanks strings.Builder
+	for d.readErr == nil {
+		line, err := d.r.ReadString('\n')
+		if err != nil && (err != io.EOF || line == "") {
+			d.readErr = err
+			break
+		}
+		if err == io.EOF {
+			d.readErr = err
+		}
+		if strings.TrimRight(line, " \n") == "" {
+			if openStringIndent < 0 {
+				break // blank line at top level: document boundary
+			}
+			heldBlanks.WriteString(line)
+			continue
+		}
+		if heldBlanks.Len() > 0 {
+			if countIndent(strings.TrimRight(line, "\n")) == 0 {
+				// The blank run was the boundary; this line starts
+				// the next document.
+				d.pending = line
+				break
+			}
+			doc.WriteString(heldBlanks.String())
+		}
+		heldBlanks.Reset()
+		openStringIndent = blockStringIndent(line, openStringIndent)
+		doc.WriteString(line)
+	}
+
+	if d.readErr != nil && d.readErr != io.EOF {
+		return nil, d.readErr
+	}
+	return unmarshal([]byte(doc.String()), d.filename)
+}
+
+// blockStringIndent advances the decoder's open-block-string state for
+// one non-blank line: -1 means no block string can be open, otherwise
+// the opener's indent. A line at or under an open string's indent
+// closes it; a backtick opens the state at the line's indent.
+func blockStringIndent(line string, open int) int {
+	indent := countIndent(strings.TrimRight(line, "\n"))
+	if open >= 0 && indent > open {
+		return open // still inside the block string body
+	}
+	if strings.Contains(line, "`") {
+		return indent
+	}
+	return -1
+}
+
+// ============================================================================
+// Typed Decoding
+// ============================================================================
+//
+// UnmarshalInto decodes into caller-provided Go values, encoding/json
+// style. The parse phases are shared with Unmarshal; typed assignment
+// happens in a single pass over the parsed document using per-type
+// field tables that are computed once and cached.
+
+// UnmarshalInto parses YAY-encoded data and stores the result in the
+// value pointed to by v, writing values directly into struct fields
+// instead of returning a generic map[string]any tree.
+//
+// Object keys match struct fields by `yay:"name"` tag, or by field name
+// with an exact match preferred over a case-insensitive one. A tag of
+// "-" skips the field. Unknown keys are ignored.
+func UnmarshalInto(data []byte, v any) error {
+	return unmarshalInto(data, "", v)
+}
+
+// UnmarshalFileInto is UnmarshalInto with a filename for error messages.
+func UnmarshalFileInto(data []byte, filename string, v any) error {
+	return unmarshalInto(data, filename, v)
+}
+
+func unmarshalInto(data []byte, filename string, v any) error {
+	rv := reflect.ValueOf(v)
+	if rv.Kind() != reflect.Pointer || rv.IsNil() {
+		return fmt.Errorf("UnmarshalInto target must be a non-nil pointer, got %T", v)
+	}
+	value, err := unmarshal(data, filename)
+	if err != nil {
+		return err
+	}
+	return assignValue(value, rv.Elem())
+}
+
+// structField describes one decodable field of a struct type.
+type structField struct {
+	name  string
+	index int
+}
+
+// structFields is the cached field table for one struct type.
+type structFields struct {
+	byName map[string]*structField // exact key match
+	byFold map[string]*structField // case-insensitive fallback
+}
+
+// fieldCache maps reflect.Type to *structFields.
+var fieldCache sync.Map
+
+func cachedFields(t reflect.Type) *structFields {
+	if f, ok := fieldCache.Load(t); ok {
+		return f.(*structFields)
+	}
+	f, _ := fieldCache.LoadOrStore(t, typeFields(t))
+	return f.(*structFields)
+}
+
+// typeFields computes the field table for a struct type.
+func typeFields(t reflect.Type) *structFields {
+	fields := &structFields{
+		byName: make(map[string]*structField),
+		byFold: make(map[string]*structField),
+	}
+	for i := 0; i < t.NumField(); i++ {
+		sf := t.Field(i)
+		if !sf.IsExported() {
+			continue
+		}
+		name := sf.Name
+		if tag, ok := sf.Tag.Lookup("yay"); ok {
+			if tag == "-" {
+				continue
+			}
+			if comma := strings.IndexByte(tag, ','); comma >= 0 {
+				tag = tag[:comma]
+			}
+			if tag != "" {
+				name = tag
+			}
+		}
+		field := &structField{name: name, index: i}
+		fields.byName[name] = field
+		fold := strings.ToLower(name)
+		if _, taken := fields.byFold[fold]; !taken {
+			fields.byFold[fold] = field
+		}
+	}
+	return fields
+}
+
+var bigIntType = reflect.TypeOf(big.Int{})
+
+// assignValue stores a parsed value into dst, which must be settable.
+func assignValue(src any, dst reflect.Value) error {
+	if src == nil {
+		dst.SetZero()
+		return nil
+	}
+
+	// Walk through pointers, allocating as needed.
+	for dst.Kind() == reflect.Pointer {
+		if dst.IsNil() {
+			dst.Set(reflect.New(dst.Type().Elem()))
+		}
+		dst = dst.Elem()
+	}
+
+	if dst.Kind() == reflect.Interface && dst.NumMethod() == 0 {
+		dst.Set(reflect.ValueOf(src))
+		return nil
+	}
+
+	switch s := src.(type) {
+	case bool:
+		if dst.Kind() != reflect.Bool {
+			return assignError(src, dst)
+		}
+		dst.SetBool(s)
+	case string:
+		if dst.Kind() != reflect.String {
+			return assignError(src, dst)
+		}
+		dst.SetString(s)
+	case float64:
+		if dst.Kind() != reflect.Float32 && dst.Kind() != reflect.Float64 {
+			return assignError(src, dst)
+		}
+		dst.SetFloat(s)
+	case int64:
+		return assignInt64(s, dst)
+	case *big.Int:
+		return assignInteger(s, dst)
+	case []byte:
+		if dst.Kind() != reflect.Slice || dst.Type().Elem().Kind() != reflect.Uint8 {
+			return assignError(src, dst)
+		}
+		dst.SetBytes(append([]byte(nil), s...))
+	case []any:
+		return assignArray(s, dst)
+	case map[string]any:
+		return assignObject(s, dst)
+	default:
+		return assignError(src, dst)
+	}
+	return nil
+}
+
+// assignInt64 stores an in-range integer into any numeric field, or a
+// big.Int field.
+func assignInt64(n int64, dst reflect.Value) error {
+	switch dst.Kind() {
+	case reflect.Int, reflect.Int8, reflect.Int16, reflect.Int32, reflect.Int64:
+		if dst.OverflowInt(n) {
+			return fmt.Errorf("integer %d overflows %s", n, dst.Type())
+		}
+		dst.SetInt(n)
+	case reflect.Uint, reflect.Uint8, reflect.Uint16, reflect.Uint32, reflect.Uint64:
+		if n < 0 || dst.OverflowUint(uint64(n)) {
+			return fmt.Errorf("integer %d overflows %s", n, dst.Type())
+		}
+		dst.SetUint(uint64(n))
+	case reflect.Float32, reflect.Float64:
+		dst.SetFloat(float64(n))
+	default:
+		if dst.Type() == bigIntType {
+			dst.Set(reflect.ValueOf(big.NewInt(n)).Elem())
+			return nil
+		}
+		return assignError(n, dst)
+	}
+	return nil
+}
+
+// assignInteger stores an integer into any numeric field, or a big.Int
+// field for values beyond the fixed-width range.
+func assignInteger(n *big.Int, dst reflect.Value) error {
+	switch dst.Kind() {
+	case reflect.Int, reflect.Int8, reflect.Int16, reflect.Int32, reflect.Int64:
+		if !n.IsInt64() || dst.OverflowInt(n.Int64()) {
+			return fmt.Errorf("integer %s overflows %s", n, dst.Type())
+		}
+		dst.SetInt(n.Int64())
+	case reflect.Uint, reflect.Uint8, reflect.Uint16, reflect.Uint32, reflect.Uint64:
+		if !n.IsUint64() || dst.OverflowUint(n.Uint64()) {
+			return fmt.Errorf("integer %s overflows %s", n, dst.Type())
+		}
+		dst.SetUint(n.Uint64())
+	case reflect.Float32, reflect.Float64:
+		f, _ := new(big.Float).SetInt(n).Float64()
+		dst.SetFloat(f)
+	default:
+		if dst.Type() == bigIntType {
+			dst.Set(reflect.ValueOf(n).Elem())
+			return nil
+		}
+		return assignError(n, dst)
+	}
+	return nil
+}
+
+// assignArray stores array elements into a slice or array field.
+func assignArray(src []any, dst reflect.Value) error {
+	switch dst.Kind() {
+	case reflect.Slice:
+		out := reflect.MakeSlice(dst.Type(), len(src), len(src))
+		for i, elem := range src {
+			if err := assignValue(elem, out.Index(i)); err != nil {
+				return err
+			}
+		}
+		dst.Set(out)
+	case reflect.Array:
+		n := len(src)
+		if n > dst.Len() {
+			n = dst.Len()
+		}
+		for i := 0; i < n; i++ {
+			if err := assignValue(src[i], dst.Index(i)); err != nil {
+				return err
+			}
+		}
+		for i := n; i < dst.Len(); i++ {
+			dst.Index(i).SetZero()
+		}
+	default:
+		return assignError(src, dst)
+	}
+	return nil
+}
+
+// assignObject stores object properties into a struct or map field.
+func assignObject(src map[string]any, dst reflect.Value) error {
+	switch dst.Kind() {
+	case reflect.Struct:
+		fields := cachedFields(dst.Type())
+		for key, val := range src {
+			field := fields.byName[key]
+			if field == nil {
+				field = fields.byFold[strings.ToLower(key)]
+			}
+			if field == nil {
+				continue
+			}
+			if err := assignValue(val, dst.Field(field.index)); err != nil {
+				return fmt.Errorf("field %q: %w", key, err)
+			}
+		}
+	case reflect.Map:
+		t := dst.Type()
+		if t.Key().Kind() != reflect.String {
+			return assignError(src, dst)
+		}
+		if dst.IsNil() {
+			dst.Set(reflect.MakeMapWithSize(t, len(src)))
+		}
+		for key, val := range src {
+			elem := reflect.New(t.Elem()).Elem()
+			if err := assignValue(val, elem); err != nil {
+				return fmt.Errorf("key %q: %w", key, err)
+			}
+			dst.SetMapIndex(reflect.ValueOf(key).Convert(t.Key()), elem)
+		}
+	default:
+		return assignError(src, dst)
+	}
+	return nil
+}
+
+// assignError reports a value that cannot decode into the target type,
+// naming the YAY type per the Unmarshal mapping.
+func assignError(src any, dst reflect.Value) error {
+	name := "value"
+	switch src.(type) {
+	case bool:
+		name = "boolean"
+	case int64, *big.Int:
+		name = "integer"
+	case float64:
+		name = "float"
+	case string:
+		name = "string"
+	case []byte:
+		name = "bytes"
+	case []any:
+		name = "array"
+	case map[string]any:
+		name = "object"
+	}
+	return fmt.Errorf("cannot decode %s into %s", name, dst.Type())
+}
+
+// ============================================================================
+// Encoding
+// ============================================================================
+//
+// The encoder produces the same canonical YAY as the other
+// implementations: small all-scalar containers inline, everything else
+// in block form with two-space indents. Map keys are emitted in sorted
+// order so output is deterministic.
+
 // Marshal returns the YAY encoding of v.
+//
+// The mapping from Go values mirrors Unmarshal: nil, bool, string,
+// float32/float64, the fixed-width integer types, *big.Int, []byte,
+// []any, and map[string]any. Other types report an error.
 func Marshal(v any) ([]byte, error) {
-	// TODO: implement encoder
-	return nil, fmt.Errorf("not implemented")
+	return MarshalAppend(nil, v)
+}
+
+// MarshalAppend appends the YAY encoding of v to dst and returns the
+// extended buffer, so callers can reuse one buffer across calls.
+func MarshalAppend(dst []byte, v any) ([]byte, error) {
+	return encodeYay(dst, v, 0)
+}
+
+// An Encoder writes YAY documents to an output stream, reusing its
+// internal buffer across Encode calls so steady-state serialization
+// does not allocate.
+//
+// Documents are separated by blank lines, the stream shape read back
+// by Decoder.
+type Encoder struct {
+	w     io.Writer
+	buf   []byte
+	wrote bool // whether a document has been written
+}
+
+// NewEncoder returns a new encoder that writes to w.
+func NewEncoder(w io.Writer) *Encoder {
+	return &Encoder{w: w}
+}
+
+// Encode writes the YAY encoding of v to the stream, followed by a
+// newline, with a blank line before every document after the first.
+func (enc *Encoder) Encode(v any) error {
+	enc.buf = enc.buf[:0]
+	if enc.wrote {
+		enc.buf = append(enc.buf, '\n')
+	}
+	buf, err := encodeYay(enc.buf, v, 0)
+	if err != nil {
+		return err
+	}
+	enc.buf = append(buf, '\n')
+	enc.wrote = true
+	_, err = enc.w.Write(enc.buf)
+	return err
+}
+
+// encodeYay appends the encoding of v at the given indent depth.
+func encodeYay(dst []byte, v any, indent int) ([]byte, error) {
+	switch val := v.(type) {
+	case nil:
+		return append(dst, "null"...), nil
+	case bool:
+		if val {
+			return append(dst, "true"...), nil
+		}
+		return append(dst, "false"...), nil
+	case string:
+		return appendYayString(dst, val), nil
+	case float64:
+		return appendYayFloat(dst, val), nil
+	case float32:
+		return appendYayFloat(dst, float64(val)), nil
+	case int:
+		return strconv.AppendInt(dst, int64(val), 10), nil
+	case int8:
+		return strconv.AppendInt(dst, int64(val), 10), nil
+	case int16:
+		return strconv.AppendInt(dst, int64(val), 10), nil
+	case int32:
+		return strconv.AppendInt(dst, int64(val), 10), nil
+	case int64:
+		return strconv.AppendInt(dst, val, 10), nil
+	case uint:
+		return strconv.AppendUint(dst, uint64(val), 10), nil
+	case uint8:
+		return strconv.AppendUint(dst, uint64(val), 10), nil
+	case uint16:
+		return strconv.AppendUint(dst, uint64(val), 10), nil
+	case uint32:
+		return strconv.AppendUint(dst, uint64(val), 10), nil
+	case uint64:
+		return strconv.AppendUint(dst, val, 10), nil
+	case *big.Int:
+		// big.Int.Append allocates internally; most integers fit int64.
+		if val.IsInt64() {
+			return strconv.AppendInt(dst, val.Int64(), 10), nil
+		}
+		return val.Append(dst, 10), nil
+	case []byte:
+		return appendYayBytes(dst, val), nil
+	case []any:
+		return appendYayArray(dst, val, indent)
+	case map[string]any:
+		return appendYayObject(dst, val, indent)
+	default:
+		return nil, fmt.Errorf("cannot marshal %T", v)
+	}
+}
+
+// appendYayString appends a double-quoted string with escapes.
+func appendYayString(dst []byte, s string) []byte {
+	dst = append(dst, '"')
+	for _, c := range s {
+		switch c {
+		case '"':
+			dst = append(dst, `\"`...)
+		case '\\':
+			dst = append(dst, `\\`...)
+		case '/':
+			dst = append(dst, `\/`...)
+		case '\n':
+			dst = append(dst, `\n`...)
+		case '\r':
+			dst = append(dst, `\r`...)
+		case '\t':
+			dst = append(dst, `\t`...)
+		case '\b':
+			dst = append(dst, `\b`...)
+		case '\f':
+			dst = append(dst, `\f`...)
+		default:
+			if unicode.IsControl(c) {
+				dst = append(dst, `\u{`...)
+				dst = strconv.AppendUint(dst, uint64(c), 16)
+				dst = append(dst, '}')
+			} else {
+				dst = utf8.AppendRune(dst, c)
+			}
+		}
+	}
+	return append(dst, '"')
+}
+
+// appendYayBytes appends an inline byte array literal.
+func appendYayBytes(dst []byte, b []byte) []byte {
+	dst = append(dst, '<')
+	for _, c := range b {
+		dst = append(dst, hexDigits[c>>4], hexDigits[c&0xF])
+	}
+	return append(dst, '>')
+}
+
+const hexDigits = "0123456789abcdef"
+
+// appendYayFloat appends a float, always with a decimal point, using
+// the keywords for the non-finite values.
+func appendYayFloat(dst []byte, f float64) []byte {
+	switch {
+	case math.IsNaN(f):
+		return append(dst, "nan"...)
+	case math.IsInf(f, 1):
+		return append(dst, "infinity"...)
+	case math.IsInf(f, -1):
+		return append(dst, "-infinity"...)
+	case f == 0 && math.Signbit(f):
+		return append(dst, "-0.0"...)
+	}
+	start := len(dst)
+	dst = strconv.AppendFloat(dst, f, 'f', -1, 64)
+	if !bytes.ContainsAny(dst[start:], ".e") {
+		dst = append(dst, ".0"...)
+	}
+	return dst
+}
+
+// appendYayKey appends an object key, bare when it needs no quoting.
+func appendYayKey(dst []byte, key string) []byte {
+	bare := key != ""
+	for _, c := range key {
+		if !unicode.IsLetter(c) && !unicode.IsDigit(c) && c != '_' && c != '-' {
+			bare = false
+			break
+		}
+	}
+	if bare {
+		return append(dst, key...)
+	}
+	return appendYayString(dst, key)
+}
+
+// appendPad appends the two-space indentation for a depth.
+func appendPad(dst []byte, indent int) []byte {
+	for i := 0; i < indent; i++ {
+		dst = append(dst, "  "...)
+	}
+	return dst
+}
+
+// canInlineArray reports whether an array encodes as [a, b, c].
+func canInlineArray(arr []any) bool {
+	if len(arr) > 5 {
+		return false
+	}
+	for _, v := range arr {
+		if !isSimpleValue(v) {
+			return false
+		}
+	}
+	return true
+}
+
+// canInlineObject reports whether an object encodes as {a: 1, b: 2}.
+func canInlineObject(obj map[string]any) bool {
+	if len(obj) > 3 {
+		return false
+	}
+	for _, v := range obj {
+		if !isSimpleValue(v) {
+			return false
+		}
+	}
+	return true
+}
+
+// isSimpleValue reports whether a value is a non-container scalar.
+func isSimpleValue(v any) bool {
+	switch v.(type) {
+	case []any, map[string]any:
+		return false
+	}
+	return true
+}
+
+// sortedKeys returns an object's keys in sorted order.
+func sortedKeys(obj map[string]any) []string {
+	keys := make([]string, 0, len(obj))
+	for k := range obj {
+		keys = append(keys, k)
+	}
+	sort.Strings(keys)
+	return keys
+}
+
+// appendYayArray appends an array, inline or as a block list.
+func appendYayArray(dst []byte, arr []any, indent int) ([]byte, error) {
+	if len(arr) == 0 {
+		return append(dst, "[]"...), nil
+	}
+	if canInlineArray(arr) {
+		dst = append(dst, '[')
+		for i, v := range arr {
+			if i > 0 {
+				dst = append(dst, ", "...)
+			}
+			var err error
+			dst, err = encodeYay(dst, v, 0)
+			if err != nil {
+				return nil, err
+			}
+		}
+		return append(dst, ']'), nil
+	}
+	return appendYayArrayBlock(dst, arr, indent)
+}
+
+// appendYayArrayBlock appends a block list with items at the given
+// indent; the caller pads the first line.
+func appendYayArrayBlock(dst []byte, arr []any, indent int) ([]byte, error) {
+	for i, v := range arr {
+		if i > 0 {
+			dst = append(dst, '\n')
+			dst = appendPad(dst, indent)
+		}
+		dst = append(dst, "- "...)
+		var err error
+		dst, err = appendYayArrayItem(dst, v, indent)
+		if err != nil {
+			return nil, err
+		}
+	}
+	return dst, nil
+}
+
+// appendYayArrayItem appends a block list item's value after its "- ".
+func appendYayArrayItem(dst []byte, v any, indent int) ([]byte, error) {
+	switch val := v.(type) {
+	case []any:
+		if canInlineArray(val) {
+			break
+		}
+		// Nested block list: first item on the same line, rest indented.
+		for i, item := range val {
+			if i > 0 {
+				dst = append(dst, '\n')
+				dst = appendPad(dst, indent+1)
+			}
+			dst = append(dst, "- "...)
+			var err error
+			dst, err = appendYayArrayItem(dst, item, indent+1)
+			if err != nil {
+				return nil, err
+			}
+		}
+		return dst, nil
+	case map[string]any:
+		if canInlineObject(val) {
+			break
+		}
+		// Nested block object: first property on the same line.
+		for i, k := range sortedKeys(val) {
+			if i > 0 {
+				dst = append(dst, '\n')
+				dst = appendPad(dst, indent+1)
+			}
+			var err error
+			dst, err = appendYayProperty(dst, k, val[k], indent+1)
+			if err != nil {
+				return nil, err
+			}
+		}
+		return dst, nil
+	}
+	return encodeYay(dst, v, indent+1)
+}
+
+// appendYayObject appends an object, inline or as block properties.
+func appendYayObject(dst []byte, obj map[string]any, indent int) ([]byte, error) {
+	if len(obj) == 0 {
+		return append(dst, "{}"...), nil
+	}
+	keys := sortedKeys(obj)
+	if canInlineObject(obj) {
+		dst = append(dst, '{')
+		for i, k := range keys {
+			if i > 0 {
+				dst = append(dst, ", "...)
+			}
+			dst = appendYayKey(dst, k)
+			dst = append(dst, ": "...)
+			var err error
+			dst, err = encodeYay(dst, obj[k], 0)
+			if err != nil {
+				return nil, err
+			}
+		}
+		return append(dst, '}'), nil
+	}
+	for i, k := range keys {
+		if i > 0 {
+			dst = append(dst, '\n')
+			dst = appendPad(dst, indent)
+		}
+		var err error
+		dst, err = appendYayProperty(dst, k, obj[k], indent)
+		if err != nil {
+			return nil, err
+		}
+	}
+	return dst, nil
+}
+
+// appendYayProperty appends one "key: value" property whose key sits at
+// the given indent. Block lists start at the key's own indent; block
+// objects one level deeper.
+func appendYayProperty(dst []byte, key string, v any, indent int) ([]byte, error) {
+	dst = appendYayKey(dst, key)
+	if arr, ok := v.([]any); ok && !canInlineArray(arr) {
+		dst = append(dst, ":\n"...)
+		dst = appendPad(dst, indent)
+		return appendYayArrayBlock(dst, arr, indent)
+	}
+	if obj, ok := v.(map[string]any); ok && !canInlineObject(obj) {
+		dst = append(dst, ":\n"...)
+		dst = appendPad(dst, indent+1)
+		return appendYayObject(dst, obj, indent+1)
+	}
+	dst = append(dst, ": "...)
+	return encodeYay(dst, v, indent+1)
 }
 
 // ============================================================================
@@ -64,6 +937,25 @@ func Marshal(v any) ([]byte, error) {
 // parseContext carries filename for error reporting through the parse phases.
 type parseContext struct {
 	filename string
+	// keys interns object keys for the duration of one parse, so the
+	// handful of distinct keys in a record-stream document share one
+	// backing string each instead of every record retaining its own
+	// substring of the source buffer.
+	keys map[string]string
+}
+
+// intern returns the shared copy of key, cloning it out of the source
+// buffer the first time it is seen.
+func (ctx *parseContext) intern(key string) string {
+	if interned, ok := ctx.keys[key]; ok {
+		return interned
+	}
+	if ctx.keys == nil {
+		ctx.keys = make(map[string]string)
+	}
+	key = strings.Clone(key)
+	ctx.keys[key] = key
+	return key
 }
 
 // scanLine represents a single line after the scanning phase.
@@ -120,24 +1012,63 @@ func locSuffix(ctx *parseContext, line, col int) string {
 //   - Comment filtering
 
 func unmarshal(data []byte, filename string) (any, error) {
-	source := string(data)
+	// The one copy of the payload: parsed strings slice source, so results
+	// must never alias the caller's buffer.
+	return unmarshalSource(string(data), filename)
+}
+
+func unmarshalNoCopy(data []byte, filename string) (any, error) {
+	// View the caller's bytes as a string without copying. Escape-free
+	// strings slice this view, so the result aliases data; that contract
+	// is UnmarshalNoCopy's to document, and the caller's to honor.
+	return unmarshalSource(unsafe.String(unsafe.SliceData(data), len(data)), filename)
+}
+
+func unmarshalSource(source string, filename string) (any, error) {
 	ctx := &parseContext{filename: filename}
 
 	// Phase 1: Scan source into lines
-	lines, err := scan(source, ctx)
+	linesBuf := scanLinePool.Get().(*[]scanLine)
+	defer putScanLines(linesBuf)
+	lines, err := scan(source, ctx, (*linesBuf)[:0])
+	*linesBuf = lines
 	if err != nil {
 		return nil, err
 	}
 
 	// Phase 2: Convert lines to token stream
-	tokens := outlineLex(lines)
+	tokensBuf := tokenPool.Get().(*[]token)
+	defer putTokens(tokensBuf)
+	tokens := outlineLex(lines, (*tokensBuf)[:0])
+	*tokensBuf = tokens
 
 	// Phase 3: Parse tokens into value
 	return parseRoot(tokens, ctx)
 }
 
-// scan converts source text into scan lines with validation.
-func scan(source string, ctx *parseContext) ([]scanLine, error) {
+// Pools for the scanner's and lexer's intermediate slices, which are the
+// parser's main transient allocations and are never retained past
+// unmarshal. The pooled slices hold string headers into old sources, so
+// they are cleared before being returned.
+var (
+	scanLinePool    = sync.Pool{New: func() any { return new([]scanLine) }}
+	tokenPool       = sync.Pool{New: func() any { return new([]token) }}
+	indentStackPool = sync.Pool{New: func() any { return new([]int) }}
+)
+
+func putScanLines(buf *[]scanLine) {
+	clear(*buf)
+	scanLinePool.Put(buf)
+}
+
+func putTokens(buf *[]token) {
+	clear(*buf)
+	tokenPool.Put(buf)
+}
+
+// scan converts source text into scan lines with validation, appending
+// to lines (usually a pooled slice).
+func scan(source string, ctx *parseContext, lines []scanLine) ([]scanLine, error) {
 	// Validate: No BOM allowed
 	if err := validateNoBOM(source, ctx); err != nil {
 		return nil, err
@@ -149,7 +1080,7 @@ func scan(source string, ctx *parseContext) ([]scanLine, error) {
 	}
 
 	// Process each line
-	return scanLines(source, ctx)
+	return scanLines(source, ctx, lines)
 }
 
 // validateNoBOM checks that the source doesn't start with a UTF-8 BOM.
@@ -170,32 +1101,44 @@ func isAllowedCodePoint(cp rune) bool {
 }
 
 // validateCodePoints checks that the source contains no forbidden code points.
+// ASCII bytes are checked directly; only multi-byte sequences are decoded.
+// Columns count runes, so error positions match the rune-based phases.
 func validateCodePoints(source string, ctx *parseContext) error {
 	line := 0
 	col := 0
-	for _, r := range source {
-		if !isAllowedCodePoint(r) {
-			if r == '\t' {
+	for i := 0; i < len(source); {
+		if c := source[i]; c < utf8.RuneSelf {
+			if c == '\n' {
+				line++
+				col = 0
+				i++
+				continue
+			}
+			if 0x20 <= c && c <= 0x7E {
+				col++
+				i++
+				continue
+			}
+			if c == '\t' {
 				return fmt.Errorf("Tab not allowed (use spaces)%s", locSuffix(ctx, line, col))
 			}
+			return fmt.Errorf("Forbidden code point U+%04X%s", rune(c), locSuffix(ctx, line, col))
+		}
+		r, size := utf8.DecodeRuneInString(source[i:])
+		if !isAllowedCodePoint(r) {
 			if r >= 0xD800 && r <= 0xDFFF {
 				return fmt.Errorf("Illegal surrogate%s", locSuffix(ctx, line, col))
 			}
 			return fmt.Errorf("Forbidden code point U+%04X%s", r, locSuffix(ctx, line, col))
 		}
-		if r == '\n' {
-			line++
-			col = 0
-		} else {
-			col++
-		}
+		col++
+		i += size
 	}
 	return nil
 }
 
 // scanLines processes each line of source, extracting indent and leader.
-func scanLines(source string, ctx *parseContext) ([]scanLine, error) {
-	var lines []scanLine
+func scanLines(source string, ctx *parseContext, lines []scanLine) ([]scanLine, error) {
 	lineStrings := strings.Split(source, "\n")
 
 	for lineNum, lineStr := range lineStrings {
@@ -277,12 +1220,13 @@ func extractLeader(rest string, lineNum, indent int, ctx *parseContext) (string,
 //   - tokenText: Line content
 //   - tokenBreak: Blank lines (coalesced)
 
-// outlineLex converts scan lines to a token stream with block markers.
-func outlineLex(lines []scanLine) []token {
-	var tokens []token
-	stack := []int{0} // Indent level stack, starts at 0
-	top := 0          // Current indent level
-	broken := false   // Whether we just emitted a break
+// outlineLex converts scan lines to a token stream with block markers,
+// appending to tokens (usually a pooled slice).
+func outlineLex(lines []scanLine, tokens []token) []token {
+	stackBuf := indentStackPool.Get().(*[]int)
+	stack := append((*stackBuf)[:0], 0) // Indent level stack, starts at 0
+	top := 0                            // Current indent level
+	broken := false                     // Whether we just emitted a break
 
 	for _, sl := range lines {
 		// Emit stops for each level we dedent past
@@ -298,6 +1242,8 @@ func outlineLex(lines []scanLine) []token {
 	// Close any remaining open blocks
 	tokens = emitFinalStops(tokens, stack)
 
+	*stackBuf = stack
+	indentStackPool.Put(stackBuf)
 	return tokens
 }
 
@@ -592,17 +1538,29 @@ var (
 	floatExpRe = regexp.MustCompile(`^-?\d+[eE][+-]?\d+$`)
 )
 
+// parseInteger parses a validated decimal integer (spaces already
+// removed), returning int64 for values in range and *big.Int only on
+// overflow. Most documents never leave the int64 fast path, which
+// avoids a heap allocation per number.
+func parseInteger(digits string) any {
+	if n, err := strconv.ParseInt(digits, 10, 64); err == nil {
+		return n
+	}
+	n := new(big.Int)
+	n.SetString(digits, 10)
+	return n
+}
+
 // parseNumber attempts to parse s as a number.
-// Returns (*big.Int, true) for integers, (float64, true) for floats, (nil, false) otherwise.
+// Returns (int64 or *big.Int, true) for integers, (float64, true) for
+// floats, (nil, false) otherwise.
 func parseNumber(s string) (any, bool) {
 	// Remove spaces (allowed as digit grouping)
 	trimmed := strings.ReplaceAll(s, " ", "")
 
 	// Try integer
 	if integerRe.MatchString(trimmed) {
-		n := new(big.Int)
-		n.SetString(trimmed, 10)
-		return n, true
+		return parseInteger(trimmed), true
 	}
 
 	// Try float with exponent only (no decimal point)
@@ -660,9 +1618,7 @@ func parseNumberStrict(s string, ctx *parseContext, lineNum, col int) (any, bool
 
 	// Try integer
 	if integerRe.MatchString(trimmed) {
-		n := new(big.Int)
-		n.SetString(trimmed, 10)
-		return n, true, nil
+		return parseInteger(trimmed), true, nil
 	}
 
 	// Try float with exponent only (no decimal point)
@@ -729,39 +1685,68 @@ func parseDoubleQuotedString(s string, ctx *parseContext, lineNum, col int) (str
 		return "", fmt.Errorf("Unterminated string%s", locSuffix(ctx, lineNum, col+len(s)-1))
 	}
 
-	var out strings.Builder
-	runes := []rune(s)
-
-	for i := 1; i < len(runes)-1; i++ {
-		ch := runes[i]
+	// Escape-free fast path: the body is returned as an unmodified
+	// substring, no builder needed. Stray control characters still
+	// error at their rune position.
+	body := s[1 : len(s)-1]
+	if strings.IndexByte(body, '\\') < 0 {
+		for j := 0; j < len(body); j++ {
+			if body[j] < 0x20 {
+				ri := 1 + utf8.RuneCountInString(body[:j])
+				return "", fmt.Errorf("Bad character in string%s", locSuffix(ctx, lineNum, col+ri))
+			}
+		}
+		return body, nil
+	}
 
-		if ch == '\\' {
+	var out strings.Builder
+	out.Grow(len(s) - 2)
+
+	// Byte-indexed scan: i is the byte offset of the current position and
+	// ri its rune offset, which error positions are reported in.
+	i, ri := 1, 1
+	for i < len(s)-1 {
+		switch c := s[i]; {
+		case c == '\\':
 			// Handle escape sequence
-			escaped, advance, err := parseEscapeSequence(runes, i, ctx, lineNum, col)
+			escaped, advance, err := parseEscapeSequence(s, i, ri, ctx, lineNum, col)
 			if err != nil {
 				return "", err
 			}
 			out.WriteString(escaped)
-			i += advance
-		} else if ch < 0x20 {
+			i += advance + 1
+			ri += advance + 1
+		case c < 0x20:
 			// Control characters not allowed
-			return "", fmt.Errorf("Bad character in string%s", locSuffix(ctx, lineNum, col+i))
-		} else {
-			out.WriteRune(ch)
+			return "", fmt.Errorf("Bad character in string%s", locSuffix(ctx, lineNum, col+ri))
+		case c < utf8.RuneSelf:
+			// Bulk-copy a run of plain ASCII
+			start := i
+			for i < len(s)-1 && 0x20 <= s[i] && s[i] < utf8.RuneSelf && s[i] != '\\' {
+				i++
+				ri++
+			}
+			out.WriteString(s[start:i])
+		default:
+			r, size := utf8.DecodeRuneInString(s[i:])
+			out.WriteRune(r)
+			i += size
+			ri++
 		}
 	}
 
 	return out.String(), nil
 }
 
-// parseEscapeSequence parses a backslash escape sequence.
+// parseEscapeSequence parses a backslash escape sequence starting at byte
+// offset i (rune offset ri) in s.
 // Returns (unescaped string, characters to advance, error).
-func parseEscapeSequence(runes []rune, i int, ctx *parseContext, lineNum, col int) (string, int, error) {
-	if i+1 >= len(runes)-1 {
-		return "", 0, fmt.Errorf("Bad escaped character%s", locSuffix(ctx, lineNum, col+i+1))
+func parseEscapeSequence(s string, i, ri int, ctx *parseContext, lineNum, col int) (string, int, error) {
+	if i+1 >= len(s)-1 {
+		return "", 0, fmt.Errorf("Bad escaped character%s", locSuffix(ctx, lineNum, col+ri+1))
 	}
 
-	esc := runes[i+1]
+	esc := s[i+1]
 	switch esc {
 	case '"':
 		return "\"", 1, nil
@@ -780,21 +1765,22 @@ func parseEscapeSequence(runes []rune, i int, ctx *parseContext, lineNum, col in
 	case 't':
 		return "\t", 1, nil
 	case 'u':
-		return parseUnicodeEscape(runes, i, ctx, lineNum, col)
+		return parseUnicodeEscape(s, i, ri, ctx, lineNum, col)
 	default:
-		return "", 0, fmt.Errorf("Bad escaped character%s", locSuffix(ctx, lineNum, col+i+1))
+		return "", 0, fmt.Errorf("Bad escaped character%s", locSuffix(ctx, lineNum, col+ri+1))
 	}
 }
 
 // parseUnicodeEscape parses a \u{XXXXXX} escape sequence (variable-length with braces).
-func parseUnicodeEscape(runes []rune, i int, ctx *parseContext, lineNum, col int) (string, int, error) {
+// The escape body is all ASCII, so byte offsets from i advance runes one-for-one.
+func parseUnicodeEscape(s string, i, ri int, ctx *parseContext, lineNum, col int) (string, int, error) {
 	// Column of the 'u' character (for "Bad escaped character" error)
-	uCol := col + i + 1
+	uCol := col + ri + 1
 	// Column of the opening brace (for other errors)
-	braceCol := col + i + 2
+	braceCol := col + ri + 2
 
 	// Expect opening brace after \u
-	if i+2 >= len(runes)-1 || runes[i+2] != '{' {
+	if i+2 >= len(s)-1 || s[i+2] != '{' {
 		// Old-style \uXXXX syntax is not supported - report as bad escaped character
 		return "", 0, fmt.Errorf("Bad escaped character%s", locSuffix(ctx, lineNum, uCol))
 	}
@@ -802,17 +1788,17 @@ func parseUnicodeEscape(runes []rune, i int, ctx *parseContext, lineNum, col int
 	// Find closing brace
 	start := i + 3
 	end := start
-	for end < len(runes)-1 && runes[end] != '}' {
+	for end < len(s)-1 && s[end] != '}' {
 		end++
 	}
 
-	if end >= len(runes)-1 || runes[end] != '}' {
+	if end >= len(s)-1 || s[end] != '}' {
 		return "", 0, fmt.Errorf("Bad Unicode escape%s", locSuffix(ctx, lineNum, braceCol))
 	}
 
 	// Validate hex digits
 	for j := start; j < end; j++ {
-		if !isHexDigit(runes[j]) {
+		if !isHexDigit(rune(s[j])) {
 			return "", 0, fmt.Errorf("Bad Unicode escape%s", locSuffix(ctx, lineNum, braceCol))
 		}
 	}
@@ -827,9 +1813,10 @@ func parseUnicodeEscape(runes []rune, i int, ctx *parseContext, lineNum, col int
 	}
 
 	// Parse code point
-	hexStr := string(runes[start:end])
-	var code int64
-	fmt.Sscanf(hexStr, "%x", &code)
+	code, err := strconv.ParseInt(s[start:end], 16, 64)
+	if err != nil {
+		return "", 0, fmt.Errorf("Bad Unicode escape%s", locSuffix(ctx, lineNum, braceCol))
+	}
 
 	// Reject surrogates
 	if code >= 0xD800 && code <= 0xDFFF {
@@ -1266,9 +2253,7 @@ func parseInlineNumberStrict(s string, ctx *parseContext, lineNum, col int) (any
 
 	// Try integer
 	if integerRe.MatchString(numStr) {
-		n := new(big.Int)
-		n.SetString(numStr, 10)
-		return n, end, nil
+		return parseInteger(numStr), end, nil
 	}
 
 	// Try float
@@ -1469,7 +2454,7 @@ func parseInlineObjectStrict(s string, ctx *parseContext, lineNum, col int) (map
 			return nil, err
 		}
 
-		result[key] = value
+		result[ctx.intern(key)] = value
 		remaining = remaining[consumed:]
 		offset += consumed
 		remaining = strings.TrimLeft(remaining, " ")
@@ -2031,7 +3016,7 @@ func parseKeyValuePair(tokens []token, i, colonIdx int, ctx *parseContext) (any,
 	s := t.text
 
 	keyRaw := strings.TrimSpace(s[:colonIdx])
-	key := parseKeyName(keyRaw)
+	key := ctx.intern(parseKeyName(keyRaw))
 	valuePart := strings.TrimSpace(s[colonIdx+1:])
 
 	// Calculate column for value part
@@ -2246,7 +3231,7 @@ func parseNestedObjectContent(tokens []token, i, baseIndent int, ctx *parseConte
 			}
 
 			kRaw := strings.TrimSpace(t.text[:colonIdx])
-			k := parseKeyName(kRaw)
+			k := ctx.intern(parseKeyName(kRaw))
 			vPart := strings.TrimSpace(t.text[colonIdx+1:])
 
 			if k == "" {
@@ -2392,7 +3377,7 @@ func parseRootObject(tokens []token, i int, ctx *parseContext) (any, int, error)
 			return nil, 0, err
 		}
 
-		k := parseKeyName(kRaw)
+		k := ctx.intern(parseKeyName(kRaw))
 
 		// Validate: space after colon (if there's content)
 		afterColon := t.text[colonIdx+1:]
@@ -3,6 +3,9 @@
 package yay
 
 import (
+	"bytes"
+	"fmt"
+	"io"
 	"math"
 	"math/big"
 	"os"
@@ -73,6 +76,19 @@ func TestErrorCases(t *testing.T) {
 	}
 }
 
+// asInt64 extracts an int64 from either integer representation.
+func asInt64(v any) (int64, bool) {
+	switch n := v.(type) {
+	case int64:
+		return n, true
+	case *big.Int:
+		if n.IsInt64() {
+			return n.Int64(), true
+		}
+	}
+	return 0, false
+}
+
 // deepEqual compares two values, handling special cases like NaN and *big.Int
 func deepEqual(a, b any) bool {
 	// Handle NaN
@@ -84,7 +100,14 @@ func deepEqual(a, b any) bool {
 		}
 	}
 
-	// Handle *big.Int
+	// Handle integers across representations: the parser returns int64
+	// for in-range values and *big.Int beyond that, while fixtures may
+	// use either form.
+	if ai, ok := asInt64(a); ok {
+		if bi, ok := asInt64(b); ok {
+			return ai == bi
+		}
+	}
 	if ai, ok := a.(*big.Int); ok {
 		if bi, ok := b.(*big.Int); ok {
 			return ai.Cmp(bi) == 0
@@ -139,3 +162,330 @@ func deepEqual(a, b any) bool {
 
 	return reflect.DeepEqual(a, b)
 }
+
+func TestDecoderStream(t *testing.T) {
+	stream := "a: 1\nb: 2\n\n- 1\n- 2\n\n\n\"third\"\n"
+	dec := NewDecoder(strings.NewReader(stream))
+
+	expected := []any{
+		map[string]any{"a": big.NewInt(1), "b": big.NewInt(2)},
+		[]any{big.NewInt(1), big.NewInt(2)},
+		"third",
+	}
+	for i, want := range expected {
+		if !dec.More() {
+			t.Fatalf("More() = false before document %d", i)
+		}
+		got, err := dec.Decode()
+		if err != nil {
+			t.Fatalf("Decode error on document %d: %v", i, err)
+		}
+		if !deepEqual(got, want) {
+			t.Errorf("document %d mismatch\ngot:  %#v\nwant: %#v", i, got, want)
+		}
+	}
+	if dec.More() {
+		t.Error("More() = true after last document")
+	}
+	if _, err := dec.Decode(); err != io.EOF {
+		t.Errorf("Decode after end = %v, want io.EOF", err)
+	}
+}
+
+func TestDecoderBlockStringBlankLines(t *testing.T) {
+	// The blank line belongs to the block string, not the document
+	// boundary; the following blank line ends the document.
+	stream := "text: `\n  one\n\n  two\n\nnext: 1\n"
+	dec := NewDecoderFile(strings.NewReader(stream), "stream.yay")
+
+	got, err := dec.Decode()
+	if err != nil {
+		t.Fatalf("Decode error: %v", err)
+	}
+	want := map[string]any{"text": "one\n\ntwo\n"}
+	if !deepEqual(got, want) {
+		t.Errorf("mismatch\ngot:  %#v\nwant: %#v", got, want)
+	}
+
+	got, err = dec.Decode()
+	if err != nil {
+		t.Fatalf("Decode error on second document: %v", err)
+	}
+	if !deepEqual(got, map[string]any{"next": big.NewInt(1)}) {
+		t.Errorf("second document mismatch: %#v", got)
+	}
+}
+
+func TestDecoderParseError(t *testing.T) {
+	dec := NewDecoderFile(strings.NewReader(": bad\n"), "stream.yay")
+	if _, err := dec.Decode(); err == nil || !strings.Contains(err.Error(), "stream.yay") {
+		t.Errorf("expected error naming stream.yay, got %v", err)
+	}
+}
+
+func TestStringErrorColumnsCountRunes(t *testing.T) {
+	// "é" is two bytes but one column; the bad escape must still be
+	// reported at its rune position.
+	_, err := UnmarshalFile([]byte("key: \"é\\q\"\n"), "cols.yay")
+	if err == nil || !strings.Contains(err.Error(), "Bad escaped character at 1:9 of <cols.yay>") {
+		t.Errorf("expected bad escape at 1:9, got %v", err)
+	}
+}
+
+func BenchmarkUnmarshal(b *testing.B) {
+	var doc strings.Builder
+	for i := 0; i < 200; i++ {
+		fmt.Fprintf(&doc, "entry%d:\n  name: \"service %d\"\n  port: %d\n  tags:\n  - \"alpha\"\n  - \"beta\"\n", i, i, 8000+i)
+	}
+	data := []byte(doc.String())
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if _, err := Unmarshal(data); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func TestUnmarshalInto(t *testing.T) {
+	type endpoint struct {
+		Host string `yay:"host"`
+		Port int    `yay:"port"`
+	}
+	type config struct {
+		Name     string
+		Replicas uint8 `yay:"replicas"`
+		Ratio    float64
+		Debug    bool
+		Tags     []string
+		Primary  *endpoint `yay:"primary"`
+		Extra    any
+		Secret   []byte   `yay:"secret"`
+		Ignored  string   `yay:"-"`
+		Big      *big.Int `yay:"big"`
+	}
+
+	doc := "name: \"api\"\n" +
+		"replicas: 3\n" +
+		"ratio: 0.5\n" +
+		"debug: true\n" +
+		"tags:\n- \"a\"\n- \"b\"\n" +
+		"primary:\n  host: \"db\"\n  port: 5432\n" +
+		"extra: null\n" +
+		"secret: >\n  6869\n" +
+		"big: 123456789012345678901234567890\n" +
+		"unknown: \"skipped\"\n"
+
+	var got config
+	if err := UnmarshalInto([]byte(doc), &got); err != nil {
+		t.Fatalf("UnmarshalInto error: %v", err)
+	}
+	if got.Name != "api" || got.Replicas != 3 || got.Ratio != 0.5 || !got.Debug {
+		t.Errorf("scalar mismatch: %+v", got)
+	}
+	if !reflect.DeepEqual(got.Tags, []string{"a", "b"}) {
+		t.Errorf("tags mismatch: %#v", got.Tags)
+	}
+	if got.Primary == nil || got.Primary.Host != "db" || got.Primary.Port != 5432 {
+		t.Errorf("nested struct mismatch: %+v", got.Primary)
+	}
+	if string(got.Secret) != "hi" {
+		t.Errorf("bytes mismatch: %q", got.Secret)
+	}
+	if got.Big == nil || got.Big.String() != "123456789012345678901234567890" {
+		t.Errorf("big integer mismatch: %v", got.Big)
+	}
+}
+
+func TestUnmarshalIntoErrors(t *testing.T) {
+	var overflow struct {
+		N int8 `yay:"n"`
+	}
+	err := UnmarshalInto([]byte("n: 300\n"), &overflow)
+	if err == nil || !strings.Contains(err.Error(), "overflows int8") {
+		t.Errorf("expected overflow error, got %v", err)
+	}
+
+	var mismatch struct {
+		N int `yay:"n"`
+	}
+	err = UnmarshalInto([]byte("n: \"oops\"\n"), &mismatch)
+	if err == nil || !strings.Contains(err.Error(), "cannot decode string into int") {
+		t.Errorf("expected type mismatch error, got %v", err)
+	}
+
+	var notPointer struct{}
+	if err := UnmarshalInto([]byte("a: 1\n"), notPointer); err == nil {
+		t.Error("expected error for non-pointer target")
+	}
+}
+
+func TestMarshalRoundTrip(t *testing.T) {
+	v := map[string]any{
+		"name":  "api",
+		"count": big.NewInt(3),
+		"ratio": 0.5,
+		"flags": []any{true, false, nil},
+		"blob":  []byte{0xb0, 0xb5},
+		"nested": map[string]any{
+			"items": []any{big.NewInt(1), big.NewInt(2), big.NewInt(3), big.NewInt(4), big.NewInt(5), big.NewInt(6)},
+			"text":  "line one\nline two",
+		},
+	}
+	data, err := Marshal(v)
+	if err != nil {
+		t.Fatalf("Marshal error: %v", err)
+	}
+	got, err := Unmarshal(data)
+	if err != nil {
+		t.Fatalf("Unmarshal error on %q: %v", data, err)
+	}
+	if !deepEqual(got, v) {
+		t.Errorf("round trip mismatch\ngot:  %#v\nwant: %#v", got, v)
+	}
+}
+
+func TestMarshalCanonicalForm(t *testing.T) {
+	v := map[string]any{
+		"b": map[string]any{"c": []any{map[string]any{"x": big.NewInt(1)}, big.NewInt(7)}},
+		"a": []any{"x", "y"},
+	}
+	want := "a: [\"x\", \"y\"]\n" +
+		"b:\n" +
+		"  c:\n" +
+		"  - {x: 1}\n" +
+		"  - 7"
+	data, err := Marshal(v)
+	if err != nil {
+		t.Fatalf("Marshal error: %v", err)
+	}
+	if string(data) != want {
+		t.Errorf("canonical form mismatch\ngot:\n%s\nwant:\n%s", data, want)
+	}
+}
+
+func TestMarshalAppendReusesBuffer(t *testing.T) {
+	buf := make([]byte, 0, 256)
+	out, err := MarshalAppend(buf, []any{big.NewInt(1), big.NewInt(2)})
+	if err != nil {
+		t.Fatalf("MarshalAppend error: %v", err)
+	}
+	if &out[0] != &buf[:1][0] {
+		t.Error("MarshalAppend did not reuse the destination buffer")
+	}
+	if string(out) != "[1, 2]" {
+		t.Errorf("unexpected encoding: %q", out)
+	}
+}
+
+func TestEncoderStreamDecodes(t *testing.T) {
+	var stream strings.Builder
+	enc := NewEncoder(&stream)
+	docs := []any{
+		map[string]any{"a": big.NewInt(1)},
+		[]any{big.NewInt(1), big.NewInt(2)},
+		"third",
+	}
+	for _, doc := range docs {
+		if err := enc.Encode(doc); err != nil {
+			t.Fatalf("Encode error: %v", err)
+		}
+	}
+
+	dec := NewDecoder(strings.NewReader(stream.String()))
+	for i, want := range docs {
+		got, err := dec.Decode()
+		if err != nil {
+			t.Fatalf("Decode error on document %d: %v", i, err)
+		}
+		if !deepEqual(got, want) {
+			t.Errorf("document %d mismatch\ngot:  %#v\nwant: %#v", i, got, want)
+		}
+	}
+	if dec.More() {
+		t.Error("unexpected extra document")
+	}
+}
+
+func TestEncoderSteadyStateAllocs(t *testing.T) {
+	enc := NewEncoder(io.Discard)
+	// Pre-boxed so the measurement sees the encoder, not the
+	// interface conversion at the call site.
+	var record any = []any{big.NewInt(42), "name", 0.5, true}
+	if err := enc.Encode(record); err != nil {
+		t.Fatalf("Encode error: %v", err)
+	}
+	allocs := testing.AllocsPerRun(100, func() {
+		if err := enc.Encode(record); err != nil {
+			t.Fatalf("Encode error: %v", err)
+		}
+	})
+	if allocs > 0 {
+		t.Errorf("Encode allocated %v times per call in steady state", allocs)
+	}
+}
+
+func TestUnmarshalFiles(t *testing.T) {
+	dir := t.TempDir()
+	var paths []string
+	for i := 0; i < 20; i++ {
+		path := filepath.Join(dir, fmt.Sprintf("doc%02d.yay", i))
+		if err := os.WriteFile(path, []byte(fmt.Sprintf("n: %d\n", i)), 0o644); err != nil {
+			t.Fatal(err)
+		}
+		paths = append(paths, path)
+	}
+	bad := filepath.Join(dir, "bad.yay")
+	if err := os.WriteFile(bad, []byte(": nope\n"), 0o644); err != nil {
+		t.Fatal(err)
+	}
+	paths = append(paths, bad, filepath.Join(dir, "missing.yay"))
+
+	results := UnmarshalFiles(paths, 4)
+	if len(results) != len(paths) {
+		t.Fatalf("got %d results for %d paths", len(results), len(paths))
+	}
+	for i := 0; i < 20; i++ {
+		if results[i].Path != paths[i] {
+			t.Errorf("result %d out of order: %s", i, results[i].Path)
+		}
+		if results[i].Err != nil {
+			t.Errorf("result %d error: %v", i, results[i].Err)
+			continue
+		}
+		want := map[string]any{"n": big.NewInt(int64(i))}
+		if !deepEqual(results[i].Value, want) {
+			t.Errorf("result %d mismatch: %#v", i, results[i].Value)
+		}
+	}
+	if results[20].Err == nil || !strings.Contains(results[20].Err.Error(), "bad.yay") {
+		t.Errorf("expected parse error naming bad.yay, got %v", results[20].Err)
+	}
+	if results[21].Err == nil {
+		t.Error("expected read error for missing file")
+	}
+}
+
+func TestUnmarshalNoCopy(t *testing.T) {
+	data := []byte("name: \"alpha\"\nesc: \"a\\nb\"\n")
+	value, err := UnmarshalNoCopy(data)
+	if err != nil {
+		t.Fatal(err)
+	}
+	m, ok := value.(map[string]any)
+	if !ok {
+		t.Fatalf("expected object, got %#v", value)
+	}
+	if m["name"] != "alpha" || m["esc"] != "a\nb" {
+		t.Fatalf("value mismatch: %#v", m)
+	}
+	// Escape-free strings alias the buffer: mutating it in place shows
+	// through, which is the documented contract of the no-copy mode.
+	copy(data[bytes.Index(data, []byte("alpha")):], "omega")
+	if m["name"] != "omega" {
+		t.Errorf("expected escape-free string to alias the buffer, got %q", m["name"])
+	}
+	if m["esc"] != "a\nb" {
+		t.Errorf("expected escaped string to be materialized, got %q", m["esc"])
+	}
+}
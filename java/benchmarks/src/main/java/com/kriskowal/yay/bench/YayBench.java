@@ -0,0 +1,141 @@
+package com.kriskowal.yay.bench;
+
+import com.kriskowal.yay.Yay;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.TimeUnit;
+import java.util.stream.Stream;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+import org.openjdk.jmh.infra.Blackhole;
+
+/**
+ * JMH benchmarks for {@link Yay#parse}, comparable with the Go and Rust ports: the corpus
+ * benchmark parses every document under the shared test/yay directory; the synthetic benchmarks
+ * isolate wide, deep, and number-dense shapes at the same sizes as go/bench_test.go.
+ *
+ * <p>Build and run (install the parser jar first with {@code mvn install} in java/):
+ *
+ * <pre>
+ *   mvn package
+ *   java -jar target/benchmarks.jar -prof gc
+ * </pre>
+ *
+ * <p>The gc profiler reports allocation rates alongside timings, which is the number to watch for
+ * substring-copy regressions in the tokenizer.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@State(Scope.Benchmark)
+@Fork(1)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+public class YayBench {
+
+  private List<String> corpus;
+  private String wide;
+  private String deep;
+  private String numbers;
+
+  @Setup
+  public void setup() throws IOException {
+    corpus = loadCorpus();
+    wide = wideDocument();
+    deep = deepDocument();
+    numbers = numberDocument();
+  }
+
+  /** Locate the shared corpus relative to the benchmarks module or the repository root. */
+  private static List<String> loadCorpus() throws IOException {
+    Path dir = null;
+    for (String candidate : new String[] {"../../test/yay", "../test/yay", "test/yay"}) {
+      Path path = Paths.get(candidate);
+      if (Files.isDirectory(path)) {
+        dir = path;
+        break;
+      }
+    }
+    if (dir == null) {
+      throw new IOException("test/yay corpus not found; run from java/benchmarks/");
+    }
+    List<String> docs = new ArrayList<>();
+    try (Stream<Path> paths = Files.list(dir)) {
+      for (Path path : paths.filter(p -> p.toString().endsWith(".yay")).sorted().toList()) {
+        docs.add(Files.readString(path));
+      }
+    }
+    if (docs.isEmpty()) {
+      throw new IOException("no .yay documents in " + dir);
+    }
+    return docs;
+  }
+
+  /** One object with many scalar properties. */
+  private static String wideDocument() {
+    StringBuilder doc = new StringBuilder();
+    for (int i = 0; i < 1000; i++) {
+      doc.append(String.format("key%04d: \"value %d\"\n", i, i));
+    }
+    return doc.toString();
+  }
+
+  /** One object nested per indent level. */
+  private static String deepDocument() {
+    StringBuilder doc = new StringBuilder();
+    final int depth = 64;
+    for (int i = 0; i < depth; i++) {
+      doc.append("  ".repeat(i));
+      doc.append("a:\n");
+    }
+    doc.append("  ".repeat(depth));
+    doc.append("b: 1\n");
+    return doc.toString();
+  }
+
+  /** A long list of mixed integers and floats. */
+  private static String numberDocument() {
+    StringBuilder doc = new StringBuilder();
+    for (int i = 0; i < 2000; i++) {
+      if (i % 2 == 0) {
+        doc.append("- ").append(i * 7919).append('\n');
+      } else {
+        doc.append("- ").append(i).append('.').append(i % 100).append('\n');
+      }
+    }
+    return doc.toString();
+  }
+
+  @Benchmark
+  public void corpus(Blackhole bh) {
+    for (String doc : corpus) {
+      bh.consume(Yay.parse(doc));
+    }
+  }
+
+  @Benchmark
+  public Object wide() {
+    return Yay.parse(wide);
+  }
+
+  @Benchmark
+  public Object deep() {
+    return Yay.parse(deep);
+  }
+
+  @Benchmark
+  public Object numbers() {
+    return Yay.parse(numbers);
+  }
+}
@@ -1,7 +1,23 @@
 package com.kriskowal.yay;
 
+import java.io.IOException;
+import java.io.Reader;
+import java.io.Writer;
 import java.math.BigInteger;
+import java.nio.CharBuffer;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.charset.CharsetDecoder;
+import java.nio.charset.CoderResult;
+import java.nio.charset.CodingErrorAction;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
 import java.util.*;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
 import java.util.regex.Pattern;
 
 /**
@@ -27,20 +43,488 @@ public class Yay {
     return parser.parse();
   }
 
+  /** Parse YAY-encoded data from a reader, draining it fully. */
+  public static Object parse(Reader reader) throws IOException {
+    return parse(reader, null);
+  }
+
+  /** Parse YAY-encoded data from a reader with filename for error messages. */
+  public static Object parse(Reader reader, String filename) throws IOException {
+    StringBuilder source = new StringBuilder();
+    char[] buffer = new char[8192];
+    int n;
+    while ((n = reader.read(buffer)) >= 0) {
+      source.append(buffer, 0, n);
+    }
+    Parser parser = new Parser(source, filename);
+    return parser.parse();
+  }
+
+  /**
+   * Parse a YAY file by memory-mapping it. The mapping is decoded as UTF-8 through a reusable
+   * CharBuffer window into a single source buffer pre-sized from the byte count (UTF-8 never
+   * decodes to more chars than bytes), so the file's bytes are never copied onto the heap and
+   * decoding overlaps the pages faulting in. Malformed UTF-8 is reported as an IOException, like
+   * {@link java.nio.file.Files#readString}.
+   */
+  public static Object parse(Path path) throws IOException {
+    try (FileChannel channel = FileChannel.open(path, StandardOpenOption.READ)) {
+      long size = channel.size();
+      if (size > Integer.MAX_VALUE) {
+        throw new IOException("File too large to map: " + path);
+      }
+      MappedByteBuffer mapped = channel.map(FileChannel.MapMode.READ_ONLY, 0, size);
+      CharsetDecoder decoder =
+          StandardCharsets.UTF_8
+              .newDecoder()
+              .onMalformedInput(CodingErrorAction.REPORT)
+              .onUnmappableCharacter(CodingErrorAction.REPORT);
+      StringBuilder source = new StringBuilder((int) size);
+      CharBuffer window = CharBuffer.allocate(1 << 16);
+      while (true) {
+        CoderResult result = decoder.decode(mapped, window, true);
+        source.append(window.array(), 0, window.position());
+        window.clear();
+        if (result.isError()) {
+          result.throwException();
+        }
+        if (result.isUnderflow()) {
+          break;
+        }
+      }
+      while (true) {
+        CoderResult result = decoder.flush(window);
+        source.append(window.array(), 0, window.position());
+        window.clear();
+        if (result.isError()) {
+          result.throwException();
+        }
+        if (result.isUnderflow()) {
+          break;
+        }
+      }
+      Parser parser = new Parser(source, path.toString());
+      return parser.parse();
+    }
+  }
+
+  /** Parse a batch of YAY files concurrently, using one thread per available processor. */
+  public static List<Object> parseAll(List<Path> paths) throws IOException {
+    return parseAll(paths, Runtime.getRuntime().availableProcessors());
+  }
+
+  /**
+   * Parse a batch of YAY files concurrently on up to {@code parallelism} threads. Each file is
+   * mapped and parsed on its own task, so the per-parse scratch state (source buffer, scan lines,
+   * tokens) stays thread-local. Results are returned in the order of {@code paths}. The first
+   * failure is rethrown with its file's name in the message, as from {@link #parse}.
+   */
+  public static List<Object> parseAll(List<Path> paths, int parallelism) throws IOException {
+    if (parallelism < 1) {
+      throw new IllegalArgumentException("parallelism must be at least 1");
+    }
+    ExecutorService pool =
+        Executors.newFixedThreadPool(Math.min(parallelism, Math.max(1, paths.size())));
+    try {
+      List<Future<Object>> futures = new ArrayList<>(paths.size());
+      for (Path path : paths) {
+        futures.add(pool.submit(() -> parse(path)));
+      }
+      List<Object> results = new ArrayList<>(paths.size());
+      for (Future<Object> future : futures) {
+        try {
+          results.add(future.get());
+        } catch (InterruptedException e) {
+          Thread.currentThread().interrupt();
+          throw new IOException("Interrupted while parsing batch", e);
+        } catch (ExecutionException e) {
+          Throwable cause = e.getCause();
+          if (cause instanceof IOException) {
+            throw (IOException) cause;
+          }
+          if (cause instanceof RuntimeException) {
+            throw (RuntimeException) cause;
+          }
+          throw new RuntimeException(cause);
+        }
+      }
+      return results;
+    } finally {
+      pool.shutdownNow();
+    }
+  }
+
+  // ========================================================================
+  // Encoder
+  // ========================================================================
+
+  /** Encode a value as canonical YAY text, presizing the output from an estimate. */
+  public static String encode(Object value) {
+    Encoder encoder = new Encoder(null, estimateSize(value));
+    encoder.encodeValue(value, 0);
+    return encoder.out.toString();
+  }
+
+  /** Encode a value as canonical YAY text through a writer, followed by a newline. */
+  public static void encode(Object value, Writer writer) throws IOException {
+    new Encoder(writer, 0).encodeDocument(value);
+  }
+
+  /**
+   * A streaming canonical YAY encoder. Output accumulates in one reusable char buffer that is
+   * drained to the writer whenever it fills, so a large export never materializes in memory; the
+   * buffer survives across {@link #encodeDocument} calls, which separate documents with blank
+   * lines. Encoding rules match the other ports: keys in sorted order, two-space indents, and
+   * small all-scalar containers inline.
+   */
+  public static class Encoder {
+    private static final int FLUSH_THRESHOLD = 1 << 16;
+    private static final String HEX_DIGITS = "0123456789abcdef";
+
+    private final Writer writer;
+    private final StringBuilder out;
+    private boolean wrote;
+
+    public Encoder(Writer writer) {
+      this(writer, 0);
+    }
+
+    private Encoder(Writer writer, int sizeHint) {
+      this.writer = writer;
+      this.out = new StringBuilder(Math.max(sizeHint, 16));
+    }
+
+    /** Encode one document followed by a newline, with a blank line before every document after
+     * the first, and flush the buffer through the writer. */
+    public void encodeDocument(Object value) throws IOException {
+      if (wrote) {
+        out.append('\n');
+      }
+      encodeValue(value, 0);
+      out.append('\n');
+      wrote = true;
+      writer.write(out.toString());
+      out.setLength(0);
+    }
+
+    private void maybeFlush() {
+      if (writer != null && out.length() >= FLUSH_THRESHOLD) {
+        try {
+          writer.write(out.toString());
+        } catch (IOException e) {
+          throw new java.io.UncheckedIOException(e);
+        }
+        out.setLength(0);
+      }
+    }
+
+    private void encodeValue(Object value, int indent) {
+      if (value == null) {
+        out.append("null");
+      } else if (value instanceof Boolean) {
+        out.append(((Boolean) value) ? "true" : "false");
+      } else if (value instanceof String) {
+        encodeString((String) value);
+      } else if (value instanceof Double || value instanceof Float) {
+        encodeFloat(((Number) value).doubleValue());
+      } else if (value instanceof BigInteger
+          || value instanceof Long
+          || value instanceof Integer
+          || value instanceof Short
+          || value instanceof Byte) {
+        out.append(value);
+      } else if (value instanceof byte[]) {
+        encodeBytes((byte[]) value);
+      } else if (value instanceof List) {
+        encodeArray((List<?>) value, indent);
+      } else if (value instanceof Map) {
+        encodeObject(asObject(value), indent);
+      } else {
+        throw new YayException("Cannot encode " + value.getClass().getName(), null);
+      }
+    }
+
+    private void encodeString(String s) {
+      out.append('"');
+      for (int i = 0; i < s.length(); i++) {
+        char c = s.charAt(i);
+        switch (c) {
+          case '"':
+            out.append("\\\"");
+            break;
+          case '\\':
+            out.append("\\\\");
+            break;
+          case '/':
+            out.append("\\/");
+            break;
+          case '\n':
+            out.append("\\n");
+            break;
+          case '\r':
+            out.append("\\r");
+            break;
+          case '\t':
+            out.append("\\t");
+            break;
+          case '\b':
+            out.append("\\b");
+            break;
+          case '\f':
+            out.append("\\f");
+            break;
+          default:
+            if (Character.isISOControl(c)) {
+              out.append("\\u{").append(Integer.toHexString(c)).append('}');
+            } else {
+              out.append(c);
+            }
+        }
+      }
+      out.append('"');
+    }
+
+    private void encodeBytes(byte[] bytes) {
+      out.append('<');
+      for (byte b : bytes) {
+        out.append(HEX_DIGITS.charAt((b >> 4) & 0xF)).append(HEX_DIGITS.charAt(b & 0xF));
+      }
+      out.append('>');
+    }
+
+    /** Floats always carry a decimal point; the non-finite values use the keywords. */
+    private void encodeFloat(double f) {
+      if (Double.isNaN(f)) {
+        out.append("nan");
+      } else if (f == Double.POSITIVE_INFINITY) {
+        out.append("infinity");
+      } else if (f == Double.NEGATIVE_INFINITY) {
+        out.append("-infinity");
+      } else {
+        // Double.toString always includes '.' or an exponent, but the
+        // exponent must be lowercased for the parser
+        out.append(Double.toString(f).replace('E', 'e'));
+      }
+    }
+
+    /** Keys are bare when they need no quoting. */
+    private void encodeKey(String key) {
+      boolean bare = !key.isEmpty();
+      for (int i = 0; i < key.length(); i++) {
+        char c = key.charAt(i);
+        if (!Character.isLetterOrDigit(c) && c != '_' && c != '-') {
+          bare = false;
+          break;
+        }
+      }
+      if (bare) {
+        out.append(key);
+      } else {
+        encodeString(key);
+      }
+    }
+
+    private void pad(int indent) {
+      for (int i = 0; i < indent; i++) {
+        out.append("  ");
+      }
+    }
+
+    private void encodeArray(List<?> arr, int indent) {
+      if (arr.isEmpty()) {
+        out.append("[]");
+        return;
+      }
+      if (canInlineArray(arr)) {
+        out.append('[');
+        for (int i = 0; i < arr.size(); i++) {
+          if (i > 0) {
+            out.append(", ");
+          }
+          encodeValue(arr.get(i), 0);
+        }
+        out.append(']');
+        return;
+      }
+      encodeArrayBlock(arr, indent);
+    }
+
+    /** A block list with items at the given indent; the caller pads the first line. */
+    private void encodeArrayBlock(List<?> arr, int indent) {
+      for (int i = 0; i < arr.size(); i++) {
+        if (i > 0) {
+          out.append('\n');
+          pad(indent);
+        }
+        out.append("- ");
+        encodeArrayItem(arr.get(i), indent);
+        maybeFlush();
+      }
+    }
+
+    /** A block list item's value after its "- ". */
+    private void encodeArrayItem(Object value, int indent) {
+      if (value instanceof List && !canInlineArray((List<?>) value)) {
+        // Nested block list: first item on the same line, rest indented
+        List<?> arr = (List<?>) value;
+        for (int i = 0; i < arr.size(); i++) {
+          if (i > 0) {
+            out.append('\n');
+            pad(indent + 1);
+          }
+          out.append("- ");
+          encodeArrayItem(arr.get(i), indent + 1);
+        }
+        return;
+      }
+      if (value instanceof Map && !canInlineObject(asObject(value))) {
+        // Nested block object: first property on the same line
+        Map<String, Object> obj = asObject(value);
+        int i = 0;
+        for (String key : sortedKeys(obj)) {
+          if (i++ > 0) {
+            out.append('\n');
+            pad(indent + 1);
+          }
+          encodeProperty(key, obj.get(key), indent + 1);
+        }
+        return;
+      }
+      encodeValue(value, indent + 1);
+    }
+
+    private void encodeObject(Map<String, Object> obj, int indent) {
+      if (obj.isEmpty()) {
+        out.append("{}");
+        return;
+      }
+      List<String> keys = sortedKeys(obj);
+      if (canInlineObject(obj)) {
+        out.append('{');
+        for (int i = 0; i < keys.size(); i++) {
+          if (i > 0) {
+            out.append(", ");
+          }
+          encodeKey(keys.get(i));
+          out.append(": ");
+          encodeValue(obj.get(keys.get(i)), 0);
+        }
+        out.append('}');
+        return;
+      }
+      for (int i = 0; i < keys.size(); i++) {
+        if (i > 0) {
+          out.append('\n');
+          pad(indent);
+        }
+        encodeProperty(keys.get(i), obj.get(keys.get(i)), indent);
+        maybeFlush();
+      }
+    }
+
+    /**
+     * One "key: value" property whose key sits at the given indent. Block lists start at the
+     * key's own indent; block objects one level deeper.
+     */
+    private void encodeProperty(String key, Object value, int indent) {
+      encodeKey(key);
+      if (value instanceof List && !canInlineArray((List<?>) value)) {
+        out.append(":\n");
+        pad(indent);
+        encodeArrayBlock((List<?>) value, indent);
+        return;
+      }
+      if (value instanceof Map && !canInlineObject(asObject(value))) {
+        out.append(":\n");
+        pad(indent + 1);
+        encodeObject(asObject(value), indent + 1);
+        return;
+      }
+      out.append(": ");
+      encodeValue(value, indent + 1);
+    }
+
+    private static boolean canInlineArray(List<?> arr) {
+      if (arr.size() > 5) {
+        return false;
+      }
+      for (Object v : arr) {
+        if (v instanceof List || v instanceof Map) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    private static boolean canInlineObject(Map<String, Object> obj) {
+      if (obj.size() > 3) {
+        return false;
+      }
+      for (Object v : obj.values()) {
+        if (v instanceof List || v instanceof Map) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    private static List<String> sortedKeys(Map<String, Object> obj) {
+      List<String> keys = new ArrayList<>(obj.keySet());
+      Collections.sort(keys);
+      return keys;
+    }
+
+    @SuppressWarnings("unchecked")
+    private static Map<String, Object> asObject(Object value) {
+      return (Map<String, Object>) value;
+    }
+  }
+
+  /** Estimate a value's encoded length, so one-shot encodes size their buffer up front. */
+  private static int estimateSize(Object value) {
+    if (value instanceof String) {
+      return ((String) value).length() + 2;
+    }
+    if (value instanceof byte[]) {
+      return ((byte[]) value).length * 2 + 2;
+    }
+    if (value instanceof List) {
+      int size = 2;
+      for (Object v : (List<?>) value) {
+        size += estimateSize(v) + 4;
+      }
+      return size;
+    }
+    if (value instanceof Map) {
+      int size = 2;
+      for (Map.Entry<?, ?> entry : ((Map<?, ?>) value).entrySet()) {
+        size += String.valueOf(entry.getKey()).length() + estimateSize(entry.getValue()) + 6;
+      }
+      return size;
+    }
+    return 8;
+  }
+
   // ========================================================================
   // Scanner - Phase 1: Convert source to scan lines
   // ========================================================================
 
+  /**
+   * One source line as an offset/length slice over the original CharSequence. Content excludes the
+   * indent and any list leader; nothing is copied until a token's text is materialized.
+   */
   private static class ScanLine {
-    String content;
+    int contentStart;
+    int contentEnd;
     int indent;
-    String leader;
+    int leaderLen;
     int lineNum;
 
-    ScanLine(String content, int indent, String leader, int lineNum) {
-      this.content = content;
+    ScanLine(int contentStart, int contentEnd, int indent, int leaderLen, int lineNum) {
+      this.contentStart = contentStart;
+      this.contentEnd = contentEnd;
       this.indent = indent;
-      this.leader = leader;
+      this.leaderLen = leaderLen;
       this.lineNum = lineNum;
     }
   }
@@ -53,7 +537,19 @@ public class Yay {
         || (0x10000 <= cp && cp <= 0x10FFFF && (cp & 0xFFFF) < 0xFFFE);
   }
 
-  private static List<ScanLine> scan(String source, String filename) {
+  private static boolean regionEquals(CharSequence source, int start, int end, String expected) {
+    if (end - start != expected.length()) {
+      return false;
+    }
+    for (int i = 0; i < expected.length(); i++) {
+      if (source.charAt(start + i) != expected.charAt(i)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  private static List<ScanLine> scan(CharSequence source, String filename) {
     // Check for BOM
     if (source.length() >= 1 && source.charAt(0) == '\uFEFF') {
       throw new YayException("Illegal BOM", filename, 1, 1);
@@ -63,7 +559,7 @@ public class Yay {
     {
       int line = 1, col = 1;
       for (int i = 0; i < source.length(); ) {
-        int cp = source.codePointAt(i);
+        int cp = Character.codePointAt(source, i);
         if (!isAllowedCodePoint(cp)) {
           if (cp == 0x09) {
             throw new YayException("Tab not allowed (use spaces)", filename, line, col);
@@ -85,61 +581,69 @@ public class Yay {
     }
 
     List<ScanLine> lines = new ArrayList<>();
-    String[] rawLines = source.split("\n", -1);
+    int length = source.length();
+    int lineStart = 0;
 
-    for (int i = 0; i < rawLines.length; i++) {
-      String line = rawLines[i];
+    for (int i = 0; ; i++) {
+      int lineEnd = lineStart;
+      while (lineEnd < length && source.charAt(lineEnd) != '\n') {
+        lineEnd++;
+      }
 
       // Check for trailing space
-      if (line.length() > 0 && line.charAt(line.length() - 1) == ' ') {
-        throw new YayException("Unexpected trailing space", filename, i + 1, line.length());
+      if (lineEnd > lineStart && source.charAt(lineEnd - 1) == ' ') {
+        throw new YayException("Unexpected trailing space", filename, i + 1, lineEnd - lineStart);
       }
 
       // Count indent
-      int indent = 0;
-      while (indent < line.length() && line.charAt(indent) == ' ') {
-        indent++;
+      int restStart = lineStart;
+      while (restStart < lineEnd && source.charAt(restStart) == ' ') {
+        restStart++;
       }
-
-      String rest = line.substring(indent);
+      int indent = restStart - lineStart;
+      int restLen = lineEnd - restStart;
 
       // Empty line or comment-only at column 0
-      if (rest.isEmpty() || (rest.startsWith("#") && indent == 0)) {
-        lines.add(new ScanLine("", indent, "", i));
-        continue;
-      }
-
-      // Check for $ character
-      if (rest.equals("$")) {
-        throw new YayException("Unexpected character \"$\"", filename, i + 1, indent + 1);
-      }
+      if (restLen == 0 || (source.charAt(restStart) == '#' && indent == 0)) {
+        lines.add(new ScanLine(lineEnd, lineEnd, indent, 0, i));
+      } else {
+        char first = source.charAt(restStart);
+
+        // Check for $ character
+        if (restLen == 1 && first == '$') {
+          throw new YayException("Unexpected character \"$\"", filename, i + 1, indent + 1);
+        }
+
+        // Check for * character (not allowed as leader)
+        if (first == '*' && (restLen == 1 || source.charAt(restStart + 1) == ' ')) {
+          throw new YayException("Unexpected character \"*\"", filename, i + 1, indent + 1);
+        }
+
+        // Check for list item
+        int leaderLen = 0;
+        int contentStart = restStart;
+        if (first == '-') {
+          if (restLen >= 2 && source.charAt(restStart + 1) == ' ') {
+            leaderLen = 2;
+            contentStart = restStart + 2;
+          } else if (restLen == 1) {
+            leaderLen = 1;
+            contentStart = lineEnd;
+          } else if (source.charAt(restStart + 1) != '.'
+              && !Character.isDigit(source.charAt(restStart + 1))
+              && !regionEquals(source, restStart, lineEnd, "-infinity")) {
+            // Compact list syntax (-value without space) is not allowed
+            throw new YayException("Expected space after \"-\"", filename, i + 1, indent + 2);
+          }
+        }
 
-      // Check for * character (not allowed as leader)
-      if (rest.equals("*")
-          || (rest.length() >= 2 && rest.charAt(0) == '*' && rest.charAt(1) == ' ')) {
-        throw new YayException("Unexpected character \"*\"", filename, i + 1, indent + 1);
+        lines.add(new ScanLine(contentStart, lineEnd, indent, leaderLen, i));
       }
 
-      // Check for list item
-      String leader = "";
-      String content = rest;
-      if (rest.startsWith("- ")) {
-        leader = "- ";
-        content = rest.substring(2);
-      } else if (rest.equals("-")) {
-        leader = "-";
-        content = "";
-      } else if (rest.startsWith("-")
-          && rest.length() >= 2
-          && rest.charAt(1) != ' '
-          && rest.charAt(1) != '.'
-          && !Character.isDigit(rest.charAt(1))
-          && !rest.equals("-infinity")) {
-        // Compact list syntax (-value without space) is not allowed
-        throw new YayException("Expected space after \"-\"", filename, i + 1, indent + 2);
+      if (lineEnd >= length) {
+        break;
       }
-
-      lines.add(new ScanLine(content, indent, leader, i));
+      lineStart = lineEnd + 1;
     }
 
     return lines;
@@ -156,15 +660,33 @@ public class Yay {
     BREAK
   }
 
+  /**
+   * A token is an offset/length slice over the source; TEXT tokens materialize their String lazily
+   * through {@link Parser#text} and cache it. START/STOP/BREAK tokens carry constant text.
+   */
   private static class Token {
     TokenType type;
+    int start;
+    int end;
     String text;
     int indent;
     int lineNum;
     int col;
 
+    Token(TokenType type, int start, int end, int indent, int lineNum, int col) {
+      this.type = type;
+      this.start = start;
+      this.end = end;
+      this.text = null;
+      this.indent = indent;
+      this.lineNum = lineNum;
+      this.col = col;
+    }
+
     Token(TokenType type, String text, int indent, int lineNum, int col) {
       this.type = type;
+      this.start = 0;
+      this.end = 0;
       this.text = text;
       this.indent = indent;
       this.lineNum = lineNum;
@@ -180,7 +702,7 @@ public class Yay {
 
     for (ScanLine sl : scanLines) {
       // Handle blank lines
-      if (sl.content.isEmpty() && sl.leader.isEmpty()) {
+      if (sl.contentStart == sl.contentEnd && sl.leaderLen == 0) {
         if (!lastWasBreak && !tokens.isEmpty()) {
           tokens.add(new Token(TokenType.BREAK, "", sl.indent, sl.lineNum, 0));
           lastWasBreak = true;
@@ -189,7 +711,7 @@ public class Yay {
       }
 
       lastWasBreak = false;
-      int effectiveIndent = sl.indent + sl.leader.length();
+      int effectiveIndent = sl.indent + sl.leaderLen;
 
       // Handle dedent
       while (indentStack.peek() >= effectiveIndent) {
@@ -198,15 +720,19 @@ public class Yay {
       }
 
       // Handle list item
-      if (!sl.leader.isEmpty()) {
-        tokens.add(new Token(TokenType.START, sl.leader, sl.indent, sl.lineNum, sl.indent));
+      if (sl.leaderLen > 0) {
+        String leader = sl.leaderLen == 2 ? "- " : "-";
+        tokens.add(new Token(TokenType.START, leader, sl.indent, sl.lineNum, sl.indent));
         indentStack.push(effectiveIndent);
       }
 
       // Handle content
-      if (!sl.content.isEmpty()) {
-        // Use indent as col (like JS), not indent + leader.length()
-        tokens.add(new Token(TokenType.TEXT, sl.content, effectiveIndent, sl.lineNum, sl.indent));
+      if (sl.contentStart < sl.contentEnd) {
+        // Use indent as col (like JS), not indent + leader length
+        tokens.add(
+            new Token(
+                TokenType.TEXT, sl.contentStart, sl.contentEnd, effectiveIndent, sl.lineNum,
+                sl.indent));
       }
     }
 
@@ -224,11 +750,13 @@ public class Yay {
   // ========================================================================
 
   private static class Parser {
+    private final CharSequence source;
     private final List<Token> tokens;
     private final String filename;
     private int pos;
 
-    Parser(String source, String filename) {
+    Parser(CharSequence source, String filename) {
+      this.source = source;
       this.filename = filename;
 
       // BOM check is now in scan()
@@ -237,6 +765,14 @@ public class Yay {
       this.pos = 0;
     }
 
+    /** Materialize a token's text, caching the String on the token. */
+    private String text(Token t) {
+      if (t.text == null) {
+        t.text = source.subSequence(t.start, t.end).toString();
+      }
+      return t.text;
+    }
+
     Object parse() {
       skipBreaks();
       if (pos >= tokens.size()) {
@@ -251,13 +787,13 @@ public class Yay {
       }
 
       // Check for leading space in text
-      if (t.type == TokenType.TEXT && t.text.startsWith(" ")) {
+      if (t.type == TokenType.TEXT && text(t).startsWith(" ")) {
         throw new YayException("Unexpected leading space", filename, t.lineNum + 1, t.col + 1);
       }
 
       // Check for root-level multiline object (key: value at indent 0)
-      if (t.type == TokenType.TEXT && t.indent == 0 && !t.text.startsWith("{")) {
-        int colonIdx = findColonOutsideQuotes(t.text);
+      if (t.type == TokenType.TEXT && t.indent == 0 && !text(t).startsWith("{")) {
+        int colonIdx = findColonOutsideQuotes(text(t));
         if (colonIdx > 0) {
           Object result = parseRootObject();
           return ensureAtEnd(result);
@@ -290,7 +826,7 @@ public class Yay {
           break;
         }
 
-        int colonIdx = findColonOutsideQuotes(t.text);
+        int colonIdx = findColonOutsideQuotes(text(t));
         if (colonIdx <= 0) {
           break;
         }
@@ -325,7 +861,7 @@ public class Yay {
 
       switch (t.type) {
         case START:
-          if (t.text.equals("- ") || t.text.equals("-")) {
+          if (text(t).equals("- ") || text(t).equals("-")) {
             return parseMultilineArray();
           }
           pos++;
@@ -344,7 +880,7 @@ public class Yay {
     }
 
     private Object parseTextValue(Token t) {
-      String s = t.text;
+      String s = text(t);
 
       // Check for leading space
       if (s.startsWith(" ")) {
@@ -568,7 +1104,7 @@ public class Yay {
           if (isProperty && t.indent <= baseIndent) {
             break;
           }
-          lines.add(t.text);
+          lines.add(text(t));
           indents.add(t.indent);
           pos++;
         } else if (t.type == TokenType.BREAK) {
@@ -698,7 +1234,7 @@ public class Yay {
           if (isProperty && t.indent <= baseIndent) {
             break;
           }
-          String line = t.text;
+          String line = text(t);
           int h = line.indexOf('#');
           if (h >= 0) {
             line = line.substring(0, h);
@@ -721,7 +1257,7 @@ public class Yay {
 
     private byte[] parseMultilineAngleBytes(int baseIndent) {
       Token first = tokens.get(pos);
-      String firstLine = first.text;
+      String firstLine = text(first);
       String hexStart =
           firstLine.startsWith("< ") ? firstLine.substring(2) : firstLine.substring(1);
       int hashIdx = hexStart.indexOf('#');
@@ -735,7 +1271,7 @@ public class Yay {
       while (pos < tokens.size()) {
         Token t = tokens.get(pos);
         if (t.type == TokenType.TEXT && t.indent > baseIndent) {
-          String line = t.text;
+          String line = text(t);
           int h = line.indexOf('#');
           if (h >= 0) {
             line = line.substring(0, h);
@@ -800,12 +1336,12 @@ public class Yay {
           if (pos < tokens.size()) {
             Token next = tokens.get(pos);
             // Check for nested array (text starting with "- ")
-            if (next.type == TokenType.TEXT && next.text.startsWith("- ")) {
+            if (next.type == TokenType.TEXT && text(next).startsWith("- ")) {
               items.add(parseInlineBulletList(baseIndent));
             } else if (next.type == TokenType.START) {
               // Another START token means nested list
               items.add(parseMultilineArray());
-            } else if (next.type == TokenType.TEXT && findColonOutsideQuotes(next.text) > 0) {
+            } else if (next.type == TokenType.TEXT && findColonOutsideQuotes(text(next)) > 0) {
               // Object inside array item - parse all key-value pairs at this indent level
               items.add(parseObjectInArrayItem(listItemIndent));
             } else {
@@ -857,7 +1393,7 @@ public class Yay {
 
         // Parse key-value pairs at the object indent
         if (t.type == TokenType.TEXT && t.indent == objectIndent) {
-          int colonIdx = findColonOutsideQuotes(t.text);
+          int colonIdx = findColonOutsideQuotes(text(t));
           if (colonIdx > 0) {
             Map<String, Object> pair = parseKeyValuePair(t, colonIdx);
             obj.putAll(pair);
@@ -896,8 +1432,8 @@ public class Yay {
         Token t = tokens.get(pos);
 
         // Handle inline bullet text (e.g., "- a" or "- key:")
-        if (t.type == TokenType.TEXT && t.text.startsWith("- ")) {
-          String value = t.text.substring(2);
+        if (t.type == TokenType.TEXT && text(t).startsWith("- ")) {
+          String value = text(t).substring(2);
 
           // Check for extra space after "-"
           if (value.startsWith(" ")) {
@@ -953,12 +1489,12 @@ public class Yay {
           if (pos < tokens.size()) {
             Token next = tokens.get(pos);
             if (next.type == TokenType.TEXT) {
-              int colonIdx = findColonOutsideQuotes(next.text);
+              int colonIdx = findColonOutsideQuotes(text(next));
               if (colonIdx > 0) {
                 // Object inside list item
                 items.add(parseObjectInArrayItem(itemIndent));
               } else {
-                items.add(parseScalar(next.text, next.lineNum, next.col));
+                items.add(parseScalar(text(next), next.lineNum, next.col));
                 pos++;
               }
             } else {
@@ -1151,8 +1687,8 @@ public class Yay {
     // ====================================================================
 
     private Map<String, Object> parseKeyValuePair(Token t, int colonIdx) {
-      String keyRaw = t.text.substring(0, colonIdx);
-      String valueSlice = t.text.substring(colonIdx + 1);
+      String keyRaw = text(t).substring(0, colonIdx);
+      String valueSlice = text(t).substring(colonIdx + 1);
 
       // Check for space before colon
       if (keyRaw.endsWith(" ")) {
@@ -1257,20 +1793,20 @@ public class Yay {
       Token next = tokens.get(pos);
 
       // Named array - pass next.indent so array stops at items below this level
-      if (next.type == TokenType.START && (next.text.equals("- ") || next.text.equals("-"))) {
+      if (next.type == TokenType.START && (text(next).equals("- ") || text(next).equals("-"))) {
         obj.put(key, parseMultilineArrayImpl(next.indent));
         return obj;
       }
 
       // Block string on next line - this is invalid in strict YAY
       // The backtick must be on the same line as the key
-      if (next.type == TokenType.TEXT && next.text.equals("`")) {
+      if (next.type == TokenType.TEXT && text(next).equals("`")) {
         throw new YayException("Unexpected indent", filename, next.lineNum + 1, 1);
       }
 
       // Block bytes on next line - this is invalid in strict YAY
       // The > must be on the same line as the key
-      if (next.type == TokenType.TEXT && next.text.startsWith(">") && !next.text.contains("<")) {
+      if (next.type == TokenType.TEXT && text(next).startsWith(">") && !text(next).contains("<")) {
         throw new YayException("Unexpected indent", filename, next.lineNum + 1, 1);
       }
 
@@ -1279,7 +1815,7 @@ public class Yay {
 
       // Concatenated quoted strings (multiple quoted strings on consecutive lines)
       if (next.type == TokenType.TEXT && next.indent > t.indent) {
-        String trimmed = next.text.trim();
+        String trimmed = text(next).trim();
         if ((trimmed.startsWith("\"") && trimmed.endsWith("\"") && trimmed.length() >= 2)
             || (trimmed.startsWith("'") && trimmed.endsWith("'") && trimmed.length() >= 2)) {
           String result = parseConcatenatedStrings(next.indent);
@@ -1317,11 +1853,11 @@ public class Yay {
         }
 
         // Reject inline values on separate line (they look like keys starting with special chars)
-        if (t.text.startsWith("{") || t.text.startsWith("[") || t.text.startsWith("<")) {
+        if (text(t).startsWith("{") || text(t).startsWith("[") || text(t).startsWith("<")) {
           throw new YayException("Unexpected indent", filename, t.lineNum + 1, 1);
         }
 
-        int colonIdx = findColonOutsideQuotes(t.text);
+        int colonIdx = findColonOutsideQuotes(text(t));
         if (colonIdx > 0) {
           Map<String, Object> pair = parseKeyValuePair(t, colonIdx);
           obj.putAll(pair);
@@ -1353,7 +1889,7 @@ public class Yay {
           break;
         }
 
-        String trimmed = t.text.trim();
+        String trimmed = text(t).trim();
 
         // Check if this line is a quoted string
         boolean isDoubleQuoted =
@@ -1397,7 +1933,7 @@ public class Yay {
       while (pos < tokens.size()) {
         Token t = tokens.get(pos);
         if (t.type == TokenType.TEXT && t.indent > baseIndent) {
-          String line = t.text;
+          String line = text(t);
           int h = line.indexOf('#');
           if (h >= 0) {
             line = line.substring(0, h);
@@ -74,6 +74,87 @@ public class YayTest {
     assertArrayEquals(new byte[] {(byte) 0xca, (byte) 0xfe}, bytes);
   }
 
+  @Test
+  void testParseReader() throws IOException {
+    @SuppressWarnings("unchecked")
+    Map<String, Object> obj =
+        (Map<String, Object>) Yay.parse(new java.io.StringReader("a: 1\nb: 'two'"));
+    assertEquals(new BigInteger("1"), obj.get("a"));
+    assertEquals("two", obj.get("b"));
+  }
+
+  @Test
+  void testParseAll() throws IOException {
+    if (!Files.exists(YAY_DIR)) {
+      return;
+    }
+    List<Path> paths;
+    try (Stream<Path> entries = Files.list(YAY_DIR)) {
+      paths = entries.filter(p -> p.toString().endsWith(".yay")).sorted().toList();
+    }
+    List<Object> parallel = Yay.parseAll(paths, 4);
+    assertEquals(paths.size(), parallel.size());
+    // Ordered delivery: each slot matches a single-threaded parse of the same file
+    for (int i = 0; i < paths.size(); i++) {
+      Object expected = Yay.parse(Files.readString(paths.get(i)), paths.get(i).toString());
+      assertTrue(deepEqual(expected, parallel.get(i)), paths.get(i).toString());
+    }
+  }
+
+  @Test
+  void testParsePath() throws IOException {
+    if (!Files.exists(YAY_DIR)) {
+      return;
+    }
+    List<Path> paths;
+    try (Stream<Path> entries = Files.list(YAY_DIR)) {
+      paths = entries.filter(p -> p.toString().endsWith(".yay")).sorted().toList();
+    }
+    // The memory-mapped entry point decodes to the same values as readString + parse
+    for (Path path : paths) {
+      Object expected = Yay.parse(Files.readString(path), path.toString());
+      assertTrue(deepEqual(expected, Yay.parse(path)), path.toString());
+    }
+  }
+
+  @Test
+  void testEncode() {
+    assertEquals("null", Yay.encode(null));
+    assertEquals("42", Yay.encode(new BigInteger("42")));
+    assertEquals("1.5", Yay.encode(1.5));
+    assertEquals("1.0", Yay.encode(1.0));
+    assertEquals("nan", Yay.encode(Double.NaN));
+    assertEquals("\"hi\\n\"", Yay.encode("hi\n"));
+    assertEquals("<cafe>", Yay.encode(new byte[] {(byte) 0xca, (byte) 0xfe}));
+    assertEquals("[1, 2, 3]", Yay.encode(Yay.parse("[1, 2, 3]")));
+    assertEquals("a: 1\nb:\n- 1\n- 2\n- 3\n- 4\n- 5\n- 6", Yay.encode(Yay.parse("a: 1\nb: [1, 2, 3, 4, 5, 6]")));
+  }
+
+  @Test
+  void testEncodeWriter() throws IOException {
+    java.io.StringWriter writer = new java.io.StringWriter();
+    Yay.Encoder encoder = new Yay.Encoder(writer);
+    encoder.encodeDocument(Yay.parse("a: 1"));
+    encoder.encodeDocument(Yay.parse("b: 2"));
+    assertEquals("a: 1\n\nb: 2\n", writer.toString());
+  }
+
+  @Test
+  void testEncodeRoundTrip() throws IOException {
+    if (!Files.exists(YAY_DIR)) {
+      return;
+    }
+    List<Path> paths;
+    try (Stream<Path> entries = Files.list(YAY_DIR)) {
+      paths = entries.filter(p -> p.toString().endsWith(".yay")).sorted().toList();
+    }
+    for (Path path : paths) {
+      Object expected = Yay.parse(Files.readString(path), path.toString());
+      Object reparsed = Yay.parse(Yay.encode(expected), path.toString());
+      assertTrue(deepEqual(expected, reparsed), path.toString());
+    }
+  }
+
   @TestFactory
   Stream<DynamicTest> testAllYayFixtures() throws IOException {
     if (!Files.exists(YAY_DIR)) {
@@ -0,0 +1,40 @@
+// Parses every .yay file in a corpus directory a number of times and
+// prints one machine-readable line, "<bytes> <seconds>", for
+// scripts/bench.sh to turn into a cross-implementation MB/s and
+// peak-RSS table.
+//
+// Usage: node bench.js [corpus-dir] [reps]   (default ../../test/yay, 100)
+
+import { readFileSync, readdirSync } from "node:fs";
+import { join } from "node:path";
+import { parseYay } from "./yay.js";
+
+const dir = process.argv[2] ?? "../../test/yay";
+const reps = Number(process.argv[3] ?? 100);
+if (!Number.isInteger(reps) || reps < 1) {
+  console.error(`bad rep count ${process.argv[3]}`);
+  process.exit(1);
+}
+
+const names = readdirSync(dir)
+  .filter((name) => name.endsWith(".yay"))
+  .sort();
+const sources = names.map((name) => readFileSync(join(dir, name), "utf8"));
+const totalBytes = sources.reduce(
+  (sum, source) => sum + Buffer.byteLength(source),
+  0,
+);
+
+const start = process.hrtime.bigint();
+for (let rep = 0; rep < reps; rep += 1) {
+  for (const source of sources) {
+    try {
+      parseYay(source);
+    } catch {
+      // Parse errors still count as work done
+    }
+  }
+}
+const elapsed = Number(process.hrtime.bigint() - start) / 1e9;
+
+console.log(`${totalBytes * reps} ${elapsed.toFixed(6)}`);
@@ -0,0 +1,206 @@
+"use strict";
+
+/**
+ * Incremental tokenizer for editor diagnostics.
+ *
+ * Running parseYay over a whole buffer on every keystroke is linear in
+ * the document, which makes diagnostics sluggish past a few thousand
+ * lines. This layer keeps a per-line scan cache over the same scanner
+ * the parser uses: an edit rescans only the inserted lines, then
+ * re-lexes and re-parses the smallest enclosing outline subtree (the
+ * span between the surrounding column-zero lines), so keystroke work
+ * is bounded by the subtree rather than the file.
+ *
+ * Diagnostics are structural, not semantic: they report what parseYay
+ * would reject, with zero-based line and column positions.
+ */
+
+import { scan, outlineLex, parseRoot, ParseContext } from "./yay.js";
+
+/**
+ * @typedef {Object} Diagnostic
+ * @property {string} message - Error text without the location suffix
+ * @property {number} line - Zero-based line
+ * @property {number} col - Zero-based column
+ */
+
+// The scanner and parser bake positions into error messages when a
+// filename is present; this private name lets them be recovered as
+// structured positions.
+const FILENAME = "\u0000incremental";
+const LOC_SUFFIX = / at (\d+):(\d+) of <\u0000incremental>$/;
+
+/**
+ * Convert a thrown scanner or parser error into a diagnostic.
+ * @param {unknown} error
+ * @param {number} fallbackLine
+ * @returns {Diagnostic}
+ */
+function toDiagnostic(error, fallbackLine) {
+  const message = error instanceof Error ? error.message : String(error);
+  const match = message.match(LOC_SUFFIX);
+  if (match) {
+    return {
+      message: message.slice(0, match.index),
+      line: Number(match[1]) - 1,
+      col: Number(match[2]) - 1,
+    };
+  }
+  return { message, line: fallbackLine, col: 0 };
+}
+
+/**
+ * Count a line's leading spaces.
+ * @param {string} lineStr
+ * @returns {number}
+ */
+function countIndent(lineStr) {
+  let indent = 0;
+  while (indent < lineStr.length && lineStr[indent] === " ") {
+    indent++;
+  }
+  return indent;
+}
+
+class IncrementalTokenizer {
+  /**
+   * @param {string} source - Initial buffer contents
+   */
+  constructor(source = "") {
+    this.ctx = new ParseContext(FILENAME);
+    /** @type {string[]} */
+    this.lineStrings = source.split("\n");
+    /**
+     * Per-line scan cache, parallel to lineStrings. Each slot holds the
+     * line's ScanLine, null for comment lines, or a Diagnostic under
+     * `error` when the line does not scan.
+     * @type {Array<{scanLine: ?object, error: ?Diagnostic}>}
+     */
+    this.scanned = [];
+    for (let i = 0; i < this.lineStrings.length; i++) {
+      this.scanned.push(this.scanLine(i));
+    }
+  }
+
+  /**
+   * Scan a single line, caching its tokens or its diagnostic.
+   * @param {number} lineNum
+   */
+  scanLine(lineNum) {
+    try {
+      const lines = scan(this.lineStrings[lineNum], this.ctx, lineNum);
+      return { scanLine: lines.length > 0 ? lines[0] : null, error: null };
+    } catch (error) {
+      return { scanLine: null, error: toDiagnostic(error, lineNum) };
+    }
+  }
+
+  /**
+   * Apply an edit that replaces whole lines, rescanning only the
+   * inserted lines and revalidating the enclosing outline subtree.
+   *
+   * @param {number} startLine - First replaced line
+   * @param {number} deleteCount - Number of lines removed
+   * @param {string} insertedText - Replacement text ("" inserts nothing)
+   * @returns {{startLine: number, endLine: number, diagnostics: Diagnostic[]}}
+   *   The revalidated line range (endLine exclusive) and its diagnostics.
+   */
+  applyEdit(startLine, deleteCount, insertedText) {
+    const insertedLines = insertedText === "" ? [] : insertedText.split("\n");
+    this.lineStrings.splice(startLine, deleteCount, ...insertedLines);
+    const slots = insertedLines.map(() => null);
+    this.scanned.splice(startLine, deleteCount, ...slots);
+    for (let i = 0; i < insertedLines.length; i++) {
+      this.scanned[startLine + i] = this.scanLine(startLine + i);
+    }
+    // Following lines keep their text but their absolute numbers moved.
+    const shift = insertedLines.length - deleteCount;
+    if (shift !== 0) {
+      for (let i = startLine + insertedLines.length; i < this.scanned.length; i++) {
+        const slot = this.scanned[i];
+        if (slot.scanLine) slot.scanLine.lineNum = i;
+        if (slot.error) slot.error.line += shift;
+      }
+    }
+    return this.validateSubtree(startLine, startLine + insertedLines.length);
+  }
+
+  /**
+   * Find the enclosing subtree of a line range and re-run the outline
+   * lexer and parser over it.
+   *
+   * The subtree spans from the nearest non-blank column-zero line at or
+   * before the range to the next one after it; blank lines do not bound
+   * it, since they may sit inside block strings.
+   *
+   * @param {number} fromLine
+   * @param {number} toLine - Exclusive
+   * @returns {{startLine: number, endLine: number, diagnostics: Diagnostic[]}}
+   */
+  validateSubtree(fromLine, toLine) {
+    if (this.lineStrings.length === 0) {
+      return { startLine: 0, endLine: 0, diagnostics: [] };
+    }
+    let start = Math.min(fromLine, this.lineStrings.length - 1);
+    while (
+      start > 0 &&
+      (this.lineStrings[start].length === 0 ||
+        countIndent(this.lineStrings[start]) > 0)
+    ) {
+      start--;
+    }
+    let end = Math.max(toLine, start + 1);
+    while (
+      end < this.lineStrings.length &&
+      (this.lineStrings[end].length === 0 ||
+        countIndent(this.lineStrings[end]) > 0)
+    ) {
+      end++;
+    }
+
+    const diagnostics = [];
+    const scanLines = [];
+    for (let i = start; i < end; i++) {
+      const slot = this.scanned[i];
+      if (slot.error) {
+        diagnostics.push(slot.error);
+      } else if (slot.scanLine) {
+        scanLines.push(slot.scanLine);
+      }
+    }
+    // Scan errors mask parse errors, as in the batch parser's phases.
+    if (diagnostics.length === 0 && scanLines.length > 0) {
+      try {
+        parseRoot(outlineLex(scanLines), this.ctx);
+      } catch (error) {
+        diagnostics.push(toDiagnostic(error, start));
+      }
+    }
+    return { startLine: start, endLine: end, diagnostics };
+  }
+
+  /**
+   * Revalidate the whole document, subtree by subtree.
+   * @returns {Diagnostic[]}
+   */
+  validateAll() {
+    const diagnostics = [];
+    let line = 0;
+    while (line < this.lineStrings.length) {
+      const { endLine, diagnostics: subtree } = this.validateSubtree(
+        line,
+        line + 1,
+      );
+      diagnostics.push(...subtree);
+      line = Math.max(endLine, line + 1);
+    }
+    return diagnostics;
+  }
+
+  /** @returns {string} The tracked buffer contents. */
+  text() {
+    return this.lineStrings.join("\n");
+  }
+}
+
+export { IncrementalTokenizer };
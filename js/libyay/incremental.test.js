@@ -0,0 +1,70 @@
+import { describe, it } from "node:test";
+import assert from "node:assert";
+
+import { IncrementalTokenizer } from "./incremental.js";
+
+describe("IncrementalTokenizer", () => {
+  it("reports no diagnostics for a valid document", () => {
+    const doc = new IncrementalTokenizer('a: 1\nb:\n  c: "hi"\nd: [1, 2]');
+    assert.deepStrictEqual(doc.validateAll(), []);
+  });
+
+  it("reports a scan diagnostic with structured position", () => {
+    const doc = new IncrementalTokenizer("a: 1\nb:\tbad\nc: 3");
+    const diagnostics = doc.validateAll();
+    assert.strictEqual(diagnostics.length, 1);
+    assert.strictEqual(diagnostics[0].message, "Tab not allowed (use spaces)");
+    assert.strictEqual(diagnostics[0].line, 1);
+    assert.strictEqual(diagnostics[0].col, 2);
+  });
+
+  it("applies an edit and revalidates only the enclosing subtree", () => {
+    const doc = new IncrementalTokenizer(
+      "first: 1\nsecond:\n  nested: 2\n  other: 3\nthird: 4",
+    );
+    const result = doc.applyEdit(2, 1, "  nested: 22");
+    assert.strictEqual(result.startLine, 1);
+    assert.strictEqual(result.endLine, 4);
+    assert.deepStrictEqual(result.diagnostics, []);
+    assert.strictEqual(
+      doc.text(),
+      "first: 1\nsecond:\n  nested: 22\n  other: 3\nthird: 4",
+    );
+  });
+
+  it("surfaces a parse diagnostic introduced by an edit and clears it", () => {
+    const doc = new IncrementalTokenizer("a:\n  b: 1\nc: 2");
+    const broken = doc.applyEdit(1, 1, "  b 1");
+    assert.strictEqual(broken.diagnostics.length, 1);
+    assert.match(broken.diagnostics[0].message, /Unexpected indent/);
+    assert.strictEqual(broken.diagnostics[0].line, 1);
+
+    const fixed = doc.applyEdit(1, 1, "  b: 1");
+    assert.deepStrictEqual(fixed.diagnostics, []);
+  });
+
+  it("renumbers diagnostics on lines after an insertion", () => {
+    const doc = new IncrementalTokenizer("a: 1\nb:\tbad");
+    doc.applyEdit(0, 0, "zero: 0\nmore: 0");
+    const diagnostics = doc.validateAll();
+    assert.strictEqual(diagnostics.length, 1);
+    assert.strictEqual(diagnostics[0].line, 3);
+  });
+
+  it("keeps blank lines inside block strings within one subtree", () => {
+    const doc = new IncrementalTokenizer("text: `\n  one\n\n  two\nnext: 1");
+    assert.deepStrictEqual(doc.validateAll(), []);
+    const result = doc.applyEdit(3, 1, "  two edited");
+    assert.strictEqual(result.startLine, 0);
+    assert.deepStrictEqual(result.diagnostics, []);
+  });
+
+  it("handles line insertion and deletion at the document edges", () => {
+    const doc = new IncrementalTokenizer("a: 1");
+    doc.applyEdit(1, 0, "b: 2");
+    assert.strictEqual(doc.text(), "a: 1\nb: 2");
+    doc.applyEdit(0, 1, "");
+    assert.strictEqual(doc.text(), "b: 2");
+    assert.deepStrictEqual(doc.validateAll(), []);
+  });
+});
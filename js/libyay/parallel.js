@@ -0,0 +1,108 @@
+"use strict";
+
+/**
+ * Worker-thread parallel file parsing.
+ *
+ * Batch consumers (formatters, monorepo checks) parse thousands of
+ * documents per run; on one thread that is core-bound. parseYayFiles
+ * shards a file list across a worker_threads pool — Node startup is
+ * paid once, each worker reads and parses its own files, and parsed
+ * values come back as structured clones (bigint, Uint8Array, and plain
+ * objects all transfer) — so throughput scales with cores.
+ *
+ * This file is both the API and the worker: the pool spawns workers
+ * from its own URL, and the worker branch at the bottom serves parse
+ * requests until its port closes.
+ */
+
+import { readFileSync } from "node:fs";
+import { availableParallelism } from "node:os";
+import { Worker, isMainThread, parentPort } from "node:worker_threads";
+
+import { parseYay } from "./yay.js";
+
+/**
+ * @typedef {Object} FileResult
+ * @property {string} path
+ * @property {unknown=} value - Parsed document, when parsing succeeded
+ * @property {string=} error - Error message, when it failed
+ */
+
+/**
+ * Read and parse the named files across a pool of worker threads,
+ * resolving to results in path order. Failures are reported per file;
+ * one bad file does not reject the batch.
+ *
+ * @param {string[]} paths
+ * @param {{parallelism?: number}} [options] - Worker count; defaults to
+ *   the machine's available parallelism.
+ * @returns {Promise<FileResult[]>}
+ */
+function parseYayFiles(paths, options = {}) {
+  if (paths.length === 0) {
+    return Promise.resolve([]);
+  }
+  let parallelism = options.parallelism ?? availableParallelism();
+  if (parallelism < 1) parallelism = 1;
+  if (parallelism > paths.length) parallelism = paths.length;
+
+  return new Promise((resolve, reject) => {
+    /** @type {FileResult[]} */
+    const results = new Array(paths.length);
+    const workers = [];
+    let nextIndex = 0;
+    let pending = paths.length;
+
+    const finish = (error) => {
+      for (const worker of workers) {
+        worker.terminate();
+      }
+      if (error) {
+        reject(error);
+      } else {
+        resolve(results);
+      }
+    };
+
+    const dispatch = (worker) => {
+      if (nextIndex >= paths.length) return;
+      const index = nextIndex++;
+      worker.postMessage({ index, path: paths[index] });
+    };
+
+    for (let w = 0; w < parallelism; w++) {
+      const worker = new Worker(new URL(import.meta.url));
+      workers.push(worker);
+      worker.on("message", (result) => {
+        results[result.index] = {
+          path: paths[result.index],
+          ...(result.error !== undefined
+            ? { error: result.error }
+            : { value: result.value }),
+        };
+        pending--;
+        if (pending === 0) {
+          finish();
+        } else {
+          dispatch(worker);
+        }
+      });
+      worker.on("error", finish);
+      dispatch(worker);
+    }
+  });
+}
+
+if (!isMainThread && parentPort) {
+  parentPort.on("message", ({ index, path }) => {
+    try {
+      const source = readFileSync(path, "utf8");
+      parentPort.postMessage({ index, value: parseYay(source, path) });
+    } catch (error) {
+      const message = error instanceof Error ? error.message : String(error);
+      parentPort.postMessage({ index, error: message });
+    }
+  });
+}
+
+export { parseYayFiles };
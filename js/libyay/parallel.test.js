@@ -0,0 +1,43 @@
+import { describe, it } from "node:test";
+import assert from "node:assert";
+import fs from "fs";
+import os from "os";
+import path from "path";
+
+import { parseYayFiles } from "./parallel.js";
+
+describe("parseYayFiles", () => {
+  it("parses files across workers in path order", async () => {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), "yay-parallel-"));
+    const paths = [];
+    try {
+      for (let i = 0; i < 20; i++) {
+        const file = path.join(dir, `doc${String(i).padStart(2, "0")}.yay`);
+        fs.writeFileSync(file, `n: ${i}\ntext: "doc ${i}"\n`);
+        paths.push(file);
+      }
+      const bad = path.join(dir, "bad.yay");
+      fs.writeFileSync(bad, ": nope\n");
+      paths.push(bad, path.join(dir, "missing.yay"));
+
+      const results = await parseYayFiles(paths, { parallelism: 4 });
+      assert.strictEqual(results.length, paths.length);
+      for (let i = 0; i < 20; i++) {
+        assert.strictEqual(results[i].path, paths[i]);
+        assert.strictEqual(results[i].error, undefined);
+        assert.deepStrictEqual(results[i].value, {
+          n: BigInt(i),
+          text: `doc ${i}`,
+        });
+      }
+      assert.match(results[20].error, /bad\.yay/);
+      assert.match(results[21].error, /ENOENT/);
+    } finally {
+      fs.rmSync(dir, { recursive: true, force: true });
+    }
+  });
+
+  it("resolves immediately for an empty batch", async () => {
+    assert.deepStrictEqual(await parseYayFiles([]), []);
+  });
+});
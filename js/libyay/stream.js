@@ -0,0 +1,309 @@
+"use strict";
+
+/**
+ * Event-emitting parse mode and a streaming JSON writer.
+ *
+ * Converting a large document to JSON with parseYay means holding the
+ * whole value tree and then the whole JSON.stringify output — the
+ * document is buffered twice. This layer walks the token stream one
+ * top-level chunk at a time (a root list item or a root object entry),
+ * parses only that chunk, and reports it as scalar and container
+ * boundary events, so memory is bounded by the largest top-level value
+ * rather than the document. The JSON writer folds those events into
+ * text fragments behind a Readable, so Node pipelines get backpressure
+ * for free.
+ *
+ * JSON has no bytes, NaN, or infinity; as in the CLI's JSON encoder,
+ * those render as null. Integers (bigint) render as bare decimal
+ * literals regardless of magnitude.
+ */
+
+import { Readable } from "node:stream";
+
+import {
+  scan,
+  outlineLex,
+  parseRoot,
+  ParseContext,
+  parseListArray,
+  parseRootObject,
+  findKeyColonOutsideQuotes,
+} from "./yay.js";
+
+/**
+ * One parse event. Fixed shape for the same reason as Token in yay.js:
+ * every consumer switch over `type` stays monomorphic.
+ */
+class ParseEvent {
+  /**
+   * @param {'scalar'|'arrayStart'|'arrayEnd'|'objectStart'|'key'|'objectEnd'} type
+   * @param {string} key - Property name for 'key' events, "" otherwise
+   * @param {unknown} value - Value for 'scalar' events, undefined otherwise
+   */
+  constructor(type, key, value) {
+    this.type = type;
+    this.key = key;
+    this.value = value;
+  }
+}
+
+const ARRAY_START = new ParseEvent("arrayStart", "", undefined);
+const ARRAY_END = new ParseEvent("arrayEnd", "", undefined);
+const OBJECT_START = new ParseEvent("objectStart", "", undefined);
+const OBJECT_END = new ParseEvent("objectEnd", "", undefined);
+
+/**
+ * Split the token stream into top-level chunks, each one root list
+ * item or one root object entry with everything nested under it.
+ *
+ * In a root list every column-zero start token opens a new item;
+ * nested lists sit at deeper indents. In a root object a new entry is
+ * a column-zero text token, except the first line of a list item in a
+ * column-zero list under a key ("b:" followed by "- c: 1"), which
+ * directly follows its start token.
+ *
+ * @param {import("./yay.js").Token[]} tokens
+ * @param {number} from - Index of the first meaningful token
+ * @param {'list'|'object'} mode
+ * @returns {Generator<import("./yay.js").Token[]>}
+ */
+function* rootChunks(tokens, from, mode) {
+  let chunkStart = from;
+  let afterStart = false; // last non-break token was a column-zero start
+  for (let j = from; j < tokens.length; j++) {
+    const t = tokens[j];
+    const boundary =
+      j > chunkStart &&
+      t.indent === 0 &&
+      (mode === "list"
+        ? t.type === "start"
+        : t.type === "text" && !afterStart);
+    if (boundary) {
+      yield tokens.slice(chunkStart, j);
+      chunkStart = j;
+    }
+    if (t.type !== "break") {
+      afterStart = t.type === "start" && t.indent === 0;
+    }
+  }
+  yield tokens.slice(chunkStart);
+}
+
+/**
+ * Report a parsed value as events, depth first.
+ * @param {unknown} value
+ * @returns {Generator<ParseEvent>}
+ */
+function* valueEvents(value) {
+  if (Array.isArray(value)) {
+    yield ARRAY_START;
+    for (const item of value) yield* valueEvents(item);
+    yield ARRAY_END;
+  } else if (
+    value !== null &&
+    typeof value === "object" &&
+    !(value instanceof Uint8Array)
+  ) {
+    yield OBJECT_START;
+    for (const key of Object.keys(value)) {
+      yield new ParseEvent("key", key, undefined);
+      yield* valueEvents(value[key]);
+    }
+    yield OBJECT_END;
+  } else {
+    yield new ParseEvent("scalar", "", value);
+  }
+}
+
+/**
+ * Parse a document into a stream of events, one top-level chunk at a
+ * time. Errors surface as thrown exceptions with the same messages as
+ * parseYay, at the point the offending chunk is reached.
+ *
+ * @param {string} source - UTF-8 YAY document
+ * @param {string} [filename] - Optional filename for error messages
+ * @returns {Generator<ParseEvent>}
+ */
+function* yayEvents(source, filename) {
+  const ctx = new ParseContext(filename || undefined);
+  const tokens = outlineLex(scan(source, ctx));
+  let i = 0;
+  while (
+    i < tokens.length &&
+    (tokens[i].type === "stop" || tokens[i].type === "break")
+  )
+    i++;
+  if (i >= tokens.length) {
+    parseRoot(tokens, ctx); // throws "No value found in document"
+    return;
+  }
+  const t = tokens[i];
+  if (t.type === "start" && t.text === "-" && t.indent === 0) {
+    // Root list: each item parses and emits independently.
+    yield ARRAY_START;
+    for (const chunk of rootChunks(tokens, i, "list")) {
+      const [items] = parseListArray(chunk, 0, ctx);
+      for (const item of items) yield* valueEvents(item);
+    }
+    yield ARRAY_END;
+    return;
+  }
+  if (
+    t.type === "text" &&
+    findKeyColonOutsideQuotes(t.text) >= 0 &&
+    t.indent === 0 &&
+    !t.text.startsWith("{")
+  ) {
+    // Root object: each entry parses and emits independently.
+    yield OBJECT_START;
+    for (const chunk of rootChunks(tokens, i, "object")) {
+      const [entry] = parseRootObject(chunk, 0, ctx);
+      for (const key of Object.keys(entry)) {
+        yield new ParseEvent("key", key, undefined);
+        yield* valueEvents(entry[key]);
+      }
+    }
+    yield OBJECT_END;
+    return;
+  }
+  // Single root value: one chunk either way.
+  yield* valueEvents(parseRoot(tokens, ctx));
+}
+
+/**
+ * Parse a document, delivering each event to the matching sink
+ * callback. All callbacks are optional.
+ *
+ * @param {string} source - UTF-8 YAY document
+ * @param {Object} sink
+ * @param {(value: unknown) => void} [sink.onScalar]
+ * @param {() => void} [sink.onArrayStart]
+ * @param {() => void} [sink.onArrayEnd]
+ * @param {() => void} [sink.onObjectStart]
+ * @param {(key: string) => void} [sink.onKey]
+ * @param {() => void} [sink.onObjectEnd]
+ * @param {string} [filename] - Optional filename for error messages
+ */
+function parseYayEvents(source, sink, filename) {
+  for (const event of yayEvents(source, filename)) {
+    switch (event.type) {
+      case "scalar":
+        if (sink.onScalar) sink.onScalar(event.value);
+        break;
+      case "arrayStart":
+        if (sink.onArrayStart) sink.onArrayStart();
+        break;
+      case "arrayEnd":
+        if (sink.onArrayEnd) sink.onArrayEnd();
+        break;
+      case "objectStart":
+        if (sink.onObjectStart) sink.onObjectStart();
+        break;
+      case "key":
+        if (sink.onKey) sink.onKey(event.key);
+        break;
+      case "objectEnd":
+        if (sink.onObjectEnd) sink.onObjectEnd();
+        break;
+    }
+  }
+}
+
+/**
+ * Render one scalar as JSON text.
+ * @param {unknown} value
+ * @returns {string}
+ */
+function scalarJson(value) {
+  if (value === null || value === undefined) return "null";
+  if (typeof value === "boolean") return value ? "true" : "false";
+  if (typeof value === "bigint") return value.toString();
+  if (typeof value === "number") {
+    return Number.isFinite(value) ? String(value) : "null";
+  }
+  if (typeof value === "string") return JSON.stringify(value);
+  return "null"; // bytes
+}
+
+/**
+ * Fold events into JSON text fragments with commas and colons.
+ * @param {Generator<ParseEvent>} events
+ * @returns {Generator<string>}
+ */
+function* jsonPieces(events) {
+  // counts[d] = values already written in the container at depth d.
+  const counts = [];
+  let afterKey = false;
+  const lead = () => {
+    if (afterKey) {
+      afterKey = false;
+      return "";
+    }
+    if (counts.length === 0) return "";
+    return counts[counts.length - 1]++ === 0 ? "" : ",";
+  };
+  for (const event of events) {
+    switch (event.type) {
+      case "scalar":
+        yield lead() + scalarJson(event.value);
+        break;
+      case "arrayStart":
+        yield lead() + "[";
+        counts.push(0);
+        break;
+      case "arrayEnd":
+        counts.pop();
+        yield "]";
+        break;
+      case "objectStart":
+        yield lead() + "{";
+        counts.push(0);
+        break;
+      case "key":
+        yield lead() + JSON.stringify(event.key) + ":";
+        afterKey = true;
+        break;
+      case "objectEnd":
+        counts.pop();
+        yield "}";
+        break;
+    }
+  }
+  yield "\n";
+}
+
+// Fragments coalesce to this size before reaching the stream, so
+// pipeline overhead is per buffer, not per event.
+const JSON_BUFFER_SIZE = 64 * 1024;
+
+/**
+ * @param {string} source
+ * @param {string=} filename
+ * @returns {Generator<string>}
+ */
+function* jsonText(source, filename) {
+  let buffer = "";
+  for (const piece of jsonPieces(yayEvents(source, filename))) {
+    buffer += piece;
+    if (buffer.length >= JSON_BUFFER_SIZE) {
+      yield buffer;
+      buffer = "";
+    }
+  }
+  if (buffer.length > 0) yield buffer;
+}
+
+/**
+ * Convert a document to compact JSON as a Readable stream. The
+ * generator underneath is pulled on demand, so piping into a slow
+ * Writable parses no further than the consumer has asked for.
+ *
+ * @param {string} source - UTF-8 YAY document
+ * @param {string} [filename] - Optional filename for error messages
+ * @returns {import("node:stream").Readable}
+ */
+function toJsonStream(source, filename) {
+  return Readable.from(jsonText(source, filename));
+}
+
+export { parseYayEvents, yayEvents, toJsonStream };
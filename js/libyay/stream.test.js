@@ -0,0 +1,120 @@
+import { describe, it } from "node:test";
+import assert from "node:assert";
+import fs from "fs";
+import path from "path";
+import { fileURLToPath } from "node:url";
+
+import { parseYay } from "./yay.js";
+import { parseYayEvents, toJsonStream } from "./stream.js";
+
+const __dirname = path.dirname(fileURLToPath(import.meta.url));
+const yayDir = path.join(__dirname, "..", "..", "test", "yay");
+
+/** Rebuild the value tree from events, for parity with parseYay. */
+function parseViaEvents(source) {
+  let root;
+  const containers = [];
+  const keys = [];
+  const put = (value) => {
+    if (containers.length === 0) {
+      root = value;
+    } else {
+      const top = containers[containers.length - 1];
+      if (Array.isArray(top)) top.push(value);
+      else top[keys.pop()] = value;
+    }
+  };
+  parseYayEvents(source, {
+    onScalar: put,
+    onArrayStart: () => containers.push([]),
+    onArrayEnd: () => put(containers.pop()),
+    onObjectStart: () => containers.push({}),
+    onKey: (key) => keys.push(key),
+    onObjectEnd: () => put(containers.pop()),
+  });
+  return root;
+}
+
+async function collectJson(source) {
+  let out = "";
+  for await (const chunk of toJsonStream(source)) {
+    out += chunk;
+  }
+  return out;
+}
+
+describe("parseYayEvents", () => {
+  it("reports scalar and container boundaries in document order", () => {
+    const trace = [];
+    parseYayEvents("a: 1\nb:\n- true\n- \"x\"\n", {
+      onScalar: (v) => trace.push(["scalar", v]),
+      onArrayStart: () => trace.push(["arrayStart"]),
+      onArrayEnd: () => trace.push(["arrayEnd"]),
+      onObjectStart: () => trace.push(["objectStart"]),
+      onKey: (k) => trace.push(["key", k]),
+      onObjectEnd: () => trace.push(["objectEnd"]),
+    });
+    assert.deepStrictEqual(trace, [
+      ["objectStart"],
+      ["key", "a"],
+      ["scalar", 1n],
+      ["key", "b"],
+      ["arrayStart"],
+      ["scalar", true],
+      ["scalar", "x"],
+      ["arrayEnd"],
+      ["objectEnd"],
+    ]);
+  });
+
+  it("rebuilds every valid fixture to the batch parser's value", () => {
+    const yayFiles = fs.readdirSync(yayDir).filter((f) => f.endsWith(".yay"));
+    for (const file of yayFiles) {
+      const source = fs.readFileSync(path.join(yayDir, file), "utf8");
+      assert.deepStrictEqual(
+        parseViaEvents(source),
+        parseYay(source),
+        `fixture ${file}`,
+      );
+    }
+  });
+
+  it("throws the batch parser's message for invalid chunks", () => {
+    assert.throws(
+      () => parseYayEvents("a: nope\n", {}, "bad.yay"),
+      /Unexpected character "n".*bad\.yay/,
+    );
+  });
+});
+
+describe("toJsonStream", () => {
+  it("streams a root object as compact JSON", async () => {
+    const json = await collectJson(
+      'name: "yay"\ncount: 3\nitems:\n- 1.5\n- null\n- [true, false]\n',
+    );
+    assert.deepStrictEqual(JSON.parse(json), {
+      name: "yay",
+      count: 3,
+      items: [1.5, null, [true, false]],
+    });
+  });
+
+  it("streams a root list item by item", async () => {
+    const json = await collectJson('- "a"\n- "b"\n- c: 1\n');
+    assert.deepStrictEqual(JSON.parse(json), ["a", "b", { c: 1 }]);
+  });
+
+  it("renders bytes and non-finite numbers as null", async () => {
+    const json = await collectJson("bytes: <0102>\nbad: nan\n");
+    assert.strictEqual(json, '{"bytes":null,"bad":null}\n');
+  });
+
+  it("renders integers as bare decimal literals", async () => {
+    const json = await collectJson("big: 123456789012345678901234567890\n");
+    assert.strictEqual(json, '{"big":123456789012345678901234567890}\n');
+  });
+
+  it("surfaces parse errors as stream errors", async () => {
+    await assert.rejects(collectJson(": nope\n"), /Missing key/);
+  });
+});
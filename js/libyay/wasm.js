@@ -0,0 +1,211 @@
+"use strict";
+
+/**
+ * WebAssembly-backed parseYay with a pure-JavaScript fallback.
+ *
+ * When a `yay.wasm` module (built from the C parser with `make -C c wasm`)
+ * sits next to this file — or at the path named by the YAY_WASM environment
+ * variable — documents are parsed by the C core through its linear-memory
+ * accessor layer. When the module is missing or fails to instantiate, the
+ * pure-JS parser in yay.js takes over, so importing this module is always
+ * safe.
+ */
+
+import { readFileSync } from "node:fs";
+import { parseYay as parseYayJs } from "./yay.js";
+
+const TYPE_NULL = 0;
+const TYPE_BOOL = 1;
+const TYPE_INT = 2;
+const TYPE_FLOAT = 3;
+const TYPE_STRING = 4;
+const TYPE_BYTES = 5;
+const TYPE_ARRAY = 6;
+const TYPE_OBJECT = 7;
+
+const decoder = new TextDecoder();
+const encoder = new TextEncoder();
+
+/**
+ * Instantiate yay.wasm if it can be found.
+ * @returns {Promise<WebAssembly.Instance | null>}
+ */
+async function loadWasm() {
+  let bytes;
+  try {
+    const path = process.env.YAY_WASM || new URL("./yay.wasm", import.meta.url);
+    bytes = readFileSync(path);
+  } catch (_error) {
+    return null;
+  }
+  try {
+    // Standalone emscripten modules import a handful of WASI calls for
+    // stdio and clocks; none matter for parsing, so stub them all.
+    const wasiStubs = new Proxy(
+      {},
+      {
+        get: () => () => 0,
+      },
+    );
+    const { instance } = await WebAssembly.instantiate(bytes, {
+      wasi_snapshot_preview1: wasiStubs,
+      env: wasiStubs,
+    });
+    if (instance.exports._initialize) {
+      instance.exports._initialize();
+    }
+    return instance;
+  } catch (_error) {
+    return null;
+  }
+}
+
+const instance = await loadWasm();
+
+/**
+ * Read a NUL-terminated UTF-8 string out of linear memory.
+ * @param {WebAssembly.Exports} exports
+ * @param {number} pointer
+ * @param {number} length
+ * @returns {string}
+ */
+function readString(exports, pointer, length) {
+  return decoder.decode(new Uint8Array(exports.memory.buffer, pointer, length));
+}
+
+/**
+ * Convert a yay_value_t pointer into the corresponding JavaScript value,
+ * walking the tree through the accessor exports.
+ * @param {WebAssembly.Exports} exports
+ * @param {number} value - yay_value_t pointer in linear memory
+ * @returns {unknown}
+ */
+function convertValue(exports, value) {
+  switch (exports.yayw_type(value)) {
+    case TYPE_NULL:
+      return null;
+    case TYPE_BOOL:
+      return exports.yayw_bool(value) !== 0;
+    case TYPE_INT: {
+      const text = exports.yayw_int_text(value);
+      const result = BigInt(
+        readString(exports, text, cStringLength(exports, text)),
+      );
+      exports.yayw_free(text);
+      return result;
+    }
+    case TYPE_FLOAT:
+      return exports.yayw_float(value);
+    case TYPE_STRING:
+      return readString(
+        exports,
+        exports.yayw_string(value),
+        exports.yayw_string_length(value),
+      );
+    case TYPE_BYTES:
+      return new Uint8Array(
+        exports.memory.buffer,
+        exports.yayw_bytes(value),
+        exports.yayw_bytes_length(value),
+      ).slice();
+    case TYPE_ARRAY: {
+      const length = exports.yayw_array_length(value);
+      const array = [];
+      for (let i = 0; i < length; i++) {
+        array.push(convertValue(exports, exports.yayw_array_item(value, i)));
+      }
+      return array;
+    }
+    case TYPE_OBJECT: {
+      const length = exports.yayw_object_length(value);
+      const object = {};
+      for (let i = 0; i < length; i++) {
+        const key = exports.yayw_object_key(value, i);
+        object[readString(exports, key, cStringLength(exports, key))] =
+          convertValue(exports, exports.yayw_object_value(value, i));
+      }
+      return object;
+    }
+    default:
+      throw new Error("Unknown YAY value type");
+  }
+}
+
+/**
+ * Length of a NUL-terminated string in linear memory.
+ * @param {WebAssembly.Exports} exports
+ * @param {number} pointer
+ * @returns {number}
+ */
+function cStringLength(exports, pointer) {
+  const memory = new Uint8Array(exports.memory.buffer);
+  let end = pointer;
+  while (memory[end] !== 0) end++;
+  return end - pointer;
+}
+
+/**
+ * Parse a YAY document through the wasm core.
+ * @param {string} source - UTF-8 YAY document
+ * @param {string} [filename] - Optional filename for error messages
+ * @returns {unknown}
+ */
+function parseYayWasm(source, filename) {
+  const exports = instance.exports;
+  const sourceBytes = encoder.encode(source);
+  const nameBytes = encoder.encode(filename || "");
+
+  const sourcePointer = exports.yayw_alloc(sourceBytes.length + 1);
+  const namePointer = filename ? exports.yayw_alloc(nameBytes.length + 1) : 0;
+  const memory = new Uint8Array(exports.memory.buffer);
+  memory.set(sourceBytes, sourcePointer);
+  memory[sourcePointer + sourceBytes.length] = 0;
+  if (filename) {
+    memory.set(nameBytes, namePointer);
+    memory[namePointer + nameBytes.length] = 0;
+  }
+
+  const result = exports.yayw_parse(
+    sourcePointer,
+    sourceBytes.length,
+    namePointer,
+  );
+  try {
+    const message = exports.yayw_error_message(result);
+    if (message !== 0) {
+      throw new Error(
+        readString(exports, message, cStringLength(exports, message)),
+      );
+    }
+    return convertValue(exports, exports.yayw_result_value(result));
+  } finally {
+    exports.yayw_result_free(result);
+    exports.yayw_free(sourcePointer);
+    if (namePointer) exports.yayw_free(namePointer);
+  }
+}
+
+/**
+ * Whether the wasm core is backing parseYay.
+ * @returns {boolean}
+ */
+function isWasmBacked() {
+  return instance !== null;
+}
+
+/**
+ * Parses a YAY document string and returns the corresponding JavaScript
+ * value, using the wasm core when available and the pure-JS parser
+ * otherwise.
+ * @param {string} source - UTF-8 YAY document
+ * @param {string} [filename] - Optional filename for error messages
+ * @returns {unknown} - Parsed value (null, bigint, number, boolean, string, Array, object, Uint8Array)
+ */
+function parseYay(source, filename) {
+  if (instance !== null) {
+    return parseYayWasm(source, filename);
+  }
+  return parseYayJs(source, filename);
+}
+
+export { parseYay, isWasmBacked };
@@ -0,0 +1,30 @@
+import { describe, it } from "node:test";
+import assert from "node:assert";
+
+import { parseYay, isWasmBacked } from "./wasm.js";
+import { parseYay as parseYayJs } from "./yay.js";
+
+describe("wasm-backed parseYay", () => {
+  it("reports which backend is active", () => {
+    assert.strictEqual(typeof isWasmBacked(), "boolean");
+  });
+
+  it("parses scalars and containers", () => {
+    const source =
+      'name: "server"\n' +
+      "port: 8080\n" +
+      "ratio: 0.5\n" +
+      "enabled: true\n" +
+      "tags: [1, 2, 3]\n";
+    assert.deepStrictEqual(parseYay(source), parseYayJs(source));
+  });
+
+  it("parses byte arrays", () => {
+    const source = "blob: <deadbeef>\n";
+    assert.deepStrictEqual(parseYay(source), parseYayJs(source));
+  });
+
+  it("throws on invalid documents", () => {
+    assert.throws(() => parseYay("key: @\n", "bad.yay"));
+  });
+});
@@ -7,7 +7,7 @@
  * @returns {unknown} - Parsed value (null, bigint, number, boolean, string, Array, object, Uint8Array)
  */
 function parseYay(source, filename) {
-  const ctx = { filename: filename || undefined };
+  const ctx = new ParseContext(filename || undefined);
   const lines = scan(source, ctx);
   const tokens = outlineLex(lines);
   return parseRoot(tokens, ctx);
@@ -44,6 +44,8 @@ function isAllowedCodePoint(cp) {
  * @returns {string}
  */
 function stripInlineComment(s) {
+  // Comment-free lines need no quote tracking.
+  if (s.indexOf("#") < 0) return s;
   let inDouble = false;
   let inSingle = false;
   let escape = false;
@@ -69,44 +71,100 @@ function stripInlineComment(s) {
   return s;
 }
 
-/**
- * @typedef {Object} ParseContext
- * @property {string=} filename
- */
+// The scanner, lexer, and parser allocate these three shapes on every
+// hot path. Fixed-shape classes whose constructors assign every field
+// keep the hidden class stable, so property loads in scan, outlineLex,
+// and parseValue stay monomorphic instead of degrading as optional
+// fields appear and disappear.
 
-/**
- * @typedef {Object} ScanLine
- * @property {string} line
- * @property {number} indent
- * @property {string} leader
- * @property {number} lineNum
- */
-/**
- * @typedef {Object} Token
- * @property {'start'|'stop'|'text'|'break'} type
- * @property {string} text
- * @property {number=} indent
- * @property {number=} lineNum
- * @property {number=} col
- */
+/** Parse-time options and error-message context. */
+class ParseContext {
+  /** @param {string=} filename */
+  constructor(filename) {
+    this.filename = filename;
+  }
+}
+
+// Shared default for internal entry points called without a context, so
+// the `ctx.filename` load sees one shape whether or not a caller
+// supplied a filename.
+const EMPTY_CONTEXT = new ParseContext(undefined);
+
+/** One scanned line: payload text, indent, list/bytes leader, position. */
+class ScanLine {
+  /**
+   * @param {string} line
+   * @param {number} indent
+   * @param {string} leader
+   * @param {number} lineNum
+   */
+  constructor(line, indent, leader, lineNum) {
+    this.line = line;
+    this.indent = indent;
+    this.leader = leader;
+    this.lineNum = lineNum;
+  }
+}
+
+/** One outline token; stop and break tokens carry zeroed positions. */
+class Token {
+  /**
+   * @param {'start'|'stop'|'text'|'break'} type
+   * @param {string} text
+   * @param {number} indent
+   * @param {number} lineNum
+   * @param {number} col
+   */
+  constructor(type, text, indent, lineNum, col) {
+    this.type = type;
+    this.text = text;
+    this.indent = indent;
+    this.lineNum = lineNum;
+    this.col = col;
+  }
+}
+
+// Character classes for 7-bit code points, consulted with one table
+// load instead of chained range comparisons. Out-of-range indices read
+// undefined, which masks to zero.
+const CC_DIGIT = 1 << 0;
+const CC_HEX = 1 << 1;
+const CC_KEY = 1 << 2;
+const CHAR_CLASS = new Uint8Array(128);
+for (let c = 0x30; c <= 0x39; c++) CHAR_CLASS[c] = CC_DIGIT | CC_HEX | CC_KEY;
+for (let c = 0x41; c <= 0x46; c++) CHAR_CLASS[c] |= CC_HEX;
+for (let c = 0x61; c <= 0x66; c++) CHAR_CLASS[c] |= CC_HEX;
+for (let c = 0x41; c <= 0x5a; c++) CHAR_CLASS[c] |= CC_KEY;
+for (let c = 0x61; c <= 0x7a; c++) CHAR_CLASS[c] |= CC_KEY;
+CHAR_CLASS[0x5f] |= CC_KEY; // _
+CHAR_CLASS[0x2d] |= CC_KEY; // -
 
 // --- Scanner: source -> lines with { line, indent, leader, lineNum } ---
 
 /**
  * @param {string} source
  * @param {ParseContext} ctx
+ * @param {number} [lineOffset] - Line number of the first line of source,
+ *   so chunks rescanned by the incremental tokenizer report absolute
+ *   positions.
  * @returns {ScanLine[]}
  */
-function scan(source, ctx = {}) {
+function scan(source, ctx = EMPTY_CONTEXT, lineOffset = 0) {
   if (source.length >= 1 && source.charCodeAt(0) === 0xfeff) {
-    throw new Error("Illegal BOM" + locSuffix(ctx, 0, 0));
+    throw new Error("Illegal BOM" + locSuffix(ctx, lineOffset, 0));
   }
   // Validate all code points.
   {
-    let line = 0;
+    let line = lineOffset;
     let col = 0;
     for (let i = 0; i < source.length; i++) {
       const c = source.charCodeAt(i);
+      // Printable ASCII is the common case; everything else takes the
+      // full classification below.
+      if (c >= 0x20 && c <= 0x7e) {
+        col++;
+        continue;
+      }
       let cp = c;
       // Decode surrogate pairs to get the actual code point.
       if (c >= 0xd800 && c <= 0xdbff) {
@@ -153,58 +211,57 @@ function scan(source, ctx = {}) {
       }
     }
   }
+  // Single forward pass: lines are sliced at indexOf-found newlines and
+  // classified with charCodeAt, no regexes.
   const lines = [];
-  const lineStrings = source.split(/\n/);
-  for (let i = 0; i < lineStrings.length; i++) {
-    const lineStr = lineStrings[i];
+  let lineStart = 0;
+  for (let i = 0; lineStart <= source.length; i++) {
+    let nl = source.indexOf("\n", lineStart);
+    if (nl < 0) nl = source.length;
+    const lineStr = source.slice(lineStart, nl);
+    lineStart = nl + 1;
+    const n = i + lineOffset;
     if (lineStr.length > 0 && lineStr.charCodeAt(lineStr.length - 1) === 0x20) {
       throw new Error(
-        "Unexpected trailing space" + locSuffix(ctx, i, lineStr.length - 1),
+        "Unexpected trailing space" + locSuffix(ctx, n, lineStr.length - 1),
       );
     }
     let indent = 0;
-    while (indent < lineStr.length && lineStr[indent] === " ") {
+    while (indent < lineStr.length && lineStr.charCodeAt(indent) === 0x20) {
       indent++;
     }
-    const rest = lineStr.slice(indent);
-    if (rest.startsWith("#") && indent === 0) {
+    const rest = indent === 0 ? lineStr : lineStr.slice(indent);
+    const first = rest.charCodeAt(0); // NaN for blank lines
+    if (first === 0x23 && indent === 0) {
       continue; // comment only at column 0
     }
     // leader identifies list/bytes syntax while preserving the line payload.
     let leader = "";
     let line = rest;
-    if (rest.startsWith("- ")) {
-      leader = "-";
-      line = rest.slice(2);
-    } else if (rest === "-") {
-      // Bare "-" without space is invalid - must be "- " followed by value
-      throw new Error(
-        'Expected space after "-"' + locSuffix(ctx, i, indent + 1),
-      );
-    } else if (rest.match(/^-\.?\d/)) {
-      leader = "";
-      line = rest;
-    } else if (rest === "-infinity") {
-      leader = "";
-      line = rest;
-    } else if (
-      rest.length >= 2 &&
-      rest[0] === "-" &&
-      rest[1] !== " " &&
-      rest[1] !== "." &&
-      !/^\d/.test(rest[1])
-    ) {
-      // Compact list syntax (-value without space) is not allowed
-      throw new Error(
-        'Expected space after "-"' + locSuffix(ctx, i, indent + 1),
-      );
+    if (first === 0x2d) {
+      const second = rest.charCodeAt(1); // NaN for bare "-"
+      if (second === 0x20) {
+        leader = "-";
+        line = rest.slice(2);
+      } else if (
+        second !== 0x2e &&
+        (CHAR_CLASS[second] & CC_DIGIT) === 0 &&
+        rest !== "-infinity"
+      ) {
+        // Bare "-" and compact list syntax (-value without space) are
+        // invalid - must be "- " followed by value. Negative numbers
+        // ("-5", "-.5") and -infinity pass through as scalars.
+        throw new Error(
+          'Expected space after "-"' + locSuffix(ctx, n, indent + 1),
+        );
+      }
     } else if (
-      rest === "*" ||
-      (rest.length >= 2 && rest[0] === "*" && rest[1] === " ")
+      first === 0x2a &&
+      (rest.length === 1 || rest.charCodeAt(1) === 0x20)
     ) {
-      throw new Error('Unexpected character "*"' + locSuffix(ctx, i, indent));
+      throw new Error('Unexpected character "*"' + locSuffix(ctx, n, indent));
     }
-    lines.push({ line, indent, leader, lineNum: i });
+    lines.push(new ScanLine(line, indent, leader, n));
   }
   return lines;
 }
@@ -223,42 +280,30 @@ function outlineLex(lines) {
   for (const { line, indent, leader, lineNum } of lines) {
     // Close blocks on dedent.
     while (indent < top) {
-      tokens.push({ type: "stop", text: "" });
+      tokens.push(new Token("stop", "", 0, 0, 0));
       stack.pop();
       top = stack[stack.length - 1];
     }
     if (leader.length > 0 && indent > top) {
-      tokens.push({
-        type: "start",
-        text: leader,
-        indent,
-        lineNum,
-        col: indent,
-      });
+      tokens.push(new Token("start", leader, indent, lineNum, indent));
       stack.push(indent);
       top = indent;
       broken = false;
     } else if (leader.length > 0 && indent === top) {
-      tokens.push({ type: "stop", text: "" });
-      tokens.push({
-        type: "start",
-        text: leader,
-        indent,
-        lineNum,
-        col: indent,
-      });
+      tokens.push(new Token("stop", "", 0, 0, 0));
+      tokens.push(new Token("start", leader, indent, lineNum, indent));
       broken = false;
     }
     if (line.length > 0) {
-      tokens.push({ type: "text", text: line, indent, lineNum, col: indent });
+      tokens.push(new Token("text", line, indent, lineNum, indent));
       broken = false;
     } else if (!broken) {
-      tokens.push({ type: "break", text: "", lineNum, col: indent });
+      tokens.push(new Token("break", "", 0, lineNum, indent));
       broken = true;
     }
   }
   while (stack.length > 1) {
-    tokens.push({ type: "stop", text: "" });
+    tokens.push(new Token("stop", "", 0, 0, 0));
     stack.pop();
   }
   return tokens;
@@ -271,7 +316,7 @@ function outlineLex(lines) {
  * @param {ParseContext} ctx
  * @returns {unknown}
  */
-function parseRoot(tokens, ctx = {}) {
+function parseRoot(tokens, ctx = EMPTY_CONTEXT) {
   let i = 0;
   while (
     i < tokens.length &&
@@ -305,7 +350,7 @@ function parseRoot(tokens, ctx = {}) {
   return ensureAtEnd(value, tokens, next, ctx);
 }
 
-function ensureAtEnd(value, tokens, i, ctx = {}) {
+function ensureAtEnd(value, tokens, i, ctx = EMPTY_CONTEXT) {
   let j = i;
   while (
     j < tokens.length &&
@@ -332,7 +377,7 @@ function ensureAtEnd(value, tokens, i, ctx = {}) {
  * @param {ParseContext} ctx
  * @returns {[unknown, number]}
  */
-function parseValue(tokens, i, ctx = {}) {
+function parseValue(tokens, i, ctx = EMPTY_CONTEXT) {
   const t = tokens[i];
   if (t.type === "text") {
     if (t.text.startsWith(" ")) {
@@ -481,12 +526,7 @@ function splitKeyValue(s, sCol, ctx, lineNum, inlineCol) {
       throw new Error("Missing key" + locSuffix(ctx, lineNum, sCol + colonIdx));
     }
     for (let i = 0; i < keyRaw.length; i++) {
-      const c = keyRaw[i];
-      const isAlpha = (c >= "a" && c <= "z") || (c >= "A" && c <= "Z");
-      const isDigit = c >= "0" && c <= "9";
-      const isUnderscore = c === "_";
-      const isHyphen = c === "-";
-      if (!isAlpha && !isDigit && !isUnderscore && !isHyphen) {
+      if ((CHAR_CLASS[keyRaw.charCodeAt(i)] & CC_KEY) === 0) {
         // First character invalid = "Invalid key", subsequent = "Invalid key character"
         const errMsg = i === 0 ? "Invalid key" : "Invalid key character";
         // For inline objects, report column of opening brace; otherwise report character position
@@ -522,6 +562,13 @@ function splitKeyValue(s, sCol, ctx, lineNum, inlineCol) {
  * @returns {number}
  */
 function findKeyColonOutsideQuotes(s) {
+  // Escapes only matter inside quotes, so when no quote precedes the
+  // first colon the answer is just that colon.
+  const colon = s.indexOf(":");
+  if (colon < 0) return -1;
+  const dq = s.indexOf('"');
+  const sq = s.indexOf("'");
+  if ((dq < 0 || dq > colon) && (sq < 0 || sq > colon)) return colon;
   let inSingle = false;
   let inDouble = false;
   let escape = false;
@@ -581,7 +628,7 @@ function isPropertyBlockLeaderOnly(valuePart, leader) {
  * @param {number} col
  * @returns {Record<string, unknown>|null}
  */
-function parseInlineObject(s, ctx = {}, lineNum = 0, col = 0) {
+function parseInlineObject(s, ctx = EMPTY_CONTEXT, lineNum = 0, col = 0) {
   if (!s.startsWith("{")) return null;
   if (!s.includes("}")) {
     return null;
@@ -702,7 +749,7 @@ function parseInlineObject(s, ctx = {}, lineNum = 0, col = 0) {
  * @param {number} col
  * @returns {unknown}
  */
-function parseScalar(s, ctx = {}, lineNum = 0, col = 0) {
+function parseScalar(s, ctx = EMPTY_CONTEXT, lineNum = 0, col = 0) {
   // Strip inline comments first
   s = stripInlineComment(s);
 
@@ -751,14 +798,17 @@ function parseScalar(s, ctx = {}, lineNum = 0, col = 0) {
  * @param {number} col
  * @returns {number|bigint|undefined}
  */
-function parseNumber(s, ctx = {}, lineNum = 0, col = 0) {
+function parseNumber(s, ctx = EMPTY_CONTEXT, lineNum = 0, col = 0) {
   // Check for uppercase E in exponent (must be lowercase)
   // Only check if this looks like a number (starts with digit, minus, or dot)
-  const firstNonSpace = s.replace(/^ */, "")[0];
+  let firstNonSpaceIdx = 0;
+  while (firstNonSpaceIdx < s.length && s.charCodeAt(firstNonSpaceIdx) === 0x20)
+    firstNonSpaceIdx++;
+  const firstNonSpace = s.charCodeAt(firstNonSpaceIdx); // NaN when all spaces
   if (
-    (firstNonSpace >= "0" && firstNonSpace <= "9") ||
-    firstNonSpace === "-" ||
-    firstNonSpace === "."
+    (CHAR_CLASS[firstNonSpace] & CC_DIGIT) !== 0 ||
+    firstNonSpace === 0x2d ||
+    firstNonSpace === 0x2e
   ) {
     const eIdx = s.indexOf("E");
     if (eIdx >= 0) {
@@ -772,35 +822,35 @@ function parseNumber(s, ctx = {}, lineNum = 0, col = 0) {
   let hasDigit = false;
   let hasExponent = false;
   for (let i = 0; i < s.length; i++) {
-    const c = s[i];
-    if (c === " ") continue;
-    if (c >= "0" && c <= "9") {
+    const c = s.charCodeAt(i);
+    if (c === 0x20) continue;
+    if ((CHAR_CLASS[c] & CC_DIGIT) !== 0) {
       hasDigit = true;
       continue;
     }
-    if (c === ".") continue;
-    if (c === "-" && i === 0) continue;
+    if (c === 0x2e) continue;
+    if (c === 0x2d && i === 0) continue;
     // Allow 'e' for exponent notation (E already rejected above)
-    if (c === "e" && hasDigit && !hasExponent) {
+    if (c === 0x65 && hasDigit && !hasExponent) {
       hasExponent = true;
       continue;
     }
     // Allow +/- after exponent
-    if ((c === "+" || c === "-") && hasExponent) {
-      const prev = i > 0 ? s[i - 1] : "";
-      if (prev === "e") continue;
+    if ((c === 0x2b || c === 0x2d) && hasExponent) {
+      if (i > 0 && s.charCodeAt(i - 1) === 0x65) continue;
     }
     // Not a numeric candidate.
     return undefined;
   }
   if (!hasDigit) return undefined;
   for (let i = 0; i < s.length; i++) {
-    if (s[i] !== " ") continue;
-    const prev = i > 0 ? s[i - 1] : "";
-    const next = i + 1 < s.length ? s[i + 1] : "";
-    const isDigitPrev = prev >= "0" && prev <= "9";
-    const isDigitNext = next >= "0" && next <= "9";
-    if (!(isDigitPrev && isDigitNext)) {
+    if (s.charCodeAt(i) !== 0x20) continue;
+    const prev = i > 0 ? s.charCodeAt(i - 1) : 0;
+    const next = i + 1 < s.length ? s.charCodeAt(i + 1) : 0;
+    if (
+      (CHAR_CLASS[prev] & CC_DIGIT) === 0 ||
+      (CHAR_CLASS[next] & CC_DIGIT) === 0
+    ) {
       throw new Error(
         "Unexpected space in number" + locSuffix(ctx, lineNum, col + i),
       );
@@ -826,7 +876,7 @@ function parseNumber(s, ctx = {}, lineNum = 0, col = 0) {
  * @param {number} col
  * @returns {string}
  */
-function parseQuotedString(s, ctx = {}, lineNum = 0, col = 0) {
+function parseQuotedString(s, ctx = EMPTY_CONTEXT, lineNum = 0, col = 0) {
   if (s.startsWith('"')) return parseJsonQuotedString(s, ctx, lineNum, col);
   if (s.startsWith("'")) return s.slice(1, -1);
   return s;
@@ -840,7 +890,7 @@ function parseQuotedString(s, ctx = {}, lineNum = 0, col = 0) {
  * @param {number} col
  * @returns {string}
  */
-function parseJsonQuotedString(s, ctx = {}, lineNum = 0, col = 0) {
+function parseJsonQuotedString(s, ctx = EMPTY_CONTEXT, lineNum = 0, col = 0) {
   if (s.length < 2 || s[0] !== '"') return s;
   if (s[s.length - 1] !== '"') {
     const index = Math.max(0, s.length - 1);
@@ -925,17 +975,14 @@ function parseJsonQuotedString(s, ctx = {}, lineNum = 0, col = 0) {
               "Bad Unicode escape" + locSuffix(ctx, lineNum, braceCol),
             );
           }
-          let hex = "";
           for (let j = hexStart; j < braceEnd; j++) {
-            const c = s[j];
-            if (!/[0-9a-fA-F]/.test(c)) {
+            if ((CHAR_CLASS[s.charCodeAt(j)] & CC_HEX) === 0) {
               throw new Error(
                 "Bad Unicode escape" + locSuffix(ctx, lineNum, braceCol),
               );
             }
-            hex += c;
           }
-          const code = parseInt(hex, 16);
+          const code = parseInt(s.slice(hexStart, braceEnd), 16);
           if (code >= 0xd800 && code <= 0xdfff) {
             throw new Error(
               "Illegal surrogate" + locSuffix(ctx, lineNum, braceCol),
@@ -977,7 +1024,7 @@ function parseJsonQuotedString(s, ctx = {}, lineNum = 0, col = 0) {
  * @param {number} col
  * @returns {unknown[]}
  */
-function parseInlineArray(s, ctx = {}, lineNum = 0, col = 0) {
+function parseInlineArray(s, ctx = EMPTY_CONTEXT, lineNum = 0, col = 0) {
   if (!s.startsWith("[")) return [];
   if (!s.endsWith("]")) {
     throw new Error("Unterminated inline array" + locSuffix(ctx, lineNum, col));
@@ -1098,7 +1145,7 @@ function parseInlineArray(s, ctx = {}, lineNum = 0, col = 0) {
  * @param {number} lineNum
  * @param {number} col
  */
-function validateInlineArrayWhitespace(s, ctx = {}, lineNum = 0, col = 0) {
+function validateInlineArrayWhitespace(s, ctx = EMPTY_CONTEXT, lineNum = 0, col = 0) {
   let inSingle = false;
   let inDouble = false;
   let escape = false;
@@ -1224,7 +1271,7 @@ function validateInlineArrayWhitespace(s, ctx = {}, lineNum = 0, col = 0) {
  * @param {number} col
  * @returns {Uint8Array}
  */
-function parseAngleBytes(s, ctx = {}, lineNum = 0, col = 0) {
+function parseAngleBytes(s, ctx = EMPTY_CONTEXT, lineNum = 0, col = 0) {
   if (!s.endsWith(">")) {
     throw new Error("Unmatched angle bracket" + locSuffix(ctx, lineNum, col));
   }
@@ -1251,27 +1298,79 @@ function parseAngleBytes(s, ctx = {}, lineNum = 0, col = 0) {
       );
     }
   }
-  const hex = inner.replace(/\s/g, "");
-  if (hex.length % 2 !== 0)
+  return decodeHexSegments([inner], false, ctx, lineNum, col);
+}
+
+// Hex digit values indexed by char code; -1 for non-digits. Uppercase
+// digits also resolve here, for the block form that folds case.
+const HEX_VALUE = new Int8Array(256).fill(-1);
+for (let i = 0; i < 10; i++) HEX_VALUE[0x30 + i] = i;
+for (let i = 0; i < 6; i++) {
+  HEX_VALUE[0x61 + i] = 10 + i;
+  HEX_VALUE[0x41 + i] = 10 + i;
+}
+
+/**
+ * Whether a char code counts as whitespace between hex digits,
+ * matching the \s class previously used to strip separators.
+ * @param {number} code
+ * @returns {boolean}
+ */
+function isHexSpace(code) {
+  if (code === 0x20) return true;
+  if (code < 0x80) return code >= 0x09 && code <= 0x0d;
+  return /\s/.test(String.fromCharCode(code));
+}
+
+/**
+ * Decode hex digit segments directly into one pre-sized Uint8Array,
+ * skipping whitespace separators, with no intermediate strings.
+ * @param {string[]} segments
+ * @param {boolean} foldCase - Accept uppercase digits (block form)
+ * @param {ParseContext} ctx
+ * @param {number} lineNum
+ * @param {number} col
+ * @returns {Uint8Array}
+ */
+function decodeHexSegments(segments, foldCase, ctx, lineNum, col) {
+  // First pass: count digits, so parity and validity errors keep their
+  // order (non-digit separators still count toward parity).
+  let count = 0;
+  let valid = true;
+  for (const segment of segments) {
+    for (let i = 0; i < segment.length; i++) {
+      const code = segment.charCodeAt(i);
+      if (code > 0xff || HEX_VALUE[code] < 0) {
+        if (isHexSpace(code)) continue;
+        valid = false;
+      } else if (!foldCase && code >= 0x41 && code <= 0x46) {
+        valid = false;
+      }
+      count++;
+    }
+  }
+  if (count % 2 !== 0)
     throw new Error(
       "Odd number of hex digits in byte literal" + locSuffix(ctx, lineNum, col),
     );
-  if (!/^[0-9a-f]*$/.test(hex))
+  if (!valid)
     throw new Error("Invalid hex digit" + locSuffix(ctx, lineNum, col));
-  return Uint8Array.fromHex
-    ? Uint8Array.fromHex(hex)
-    : hexToUint8Array(hex, ctx, lineNum, col);
-}
-
-function hexToUint8Array(hex, ctx, lineNum, col) {
-  const bytes = new Uint8Array(hex.length / 2);
-  for (let j = 0; j < bytes.length; j++) {
-    const pair = hex.slice(j * 2, j * 2 + 2);
-    const val = parseInt(pair, 16);
-    if (isNaN(val)) {
-      throw new Error("Invalid hex digit" + locSuffix(ctx, lineNum, col));
+  const bytes = new Uint8Array(count / 2);
+  let high = -1;
+  let at = 0;
+  for (const segment of segments) {
+    for (let i = 0; i < segment.length; i++) {
+      const code = segment.charCodeAt(i);
+      if (code > 0xff) continue;
+      const value = HEX_VALUE[code];
+      if (value < 0) continue;
+      if (high < 0) {
+        high = value;
+      } else {
+        bytes[at++] = (high << 4) | value;
+        high = -1;
+      }
     }
-    bytes[j] = val;
   }
   return bytes;
 }
@@ -1282,7 +1381,7 @@ function hexToUint8Array(hex, ctx, lineNum, col) {
  * @param {ParseContext} ctx
  * @returns {[unknown[], number]}
  */
-function parseListArray(tokens, i, ctx = {}, minIndent = -1) {
+function parseListArray(tokens, i, ctx = EMPTY_CONTEXT, minIndent = -1) {
   const arr = [];
   while (
     i < tokens.length &&
@@ -1536,7 +1635,7 @@ function parseBlockStringWithIndent(
  * @param {ParseContext} ctx
  * @returns {[string, number] | null}
  */
-function parseConcatenatedStrings(tokens, i, baseIndent, ctx = {}) {
+function parseConcatenatedStrings(tokens, i, baseIndent, ctx = EMPTY_CONTEXT) {
   const parts = [];
   const startI = i;
 
@@ -1601,7 +1700,7 @@ function isInlineBullet(text) {
  * @param {number} col
  * @returns {string}
  */
-function parseInlineBulletValue(text, ctx = {}, lineNum = 0, col = 0) {
+function parseInlineBulletValue(text, ctx = EMPTY_CONTEXT, lineNum = 0, col = 0) {
   let i = 0;
   while (i < text.length && text[i] === " ") i++;
   if (i >= text.length || text[i] !== "-") return "";
@@ -1621,7 +1720,7 @@ function parseInlineBulletValue(text, ctx = {}, lineNum = 0, col = 0) {
  * Recursively parse an inline bullet value, handling nested "- " prefixes.
  * Returns the parsed value (could be a nested array or a scalar).
  */
-function parseNestedInlineBullet(text, ctx = {}, lineNum = 0, col = 0) {
+function parseNestedInlineBullet(text, ctx = EMPTY_CONTEXT, lineNum = 0, col = 0) {
   // Check if the text itself is another inline bullet
   if (isInlineBullet(text)) {
     const innerText = parseInlineBulletValue(text, ctx, lineNum, col);
@@ -1648,17 +1747,21 @@ function parseNestedInlineBullet(text, ctx = {}, lineNum = 0, col = 0) {
  * @param {number} baseIndent
  * @returns {[Uint8Array, number]}
  */
-function parseBlockBytes(tokens, i, ctx = {}, firstLineRaw, baseIndent) {
+function parseBlockBytes(tokens, i, ctx = EMPTY_CONTEXT, firstLineRaw, baseIndent) {
   const startToken = tokens[i];
   const lineNum = startToken.lineNum ?? 0;
   const col = startToken.col ?? 0;
-  let hex = "";
+  // Collect each line's pre-comment span; the decoder skips whitespace
+  // and folds case, so lines need no per-line rewriting.
+  const segments = [];
+  const pushSegment = (text) => {
+    const comment = text.indexOf("#");
+    segments.push(comment < 0 ? text : text.slice(0, comment));
+  };
   if (firstLineRaw !== undefined) {
-    hex += firstLineRaw.replace(/#.*$/, "").replace(/\s/g, "").toLowerCase();
-    i++;
-  } else {
-    i++;
+    pushSegment(firstLineRaw);
   }
+  i++;
   while (i < tokens.length) {
     const t = tokens[i];
     if (t.type === "break") {
@@ -1666,21 +1769,13 @@ function parseBlockBytes(tokens, i, ctx = {}, firstLineRaw, baseIndent) {
       continue;
     }
     if (t.type === "text" && (t.indent ?? 0) > baseIndent) {
-      hex += t.text.replace(/#.*$/, "").replace(/\s/g, "").toLowerCase();
+      pushSegment(t.text);
       i++;
       continue;
     }
     break;
   }
-  if (hex.length % 2 !== 0)
-    throw new Error(
-      "Odd number of hex digits in byte literal" + locSuffix(ctx, lineNum, col),
-    );
-  if (!/^[0-9a-f]*$/.test(hex))
-    throw new Error("Invalid hex digit" + locSuffix(ctx, lineNum, col));
-  const result = Uint8Array.fromHex
-    ? Uint8Array.fromHex(hex)
-    : hexToUint8Array(hex, ctx, lineNum, col);
+  const result = decodeHexSegments(segments, true, ctx, lineNum, col);
   return [result, i];
 }
 
@@ -1694,7 +1789,7 @@ function parseBlockBytes(tokens, i, ctx = {}, firstLineRaw, baseIndent) {
  * @param {ParseContext} ctx
  * @returns {[Record<string, unknown>, number]}
  */
-function parseObjectOrNamedArray(tokens, i, key, ctx = {}) {
+function parseObjectOrNamedArray(tokens, i, key, ctx = EMPTY_CONTEXT) {
   const keyToken = tokens[i];
   const keyValue = splitKeyValue(
     keyToken.text,
@@ -1903,7 +1998,7 @@ function skipToNextKey(tokens, i, baseIndent) {
  * @param {number=} inlineIndent
  * @returns {[Record<string, unknown>, number]}
  */
-function parseObjectBlock(tokens, i, baseIndent, ctx = {}, inlineIndent) {
+function parseObjectBlock(tokens, i, baseIndent, ctx = EMPTY_CONTEXT, inlineIndent) {
   const obj = {};
   let firstText = true;
   while (i < tokens.length) {
@@ -2011,7 +2106,7 @@ function parseObjectBlock(tokens, i, baseIndent, ctx = {}, inlineIndent) {
  * @param {ParseContext} ctx
  * @returns {[Record<string, unknown>, number]}
  */
-function parseRootObject(tokens, i, ctx = {}) {
+function parseRootObject(tokens, i, ctx = EMPTY_CONTEXT) {
   const obj = {};
   const baseIndent = 0;
   while (i < tokens.length) {
@@ -2111,3 +2206,7 @@ function parseRootObject(tokens, i, ctx = {}) {
 }
 
 export { parseYay };
+// Phase entry points for the incremental tokenizer (see incremental.js).
+export { scan, outlineLex, parseRoot, ParseContext };
+// Internals for the streaming JSON emitter (see stream.js).
+export { parseListArray, parseRootObject, findKeyColonOutsideQuotes };
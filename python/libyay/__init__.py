@@ -4,9 +4,100 @@ YAY - Yet Another YAML
 A Python parser and serializer for the YAY data format.
 """
 
-from .parser import load, loads
+import os
+from typing import Any, Iterable, NamedTuple, TextIO
+
+from .parser import loads as _loads_python
+from .parser import iterparse
 from .dumper import dump, dumps
 from .errors import YayError, YaySyntaxError
 
-__all__ = ["load", "loads", "dump", "dumps", "YayError", "YaySyntaxError"]
+try:
+    from ._native import loads as _loads_native
+except ImportError:
+    _loads_native = None
+
+
+def loads(s: str) -> Any:
+    """Parse a YAY string into Python objects.
+
+    Uses the C extension when it is built, falling back to the
+    pure-Python parser otherwise.
+    """
+    if _loads_native is not None:
+        return _loads_native(s)
+    return _loads_python(s)
+
+
+def load(fp: TextIO) -> Any:
+    """Parse a YAY file into Python objects."""
+    return loads(fp.read())
+
+
+class FileResult(NamedTuple):
+    """One file's outcome from parse_files."""
+
+    path: str
+    value: Any
+    error: Exception | None
+
+
+def _parse_batch(paths: list[str]) -> list[FileResult]:
+    """Parse one chunk of files; runs inside a worker process."""
+    results = []
+    for path in paths:
+        try:
+            with open(path, "r", encoding="utf-8") as fp:
+                results.append(FileResult(path, loads(fp.read()), None))
+        except Exception as error:
+            results.append(FileResult(path, None, error))
+    return results
+
+
+def parse_files(
+    paths: Iterable[str], processes: int | None = None
+) -> list[FileResult]:
+    """Parse many YAY files across processes, returning results in path
+    order.
+
+    The GIL keeps one interpreter on one core, so directory-scale loads
+    fan out over a multiprocessing pool instead. Paths are handed out in
+    chunks and each worker returns a whole chunk of parsed values, so
+    pickling overhead amortizes over many small files. Failures are
+    reported per file in FileResult.error; one bad file does not stop
+    the batch.
+
+    processes caps the pool size; None uses the CPU count.
+    """
+    paths = [os.fspath(path) for path in paths]
+    if processes is None:
+        processes = os.cpu_count() or 1
+    processes = max(1, min(processes, len(paths)))
+    if processes == 1:
+        return _parse_batch(paths)
+
+    import multiprocessing
+
+    # A few chunks per worker balances stragglers against per-chunk
+    # dispatch and result pickling.
+    chunk = max(1, len(paths) // (processes * 4))
+    batches = [paths[i : i + chunk] for i in range(0, len(paths), chunk)]
+    with multiprocessing.Pool(processes) as pool:
+        results: list[FileResult] = []
+        for batch in pool.map(_parse_batch, batches):
+            results.extend(batch)
+    return results
+
+
+__all__ = [
+    "load",
+    "loads",
+    "iterparse",
+    "parse_files",
+    "FileResult",
+    "dump",
+    "dumps",
+    "YayError",
+    "YaySyntaxError",
+]
 __version__ = "1.0.0"
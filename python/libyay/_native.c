@@ -0,0 +1,130 @@
+/*
+ * Native CPython binding for the C parser in c/yay.c.
+ *
+ * Exposes a single loads(s) that parses through libyay and converts the
+ * resulting yay_value_t tree straight into Python objects, with object
+ * keys interned. Built by setup.py as libyay._native; __init__.py falls
+ * back to the pure-Python parser when the extension is unavailable.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "yay.h"
+
+/* libyay.errors.YaySyntaxError, resolved at module init */
+static PyObject *syntax_error;
+
+static PyObject *convert_value(const yay_value_t *value) {
+    if (!value) Py_RETURN_NONE;
+
+    switch (value->type) {
+        case YAY_NULL:
+            Py_RETURN_NONE;
+        case YAY_BOOL:
+            return PyBool_FromLong(value->data.boolean);
+        case YAY_INT: {
+            if (value->data.bigint.digits) {
+                PyObject *magnitude =
+                    PyLong_FromString(value->data.bigint.digits, NULL, 10);
+                if (!magnitude || !value->data.bigint.negative) {
+                    return magnitude;
+                }
+                PyObject *negated = PyNumber_Negative(magnitude);
+                Py_DECREF(magnitude);
+                return negated;
+            }
+            long long small = (long long)value->data.bigint.small;
+            if (value->data.bigint.negative && small > 0) small = -small;
+            return PyLong_FromLongLong(small);
+        }
+        case YAY_FLOAT:
+            return PyFloat_FromDouble(value->data.number);
+        case YAY_STRING:
+            return PyUnicode_FromString(value->data.string);
+        case YAY_BYTES:
+            return PyBytes_FromStringAndSize(
+                (const char *)value->data.bytes.data,
+                (Py_ssize_t)value->data.bytes.length);
+        case YAY_ARRAY: {
+            PyObject *list = PyList_New((Py_ssize_t)value->data.array.length);
+            if (!list) return NULL;
+            for (size_t i = 0; i < value->data.array.length; i++) {
+                PyObject *item = convert_value(value->data.array.items[i]);
+                if (!item) {
+                    Py_DECREF(list);
+                    return NULL;
+                }
+                PyList_SET_ITEM(list, (Py_ssize_t)i, item);
+            }
+            return list;
+        }
+        case YAY_OBJECT: {
+            PyObject *dict = PyDict_New();
+            if (!dict) return NULL;
+            for (size_t i = 0; i < value->data.object.length; i++) {
+                PyObject *key = PyUnicode_InternFromString(
+                    value->data.object.pairs[i].key);
+                PyObject *item =
+                    convert_value(value->data.object.pairs[i].value);
+                if (!key || !item || PyDict_SetItem(dict, key, item) < 0) {
+                    Py_XDECREF(key);
+                    Py_XDECREF(item);
+                    Py_DECREF(dict);
+                    return NULL;
+                }
+                Py_DECREF(key);
+                Py_DECREF(item);
+            }
+            return dict;
+        }
+    }
+    PyErr_SetString(PyExc_TypeError, "unknown YAY value type");
+    return NULL;
+}
+
+static PyObject *native_loads(PyObject *module, PyObject *args) {
+    (void)module;
+    const char *source;
+    Py_ssize_t length;
+    if (!PyArg_ParseTuple(args, "s#:loads", &source, &length)) return NULL;
+
+    yay_result_t result = yay_parse(source, (size_t)length, NULL);
+    if (result.error) {
+        PyErr_SetString(syntax_error ? syntax_error : PyExc_ValueError,
+                        yay_error_message(result.error));
+        yay_result_free(&result);
+        return NULL;
+    }
+    PyObject *value = convert_value(result.value);
+    yay_result_free(&result);
+    return value;
+}
+
+static PyMethodDef native_methods[] = {
+    {"loads", native_loads, METH_VARARGS,
+     "Parse a YAY string into Python objects using the C parser."},
+    {NULL, NULL, 0, NULL},
+};
+
+static struct PyModuleDef native_module = {
+    PyModuleDef_HEAD_INIT,
+    "libyay._native",
+    "C-accelerated YAY parsing.",
+    -1,
+    native_methods,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+};
+
+PyMODINIT_FUNC PyInit__native(void) {
+    PyObject *errors = PyImport_ImportModule("libyay.errors");
+    if (errors) {
+        syntax_error = PyObject_GetAttrString(errors, "YaySyntaxError");
+        Py_DECREF(errors);
+    }
+    if (!syntax_error) PyErr_Clear();
+    return PyModule_Create(&native_module);
+}
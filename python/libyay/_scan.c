@@ -0,0 +1,219 @@
+/*
+ * Optional C-accelerated scanners for the pure-Python lexer.
+ *
+ * Unlike _native.c this module has no dependency on the C parser in
+ * ../c, so it builds from the package sources alone. Each function is
+ * an optimistic fast path over one of Lexer's hot inner loops
+ * (_read_double_quoted_string, read_number, read_bytes): it scans the
+ * common shape of its token directly over the source buffer and
+ * returns None for anything unusual — escapes, unicode digits, errors,
+ * end of input — so the pure-Python loop keeps sole ownership of error
+ * messages and positions.
+ *
+ * All positions are code-point indices into the source str, matching
+ * Lexer.pos; none of the accepted shapes span a newline, so the caller
+ * can update its column by the consumed width.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+/* scan_dquote(source, pos) -> (value, end) | None
+ *
+ * pos indexes the first character after the opening quote; end indexes
+ * past the closing quote. Escape-free strings only. */
+static PyObject *scan_dquote(PyObject *module, PyObject *args) {
+    PyObject *source;
+    Py_ssize_t pos;
+    if (!PyArg_ParseTuple(args, "Un", &source, &pos)) return NULL;
+    const void *data = PyUnicode_DATA(source);
+    int kind = PyUnicode_KIND(source);
+    Py_ssize_t length = PyUnicode_GET_LENGTH(source);
+    for (Py_ssize_t i = pos; i < length; i++) {
+        Py_UCS4 ch = PyUnicode_READ(kind, data, i);
+        if (ch == '"') {
+            PyObject *value = PyUnicode_Substring(source, pos, i);
+            if (!value) return NULL;
+            return Py_BuildValue("(Nn)", value, i + 1);
+        }
+        if (ch == '\\' || ch < 0x20) Py_RETURN_NONE;
+    }
+    Py_RETURN_NONE;
+}
+
+/* scan_number(source, pos) -> (value, end) | None
+ *
+ * pos indexes the leading minus, digit, or dot. Accepts ASCII digits
+ * with single grouping spaces, one dot, and a lowercase exponent; the
+ * value comes back as int or float, telling the caller the token kind.
+ * Anything the pure-Python loop would reject — uppercase exponent,
+ * space next to a dot, a bare exponent — falls back. */
+static PyObject *scan_number(PyObject *module, PyObject *args) {
+    PyObject *source;
+    Py_ssize_t pos;
+    if (!PyArg_ParseTuple(args, "Un", &source, &pos)) return NULL;
+    const void *data = PyUnicode_DATA(source);
+    int kind = PyUnicode_KIND(source);
+    Py_ssize_t length = PyUnicode_GET_LENGTH(source);
+
+    /* Digits compact into an ASCII buffer with grouping spaces dropped,
+     * sized by the remaining source. */
+    char *compact = PyMem_Malloc((size_t)(length - pos) + 1);
+    if (!compact) return PyErr_NoMemory();
+    Py_ssize_t n = 0;
+    Py_ssize_t i = pos;
+    int has_dot = 0, has_exp = 0, has_digit = 0, last_was_space = 0;
+
+    if (i < length && PyUnicode_READ(kind, data, i) == '-') {
+        compact[n++] = '-';
+        i++;
+    }
+    while (i < length) {
+        Py_UCS4 ch = PyUnicode_READ(kind, data, i);
+        if (ch >= 0x80) goto bail; /* unicode digits: pure-Python rules */
+        if (ch >= '0' && ch <= '9') {
+            compact[n++] = (char)ch;
+            has_digit = 1;
+            last_was_space = 0;
+            i++;
+        } else if (ch == '.') {
+            if (has_dot || has_exp) break;
+            if (last_was_space) goto bail; /* space before dot: error */
+            has_dot = 1;
+            compact[n++] = '.';
+            i++;
+            if (i < length && PyUnicode_READ(kind, data, i) == ' ')
+                goto bail; /* space after dot: error */
+        } else if (ch == 'e') {
+            if (has_exp || n == 0) break;
+            has_exp = 1;
+            compact[n++] = 'e';
+            i++;
+            if (i < length) {
+                Py_UCS4 sign = PyUnicode_READ(kind, data, i);
+                if (sign == '+' || sign == '-') {
+                    compact[n++] = (char)sign;
+                    i++;
+                }
+            }
+            if (i >= length) goto bail; /* bare exponent: error */
+            Py_UCS4 first = PyUnicode_READ(kind, data, i);
+            if (first < '0' || first > '9') goto bail;
+        } else if (ch == 'E') {
+            if (!has_exp && n > 0) goto bail; /* uppercase: error */
+            break;
+        } else if (ch == ' ') {
+            Py_UCS4 next =
+                i + 1 < length ? PyUnicode_READ(kind, data, i + 1) : 0;
+            if (next >= 0x80) goto bail;
+            if (next >= '0' && next <= '9') {
+                last_was_space = 1;
+                i++; /* grouping space, not collected */
+            } else if (next == '.') {
+                goto bail; /* space before dot: error */
+            } else {
+                break;
+            }
+        } else {
+            break;
+        }
+    }
+    if (!has_digit) goto bail;
+
+    compact[n] = '\0';
+    PyObject *value;
+    if (has_dot || has_exp) {
+        double d = PyOS_string_to_double(compact, NULL, NULL);
+        if (d == -1.0 && PyErr_Occurred()) {
+            PyErr_Clear();
+            goto bail;
+        }
+        value = PyFloat_FromDouble(d);
+    } else {
+        value = PyLong_FromString(compact, NULL, 10);
+        if (!value) {
+            PyErr_Clear();
+            goto bail;
+        }
+    }
+    PyMem_Free(compact);
+    if (!value) return NULL;
+    return Py_BuildValue("(Nn)", value, i);
+
+bail:
+    PyMem_Free(compact);
+    Py_RETURN_NONE;
+}
+
+/* scan_hex(source, pos) -> (value, end) | None
+ *
+ * pos indexes the first character after '<' of an inline byte array;
+ * end indexes past the closing '>'. Lowercase digits and spaces only;
+ * comments, uppercase digits, odd counts, space before '>', and
+ * unterminated arrays all fall back. */
+static PyObject *scan_hex(PyObject *module, PyObject *args) {
+    PyObject *source;
+    Py_ssize_t pos;
+    if (!PyArg_ParseTuple(args, "Un", &source, &pos)) return NULL;
+    const void *data = PyUnicode_DATA(source);
+    int kind = PyUnicode_KIND(source);
+    Py_ssize_t length = PyUnicode_GET_LENGTH(source);
+
+    unsigned char *bytes = PyMem_Malloc((size_t)(length - pos) / 2 + 1);
+    if (!bytes) return PyErr_NoMemory();
+    Py_ssize_t count = 0;
+    int have_high = 0;
+    unsigned char high = 0;
+    int last_was_space = 0;
+
+    for (Py_ssize_t i = pos; i < length; i++) {
+        Py_UCS4 ch = PyUnicode_READ(kind, data, i);
+        if (ch == '>') {
+            if (last_was_space || have_high) break; /* error or odd count */
+            PyObject *value =
+                PyBytes_FromStringAndSize((const char *)bytes, count);
+            PyMem_Free(bytes);
+            if (!value) return NULL;
+            return Py_BuildValue("(Nn)", value, i + 1);
+        }
+        if (ch == ' ') {
+            last_was_space = 1;
+            continue;
+        }
+        last_was_space = 0;
+        int nibble;
+        if (ch >= '0' && ch <= '9') {
+            nibble = (int)(ch - '0');
+        } else if (ch >= 'a' && ch <= 'f') {
+            nibble = (int)(ch - 'a') + 10;
+        } else {
+            break; /* comment, newline, uppercase, or error */
+        }
+        if (have_high) {
+            bytes[count++] = (unsigned char)((high << 4) | nibble);
+            have_high = 0;
+        } else {
+            high = (unsigned char)nibble;
+            have_high = 1;
+        }
+    }
+    PyMem_Free(bytes);
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef scan_methods[] = {
+    {"scan_dquote", scan_dquote, METH_VARARGS,
+     "Scan an escape-free double-quoted string; None to fall back."},
+    {"scan_number", scan_number, METH_VARARGS,
+     "Scan a number with grouping spaces; None to fall back."},
+    {"scan_hex", scan_hex, METH_VARARGS,
+     "Scan an inline byte array body; None to fall back."},
+    {NULL, NULL, 0, NULL},
+};
+
+static struct PyModuleDef scan_module = {
+    PyModuleDef_HEAD_INIT, "libyay._scan",
+    "C-accelerated scanners for the pure-Python lexer.", -1, scan_methods,
+};
+
+PyMODINIT_FUNC PyInit__scan(void) { return PyModule_Create(&scan_module); }
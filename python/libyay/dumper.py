@@ -1,10 +1,25 @@
 """
 YAY dumper - serializes Python objects to YAY format.
+
+Output accumulates as a flat list of fragments joined once at the end
+(or flushed in batches to a file), so serializing never concatenates
+strings per node.
 """
 
 import math
-import re
-from typing import Any, TextIO
+from typing import Any, Callable, TextIO
+
+# Fragments buffered before a flush when dumping straight to a file.
+_FLUSH_FRAGMENTS = 4096
+
+# Memoized two-space indent prefixes, grown on demand.
+_INDENTS = ["", "  "]
+
+
+def _prefix(indent: int) -> str:
+    while len(_INDENTS) <= indent:
+        _INDENTS.append(_INDENTS[-1] + "  ")
+    return _INDENTS[indent]
 
 
 def _is_simple_key(key: str) -> bool:
@@ -56,10 +71,12 @@ def _escape_single_quoted(s: str) -> str:
     return s.replace("'", "''")
 
 
-def _format_value(value: Any, indent: int = 0, inline: bool = False) -> str:
-    """Format a value as YAY."""
-    prefix = "  " * indent
+def _format_key(key: str) -> str:
+    return key if _is_simple_key(key) else f"'{_escape_single_quoted(key)}'"
+
 
+def _format_scalar(value: Any) -> str:
+    """Format a non-container value as YAY."""
     if value is None:
         return "null"
 
@@ -93,67 +110,104 @@ def _format_value(value: Any, indent: int = 0, inline: bool = False) -> str:
     if isinstance(value, bytes):
         return f"<{value.hex()}>"
 
-    if isinstance(value, list):
-        if inline or not value:
-            # Inline array
-            items = [_format_value(item, 0, inline=True) for item in value]
-            return "[" + ", ".join(items) + "]"
-        else:
-            # Block array
-            lines = []
-            for item in value:
-                if isinstance(item, (dict, list)) and item:
-                    # Complex nested item
-                    item_str = _format_value(item, indent + 1, inline=False)
-                    if isinstance(item, list):
-                        # Nested list - format inline or as nested block
-                        lines.append(f"{prefix}- {_format_value(item, 0, inline=True)}")
-                    else:
-                        # Nested object
-                        lines.append(f"{prefix}-")
-                        for line in item_str.split("\n"):
-                            if line.strip():
-                                lines.append(f"{prefix}  {line}")
-                else:
-                    item_str = _format_value(item, 0, inline=True)
-                    lines.append(f"{prefix}- {item_str}")
-            return "\n".join(lines)
-
-    if isinstance(value, dict):
-        if inline or not value:
-            # Inline object
-            items = []
-            for k, v in value.items():
-                key_str = k if _is_simple_key(k) else f"'{_escape_single_quoted(k)}'"
-                val_str = _format_value(v, 0, inline=True)
-                items.append(f"{key_str}: {val_str}")
-            return "{" + ", ".join(items) + "}"
-        else:
-            # Block object
-            lines = []
-            for k, v in value.items():
-                key_str = k if _is_simple_key(k) else f"'{_escape_single_quoted(k)}'"
+    raise TypeError(f"Cannot serialize type {type(value).__name__} to YAY")
 
-                if isinstance(v, dict) and v:
-                    # Nested object
-                    lines.append(f"{prefix}{key_str}:")
-                    nested = _format_value(v, indent + 1, inline=False)
-                    lines.append(nested)
-                elif isinstance(v, list) and v:
-                    # Nested array
-                    lines.append(f"{prefix}{key_str}:")
-                    nested = _format_value(v, indent + 1, inline=False)
-                    lines.append(nested)
-                else:
-                    # Inline value
-                    val_str = _format_value(v, 0, inline=True)
-                    lines.append(f"{prefix}{key_str}: {val_str}")
-            return "\n".join(lines)
 
-    raise TypeError(f"Cannot serialize type {type(value).__name__} to YAY")
+class _Dumper:
+    """Serializer state: a fragment sink plus formatting options."""
+
+    def __init__(self, write: Callable[[str], None], sort_keys: bool):
+        self.write = write
+        self.sort_keys = sort_keys
+        self.started = False
 
+    def _items(self, mapping: dict) -> Any:
+        """One pass over a dict's items, pre-sorted when requested."""
+        if self.sort_keys:
+            return sorted(mapping.items())
+        return mapping.items()
 
-def dumps(obj: Any, *, indent: bool = True) -> str:
+    def _newline(self) -> None:
+        if self.started:
+            self.write("\n")
+        self.started = True
+
+    def dump(self, value: Any, indent: bool) -> None:
+        if indent and isinstance(value, (dict, list)) and value:
+            self._block(value, 0, 0)
+        else:
+            self._inline(value)
+
+    def _inline(self, value: Any) -> None:
+        write = self.write
+
+        if isinstance(value, list):
+            write("[")
+            first = True
+            for item in value:
+                if not first:
+                    write(", ")
+                first = False
+                self._inline(item)
+            write("]")
+            return
+
+        if isinstance(value, dict):
+            write("{")
+            first = True
+            for k, v in self._items(value):
+                if not first:
+                    write(", ")
+                first = False
+                write(_format_key(k))
+                write(": ")
+                self._inline(v)
+            write("}")
+            return
+
+        write(_format_scalar(value))
+
+    def _block(self, value: Any, indent: int, shift: int) -> None:
+        """Write a non-empty container in block format.
+
+        shift carries the extra indent a nested object accrues under a
+        dash item, so deeply nested output matches what re-prefixing
+        every rendered line would have produced.
+        """
+        prefix = _prefix(indent + shift)
+        write = self.write
+
+        if isinstance(value, list):
+            for item in value:
+                self._newline()
+                if isinstance(item, dict) and item:
+                    # Nested object
+                    write(prefix)
+                    write("-")
+                    self._block(item, indent + 1, shift + indent + 1)
+                else:
+                    # Nested lists and empty containers stay inline
+                    write(prefix)
+                    write("- ")
+                    self._inline(item)
+            return
+
+        # Block object
+        for k, v in self._items(value):
+            self._newline()
+            write(prefix)
+            write(_format_key(k))
+            if isinstance(v, (dict, list)) and v:
+                # Nested container
+                write(":")
+                self._block(v, indent + 1, shift)
+            else:
+                # Inline value
+                write(": ")
+                self._inline(v)
+
+
+def dumps(obj: Any, *, indent: bool = True, sort_keys: bool = False) -> str:
     """
     Serialize Python objects to a YAY string.
 
@@ -161,20 +215,37 @@ def dumps(obj: Any, *, indent: bool = True) -> str:
         obj: The Python object to serialize
         indent: If True (default), use block format for arrays/objects.
                 If False, use inline format.
+        sort_keys: If True, write object keys in sorted order.
 
     Returns:
         YAY-formatted string
     """
-    return _format_value(obj, 0, inline=not indent)
+    parts: list[str] = []
+    _Dumper(parts.append, sort_keys).dump(obj, indent)
+    return "".join(parts)
 
 
-def dump(obj: Any, fp: TextIO, *, indent: bool = True) -> None:
+def dump(obj: Any, fp: TextIO, *, indent: bool = True, sort_keys: bool = False) -> None:
     """
     Serialize Python objects to a YAY file.
 
+    Fragments stream to fp in batches, so the full output string is
+    never materialized.
+
     Args:
         obj: The Python object to serialize
         fp: File-like object to write to
         indent: If True (default), use block format for arrays/objects.
+        sort_keys: If True, write object keys in sorted order.
     """
-    fp.write(dumps(obj, indent=indent))
+    parts: list[str] = []
+
+    def write(fragment: str) -> None:
+        parts.append(fragment)
+        if len(parts) >= _FLUSH_FRAGMENTS:
+            fp.write("".join(parts))
+            parts.clear()
+
+    _Dumper(write, sort_keys).dump(obj, indent)
+    if parts:
+        fp.write("".join(parts))
@@ -7,6 +7,35 @@ from dataclasses import dataclass
 from typing import Iterator
 from .errors import YaySyntaxError
 
+try:
+    # Optional C-accelerated scanners (see _scan.c). Each returns None
+    # for input it does not handle, so the pure-Python loops below stay
+    # the source of truth for error messages and positions.
+    from . import _scan
+except ImportError:
+    _scan = None
+
+# Bulk-scan patterns: one regex match replaces a per-character loop,
+# which is what keeps the pure-Python fallback usable on hosts where
+# the extensions cannot build.
+_SPACES = re.compile(r" *")
+_IDENT_ASCII = re.compile(r"[0-9A-Za-z_-]*")
+_TRAILING_SPACE = re.compile(r" (?=\n)")
+# Everything _is_allowed_code_point rejects, as one character class:
+# controls other than newline, DEL through C1, surrogates, the U+FDD0
+# block, and the two trailing noncharacters of every plane.
+_FORBIDDEN = re.compile(
+    "[\x00-\x09\x0b-\x1f\x7f-\x9f"
+    "\ud800-\udfff"
+    "\ufdd0-\ufdef"
+    "\ufffe\uffff"
+    + "".join(
+        chr(plane + 0xFFFE) + chr(plane + 0xFFFF)
+        for plane in range(0x10000, 0x110000, 0x10000)
+    )
+    + "]"
+)
+
 
 @dataclass
 class Token:
@@ -68,32 +97,34 @@ class Lexer:
             if self.source[0] == "\ufeff" or self.source[:3] == "\xef\xbb\xbf":
                 raise YaySyntaxError("Illegal BOM", 1, 1)
 
-        # Check for forbidden code points
-        line = 1
-        col = 1
-        for ch in self.source:
-            cp = ord(ch)
-            if not self._is_allowed_code_point(cp):
-                if cp == 0x09:
-                    raise YaySyntaxError("Tab not allowed (use spaces)", line, col)
-                if 0xD800 <= cp <= 0xDFFF:
-                    raise YaySyntaxError("Illegal surrogate", line, col)
-                raise YaySyntaxError(f"Forbidden code point U+{cp:04X}", line, col)
-            if cp == 0x0A:
-                line += 1
-                col = 1
-            else:
-                col += 1
-
-        # Check for trailing spaces line by line
-        lines = self.source.split("\n")
-        for i, line_str in enumerate(lines):
-            line_num = i + 1
-            # Check for trailing space (but not on the last empty line)
-            if line_str.endswith(" ") and not (i == len(lines) - 1 and line_str == ""):
-                raise YaySyntaxError(
-                    "Unexpected trailing space", line_num, len(line_str)
-                )
+        # One character-class search finds the first forbidden code
+        # point, if any; line and column are recovered from the match
+        # position only on the error path.
+        match = _FORBIDDEN.search(self.source)
+        if match is not None:
+            idx = match.start()
+            cp = ord(self.source[idx])
+            line = self.source.count("\n", 0, idx) + 1
+            col = idx - self.source.rfind("\n", 0, idx)
+            if cp == 0x09:
+                raise YaySyntaxError("Tab not allowed (use spaces)", line, col)
+            if 0xD800 <= cp <= 0xDFFF:
+                raise YaySyntaxError("Illegal surrogate", line, col)
+            raise YaySyntaxError(f"Forbidden code point U+{cp:04X}", line, col)
+
+        # First trailing space, either before a newline or at the very
+        # end of a non-empty final line.
+        match = _TRAILING_SPACE.search(self.source)
+        if match is not None:
+            idx = match.start()
+            line = self.source.count("\n", 0, idx) + 1
+            col = idx - self.source.rfind("\n", 0, idx)
+            raise YaySyntaxError("Unexpected trailing space", line, col)
+        if self.source.endswith(" "):
+            idx = len(self.source) - 1
+            line = self.source.count("\n", 0, idx) + 1
+            col = idx - self.source.rfind("\n", 0, idx)
+            raise YaySyntaxError("Unexpected trailing space", line, col)
 
     def peek(self, offset: int = 0) -> str:
         """Peek at character at current position + offset."""
@@ -117,15 +148,18 @@ class Lexer:
 
     def skip_to_eol(self) -> None:
         """Skip to end of line (for comments)."""
-        while self.peek() and self.peek() != "\n":
-            self.advance()
+        end = self.source.find("\n", self.pos)
+        if end < 0:
+            end = len(self.source)
+        self.col += end - self.pos
+        self.pos = end
 
     def read_indent(self) -> int:
         """Read leading spaces and return indent level."""
-        spaces = 0
-        while self.peek() == " ":
-            self.advance()
-            spaces += 1
+        end = _SPACES.match(self.source, self.pos).end()
+        spaces = end - self.pos
+        self.col += spaces
+        self.pos = end
         if self.peek() == "\t":
             raise self.error("Tab not allowed (use spaces)")
         return spaces
@@ -365,6 +399,15 @@ class Lexer:
 
     def _read_double_quoted_string(self, start_line: int, start_col: int) -> Token:
         """Read a JSON-style double-quoted string with escape sequences."""
+        if _scan is not None:
+            # Fast path for escape-free strings; they contain no
+            # newlines, so the column moves by the consumed width.
+            fast = _scan.scan_dquote(self.source, self.pos)
+            if fast is not None:
+                value, end = fast
+                self.col += end - self.pos
+                self.pos = end
+                return Token("STRING", value, start_line, start_col)
         chars = []
         while True:
             ch = self.peek()
@@ -466,6 +509,18 @@ class Lexer:
         start_line = self.line
         start_col = self.col
 
+        if _scan is not None:
+            # Fast path for plain numbers; the value's type carries the
+            # token kind, and anything malformed falls through to the
+            # character loop for its exact error.
+            fast = _scan.scan_number(self.source, self.pos)
+            if fast is not None:
+                value, end = fast
+                self.col += end - self.pos
+                self.pos = end
+                kind = "FLOAT" if isinstance(value, float) else "INT"
+                return Token(kind, value, start_line, start_col)
+
         # Collect all characters that could be part of a number
         # Numbers can have spaces for grouping
         chars = []
@@ -558,6 +613,16 @@ class Lexer:
         if not already_consumed_open:
             self.advance()  # consume '<'
 
+        if _scan is not None and not allow_multiline:
+            # Fast path for single-line <hex> bodies; comments and
+            # malformed arrays fall through to the character loop.
+            fast = _scan.scan_hex(self.source, self.pos)
+            if fast is not None:
+                value, end = fast
+                self.col += end - self.pos
+                self.pos = end
+                return Token("BYTES", value, start_line, start_col)
+
         hex_chars = []
         last_was_space = False
         space_col = 0
@@ -636,7 +701,13 @@ class Lexer:
         """Read an identifier or keyword."""
         start_line = self.line
         start_col = self.col
-        chars = []
+
+        # Bulk jump over the ASCII run, then fall back to the
+        # character loop for the rare unicode-alphanumeric tail.
+        end = _IDENT_ASCII.match(self.source, self.pos).end()
+        chars = [self.source[self.pos : end]]
+        self.col += end - self.pos
+        self.pos = end
 
         while True:
             ch = self.peek()
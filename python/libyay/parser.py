@@ -3,9 +3,10 @@ YAY parser - parses YAY input into Python objects.
 """
 
 import math
-from typing import Any, TextIO
+from collections import deque
+from typing import Any, Iterator, TextIO
 from .lexer import Lexer, Token
-from .errors import YaySyntaxError
+from .errors import YayError, YaySyntaxError
 
 
 class Parser:
@@ -22,8 +23,13 @@ class Parser:
         self.source = source
         self.source_lines = source.split("\n")
         self.lexer = Lexer(source)
-        self.tokens: list[Token] = list(self.lexer.tokenize())
-        self.pos = 0
+        # Tokens are pulled lazily and released once consumed, so the
+        # live window tracks the parser's small lookahead (at most two
+        # tokens) rather than the whole document. iterparse relies on
+        # this to keep memory at one record.
+        self._tokens = self.lexer.tokenize()
+        self._window: deque[Token] = deque()
+        self._eof: Token | None = None
 
     def error(self, message: str, token: Token | None = None) -> YaySyntaxError:
         if token is None:
@@ -174,15 +180,20 @@ class Parser:
 
     def peek(self, offset: int = 0) -> Token:
         """Peek at token at current position + offset."""
-        idx = self.pos + offset
-        if idx >= len(self.tokens):
-            return self.tokens[-1]  # EOF
-        return self.tokens[idx]
+        while len(self._window) <= offset:
+            token = next(self._tokens, None)
+            if token is None:
+                return self._eof  # the lexer always ends with EOF
+            if token.kind == "EOF":
+                self._eof = token
+            self._window.append(token)
+        return self._window[offset]
 
     def advance(self) -> Token:
         """Consume and return current token."""
         token = self.peek()
-        self.pos += 1
+        if self._window:
+            self._window.popleft()
         return token
 
     def expect(self, kind: str) -> Token:
@@ -734,6 +745,81 @@ class Parser:
 
         return "".join(parts)
 
+    def iter_root_array(self) -> Iterator[Any]:
+        """Parse a root array, yielding each element as it completes.
+
+        Mirrors parse() followed by parse_block_array(0), but hands
+        elements back one at a time instead of collecting them; with
+        the lazy token window this keeps memory at one element.
+        Raises YayError when the document's root is not an array.
+        """
+        has_content = bool(self.source.strip())
+
+        while self.peek().kind == "NEWLINE":
+            self.advance()
+
+        if self.peek().kind == "INDENT":
+            if self.peek().value > 0:
+                raise YaySyntaxError("Unexpected indent", self.peek().line, 1)
+            self.advance()
+
+        if self.peek().kind == "EOF":
+            if has_content:
+                raise YaySyntaxError("No value found in document", 1, 1)
+            return
+
+        token = self.peek()
+        if token.kind == "LBRACKET":
+            # Inline arrays sit on a single line; nothing to stream.
+            items = self.parse_inline_array()
+            self.skip_newlines()
+            if self.peek().kind != "EOF":
+                raise self.error("Unexpected extra content")
+            yield from items
+            return
+        if token.kind != "DASH":
+            raise YayError("Document root is not an array")
+
+        any_items = False
+        while True:
+            token = self.peek()
+
+            if token.kind == "INDENT":
+                indent = token.value
+                if indent > 0 and any_items:
+                    break
+                self.advance()
+                token = self.peek()
+
+            if token.kind != "DASH":
+                break
+
+            dash_token = token
+            self.advance()  # consume dash
+
+            # Check for exactly one space after dash
+            next_col = dash_token.col + 1
+            if self.char_at(dash_token.line, next_col) != " ":
+                raise YaySyntaxError(
+                    'Expected space after "-"', dash_token.line, next_col
+                )
+            if self.char_at(dash_token.line, next_col + 1) == " ":
+                if dash_token.col == 1:
+                    raise YaySyntaxError("Unexpected leading space", dash_token.line, 1)
+                raise YaySyntaxError(
+                    'Unexpected space after "-"', dash_token.line, dash_token.col
+                )
+
+            yield self.parse_array_item(2)
+            any_items = True
+
+            if self.peek().kind == "NEWLINE":
+                self.advance()
+
+        self.skip_newlines()
+        if self.peek().kind != "EOF":
+            raise self.error("Unexpected extra content")
+
 
 def loads(s: str) -> Any:
     """Parse a YAY string into Python objects."""
@@ -745,3 +831,14 @@ def loads(s: str) -> Any:
 def load(fp: TextIO) -> Any:
     """Parse a YAY file into Python objects."""
     return loads(fp.read())
+
+
+def iterparse(fp: TextIO) -> Iterator[Any]:
+    """Lazily parse an array-rooted YAY file, yielding elements.
+
+    Only the source text and the element being built are held in
+    memory, so iterating a huge root array stays at one record rather
+    than the whole list. Raises YayError when the root is not an array.
+    """
+    parser = Parser(fp.read())
+    yield from parser.iter_root_array()
@@ -0,0 +1,26 @@
+"""Build configuration for the optional C extensions.
+
+_native compiles the C parser from ../c/yay.c, so it can only be built
+from a checkout of the full repository. _scan accelerates the hot loops
+of the pure-Python lexer and builds from the package sources alone.
+Both are marked optional: when compilation fails, installation proceeds
+and the package falls back to pure Python.
+"""
+
+from setuptools import Extension, setup
+
+setup(
+    ext_modules=[
+        Extension(
+            "libyay._native",
+            sources=["libyay/_native.c", "../c/yay.c"],
+            include_dirs=["../c"],
+            optional=True,
+        ),
+        Extension(
+            "libyay._scan",
+            sources=["libyay/_scan.c"],
+            optional=True,
+        ),
+    ]
+)
@@ -311,6 +311,34 @@ def run_error_tests(test_root: str, verbose: bool = False) -> tuple[int, int, li
     return passed, failed, errors
 
 
+def run_parse_files_tests(test_root: str) -> tuple[int, int, list]:
+    """Compare parse_files against sequential loads over the corpus."""
+    yay_dir = os.path.join(test_root, "yay")
+    paths = sorted(
+        os.path.join(yay_dir, name)
+        for name in os.listdir(yay_dir)
+        if name.endswith(".yay")
+    )
+    results = yay.parse_files(paths, processes=2)
+    passed = 0
+    failed = 0
+    errors = []
+    for path, result in zip(paths, results):
+        name = os.path.basename(path)
+        with open(path, "r", encoding="utf-8") as fp:
+            expected = yay.loads(fp.read())
+        if (
+            result.path == path
+            and result.error is None
+            and values_equal(result.value, expected)
+        ):
+            passed += 1
+        else:
+            failed += 1
+            errors.append((name, f"parse_files mismatch: {result!r}"))
+    return passed, failed, errors
+
+
 def main():
     import argparse
 
@@ -359,9 +387,14 @@ def main():
         e_passed, e_failed, e_errors = run_error_tests(test_root, args.verbose)
         print(f"  {e_passed} passed, {e_failed} failed")
 
-        total_passed = v_passed + e_passed
-        total_failed = v_failed + e_failed
-        all_errors = v_errors + e_errors
+        # Run the multiprocessing batch parser over the same corpus
+        print("\nParallel parse_files:")
+        p_passed, p_failed, p_errors = run_parse_files_tests(test_root)
+        print(f"  {p_passed} passed, {p_failed} failed")
+
+        total_passed = v_passed + e_passed + p_passed
+        total_failed = v_failed + e_failed + p_failed
+        all_errors = v_errors + e_errors + p_errors
 
         print(f"\nTotal: {total_passed} passed, {total_failed} failed")
 
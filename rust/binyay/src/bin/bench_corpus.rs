@@ -0,0 +1,57 @@
+//! Parses every `.yay` file in a corpus directory a number of times and
+//! prints one machine-readable line, `<bytes> <seconds>`, for
+//! `scripts/bench.sh` to turn into a cross-implementation MB/s and
+//! peak-RSS table.
+//!
+//! Usage: `bench_corpus [corpus-dir] [reps]` (default `../test/yay`, 100)
+
+use std::env;
+use std::fs;
+use std::process::ExitCode;
+use std::time::Instant;
+
+fn main() -> ExitCode {
+    let args: Vec<String> = env::args().collect();
+    let dir = args.get(1).map(String::as_str).unwrap_or("../test/yay");
+    let reps: usize = match args.get(2).map(String::as_str).unwrap_or("100").parse() {
+        Ok(n) => n,
+        Err(_) => {
+            eprintln!("bad rep count {:?}", args[2]);
+            return ExitCode::FAILURE;
+        }
+    };
+
+    let entries = match fs::read_dir(dir) {
+        Ok(entries) => entries,
+        Err(err) => {
+            eprintln!("cannot open corpus directory {}: {}", dir, err);
+            return ExitCode::FAILURE;
+        }
+    };
+    let mut paths: Vec<_> = entries
+        .filter_map(|entry| entry.ok())
+        .map(|entry| entry.path())
+        .filter(|path| path.extension().is_some_and(|ext| ext == "yay"))
+        .collect();
+    paths.sort();
+
+    let mut sources = Vec::with_capacity(paths.len());
+    let mut total_bytes = 0;
+    for path in &paths {
+        if let Ok(source) = fs::read_to_string(path) {
+            total_bytes += source.len();
+            sources.push(source);
+        }
+    }
+
+    let start = Instant::now();
+    for _ in 0..reps {
+        for source in &sources {
+            let _ = libyay::parse(source);
+        }
+    }
+    let elapsed = start.elapsed().as_secs_f64();
+
+    println!("{} {:.6}", total_bytes * reps, elapsed);
+    ExitCode::SUCCESS
+}
@@ -0,0 +1,118 @@
+//! Persistent cache of known-clean inputs for directory runs.
+//!
+//! Repo-wide `yay --check` and `yay -w` runs mostly revisit files that
+//! have not changed since the previous run. The cache records the
+//! content hash of every input that checked clean (or was already in
+//! canonical form), one cache file per mode under `~/.cache/yay/`, so
+//! a warm run skips parsing for every unchanged file and only touches
+//! the edited ones.
+
+use std::collections::HashSet;
+use std::env;
+use std::fmt::Write as _;
+use std::fs;
+use std::path::PathBuf;
+
+/// Bump when the meaning of an entry changes so caches written by
+/// older binaries are ignored rather than trusted.
+const CACHE_VERSION: u32 = 1;
+
+/// Cap on persisted entries. Hashes from files that were edited or
+/// deleted linger until evicted; the cap keeps the cache file bounded
+/// while still covering repositories far larger than ours.
+const MAX_ENTRIES: usize = 1 << 18;
+
+/// FNV-1a, 64-bit. Not cryptographic, but collisions are vanishingly
+/// unlikely across a repository of documents, and a collision can only
+/// skip work for a file, never change the result of processing one.
+pub fn content_hash(bytes: &[u8]) -> u64 {
+    let mut hash: u64 = 0xcbf29ce484222325;
+    for &byte in bytes {
+        hash ^= byte as u64;
+        hash = hash.wrapping_mul(0x100000001b3);
+    }
+    hash
+}
+
+/// Hashes of inputs known clean for one (mode, input format) pair.
+pub struct CleanCache {
+    path: PathBuf,
+    seen: HashSet<u64>,
+}
+
+impl CleanCache {
+    /// Load the cache for a mode ("check" or "format") and input
+    /// format, honoring XDG_CACHE_HOME and falling back to
+    /// `$HOME/.cache`. Returns None when neither is set, in which case
+    /// the run is simply uncached. A missing or corrupt cache file
+    /// starts the run cold rather than failing it.
+    pub fn load(mode: &str, from_format: &str) -> Option<CleanCache> {
+        let mut dir = match env::var_os("XDG_CACHE_HOME") {
+            Some(cache_home) if !cache_home.is_empty() => PathBuf::from(cache_home),
+            _ => {
+                let home = env::var_os("HOME")?;
+                if home.is_empty() {
+                    return None;
+                }
+                let mut home = PathBuf::from(home);
+                home.push(".cache");
+                home
+            }
+        };
+        dir.push("yay");
+        let path = dir.join(format!(
+            "v{}-{}-{}.hashes",
+            CACHE_VERSION, mode, from_format
+        ));
+        let mut seen = HashSet::new();
+        if let Ok(contents) = fs::read_to_string(&path) {
+            for line in contents.lines() {
+                if let Ok(hash) = u64::from_str_radix(line.trim(), 16) {
+                    seen.insert(hash);
+                }
+            }
+        }
+        Some(CleanCache { path, seen })
+    }
+
+    pub fn contains(&self, hash: u64) -> bool {
+        self.seen.contains(&hash)
+    }
+
+    /// Persist the hashes that were clean this run plus the previously
+    /// known ones, so checking a subdirectory does not evict entries
+    /// for the rest of the tree. When the union exceeds the cap, only
+    /// entries confirmed this run are kept. Cache write failures are
+    /// ignored; the next run just starts cold.
+    pub fn save(&self, clean: &HashSet<u64>) {
+        let Some(dir) = self.path.parent() else {
+            return;
+        };
+        if fs::create_dir_all(dir).is_err() {
+            return;
+        }
+        let mut hashes: Vec<u64> = clean.iter().copied().collect();
+        if hashes.len() < MAX_ENTRIES {
+            hashes.extend(
+                self.seen
+                    .iter()
+                    .copied()
+                    .filter(|hash| !clean.contains(hash))
+                    .take(MAX_ENTRIES - hashes.len()),
+            );
+        } else {
+            hashes.truncate(MAX_ENTRIES);
+        }
+        hashes.sort_unstable();
+        let mut contents = String::with_capacity(hashes.len() * 17);
+        for hash in hashes {
+            let _ = writeln!(contents, "{:016x}", hash);
+        }
+        // Write-and-rename so a run interrupted mid-save (or a
+        // concurrent run) never leaves a torn cache file behind.
+        let tmp = self.path.with_extension("tmp");
+        if fs::write(&tmp, contents).is_ok() {
+            let _ = fs::rename(&tmp, &self.path);
+        }
+    }
+}
@@ -1,6 +1,7 @@
 //! YAY command-line tool for parsing, formatting, and transcoding YAY documents.
 //!
 //! Usage: yay [OPTIONS] [FILE|DIR]
+//!        yay merge [-o FILE] FRAGMENT...
 //!
 //! Options:
 //!       -f, --from <FORMAT>    Input format (meh, yay, json, yson, yaml, toml, cbor)
@@ -10,25 +11,32 @@
 //!   -o, --output <FILE>    Write output to specified file
 //!   --check                Check if file is valid (exit 0 if valid, 1 if invalid)
 //!                          Defaults to strict YAY input; use --from meh for lenient
+//!   --diff                 Compare two documents structurally and print changed
+//!                          paths (exit 0 if identical, 1 if different)
+//!   --stats                Report per-phase timing, throughput, and peak RSS
 //!   -h, --help             Print help
 //!   -V, --version          Print version
 
 use libyay::{
-    encode, format_yay, parse, parse_shon_bracket, parse_shon_file_bytes, parse_shon_file_string,
-    parse_shon_hex, parse_with_filename, parse_yson, Format, Value,
+    diff, encode_to, format_yay, parse, parse_shon_bracket, parse_shon_file_bytes,
+    parse_shon_file_string, parse_shon_hex, parse_with_filename, parse_yson,
+    validate_with_filename, DiffOp, Format, Value,
 };
 use std::fs;
 use std::io::{self, Read, Write};
 use std::path::Path;
 use std::process;
+use std::time::{Duration, Instant};
 
+mod cache;
 mod transcode;
 
 /// Check whether a string is a recognized format name for -f or -t.
 fn is_format_name(s: &str) -> bool {
     matches!(
         s,
-        "meh"
+        "auto"
+            | "meh"
             | "yay"
             | "json"
             | "yson"
@@ -54,13 +62,23 @@ fn is_format_name(s: &str) -> bool {
 fn main() {
     let args: Vec<String> = std::env::args().collect();
 
+    // `yay merge` is the one subcommand: it takes arbitrarily many
+    // inputs where the flag grammar below takes at most two.
+    if args.len() > 1 && args[1] == "merge" {
+        process::exit(run_merge(&args[2..]));
+    }
+
     let mut from_format: Option<&str> = None;
     let mut to_format: Option<&str> = None;
     let mut write_back = false;
     let mut output_file: Option<&str> = None;
     let mut check_only = false;
     let mut input_path: Option<&str> = None;
+    let mut second_input_path: Option<&str> = None;
     let mut shon_value: Option<Value> = None;
+    let mut daemon_socket: Option<&str> = None;
+    let mut diff_mode = false;
+    let mut stats_mode = false;
 
     let mut i = 1;
     while i < args.len() {
@@ -111,6 +129,20 @@ fn main() {
             "--check" => {
                 check_only = true;
             }
+            "--diff" => {
+                diff_mode = true;
+            }
+            "--stats" => {
+                stats_mode = true;
+            }
+            "--daemon" => {
+                i += 1;
+                if i >= args.len() {
+                    eprintln!("Error: --daemon requires a socket path argument");
+                    process::exit(1);
+                }
+                daemon_socket = Some(&args[i]);
+            }
             "-" => {
                 // Explicit stdin
                 // input_path stays None, which means stdin
@@ -125,7 +157,8 @@ fn main() {
                     eprintln!("Error: Cannot combine input file with SHON expression");
                     process::exit(1);
                 }
-                match parse_shon_bracket(&args[i..]) {
+                let shon_args: Vec<&str> = args[i..].iter().map(String::as_str).collect();
+                match parse_shon_bracket(&shon_args) {
                     Ok((value, consumed)) => {
                         shon_value = Some(value);
                         i += consumed;
@@ -147,7 +180,8 @@ fn main() {
                     eprintln!("Error: Cannot combine input file with SHON expression");
                     process::exit(1);
                 }
-                match parse_shon_hex(&args[i..]) {
+                let shon_args: Vec<&str> = args[i..].iter().map(String::as_str).collect();
+                match parse_shon_hex(&shon_args) {
                     Ok((value, consumed)) => {
                         shon_value = Some(value);
                         i += consumed;
@@ -168,7 +202,8 @@ fn main() {
                     eprintln!("Error: Cannot combine input file with SHON expression");
                     process::exit(1);
                 }
-                match parse_shon_file_bytes(&args[i..]) {
+                let shon_args: Vec<&str> = args[i..].iter().map(String::as_str).collect();
+                match parse_shon_file_bytes(&shon_args) {
                     Ok((value, consumed)) => {
                         shon_value = Some(value);
                         i += consumed;
@@ -189,7 +224,8 @@ fn main() {
                     eprintln!("Error: Cannot combine input file with SHON expression");
                     process::exit(1);
                 }
-                match parse_shon_file_string(&args[i..]) {
+                let shon_args: Vec<&str> = args[i..].iter().map(String::as_str).collect();
+                match parse_shon_file_string(&shon_args) {
                     Ok((value, consumed)) => {
                         shon_value = Some(value);
                         i += consumed;
@@ -210,16 +246,58 @@ fn main() {
                     eprintln!("Error: Cannot combine input file with SHON expression");
                     process::exit(1);
                 }
-                if input_path.is_some() {
+                if input_path.is_none() {
+                    input_path = Some(&args[i]);
+                } else if second_input_path.is_none() {
+                    // Only --diff takes two paths; rejected after the
+                    // loop so `yay old.yay new.yay --diff` also works
+                    second_input_path = Some(&args[i]);
+                } else {
                     eprintln!("Error: Multiple input paths not supported");
                     process::exit(1);
                 }
-                input_path = Some(&args[i]);
             }
         }
         i += 1;
     }
 
+    if let Some(socket_path) = daemon_socket {
+        process::exit(run_daemon(socket_path));
+    }
+
+    if diff_mode {
+        if shon_value.is_some() {
+            eprintln!("Error: Cannot combine --diff with SHON expression");
+            process::exit(2);
+        }
+        let (old_path, new_path) = match (input_path, second_input_path) {
+            (Some(old), Some(new)) => (old, new),
+            _ => {
+                eprintln!("Error: --diff requires two input files");
+                process::exit(2);
+            }
+        };
+        process::exit(run_diff(old_path, new_path));
+    }
+
+    if second_input_path.is_some() {
+        eprintln!("Error: Multiple input paths not supported");
+        process::exit(1);
+    }
+
+    if stats_mode {
+        if shon_value.is_some() {
+            eprintln!("Error: Cannot combine --stats with SHON expression");
+            process::exit(1);
+        }
+        let from = from_format.unwrap_or("meh");
+        if from != "yay" && from != "meh" {
+            eprintln!("Error: --stats supports yay and meh input");
+            process::exit(1);
+        }
+        process::exit(run_stats(input_path, from));
+    }
+
     // Cannot have both SHON and input format (SHON is its own input)
     if shon_value.is_some() && from_format.is_some() {
         eprintln!("Error: Cannot use -f/--from with SHON input");
@@ -268,9 +346,16 @@ fn main() {
                 eprintln!("Error: --output cannot be used with directory input");
                 process::exit(1);
             }
+            // Directory mode only processes .yay files, so sniffing
+            // reduces to the lenient default.
+            let dir_from = if from_format == "auto" {
+                "meh"
+            } else {
+                from_format
+            };
             process_directory(
                 path,
-                from_format,
+                dir_from,
                 output_format_str,
                 output_format,
                 write_back,
@@ -280,33 +365,39 @@ fn main() {
         }
     }
 
-    // Single file mode: always read raw bytes first, then derive string as needed.
-    // This avoids the double-read problem for CBOR and supports stdin uniformly.
-    let raw_bytes: Vec<u8> = match input_path {
-        Some(path) => match fs::read(path) {
-            Ok(bytes) => bytes,
-            Err(e) => {
-                eprintln!("Error reading {}: {}", path, e);
-                process::exit(1);
-            }
-        },
+    // Single file mode: get raw bytes first, then borrow a string view.
+    // This avoids the double-read problem for CBOR and supports stdin
+    // uniformly. Large regular files are memory-mapped instead of read,
+    // so the parse works over the page cache with no copy; stdin and
+    // small files use the buffered read.
+    let input_data: InputData = match input_path {
+        Some(path) => read_input_file(path),
         None => {
             let mut buffer = Vec::new();
             if let Err(e) = io::stdin().read_to_end(&mut buffer) {
                 eprintln!("Error reading stdin: {}", e);
                 process::exit(1);
             }
-            buffer
+            InputData::Owned(buffer)
         }
     };
+    let raw_bytes = input_data.bytes();
+
+    // --from auto samples the content now that the bytes are in hand.
+    let from_format = if from_format == "auto" {
+        detect_format(raw_bytes)
+    } else {
+        from_format
+    };
 
     let is_binary_input = from_format == "cbor";
-    let input: String = if is_binary_input {
+    let input: &str = if is_binary_input {
         // For CBOR, the string representation is unused by the parser,
         // but process_input still takes &str, so provide an empty string.
-        String::new()
+        ""
     } else {
-        match String::from_utf8(raw_bytes.clone()) {
+        // Validate UTF-8 once, borrowing straight from the bytes.
+        match std::str::from_utf8(raw_bytes) {
             Ok(s) => s,
             Err(e) => {
                 eprintln!("Error: input is not valid UTF-8: {}", e);
@@ -316,13 +407,13 @@ fn main() {
     };
 
     let input_bytes: Option<&[u8]> = if is_binary_input {
-        Some(&raw_bytes)
+        Some(raw_bytes)
     } else {
         None
     };
 
     let exit_code = process_input(
-        &input,
+        input,
         input_bytes,
         input_path,
         from_format,
@@ -335,6 +426,490 @@ fn main() {
     process::exit(exit_code);
 }
 
+/// Minimum size worth memory-mapping; smaller files are cheaper to read.
+const MMAP_THRESHOLD: u64 = 1 << 20;
+
+/// Buffer size for conversion output. Stdout is line-buffered by
+/// default, so large conversions piped to a consumer otherwise degrade
+/// into thousands of small writes; batching them into 1 MB chunks keeps
+/// the output path syscall-bound on the consumer, not us.
+const OUTPUT_BUF_SIZE: usize = 1 << 20;
+
+/// Input bytes, either owned or memory-mapped from a regular file.
+enum InputData {
+    Owned(Vec<u8>),
+    #[cfg(all(unix, target_pointer_width = "64"))]
+    Mapped(mmap::Mmap),
+}
+
+impl InputData {
+    fn bytes(&self) -> &[u8] {
+        match self {
+            InputData::Owned(bytes) => bytes,
+            #[cfg(all(unix, target_pointer_width = "64"))]
+            InputData::Mapped(map) => map.bytes(),
+        }
+    }
+}
+
+/// Read a file's bytes, memory-mapping large regular files and falling
+/// back to a buffered read for small files, special files, or mapping
+/// failures.
+fn read_input_file(path: &str) -> InputData {
+    #[cfg(all(unix, target_pointer_width = "64"))]
+    {
+        if let Ok(file) = fs::File::open(path) {
+            if let Ok(meta) = file.metadata() {
+                if meta.is_file() && meta.len() >= MMAP_THRESHOLD {
+                    if let Some(map) = mmap::Mmap::map(&file, meta.len() as usize) {
+                        return InputData::Mapped(map);
+                    }
+                }
+            }
+        }
+    }
+    match fs::read(path) {
+        Ok(bytes) => InputData::Owned(bytes),
+        Err(e) => {
+            eprintln!("Error reading {}: {}", path, e);
+            process::exit(1);
+        }
+    }
+}
+
+/// Parse one side of a --diff invocation, reusing the mmap-aware input
+/// path so 100 MB snapshots are compared over the page cache.
+fn parse_diff_input(path: &str) -> Value {
+    let data = read_input_file(path);
+    let input = match std::str::from_utf8(data.bytes()) {
+        Ok(s) => s,
+        Err(e) => {
+            eprintln!("Error: {} is not valid UTF-8: {}", path, e);
+            process::exit(2);
+        }
+    };
+    match parse_with_filename(input, Some(path)) {
+        Ok(value) => value,
+        Err(e) => {
+            eprintln!("Error: {}", e);
+            process::exit(2);
+        }
+    }
+}
+
+/// Compare two documents structurally and print one line per changed
+/// path. Exits like diff(1): 0 when identical, 1 when different, 2 on
+/// trouble.
+fn run_diff(old_path: &str, new_path: &str) -> i32 {
+    let old = parse_diff_input(old_path);
+    let new = parse_diff_input(new_path);
+    let changes = diff(&old, &new);
+    if changes.is_empty() {
+        return 0;
+    }
+    let stdout = io::stdout();
+    let mut out = io::BufWriter::new(stdout.lock());
+    for entry in &changes {
+        let result = match entry.op {
+            DiffOp::Added => writeln!(
+                out,
+                "+ {}: {}",
+                entry.path,
+                entry.new.as_deref().unwrap_or("")
+            ),
+            DiffOp::Removed => writeln!(
+                out,
+                "- {}: {}",
+                entry.path,
+                entry.old.as_deref().unwrap_or("")
+            ),
+            DiffOp::Changed => writeln!(
+                out,
+                "~ {}: {} -> {}",
+                entry.path,
+                entry.old.as_deref().unwrap_or(""),
+                entry.new.as_deref().unwrap_or("")
+            ),
+        };
+        if result.is_err() {
+            // Broken pipe; the consumer has seen all it wants
+            break;
+        }
+    }
+    1
+}
+
+// ---------------------------------------------------------------------------
+// --stats mode
+//
+// When a file is slow there is no way to see from the outside whether
+// the time went to scanning, lexing, parsing, or MEH formatting.
+// `--stats` runs the same pipeline the normal path would, timing each
+// phase, and reports per-file throughput plus peak RSS — enough to pick
+// the pathological files out of a corpus.
+// ---------------------------------------------------------------------------
+
+/// Wall time of each pipeline phase over one document.
+struct PhaseStats {
+    bytes: usize,
+    scan: Duration,
+    lex: Duration,
+    parse: Duration,
+    format: Duration,
+}
+
+impl PhaseStats {
+    fn new() -> PhaseStats {
+        PhaseStats {
+            bytes: 0,
+            scan: Duration::ZERO,
+            lex: Duration::ZERO,
+            parse: Duration::ZERO,
+            format: Duration::ZERO,
+        }
+    }
+
+    fn total(&self) -> Duration {
+        self.scan + self.lex + self.parse + self.format
+    }
+
+    fn add(&mut self, other: &PhaseStats) {
+        self.bytes += other.bytes;
+        self.scan += other.scan;
+        self.lex += other.lex;
+        self.parse += other.parse;
+        self.format += other.format;
+    }
+}
+
+/// Time each phase of the standard pipeline over one document, calling
+/// the same phase entry points libyay exports for the streaming paths.
+/// MEH input formats first and parses the canonical text, strict YAY
+/// parses the input directly then formats it — matching what
+/// process_input actually runs for each.
+fn measure_phases(
+    input: &str,
+    filename: Option<&str>,
+    from_format: &str,
+) -> Result<PhaseStats, String> {
+    let mut stats = PhaseStats::new();
+    stats.bytes = input.len();
+
+    let canonical;
+    let parse_source: &str = if from_format == "meh" {
+        let start = Instant::now();
+        canonical = format_yay(input).map_err(|e| e.to_string())?;
+        stats.format = start.elapsed();
+        &canonical
+    } else {
+        input
+    };
+
+    let ctx = libyay::ParseContext::new(filename);
+    let start = Instant::now();
+    let scanned = libyay::scanner::scan(parse_source, &ctx).map_err(|e| e.to_string())?;
+    stats.scan = start.elapsed();
+
+    let start = Instant::now();
+    let tokens = libyay::lexer::outline_lex(&scanned);
+    stats.lex = start.elapsed();
+
+    let start = Instant::now();
+    libyay::parser::parse_root(&tokens, &ctx, scanned.had_comments).map_err(|e| e.to_string())?;
+    stats.parse = start.elapsed();
+
+    if from_format == "yay" {
+        let start = Instant::now();
+        format_yay(input).map_err(|e| e.to_string())?;
+        stats.format = start.elapsed();
+    }
+
+    Ok(stats)
+}
+
+fn fmt_mb(bytes: usize) -> String {
+    if bytes < 1024 * 1024 {
+        format!("{:.1} KB", bytes as f64 / 1024.0)
+    } else {
+        format!("{:.1} MB", bytes as f64 / (1024.0 * 1024.0))
+    }
+}
+
+fn fmt_ms(d: Duration) -> String {
+    let ms = d.as_secs_f64() * 1000.0;
+    if ms < 1.0 {
+        format!("{}us", d.as_micros())
+    } else {
+        format!("{:.1}ms", ms)
+    }
+}
+
+fn fmt_rate(bytes: usize, d: Duration) -> String {
+    let secs = d.as_secs_f64();
+    if secs <= 0.0 {
+        return "-".to_string();
+    }
+    format!("{:.1} MB/s", bytes as f64 / (1024.0 * 1024.0) / secs)
+}
+
+fn print_stats_line(label: &str, stats: &PhaseStats) {
+    println!(
+        "{}: {} in {} ({})  scan {}  lex {}  parse {}  format {}",
+        label,
+        fmt_mb(stats.bytes),
+        fmt_ms(stats.total()),
+        fmt_rate(stats.bytes, stats.total()),
+        fmt_ms(stats.scan),
+        fmt_ms(stats.lex),
+        fmt_ms(stats.parse),
+        fmt_ms(stats.format),
+    );
+}
+
+/// Run `--stats` over a file, stdin, or every .yay file in a directory.
+fn run_stats(input_path: Option<&str>, from_format: &str) -> i32 {
+    let mut had_errors = false;
+
+    if let Some(path) = input_path.filter(|p| Path::new(p).is_dir()) {
+        let entries = match fs::read_dir(path) {
+            Ok(e) => e,
+            Err(e) => {
+                eprintln!("Error reading directory {}: {}", path, e);
+                return 1;
+            }
+        };
+        let mut paths: Vec<std::path::PathBuf> = entries
+            .flatten()
+            .map(|entry| entry.path())
+            .filter(|p| p.extension().map(|e| e == "yay").unwrap_or(false))
+            .collect();
+        paths.sort();
+
+        let mut totals = PhaseStats::new();
+        let mut files = 0usize;
+        for file in &paths {
+            let file_str = file.to_string_lossy();
+            let input = match fs::read_to_string(file) {
+                Ok(content) => content,
+                Err(e) => {
+                    eprintln!("Error reading {}: {}", file_str, e);
+                    had_errors = true;
+                    continue;
+                }
+            };
+            match measure_phases(&input, Some(&file_str), from_format) {
+                Ok(stats) => {
+                    print_stats_line(&file_str, &stats);
+                    totals.add(&stats);
+                    files += 1;
+                }
+                Err(e) => {
+                    eprintln!("{}: {}", file_str, e);
+                    had_errors = true;
+                }
+            }
+        }
+        let total_label = format!("total ({} files)", files);
+        print_stats_line(&total_label, &totals);
+    } else {
+        let input = match input_path {
+            Some(path) => {
+                let data = read_input_file(path);
+                match std::str::from_utf8(data.bytes()) {
+                    Ok(s) => s.to_string(),
+                    Err(e) => {
+                        eprintln!("Error: input is not valid UTF-8: {}", e);
+                        return 1;
+                    }
+                }
+            }
+            None => {
+                let mut buffer = String::new();
+                if let Err(e) = io::stdin().read_to_string(&mut buffer) {
+                    eprintln!("Error reading stdin: {}", e);
+                    return 1;
+                }
+                buffer
+            }
+        };
+        match measure_phases(&input, input_path, from_format) {
+            Ok(stats) => print_stats_line(input_path.unwrap_or("(stdin)"), &stats),
+            Err(e) => {
+                eprintln!("Error: {}", e);
+                return 1;
+            }
+        }
+    }
+
+    if let Some(rss) = rusage::peak_rss_bytes() {
+        println!("peak RSS: {}", fmt_mb(rss as usize));
+    }
+
+    if had_errors {
+        1
+    } else {
+        0
+    }
+}
+
+/// Peak resident set size via getrusage, calling the C library the
+/// binary already links instead of pulling in a crate.
+mod rusage {
+    #[repr(C)]
+    struct Timeval {
+        tv_sec: i64,
+        tv_usec: i64,
+    }
+
+    #[repr(C)]
+    struct Rusage {
+        ru_utime: Timeval,
+        ru_stime: Timeval,
+        ru_maxrss: i64,
+        // The rest of the struct is unused here but must be present so
+        // getrusage has the full buffer to fill in.
+        _unused: [i64; 16],
+    }
+
+    extern "C" {
+        fn getrusage(who: i32, usage: *mut Rusage) -> i32;
+    }
+
+    /// Peak resident set size in bytes, or None if the call fails.
+    pub fn peak_rss_bytes() -> Option<u64> {
+        const RUSAGE_SELF: i32 = 0;
+        let mut usage = Rusage {
+            ru_utime: Timeval {
+                tv_sec: 0,
+                tv_usec: 0,
+            },
+            ru_stime: Timeval {
+                tv_sec: 0,
+                tv_usec: 0,
+            },
+            ru_maxrss: 0,
+            _unused: [0; 16],
+        };
+        if unsafe { getrusage(RUSAGE_SELF, &mut usage) } != 0 {
+            return None;
+        }
+        // Linux reports kilobytes, macOS bytes.
+        #[cfg(target_os = "macos")]
+        let bytes = usage.ru_maxrss as u64;
+        #[cfg(not(target_os = "macos"))]
+        let bytes = usage.ru_maxrss as u64 * 1024;
+        Some(bytes)
+    }
+}
+
+/// Minimal read-only memory mapping for regular files, calling the C
+/// library the binary already links instead of pulling in a crate.
+#[cfg(all(unix, target_pointer_width = "64"))]
+mod mmap {
+    use std::fs::File;
+    use std::os::unix::io::AsRawFd;
+
+    const PROT_READ: i32 = 1;
+    const MAP_PRIVATE: i32 = 2;
+
+    extern "C" {
+        fn mmap(addr: *mut u8, len: usize, prot: i32, flags: i32, fd: i32, offset: i64) -> *mut u8;
+        fn munmap(addr: *mut u8, len: usize) -> i32;
+    }
+
+    pub struct Mmap {
+        ptr: *mut u8,
+        len: usize,
+    }
+
+    impl Mmap {
+        /// Map a file read-only. Returns None if the mapping fails, in
+        /// which case the caller falls back to a buffered read.
+        pub fn map(file: &File, len: usize) -> Option<Mmap> {
+            if len == 0 {
+                return None;
+            }
+            let ptr = unsafe {
+                mmap(
+                    std::ptr::null_mut(),
+                    len,
+                    PROT_READ,
+                    MAP_PRIVATE,
+                    file.as_raw_fd(),
+                    0,
+                )
+            };
+            if ptr as isize == -1 {
+                return None;
+            }
+            Some(Mmap { ptr, len })
+        }
+
+        pub fn bytes(&self) -> &[u8] {
+            unsafe { std::slice::from_raw_parts(self.ptr, self.len) }
+        }
+    }
+
+    impl Drop for Mmap {
+        fn drop(&mut self) {
+            unsafe {
+                munmap(self.ptr, self.len);
+            }
+        }
+    }
+}
+
+/// Guess the input format by sampling the first KB of content, so
+/// mixed archives convert in one invocation instead of one trial parse
+/// per candidate format. The signatures are cheap heuristics; the
+/// chosen decoder still fully validates the input.
+fn detect_format(bytes: &[u8]) -> &'static str {
+    // Binary first: CBOR documents open with a major-type header, and
+    // text formats never start with a high or non-whitespace control
+    // byte.
+    match bytes.first() {
+        None => return "meh",
+        Some(&b) if b >= 0x80 || (b < 0x20 && !b" \t\n\r".contains(&b)) => return "cbor",
+        _ => {}
+    }
+
+    let sample = &bytes[..bytes.len().min(1024)];
+    let text = String::from_utf8_lossy(sample);
+    for line in text.lines() {
+        let trimmed = line.trim();
+        // Comment and blank lines are shared by YAY, TOML, and YAML and
+        // decide nothing.
+        if trimmed.is_empty() || trimmed.starts_with('#') {
+            continue;
+        }
+        if trimmed == "---" || trimmed.starts_with("%YAML") {
+            return "yaml";
+        }
+        if trimmed.starts_with('{') {
+            return "yson";
+        }
+        if trimmed.starts_with('[') {
+            // A TOML table header is a bracketed name alone on its
+            // line; anything else bracket-first reads as a JSON/YSON
+            // array.
+            if trimmed.ends_with(']') && !trimmed.contains(',') && !trimmed.contains(':') {
+                return "toml";
+            }
+            return "yson";
+        }
+        // An assignment before any colon is TOML's key = value shape;
+        // colon-first lines are YAY/MEH territory.
+        match (trimmed.find('='), trimmed.find(':')) {
+            (Some(eq), Some(colon)) if eq < colon => return "toml",
+            (Some(_), None) => return "toml",
+            _ => {}
+        }
+        // The first significant line decides; default to lenient YAY.
+        break;
+    }
+    "meh"
+}
+
 fn parse_format(s: &str) -> Format {
     match s {
         "yay" | "meh" => Format::Yay,
@@ -377,6 +952,133 @@ fn format_extension(format: Format) -> &'static str {
     }
 }
 
+/// Buffered result of processing one file, so workers can run
+/// concurrently while diagnostics print in deterministic order.
+struct FileOutcome {
+    out: String,
+    err: String,
+    code: i32,
+    /// True when --write actually rewrote the file; unchanged files are
+    /// left untouched so their mtimes stay stable.
+    changed: bool,
+    /// Content hash of the file once it is known clean (checked ok, or
+    /// in canonical form after formatting), for the persistent cache.
+    clean_hash: Option<u64>,
+}
+
+/// Process one .yay file with buffered diagnostics instead of printing.
+/// Covers the directory modes: --check and YAY/MEH to YAY formatting,
+/// mirroring the corresponding branches of process_input.
+fn process_file_buffered(
+    path: &Path,
+    from_format: &str,
+    check_only: bool,
+    write_back: bool,
+    clean_cache: Option<&cache::CleanCache>,
+) -> FileOutcome {
+    let path_str = path.to_string_lossy();
+    let mut outcome = FileOutcome {
+        out: String::new(),
+        err: String::new(),
+        code: 0,
+        changed: false,
+        clean_hash: None,
+    };
+
+    let input = match fs::read_to_string(path) {
+        Ok(content) => content,
+        Err(e) => {
+            outcome.err = format!("Error reading {}: {}\n", path_str, e);
+            outcome.code = 1;
+            return outcome;
+        }
+    };
+
+    // Unchanged since a previous run: a check hit means the content
+    // already validated, a format hit means it is already canonical.
+    // Either way there is no parsing left to do.
+    let hash = clean_cache.map(|_| cache::content_hash(input.as_bytes()));
+    if let (Some(clean_cache), Some(hash)) = (clean_cache, hash) {
+        if clean_cache.contains(hash) {
+            outcome.clean_hash = Some(hash);
+            if check_only {
+                outcome.out = format!("{}: ok\n", path_str);
+            }
+            return outcome;
+        }
+    }
+
+    // For strict YAY mode (--from yay), validate with strict parser first
+    if from_format == "yay" {
+        let filename = path
+            .file_name()
+            .map(|n| n.to_string_lossy().to_string())
+            .unwrap_or_else(|| path_str.to_string());
+        if let Err(e) = validate_with_filename(&input, Some(&filename)) {
+            outcome.err = format!("{}: {}\n", path_str, e);
+            outcome.code = 1;
+            return outcome;
+        }
+        if check_only {
+            outcome.out = format!("{}: ok\n", path_str);
+            outcome.clean_hash = hash;
+            return outcome;
+        }
+    }
+
+    if check_only {
+        // For MEH, validate with MEH parser
+        match format_yay(&input) {
+            Ok(_) => {
+                outcome.out = format!("{}: ok\n", path_str);
+                outcome.clean_hash = hash;
+            }
+            Err(e) => {
+                outcome.err = format!("{}: {}\n", path_str, e);
+                outcome.code = 1;
+            }
+        }
+        return outcome;
+    }
+
+    let output = match format_yay(&input) {
+        Ok(s) => s,
+        Err(e) => {
+            outcome.err = format!("{}: {}\n", path_str, e);
+            outcome.code = 1;
+            return outcome;
+        }
+    };
+
+    if write_back {
+        // Already canonical: leave the file alone rather than dirty its
+        // mtime and trigger downstream rebuilds for a byte-identical
+        // write.
+        if output == input {
+            outcome.clean_hash = hash;
+            return outcome;
+        }
+        // Workers write distinct files, so this is safe concurrently.
+        if let Err(e) = fs::write(path, &output) {
+            outcome.err = format!("Error writing {}: {}\n", path.display(), e);
+            outcome.code = 1;
+        } else {
+            outcome.changed = true;
+            // The rewritten file is canonical by construction, so the
+            // next run can skip it too.
+            if clean_cache.is_some() {
+                outcome.clean_hash = Some(cache::content_hash(output.as_bytes()));
+            }
+        }
+    } else {
+        outcome.out = output;
+        if !outcome.out.ends_with('\n') {
+            outcome.out.push('\n');
+        }
+    }
+    outcome
+}
+
 fn process_directory(
     dir_path: &str,
     from_format: &str,
@@ -393,40 +1095,347 @@ fn process_directory(
         }
     };
 
+    // Sort for deterministic processing and diagnostics order.
+    let mut paths: Vec<std::path::PathBuf> = entries
+        .flatten()
+        .map(|entry| entry.path())
+        .filter(|path| path.extension().map(|e| e == "yay").unwrap_or(false))
+        .collect();
+    paths.sort();
+
     let mut had_errors = false;
 
-    for entry in entries.flatten() {
-        let path = entry.path();
-        if path.extension().map(|e| e == "yay").unwrap_or(false) {
-            let path_str = path.to_string_lossy();
-            let input = match fs::read_to_string(&path) {
-                Ok(content) => content,
-                Err(e) => {
-                    eprintln!("Error reading {}: {}", path_str, e);
-                    had_errors = true;
-                    continue;
+    // The common directory modes (--check and YAY/MEH formatting) are
+    // pure per-file work, so fan them out across cores. Workers claim
+    // files from a shared counter and buffer their diagnostics; the main
+    // thread prints outcomes in path order afterwards.
+    let parallel = (from_format == "yay" || from_format == "meh")
+        && (check_only || output_format_str == "yay");
+    if parallel {
+        // Repeated runs over a large tree mostly revisit unchanged
+        // files, so consult the persistent clean-content cache before
+        // parsing. Only check and --write runs cache: a format run to
+        // stdout has to produce its output either way.
+        let clean_cache = if check_only || write_back {
+            cache::CleanCache::load(if check_only { "check" } else { "format" }, from_format)
+        } else {
+            None
+        };
+        let jobs = std::thread::available_parallelism()
+            .map(|n| n.get())
+            .unwrap_or(1)
+            .min(paths.len().max(1));
+        let next = std::sync::atomic::AtomicUsize::new(0);
+        let results = std::sync::Mutex::new(vec![None; paths.len()]);
+
+        std::thread::scope(|scope| {
+            for _ in 0..jobs {
+                scope.spawn(|| loop {
+                    let i = next.fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+                    if i >= paths.len() {
+                        break;
+                    }
+                    let outcome = process_file_buffered(
+                        &paths[i],
+                        from_format,
+                        check_only,
+                        write_back,
+                        clean_cache.as_ref(),
+                    );
+                    results.lock().unwrap()[i] = Some((
+                        outcome.out,
+                        outcome.err,
+                        outcome.code,
+                        outcome.changed,
+                        outcome.clean_hash,
+                    ));
+                });
+            }
+        });
+
+        let stdout = io::stdout();
+        let mut handle = stdout.lock();
+        let mut changed = 0usize;
+        let mut clean_hashes = std::collections::HashSet::new();
+        for result in results.into_inner().unwrap() {
+            let (out, err, code, file_changed, clean_hash) = result.expect("worker skipped a file");
+            let _ = handle.write_all(out.as_bytes());
+            eprint!("{}", err);
+            if code != 0 {
+                had_errors = true;
+            }
+            if file_changed {
+                changed += 1;
+            }
+            if let Some(hash) = clean_hash {
+                clean_hashes.insert(hash);
+            }
+        }
+        if let Some(clean_cache) = &clean_cache {
+            clean_cache.save(&clean_hashes);
+        }
+        if write_back {
+            let _ = writeln!(handle, "{} of {} files changed", changed, paths.len());
+        }
+        drop(handle);
+        process::exit(if had_errors { 1 } else { 0 });
+    }
+
+    for path in &paths {
+        let path_str = path.to_string_lossy();
+        let input = match fs::read_to_string(path) {
+            Ok(content) => content,
+            Err(e) => {
+                eprintln!("Error reading {}: {}", path_str, e);
+                had_errors = true;
+                continue;
+            }
+        };
+
+        let exit_code = process_input(
+            &input,
+            None,
+            Some(&path_str),
+            from_format,
+            output_format_str,
+            output_format,
+            None,
+            write_back,
+            check_only,
+        );
+
+        if exit_code != 0 {
+            had_errors = true;
+        }
+    }
+
+    process::exit(if had_errors { 1 } else { 0 });
+}
+
+// ---------------------------------------------------------------------------
+// Daemon mode
+//
+// Editor and pre-commit integrations shell out once per file, and for
+// small files process startup dominates the actual work. `--daemon`
+// keeps a warm process listening on a unix socket and serves
+// format/check/convert requests from it.
+//
+// Protocol (one request per connection):
+//   request:  "<op> <from> <to>\n" where op is format, check, convert,
+//             or stop, followed by either "path <file>\n" or
+//             "content <byte-count>\n" and that many raw bytes.
+//   response: "ok <byte-count>\n" or "err <byte-count>\n" followed by
+//             the output or error message.
+// ---------------------------------------------------------------------------
+
+fn run_daemon(socket_path: &str) -> i32 {
+    use std::os::unix::net::{UnixListener, UnixStream};
+
+    // Replace a socket left behind by a dead daemon, but refuse to
+    // displace a live one.
+    if Path::new(socket_path).exists() {
+        if UnixStream::connect(socket_path).is_ok() {
+            eprintln!("Error: a daemon is already listening on {}", socket_path);
+            return 1;
+        }
+        let _ = fs::remove_file(socket_path);
+    }
+
+    let listener = match UnixListener::bind(socket_path) {
+        Ok(l) => l,
+        Err(e) => {
+            eprintln!("Error binding {}: {}", socket_path, e);
+            return 1;
+        }
+    };
+    eprintln!("yay daemon listening on {}", socket_path);
+
+    // Requests are small per-file jobs, so connections are served one
+    // at a time; a request is answered and the connection closed before
+    // the next accept.
+    for stream in listener.incoming() {
+        match stream {
+            Ok(stream) => {
+                if serve_daemon_connection(stream) {
+                    break; // stop requested
                 }
-            };
+            }
+            Err(e) => {
+                eprintln!("Error accepting connection: {}", e);
+            }
+        }
+    }
 
-            let exit_code = process_input(
-                &input,
-                None,
-                Some(&path_str),
-                from_format,
-                output_format_str,
-                output_format,
-                None,
-                write_back,
-                check_only,
+    let _ = fs::remove_file(socket_path);
+    0
+}
+
+/// Serve one request on an accepted connection. Returns true when the
+/// client asked the daemon to stop.
+fn serve_daemon_connection(stream: std::os::unix::net::UnixStream) -> bool {
+    let mut reader = io::BufReader::new(stream);
+
+    let mut header = String::new();
+    if io::BufRead::read_line(&mut reader, &mut header).is_err() {
+        return false;
+    }
+    let mut parts = header.split_whitespace();
+    let (op, from_format, to_format) = match (parts.next(), parts.next(), parts.next()) {
+        (Some("stop"), _, _) => {
+            respond_daemon(reader.into_inner(), true, b"");
+            return true;
+        }
+        (Some(op), Some(from), Some(to)) => (op.to_string(), from.to_string(), to.to_string()),
+        _ => {
+            respond_daemon(
+                reader.into_inner(),
+                false,
+                b"malformed request header; expected: <op> <from> <to>",
             );
+            return false;
+        }
+    };
+
+    let input = match read_daemon_source(&mut reader) {
+        Ok(bytes) => bytes,
+        Err(e) => {
+            respond_daemon(reader.into_inner(), false, e.as_bytes());
+            return false;
+        }
+    };
+
+    let result = match op.as_str() {
+        "check" => check_buffered(&input, &from_format).map(|()| b"ok\n".to_vec()),
+        "format" => convert_buffered(&input, &from_format, "yay"),
+        "convert" => convert_buffered(&input, &from_format, &to_format),
+        other => Err(format!("unknown operation: {}", other)),
+    };
+
+    match result {
+        Ok(output) => respond_daemon(reader.into_inner(), true, &output),
+        Err(e) => respond_daemon(reader.into_inner(), false, e.as_bytes()),
+    }
+    false
+}
+
+/// Read the source half of a daemon request: either a path to load or
+/// an inline content block.
+fn read_daemon_source(
+    reader: &mut io::BufReader<std::os::unix::net::UnixStream>,
+) -> Result<Vec<u8>, String> {
+    let mut line = String::new();
+    io::BufRead::read_line(reader, &mut line).map_err(|e| format!("read error: {}", e))?;
+    let line = line.trim_end();
+    if let Some(path) = line.strip_prefix("path ") {
+        fs::read(path).map_err(|e| format!("Error reading {}: {}", path, e))
+    } else if let Some(count) = line.strip_prefix("content ") {
+        let count: usize = count
+            .parse()
+            .map_err(|_| format!("bad content length: {}", count))?;
+        let mut bytes = vec![0u8; count];
+        reader
+            .read_exact(&mut bytes)
+            .map_err(|e| format!("read error: {}", e))?;
+        Ok(bytes)
+    } else {
+        Err(format!(
+            "malformed source line: {:?}; expected \"path <file>\" or \"content <byte-count>\"",
+            line
+        ))
+    }
+}
+
+fn respond_daemon(stream: std::os::unix::net::UnixStream, ok: bool, payload: &[u8]) {
+    let mut writer = io::BufWriter::new(stream);
+    let status = if ok { "ok" } else { "err" };
+    let _ = writeln!(writer, "{} {}", status, payload.len());
+    let _ = writer.write_all(payload);
+    let _ = writer.flush();
+}
+
+/// Validate input without producing output: the daemon-side equivalent
+/// of --check.
+fn check_buffered(input: &[u8], from_format: &str) -> Result<(), String> {
+    let text =
+        || std::str::from_utf8(input).map_err(|e| format!("input is not valid UTF-8: {}", e));
+    let from_format = if from_format == "auto" {
+        detect_format(input)
+    } else {
+        from_format
+    };
+    match from_format {
+        "yay" => validate_with_filename(text()?, None).map_err(|e| e.to_string()),
+        "meh" => format_yay(text()?).map(|_| ()),
+        "json" | "yson" => parse_yson(text()?).map(|_| ()),
+        "yaml" | "yml" => transcode::yaml::decode(text()?).map(|_| ()),
+        "toml" => transcode::toml::decode(text()?).map(|_| ()),
+        "cbor" => transcode::cbor::decode(input).map(|_| ()),
+        other => Err(format!("Unknown input format: {}", other)),
+    }
+}
+
+/// Run one conversion entirely in memory: the daemon-side equivalent of
+/// the tree path through process_input.
+fn convert_buffered(
+    input: &[u8],
+    from_format: &str,
+    output_format_str: &str,
+) -> Result<Vec<u8>, String> {
+    let text =
+        || std::str::from_utf8(input).map_err(|e| format!("input is not valid UTF-8: {}", e));
+    let from_format = if from_format == "auto" {
+        detect_format(input)
+    } else {
+        from_format
+    };
+
+    // YAY/MEH to YAY goes through the MEH formatter to preserve
+    // comments and key order, like the one-shot path.
+    if (from_format == "yay" || from_format == "meh") && output_format_str == "yay" {
+        let text = text()?;
+        if from_format == "yay" {
+            validate_with_filename(text, None).map_err(|e| e.to_string())?;
+        }
+        return format_yay(text).map(String::into_bytes);
+    }
 
-            if exit_code != 0 {
-                had_errors = true;
-            }
+    let value: Value = match from_format {
+        "yay" => parse(text()?).map_err(|e| e.to_string())?,
+        "meh" => {
+            let canonical = format_yay(text()?)?;
+            parse(&canonical).map_err(|e| e.to_string())?
+        }
+        "json" | "yson" => parse_yson(text()?)?,
+        "yaml" | "yml" => transcode::yaml::decode(text()?)?,
+        "toml" => transcode::toml::decode(text()?)?,
+        "cbor" => transcode::cbor::decode(input)?,
+        other => return Err(format!("Unknown input format: {}", other)),
+    };
+
+    let output_format = parse_format(output_format_str);
+    if output_format == Format::Json {
+        if let Some(reason) = value.json_incompatibility() {
+            return Err(format!(
+                "Cannot convert to JSON because the document contains {}.",
+                reason
+            ));
         }
     }
 
-    process::exit(if had_errors { 1 } else { 0 });
+    match output_format {
+        Format::Yaml => transcode::yaml::encode(&value).map(String::into_bytes),
+        Format::Toml => transcode::toml::encode(&value).map(String::into_bytes),
+        Format::Cbor => transcode::cbor::encode(&value),
+        Format::CborDiag => {
+            let bytes = transcode::cbor::encode(&value)?;
+            transcode::cbor::diagnostic(&bytes).map(String::into_bytes)
+        }
+        _ => {
+            let mut output = libyay::encode(&value, output_format).into_bytes();
+            output.push(b'\n');
+            Ok(output)
+        }
+    }
 }
 
 #[allow(clippy::too_many_arguments)]
@@ -448,9 +1457,44 @@ fn process_input(
             .unwrap_or_else(|| p.to_string())
     });
 
-    // For strict YAY mode (--from yay), validate with strict parser first
+    // Streaming fast path: a straight YAY → JSON/YSON conversion of a
+    // root-level list pipes items from the parser to the encoder, so
+    // large dumps convert without building the whole tree in memory.
+    if !check_only
+        && from_format == "yay"
+        && (output_format == Format::Json || output_format == Format::Yson)
+    {
+        if let Some(code) = stream_root_list(
+            input,
+            filename.as_deref(),
+            input_file,
+            output_format,
+            output_file,
+            write_back,
+        ) {
+            return code;
+        }
+    }
+
+    // Likewise, a root-level CBOR array streams element by element to
+    // the YAY/JSON/YSON encoder, so multi-gigabyte archives transcode
+    // in memory bounded by the largest element.
+    if !check_only
+        && from_format == "cbor"
+        && matches!(output_format, Format::Yay | Format::Json | Format::Yson)
+    {
+        let bytes = input_bytes.unwrap_or(input.as_bytes());
+        if let Some(code) =
+            stream_cbor_root_list(bytes, input_file, output_format, output_file, write_back)
+        {
+            return code;
+        }
+    }
+
+    // For strict YAY mode (--from yay), validate with strict parser first.
+    // Validation drops each root entry as it goes, so no tree is built.
     if from_format == "yay" {
-        match parse_with_filename(input, filename.as_deref()) {
+        match validate_with_filename(input, filename.as_deref()) {
             Ok(_) => {
                 // Strict parse succeeded, continue to MEH processing
             }
@@ -556,8 +1600,14 @@ fn process_input(
 
         if from_format == "cbor" {
             let bytes = input_bytes.unwrap_or(input.as_bytes());
-            match transcode::cbor::decode(bytes) {
-                Ok(_) => {
+            // Root-level arrays are checked element by element so large
+            // archives validate without building the whole tree.
+            let result = match transcode::cbor::decode_root_array_each(bytes, &mut |_| Ok(())) {
+                Some(r) => r,
+                None => transcode::cbor::decode(bytes).map(|_| ()),
+            };
+            match result {
+                Ok(()) => {
                     if let Some(path) = input_file {
                         println!("{}: ok", path);
                     }
@@ -725,15 +1775,9 @@ fn process_input(
                 return 1;
             }
         },
-        Format::Cbor => match transcode::cbor::encode(&value) {
-            Ok(bytes) => {
-                write_binary_output(&bytes, output_file, write_back, input_file, output_format);
-            }
-            Err(e) => {
-                eprintln!("Error: Cannot convert to CBOR: {}", e);
-                return 1;
-            }
-        },
+        Format::Cbor => {
+            write_cbor_output(&value, output_file, write_back, input_file);
+        }
         Format::CborDiag => {
             // Encode to CBOR bytes first, then render as diagnostic notation.
             // This ensures the diagnostic output reflects the actual wire encoding.
@@ -760,9 +1804,8 @@ fn process_input(
             }
         }
         _ => {
-            // Use libyay's encode for all other formats
-            let output = encode(&value, output_format);
-            write_text_output(&output, output_file, write_back, input_file, output_format);
+            // Use libyay's streaming encoder for all other formats
+            write_value_output(&value, output_file, write_back, input_file, output_format);
         }
     }
 
@@ -781,8 +1824,7 @@ fn output_value(
 ) -> i32 {
     // For SHON → YAY, encode via the standard encoder
     if output_format_str == "yay" {
-        let output = encode(value, Format::Yay);
-        write_text_output(&output, output_file, write_back, input_file, output_format);
+        write_value_output(value, output_file, write_back, input_file, Format::Yay);
         return 0;
     }
 
@@ -818,15 +1860,9 @@ fn output_value(
                 return 1;
             }
         },
-        Format::Cbor => match transcode::cbor::encode(value) {
-            Ok(bytes) => {
-                write_binary_output(&bytes, output_file, write_back, input_file, output_format);
-            }
-            Err(e) => {
-                eprintln!("Error: Cannot convert to CBOR: {}", e);
-                return 1;
-            }
-        },
+        Format::Cbor => {
+            write_cbor_output(value, output_file, write_back, input_file);
+        }
         Format::CborDiag => match transcode::cbor::encode(value) {
             Ok(bytes) => match transcode::cbor::diagnostic(&bytes) {
                 Ok(output) => {
@@ -843,14 +1879,25 @@ fn output_value(
             }
         },
         _ => {
-            let output = encode(value, output_format);
-            write_text_output(&output, output_file, write_back, input_file, output_format);
+            write_value_output(value, output_file, write_back, input_file, output_format);
         }
     }
 
     0
 }
 
+/// True when `path` already holds exactly `output`, so writing it again
+/// would only dirty the mtime and trigger downstream rebuilds. Checks
+/// the length from metadata before reading; any error counts as changed
+/// and lets the write report it.
+fn write_is_noop(path: &Path, output: &[u8]) -> bool {
+    match fs::metadata(path) {
+        Ok(meta) if meta.len() == output.len() as u64 => {}
+        _ => return false,
+    }
+    matches!(fs::read(path), Ok(existing) if existing == output)
+}
+
 fn write_text_output(
     output: &str,
     output_file: Option<&str>,
@@ -867,6 +1914,9 @@ fn write_text_output(
         if let Some(input_path) = input_file {
             let ext = format_extension(format);
             let output_path = Path::new(input_path).with_extension(ext);
+            if write_is_noop(&output_path, output.as_bytes()) {
+                return;
+            }
             if let Err(e) = fs::write(&output_path, output) {
                 eprintln!("Error writing {}: {}", output_path.display(), e);
                 process::exit(1);
@@ -876,46 +1926,539 @@ fn write_text_output(
             process::exit(1);
         }
     } else {
-        print!("{}", output);
-        // Ensure output ends with newline
-        if !output.ends_with('\n') {
-            println!();
+        let stdout = io::stdout();
+        let mut handle = io::BufWriter::with_capacity(OUTPUT_BUF_SIZE, stdout.lock());
+        let result = handle.write_all(output.as_bytes()).and_then(|()| {
+            // Ensure output ends with newline
+            if !output.ends_with('\n') {
+                handle.write_all(b"\n")?;
+            }
+            handle.flush()
+        });
+        if let Err(e) = result {
+            eprintln!("Error writing to stdout: {}", e);
+            process::exit(1);
+        }
+    }
+}
+
+/// Stream a root-level list straight from the parser to the JSON/YSON
+/// encoder, one item at a time, without building the document tree.
+/// Returns None when the document is not a root list (or fails to
+/// scan), in which case the caller falls back to the tree path.
+fn stream_root_list(
+    input: &str,
+    filename: Option<&str>,
+    input_file: Option<&str>,
+    output_format: Format,
+    output_file: Option<&str>,
+    write_back: bool,
+) -> Option<i32> {
+    let ctx = libyay::ParseContext::new(filename);
+    let scanned = match libyay::scanner::scan(input, &ctx) {
+        Ok(s) => s,
+        Err(_) => return None, // let the tree path report scan errors
+    };
+    let tokens = libyay::lexer::outline_lex(&scanned);
+    if !libyay::parser::root_is_list(&tokens) {
+        return None;
+    }
+
+    // Open the destination only once streaming is certain.
+    let writer = match open_stream_output(output_file, write_back, input_file, output_format) {
+        Ok(w) => w,
+        Err(code) => return Some(code),
+    };
+    let to_stdout = output_file.is_none() && !write_back;
+
+    let mut encoder = libyay::RootListEncoder::new(writer, output_format);
+    let mut incompatibility = None;
+    let mut write_error = None;
+    let result = libyay::parser::parse_root_items(&tokens, &ctx, &mut |item| {
+        if output_format == Format::Json {
+            if let Some(reason) = item.json_incompatibility() {
+                incompatibility = Some(reason);
+                return Err(libyay::ParseError::Generic(String::new()));
+            }
+        }
+        encoder.push(&item).map_err(|e| {
+            write_error = Some(e);
+            libyay::ParseError::Generic(String::new())
+        })
+    });
+
+    match result {
+        Ok(()) => {
+            if let Err(e) = encoder.finish() {
+                eprintln!("Error writing output: {}", e);
+                return Some(1);
+            }
+            if to_stdout {
+                // Terminate the line like write_text_output does.
+                println!();
+            }
+            Some(0)
+        }
+        Err(_) if incompatibility.is_some() => {
+            eprintln!(
+                "Error: Cannot convert to JSON because the document contains {}.",
+                incompatibility.unwrap()
+            );
+            eprintln!("Hint: Try using YSON format instead (-t yson), which supports these types.");
+            Some(1)
+        }
+        Err(_) if write_error.is_some() => {
+            eprintln!("Error writing output: {}", write_error.unwrap());
+            Some(1)
+        }
+        Err(e) => {
+            if let Some(path) = input_file {
+                eprintln!("{}: {}", path, e);
+            } else {
+                eprintln!("Parse error: {}", e);
+            }
+            Some(1)
         }
     }
 }
 
-fn write_binary_output(
-    output: &[u8],
+/// Open the destination a streaming conversion writes to, reporting
+/// failures itself and returning the exit code to propagate.
+fn open_stream_output(
     output_file: Option<&str>,
     write_back: bool,
     input_file: Option<&str>,
-    format: Format,
-) {
+    output_format: Format,
+) -> Result<Box<dyn Write>, i32> {
     if let Some(path) = output_file {
-        if let Err(e) = fs::write(path, output) {
-            eprintln!("Error writing {}: {}", path, e);
-            process::exit(1);
+        match fs::File::create(path) {
+            Ok(f) => Ok(Box::new(f)),
+            Err(e) => {
+                eprintln!("Error writing {}: {}", path, e);
+                Err(1)
+            }
         }
     } else if write_back {
-        if let Some(input_path) = input_file {
-            let ext = format_extension(format);
-            let output_path = Path::new(input_path).with_extension(ext);
-            if let Err(e) = fs::write(&output_path, output) {
+        let input_path = match input_file {
+            Some(p) => p,
+            None => {
+                eprintln!("Error: --write requires an input file");
+                return Err(1);
+            }
+        };
+        let output_path = Path::new(input_path).with_extension(format_extension(output_format));
+        match fs::File::create(&output_path) {
+            Ok(f) => Ok(Box::new(f)),
+            Err(e) => {
                 eprintln!("Error writing {}: {}", output_path.display(), e);
-                process::exit(1);
+                Err(1)
             }
-        } else {
-            eprintln!("Error: --write requires an input file");
-            process::exit(1);
         }
     } else {
-        // Write raw bytes to stdout
-        let stdout = io::stdout();
-        let mut handle = stdout.lock();
-        if let Err(e) = handle.write_all(output) {
-            eprintln!("Error writing to stdout: {}", e);
-            process::exit(1);
+        Ok(Box::new(io::stdout()))
+    }
+}
+
+/// Pull one entry from fragment `idx` into its cursor slot and the
+/// merge heap, enforcing that the fragment's keys arrive sorted (the
+/// property the k-way merge rests on). Reports its own errors and
+/// returns the exit code to propagate.
+fn merge_pull(
+    streams: &mut [libyay::parser::RootEntries<'_>],
+    idx: usize,
+    pending: &mut [Option<Value>],
+    last: &mut [String],
+    heap: &mut std::collections::BinaryHeap<std::cmp::Reverse<(String, usize)>>,
+    path: &str,
+) -> Result<(), i32> {
+    match streams[idx].next_entry() {
+        Ok(Some((key, value))) => {
+            if key < last[idx] {
+                eprintln!(
+                    "Error: {}: key {:?} out of order after {:?}; merge requires each fragment's keys to be sorted",
+                    path, key, last[idx]
+                );
+                return Err(1);
+            }
+            last[idx] = key.clone();
+            pending[idx] = Some(value);
+            heap.push(std::cmp::Reverse((key, idx)));
+            Ok(())
+        }
+        Ok(None) => Ok(()),
+        Err(e) => {
+            eprintln!("{}: {}", path, e);
+            Err(1)
+        }
+    }
+}
+
+/// `yay merge FRAGMENT...`: streaming k-way merge of sorted root-object
+/// fragments with last-writer-wins per key. Every fragment contributes
+/// a cursor holding at most one parsed entry; a heap over the cursors'
+/// current keys emits merged entries in key order straight to the
+/// encoder. Beyond the fragment sources and their token slices, memory
+/// is bounded by the fragment count, not the merged tree.
+fn run_merge(args: &[String]) -> i32 {
+    let mut output_file: Option<&str> = None;
+    let mut paths: Vec<&str> = Vec::new();
+    let mut i = 0;
+    while i < args.len() {
+        match args[i].as_str() {
+            "-h" | "--help" => {
+                println!(
+                    "Usage: yay merge [-o FILE] FRAGMENT...\n\n\
+                     Merge sorted root-object YAY fragments into one document.\n\
+                     When fragments share a key, the last fragment named wins."
+                );
+                return 0;
+            }
+            "-o" | "--output" => {
+                i += 1;
+                if i >= args.len() {
+                    eprintln!("Error: --output requires an argument");
+                    return 1;
+                }
+                output_file = Some(&args[i]);
+            }
+            arg if arg.starts_with('-') => {
+                eprintln!("Error: Unknown merge option: {}", arg);
+                return 1;
+            }
+            _ => paths.push(&args[i]),
+        }
+        i += 1;
+    }
+    if paths.is_empty() {
+        eprintln!("Error: merge requires at least one fragment file");
+        return 1;
+    }
+
+    let mut sources = Vec::with_capacity(paths.len());
+    for path in &paths {
+        match fs::read_to_string(path) {
+            Ok(s) => sources.push(s),
+            Err(e) => {
+                eprintln!("Error reading {}: {}", path, e);
+                return 1;
+            }
+        }
+    }
+    let ctxs: Vec<libyay::ParseContext> = paths
+        .iter()
+        .map(|p| libyay::ParseContext::new(Some(p)))
+        .collect();
+    let mut scans = Vec::with_capacity(paths.len());
+    for (source, ctx) in sources.iter().zip(&ctxs) {
+        match libyay::scanner::scan(source, ctx) {
+            Ok(s) => scans.push(s),
+            Err(e) => {
+                eprintln!("{}", e);
+                return 1;
+            }
+        }
+    }
+    let tokens_list: Vec<_> = scans.iter().map(libyay::lexer::outline_lex).collect();
+    for (tokens, path) in tokens_list.iter().zip(&paths) {
+        let has_content = tokens
+            .iter()
+            .any(|t| t.typ == libyay::lexer::TokenType::Text);
+        if has_content && !libyay::parser::root_is_object(tokens) {
+            eprintln!(
+                "Error: {} is not a root object; merge combines key: value fragments",
+                path
+            );
+            return 1;
+        }
+    }
+
+    let mut streams: Vec<_> = tokens_list
+        .iter()
+        .zip(&ctxs)
+        .map(|(tokens, ctx)| libyay::parser::RootEntries::new(tokens, ctx))
+        .collect();
+    let mut pending: Vec<Option<Value>> = (0..paths.len()).map(|_| None).collect();
+    let mut last: Vec<String> = vec![String::new(); paths.len()];
+    let mut heap = std::collections::BinaryHeap::new();
+    for (idx, path) in paths.iter().enumerate() {
+        if let Err(code) = merge_pull(&mut streams, idx, &mut pending, &mut last, &mut heap, path) {
+            return code;
+        }
+    }
+
+    let mut writer = match open_stream_output(output_file, false, None, Format::Yay) {
+        Ok(w) => w,
+        Err(code) => return code,
+    };
+    if heap.is_empty() {
+        // No entries anywhere: the merged document is an empty object.
+        if let Err(e) = writer.write_all(b"{}\n").and_then(|_| writer.flush()) {
+            eprintln!("Error writing output: {}", e);
+            return 1;
+        }
+        return 0;
+    }
+
+    let mut encoder = libyay::RootObjectEncoder::new(&mut writer);
+    while let Some(std::cmp::Reverse((key, idx))) = heap.pop() {
+        // Gather every cursor sitting on this key; the highest fragment
+        // index (and, within a fragment, the latest duplicate) wins.
+        let mut winner_idx = idx;
+        let mut winner = pending[idx].take().expect("popped key has a value");
+        if let Err(code) = merge_pull(
+            &mut streams,
+            idx,
+            &mut pending,
+            &mut last,
+            &mut heap,
+            paths[idx],
+        ) {
+            return code;
+        }
+        while heap
+            .peek()
+            .is_some_and(|top: &std::cmp::Reverse<(String, usize)>| (top.0).0 == key)
+        {
+            let std::cmp::Reverse((_, idx2)) = heap.pop().unwrap();
+            let value = pending[idx2].take().expect("popped key has a value");
+            if idx2 >= winner_idx {
+                winner_idx = idx2;
+                winner = value;
+            }
+            if let Err(code) = merge_pull(
+                &mut streams,
+                idx2,
+                &mut pending,
+                &mut last,
+                &mut heap,
+                paths[idx2],
+            ) {
+                return code;
+            }
+        }
+        if let Err(e) = encoder.push(&key, &winner) {
+            eprintln!("Error writing output: {}", e);
+            return 1;
+        }
+    }
+    // Terminate the document like write_text_output's callers do.
+    if let Err(e) = encoder
+        .finish()
+        .and_then(|_| writer.write_all(b"\n"))
+        .and_then(|_| writer.flush())
+    {
+        eprintln!("Error writing output: {}", e);
+        return 1;
+    }
+    0
+}
+
+/// Stream a root-level CBOR array straight to the YAY/JSON/YSON
+/// encoder, one element at a time, without building the document tree.
+/// Returns None when the input is not a root-level array (or is a list
+/// small enough to inline in YAY), in which case the caller falls back
+/// to the tree path.
+fn stream_cbor_root_list(
+    bytes: &[u8],
+    input_file: Option<&str>,
+    output_format: Format,
+    output_file: Option<&str>,
+    write_back: bool,
+) -> Option<i32> {
+    // Major type 4 = array; anything else takes the tree path.
+    if !matches!(bytes.first(), Some(b) if b >> 5 == 4) {
+        return None;
+    }
+    let to_stdout = output_file.is_none() && !write_back;
+
+    if output_format == Format::Yay {
+        // A YAY root list only renders in block form once it is certain
+        // not to inline: more than five items, or any nested container.
+        // Buffer the undecided prefix and open the destination at the
+        // point of no return.
+        let is_container = |v: &Value| matches!(v, Value::Array(_) | Value::Object(_));
+        let mut pending: Vec<Value> = Vec::new();
+        let mut encoder: Option<libyay::RootListEncoder<Box<dyn Write>>> = None;
+        let mut open_error = None;
+        let mut write_error = None;
+        let result = transcode::cbor::decode_root_array_each(bytes, &mut |item| {
+            if encoder.is_none() && !is_container(&item) && pending.len() < 5 {
+                pending.push(item);
+                return Ok(());
+            }
+            if encoder.is_none() {
+                let writer =
+                    match open_stream_output(output_file, write_back, input_file, output_format) {
+                        Ok(w) => w,
+                        Err(code) => {
+                            open_error = Some(code);
+                            return Err(String::new());
+                        }
+                    };
+                let mut enc = libyay::RootListEncoder::new(writer, Format::Yay);
+                for v in pending.drain(..) {
+                    if let Err(e) = enc.push(&v) {
+                        write_error = Some(e);
+                        return Err(String::new());
+                    }
+                }
+                encoder = Some(enc);
+            }
+            encoder.as_mut().unwrap().push(&item).map_err(|e| {
+                write_error = Some(e);
+                String::new()
+            })
+        })?;
+
+        match result {
+            Ok(()) => {
+                let encoder = match encoder {
+                    Some(enc) => enc,
+                    None => {
+                        // Five or fewer scalars: the list inlines, so
+                        // encode the buffered items through the tree path.
+                        write_value_output(
+                            &Value::Array(pending),
+                            output_file,
+                            write_back,
+                            input_file,
+                            output_format,
+                        );
+                        return Some(0);
+                    }
+                };
+                if let Err(e) = encoder.finish() {
+                    eprintln!("Error writing output: {}", e);
+                    return Some(1);
+                }
+                if to_stdout {
+                    // Terminate the line like write_text_output does.
+                    println!();
+                }
+                Some(0)
+            }
+            Err(_) if open_error.is_some() => Some(open_error.unwrap()),
+            Err(_) if write_error.is_some() => {
+                eprintln!("Error writing output: {}", write_error.unwrap());
+                Some(1)
+            }
+            Err(e) => {
+                if let Some(path) = input_file {
+                    eprintln!("{}: {}", path, e);
+                } else {
+                    eprintln!("Parse error: {}", e);
+                }
+                Some(1)
+            }
+        }
+    } else {
+        let writer = match open_stream_output(output_file, write_back, input_file, output_format) {
+            Ok(w) => w,
+            Err(code) => return Some(code),
+        };
+        let mut encoder = libyay::RootListEncoder::new(writer, output_format);
+        let mut incompatibility = None;
+        let mut write_error = None;
+        let result = transcode::cbor::decode_root_array_each(bytes, &mut |item| {
+            if output_format == Format::Json {
+                if let Some(reason) = item.json_incompatibility() {
+                    incompatibility = Some(reason);
+                    return Err(String::new());
+                }
+            }
+            encoder.push(&item).map_err(|e| {
+                write_error = Some(e);
+                String::new()
+            })
+        })?;
+
+        match result {
+            Ok(()) => {
+                if let Err(e) = encoder.finish() {
+                    eprintln!("Error writing output: {}", e);
+                    return Some(1);
+                }
+                if to_stdout {
+                    // Terminate the line like write_text_output does.
+                    println!();
+                }
+                Some(0)
+            }
+            Err(_) if incompatibility.is_some() => {
+                eprintln!(
+                    "Error: Cannot convert to JSON because the document contains {}.",
+                    incompatibility.unwrap()
+                );
+                eprintln!(
+                    "Hint: Try using YSON format instead (-t yson), which supports these types."
+                );
+                Some(1)
+            }
+            Err(_) if write_error.is_some() => {
+                eprintln!("Error writing output: {}", write_error.unwrap());
+                Some(1)
+            }
+            Err(e) => {
+                if let Some(path) = input_file {
+                    eprintln!("{}: {}", path, e);
+                } else {
+                    eprintln!("Parse error: {}", e);
+                }
+                Some(1)
+            }
+        }
+    }
+}
+
+/// Stream an encoded value to the chosen destination without building
+/// the full output text in memory.
+fn write_value_output(
+    value: &Value,
+    output_file: Option<&str>,
+    write_back: bool,
+    input_file: Option<&str>,
+    format: Format,
+) {
+    let to_stdout = output_file.is_none() && !write_back;
+    let writer = match open_stream_output(output_file, write_back, input_file, format) {
+        Ok(w) => w,
+        Err(code) => process::exit(code),
+    };
+    let mut writer = writer;
+    let result = encode_to(value, format, &mut writer).and_then(|()| {
+        if to_stdout {
+            // Encoded documents never end with a newline; terminate the
+            // line like write_text_output does.
+            writer.write_all(b"\n")?;
         }
+        writer.flush()
+    });
+    if let Err(e) = result {
+        eprintln!("Error writing output: {}", e);
+        process::exit(1);
+    }
+}
+
+/// Stream a value's CBOR encoding to the chosen destination without
+/// building the full byte string in memory.
+fn write_cbor_output(
+    value: &Value,
+    output_file: Option<&str>,
+    write_back: bool,
+    input_file: Option<&str>,
+) {
+    let writer = match open_stream_output(output_file, write_back, input_file, Format::Cbor) {
+        Ok(w) => w,
+        Err(code) => process::exit(code),
+    };
+    let mut writer = io::BufWriter::with_capacity(OUTPUT_BUF_SIZE, writer);
+    if let Err(e) = transcode::cbor::encode_to(&mut writer, value) {
+        eprintln!("Error: Cannot convert to CBOR: {}", e);
+        process::exit(1);
+    }
+    if let Err(e) = writer.flush() {
+        eprintln!("Error writing output: {}", e);
+        process::exit(1);
     }
 }
 
@@ -925,6 +2468,7 @@ fn print_help() {
 
 USAGE:
     yay [OPTIONS] [FILE|DIR]
+    yay merge [-o FILE] FRAGMENT...
 
 ARGS:
     [FILE|DIR]    Input file or directory (reads from stdin if not provided)
@@ -932,7 +2476,8 @@ ARGS:
 
 OPTIONS:
     -f, --from <FORMAT>    Input format [default: meh, or yay when --check]
-                           Supported: meh, yay, json, yson, yaml, toml, cbor
+                           Supported: meh, yay, json, yson, yaml, toml, cbor,
+                                      auto (sniff the format from the content)
                            
                            'meh' (default) accepts loose formatting and reformats
                            to canonical YAY. 'yay' enforces strict YAY syntax
@@ -950,6 +2495,17 @@ OPTIONS:
     -o, --output <FILE>    Write output to specified file (not valid with directory input)
     
     --check                Check if input is valid (exit 0 if valid, 1 if invalid)
+
+    --diff                 Compare two documents structurally and print changed
+                           paths (exit 0 if identical, 1 if different)
+
+    --stats                Report per-phase timing (scan, lex, parse, format),
+                           throughput, and peak RSS; per-file lines plus a
+                           total with directory input
+
+    --daemon <SOCKET>      Listen on a unix socket and serve format/check/convert
+                           requests from a warm process, avoiding per-file
+                           process startup in editor and pre-commit hooks
                            Defaults to strict YAY input; use --from meh for lenient
     
     -h, --help             Print help
@@ -968,6 +2524,15 @@ EXAMPLES:
     
     # Validate all YAY files in a directory strictly
     yay --check ./configs/
+
+    # Show the paths that changed between two snapshots
+    yay --diff old.yay new.yay
+
+    # Merge sorted config fragments, last fragment winning shared keys
+    yay merge base.yay region.yay host.yay -o config.yay
+
+    # Find the slow files in a corpus
+    yay --stats ./configs/
     
     # Convert YAY to JSON (lenient input)
     yay -t json config.yay
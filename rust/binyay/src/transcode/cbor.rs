@@ -27,54 +27,196 @@
 //! produce an error rather than using bignum tags.
 
 use ciborium::value::Value as CborValue;
+use ciborium_ll::{Decoder, Header};
+use libyay::Map;
 use libyay::Value;
 use num_bigint::BigInt;
 use num_traits::ToPrimitive;
-use std::collections::HashMap;
 use std::fmt::Write as FmtWrite;
+use std::io;
 
 // ---------------------------------------------------------------------------
 // Decode (CBOR -> YAY)
 // ---------------------------------------------------------------------------
 
+/// Maximum nesting depth accepted while decoding, matching ciborium's
+/// own recursion limit.
+const MAX_DEPTH: usize = 128;
+
+/// Scratch buffer size for chunked reads of text and byte strings.
+const SCRATCH_SIZE: usize = 4096;
+
 /// Decode CBOR bytes into a YAY Value.
 pub fn decode(input: &[u8]) -> Result<Value, String> {
-    let cbor_value: CborValue =
-        ciborium::de::from_reader(input).map_err(|e| format!("CBOR decode error: {}", e))?;
-    cbor_to_value(&cbor_value)
+    decode_from(input)
 }
 
-fn cbor_to_value(cbor: &CborValue) -> Result<Value, String> {
-    match cbor {
-        CborValue::Null => Ok(Value::Null),
-        CborValue::Bool(b) => Ok(Value::Bool(*b)),
-        CborValue::Integer(i) => {
-            let n: i128 = (*i).into();
-            Ok(Value::Integer(BigInt::from(n)))
+/// Decode a single CBOR item from a reader into a YAY Value.
+///
+/// Decoding is driven by ciborium's low-level event decoder, so the raw
+/// input is consumed in chunks as items are pulled rather than buffered
+/// whole: memory use is bounded by the decoded value, not the input.
+pub fn decode_from<R: io::Read>(reader: R) -> Result<Value, String> {
+    let mut decoder = Decoder::from(reader);
+    let header = decoder.pull().map_err(decode_error)?;
+    decode_item(&mut decoder, header, 0)
+}
+
+/// Stream the elements of a root-level CBOR array.
+///
+/// Returns `None` without consuming anything when the input does not
+/// start with an array header, so callers can fall back to `decode`.
+/// Each element is decoded into its own `Value` and handed to `sink`,
+/// bounding memory by the largest element rather than the document.
+pub fn decode_root_array_each(
+    input: &[u8],
+    sink: &mut dyn FnMut(Value) -> Result<(), String>,
+) -> Option<Result<(), String>> {
+    // Major type 4 = array; peek before constructing the decoder
+    match input.first() {
+        Some(b) if b >> 5 == 4 => {}
+        _ => return None,
+    }
+    let mut decoder = Decoder::from(input);
+    let len = match decoder.pull() {
+        Ok(Header::Array(len)) => len,
+        Ok(_) => return None,
+        Err(e) => return Some(Err(decode_error(e))),
+    };
+    Some(decode_array_items(&mut decoder, len, 1, sink))
+}
+
+/// Decode the items of an array whose header has been pulled, handing
+/// each to `sink`. `len` of `None` means indefinite length (until break).
+fn decode_array_items<R: io::Read>(
+    decoder: &mut Decoder<R>,
+    len: Option<usize>,
+    depth: usize,
+    sink: &mut dyn FnMut(Value) -> Result<(), String>,
+) -> Result<(), String> {
+    match len {
+        Some(n) => {
+            for _ in 0..n {
+                let header = decoder.pull().map_err(decode_error)?;
+                sink(decode_item(decoder, header, depth)?)?;
+            }
         }
-        CborValue::Float(f) => Ok(Value::Float(*f)),
-        CborValue::Text(s) => Ok(Value::String(s.clone())),
-        CborValue::Bytes(b) => Ok(Value::Bytes(b.clone())),
-        CborValue::Array(arr) => {
-            let items: Result<Vec<Value>, String> = arr.iter().map(cbor_to_value).collect();
-            Ok(Value::Array(items?))
+        None => loop {
+            match decoder.pull().map_err(decode_error)? {
+                Header::Break => break,
+                header => sink(decode_item(decoder, header, depth)?)?,
+            }
+        },
+    }
+    Ok(())
+}
+
+fn decode_item<R: io::Read>(
+    decoder: &mut Decoder<R>,
+    header: Header,
+    depth: usize,
+) -> Result<Value, String> {
+    if depth > MAX_DEPTH {
+        return Err("CBOR decode error: recursion limit exceeded".to_string());
+    }
+    match header {
+        Header::Positive(n) => Ok(Value::Integer(n.into())),
+        // The wire value has all bits inverted from the signed integer
+        Header::Negative(n) => Ok(Value::Integer((n as i128 ^ !0).into())),
+        Header::Float(f) => Ok(Value::Float(f)),
+        Header::Simple(20) => Ok(Value::Bool(false)),
+        Header::Simple(21) => Ok(Value::Bool(true)),
+        Header::Simple(22) => Ok(Value::Null),
+        Header::Simple(n) => Err(format!("CBOR simple value {} has no YAY equivalent", n)),
+        Header::Tag(tag) => Err(format!(
+            "CBOR tagged value (tag {}) has no YAY equivalent",
+            tag
+        )),
+        Header::Bytes(len) => {
+            let mut out = match len {
+                Some(n) => Vec::with_capacity(n.min(SCRATCH_SIZE)),
+                None => Vec::new(),
+            };
+            let mut scratch = [0u8; SCRATCH_SIZE];
+            let mut segments = decoder.bytes(len);
+            while let Some(mut segment) = segments.pull().map_err(decode_error)? {
+                while let Some(chunk) = segment.pull(&mut scratch).map_err(decode_error)? {
+                    out.extend_from_slice(chunk);
+                }
+            }
+            Ok(Value::Bytes(out.into()))
         }
-        CborValue::Map(pairs) => {
-            let mut obj = HashMap::new();
-            for (k, v) in pairs {
-                let key = match k {
-                    CborValue::Text(s) => s.clone(),
-                    _ => return Err(format!("CBOR map key must be a text string, got: {:?}", k)),
+        Header::Text(len) => {
+            let mut out = String::with_capacity(len.unwrap_or(0).min(SCRATCH_SIZE));
+            let mut scratch = [0u8; SCRATCH_SIZE];
+            let mut segments = decoder.text(len);
+            while let Some(mut segment) = segments.pull().map_err(decode_error)? {
+                while let Some(chunk) = segment.pull(&mut scratch).map_err(decode_error)? {
+                    out.push_str(chunk);
+                }
+            }
+            Ok(Value::String(out.into()))
+        }
+        Header::Array(len) => {
+            let mut items = match len {
+                Some(n) => Vec::with_capacity(n.min(SCRATCH_SIZE)),
+                None => Vec::new(),
+            };
+            decode_array_items(decoder, len, depth + 1, &mut |item| {
+                items.push(item);
+                Ok(())
+            })?;
+            Ok(Value::Array(items))
+        }
+        Header::Map(len) => {
+            let mut obj = Map::new();
+            let mut entry = |decoder: &mut Decoder<R>| -> Result<(), String> {
+                let key = match decoder.pull().map_err(decode_error)? {
+                    Header::Text(klen) => {
+                        match decode_item(decoder, Header::Text(klen), depth + 1)? {
+                            Value::String(s) => s.into_string(),
+                            _ => unreachable!(),
+                        }
+                    }
+                    other => {
+                        return Err(format!(
+                            "CBOR map key must be a text string, got: {:?}",
+                            other
+                        ))
+                    }
                 };
-                obj.insert(key, cbor_to_value(v)?);
+                let vheader = decoder.pull().map_err(decode_error)?;
+                obj.insert(key, decode_item(decoder, vheader, depth + 1)?);
+                Ok(())
+            };
+            match len {
+                Some(n) => {
+                    for _ in 0..n {
+                        entry(decoder)?;
+                    }
+                }
+                None => loop {
+                    match decoder.pull().map_err(decode_error)? {
+                        Header::Break => break,
+                        header => {
+                            decoder.push(header);
+                            entry(decoder)?;
+                        }
+                    }
+                },
             }
             Ok(Value::Object(obj))
         }
-        CborValue::Tag(tag, _) => Err(format!(
-            "CBOR tagged value (tag {}) has no YAY equivalent",
-            tag
-        )),
-        _ => Err(format!("CBOR value {:?} has no YAY equivalent", cbor)),
+        Header::Break => Err("CBOR decode error: unexpected break code".to_string()),
+    }
+}
+
+fn decode_error(e: ciborium_ll::Error<io::Error>) -> String {
+    match e {
+        ciborium_ll::Error::Io(e) => format!("CBOR decode error: Io({:?})", e),
+        ciborium_ll::Error::Syntax(offset) => {
+            format!("CBOR decode error: syntax error at offset {}", offset)
+        }
     }
 }
 
@@ -95,38 +237,47 @@ pub fn encode(value: &Value) -> Result<Vec<u8>, String> {
     Ok(buf)
 }
 
-fn write_value(buf: &mut Vec<u8>, value: &Value) -> Result<(), String> {
+/// Encode a YAY Value as CBOR directly into a writer.
+///
+/// Bytes are emitted as the value tree is walked, so the full CBOR
+/// encoding is never buffered. Callers should wrap slow destinations in
+/// a `BufWriter`.
+pub fn encode_to<W: io::Write>(buf: &mut W, value: &Value) -> Result<(), String> {
+    write_value(buf, value)
+}
+
+fn write_value<W: io::Write>(buf: &mut W, value: &Value) -> Result<(), String> {
     match value {
         Value::Null => {
             // CBOR simple value 22 = null
-            buf.push(0xf6);
+            write_byte(buf, 0xf6)?;
             Ok(())
         }
         Value::Bool(b) => {
             // CBOR simple value 20 = false, 21 = true
-            buf.push(if *b { 0xf5 } else { 0xf4 });
+            write_byte(buf, if *b { 0xf5 } else { 0xf4 })?;
             Ok(())
         }
         Value::Integer(n) => write_integer(buf, n),
         Value::Float(f) => {
             // Always encode as CBOR float64 (major 7, info 27)
-            buf.push(0xfb);
-            buf.extend_from_slice(&f.to_be_bytes());
+            write_byte(buf, 0xfb)?;
+            write_bytes(buf, &f.to_be_bytes())?;
             Ok(())
         }
         Value::String(s) => {
             let bytes = s.as_bytes();
-            write_type_and_length(buf, 3, bytes.len() as u64); // major 3 = text string
-            buf.extend_from_slice(bytes);
+            write_type_and_length(buf, 3, bytes.len() as u64)?; // major 3 = text string
+            write_bytes(buf, bytes)?;
             Ok(())
         }
         Value::Bytes(b) => {
-            write_type_and_length(buf, 2, b.len() as u64); // major 2 = byte string
-            buf.extend_from_slice(b);
+            write_type_and_length(buf, 2, b.len() as u64)?; // major 2 = byte string
+            write_bytes(buf, b)?;
             Ok(())
         }
         Value::Array(arr) => {
-            write_type_and_length(buf, 4, arr.len() as u64); // major 4 = array
+            write_type_and_length(buf, 4, arr.len() as u64)?; // major 4 = array
             for item in arr {
                 write_value(buf, item)?;
             }
@@ -135,12 +286,12 @@ fn write_value(buf: &mut Vec<u8>, value: &Value) -> Result<(), String> {
         Value::Object(obj) => {
             let mut keys: Vec<&String> = obj.keys().collect();
             keys.sort();
-            write_type_and_length(buf, 5, keys.len() as u64); // major 5 = map
+            write_type_and_length(buf, 5, keys.len() as u64)?; // major 5 = map
             for k in keys {
                 // Key: text string
                 let key_bytes = k.as_bytes();
-                write_type_and_length(buf, 3, key_bytes.len() as u64);
-                buf.extend_from_slice(key_bytes);
+                write_type_and_length(buf, 3, key_bytes.len() as u64)?;
+                write_bytes(buf, key_bytes)?;
                 // Value
                 write_value(buf, &obj[k])?;
             }
@@ -158,29 +309,39 @@ fn write_value(buf: &mut Vec<u8>, value: &Value) -> Result<(), String> {
 ///   25:      2-byte argument follows
 ///   26:      4-byte argument follows
 ///   27:      8-byte argument follows
-fn write_type_and_length(buf: &mut Vec<u8>, major: u8, val: u64) {
+fn write_type_and_length<W: io::Write>(buf: &mut W, major: u8, val: u64) -> Result<(), String> {
     let high = major << 5;
     match val {
         0..=23 => {
-            buf.push(high | val as u8);
+            write_byte(buf, high | val as u8)?;
         }
         24..=0xff => {
-            buf.push(high | 24);
-            buf.push(val as u8);
+            write_byte(buf, high | 24)?;
+            write_byte(buf, val as u8)?;
         }
         0x100..=0xffff => {
-            buf.push(high | 25);
-            buf.extend_from_slice(&(val as u16).to_be_bytes());
+            write_byte(buf, high | 25)?;
+            write_bytes(buf, &(val as u16).to_be_bytes())?;
         }
         0x10000..=0xffff_ffff => {
-            buf.push(high | 26);
-            buf.extend_from_slice(&(val as u32).to_be_bytes());
+            write_byte(buf, high | 26)?;
+            write_bytes(buf, &(val as u32).to_be_bytes())?;
         }
         _ => {
-            buf.push(high | 27);
-            buf.extend_from_slice(&val.to_be_bytes());
+            write_byte(buf, high | 27)?;
+            write_bytes(buf, &val.to_be_bytes())?;
         }
     }
+    Ok(())
+}
+
+fn write_byte<W: io::Write>(buf: &mut W, byte: u8) -> Result<(), String> {
+    write_bytes(buf, &[byte])
+}
+
+fn write_bytes<W: io::Write>(buf: &mut W, bytes: &[u8]) -> Result<(), String> {
+    buf.write_all(bytes)
+        .map_err(|e| format!("write error: {}", e))
 }
 
 /// Write a YAY integer as the smallest CBOR integer encoding.
@@ -190,7 +351,19 @@ fn write_type_and_length(buf: &mut Vec<u8>, major: u8, val: u64) {
 ///   - Major 1 (negative): encodes value n (represents -1 - n)
 ///
 /// The argument uses the smallest encoding that fits.
-fn write_integer(buf: &mut Vec<u8>, n: &BigInt) -> Result<(), String> {
+fn write_integer<W: io::Write>(buf: &mut W, n: &libyay::Int) -> Result<(), String> {
+    // Fast path: i64-backed integers encode without BigInt arithmetic
+    if let Some(i) = n.to_i64() {
+        if i >= 0 {
+            write_type_and_length(buf, 0, i as u64)?;
+        } else {
+            // Negative: CBOR major 1 encodes -1 - n, so the argument is |n| - 1
+            write_type_and_length(buf, 1, (-1i128 - i as i128) as u64)?;
+        }
+        return Ok(());
+    }
+    let n = n.to_bigint();
+    let n = &n;
     if n.sign() == num_bigint::Sign::Minus {
         // Negative: CBOR major 1 encodes -1 - n, so the argument is |n| - 1
         let abs_minus_1 = (-n) - BigInt::from(1);
@@ -200,7 +373,7 @@ fn write_integer(buf: &mut Vec<u8>, n: &BigInt) -> Result<(), String> {
                 n
             )
         })?;
-        write_type_and_length(buf, 1, val);
+        write_type_and_length(buf, 1, val)?;
     } else {
         let val = n.to_u64().ok_or_else(|| {
             format!(
@@ -208,7 +381,7 @@ fn write_integer(buf: &mut Vec<u8>, n: &BigInt) -> Result<(), String> {
                 n
             )
         })?;
-        write_type_and_length(buf, 0, val);
+        write_type_and_length(buf, 0, val)?;
     }
     Ok(())
 }
@@ -27,17 +27,14 @@
 //!   - TOML datetimes become YAY strings (no dedicated datetime type in YAY).
 //!   - TOML requires the top-level value to be a table; non-table YAY values error.
 
+use libyay::Map;
 use libyay::Value;
-use num_bigint::BigInt;
-use num_traits::ToPrimitive;
-use std::collections::HashMap;
-use toml_edit::DocumentMut;
+use toml_edit::{DocumentMut, ImDocument};
 
 /// Decode a TOML string into a YAY Value.
 pub fn decode(input: &str) -> Result<Value, String> {
-    let doc: DocumentMut = input
-        .parse::<DocumentMut>()
-        .map_err(|e| format!("TOML parse error: {}", e))?;
+    // The read-only document skips DocumentMut's editing overlay
+    let doc = ImDocument::parse(input).map_err(|e| format!("TOML parse error: {}", e))?;
     toml_table_to_value(doc.as_table())
 }
 
@@ -45,18 +42,16 @@ pub fn decode(input: &str) -> Result<Value, String> {
 pub fn encode(value: &Value) -> Result<String, String> {
     check_toml_compatibility(value)?;
     match value {
-        Value::Object(_) => {
-            let toml_item = value_to_toml(value)?;
-            match toml_item {
-                toml_edit::Item::Table(table) => {
-                    let mut doc = DocumentMut::new();
-                    for (key, value) in table.iter() {
-                        doc[key] = value.clone();
-                    }
-                    Ok(doc.to_string())
-                }
-                _ => Err("Internal error: expected table".to_string()),
+        Value::Object(obj) => {
+            // Build the document in place rather than converting to a
+            // detached table and cloning every item into the document
+            let mut doc = DocumentMut::new();
+            let mut keys: Vec<&String> = obj.keys().collect();
+            keys.sort();
+            for k in keys {
+                doc.as_table_mut().insert(k, value_to_toml(&obj[k])?);
             }
+            Ok(doc.to_string())
         }
         _ => Err("TOML requires the top-level value to be a table/object".to_string()),
     }
@@ -90,10 +85,12 @@ fn check_toml_compatibility(value: &Value) -> Result<(), String> {
 }
 
 fn toml_table_to_value(table: &toml_edit::Table) -> Result<Value, String> {
-    let mut obj = HashMap::new();
+    let mut obj = Map::new();
     for (key, item) in table.iter() {
         obj.insert(key.to_string(), toml_item_to_value(item)?);
     }
+    // Ingested documents encode in canonical sorted order
+    obj.sort_keys();
     Ok(Value::Object(obj))
 }
 
@@ -111,23 +108,24 @@ fn toml_item_to_value(item: &toml_edit::Item) -> Result<Value, String> {
 
 fn toml_value_to_yay(v: &toml_edit::Value) -> Result<Value, String> {
     match v {
-        toml_edit::Value::String(s) => Ok(Value::String(s.value().clone())),
-        toml_edit::Value::Integer(i) => Ok(Value::Integer(BigInt::from(*i.value()))),
+        toml_edit::Value::String(s) => Ok(Value::String(s.value().as_str().into())),
+        toml_edit::Value::Integer(i) => Ok(Value::Integer((*i.value()).into())),
         toml_edit::Value::Float(f) => Ok(Value::Float(*f.value())),
         toml_edit::Value::Boolean(b) => Ok(Value::Bool(*b.value())),
         toml_edit::Value::Datetime(dt) => {
             // Convert datetime to string representation
-            Ok(Value::String(dt.value().to_string()))
+            Ok(Value::String(dt.value().to_string().into()))
         }
         toml_edit::Value::Array(arr) => {
             let items: Result<Vec<Value>, String> = arr.iter().map(toml_value_to_yay).collect();
             Ok(Value::Array(items?))
         }
         toml_edit::Value::InlineTable(table) => {
-            let mut obj = HashMap::new();
+            let mut obj = Map::new();
             for (key, val) in table.iter() {
                 obj.insert(key.to_string(), toml_value_to_yay(val)?);
             }
+            obj.sort_keys();
             Ok(Value::Object(obj))
         }
     }
@@ -151,7 +149,7 @@ fn value_to_toml(value: &Value) -> Result<toml_edit::Item, String> {
             toml_edit::Formatted::new(*f),
         ))),
         Value::String(s) => Ok(toml_edit::Item::Value(toml_edit::Value::String(
-            toml_edit::Formatted::new(s.clone()),
+            toml_edit::Formatted::new(s.to_string()),
         ))),
         Value::Bytes(_) => Err("TOML has no binary data type".to_string()),
         Value::Array(arr) => {
@@ -19,122 +19,242 @@
 //!   - Value::Array        -> YAML sequence
 //!   - Value::Object       -> YAML mapping
 //!   - Value::Bytes        -> YAML !!binary (base64-encoded)
+//!
+//! Both directions stream through serde's trait interfaces: decoding
+//! drives the YAML parser's events straight into `Value` construction
+//! and encoding walks the `Value` tree straight into the emitter, so no
+//! intermediate `serde_yaml::Value` document model is ever built.
 
 use base64::prelude::*;
+use libyay::Map;
 use libyay::Value;
-use num_bigint::BigInt;
-use num_traits::ToPrimitive;
-use std::collections::HashMap;
+use serde::de::{self, Deserialize, EnumAccess, MapAccess, SeqAccess, VariantAccess, Visitor};
+use serde::ser::{Serialize, SerializeMap, SerializeSeq, Serializer};
+use std::fmt;
 
 /// Decode a YAML string into a YAY Value.
 pub fn decode(input: &str) -> Result<Value, String> {
-    let yaml_value: serde_yaml::Value =
+    let YamlValue(value) =
         serde_yaml::from_str(input).map_err(|e| format!("YAML parse error: {}", e))?;
-    yaml_to_value(&yaml_value)
+    Ok(value)
 }
 
 /// Encode a YAY Value as a YAML string.
 pub fn encode(value: &Value) -> Result<String, String> {
-    let yaml_value = value_to_yaml(value)?;
-    serde_yaml::to_string(&yaml_value).map_err(|e| format!("YAML encode error: {}", e))
+    serde_yaml::to_string(&YamlOut(value)).map_err(|e| format!("YAML encode error: {}", e))
 }
 
-fn yaml_to_value(yaml: &serde_yaml::Value) -> Result<Value, String> {
-    match yaml {
-        serde_yaml::Value::Null => Ok(Value::Null),
-        serde_yaml::Value::Bool(b) => Ok(Value::Bool(*b)),
-        serde_yaml::Value::Number(n) => {
-            if let Some(i) = n.as_i64() {
-                Ok(Value::Integer(BigInt::from(i)))
-            } else if let Some(u) = n.as_u64() {
-                Ok(Value::Integer(BigInt::from(u)))
-            } else if let Some(f) = n.as_f64() {
-                Ok(Value::Float(f))
-            } else {
-                Err(format!("Unsupported YAML number: {:?}", n))
+/// Newtype carrier building a `Value` directly from parser events.
+struct YamlValue(Value);
+
+impl<'de> Deserialize<'de> for YamlValue {
+    fn deserialize<D>(deserializer: D) -> Result<Self, D::Error>
+    where
+        D: de::Deserializer<'de>,
+    {
+        struct ValueVisitor;
+
+        impl<'de> Visitor<'de> for ValueVisitor {
+            type Value = YamlValue;
+
+            fn expecting(&self, formatter: &mut fmt::Formatter) -> fmt::Result {
+                formatter.write_str("any YAML value")
             }
-        }
-        serde_yaml::Value::String(s) => Ok(Value::String(s.clone())),
-        serde_yaml::Value::Sequence(seq) => {
-            let items: Result<Vec<Value>, String> = seq.iter().map(yaml_to_value).collect();
-            Ok(Value::Array(items?))
-        }
-        serde_yaml::Value::Mapping(map) => {
-            let mut obj = HashMap::new();
-            for (k, v) in map {
-                let key = match k {
-                    serde_yaml::Value::String(s) => s.clone(),
-                    serde_yaml::Value::Number(n) => format!("{}", n),
-                    serde_yaml::Value::Bool(b) => format!("{}", b),
-                    serde_yaml::Value::Null => "null".to_string(),
-                    _ => return Err(format!("Unsupported YAML mapping key type: {:?}", k)),
-                };
-                obj.insert(key, yaml_to_value(v)?);
+
+            fn visit_bool<E: de::Error>(self, b: bool) -> Result<YamlValue, E> {
+                Ok(YamlValue(Value::Bool(b)))
             }
-            Ok(Value::Object(obj))
-        }
-        serde_yaml::Value::Tagged(tagged) => {
-            // Handle !!binary / !binary tag (serde_yaml normalizes the leading !'s)
-            let tag_str = tagged.tag.to_string();
-            let bare_tag = tag_str.trim_start_matches('!');
-            if bare_tag == "binary" {
-                if let serde_yaml::Value::String(s) = &tagged.value {
-                    let clean: String = s.chars().filter(|c| !c.is_whitespace()).collect();
-                    let bytes = BASE64_STANDARD
-                        .decode(&clean)
-                        .map_err(|e| format!("Invalid base64 in !!binary: {}", e))?;
-                    return Ok(Value::Bytes(bytes));
+
+            fn visit_i64<E: de::Error>(self, i: i64) -> Result<YamlValue, E> {
+                Ok(YamlValue(Value::Integer(i.into())))
+            }
+
+            fn visit_u64<E: de::Error>(self, u: u64) -> Result<YamlValue, E> {
+                Ok(YamlValue(Value::Integer(u.into())))
+            }
+
+            fn visit_f64<E: de::Error>(self, f: f64) -> Result<YamlValue, E> {
+                Ok(YamlValue(Value::Float(f)))
+            }
+
+            fn visit_str<E: de::Error>(self, s: &str) -> Result<YamlValue, E> {
+                Ok(YamlValue(Value::String(s.into())))
+            }
+
+            fn visit_unit<E: de::Error>(self) -> Result<YamlValue, E> {
+                Ok(YamlValue(Value::Null))
+            }
+
+            fn visit_none<E: de::Error>(self) -> Result<YamlValue, E> {
+                Ok(YamlValue(Value::Null))
+            }
+
+            fn visit_some<D>(self, deserializer: D) -> Result<YamlValue, D::Error>
+            where
+                D: de::Deserializer<'de>,
+            {
+                Deserialize::deserialize(deserializer)
+            }
+
+            fn visit_seq<A>(self, mut seq: A) -> Result<YamlValue, A::Error>
+            where
+                A: SeqAccess<'de>,
+            {
+                let mut items = Vec::with_capacity(seq.size_hint().unwrap_or(0));
+                while let Some(YamlValue(v)) = seq.next_element()? {
+                    items.push(v);
                 }
+                Ok(YamlValue(Value::Array(items)))
+            }
+
+            fn visit_map<A>(self, mut map: A) -> Result<YamlValue, A::Error>
+            where
+                A: MapAccess<'de>,
+            {
+                let mut obj = Map::new();
+                while let Some((YamlKey(key), YamlValue(v))) = map.next_entry()? {
+                    obj.insert(key, v);
+                }
+                // Ingested documents encode in canonical sorted order
+                obj.sort_keys();
+                Ok(YamlValue(Value::Object(obj)))
+            }
+
+            fn visit_enum<A>(self, data: A) -> Result<YamlValue, A::Error>
+            where
+                A: EnumAccess<'de>,
+            {
+                // Tagged values arrive as enums with the tag as variant
+                let (tag, contents): (String, _) = data.variant()?;
+                let YamlValue(inner) = contents.newtype_variant()?;
+                // Handle !!binary / !binary (serde_yaml normalizes the leading !'s)
+                if tag.trim_start_matches('!') == "binary" {
+                    if let Value::String(s) = &inner {
+                        let clean: String = s.chars().filter(|c| !c.is_whitespace()).collect();
+                        let bytes = BASE64_STANDARD.decode(&clean).map_err(|e| {
+                            de::Error::custom(format!("Invalid base64 in !!binary: {}", e))
+                        })?;
+                        return Ok(YamlValue(Value::Bytes(bytes.into())));
+                    }
+                }
+                // For other tags, keep the inner value
+                Ok(YamlValue(inner))
             }
-            // For other tags, try to decode the inner value
-            yaml_to_value(&tagged.value)
         }
+
+        deserializer.deserialize_any(ValueVisitor)
     }
 }
 
-fn value_to_yaml(value: &Value) -> Result<serde_yaml::Value, String> {
-    match value {
-        Value::Null => Ok(serde_yaml::Value::Null),
-        Value::Bool(b) => Ok(serde_yaml::Value::Bool(*b)),
-        Value::Integer(n) => {
-            // Try to fit in i64 first, then u64
-            if let Some(i) = n.to_i64() {
-                Ok(serde_yaml::Value::Number(serde_yaml::Number::from(i)))
-            } else if let Some(u) = n.to_u64() {
-                Ok(serde_yaml::Value::Number(serde_yaml::Number::from(u)))
-            } else {
-                // Big integer beyond i64/u64: emit as string
-                // YAML doesn't have native arbitrary-precision integers
-                Ok(serde_yaml::Value::String(n.to_string()))
+/// Mapping keys coerced to strings the way the document-model converter
+/// did: strings as-is, numbers and bools via their display form, null
+/// as "null"; anything else is unsupported.
+struct YamlKey(String);
+
+impl<'de> Deserialize<'de> for YamlKey {
+    fn deserialize<D>(deserializer: D) -> Result<Self, D::Error>
+    where
+        D: de::Deserializer<'de>,
+    {
+        struct KeyVisitor;
+
+        impl<'de> Visitor<'de> for KeyVisitor {
+            type Value = YamlKey;
+
+            fn expecting(&self, formatter: &mut fmt::Formatter) -> fmt::Result {
+                formatter.write_str("a YAML mapping key")
+            }
+
+            fn visit_str<E: de::Error>(self, s: &str) -> Result<YamlKey, E> {
+                Ok(YamlKey(s.to_string()))
+            }
+
+            fn visit_bool<E: de::Error>(self, b: bool) -> Result<YamlKey, E> {
+                Ok(YamlKey(format!("{}", b)))
+            }
+
+            fn visit_i64<E: de::Error>(self, i: i64) -> Result<YamlKey, E> {
+                Ok(YamlKey(format!("{}", i)))
+            }
+
+            fn visit_u64<E: de::Error>(self, u: u64) -> Result<YamlKey, E> {
+                Ok(YamlKey(format!("{}", u)))
+            }
+
+            fn visit_f64<E: de::Error>(self, f: f64) -> Result<YamlKey, E> {
+                if f.is_nan() {
+                    Ok(YamlKey(".nan".to_string()))
+                } else if f.is_infinite() {
+                    Ok(YamlKey(if f > 0.0 { ".inf" } else { "-.inf" }.to_string()))
+                } else {
+                    let s = format!("{}", f);
+                    if s.contains('.') || s.contains('e') {
+                        Ok(YamlKey(s))
+                    } else {
+                        Ok(YamlKey(format!("{}.0", s)))
+                    }
+                }
+            }
+
+            fn visit_unit<E: de::Error>(self) -> Result<YamlKey, E> {
+                Ok(YamlKey("null".to_string()))
             }
         }
-        Value::Float(f) => Ok(serde_yaml::Value::Number(serde_yaml::Number::from(*f))),
-        Value::String(s) => Ok(serde_yaml::Value::String(s.clone())),
-        Value::Bytes(b) => {
-            let b64 = BASE64_STANDARD.encode(b);
-            Ok(serde_yaml::Value::Tagged(Box::new(
-                serde_yaml::value::TaggedValue {
+
+        deserializer.deserialize_any(KeyVisitor)
+    }
+}
+
+/// Borrowing wrapper walking a `Value` straight into the YAML emitter.
+struct YamlOut<'a>(&'a Value);
+
+impl Serialize for YamlOut<'_> {
+    fn serialize<S>(&self, serializer: S) -> Result<S::Ok, S::Error>
+    where
+        S: Serializer,
+    {
+        match self.0 {
+            Value::Null => serializer.serialize_unit(),
+            Value::Bool(b) => serializer.serialize_bool(*b),
+            Value::Integer(n) => {
+                // Try to fit in i64 first, then u64
+                if let Some(i) = n.to_i64() {
+                    serializer.serialize_i64(i)
+                } else if let Some(u) = n.to_u64() {
+                    serializer.serialize_u64(u)
+                } else {
+                    // Big integer beyond i64/u64: emit as string
+                    // YAML doesn't have native arbitrary-precision integers
+                    serializer.serialize_str(&n.to_string())
+                }
+            }
+            Value::Float(f) => serializer.serialize_f64(*f),
+            Value::String(s) => serializer.serialize_str(s),
+            Value::Bytes(b) => {
+                // The per-leaf TaggedValue carries the !!binary tag
+                // through serde_yaml's tag-aware Serialize impl
+                let tagged = serde_yaml::value::TaggedValue {
                     tag: serde_yaml::value::Tag::new("!!binary"),
-                    value: serde_yaml::Value::String(b64),
-                },
-            )))
-        }
-        Value::Array(arr) => {
-            let items: Result<Vec<serde_yaml::Value>, String> =
-                arr.iter().map(value_to_yaml).collect();
-            Ok(serde_yaml::Value::Sequence(items?))
-        }
-        Value::Object(obj) => {
-            let mut map = serde_yaml::Mapping::new();
-            let mut keys: Vec<&String> = obj.keys().collect();
-            keys.sort();
-            for k in keys {
-                map.insert(
-                    serde_yaml::Value::String(k.clone()),
-                    value_to_yaml(&obj[k])?,
-                );
-            }
-            Ok(serde_yaml::Value::Mapping(map))
+                    value: serde_yaml::Value::String(BASE64_STANDARD.encode(b)),
+                };
+                tagged.serialize(serializer)
+            }
+            Value::Array(arr) => {
+                let mut seq = serializer.serialize_seq(Some(arr.len()))?;
+                for v in arr {
+                    seq.serialize_element(&YamlOut(v))?;
+                }
+                seq.end()
+            }
+            Value::Object(obj) => {
+                let mut keys: Vec<&String> = obj.keys().collect();
+                keys.sort();
+                let mut map = serializer.serialize_map(Some(keys.len()))?;
+                for k in keys {
+                    map.serialize_entry(k, &YamlOut(&obj[k]))?;
+                }
+                map.end()
+            }
         }
     }
 }
@@ -0,0 +1,163 @@
+//! Phase-level benchmarks: scan, lex, parse, and encode timed separately
+//! over the test/yay/ corpus plus generated scaling inputs.
+//!
+//! Runs as a plain binary (`cargo bench`) with a self-contained timing
+//! loop, since the crate carries no benchmark-framework dependency.
+//! Each phase reports nanoseconds per iteration and throughput in MB/s
+//! over the source bytes (output bytes for encode).
+
+use libyay::lexer::outline_lex;
+use libyay::parser::parse_root;
+use libyay::scanner::scan;
+use libyay::{encode, Format, ParseContext};
+use std::hint::black_box;
+use std::path::Path;
+use std::time::Instant;
+
+/// Target wall time per measurement, in seconds.
+const TARGET_SECONDS: f64 = 0.2;
+
+/// Time a closure, auto-scaling iterations to the target duration.
+/// Returns nanoseconds per iteration.
+fn measure<F: FnMut()>(mut work: F) -> f64 {
+    // Warm up and estimate a single iteration.
+    let start = Instant::now();
+    work();
+    let estimate = start.elapsed().as_secs_f64().max(1e-9);
+
+    let iterations = ((TARGET_SECONDS / estimate) as u64).clamp(1, 1_000_000);
+    let start = Instant::now();
+    for _ in 0..iterations {
+        work();
+    }
+    start.elapsed().as_secs_f64() * 1e9 / iterations as f64
+}
+
+/// Report one phase measurement with throughput over `bytes`.
+fn report(input: &str, phase: &str, nanos: f64, bytes: usize) {
+    let mbps = bytes as f64 / (nanos / 1e9) / 1e6;
+    println!(
+        "{:<24} {:<8} {:>12.0} ns {:>10.1} MB/s",
+        input, phase, nanos, mbps
+    );
+}
+
+/// Benchmark all four phases over one source document.
+fn bench_document(name: &str, source: &str) {
+    let ctx = ParseContext::new(None);
+
+    let nanos = measure(|| {
+        black_box(scan(black_box(source), &ctx).unwrap());
+    });
+    report(name, "scan", nanos, source.len());
+
+    let scanned = scan(source, &ctx).unwrap();
+    let nanos = measure(|| {
+        black_box(outline_lex(black_box(&scanned)));
+    });
+    report(name, "lex", nanos, source.len());
+
+    let tokens = outline_lex(&scanned);
+    let nanos = measure(|| {
+        black_box(parse_root(black_box(&tokens), &ctx, scanned.had_comments).unwrap());
+    });
+    report(name, "parse", nanos, source.len());
+
+    let value = parse_root(&tokens, &ctx, scanned.had_comments).unwrap();
+    let encoded_len = encode(&value, Format::Yay).len();
+    let nanos = measure(|| {
+        black_box(encode(black_box(&value), Format::Yay));
+    });
+    report(name, "encode", nanos, encoded_len);
+}
+
+/// Concatenate the whole test/yay/ corpus into one measurement per phase.
+fn bench_corpus() {
+    let dir = Path::new(env!("CARGO_MANIFEST_DIR"))
+        .parent()
+        .unwrap()
+        .parent()
+        .unwrap()
+        .join("test")
+        .join("yay");
+    let mut sources = Vec::new();
+    let mut entries: Vec<_> = std::fs::read_dir(&dir)
+        .expect("test/yay/ corpus not found")
+        .flatten()
+        .map(|e| e.path())
+        .filter(|p| p.extension().map(|e| e == "yay").unwrap_or(false))
+        .collect();
+    entries.sort();
+    for path in entries {
+        sources.push(std::fs::read_to_string(path).unwrap());
+    }
+    let total_bytes: usize = sources.iter().map(|s| s.len()).sum();
+    let ctx = ParseContext::new(None);
+
+    let nanos = measure(|| {
+        for source in &sources {
+            black_box(scan(black_box(source.as_str()), &ctx).unwrap());
+        }
+    });
+    report("corpus", "scan", nanos, total_bytes);
+
+    let scanned: Vec<_> = sources.iter().map(|s| scan(s, &ctx).unwrap()).collect();
+    let nanos = measure(|| {
+        for result in &scanned {
+            black_box(outline_lex(black_box(result)));
+        }
+    });
+    report("corpus", "lex", nanos, total_bytes);
+
+    let lexed: Vec<_> = scanned
+        .iter()
+        .map(|r| (outline_lex(r), r.had_comments))
+        .collect();
+    let nanos = measure(|| {
+        for (tokens, had_comments) in &lexed {
+            black_box(parse_root(black_box(tokens), &ctx, *had_comments).unwrap());
+        }
+    });
+    report("corpus", "parse", nanos, total_bytes);
+
+    let values: Vec<_> = lexed
+        .iter()
+        .map(|(tokens, had_comments)| parse_root(tokens, &ctx, *had_comments).unwrap())
+        .collect();
+    let encoded_bytes: usize = values.iter().map(|v| encode(v, Format::Yay).len()).sum();
+    let nanos = measure(|| {
+        for value in &values {
+            black_box(encode(black_box(value), Format::Yay));
+        }
+    });
+    report("corpus", "encode", nanos, encoded_bytes);
+}
+
+/// Build a synthetic document with the given number of lines: a list of
+/// small objects, exercising leaders, indentation, keys, and scalars.
+fn scaling_input(lines: usize) -> String {
+    let mut source = String::with_capacity(lines * 24);
+    let mut n = 0;
+    while n + 3 <= lines {
+        source.push_str(&format!(
+            "- id: {}\n  name: \"entry {}\"\n  live: {}\n",
+            n,
+            n,
+            n % 2 == 0
+        ));
+        n += 3;
+    }
+    source
+}
+
+fn main() {
+    println!(
+        "{:<24} {:<8} {:>15} {:>15}",
+        "input", "phase", "time", "throughput"
+    );
+    bench_corpus();
+    for lines in [1_000, 10_000, 100_000, 1_000_000] {
+        let source = scaling_input(lines);
+        bench_document(&format!("{}-lines", lines), &source);
+    }
+}
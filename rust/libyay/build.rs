@@ -0,0 +1,221 @@
+//! Derives keyword and escape dispatch tables from GRAMMAR.md.
+//!
+//! The grammar is the source of truth for the language's terminal sets.
+//! This script extracts the keyword spellings (null, boolean, and
+//! special-float productions) and the single-character dq-escape set,
+//! computes a perfect hash over the keywords, and emits
+//! `$OUT_DIR/terminals_gen.rs` for the parser to include, so future
+//! grammar additions cannot silently diverge from the hot path. The C
+//! parser's checked-in `terminals_gen.h` is generated from the same
+//! productions by `c/gen_terminals.py`.
+
+use std::env;
+use std::fs;
+use std::path::Path;
+
+/// Grammar productions whose double-quoted alternatives are keywords.
+const KEYWORD_PRODUCTIONS: &[&str] = &["null", "boolean", "special-float"];
+
+/// Enum variant and value expression for each keyword spelling. The
+/// grammar names the spellings; the semantics live here, and an unknown
+/// spelling aborts the build so additions are made deliberately.
+const KEYWORD_SEMANTICS: &[(&str, &str)] = &[
+    ("null", "Null"),
+    ("true", "True"),
+    ("false", "False"),
+    ("nan", "Nan"),
+    ("infinity", "Infinity"),
+    ("-infinity", "NegInfinity"),
+];
+
+/// Replacement character for each single-character dq-escape; same
+/// deliberate-addition rule as the keywords.
+const ESCAPE_SEMANTICS: &[(char, char)] = &[
+    ('"', '"'),
+    ('\\', '\\'),
+    ('/', '/'),
+    ('b', '\x08'),
+    ('f', '\x0C'),
+    ('n', '\n'),
+    ('r', '\r'),
+    ('t', '\t'),
+];
+
+fn main() {
+    let grammar_path = Path::new(env!("CARGO_MANIFEST_DIR")).join("../../GRAMMAR.md");
+    println!("cargo:rerun-if-changed={}", grammar_path.display());
+    let grammar = fs::read_to_string(&grammar_path)
+        .unwrap_or_else(|e| panic!("cannot read {}: {}", grammar_path.display(), e));
+
+    let keywords = extract_keywords(&grammar);
+    let escapes = extract_escapes(&grammar);
+    let (mul, size) = perfect_hash(&keywords);
+
+    let mut out = String::new();
+    out.push_str("// Generated by build.rs from GRAMMAR.md. Do not edit.\n\n");
+
+    out.push_str("/// A keyword terminal from the grammar's scalar productions.\n");
+    out.push_str("#[derive(Debug, Clone, Copy, PartialEq, Eq)]\n");
+    out.push_str("pub(crate) enum Keyword {\n");
+    for (_, variant) in KEYWORD_SEMANTICS {
+        out.push_str(&format!("    {},\n", variant));
+    }
+    out.push_str("}\n\n");
+
+    out.push_str(
+        "/// Keyword spellings with their variants, longest first so prefix\n\
+         /// matching never stops at a shorter keyword.\n",
+    );
+    out.push_str(&format!(
+        "pub(crate) static KEYWORDS: [(&str, Keyword); {}] = [\n",
+        keywords.len()
+    ));
+    let mut by_len = keywords.clone();
+    by_len.sort_by_key(|kw| std::cmp::Reverse(kw.len()));
+    for kw in &by_len {
+        out.push_str(&format!("    ({:?}, Keyword::{}),\n", kw, variant_for(kw)));
+    }
+    out.push_str("];\n\n");
+
+    out.push_str(&format!(
+        "static KEYWORD_TABLE: [Option<(&str, Keyword)>; {}] = {{\n\
+         \x20   let mut table: [Option<(&str, Keyword)>; {}] = [None; {}];\n",
+        size, size, size
+    ));
+    for kw in &keywords {
+        let slot = (kw.len() * mul + kw.as_bytes()[0] as usize) % size;
+        out.push_str(&format!(
+            "    table[{}] = Some(({:?}, Keyword::{}));\n",
+            slot,
+            kw,
+            variant_for(kw)
+        ));
+    }
+    out.push_str("    table\n};\n\n");
+
+    out.push_str(
+        "/// Whole-string keyword lookup through a perfect hash on\n\
+         /// (length, first byte).\n",
+    );
+    out.push_str(&format!(
+        "pub(crate) fn lookup_keyword(s: &str) -> Option<Keyword> {{\n\
+         \x20   let bytes = s.as_bytes();\n\
+         \x20   let first = *bytes.first()? as usize;\n\
+         \x20   match KEYWORD_TABLE[(bytes.len() * {} + first) % {}] {{\n\
+         \x20       Some((spelling, keyword)) if spelling == s => Some(keyword),\n\
+         \x20       _ => None,\n\
+         \x20   }}\n\
+         }}\n\n",
+        mul, size
+    ));
+
+    out.push_str(
+        "/// dq-escape classification: the replacement character for\n\
+         /// one-character escapes, ESC_UNICODE for the unicode-escape opener,\n\
+         /// 0 for invalid escapes.\n",
+    );
+    out.push_str("pub(crate) const ESC_UNICODE: u8 = 1;\n\n");
+    out.push_str("pub(crate) static DQ_ESCAPE_TABLE: [u8; 256] = {\n");
+    out.push_str("    let mut table = [0u8; 256];\n");
+    for esc in &escapes {
+        out.push_str(&format!(
+            "    table[{}] = {};\n",
+            *esc as u32,
+            replacement_for(*esc) as u32
+        ));
+    }
+    out.push_str("    table[b'u' as usize] = ESC_UNICODE; // unicode-escape\n");
+    out.push_str("    table\n};\n");
+
+    let out_path = Path::new(&env::var("OUT_DIR").unwrap()).join("terminals_gen.rs");
+    fs::write(&out_path, out).expect("cannot write terminals_gen.rs");
+}
+
+fn variant_for(keyword: &str) -> &'static str {
+    KEYWORD_SEMANTICS
+        .iter()
+        .find(|(spelling, _)| *spelling == keyword)
+        .map(|(_, variant)| *variant)
+        .unwrap_or_else(|| {
+            panic!(
+                "keyword {:?} has no semantics mapping; add it to KEYWORD_SEMANTICS",
+                keyword
+            )
+        })
+}
+
+fn replacement_for(escape: char) -> char {
+    ESCAPE_SEMANTICS
+        .iter()
+        .find(|(spelling, _)| *spelling == escape)
+        .map(|(_, replacement)| *replacement)
+        .unwrap_or_else(|| {
+            panic!(
+                "escape {:?} has no replacement mapping; add it to ESCAPE_SEMANTICS",
+                escape
+            )
+        })
+}
+
+/// Pull the double-quoted alternatives out of a grammar production.
+fn production_body<'a>(grammar: &'a str, name: &str) -> &'a str {
+    let needle = format!("\n{} ", name);
+    let start = grammar
+        .find(&needle)
+        .unwrap_or_else(|| panic!("production {:?} not found in GRAMMAR.md", name));
+    let body = &grammar[start + needle.len()..];
+    let end = body
+        .find(';')
+        .unwrap_or_else(|| panic!("production {:?} is unterminated", name));
+    &body[..end]
+}
+
+fn extract_keywords(grammar: &str) -> Vec<String> {
+    let mut keywords = Vec::new();
+    for name in KEYWORD_PRODUCTIONS {
+        let body = production_body(grammar, name);
+        let mut rest = body;
+        while let Some(open) = rest.find('"') {
+            let tail = &rest[open + 1..];
+            let close = tail.find('"').expect("unterminated terminal");
+            keywords.push(tail[..close].to_string());
+            rest = &tail[close + 1..];
+        }
+    }
+    assert!(!keywords.is_empty(), "no keyword terminals in GRAMMAR.md");
+    keywords
+}
+
+fn extract_escapes(grammar: &str) -> Vec<char> {
+    let body = production_body(grammar, "dq-escape");
+    let mut escapes = Vec::new();
+    let mut rest = body;
+    // Alternatives look like '\"' — a backslash and the escape letter in
+    // single quotes.
+    while let Some(open) = rest.find("'\\") {
+        let tail = &rest[open + 2..];
+        let mut chars = tail.chars();
+        let esc = chars.next().expect("unterminated escape terminal");
+        escapes.push(esc);
+        rest = chars.as_str();
+    }
+    assert!(!escapes.is_empty(), "no dq-escape terminals in GRAMMAR.md");
+    escapes
+}
+
+/// Find (multiplier, size) so (len * mul + first-byte) % size is
+/// collision-free over the keyword set.
+fn perfect_hash(keywords: &[String]) -> (usize, usize) {
+    for size in keywords.len()..64 {
+        for mul in 1..128 {
+            let slots: std::collections::HashSet<usize> = keywords
+                .iter()
+                .map(|kw| (kw.len() * mul + kw.as_bytes()[0] as usize) % size)
+                .collect();
+            if slots.len() == keywords.len() {
+                return (mul, size);
+            }
+        }
+    }
+    panic!("no perfect hash parameters found for keyword set");
+}
@@ -0,0 +1,344 @@
+//! serde Deserializer for YAY documents.
+//!
+//! `from_str::<T>(source)` parses a YAY document through the usual
+//! scanner/lexer/parser pipeline and decodes it directly into `T`.
+//! The deserializer consumes the parsed tree by value, moving strings,
+//! byte buffers, and children into the target type instead of cloning
+//! them, so the document's heap data is allocated exactly once.
+
+use crate::error::{ParseError, Result};
+use crate::value::Value;
+use serde::de::{
+    self, DeserializeOwned, Deserializer, EnumAccess, IntoDeserializer, MapAccess, SeqAccess,
+    VariantAccess, Visitor,
+};
+
+/// Parse a YAY document and decode it into a deserializable type.
+///
+/// # Example
+///
+/// ```
+/// use serde::Deserialize;
+///
+/// #[derive(Deserialize)]
+/// struct Config {
+///     name: String,
+///     retries: u32,
+/// }
+///
+/// let config: Config = libyay::from_str("name: \"demo\"\nretries: 3").unwrap();
+/// assert_eq!(config.retries, 3);
+/// ```
+pub fn from_str<T: DeserializeOwned>(source: &str) -> Result<T> {
+    from_value(crate::parse(source)?)
+}
+
+/// Decode an already-parsed value into a deserializable type,
+/// consuming the value.
+pub fn from_value<T: DeserializeOwned>(value: Value) -> Result<T> {
+    T::deserialize(ValueDeserializer(value))
+}
+
+impl de::Error for ParseError {
+    fn custom<T: std::fmt::Display>(msg: T) -> Self {
+        ParseError::Generic(msg.to_string())
+    }
+}
+
+/// Deserializer over a parsed value, consumed as it is visited.
+struct ValueDeserializer(Value);
+
+/// Short type description for mismatch errors.
+fn type_name(value: &Value) -> &'static str {
+    match value {
+        Value::Null => "null",
+        Value::Bool(_) => "boolean",
+        Value::Integer(_) => "integer",
+        Value::Float(_) => "float",
+        Value::String(_) => "string",
+        Value::Array(_) => "array",
+        Value::Object(_) => "object",
+        Value::Bytes(_) => "bytes",
+    }
+}
+
+impl<'de> Deserializer<'de> for ValueDeserializer {
+    type Error = ParseError;
+
+    fn deserialize_any<V: Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        match self.0 {
+            Value::Null => visitor.visit_unit(),
+            Value::Bool(b) => visitor.visit_bool(b),
+            Value::Integer(n) => {
+                // YAY integers are arbitrary precision; serde is not.
+                if let Some(small) = n.to_i64() {
+                    visitor.visit_i64(small)
+                } else if let Some(small) = n.to_u64() {
+                    visitor.visit_u64(small)
+                } else {
+                    Err(ParseError::Generic(format!(
+                        "Integer {} does not fit in 64 bits",
+                        n
+                    )))
+                }
+            }
+            Value::Float(f) => visitor.visit_f64(f),
+            Value::String(s) => visitor.visit_string(s.into_string()),
+            Value::Bytes(b) => visitor.visit_byte_buf(b.into_vec()),
+            Value::Array(arr) => visitor.visit_seq(SeqDeserializer {
+                iter: arr.into_iter(),
+            }),
+            Value::Object(obj) => visitor.visit_map(MapDeserializer {
+                iter: obj.into_iter(),
+                pending: None,
+            }),
+        }
+    }
+
+    fn deserialize_option<V: Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        match self.0 {
+            Value::Null => visitor.visit_none(),
+            _ => visitor.visit_some(self),
+        }
+    }
+
+    fn deserialize_newtype_struct<V: Visitor<'de>>(
+        self,
+        _name: &'static str,
+        visitor: V,
+    ) -> Result<V::Value> {
+        visitor.visit_newtype_struct(self)
+    }
+
+    fn deserialize_enum<V: Visitor<'de>>(
+        self,
+        _name: &'static str,
+        _variants: &'static [&'static str],
+        visitor: V,
+    ) -> Result<V::Value> {
+        match self.0 {
+            // A bare string is a unit variant.
+            Value::String(variant) => visitor.visit_enum(variant.into_deserializer()),
+            // A single-entry object is a variant with data.
+            Value::Object(obj) if obj.len() == 1 => {
+                let (variant, value) = obj.into_iter().next().unwrap();
+                visitor.visit_enum(EnumDeserializer { variant, value })
+            }
+            other => Err(ParseError::Generic(format!(
+                "Expected string or single-key object for enum, found {}",
+                type_name(&other)
+            ))),
+        }
+    }
+
+    serde::forward_to_deserialize_any! {
+        bool i8 i16 i32 i64 i128 u8 u16 u32 u64 u128 f32 f64 char str string
+        bytes byte_buf unit unit_struct seq tuple tuple_struct map struct
+        identifier ignored_any
+    }
+}
+
+/// Streams array elements out of the owning vector.
+struct SeqDeserializer {
+    iter: std::vec::IntoIter<Value>,
+}
+
+impl<'de> SeqAccess<'de> for SeqDeserializer {
+    type Error = ParseError;
+
+    fn next_element_seed<T: de::DeserializeSeed<'de>>(
+        &mut self,
+        seed: T,
+    ) -> Result<Option<T::Value>> {
+        match self.iter.next() {
+            Some(value) => seed.deserialize(ValueDeserializer(value)).map(Some),
+            None => Ok(None),
+        }
+    }
+
+    fn size_hint(&self) -> Option<usize> {
+        Some(self.iter.len())
+    }
+}
+
+/// Streams object entries in document order.
+struct MapDeserializer {
+    iter: std::vec::IntoIter<(String, Value)>,
+    pending: Option<Value>,
+}
+
+impl<'de> MapAccess<'de> for MapDeserializer {
+    type Error = ParseError;
+
+    fn next_key_seed<K: de::DeserializeSeed<'de>>(&mut self, seed: K) -> Result<Option<K::Value>> {
+        match self.iter.next() {
+            Some((key, value)) => {
+                self.pending = Some(value);
+                seed.deserialize(ValueDeserializer(Value::String(key.into())))
+                    .map(Some)
+            }
+            None => Ok(None),
+        }
+    }
+
+    fn next_value_seed<V: de::DeserializeSeed<'de>>(&mut self, seed: V) -> Result<V::Value> {
+        let value = self
+            .pending
+            .take()
+            .expect("next_value_seed before next_key_seed");
+        seed.deserialize(ValueDeserializer(value))
+    }
+
+    fn size_hint(&self) -> Option<usize> {
+        Some(self.iter.len())
+    }
+}
+
+/// Decodes `variant: data` objects into data-carrying enum variants.
+struct EnumDeserializer {
+    variant: String,
+    value: Value,
+}
+
+impl<'de> EnumAccess<'de> for EnumDeserializer {
+    type Error = ParseError;
+    type Variant = VariantDeserializer;
+
+    fn variant_seed<V: de::DeserializeSeed<'de>>(
+        self,
+        seed: V,
+    ) -> Result<(V::Value, VariantDeserializer)> {
+        let variant = seed.deserialize(ValueDeserializer(Value::String(self.variant.into())))?;
+        Ok((variant, VariantDeserializer { value: self.value }))
+    }
+}
+
+/// Carries the data half of a `variant: data` entry.
+struct VariantDeserializer {
+    value: Value,
+}
+
+impl<'de> VariantAccess<'de> for VariantDeserializer {
+    type Error = ParseError;
+
+    fn unit_variant(self) -> Result<()> {
+        match self.value {
+            Value::Null => Ok(()),
+            other => Err(ParseError::Generic(format!(
+                "Expected null for unit variant, found {}",
+                type_name(&other)
+            ))),
+        }
+    }
+
+    fn newtype_variant_seed<T: de::DeserializeSeed<'de>>(self, seed: T) -> Result<T::Value> {
+        seed.deserialize(ValueDeserializer(self.value))
+    }
+
+    fn tuple_variant<V: Visitor<'de>>(self, _len: usize, visitor: V) -> Result<V::Value> {
+        ValueDeserializer(self.value).deserialize_any(visitor)
+    }
+
+    fn struct_variant<V: Visitor<'de>>(
+        self,
+        _fields: &'static [&'static str],
+        visitor: V,
+    ) -> Result<V::Value> {
+        ValueDeserializer(self.value).deserialize_any(visitor)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use serde::Deserialize;
+
+    #[derive(Deserialize, Debug, PartialEq)]
+    struct Config {
+        name: String,
+        retries: u32,
+        timeout: Option<f64>,
+        hosts: Vec<String>,
+    }
+
+    #[test]
+    fn test_struct() {
+        let source = concat!(
+            "name: \"demo\"\n",
+            "retries: 3\n",
+            "timeout: 1.5\n",
+            "hosts:\n",
+            "- \"alpha\"\n",
+            "- \"beta\"\n",
+        );
+        let config: Config = from_str(source).unwrap();
+        assert_eq!(
+            config,
+            Config {
+                name: "demo".to_string(),
+                retries: 3,
+                timeout: Some(1.5),
+                hosts: vec!["alpha".to_string(), "beta".to_string()],
+            }
+        );
+    }
+
+    #[test]
+    fn test_missing_optional() {
+        let config: Config =
+            from_str("name: \"demo\"\nretries: 0\ntimeout: null\nhosts: []").unwrap();
+        assert_eq!(config.timeout, None);
+        assert!(config.hosts.is_empty());
+    }
+
+    #[test]
+    fn test_bytes() {
+        #[derive(Deserialize)]
+        struct Blob {
+            data: serde_bytes_free::ByteBuf,
+        }
+        // Avoid a serde_bytes dependency: Vec<u8> decodes element-wise,
+        // so route through a visitor-friendly wrapper instead.
+        mod serde_bytes_free {
+            use serde::de::{Deserialize, Deserializer, Error, Visitor};
+            #[derive(Debug, PartialEq)]
+            pub struct ByteBuf(pub Vec<u8>);
+            impl<'de> Deserialize<'de> for ByteBuf {
+                fn deserialize<D: Deserializer<'de>>(d: D) -> Result<Self, D::Error> {
+                    struct V;
+                    impl<'de> Visitor<'de> for V {
+                        type Value = ByteBuf;
+                        fn expecting(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+                            f.write_str("bytes")
+                        }
+                        fn visit_byte_buf<E: Error>(self, v: Vec<u8>) -> Result<ByteBuf, E> {
+                            Ok(ByteBuf(v))
+                        }
+                    }
+                    d.deserialize_byte_buf(V)
+                }
+            }
+        }
+        let blob: Blob = from_str("data: <cafe>").unwrap();
+        assert_eq!(blob.data.0, vec![0xca, 0xfe]);
+    }
+
+    #[test]
+    fn test_enum() {
+        #[derive(Deserialize, Debug, PartialEq)]
+        enum Mode {
+            Off,
+            Level(u8),
+        }
+        let off: Mode = from_str("\"Off\"").unwrap();
+        assert_eq!(off, Mode::Off);
+        let level: Mode = from_str("Level: 7").unwrap();
+        assert_eq!(level, Mode::Level(7));
+    }
+
+    #[test]
+    fn test_too_big_integer() {
+        let result: Result<u64> = from_str("12345678901234567890123456789");
+        assert!(result.is_err());
+    }
+}
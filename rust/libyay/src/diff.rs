@@ -0,0 +1,293 @@
+//! Structural diff between two YAY values.
+//!
+//! A textual diff of large generated documents is noisy, and a naive
+//! tree diff re-compares every node even when almost nothing changed.
+//! This module instead computes a 64-bit structural hash for every
+//! subtree in one bottom-up pass per document, then walks the two trees
+//! in step: any pair of subtrees with matching hashes is skipped in
+//! O(1) without visiting its contents, so the walk only descends along
+//! the changed spine. Matching hashes are trusted rather than
+//! re-verified — the FNV-1a mix over tagged, length-framed content
+//! makes an accidental collision between two subtrees of the same
+//! document pair vanishingly unlikely, and re-verifying would reinstate
+//! exactly the full comparison the hashes exist to avoid.
+
+use crate::value::Value;
+use std::collections::HashMap;
+use std::fmt::Write;
+
+/// How a path differs between the old and new documents.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum DiffOp {
+    /// Present only in the new document.
+    Added,
+    /// Present only in the old document.
+    Removed,
+    /// Present in both documents with different values.
+    Changed,
+}
+
+/// A single path-level difference.
+#[derive(Debug, Clone)]
+pub struct DiffEntry {
+    /// Path from the root, e.g. `$.servers[0].port`.
+    pub path: String,
+    pub op: DiffOp,
+    /// Short rendering of the old value (`Removed` and `Changed`).
+    pub old: Option<String>,
+    /// Short rendering of the new value (`Added` and `Changed`).
+    pub new: Option<String>,
+}
+
+/// Per-subtree hashes, shaped like the value tree so the diff walk can
+/// descend through both in step.
+struct HashNode {
+    hash: u64,
+    children: Vec<HashNode>,
+}
+
+const FNV_OFFSET: u64 = 0xcbf29ce484222325;
+const FNV_PRIME: u64 = 0x100000001b3;
+
+fn mix_bytes(mut hash: u64, bytes: &[u8]) -> u64 {
+    for &b in bytes {
+        hash ^= b as u64;
+        hash = hash.wrapping_mul(FNV_PRIME);
+    }
+    hash
+}
+
+fn mix_u64(hash: u64, v: u64) -> u64 {
+    mix_bytes(hash, &v.to_le_bytes())
+}
+
+/// Hash every subtree bottom-up. Each node's hash covers a type tag,
+/// a length frame, and either the scalar's content or the children's
+/// hashes (object entries include their keys), so structurally equal
+/// subtrees hash equal and nothing else does.
+fn hash_tree(value: &Value) -> HashNode {
+    match value {
+        Value::Null => HashNode {
+            hash: mix_bytes(FNV_OFFSET, b"n"),
+            children: Vec::new(),
+        },
+        Value::Bool(b) => HashNode {
+            hash: mix_bytes(FNV_OFFSET, if *b { b"b1" } else { b"b0" }),
+            children: Vec::new(),
+        },
+        Value::Integer(n) => {
+            let hash = mix_bytes(FNV_OFFSET, b"i");
+            let hash = match n.to_i64() {
+                Some(small) => mix_u64(hash, small as u64),
+                None => mix_bytes(hash, n.to_string().as_bytes()),
+            };
+            HashNode {
+                hash,
+                children: Vec::new(),
+            }
+        }
+        Value::Float(f) => HashNode {
+            hash: mix_u64(mix_bytes(FNV_OFFSET, b"f"), f.to_bits()),
+            children: Vec::new(),
+        },
+        Value::String(s) => HashNode {
+            hash: mix_bytes(
+                mix_u64(mix_bytes(FNV_OFFSET, b"s"), s.len() as u64),
+                s.as_bytes(),
+            ),
+            children: Vec::new(),
+        },
+        Value::Bytes(b) => HashNode {
+            hash: mix_bytes(mix_u64(mix_bytes(FNV_OFFSET, b"x"), b.len() as u64), b),
+            children: Vec::new(),
+        },
+        Value::Array(items) => {
+            let children: Vec<HashNode> = items.iter().map(hash_tree).collect();
+            let mut hash = mix_u64(mix_bytes(FNV_OFFSET, b"a"), items.len() as u64);
+            for child in &children {
+                hash = mix_u64(hash, child.hash);
+            }
+            HashNode { hash, children }
+        }
+        Value::Object(map) => {
+            let children: Vec<HashNode> = map.values().map(hash_tree).collect();
+            let mut hash = mix_u64(mix_bytes(FNV_OFFSET, b"o"), map.len() as u64);
+            for (key, child) in map.keys().zip(&children) {
+                hash = mix_u64(hash, key.len() as u64);
+                hash = mix_bytes(hash, key.as_bytes());
+                hash = mix_u64(hash, child.hash);
+            }
+            HashNode { hash, children }
+        }
+    }
+}
+
+/// Maximum rendered scalar length before truncation; keeps one change
+/// per line even when a long string or byte array differs.
+const RENDER_LIMIT: usize = 64;
+
+/// Short one-line rendering of a value for diff output. Containers are
+/// summarized by size — the entries that actually differ get their own
+/// path-level lines.
+fn render(value: &Value) -> String {
+    match value {
+        Value::Array(items) => format!("array ({} items)", items.len()),
+        Value::Object(map) => format!("object ({} entries)", map.len()),
+        _ => {
+            let text = format!("{:?}", value);
+            if text.len() > RENDER_LIMIT {
+                let mut cut = RENDER_LIMIT;
+                while !text.is_char_boundary(cut) {
+                    cut -= 1;
+                }
+                format!("{}...", &text[..cut])
+            } else {
+                text
+            }
+        }
+    }
+}
+
+/// True when a key reads unambiguously in `$.key` position.
+fn is_bare_key(key: &str) -> bool {
+    !key.is_empty()
+        && key
+            .chars()
+            .all(|c| c.is_ascii_alphanumeric() || c == '_' || c == '-')
+}
+
+fn push_key(path: &mut String, key: &str) {
+    if is_bare_key(key) {
+        path.push('.');
+        path.push_str(key);
+    } else {
+        let _ = write!(path, "[{:?}]", key);
+    }
+}
+
+fn push_entry(
+    out: &mut Vec<DiffEntry>,
+    path: &str,
+    op: DiffOp,
+    old: Option<&Value>,
+    new: Option<&Value>,
+) {
+    out.push(DiffEntry {
+        path: path.to_string(),
+        op,
+        old: old.map(render),
+        new: new.map(render),
+    });
+}
+
+fn diff_walk(
+    old: &Value,
+    new: &Value,
+    old_hash: &HashNode,
+    new_hash: &HashNode,
+    path: &mut String,
+    out: &mut Vec<DiffEntry>,
+) {
+    // The payoff: identical subtrees — usually almost the whole
+    // document — are dismissed here without being visited
+    if old_hash.hash == new_hash.hash {
+        return;
+    }
+    match (old, new) {
+        (Value::Object(old_map), Value::Object(new_map)) => {
+            // Only objects on the changed spine pay for a key index;
+            // it makes the keywise match O(1) per entry
+            let new_index: HashMap<&str, usize> = new_map
+                .keys()
+                .enumerate()
+                .map(|(i, k)| (k.as_str(), i))
+                .collect();
+            for (i, (key, old_value)) in old_map.iter().enumerate() {
+                let depth = path.len();
+                push_key(path, key);
+                match new_index.get(key.as_str()) {
+                    Some(&j) => {
+                        let new_value = new_map.get(key).expect("indexed key");
+                        diff_walk(
+                            old_value,
+                            new_value,
+                            &old_hash.children[i],
+                            &new_hash.children[j],
+                            path,
+                            out,
+                        );
+                    }
+                    None => {
+                        push_entry(out, path, DiffOp::Removed, Some(old_value), None);
+                    }
+                }
+                path.truncate(depth);
+            }
+            for (key, new_value) in new_map.iter() {
+                if !old_map.contains_key(key) {
+                    let depth = path.len();
+                    push_key(path, key);
+                    push_entry(out, path, DiffOp::Added, None, Some(new_value));
+                    path.truncate(depth);
+                }
+            }
+        }
+        (Value::Array(old_items), Value::Array(new_items)) => {
+            let common = old_items.len().min(new_items.len());
+            for i in 0..common {
+                let depth = path.len();
+                let _ = write!(path, "[{}]", i);
+                diff_walk(
+                    &old_items[i],
+                    &new_items[i],
+                    &old_hash.children[i],
+                    &new_hash.children[i],
+                    path,
+                    out,
+                );
+                path.truncate(depth);
+            }
+            for (i, old_value) in old_items.iter().enumerate().skip(common) {
+                let depth = path.len();
+                let _ = write!(path, "[{}]", i);
+                push_entry(out, path, DiffOp::Removed, Some(old_value), None);
+                path.truncate(depth);
+            }
+            for (i, new_value) in new_items.iter().enumerate().skip(common) {
+                let depth = path.len();
+                let _ = write!(path, "[{}]", i);
+                push_entry(out, path, DiffOp::Added, None, Some(new_value));
+                path.truncate(depth);
+            }
+        }
+        _ => {
+            push_entry(out, path, DiffOp::Changed, Some(old), Some(new));
+        }
+    }
+}
+
+/// Compute the path-level differences between two documents.
+///
+/// Entries come out in document order of the old tree, with additions
+/// from the new tree after the entries they join. An empty result means
+/// the documents are structurally identical.
+///
+/// # Example
+///
+/// ```
+/// use libyay::{diff, parse};
+///
+/// let old = parse("port: 8080").unwrap();
+/// let new = parse("port: 8081").unwrap();
+/// let changes = diff(&old, &new);
+/// assert_eq!(changes.len(), 1);
+/// assert_eq!(changes[0].path, "$.port");
+/// ```
+pub fn diff(old: &Value, new: &Value) -> Vec<DiffEntry> {
+    let old_hashes = hash_tree(old);
+    let new_hashes = hash_tree(new);
+    let mut out = Vec::new();
+    let mut path = String::from("$");
+    diff_walk(old, new, &old_hashes, &new_hashes, &mut path, &mut out);
+    out
+}
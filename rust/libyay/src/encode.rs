@@ -3,8 +3,11 @@
 //! This module provides functions to convert YAY values into source code
 //! literals for various programming languages, as well as YSON format.
 
+use crate::map::Map;
+use crate::value::Int;
 use crate::Value;
-use std::collections::HashMap;
+use std::fmt::Write as _;
+use std::io::{self, Write};
 
 /// Output format for encoding.
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
@@ -65,134 +68,356 @@ pub fn encode(value: &Value, format: Format) -> String {
     }
 }
 
+/// Encode a YAY value to a writer, streaming instead of materializing
+/// the whole document as one string.
+///
+/// Block entries at the document root are encoded and written one at a
+/// time through a `BufWriter`, so converter memory stays bounded by the
+/// parsed tree plus the largest single root entry rather than the full
+/// output text. The bytes written are identical to `encode()`.
+///
+/// The same format restrictions as `encode()` apply: YAML, TOML, and
+/// CBOR are handled by the CLI tool and panic here.
+/// Buffer size for streamed encoding. Conversions are written in large
+/// batches so piped output stays syscall-bound on the consumer side
+/// rather than degrading into thousands of small writes.
+const WRITE_BUF_SIZE: usize = 1 << 20;
+
+pub fn encode_to<W: io::Write>(value: &Value, format: Format, writer: W) -> io::Result<()> {
+    let mut writer = io::BufWriter::with_capacity(WRITE_BUF_SIZE, writer);
+    if format != Format::Yay {
+        writer.write_all(encode(value, format).as_bytes())?;
+        return writer.flush();
+    }
+    match value {
+        Value::Array(arr) if !arr.is_empty() && !can_inline_array(arr) => {
+            // Mirrors encode_yay_multiline_array at indent 0.
+            for (i, v) in arr.iter().enumerate() {
+                if i > 0 {
+                    writer.write_all(b"\n")?;
+                }
+                writer.write_all(b"- ")?;
+                writer.write_all(encode_yay_array_item(v, 0).as_bytes())?;
+            }
+        }
+        Value::Object(obj) if !obj.is_empty() && !can_inline_object(obj) => {
+            // Mirrors the block-object branch of encode_yay at indent 0.
+            for (i, (k, v)) in obj.iter().enumerate() {
+                if i > 0 {
+                    writer.write_all(b"\n")?;
+                }
+                writer.write_all(encode_yay_key(k).as_bytes())?;
+                if is_block_value(v) {
+                    writer.write_all(b":\n")?;
+                } else {
+                    writer.write_all(b": ")?;
+                }
+                writer.write_all(encode_yay(v, 1).as_bytes())?;
+            }
+        }
+        _ => writer.write_all(encode_yay(value, 0).as_bytes())?,
+    }
+    writer.flush()
+}
+
+/// Streams a root-level list's YAY, JSON, or YSON encoding to a
+/// writer, one item at a time: the encoder-side companion to
+/// `parser::parse_root_items`. Output is byte-identical to encoding the
+/// collected array with `encode()`, but only one item's text exists at
+/// a time.
+///
+/// For `Format::Yay` the equivalence holds only when the collected
+/// array would not inline (more than five items, or any nested
+/// container); callers gate on that before streaming.
+#[doc(hidden)]
+pub struct RootListEncoder<W: io::Write> {
+    writer: io::BufWriter<W>,
+    format: Format,
+    count: usize,
+}
+
+impl<W: io::Write> RootListEncoder<W> {
+    /// Start streaming. Only `Format::Yay`, `Format::Json`, and
+    /// `Format::Yson` are meaningful; other formats panic on push.
+    pub fn new(writer: W, format: Format) -> Self {
+        RootListEncoder {
+            writer: io::BufWriter::with_capacity(WRITE_BUF_SIZE, writer),
+            format,
+            count: 0,
+        }
+    }
+
+    /// Encode and write one root list item.
+    pub fn push(&mut self, value: &Value) -> io::Result<()> {
+        match self.format {
+            Format::Yay => {
+                // Mirrors encode_to's block-array branch at indent 0.
+                if self.count > 0 {
+                    self.writer.write_all(b"\n")?;
+                }
+                self.writer.write_all(b"- ")?;
+                self.writer
+                    .write_all(encode_yay_array_item(value, 0).as_bytes())?;
+            }
+            Format::Json | Format::Yson => {
+                self.writer
+                    .write_all(if self.count == 0 { b"[\n  " } else { b",\n  " })?;
+                let encoded = match self.format {
+                    Format::Json => encode_json(value, 1),
+                    _ => encode_yson(value, 1),
+                };
+                self.writer.write_all(encoded.as_bytes())?;
+            }
+            _ => panic!("RootListEncoder supports only YAY, JSON, and YSON"),
+        }
+        self.count += 1;
+        Ok(())
+    }
+
+    /// Close the list and flush.
+    pub fn finish(mut self) -> io::Result<()> {
+        if self.format != Format::Yay {
+            self.writer
+                .write_all(if self.count == 0 { b"[]" } else { b"\n]" })?;
+        }
+        self.writer.flush()
+    }
+}
+
+/// Streams a root-level object's YAY encoding to a writer, one entry at
+/// a time: the encoder-side companion to `parser::RootEntries`. Output
+/// matches encoding the collected object with `encode()` whenever the
+/// collected object would not inline; callers gate on that before
+/// streaming.
+#[doc(hidden)]
+pub struct RootObjectEncoder<W: io::Write> {
+    writer: io::BufWriter<W>,
+    count: usize,
+}
+
+impl<W: io::Write> RootObjectEncoder<W> {
+    pub fn new(writer: W) -> Self {
+        RootObjectEncoder {
+            writer: io::BufWriter::with_capacity(WRITE_BUF_SIZE, writer),
+            count: 0,
+        }
+    }
+
+    /// Encode and write one root object entry.
+    pub fn push(&mut self, key: &str, value: &Value) -> io::Result<()> {
+        // Mirrors encode_to's block-object branch at indent 0.
+        if self.count > 0 {
+            self.writer.write_all(b"\n")?;
+        }
+        self.writer.write_all(encode_yay_key(key).as_bytes())?;
+        if is_block_value(value) {
+            self.writer.write_all(b":\n")?;
+        } else {
+            self.writer.write_all(b": ")?;
+        }
+        self.writer.write_all(encode_yay(value, 1).as_bytes())?;
+        self.count += 1;
+        Ok(())
+    }
+
+    /// Flush the stream.
+    pub fn finish(mut self) -> io::Result<()> {
+        self.writer.flush()
+    }
+}
+
+// =============================================================================
+// Scalar Writers
+// =============================================================================
+//
+// Scalars dominate encoder output, so they are written straight into the
+// output buffer instead of through a `format!`/`to_string` temporary per
+// value. Integers take an itoa-style stack buffer; floats go through
+// std's shortest-round-trip formatter writing directly into the output,
+// with any fixups applied in place on the bytes just written.
+
+const HEX_DIGITS: &[u8; 16] = b"0123456789abcdef";
+
+/// Append a byte as two lowercase hex digits.
+fn push_hex_byte(out: &mut String, b: u8) {
+    out.push(HEX_DIGITS[(b >> 4) as usize] as char);
+    out.push(HEX_DIGITS[(b & 0xf) as usize] as char);
+}
+
+/// Append an i64's decimal digits: written back-to-front into a stack
+/// buffer and appended in one push.
+fn push_i64(out: &mut String, n: i64) {
+    let mut buf = [0u8; 20]; // "-9223372036854775808" is 20 bytes
+    let neg = n < 0;
+    let mut m = n.unsigned_abs();
+    let mut i = buf.len();
+    loop {
+        i -= 1;
+        buf[i] = b'0' + (m % 10) as u8;
+        m /= 10;
+        if m == 0 {
+            break;
+        }
+    }
+    if neg {
+        i -= 1;
+        buf[i] = b'-';
+    }
+    // The buffer holds only ASCII digits and '-'
+    out.push_str(std::str::from_utf8(&buf[i..]).unwrap());
+}
+
+/// Append an integer; values beyond i64 fall back to Display.
+fn push_int(out: &mut String, n: &Int) {
+    match n.to_i64() {
+        Some(i) => push_i64(out, i),
+        None => {
+            let _ = write!(out, "{}", n);
+        }
+    }
+}
+
+/// Append a finite float's shortest representation, ensuring a decimal
+/// point so the text reads back as a float. The `.0` suffix decision
+/// inspects the bytes just written rather than reformatting.
+fn push_float_with_point(out: &mut String, f: f64) {
+    let start = out.len();
+    let _ = write!(out, "{}", f);
+    if !out[start..].contains('.') && !out[start..].contains('e') {
+        out.push_str(".0");
+    }
+}
+
 // =============================================================================
 // YAY Encoder
 // =============================================================================
 
 fn encode_yay(value: &Value, indent: usize) -> String {
-    let pad = "  ".repeat(indent);
+    let mut out = String::new();
+    encode_yay_into(value, indent, &mut out);
+    out
+}
 
+fn encode_yay_into(value: &Value, indent: usize, out: &mut String) {
     match value {
-        Value::Null => "null".to_string(),
-        Value::Bool(true) => "true".to_string(),
-        Value::Bool(false) => "false".to_string(),
-        Value::Integer(n) => n.to_string(),
+        Value::Null => out.push_str("null"),
+        Value::Bool(true) => out.push_str("true"),
+        Value::Bool(false) => out.push_str("false"),
+        Value::Integer(n) => push_int(out, n),
         Value::Float(f) => {
             if f.is_nan() {
-                "nan".to_string()
+                out.push_str("nan");
             } else if f.is_infinite() {
-                if *f > 0.0 {
-                    "infinity".to_string()
-                } else {
-                    "-infinity".to_string()
-                }
+                out.push_str(if *f > 0.0 { "infinity" } else { "-infinity" });
             } else if *f == 0.0 && f.is_sign_negative() {
-                "-0.0".to_string()
+                out.push_str("-0.0");
             } else {
-                let s = format!("{}", f);
-                if s.contains('.') || s.contains('e') {
-                    s
-                } else {
-                    format!("{}.0", s)
-                }
+                push_float_with_point(out, *f);
             }
         }
-        Value::String(s) => encode_yay_string(s),
-        Value::Bytes(b) => encode_yay_bytes(b),
+        Value::String(s) => encode_yay_string_into(s, out),
+        Value::Bytes(b) => encode_yay_bytes_into(b, out),
         Value::Array(arr) => {
             if arr.is_empty() {
-                "[]".to_string()
+                out.push_str("[]");
             } else if can_inline_array(arr) {
-                let items: Vec<String> = arr.iter().map(|v| encode_yay(v, 0)).collect();
-                format!("[{}]", items.join(", "))
+                out.push('[');
+                for (i, v) in arr.iter().enumerate() {
+                    if i > 0 {
+                        out.push_str(", ");
+                    }
+                    encode_yay_into(v, 0, out);
+                }
+                out.push(']');
             } else {
-                encode_yay_multiline_array(arr, indent)
+                encode_yay_multiline_array_into(arr, indent, out);
             }
         }
         Value::Object(obj) => {
             if obj.is_empty() {
-                "{}".to_string()
+                out.push_str("{}");
             } else if can_inline_object(obj) {
-                let mut keys: Vec<&String> = obj.keys().collect();
-                keys.sort();
-                let items: Vec<String> = keys
-                    .iter()
-                    .map(|k| format!("{}: {}", encode_yay_key(k), encode_yay(&obj[*k], 0)))
-                    .collect();
-                format!("{{{}}}", items.join(", "))
+                out.push('{');
+                for (i, (k, v)) in obj.iter().enumerate() {
+                    if i > 0 {
+                        out.push_str(", ");
+                    }
+                    encode_yay_key_into(k, out);
+                    out.push_str(": ");
+                    encode_yay_into(v, 0, out);
+                }
+                out.push('}');
             } else {
-                let mut keys: Vec<&String> = obj.keys().collect();
-                keys.sort();
-                let items: Vec<String> = keys
-                    .iter()
-                    .map(|k| {
-                        let v = &obj[*k];
-                        if is_block_value(v) {
-                            // Nested block value: put on next line
-                            format!(
-                                "{}{}:\n{}",
-                                pad,
-                                encode_yay_key(k),
-                                encode_yay(v, indent + 1)
-                            )
-                        } else {
-                            format!(
-                                "{}{}: {}",
-                                pad,
-                                encode_yay_key(k),
-                                encode_yay(v, indent + 1)
-                            )
-                        }
-                    })
-                    .collect();
-                items.join("\n")
+                let pad = "  ".repeat(indent);
+                for (i, (k, v)) in obj.iter().enumerate() {
+                    if i > 0 {
+                        out.push('\n');
+                    }
+                    out.push_str(&pad);
+                    encode_yay_key_into(k, out);
+                    if is_block_value(v) {
+                        // Nested block value: put on next line
+                        out.push_str(":\n");
+                    } else {
+                        out.push_str(": ");
+                    }
+                    encode_yay_into(v, indent + 1, out);
+                }
             }
         }
     }
 }
 
-fn encode_yay_string(s: &str) -> String {
+fn encode_yay_string_into(s: &str, out: &mut String) {
     // Use double quotes and escape special characters
-    let mut result = String::from("\"");
+    out.push('"');
     for c in s.chars() {
         match c {
-            '"' => result.push_str("\\\""),
-            '\\' => result.push_str("\\\\"),
-            '/' => result.push_str("\\/"),
-            '\n' => result.push_str("\\n"),
-            '\r' => result.push_str("\\r"),
-            '\t' => result.push_str("\\t"),
-            '\x08' => result.push_str("\\b"),
-            '\x0c' => result.push_str("\\f"),
+            '"' => out.push_str("\\\""),
+            '\\' => out.push_str("\\\\"),
+            '/' => out.push_str("\\/"),
+            '\n' => out.push_str("\\n"),
+            '\r' => out.push_str("\\r"),
+            '\t' => out.push_str("\\t"),
+            '\x08' => out.push_str("\\b"),
+            '\x0c' => out.push_str("\\f"),
             c if c.is_control() => {
-                result.push_str(&format!("\\u{{{:X}}}", c as u32));
+                let _ = write!(out, "\\u{{{:X}}}", c as u32);
             }
-            c => result.push(c),
+            c => out.push(c),
         }
     }
-    result.push('"');
-    result
+    out.push('"');
 }
 
-fn encode_yay_bytes(bytes: &[u8]) -> String {
+fn encode_yay_bytes_into(bytes: &[u8], out: &mut String) {
     if bytes.is_empty() {
-        "<>".to_string()
+        out.push_str("<>");
     } else {
-        let hex: String = bytes.iter().map(|b| format!("{:02x}", b)).collect();
-        format!("<{}>", hex)
+        out.push('<');
+        for &b in bytes {
+            push_hex_byte(out, b);
+        }
+        out.push('>');
     }
 }
 
 fn encode_yay_key(key: &str) -> String {
+    let mut out = String::new();
+    encode_yay_key_into(key, &mut out);
+    out
+}
+
+fn encode_yay_key_into(key: &str, out: &mut String) {
     // Check if key needs quoting
     if key
         .chars()
         .all(|c| c.is_alphanumeric() || c == '_' || c == '-')
         && !key.is_empty()
     {
-        key.to_string()
+        out.push_str(key);
     } else {
-        encode_yay_string(key)
+        encode_yay_string_into(key, out);
     }
 }
 
@@ -200,7 +425,7 @@ fn can_inline_array(arr: &[Value]) -> bool {
     arr.len() <= 5 && arr.iter().all(is_simple_value)
 }
 
-fn can_inline_object(obj: &HashMap<String, Value>) -> bool {
+fn can_inline_object(obj: &Map) -> bool {
     obj.len() <= 3 && obj.values().all(is_simple_value)
 }
 
@@ -224,72 +449,60 @@ fn is_block_value(v: &Value) -> bool {
     }
 }
 
-fn encode_yay_multiline_array(arr: &[Value], indent: usize) -> String {
+fn encode_yay_multiline_array_into(arr: &[Value], indent: usize, out: &mut String) {
     let pad = "  ".repeat(indent);
-    let mut result = Vec::new();
 
     for (i, v) in arr.iter().enumerate() {
-        if i == 0 {
+        if i > 0 {
             // First item: no leading pad (caller handles it)
-            let encoded = encode_yay_array_item(v, indent);
-            result.push(format!("- {}", encoded));
-        } else {
-            let encoded = encode_yay_array_item(v, indent);
-            result.push(format!("{}- {}", pad, encoded));
+            out.push('\n');
+            out.push_str(&pad);
         }
+        out.push_str("- ");
+        encode_yay_array_item_into(v, indent, out);
     }
-
-    result.join("\n")
 }
 
 fn encode_yay_array_item(v: &Value, indent: usize) -> String {
+    let mut out = String::new();
+    encode_yay_array_item_into(v, indent, &mut out);
+    out
+}
+
+fn encode_yay_array_item_into(v: &Value, indent: usize, out: &mut String) {
     match v {
         Value::Array(arr) if !can_inline_array(arr) => {
             // Nested multiline array: first item on same line, rest indented
             let inner_pad = "  ".repeat(indent + 1);
-            let mut items = Vec::new();
             for (i, item) in arr.iter().enumerate() {
-                let encoded = encode_yay_array_item(item, indent + 1);
-                if i == 0 {
-                    // First item: add "- " prefix on same line
-                    items.push(format!("- {}", encoded));
-                } else {
-                    items.push(format!("{}- {}", inner_pad, encoded));
+                if i > 0 {
+                    out.push('\n');
+                    out.push_str(&inner_pad);
                 }
+                // First item: "- " prefix on same line
+                out.push_str("- ");
+                encode_yay_array_item_into(item, indent + 1, out);
             }
-            items.join("\n")
         }
         Value::Object(obj) if !can_inline_object(obj) => {
             // Nested multiline object
             let inner_pad = "  ".repeat(indent + 1);
-            let mut keys: Vec<&String> = obj.keys().collect();
-            keys.sort();
-            let items: Vec<String> = keys
-                .iter()
-                .enumerate()
-                .map(|(i, k)| {
-                    let v = &obj[*k];
-                    if is_block_value(v) {
-                        // Block value: put on next line with proper indentation
-                        let encoded = encode_yay(v, indent + 2);
-                        if i == 0 {
-                            format!("{}:\n{}", encode_yay_key(k), encoded)
-                        } else {
-                            format!("{}{}:\n{}", inner_pad, encode_yay_key(k), encoded)
-                        }
-                    } else {
-                        let encoded = encode_yay(v, indent + 2);
-                        if i == 0 {
-                            format!("{}: {}", encode_yay_key(k), encoded)
-                        } else {
-                            format!("{}{}: {}", inner_pad, encode_yay_key(k), encoded)
-                        }
-                    }
-                })
-                .collect();
-            items.join("\n")
+            for (i, (k, v)) in obj.iter().enumerate() {
+                if i > 0 {
+                    out.push('\n');
+                    out.push_str(&inner_pad);
+                }
+                encode_yay_key_into(k, out);
+                if is_block_value(v) {
+                    // Block value: put on next line with proper indentation
+                    out.push_str(":\n");
+                } else {
+                    out.push_str(": ");
+                }
+                encode_yay_into(v, indent + 2, out);
+            }
         }
-        _ => encode_yay(v, indent + 1),
+        _ => encode_yay_into(v, indent + 1, out),
     }
 }
 
@@ -656,10 +869,10 @@ fn encode_rust(value: &Value, indent: usize) -> String {
         Value::String(s) => format!("Value::String({}.into())", encode_json_string(s)),
         Value::Bytes(b) => {
             if b.is_empty() {
-                "Value::Bytes(vec![])".to_string()
+                "Value::Bytes(vec![].into())".to_string()
             } else {
                 let items: Vec<String> = b.iter().map(|byte| format!("0x{:02x}", byte)).collect();
-                format!("Value::Bytes(vec![{}])", items.join(", "))
+                format!("Value::Bytes(vec![{}].into())", items.join(", "))
             }
         }
         Value::Array(arr) => {
@@ -1066,88 +1279,95 @@ fn encode_scheme_string(s: &str) -> String {
 // =============================================================================
 
 fn encode_json(value: &Value, indent: usize) -> String {
-    let pad = "  ".repeat(indent);
-    let pad1 = "  ".repeat(indent + 1);
+    let mut out = String::new();
+    encode_json_into(value, indent, &mut out);
+    out
+}
 
+fn encode_json_into(value: &Value, indent: usize, out: &mut String) {
     match value {
-        Value::Null => "null".to_string(),
-        Value::Bool(true) => "true".to_string(),
-        Value::Bool(false) => "false".to_string(),
-        Value::Integer(n) => n.to_string(),
+        Value::Null => out.push_str("null"),
+        Value::Bool(true) => out.push_str("true"),
+        Value::Bool(false) => out.push_str("false"),
+        Value::Integer(n) => push_int(out, n),
         Value::Float(f) => {
             if f.is_nan() || f.is_infinite() {
-                "null".to_string() // JSON doesn't support NaN/Infinity
+                out.push_str("null"); // JSON doesn't support NaN/Infinity
             } else {
-                format!("{}", f)
+                let _ = write!(out, "{}", f);
             }
         }
-        Value::String(s) => encode_json_string(s),
-        Value::Bytes(_) => "null".to_string(), // JSON doesn't support bytes
+        Value::String(s) => encode_json_string_into(s, out),
+        Value::Bytes(_) => out.push_str("null"), // JSON doesn't support bytes
         Value::Array(arr) => {
             if arr.is_empty() {
-                "[]".to_string()
+                out.push_str("[]");
             } else {
-                let items: Vec<String> = arr.iter().map(|v| encode_json(v, indent + 1)).collect();
-                format!(
-                    "[\n{}\n{}]",
-                    items
-                        .iter()
-                        .map(|i| format!("{}{}", pad1, i))
-                        .collect::<Vec<_>>()
-                        .join(",\n"),
-                    pad
-                )
+                let pad = "  ".repeat(indent);
+                let pad1 = "  ".repeat(indent + 1);
+                out.push_str("[\n");
+                for (i, v) in arr.iter().enumerate() {
+                    if i > 0 {
+                        out.push_str(",\n");
+                    }
+                    out.push_str(&pad1);
+                    encode_json_into(v, indent + 1, out);
+                }
+                out.push('\n');
+                out.push_str(&pad);
+                out.push(']');
             }
         }
         Value::Object(obj) => {
             if obj.is_empty() {
-                "{}".to_string()
+                out.push_str("{}");
             } else {
                 let mut keys: Vec<&String> = obj.keys().collect();
                 keys.sort();
-                let items: Vec<String> = keys
-                    .iter()
-                    .map(|k| {
-                        format!(
-                            "{}: {}",
-                            encode_json_string(k),
-                            encode_json(&obj[*k], indent + 1)
-                        )
-                    })
-                    .collect();
-                format!(
-                    "{{\n{}\n{}}}",
-                    items
-                        .iter()
-                        .map(|i| format!("{}{}", pad1, i))
-                        .collect::<Vec<_>>()
-                        .join(",\n"),
-                    pad
-                )
+                let pad = "  ".repeat(indent);
+                let pad1 = "  ".repeat(indent + 1);
+                out.push_str("{\n");
+                for (i, k) in keys.iter().enumerate() {
+                    if i > 0 {
+                        out.push_str(",\n");
+                    }
+                    out.push_str(&pad1);
+                    encode_json_string_into(k, out);
+                    out.push_str(": ");
+                    encode_json_into(&obj[*k], indent + 1, out);
+                }
+                out.push('\n');
+                out.push_str(&pad);
+                out.push('}');
             }
         }
     }
 }
 
 fn encode_json_string(s: &str) -> String {
-    let mut result = String::from("\"");
+    let mut out = String::new();
+    encode_json_string_into(s, &mut out);
+    out
+}
+
+fn encode_json_string_into(s: &str, out: &mut String) {
+    out.push('"');
     for c in s.chars() {
         match c {
-            '"' => result.push_str("\\\""),
-            '\\' => result.push_str("\\\\"),
-            '\n' => result.push_str("\\n"),
-            '\r' => result.push_str("\\r"),
-            '\t' => result.push_str("\\t"),
-            '\x08' => result.push_str("\\b"),
-            '\x0c' => result.push_str("\\f"),
+            '"' => out.push_str("\\\""),
+            '\\' => out.push_str("\\\\"),
+            '\n' => out.push_str("\\n"),
+            '\r' => out.push_str("\\r"),
+            '\t' => out.push_str("\\t"),
+            '\x08' => out.push_str("\\b"),
+            '\x0c' => out.push_str("\\f"),
             c if c.is_control() => {
-                result.push_str(&format!("\\u{:04x}", c as u32));
+                let _ = write!(out, "\\u{:04x}", c as u32);
             }
-            c => result.push(c),
+            c => out.push(c),
         }
     }
-    result.push('"');
-    result
+    out.push('"');
 }
 
 /// Encode a string for JavaScript, preferring single quotes when the string
@@ -1293,7 +1513,7 @@ mod tests {
 
     #[test]
     fn test_encode_yson_bytes() {
-        let value = Value::Bytes(vec![0xca, 0xfe]);
+        let value = Value::Bytes(vec![0xca, 0xfe].into());
         assert_eq!(encode(&value, Format::Yson), "\"*cafe\"");
     }
 
@@ -1326,4 +1546,26 @@ mod tests {
         let value = Value::Float(f64::NEG_INFINITY);
         assert_eq!(encode(&value, Format::Yson), "\"#-Infinity\"");
     }
+
+    #[test]
+    fn test_root_object_encoder_matches_encode() {
+        let mut nested = crate::Map::new();
+        nested.insert("c".to_string(), Value::Integer(2.into()));
+        let mut obj = crate::Map::new();
+        obj.insert("a".to_string(), Value::Integer(1.into()));
+        obj.insert("b".to_string(), Value::Object(nested));
+        let value = Value::Object(obj);
+
+        let mut out = Vec::new();
+        let mut encoder = RootObjectEncoder::new(&mut out);
+        if let Value::Object(map) = &value {
+            for (key, entry) in map.iter() {
+                encoder.push(key, entry).unwrap();
+            }
+        }
+        encoder.finish().unwrap();
+        // The nested object keeps the collected encoding in block form,
+        // so the streamed bytes must match it exactly.
+        assert_eq!(String::from_utf8(out).unwrap(), encode(&value, Format::Yay));
+    }
 }
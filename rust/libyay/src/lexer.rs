@@ -7,7 +7,7 @@
 //! - `Text`: Line content
 //! - `Break`: Blank lines (coalesced)
 
-use crate::scanner::ScanLine;
+use crate::scanner::ScanResult;
 
 /// Token type in the outline lexer output.
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
@@ -22,21 +22,22 @@ pub enum TokenType {
     Break,
 }
 
-/// A single token in the token stream.
-#[derive(Debug, Clone)]
-pub struct Token {
+/// A single token in the token stream. Borrows its text from the
+/// source, so a token is five words and copying one never allocates.
+#[derive(Debug, Clone, Copy)]
+pub struct Token<'src> {
     pub typ: TokenType,
-    pub text: String,
+    pub text: &'src str,
     pub indent: usize,
     pub line_num: usize,
     pub col: usize,
 }
 
-impl Token {
-    fn new(typ: TokenType, text: &str, indent: usize, line_num: usize, col: usize) -> Self {
+impl<'src> Token<'src> {
+    fn new(typ: TokenType, text: &'src str, indent: usize, line_num: usize, col: usize) -> Self {
         Self {
             typ,
-            text: text.to_string(),
+            text,
             indent,
             line_num,
             col,
@@ -46,7 +47,7 @@ impl Token {
     fn stop() -> Self {
         Self {
             typ: TokenType::Stop,
-            text: String::new(),
+            text: "",
             indent: 0,
             line_num: 0,
             col: 0,
@@ -55,13 +56,15 @@ impl Token {
 }
 
 /// Convert scan lines to a token stream with block markers.
-pub fn outline_lex(lines: &[ScanLine]) -> Vec<Token> {
-    let mut tokens = Vec::new();
+pub fn outline_lex<'src>(scan: &ScanResult<'src>) -> Vec<Token<'src>> {
+    // The scanner counted the tokens this pass will emit, so the vector
+    // is sized exactly once and never reallocates mid-stream.
+    let mut tokens = Vec::with_capacity(scan.token_count);
     let mut stack = vec![0usize]; // Indent level stack, starts at 0
     let mut top = 0; // Current indent level
     let mut broken = false; // Whether we just emitted a break
 
-    for sl in lines {
+    for sl in &scan.lines {
         // Emit stops for each level we dedent past
         while sl.indent < top {
             tokens.push(Token::stop());
@@ -75,7 +78,7 @@ pub fn outline_lex(lines: &[ScanLine]) -> Vec<Token> {
                 // New nested block
                 tokens.push(Token::new(
                     TokenType::Start,
-                    &sl.leader,
+                    sl.leader,
                     sl.indent,
                     sl.line_num,
                     sl.indent,
@@ -88,7 +91,7 @@ pub fn outline_lex(lines: &[ScanLine]) -> Vec<Token> {
                 tokens.push(Token::stop());
                 tokens.push(Token::new(
                     TokenType::Start,
-                    &sl.leader,
+                    sl.leader,
                     sl.indent,
                     sl.line_num,
                     sl.indent,
@@ -101,7 +104,7 @@ pub fn outline_lex(lines: &[ScanLine]) -> Vec<Token> {
         if !sl.line.is_empty() {
             tokens.push(Token::new(
                 TokenType::Text,
-                &sl.line,
+                sl.line,
                 sl.indent,
                 sl.line_num,
                 sl.indent,
@@ -16,24 +16,44 @@
 //!
 //! 3. **Value Parser**: Recursively parses the token stream into Rust values.
 
+mod de;
+mod diff;
 mod encode;
 mod error;
-mod lexer;
+#[doc(hidden)]
+pub mod lexer;
+mod map;
 mod meh;
-mod parser;
-mod scanner;
+#[doc(hidden)]
+pub mod parser;
+#[doc(hidden)]
+pub mod scanner;
 pub mod shon;
+mod small;
+/// Keyword and escape dispatch tables derived from GRAMMAR.md's
+/// terminal sets by build.rs.
+mod terminals {
+    include!(concat!(env!("OUT_DIR"), "/terminals_gen.rs"));
+}
 mod value;
 mod yson;
 
-pub use encode::{encode, Format};
+pub use de::{from_str, from_value};
+pub use diff::{diff, DiffEntry, DiffOp};
+pub use encode::{encode, encode_to, Format};
+#[doc(hidden)]
+pub use encode::{RootListEncoder, RootObjectEncoder};
+#[doc(hidden)]
+pub use error::ParseContext;
 pub use error::{ParseError, Result};
-pub use meh::format_yay;
+pub use map::Map;
+pub use meh::{format_yay, format_yay_incremental};
 pub use shon::{
     parse_shon_bracket, parse_shon_file_bytes, parse_shon_file_string, parse_shon_hex, ShonError,
 };
-pub use value::Value;
-pub use yson::parse_yson;
+pub use small::{SmallBytes, SmallString};
+pub use value::{Int, Value};
+pub use yson::{parse_yson, parse_yson_lines};
 
 /// Parse a YAY document from a string.
 ///
@@ -56,12 +76,30 @@ pub fn parse_with_filename(input: &str, filename: Option<&str>) -> Result<Value>
     let scan_result = scanner::scan(input, &ctx)?;
 
     // Phase 2: Convert lines to token stream
-    let tokens = lexer::outline_lex(&scan_result.lines);
+    let tokens = lexer::outline_lex(&scan_result);
 
     // Phase 3: Parse tokens into value
     parser::parse_root(&tokens, &ctx, scan_result.had_comments)
 }
 
+/// Validate a YAY document without building its value tree.
+///
+/// Runs the same scanner, lexer, and parser as `parse`, but drops each
+/// root entry as soon as it is checked, so check-style callers hold at
+/// most one root entry's subtree in memory. Returns the same errors as
+/// `parse`.
+pub fn validate(input: &str) -> Result<()> {
+    validate_with_filename(input, None)
+}
+
+/// Validate a YAY document with a filename for error messages.
+pub fn validate_with_filename(input: &str, filename: Option<&str>) -> Result<()> {
+    let ctx = error::ParseContext::new(filename);
+    let scan_result = scanner::scan(input, &ctx)?;
+    let tokens = lexer::outline_lex(&scan_result);
+    parser::validate_root(&tokens, &ctx, scan_result.had_comments)
+}
+
 // Unit tests removed - coverage should come from fixtures
 // #[cfg(test)]
 // mod tests { ... }
@@ -0,0 +1,257 @@
+//! Order-preserving object map.
+//!
+//! YAY objects remember document order, so `Value::Object` stores its
+//! entries in an insertion vector and finds them through a separate
+//! open-addressed index of positions. Iteration walks the vector in
+//! document order, which lets the encoders emit keys without sorting,
+//! and lookups hash with an FxHash-style multiply-xor hasher instead of
+//! paying SipHash per key.
+
+use crate::value::Value;
+use std::fmt;
+use std::ops::Index;
+
+/// Empty slot marker in the position index.
+const EMPTY: u32 = u32::MAX;
+
+/// FxHash-style string hash: fold 8-byte words with rotate-xor-multiply.
+fn fx_hash(key: &str) -> u64 {
+    const SEED: u64 = 0x51_7c_c1_b7_27_22_0a_95;
+    let bytes = key.as_bytes();
+    let mut hash = 0u64;
+    let mut chunks = bytes.chunks_exact(8);
+    for chunk in &mut chunks {
+        let word = u64::from_le_bytes(chunk.try_into().unwrap());
+        hash = (hash.rotate_left(5) ^ word).wrapping_mul(SEED);
+    }
+    let mut last = bytes.len() as u64;
+    for &b in chunks.remainder() {
+        last = (last << 8) | u64::from(b);
+    }
+    (hash.rotate_left(5) ^ last).wrapping_mul(SEED)
+}
+
+/// An object map that preserves insertion order.
+#[derive(Clone, Default)]
+pub struct Map {
+    /// Entries in document order.
+    entries: Vec<(String, Value)>,
+    /// Open-addressed table of positions into `entries`.
+    index: Vec<u32>,
+}
+
+impl Map {
+    /// Creates an empty map.
+    pub fn new() -> Self {
+        Map {
+            entries: Vec::new(),
+            index: Vec::new(),
+        }
+    }
+
+    /// Number of entries.
+    pub fn len(&self) -> usize {
+        self.entries.len()
+    }
+
+    /// Returns `true` if the map has no entries.
+    pub fn is_empty(&self) -> bool {
+        self.entries.is_empty()
+    }
+
+    /// Inserts a key-value pair, returning the previous value for the
+    /// key if there was one. Existing keys keep their position; new keys
+    /// append in document order.
+    pub fn insert(&mut self, key: String, value: Value) -> Option<Value> {
+        if self.entries.len() * 4 >= self.index.len() * 3 {
+            self.grow();
+        }
+        let mask = self.index.len() - 1;
+        let mut slot = (fx_hash(&key) as usize) & mask;
+        loop {
+            match self.index[slot] {
+                EMPTY => {
+                    self.index[slot] = self.entries.len() as u32;
+                    self.entries.push((key, value));
+                    return None;
+                }
+                at => {
+                    let at = at as usize;
+                    if self.entries[at].0 == key {
+                        return Some(std::mem::replace(&mut self.entries[at].1, value));
+                    }
+                    slot = (slot + 1) & mask;
+                }
+            }
+        }
+    }
+
+    /// Looks up a value by key.
+    pub fn get(&self, key: &str) -> Option<&Value> {
+        let at = self.position(key)?;
+        Some(&self.entries[at].1)
+    }
+
+    /// Looks up a value by key for mutation.
+    pub fn get_mut(&mut self, key: &str) -> Option<&mut Value> {
+        let at = self.position(key)?;
+        Some(&mut self.entries[at].1)
+    }
+
+    /// Returns `true` if the map contains the key.
+    pub fn contains_key(&self, key: &str) -> bool {
+        self.position(key).is_some()
+    }
+
+    /// Iterates entries in document order.
+    pub fn iter(&self) -> impl Iterator<Item = (&String, &Value)> {
+        self.entries.iter().map(|(k, v)| (k, v))
+    }
+
+    /// Iterates keys in document order.
+    pub fn keys(&self) -> impl Iterator<Item = &String> {
+        self.entries.iter().map(|(k, _)| k)
+    }
+
+    /// Iterates values in document order.
+    pub fn values(&self) -> impl Iterator<Item = &Value> {
+        self.entries.iter().map(|(_, v)| v)
+    }
+
+    /// Position of a key in the entry vector.
+    fn position(&self, key: &str) -> Option<usize> {
+        if self.index.is_empty() {
+            return None;
+        }
+        let mask = self.index.len() - 1;
+        let mut slot = (fx_hash(key) as usize) & mask;
+        loop {
+            match self.index[slot] {
+                EMPTY => return None,
+                at => {
+                    let at = at as usize;
+                    if self.entries[at].0 == key {
+                        return Some(at);
+                    }
+                    slot = (slot + 1) & mask;
+                }
+            }
+        }
+    }
+
+    /// Doubles the position index and rehashes every entry into it.
+    /// Sorts entries into ascending key order and rebuilds the position
+    /// index. Decoders for foreign formats call this so ingested
+    /// objects encode in the same canonical key order as every other
+    /// producer.
+    pub fn sort_keys(&mut self) {
+        self.entries.sort_by(|a, b| a.0.cmp(&b.0));
+        if !self.index.is_empty() {
+            let mask = self.index.len() - 1;
+            self.index.fill(EMPTY);
+            for (at, (key, _)) in self.entries.iter().enumerate() {
+                let mut slot = (fx_hash(key) as usize) & mask;
+                while self.index[slot] != EMPTY {
+                    slot = (slot + 1) & mask;
+                }
+                self.index[slot] = at as u32;
+            }
+        }
+    }
+
+    fn grow(&mut self) {
+        let capacity = (self.index.len() * 2).max(8);
+        self.index.clear();
+        self.index.resize(capacity, EMPTY);
+        let mask = capacity - 1;
+        for (at, (key, _)) in self.entries.iter().enumerate() {
+            let mut slot = (fx_hash(key) as usize) & mask;
+            while self.index[slot] != EMPTY {
+                slot = (slot + 1) & mask;
+            }
+            self.index[slot] = at as u32;
+        }
+    }
+}
+
+/// Key order is insignificant to equality, matching value semantics
+/// across the other implementations.
+impl PartialEq for Map {
+    fn eq(&self, other: &Self) -> bool {
+        self.len() == other.len()
+            && self
+                .iter()
+                .all(|(k, v)| other.get(k).is_some_and(|ov| v == ov))
+    }
+}
+
+impl fmt::Debug for Map {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_map().entries(self.iter()).finish()
+    }
+}
+
+impl Index<&str> for Map {
+    type Output = Value;
+
+    fn index(&self, key: &str) -> &Value {
+        self.get(key).expect("no entry found for key")
+    }
+}
+
+impl Index<&String> for Map {
+    type Output = Value;
+
+    fn index(&self, key: &String) -> &Value {
+        self.get(key).expect("no entry found for key")
+    }
+}
+
+impl FromIterator<(String, Value)> for Map {
+    fn from_iter<I: IntoIterator<Item = (String, Value)>>(iter: I) -> Self {
+        let mut map = Map::new();
+        for (key, value) in iter {
+            map.insert(key, value);
+        }
+        map
+    }
+}
+
+impl<const N: usize> From<[(String, Value); N]> for Map {
+    fn from(entries: [(String, Value); N]) -> Self {
+        entries.into_iter().collect()
+    }
+}
+
+impl IntoIterator for Map {
+    type Item = (String, Value);
+    type IntoIter = std::vec::IntoIter<(String, Value)>;
+
+    fn into_iter(self) -> Self::IntoIter {
+        self.entries.into_iter()
+    }
+}
+
+impl<'a> IntoIterator for &'a Map {
+    type Item = (&'a String, &'a Value);
+    type IntoIter = Iter<'a>;
+
+    fn into_iter(self) -> Self::IntoIter {
+        Iter {
+            inner: self.entries.iter(),
+        }
+    }
+}
+
+/// Borrowed entry iterator in document order.
+pub struct Iter<'a> {
+    inner: std::slice::Iter<'a, (String, Value)>,
+}
+
+impl<'a> Iterator for Iter<'a> {
+    type Item = (&'a String, &'a Value);
+
+    fn next(&mut self) -> Option<Self::Item> {
+        self.inner.next().map(|(k, v)| (k, v))
+    }
+}
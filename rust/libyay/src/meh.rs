@@ -11,6 +11,7 @@
 //! 2. MEH-to-YAY Transform - Normalizes the CST to canonical form
 //! 3. MEH Formatter - Serializes the CST back to text
 
+use std::borrow::Cow;
 use std::env;
 
 /// Default line wrap length
@@ -26,162 +27,168 @@ fn get_wrap_length() -> usize {
 
 // =============================================================================
 // CST Types
+//
+// Every piece of text in the CST is a Cow borrowing from the source
+// document: the loose parser never allocates for content it does not
+// rewrite, and only the transform's normalizers (number spacing, hex
+// grouping, comment joining and wrapping) produce owned strings. The
+// 'src lifetime spans one format operation.
 // =============================================================================
 
 /// A CST node representing a YAY document
 #[derive(Debug, Clone)]
-pub struct Document {
-    pub items: Vec<Item>,
-    pub trailing_comments: Vec<Comment>,
+pub struct Document<'src> {
+    pub items: Vec<Item<'src>>,
+    pub trailing_comments: Vec<Comment<'src>>,
 }
 
 /// An item in a document or block
 #[derive(Debug, Clone)]
-pub enum Item {
+pub enum Item<'src> {
     /// A blank line
     BlankLine,
     /// A comment line
-    Comment(Comment),
+    Comment(Comment<'src>),
     /// A value (scalar, array, object, etc.)
-    Value(CstValue),
+    Value(CstValue<'src>),
     /// A key-value property
-    Property(Property),
+    Property(Property<'src>),
     /// An array item (- prefix)
-    ArrayItem(ArrayItem),
+    ArrayItem(ArrayItem<'src>),
 }
 
 /// A comment with its content
 #[derive(Debug, Clone)]
-pub struct Comment {
-    pub text: String,                // Content after #
+pub struct Comment<'src> {
+    pub text: Cow<'src, str>,        // Content after #
     pub align_column: Option<usize>, // Column to align to (for inline comments in blocks)
 }
 
 /// A key-value property
 #[derive(Debug, Clone)]
-pub struct Property {
-    pub key: Key,
-    pub value: Option<PropertyValue>,
-    pub inline_comment: Option<Comment>,
+pub struct Property<'src> {
+    pub key: Key<'src>,
+    pub value: Option<PropertyValue<'src>>,
+    pub inline_comment: Option<Comment<'src>>,
 }
 
 /// A property key
 #[derive(Debug, Clone)]
-pub enum Key {
-    Bare(String),
-    SingleQuoted(String),
-    DoubleQuoted(String),
+pub enum Key<'src> {
+    Bare(Cow<'src, str>),
+    SingleQuoted(Cow<'src, str>),
+    DoubleQuoted(Cow<'src, str>),
 }
 
 /// The value part of a property
 #[derive(Debug, Clone)]
-pub enum PropertyValue {
-    Inline(CstValue),
-    Block(Block),
+pub enum PropertyValue<'src> {
+    Inline(CstValue<'src>),
+    Block(Block<'src>),
 }
 
 /// A block (indented content after a property)
 #[derive(Debug, Clone)]
-pub struct Block {
-    pub items: Vec<Item>,
+pub struct Block<'src> {
+    pub items: Vec<Item<'src>>,
 }
 
 /// An array item (- prefix)
 #[derive(Debug, Clone)]
-pub struct ArrayItem {
-    pub value: Option<ArrayItemValue>,
-    pub inline_comment: Option<Comment>,
+pub struct ArrayItem<'src> {
+    pub value: Option<ArrayItemValue<'src>>,
+    pub inline_comment: Option<Comment<'src>>,
 }
 
 /// The value part of an array item
 #[derive(Debug, Clone)]
-pub enum ArrayItemValue {
-    Inline(CstValue),
-    Block(Block),
+pub enum ArrayItemValue<'src> {
+    Inline(CstValue<'src>),
+    Block(Block<'src>),
 }
 
 /// A CST value node
 #[derive(Debug, Clone)]
-pub enum CstValue {
+pub enum CstValue<'src> {
     Null,
     Bool(bool),
-    Integer(String), // Preserve original formatting (spaces)
-    Float(String),   // Preserve original formatting
-    String(CstString),
-    Bytes(CstBytes),
-    Array(CstArray),
-    Object(CstObject),
+    Integer(Cow<'src, str>), // Preserve original formatting (spaces)
+    Float(Cow<'src, str>),   // Preserve original formatting
+    String(CstString<'src>),
+    Bytes(CstBytes<'src>),
+    Array(CstArray<'src>),
+    Object(CstObject<'src>),
 }
 
 /// A string value
 #[derive(Debug, Clone)]
-pub enum CstString {
-    SingleQuoted(String),
-    DoubleQuoted(String),
-    Block(BlockString),
+pub enum CstString<'src> {
+    SingleQuoted(Cow<'src, str>),
+    DoubleQuoted(Cow<'src, str>),
+    Block(BlockString<'src>),
 }
 
 /// A block string (backtick)
 #[derive(Debug, Clone)]
-pub struct BlockString {
-    pub first_line: Option<String>, // Content after ` on first line
-    pub lines: Vec<BlockStringLine>,
+pub struct BlockString<'src> {
+    pub first_line: Option<Cow<'src, str>>, // Content after ` on first line
+    pub lines: Vec<BlockStringLine<'src>>,
 }
 
 #[derive(Debug, Clone)]
-pub struct BlockStringLine {
+pub struct BlockStringLine<'src> {
     pub indent: usize,
-    pub content: String,
+    pub content: Cow<'src, str>,
 }
 
 /// A bytes value
 #[derive(Debug, Clone)]
-pub enum CstBytes {
-    Inline(InlineBytes),
-    Block(BlockBytes),
+pub enum CstBytes<'src> {
+    Inline(InlineBytes<'src>),
+    Block(BlockBytes<'src>),
 }
 
 /// Inline bytes <hex>
 #[derive(Debug, Clone)]
-pub struct InlineBytes {
-    pub content: String, // Content between < and >, preserving spaces
+pub struct InlineBytes<'src> {
+    pub content: Cow<'src, str>, // Content between < and >, preserving spaces
 }
 
 /// Block bytes (> prefix)
 #[derive(Debug, Clone)]
-pub struct BlockBytes {
-    pub first_line_comment: Option<Comment>,
-    pub lines: Vec<BlockBytesLine>,
+pub struct BlockBytes<'src> {
+    pub first_line_comment: Option<Comment<'src>>,
+    pub lines: Vec<BlockBytesLine<'src>>,
 }
 
 #[derive(Debug, Clone)]
-pub struct BlockBytesLine {
+pub struct BlockBytesLine<'src> {
     pub indent: usize,
-    pub hex: String,
-    pub comment: Option<Comment>,
+    pub hex: Cow<'src, str>,
+    pub comment: Option<Comment<'src>>,
 }
 
 /// Inline array [...]
 #[derive(Debug, Clone)]
-pub struct CstArray {
-    pub items: Vec<CstArrayItem>,
+pub struct CstArray<'src> {
+    pub items: Vec<CstArrayItem<'src>>,
 }
 
 #[derive(Debug, Clone)]
-pub struct CstArrayItem {
-    pub value: CstValue,
+pub struct CstArrayItem<'src> {
+    pub value: CstValue<'src>,
 }
 
 /// Inline object {...}
 #[derive(Debug, Clone)]
-pub struct CstObject {
-    pub entries: Vec<CstObjectEntry>,
+pub struct CstObject<'src> {
+    pub entries: Vec<CstObjectEntry<'src>>,
 }
 
 #[derive(Debug, Clone)]
-pub struct CstObjectEntry {
-    pub key: Key,
-    pub value: CstValue,
+pub struct CstObjectEntry<'src> {
+    pub key: Key<'src>,
+    pub value: CstValue<'src>,
 }
 
 // =============================================================================
@@ -204,7 +211,7 @@ impl<'a> MehParser<'a> {
         }
     }
 
-    pub fn parse(&mut self) -> Result<Document, String> {
+    pub fn parse(&mut self) -> Result<Document<'a>, String> {
         let mut items = Vec::new();
 
         while self.line_idx < self.lines.len() {
@@ -228,7 +235,7 @@ impl<'a> MehParser<'a> {
         self.col = 0;
     }
 
-    fn parse_item(&mut self, min_indent: usize) -> Result<Option<Item>, String> {
+    fn parse_item(&mut self, min_indent: usize) -> Result<Option<Item<'a>>, String> {
         let line = match self.current_line() {
             Some(l) => l,
             None => return Ok(None),
@@ -251,7 +258,7 @@ impl<'a> MehParser<'a> {
         // Comment line
         if let Some(stripped) = content.strip_prefix('#') {
             let comment = Comment {
-                text: stripped.to_string(),
+                text: Cow::Borrowed(stripped),
                 align_column: None,
             };
             self.advance_line();
@@ -270,7 +277,7 @@ impl<'a> MehParser<'a> {
 
         // Block string at root level
         if content == "`" || content.starts_with("` ") {
-            let first_line = content.strip_prefix("` ").map(|s| s.to_string());
+            let first_line = content.strip_prefix("` ").map(Cow::Borrowed);
             self.advance_line();
             let block_str = self.parse_block_string_lines(indent, first_line)?;
             return Ok(Some(Item::Value(CstValue::String(CstString::Block(
@@ -286,14 +293,14 @@ impl<'a> MehParser<'a> {
                     (
                         None,
                         Some(Comment {
-                            text: rest.trim_start()[1..].to_string(),
+                            text: Cow::Borrowed(&rest.trim_start()[1..]),
                             align_column: None,
                         }),
                     )
                 } else if !rest.trim().is_empty() {
                     // Hex data on the first line (possibly with inline comment)
                     let (hex_part, comment) = split_inline_comment(rest);
-                    (Some(hex_part.trim().to_string()), comment)
+                    (Some(Cow::Borrowed(hex_part.trim())), comment)
                 } else {
                     (None, None)
                 }
@@ -323,7 +330,7 @@ impl<'a> MehParser<'a> {
         Ok(Some(Item::Value(value)))
     }
 
-    fn parse_array_item(&mut self, indent: usize) -> Result<Option<Item>, String> {
+    fn parse_array_item(&mut self, indent: usize) -> Result<Option<Item<'a>>, String> {
         let line = self.current_line().unwrap();
         let content = &line[indent..];
 
@@ -346,7 +353,7 @@ impl<'a> MehParser<'a> {
             }
         } else if value_part == "`" || value_part.starts_with("` ") {
             // Block string in array item
-            let first_line = value_part.strip_prefix("` ").map(|s| s.to_string());
+            let first_line = value_part.strip_prefix("` ").map(Cow::Borrowed);
             let block_str = self.parse_block_string_lines(indent, first_line)?;
             Some(ArrayItemValue::Inline(CstValue::String(CstString::Block(
                 block_str,
@@ -385,7 +392,11 @@ impl<'a> MehParser<'a> {
         })))
     }
 
-    fn parse_property(&mut self, indent: usize, colon_idx: usize) -> Result<Option<Item>, String> {
+    fn parse_property(
+        &mut self,
+        indent: usize,
+        colon_idx: usize,
+    ) -> Result<Option<Item<'a>>, String> {
         let line = self.current_line().unwrap();
         let content = &line[indent..];
 
@@ -425,14 +436,14 @@ impl<'a> MehParser<'a> {
                     (
                         None,
                         Some(Comment {
-                            text: rest.trim_start()[1..].to_string(),
+                            text: Cow::Borrowed(&rest.trim_start()[1..]),
                             align_column: None,
                         }),
                     )
                 } else if !rest.trim().is_empty() {
                     // Hex data on the first line (possibly with inline comment)
                     let (hex_part, comment) = split_inline_comment(rest);
-                    (Some(hex_part.trim().to_string()), comment)
+                    (Some(Cow::Borrowed(hex_part.trim())), comment)
                 } else {
                     (None, None)
                 }
@@ -464,7 +475,7 @@ impl<'a> MehParser<'a> {
         })))
     }
 
-    fn parse_block(&mut self, parent_indent: usize) -> Result<Block, String> {
+    fn parse_block(&mut self, parent_indent: usize) -> Result<Block<'a>, String> {
         let mut items = Vec::new();
 
         while let Some(line) = self.current_line() {
@@ -504,9 +515,9 @@ impl<'a> MehParser<'a> {
     /// Parse an array item from inline content (e.g., "- a" from "- - a")
     fn parse_inline_array_item(
         &mut self,
-        content: &str,
+        content: &'a str,
         _indent: usize,
-    ) -> Result<ArrayItem, String> {
+    ) -> Result<ArrayItem<'a>, String> {
         // content starts with "- " or is just "-"
         let after_dash = content.strip_prefix("- ").unwrap_or_default();
 
@@ -537,7 +548,11 @@ impl<'a> MehParser<'a> {
     }
 
     /// Parse a property from inline content (e.g., "a: 1" from "- a: 1")
-    fn parse_inline_property(&self, content: &str, _indent: usize) -> Result<Property, String> {
+    fn parse_inline_property(
+        &self,
+        content: &'a str,
+        _indent: usize,
+    ) -> Result<Property<'a>, String> {
         let colon_idx = find_colon_outside_quotes(content).unwrap();
         let key_str = &content[..colon_idx];
         let after_colon = &content[colon_idx + 1..];
@@ -559,15 +574,15 @@ impl<'a> MehParser<'a> {
         })
     }
 
-    fn parse_block_string(&mut self, parent_indent: usize) -> Result<BlockString, String> {
+    fn parse_block_string(&mut self, parent_indent: usize) -> Result<BlockString<'a>, String> {
         self.parse_block_string_lines(parent_indent, None)
     }
 
     fn parse_block_string_lines(
         &mut self,
         parent_indent: usize,
-        first_line: Option<String>,
-    ) -> Result<BlockString, String> {
+        first_line: Option<Cow<'a, str>>,
+    ) -> Result<BlockString<'a>, String> {
         let mut lines = Vec::new();
 
         while let Some(line) = self.current_line() {
@@ -575,7 +590,7 @@ impl<'a> MehParser<'a> {
                 self.advance_line();
                 lines.push(BlockStringLine {
                     indent: 0,
-                    content: String::new(),
+                    content: Cow::Borrowed(""),
                 });
                 continue;
             }
@@ -587,7 +602,7 @@ impl<'a> MehParser<'a> {
 
             lines.push(BlockStringLine {
                 indent,
-                content: line[indent..].to_string(),
+                content: Cow::Borrowed(&line[indent..]),
             });
             self.advance_line();
         }
@@ -598,8 +613,8 @@ impl<'a> MehParser<'a> {
     fn parse_block_bytes(
         &mut self,
         parent_indent: usize,
-        first_comment: Option<Comment>,
-    ) -> Result<BlockBytes, String> {
+        first_comment: Option<Comment<'a>>,
+    ) -> Result<BlockBytes<'a>, String> {
         let mut lines = Vec::new();
 
         while let Some(line) = self.current_line() {
@@ -619,9 +634,9 @@ impl<'a> MehParser<'a> {
                 // Standalone comment - store as a hex line with empty hex and the comment
                 lines.push(BlockBytesLine {
                     indent,
-                    hex: String::new(),
+                    hex: Cow::Borrowed(""),
                     comment: Some(Comment {
-                        text: stripped.to_string(),
+                        text: Cow::Borrowed(stripped),
                         align_column: None,
                     }),
                 });
@@ -633,7 +648,7 @@ impl<'a> MehParser<'a> {
 
             lines.push(BlockBytesLine {
                 indent,
-                hex: hex_part.to_string(),
+                hex: Cow::Borrowed(hex_part),
                 comment,
             });
             self.advance_line();
@@ -645,7 +660,7 @@ impl<'a> MehParser<'a> {
         })
     }
 
-    fn parse_inline_value(&self, s: &str) -> Result<CstValue, String> {
+    fn parse_inline_value(&self, s: &'a str) -> Result<CstValue<'a>, String> {
         let s = s.trim();
 
         if s.is_empty() {
@@ -662,16 +677,16 @@ impl<'a> MehParser<'a> {
 
         // String
         if s.starts_with('"') {
-            return Ok(CstValue::String(CstString::DoubleQuoted(s.to_string())));
+            return Ok(CstValue::String(CstString::DoubleQuoted(Cow::Borrowed(s))));
         }
         if s.starts_with('\'') {
-            return Ok(CstValue::String(CstString::SingleQuoted(s.to_string())));
+            return Ok(CstValue::String(CstString::SingleQuoted(Cow::Borrowed(s))));
         }
 
         // Inline bytes
         if s.starts_with('<') && s.ends_with('>') {
             return Ok(CstValue::Bytes(CstBytes::Inline(InlineBytes {
-                content: s[1..s.len() - 1].to_string(),
+                content: Cow::Borrowed(&s[1..s.len() - 1]),
             })));
         }
 
@@ -694,28 +709,27 @@ impl<'a> MehParser<'a> {
                 || s == "infinity"
                 || s == "-infinity"
             {
-                return Ok(CstValue::Float(s.to_string()));
+                return Ok(CstValue::Float(Cow::Borrowed(s)));
             } else {
-                return Ok(CstValue::Integer(s.to_string()));
+                return Ok(CstValue::Integer(Cow::Borrowed(s)));
             }
         }
 
         // Special float keywords
         match s {
-            "nan" => return Ok(CstValue::Float(s.to_string())),
-            "infinity" | "-infinity" => return Ok(CstValue::Float(s.to_string())),
+            "nan" => return Ok(CstValue::Float(Cow::Borrowed(s))),
+            "infinity" | "-infinity" => return Ok(CstValue::Float(Cow::Borrowed(s))),
             _ => {}
         }
 
         // Bare identifier - treat as a string value
         // This handles cases like property values that are unquoted identifiers
-        Ok(CstValue::String(CstString::DoubleQuoted(format!(
-            "\"{}\"",
-            s
+        Ok(CstValue::String(CstString::DoubleQuoted(Cow::Owned(
+            format!("\"{}\"", s),
         ))))
     }
 
-    fn parse_inline_array(&self, s: &str) -> Result<CstValue, String> {
+    fn parse_inline_array(&self, s: &'a str) -> Result<CstValue<'a>, String> {
         let inner = &s[1..s.len() - 1];
         let trimmed = inner.trim();
 
@@ -742,7 +756,7 @@ impl<'a> MehParser<'a> {
         Ok(CstValue::Array(CstArray { items }))
     }
 
-    fn parse_inline_object(&self, s: &str) -> Result<CstValue, String> {
+    fn parse_inline_object(&self, s: &'a str) -> Result<CstValue<'a>, String> {
         let inner = &s[1..s.len() - 1];
         let trimmed = inner.trim();
 
@@ -818,17 +832,17 @@ fn find_colon_outside_quotes(s: &str) -> Option<usize> {
     None
 }
 
-fn parse_key(s: &str) -> Key {
+fn parse_key(s: &str) -> Key<'_> {
     if s.starts_with('"') && s.ends_with('"') {
-        Key::DoubleQuoted(s.to_string())
+        Key::DoubleQuoted(Cow::Borrowed(s))
     } else if s.starts_with('\'') && s.ends_with('\'') {
-        Key::SingleQuoted(s.to_string())
+        Key::SingleQuoted(Cow::Borrowed(s))
     } else {
-        Key::Bare(s.to_string())
+        Key::Bare(Cow::Borrowed(s))
     }
 }
 
-fn split_inline_comment(s: &str) -> (&str, Option<Comment>) {
+fn split_inline_comment(s: &str) -> (&str, Option<Comment<'_>>) {
     // Find # not inside quotes
     let mut in_double = false;
     let mut in_single = false;
@@ -853,7 +867,7 @@ fn split_inline_comment(s: &str) -> (&str, Option<Comment>) {
             return (
                 value_part,
                 Some(Comment {
-                    text: comment_text.to_string(),
+                    text: Cow::Borrowed(comment_text),
                     align_column: None,
                 }),
             );
@@ -937,7 +951,7 @@ fn looks_like_number(s: &str) -> bool {
 // MEH-to-YAY Transform
 // =============================================================================
 
-pub fn transform_to_canonical(doc: &Document) -> Document {
+pub fn transform_to_canonical<'src>(doc: &Document<'src>) -> Document<'src> {
     let wrap = get_wrap_length();
     let transformer = Transformer { wrap };
     transformer.transform_document(doc)
@@ -948,7 +962,7 @@ struct Transformer {
 }
 
 impl Transformer {
-    fn transform_document(&self, doc: &Document) -> Document {
+    fn transform_document<'src>(&self, doc: &Document<'src>) -> Document<'src> {
         let items = self.transform_items_with_alignment(&doc.items, 0);
 
         Document {
@@ -958,7 +972,11 @@ impl Transformer {
     }
 
     /// Transform a list of items, handling blank line collapsing and comment alignment
-    fn transform_items_with_alignment(&self, items: &[Item], base_indent: usize) -> Vec<Item> {
+    fn transform_items_with_alignment<'src>(
+        &self,
+        items: &[Item<'src>],
+        base_indent: usize,
+    ) -> Vec<Item<'src>> {
         let mut result = Vec::new();
         let mut prev_was_blank = false;
 
@@ -992,7 +1010,11 @@ impl Transformer {
 
     /// Transform an item, potentially expanding it into multiple items
     /// (e.g., when converting inline array to block form)
-    fn transform_item_maybe_expand(&self, item: &Item, indent: usize) -> Vec<Item> {
+    fn transform_item_maybe_expand<'src>(
+        &self,
+        item: &Item<'src>,
+        indent: usize,
+    ) -> Vec<Item<'src>> {
         match item {
             Item::Property(p) => self.transform_property_maybe_expand(p, indent),
             _ => vec![self.transform_item(item, indent)],
@@ -1000,7 +1022,11 @@ impl Transformer {
     }
 
     /// Transform a property, potentially expanding inline arrays/objects to block form
-    fn transform_property_maybe_expand(&self, prop: &Property, indent: usize) -> Vec<Item> {
+    fn transform_property_maybe_expand<'src>(
+        &self,
+        prop: &Property<'src>,
+        indent: usize,
+    ) -> Vec<Item<'src>> {
         let key_width = self.key_width(&prop.key);
 
         // Check if we need to expand an inline array/object to block form
@@ -1037,7 +1063,7 @@ impl Transformer {
                     if prefix_width + value_width > self.wrap {
                         // Convert to block form: property with block value containing nested properties
                         // Object properties are children at indent + 1
-                        let nested_items: Vec<Item> = obj
+                        let nested_items: Vec<Item<'src>> = obj
                             .entries
                             .iter()
                             .map(|entry| {
@@ -1269,7 +1295,7 @@ impl Transformer {
         total
     }
 
-    fn transform_item(&self, item: &Item, indent: usize) -> Item {
+    fn transform_item<'src>(&self, item: &Item<'src>, indent: usize) -> Item<'src> {
         match item {
             Item::BlankLine => Item::BlankLine,
             Item::Comment(c) => Item::Comment(c.clone()),
@@ -1279,7 +1305,7 @@ impl Transformer {
         }
     }
 
-    fn transform_property(&self, prop: &Property, indent: usize) -> Property {
+    fn transform_property<'src>(&self, prop: &Property<'src>, indent: usize) -> Property<'src> {
         Property {
             key: prop.key.clone(),
             value: prop
@@ -1290,7 +1316,11 @@ impl Transformer {
         }
     }
 
-    fn transform_property_value(&self, value: &PropertyValue, indent: usize) -> PropertyValue {
+    fn transform_property_value<'src>(
+        &self,
+        value: &PropertyValue<'src>,
+        indent: usize,
+    ) -> PropertyValue<'src> {
         match value {
             PropertyValue::Inline(v) => PropertyValue::Inline(self.transform_value(v, indent)),
             PropertyValue::Block(b) => {
@@ -1312,13 +1342,13 @@ impl Transformer {
         }
     }
 
-    fn transform_block(&self, block: &Block, indent: usize) -> Block {
+    fn transform_block<'src>(&self, block: &Block<'src>, indent: usize) -> Block<'src> {
         Block {
             items: self.transform_items_with_alignment(&block.items, indent),
         }
     }
 
-    fn transform_array_item(&self, item: &ArrayItem, indent: usize) -> ArrayItem {
+    fn transform_array_item<'src>(&self, item: &ArrayItem<'src>, indent: usize) -> ArrayItem<'src> {
         ArrayItem {
             value: item.value.as_ref().map(|v| match v {
                 ArrayItemValue::Inline(val) => {
@@ -1332,12 +1362,12 @@ impl Transformer {
         }
     }
 
-    fn transform_value(&self, value: &CstValue, indent: usize) -> CstValue {
+    fn transform_value<'src>(&self, value: &CstValue<'src>, indent: usize) -> CstValue<'src> {
         match value {
             CstValue::Null => CstValue::Null,
             CstValue::Bool(b) => CstValue::Bool(*b),
-            CstValue::Integer(s) => CstValue::Integer(normalize_number_spaces(s)),
-            CstValue::Float(s) => CstValue::Float(canonicalize_float(s)),
+            CstValue::Integer(s) => CstValue::Integer(renormalize(s, normalize_number_spaces)),
+            CstValue::Float(s) => CstValue::Float(renormalize(s, canonicalize_float)),
             CstValue::String(s) => CstValue::String(s.clone()),
             CstValue::Bytes(b) => self.transform_bytes(b, indent),
             CstValue::Array(a) => self.transform_array(a, indent),
@@ -1345,10 +1375,10 @@ impl Transformer {
         }
     }
 
-    fn transform_bytes(&self, bytes: &CstBytes, indent: usize) -> CstValue {
+    fn transform_bytes<'src>(&self, bytes: &CstBytes<'src>, indent: usize) -> CstValue<'src> {
         match bytes {
             CstBytes::Inline(ib) => {
-                let normalized = normalize_hex_spaces(&ib.content);
+                let normalized = renormalize(&ib.content, normalize_hex_spaces);
                 let inline_width = indent * 2 + normalized.len() + 2; // indent + <hex>
 
                 // If too long, convert to block form
@@ -1362,12 +1392,12 @@ impl Transformer {
             }
             CstBytes::Block(bb) => {
                 // Normalize hex in each line
-                let mut lines: Vec<BlockBytesLine> = bb
+                let mut lines: Vec<BlockBytesLine<'src>> = bb
                     .lines
                     .iter()
                     .map(|line| BlockBytesLine {
                         indent: line.indent,
-                        hex: normalize_hex_spaces(&line.hex),
+                        hex: renormalize(&line.hex, normalize_hex_spaces),
                         comment: line.comment.clone(),
                     })
                     .collect();
@@ -1390,7 +1420,7 @@ impl Transformer {
     }
 
     /// Convert inline bytes to block form when too long
-    fn inline_bytes_to_block(&self, hex: &str, indent: usize) -> CstValue {
+    fn inline_bytes_to_block<'src>(&self, hex: &str, indent: usize) -> CstValue<'src> {
         // Remove spaces to get raw hex
         let raw: String = hex.chars().filter(|c| !c.is_whitespace()).collect();
 
@@ -1405,10 +1435,10 @@ impl Transformer {
 
         for chunk in chars.chunks(chars_per_line) {
             let chunk_str: String = chunk.iter().collect();
-            let formatted = normalize_hex_spaces(&chunk_str);
+            let formatted = normalize_hex_spaces(&chunk_str).into_owned();
             lines.push(BlockBytesLine {
                 indent: indent + 1,
-                hex: formatted,
+                hex: Cow::Owned(formatted),
                 comment: None,
             });
         }
@@ -1422,7 +1452,10 @@ impl Transformer {
     /// Join fragmented comments: merge continuation lines (empty hex) into preceding lines.
     /// Stop joining when a line ends with sentence-ending punctuation.
     /// A period followed by a capitalized word (like "Mr. Smith") is NOT a sentence end.
-    fn join_block_bytes_comments(&self, lines: Vec<BlockBytesLine>) -> Vec<BlockBytesLine> {
+    fn join_block_bytes_comments<'src>(
+        &self,
+        lines: Vec<BlockBytesLine<'src>>,
+    ) -> Vec<BlockBytesLine<'src>> {
         /// Check if a word starts with a capital letter
         fn starts_with_capital(word: &str) -> bool {
             word.chars().next().is_some_and(|c| c.is_ascii_uppercase())
@@ -1462,7 +1495,7 @@ impl Transformer {
             false
         }
 
-        let mut result: Vec<BlockBytesLine> = Vec::new();
+        let mut result: Vec<BlockBytesLine<'src>> = Vec::new();
 
         for line in lines {
             if !line.hex.is_empty() {
@@ -1483,8 +1516,11 @@ impl Transformer {
                     if let Some(prev) = result.last_mut() {
                         if let Some(ref mut prev_comment) = prev.comment {
                             let continuation_text = comment.text.trim();
-                            prev_comment.text =
-                                format!("{} {}", prev_comment.text.trim_end(), continuation_text);
+                            prev_comment.text = Cow::Owned(format!(
+                                "{} {}",
+                                prev_comment.text.trim_end(),
+                                continuation_text
+                            ));
                         }
                     }
                 } else {
@@ -1539,11 +1575,11 @@ impl Transformer {
     }
 
     /// Wrap long comments in block bytes lines
-    fn wrap_block_bytes_comments(
+    fn wrap_block_bytes_comments<'src>(
         &self,
-        lines: Vec<BlockBytesLine>,
+        lines: Vec<BlockBytesLine<'src>>,
         indent: usize,
-    ) -> Vec<BlockBytesLine> {
+    ) -> Vec<BlockBytesLine<'src>> {
         let indent_width = (indent + 1) * 2;
         let mut result = Vec::new();
 
@@ -1579,7 +1615,7 @@ impl Transformer {
                 indent: line.indent,
                 hex: line.hex.clone(),
                 comment: Some(Comment {
-                    text: wrapped[0].clone(),
+                    text: Cow::Owned(wrapped[0].clone()),
                     align_column: comment.align_column,
                 }),
             });
@@ -1588,10 +1624,10 @@ impl Transformer {
             for continuation in &wrapped[1..] {
                 result.push(BlockBytesLine {
                     indent: line.indent,
-                    hex: String::new(), // Empty hex = standalone comment
+                    hex: Cow::Borrowed(""), // Empty hex = standalone comment
                     comment: Some(Comment {
-                        text: format!(" {}", continuation), // Space after #
-                        align_column: Some(align_col),      // Align with the # above
+                        text: Cow::Owned(format!(" {}", continuation)), // Space after #
+                        align_column: Some(align_col),                  // Align with the # above
                     }),
                 });
             }
@@ -1600,8 +1636,8 @@ impl Transformer {
         result
     }
 
-    fn transform_array(&self, arr: &CstArray, indent: usize) -> CstValue {
-        let items: Vec<CstArrayItem> = arr
+    fn transform_array<'src>(&self, arr: &CstArray<'src>, indent: usize) -> CstValue<'src> {
+        let items: Vec<CstArrayItem<'src>> = arr
             .items
             .iter()
             .map(|item| CstArrayItem {
@@ -1612,8 +1648,8 @@ impl Transformer {
         CstValue::Array(CstArray { items })
     }
 
-    fn transform_object(&self, obj: &CstObject, indent: usize) -> CstValue {
-        let entries: Vec<CstObjectEntry> = obj
+    fn transform_object<'src>(&self, obj: &CstObject<'src>, indent: usize) -> CstValue<'src> {
+        let entries: Vec<CstObjectEntry<'src>> = obj
             .entries
             .iter()
             .map(|entry| CstObjectEntry {
@@ -1771,7 +1807,25 @@ fn wrap_comment_text(text: &str, max_width: usize) -> Vec<String> {
     lines
 }
 
-fn normalize_number_spaces(s: &str) -> String {
+/// Run a borrowing normalizer over a Cow while keeping the source
+/// lifetime: borrowed text the normalizer leaves alone stays borrowed,
+/// so already-canonical input costs nothing to transform.
+fn renormalize<'src>(
+    s: &Cow<'src, str>,
+    normalize: impl for<'a> Fn(&'a str) -> Cow<'a, str>,
+) -> Cow<'src, str> {
+    match s {
+        Cow::Borrowed(b) => normalize(b),
+        Cow::Owned(o) => Cow::Owned(normalize(o).into_owned()),
+    }
+}
+
+fn normalize_number_spaces(s: &str) -> Cow<'_, str> {
+    // Already canonical: no leading/trailing spaces, no doubled spaces
+    if !s.starts_with(' ') && !s.ends_with(' ') && !s.contains("  ") {
+        return Cow::Borrowed(s);
+    }
+
     // Collapse multiple spaces to single space
     let mut result = String::new();
     let mut prev_space = false;
@@ -1788,16 +1842,14 @@ fn normalize_number_spaces(s: &str) -> String {
         }
     }
 
-    result.trim().to_string()
+    Cow::Owned(result.trim().to_string())
 }
 
 /// Canonicalize a float string to its shortest representation that round-trips.
-fn canonicalize_float(s: &str) -> String {
+fn canonicalize_float(s: &str) -> Cow<'_, str> {
     // Handle special values
     match s {
-        "nan" => return "nan".to_string(),
-        "infinity" => return "infinity".to_string(),
-        "-infinity" => return "-infinity".to_string(),
+        "nan" | "infinity" | "-infinity" => return Cow::Borrowed(s),
         _ => {}
     }
 
@@ -1807,18 +1859,18 @@ fn canonicalize_float(s: &str) -> String {
     // Parse to f64
     let f: f64 = match compact.parse() {
         Ok(v) => v,
-        Err(_) => return s.to_string(), // Preserve original if parse fails
+        Err(_) => return Cow::Borrowed(s), // Preserve original if parse fails
     };
 
     // Handle special float values
     if f.is_nan() {
-        return "nan".to_string();
+        return Cow::Borrowed("nan");
     }
     if f.is_infinite() {
         return if f.is_sign_positive() {
-            "infinity".to_string()
+            Cow::Borrowed("infinity")
         } else {
-            "-infinity".to_string()
+            Cow::Borrowed("-infinity")
         };
     }
 
@@ -1836,13 +1888,54 @@ fn canonicalize_float(s: &str) -> String {
 
     // Ensure floats have a decimal point to distinguish from integers
     if !formatted.contains('.') && !formatted.contains('e') && !formatted.contains('E') {
-        format!("{}.0", formatted)
+        Cow::Owned(format!("{}.0", formatted))
+    } else if formatted == s {
+        Cow::Borrowed(s)
     } else {
-        formatted
+        Cow::Owned(formatted)
+    }
+}
+
+/// Check whether hex text is already in canonical form: lowercase byte
+/// pairs, single space between bytes, double space between 4-byte words.
+fn hex_is_normalized(s: &str) -> bool {
+    fn is_lower_hex(c: u8) -> bool {
+        matches!(c, b'0'..=b'9' | b'a'..=b'f')
     }
+
+    let bytes = s.as_bytes();
+    let mut i = 0;
+    let mut byte_count = 0usize;
+
+    while i < bytes.len() {
+        if i + 2 > bytes.len() || !is_lower_hex(bytes[i]) || !is_lower_hex(bytes[i + 1]) {
+            return false;
+        }
+        i += 2;
+        byte_count += 1;
+        if i == bytes.len() {
+            return true;
+        }
+        let sep: &[u8] = if byte_count.is_multiple_of(4) {
+            b"  "
+        } else {
+            b" "
+        };
+        if !bytes[i..].starts_with(sep) {
+            return false;
+        }
+        i += sep.len();
+    }
+
+    s.is_empty()
 }
 
-fn normalize_hex_spaces(s: &str) -> String {
+fn normalize_hex_spaces(s: &str) -> Cow<'_, str> {
+    // Idempotent reformatting is the common case: leave canonical hex alone
+    if hex_is_normalized(s) {
+        return Cow::Borrowed(s);
+    }
+
     // Remove all spaces, lowercase, then re-add with proper grouping
     let hex: String = s
         .chars()
@@ -1851,7 +1944,7 @@ fn normalize_hex_spaces(s: &str) -> String {
         .collect();
 
     if hex.is_empty() {
-        return String::new();
+        return Cow::Borrowed("");
     }
 
     // Group into bytes (2 chars each), then words (4 bytes = 8 chars)
@@ -1871,7 +1964,7 @@ fn normalize_hex_spaces(s: &str) -> String {
         }
     }
 
-    result
+    Cow::Owned(result)
 }
 
 // =============================================================================
@@ -2383,6 +2476,163 @@ pub fn format_yay(input: &str) -> Result<String, String> {
     Ok(format_document(&canonical))
 }
 
+// =============================================================================
+// Incremental Formatting
+// =============================================================================
+
+/// Split a document into top-level chunks.
+///
+/// A chunk boundary is a run of blank lines followed by an unindented
+/// line, mirroring the blank-line lookahead in `parse_block`: such
+/// blanks always surface as top-level items, so each boundary collapses
+/// to a single blank line in canonical form. The one exception is an
+/// open block string — block strings absorb every blank line that
+/// follows them — so boundaries are suppressed while a backtick line's
+/// block is still open. A backtick anywhere in a line conservatively
+/// counts as opening a block string; that can only merge chunks, never
+/// split where the parser would not. Separator blanks are excluded from
+/// the chunks; trailing blank lines stay with the final chunk because a
+/// block string may own them.
+fn split_top_chunks(input: &str) -> Vec<&str> {
+    let mut chunks = Vec::new();
+    let mut chunk_start: Option<usize> = None;
+    let mut chunk_end = 0;
+    let mut saw_blank = false;
+    let mut open_string_indent: Option<usize> = None;
+
+    let mut pos = 0;
+    while pos < input.len() {
+        let line_end = match input[pos..].find('\n') {
+            Some(i) => pos + i + 1,
+            None => input.len(),
+        };
+        let line = &input[pos..line_end];
+        let stripped = line.strip_suffix('\n').unwrap_or(line);
+
+        if stripped.trim().is_empty() {
+            // Leading blank lines belong to no chunk
+            if chunk_start.is_some() {
+                saw_blank = true;
+            }
+        } else {
+            let indent = count_indent(stripped);
+            if saw_blank && indent == 0 && open_string_indent.is_none() {
+                chunks.push(&input[chunk_start.unwrap()..chunk_end]);
+                chunk_start = None;
+            }
+            if let Some(parent) = open_string_indent {
+                if indent <= parent {
+                    open_string_indent = None;
+                }
+            }
+            if open_string_indent.is_none() && stripped.contains('`') {
+                open_string_indent = Some(indent);
+            }
+            if chunk_start.is_none() {
+                chunk_start = Some(pos);
+            }
+            chunk_end = line_end;
+            saw_blank = false;
+        }
+
+        pos = line_end;
+    }
+
+    if let Some(start) = chunk_start {
+        let end = if saw_blank { input.len() } else { chunk_end };
+        chunks.push(&input[start..end]);
+    }
+
+    chunks
+}
+
+/// Format loose YAY incrementally, reusing the output of a previous run.
+///
+/// Splits both sources into top-level chunks, reformats only the chunks
+/// that changed, and splices the previous formatted text verbatim for
+/// the unchanged prefix and suffix, so the cost of a reformat is
+/// proportional to the size of the edit rather than the document.
+///
+/// Provided `previous_output` is `format_yay(previous_input)`, the
+/// result is byte-for-byte identical to `format_yay(input)`. When the
+/// previous texts cannot be matched up chunk-for-chunk, falls back to a
+/// full reformat.
+pub fn format_yay_incremental(
+    input: &str,
+    previous_input: &str,
+    previous_output: &str,
+) -> Result<String, String> {
+    if input == previous_input {
+        return Ok(previous_output.to_string());
+    }
+
+    let new_chunks = split_top_chunks(input);
+    let prev_chunks = split_top_chunks(previous_input);
+    let prev_out_chunks = split_top_chunks(previous_output);
+
+    // The previous output must map one-to-one onto the previous input's
+    // chunks, otherwise we cannot tell which formatted span came from
+    // which chunk.
+    if prev_chunks.len() != prev_out_chunks.len() {
+        return format_yay(input);
+    }
+
+    let mut prefix = 0;
+    while prefix < new_chunks.len()
+        && prefix < prev_chunks.len()
+        && new_chunks[prefix] == prev_chunks[prefix]
+    {
+        prefix += 1;
+    }
+
+    let mut suffix = 0;
+    while suffix < new_chunks.len() - prefix
+        && suffix < prev_chunks.len() - prefix
+        && new_chunks[new_chunks.len() - 1 - suffix] == prev_chunks[prev_chunks.len() - 1 - suffix]
+    {
+        suffix += 1;
+    }
+
+    // Reformat the dirty middle as a document of its own
+    let dirty = &new_chunks[prefix..new_chunks.len() - suffix];
+    let dirty_output = if dirty.is_empty() {
+        String::new()
+    } else {
+        let mut source = String::new();
+        for (i, chunk) in dirty.iter().enumerate() {
+            if i > 0 {
+                source.push('\n');
+            }
+            source.push_str(chunk);
+            if !source.ends_with('\n') {
+                source.push('\n');
+            }
+        }
+        format_yay(&source)?
+    };
+
+    // Splice: every unit ends with a newline, and chunks are separated
+    // by exactly one blank line in canonical form
+    let mut output = String::new();
+    let push_unit = |output: &mut String, unit: &str| {
+        if !output.is_empty() {
+            output.push('\n');
+        }
+        output.push_str(unit);
+    };
+    for chunk in &prev_out_chunks[..prefix] {
+        push_unit(&mut output, chunk);
+    }
+    if !dirty_output.is_empty() {
+        push_unit(&mut output, &dirty_output);
+    }
+    for chunk in &prev_out_chunks[prev_out_chunks.len() - suffix..] {
+        push_unit(&mut output, chunk);
+    }
+
+    Ok(output)
+}
+
 // Most MEH functionality is tested via fixtures in test/meh/
 // These unit tests cover internal helper functions not directly exercised by fixtures
 #[cfg(test)]
@@ -2448,4 +2698,44 @@ mod tests {
         let result = wrap_comment_text("   ", 80);
         assert_eq!(result.len(), 1);
     }
+
+    #[test]
+    fn test_split_top_chunks_basic() {
+        let chunks = split_top_chunks("a: 1\n\nb: 2\n");
+        assert_eq!(chunks, vec!["a: 1\n", "b: 2\n"]);
+        // Multiple separator blanks still form one boundary
+        let chunks = split_top_chunks("\n\na: 1\n\n\n\nb: 2\n");
+        assert_eq!(chunks, vec!["a: 1\n", "b: 2\n"]);
+    }
+
+    #[test]
+    fn test_split_top_chunks_nested_blank() {
+        // A blank line followed by an indented line stays inside its chunk
+        let chunks = split_top_chunks("a:\n  x: 1\n\n  y: 2\n\nb: 1\n");
+        assert_eq!(chunks, vec!["a:\n  x: 1\n\n  y: 2\n", "b: 1\n"]);
+    }
+
+    #[test]
+    fn test_split_top_chunks_block_string() {
+        // Block strings absorb the blank lines after them, so a backtick
+        // line suppresses the boundary
+        let chunks = split_top_chunks("a: `\n  x\n\nb: 2\n");
+        assert_eq!(chunks, vec!["a: `\n  x\n\nb: 2\n"]);
+        // Trailing blanks stay with the final chunk for the same reason
+        let chunks = split_top_chunks("a: `\n  x\n\n\n");
+        assert_eq!(chunks, vec!["a: `\n  x\n\n\n"]);
+    }
+
+    #[test]
+    fn test_format_yay_incremental_reuses_previous_output() {
+        let old = "a: 1\n\nb: 2\n\nc: 3\n";
+        let old_out = format_yay(old).unwrap();
+        let new = "a: 1\n\nb: 22\n\nc: 3\n";
+        assert_eq!(
+            format_yay_incremental(new, old, &old_out).unwrap(),
+            format_yay(new).unwrap()
+        );
+        // Unchanged input returns the previous output verbatim
+        assert_eq!(format_yay_incremental(old, old, &old_out).unwrap(), old_out);
+    }
 }
@@ -9,9 +9,9 @@
 
 use crate::error::{ParseContext, ParseError, Result};
 use crate::lexer::{Token, TokenType};
-use crate::value::Value;
-use num_bigint::BigInt;
-use std::collections::HashMap;
+use crate::map::Map;
+use crate::value::{Int, Value};
+use std::borrow::Cow;
 
 /// Parse the root of a YAY document.
 pub fn parse_root(tokens: &[Token], ctx: &ParseContext, had_comments: bool) -> Result<Value> {
@@ -49,6 +49,101 @@ pub fn parse_root(tokens: &[Token], ctx: &ParseContext, had_comments: bool) -> R
     ensure_at_end(value, tokens, next, ctx)
 }
 
+/// Validate a document without retaining its tree. Root entries are
+/// parsed and dropped one at a time, so check mode holds at most one
+/// root entry's subtree instead of the whole document. Errors match
+/// parse_root exactly.
+pub fn validate_root(tokens: &[Token], ctx: &ParseContext, had_comments: bool) -> Result<()> {
+    let i = skip_breaks_and_stops(tokens, 0);
+
+    if i >= tokens.len() {
+        if had_comments {
+            let suffix = match &ctx.filename {
+                Some(name) => format!(" <{}>", name),
+                None => String::new(),
+            };
+            return Err(ParseError::NoValueFound(suffix));
+        }
+        return Ok(());
+    }
+
+    let t = &tokens[i];
+
+    if t.typ == TokenType::Text && t.indent > 0 {
+        return Err(ParseError::UnexpectedIndent(String::new()).with_location(ctx, t.line_num, 0));
+    }
+
+    if t.typ == TokenType::Text && t.text.contains(':') && t.indent == 0 && !t.text.starts_with('{')
+    {
+        let next = parse_root_object_each(tokens, i, ctx, &mut |_, _| Ok(()))?;
+        let j = skip_breaks_and_stops(tokens, next);
+        if j < tokens.len() {
+            let t = &tokens[j];
+            return Err(
+                ParseError::ExtraContent(String::new()).with_location(ctx, t.line_num, t.col)
+            );
+        }
+        return Ok(());
+    }
+
+    if root_is_list(tokens) {
+        return parse_root_items(tokens, ctx, &mut |_| Ok(()));
+    }
+
+    let (value, next) = parse_value(tokens, i, ctx)?;
+    ensure_at_end(value, tokens, next, ctx).map(|_| ())
+}
+
+/// Whether the document root is a multiline list, the shape
+/// `parse_root_items` can stream.
+pub fn root_is_list(tokens: &[Token]) -> bool {
+    let i = skip_breaks_and_stops(tokens, 0);
+    i < tokens.len() && tokens[i].typ == TokenType::Start && tokens[i].text == "- "
+}
+
+/// Parse the items of a root-level list one at a time, handing each
+/// parsed item to the sink instead of collecting a root array. The
+/// caller must have checked `root_is_list` first. Items are validated
+/// exactly as parse_root would, including the trailing extra-content
+/// check, so a streaming caller sees the same errors as a tree caller.
+pub fn parse_root_items(
+    tokens: &[Token],
+    ctx: &ParseContext,
+    sink: &mut dyn FnMut(Value) -> Result<()>,
+) -> Result<()> {
+    let mut i = skip_breaks_and_stops(tokens, 0);
+
+    // Mirrors parse_multiline_array, emitting instead of pushing.
+    let base_indent = if i < tokens.len() {
+        tokens[i].indent
+    } else {
+        0
+    };
+    while i < tokens.len()
+        && tokens[i].typ == TokenType::Start
+        && tokens[i].text == "- "
+        && tokens[i].indent == base_indent
+    {
+        let list_indent = tokens[i].indent;
+        i += 1;
+        i = skip_breaks(tokens, i);
+        if i >= tokens.len() {
+            break;
+        }
+        let (value, next_i) = parse_array_item(tokens, i, list_indent, ctx)?;
+        sink(value)?;
+        i = next_i;
+        i = skip_breaks_and_stops(tokens, i);
+    }
+
+    let j = skip_breaks_and_stops(tokens, i);
+    if j < tokens.len() {
+        let t = &tokens[j];
+        return Err(ParseError::ExtraContent(String::new()).with_location(ctx, t.line_num, t.col));
+    }
+    Ok(())
+}
+
 /// Verify no content remains after parsing.
 fn ensure_at_end(value: Value, tokens: &[Token], i: usize, ctx: &ParseContext) -> Result<Value> {
     let j = skip_breaks_and_stops(tokens, i);
@@ -183,7 +278,7 @@ fn parse_text_value(tokens: &[Token], i: usize, ctx: &ParseContext) -> Result<(V
     // Try quoted string
     if is_quoted_string(s) {
         let str_val = parse_quoted_string(s, ctx, t.line_num, t.col)?;
-        return Ok((Value::String(str_val), i + 1));
+        return Ok((Value::String(str_val.into()), i + 1));
     }
 
     // Try inline array
@@ -199,7 +294,7 @@ fn parse_text_value(tokens: &[Token], i: usize, ctx: &ParseContext) -> Result<(V
     // Try inline bytes
     if s.starts_with('<') && s.contains('>') {
         let bytes = parse_angle_bytes(s, ctx, t.line_num, t.col)?;
-        return Ok((Value::Bytes(bytes), i + 1));
+        return Ok((Value::Bytes(bytes.into()), i + 1));
     }
 
     // Unclosed angle bracket is invalid
@@ -259,16 +354,21 @@ fn strip_inline_comment(s: &str) -> &str {
 // Keyword Parsing
 // ============================================================================
 
-/// Check if s is a YAY keyword and return its value.
+/// Check if s is a YAY keyword and return its value. The lookup goes
+/// through the perfect-hash table build.rs derives from GRAMMAR.md.
 fn parse_keyword(s: &str) -> Option<Value> {
-    match s {
-        "null" => Some(Value::Null),
-        "true" => Some(Value::Bool(true)),
-        "false" => Some(Value::Bool(false)),
-        "nan" => Some(Value::Float(f64::NAN)),
-        "infinity" => Some(Value::Float(f64::INFINITY)),
-        "-infinity" => Some(Value::Float(f64::NEG_INFINITY)),
-        _ => None,
+    crate::terminals::lookup_keyword(s).map(keyword_value)
+}
+
+fn keyword_value(keyword: crate::terminals::Keyword) -> Value {
+    use crate::terminals::Keyword;
+    match keyword {
+        Keyword::Null => Value::Null,
+        Keyword::True => Value::Bool(true),
+        Keyword::False => Value::Bool(false),
+        Keyword::Nan => Value::Float(f64::NAN),
+        Keyword::Infinity => Value::Float(f64::INFINITY),
+        Keyword::NegInfinity => Value::Float(f64::NEG_INFINITY),
     }
 }
 
@@ -289,7 +389,7 @@ fn parse_number(s: &str) -> Option<Value> {
 
     // Try integer: optional minus followed by digits
     if is_integer_pattern(&trimmed) {
-        if let Ok(n) = trimmed.parse::<BigInt>() {
+        if let Ok(n) = trimmed.parse::<Int>() {
             return Some(Value::Integer(n));
         }
     }
@@ -422,8 +522,14 @@ fn is_quoted_string(s: &str) -> bool {
     (s.starts_with('"') && s.len() > 1) || (s.starts_with('\'') && s.len() > 1)
 }
 
-/// Parse a quoted string value.
-fn parse_quoted_string(s: &str, ctx: &ParseContext, line_num: usize, col: usize) -> Result<String> {
+/// Parse a quoted string value. Escape-free strings — the overwhelming
+/// majority — borrow straight from the source; only escapes allocate.
+fn parse_quoted_string<'s>(
+    s: &'s str,
+    ctx: &ParseContext,
+    line_num: usize,
+    col: usize,
+) -> Result<Cow<'s, str>> {
     if s.starts_with('"') {
         parse_double_quoted_string(s, ctx, line_num, col)
     } else if s.starts_with('\'') {
@@ -435,13 +541,18 @@ fn parse_quoted_string(s: &str, ctx: &ParseContext, line_num: usize, col: usize)
         }
         Ok(parse_single_quoted_content(&s[1..s.len() - 1]))
     } else {
-        Ok(s.to_string())
+        Ok(Cow::Borrowed(s))
     }
 }
 
 /// Parse content of a single-quoted string, handling \' and \\ escapes.
-fn parse_single_quoted_content(s: &str) -> String {
-    let mut result = String::new();
+/// Borrows the content when it contains no backslash.
+fn parse_single_quoted_content(s: &str) -> Cow<'_, str> {
+    if !s.contains('\\') {
+        return Cow::Borrowed(s);
+    }
+
+    let mut result = String::with_capacity(s.len());
     let mut chars = s.chars().peekable();
 
     while let Some(c) = chars.next() {
@@ -464,18 +575,18 @@ fn parse_single_quoted_content(s: &str) -> String {
         }
     }
 
-    result
+    Cow::Owned(result)
 }
 
 /// Parse a JSON-style double-quoted string.
-fn parse_double_quoted_string(
-    s: &str,
+fn parse_double_quoted_string<'s>(
+    s: &'s str,
     ctx: &ParseContext,
     line_num: usize,
     col: usize,
-) -> Result<String> {
+) -> Result<Cow<'s, str>> {
     if s.len() < 2 || !s.starts_with('"') {
-        return Ok(s.to_string());
+        return Ok(Cow::Borrowed(s));
     }
     if !s.ends_with('"') {
         return Err(ParseError::UnterminatedString(String::new()).with_location(
@@ -485,7 +596,14 @@ fn parse_double_quoted_string(
         ));
     }
 
-    let mut out = String::new();
+    // No escapes and no control characters (both single ASCII bytes, so
+    // a byte scan is UTF-8 safe): the content is the result verbatim.
+    let inner = &s[1..s.len() - 1];
+    if inner.bytes().all(|b| b != b'\\' && b >= 0x20) {
+        return Ok(Cow::Borrowed(inner));
+    }
+
+    let mut out = String::with_capacity(inner.len());
     let chars: Vec<char> = s.chars().collect();
     let mut i = 1; // Skip opening quote
 
@@ -508,7 +626,7 @@ fn parse_double_quoted_string(
         }
     }
 
-    Ok(out)
+    Ok(Cow::Owned(out))
 }
 
 /// Parse a backslash escape sequence.
@@ -527,20 +645,19 @@ fn parse_escape_sequence(
         ));
     }
 
+    // Classification table generated from the grammar's dq-escape set.
     let esc = chars[i + 1];
-    match esc {
-        '"' => Ok(("\"".to_string(), 1)),
-        '\\' => Ok(("\\".to_string(), 1)),
-        '/' => Ok(("/".to_string(), 1)),
-        'b' => Ok(("\x08".to_string(), 1)),
-        'f' => Ok(("\x0C".to_string(), 1)),
-        'n' => Ok(("\n".to_string(), 1)),
-        'r' => Ok(("\r".to_string(), 1)),
-        't' => Ok(("\t".to_string(), 1)),
-        'u' => parse_unicode_escape(chars, i, ctx, line_num, col),
-        _ => {
+    let class = if esc.is_ascii() {
+        crate::terminals::DQ_ESCAPE_TABLE[esc as usize]
+    } else {
+        0
+    };
+    match class {
+        0 => {
             Err(ParseError::BadEscapedChar(String::new()).with_location(ctx, line_num, col + i + 1))
         }
+        crate::terminals::ESC_UNICODE => parse_unicode_escape(chars, i, ctx, line_num, col),
+        replacement => Ok(((replacement as char).to_string(), 1)),
     }
 }
 
@@ -661,7 +778,7 @@ fn parse_block_string(tokens: &[Token], mut i: usize, first_line: &str) -> Resul
             "Empty block string not allowed (use \"\" or \"\\n\" explicitly)".to_string(),
         ));
     }
-    Ok((Value::String(result), i))
+    Ok((Value::String(result.into()), i))
 }
 
 /// Gather continuation lines for a block string.
@@ -680,7 +797,7 @@ fn collect_block_string_lines(tokens: &[Token], mut i: usize) -> (Vec<BlockLine>
         } else {
             lines.push(BlockLine {
                 indent: tokens[i].indent,
-                text: tokens[i].text.clone(),
+                text: tokens[i].text.to_string(),
                 is_break: false,
             });
         }
@@ -986,12 +1103,7 @@ fn parse_inline_object_value(
 }
 
 /// Parse an inline object in brace notation.
-fn parse_inline_object(
-    s: &str,
-    ctx: &ParseContext,
-    line_num: usize,
-    col: usize,
-) -> Result<HashMap<String, Value>> {
+fn parse_inline_object(s: &str, ctx: &ParseContext, line_num: usize, col: usize) -> Result<Map> {
     let s = s.trim();
     if !s.starts_with('{') || !s.ends_with('}') {
         return Err(ParseError::UnmatchedBrace(String::new()).with_location(ctx, line_num, col));
@@ -1003,10 +1115,10 @@ fn parse_inline_object(
     let inner = s[1..s.len() - 1].trim();
 
     if inner.is_empty() {
-        return Ok(HashMap::new());
+        return Ok(Map::new());
     }
 
-    let mut result = HashMap::new();
+    let mut result = Map::new();
     let mut remaining = inner;
 
     while !remaining.is_empty() {
@@ -1048,11 +1160,11 @@ fn parse_inline_key(
 ) -> Result<(String, usize)> {
     if s.starts_with('"') {
         let (str_val, consumed) = parse_inline_string(s, ctx, line_num, col)?;
-        return Ok((str_val, consumed));
+        return Ok((str_val.into_owned(), consumed));
     }
     if s.starts_with('\'') {
         let (str_val, consumed) = parse_inline_single_quoted_string(s)?;
-        return Ok((str_val, consumed));
+        return Ok((str_val.into_owned(), consumed));
     }
 
     // Unquoted key: alphanumeric characters, underscores, and hyphens
@@ -1094,41 +1206,25 @@ fn parse_inline_value(
             ParseError::UnmatchedAngle(String::new()).with_location(ctx, line_num, col)
         })?;
         let bytes = parse_inline_byte_array(&s[1..end])?;
-        return Ok((Value::Bytes(bytes), end + 1));
+        return Ok((Value::Bytes(bytes.into()), end + 1));
     }
 
     if s.starts_with('"') {
         let (str_val, consumed) = parse_inline_string(s, ctx, line_num, col)?;
-        return Ok((Value::String(str_val), consumed));
+        return Ok((Value::String(str_val.into()), consumed));
     }
 
     if s.starts_with('\'') {
         let (str_val, consumed) = parse_inline_single_quoted_string(s)?;
-        return Ok((Value::String(str_val), consumed));
-    }
-
-    if s.starts_with("true") {
-        return Ok((Value::Bool(true), 4));
-    }
-
-    if s.starts_with("false") {
-        return Ok((Value::Bool(false), 5));
-    }
-
-    if s.starts_with("null") {
-        return Ok((Value::Null, 4));
-    }
-
-    if s.starts_with("nan") {
-        return Ok((Value::Float(f64::NAN), 3));
+        return Ok((Value::String(str_val.into()), consumed));
     }
 
-    if s.starts_with("infinity") {
-        return Ok((Value::Float(f64::INFINITY), 8));
-    }
-
-    if s.starts_with("-infinity") {
-        return Ok((Value::Float(f64::NEG_INFINITY), 9));
+    // Keyword prefixes, longest spelling first (table generated from
+    // the grammar's terminal sets).
+    for &(spelling, keyword) in crate::terminals::KEYWORDS.iter() {
+        if s.starts_with(spelling) {
+            return Ok((keyword_value(keyword), spelling.len()));
+        }
     }
 
     parse_inline_number(s)
@@ -1238,13 +1334,25 @@ fn find_matching_brace(s: &str) -> Option<usize> {
     None
 }
 
-/// Parse a single-quoted string in inline notation.
-fn parse_inline_single_quoted_string(s: &str) -> Result<(String, usize)> {
+/// Parse a single-quoted string in inline notation. Escape-free
+/// strings borrow their content from the source.
+fn parse_inline_single_quoted_string(s: &str) -> Result<(Cow<'_, str>, usize)> {
     if !s.starts_with('\'') {
         return Err(ParseError::UnterminatedString(String::new()));
     }
 
-    let mut out = String::new();
+    // Quote and backslash are single ASCII bytes, so a byte scan to the
+    // terminator is UTF-8 safe; hitting the close quote first means the
+    // content needs no unescaping.
+    for (i, b) in s.bytes().enumerate().skip(1) {
+        match b {
+            b'\\' => break,
+            b'\'' => return Ok((Cow::Borrowed(&s[1..i]), i + 1)),
+            _ => {}
+        }
+    }
+
+    let mut out = String::with_capacity(s.len());
     let mut escape = false;
 
     for (i, c) in s.chars().enumerate().skip(1) {
@@ -1266,7 +1374,7 @@ fn parse_inline_single_quoted_string(s: &str) -> Result<(String, usize)> {
         }
 
         if c == '\'' {
-            return Ok((out, i + 1));
+            return Ok((Cow::Owned(out), i + 1));
         }
 
         out.push(c);
@@ -1275,17 +1383,28 @@ fn parse_inline_single_quoted_string(s: &str) -> Result<(String, usize)> {
     Err(ParseError::UnterminatedString(String::new()))
 }
 
-/// Parse a double-quoted string in inline notation.
-fn parse_inline_string(
-    s: &str,
+/// Parse a double-quoted string in inline notation. Escape-free
+/// strings borrow their content from the source.
+fn parse_inline_string<'s>(
+    s: &'s str,
     ctx: &ParseContext,
     line_num: usize,
     col: usize,
-) -> Result<(String, usize)> {
+) -> Result<(Cow<'s, str>, usize)> {
     if !s.starts_with('"') {
         return Err(ParseError::UnterminatedString(String::new()).with_location(ctx, line_num, col));
     }
 
+    // Byte scan to the terminator (quote and backslash are single ASCII
+    // bytes): no backslash before the close quote means no unescaping.
+    for (i, b) in s.bytes().enumerate().skip(1) {
+        match b {
+            b'\\' => break,
+            b'"' => return Ok((Cow::Borrowed(&s[1..i]), i + 1)),
+            _ => {}
+        }
+    }
+
     let mut out = String::new();
     let mut escape = false;
     let chars: Vec<char> = s.chars().collect();
@@ -1384,7 +1503,7 @@ fn parse_inline_string(
         }
 
         if c == '"' {
-            return Ok((out, i + 1));
+            return Ok((Cow::Owned(out), i + 1));
         }
 
         out.push(c);
@@ -1444,7 +1563,7 @@ fn parse_inline_number(s: &str) -> Result<(Value, usize)> {
 
     // If no decimal point or exponent, return as big.Int
     if !has_decimal && !has_exponent {
-        let n: BigInt = num_str
+        let n: Int = num_str
             .parse()
             .map_err(|_| ParseError::InvalidNumber(String::new()))?;
         return Ok((Value::Integer(n), i));
@@ -1558,7 +1677,7 @@ fn parse_block_bytes(tokens: &[Token], mut i: usize, ctx: &ParseContext) -> Resu
     // Collect continuation lines
     while i < tokens.len() && tokens[i].typ == TokenType::Text && tokens[i].indent > base_indent {
         let t = &tokens[i];
-        let line = strip_comment(&t.text);
+        let line = strip_comment(t.text);
 
         // Check for uppercase hex digits
         for (j, c) in line.chars().enumerate() {
@@ -1587,7 +1706,7 @@ fn parse_block_bytes(tokens: &[Token], mut i: usize, ctx: &ParseContext) -> Resu
     let result = hex::decode(&hex_str).map_err(|_| {
         ParseError::InvalidHexDigit(String::new()).with_location(ctx, first.line_num, first.col)
     })?;
-    Ok((Value::Bytes(result), i))
+    Ok((Value::Bytes(result.into()), i))
 }
 
 /// Parse block bytes from a property context (key: >)
@@ -1608,7 +1727,7 @@ fn parse_block_bytes_from_property(
     let mut hex_str = String::new();
     while i < tokens.len() && tokens[i].typ == TokenType::Text && tokens[i].indent > key_indent {
         let t = &tokens[i];
-        let line = strip_comment(&t.text);
+        let line = strip_comment(t.text);
 
         // Check for uppercase hex digits
         for (j, c) in line.chars().enumerate() {
@@ -1645,7 +1764,7 @@ fn parse_block_bytes_from_property(
             start_token.col,
         )
     })?;
-    Ok((Value::Bytes(result), i))
+    Ok((Value::Bytes(result.into()), i))
 }
 
 /// Parse block string from a property context (key: `)
@@ -1700,7 +1819,7 @@ fn parse_block_string_from_property(
         result.push('\n');
     }
 
-    Ok((Value::String(result), i))
+    Ok((Value::String(result.into()), i))
 }
 
 /// Parse concatenated quoted strings (multiple quoted strings on consecutive lines).
@@ -1711,7 +1830,7 @@ fn parse_concatenated_strings(
     base_indent: usize,
     ctx: &ParseContext,
 ) -> Result<(Value, usize)> {
-    let mut parts: Vec<String> = Vec::new();
+    let mut parts: Vec<Cow<str>> = Vec::new();
     let start_i = i;
 
     while i < tokens.len() {
@@ -1763,7 +1882,7 @@ fn parse_concatenated_strings(
 
     // Concatenate all parts
     let result = parts.join("");
-    Ok((Value::String(result), i))
+    Ok((Value::String(result.into()), i))
 }
 
 // ============================================================================
@@ -1840,7 +1959,7 @@ fn parse_array_item(
     }
 
     // Inline nested list: "- value" as text
-    if next.typ == TokenType::Text && is_inline_list_item(&next.text) {
+    if next.typ == TokenType::Text && is_inline_list_item(next.text) {
         return parse_inline_nested_list(tokens, i, list_indent, ctx);
     }
 
@@ -1888,7 +2007,7 @@ fn parse_inline_nested_list(
     // Collect inline items
     while i < tokens.len()
         && tokens[i].typ == TokenType::Text
-        && is_inline_list_item(&tokens[i].text)
+        && is_inline_list_item(tokens[i].text)
     {
         let t = &tokens[i];
 
@@ -1903,7 +2022,7 @@ fn parse_inline_nested_list(
             );
         }
 
-        let val_str = t.text.strip_prefix("- ").unwrap_or(&t.text).trim();
+        let val_str = t.text.strip_prefix("- ").unwrap_or(t.text).trim();
         // Use parse_nested_inline_bullet to handle nested "- - value" patterns
         let value = parse_nested_inline_bullet(val_str, ctx, t.line_num, t.col + 2)?;
         group.push(value);
@@ -1965,7 +2084,7 @@ fn merge_additional_object_properties(
     tokens: &[Token],
     mut j: usize,
     list_indent: usize,
-    obj: &mut HashMap<String, Value>,
+    obj: &mut Map,
     ctx: &ParseContext,
 ) -> Result<usize> {
     loop {
@@ -1977,7 +2096,7 @@ fn merge_additional_object_properties(
         let t = &tokens[j];
         if t.typ == TokenType::Text
             && t.indent > list_indent
-            && find_colon_outside_quotes(&t.text).is_some()
+            && find_colon_outside_quotes(t.text).is_some()
         {
             let (prop_val, next_j) = parse_value(tokens, j, ctx)?;
             if let Value::Object(prop_obj) = prop_val {
@@ -2054,7 +2173,7 @@ fn parse_key_value_pair(
     // Block bytes: "key: >" followed by indented hex lines
     if value_part == ">" && !key.is_empty() {
         let (bytes, next) = parse_block_bytes_from_property(tokens, i, t.indent, ctx)?;
-        let mut obj = HashMap::new();
+        let mut obj = Map::new();
         obj.insert(key, bytes);
         return Ok((Value::Object(obj), next));
     }
@@ -2062,7 +2181,7 @@ fn parse_key_value_pair(
     // Block string: "key: `" followed by indented content
     if value_part == "`" && !key.is_empty() {
         let (body, next) = parse_block_string_from_property(tokens, i, t.indent)?;
-        let mut obj = HashMap::new();
+        let mut obj = Map::new();
         obj.insert(key, body);
         return Ok((Value::Object(obj), next));
     }
@@ -2077,7 +2196,7 @@ fn parse_key_value_pair(
         } else {
             Value::Null
         };
-        let mut obj = HashMap::new();
+        let mut obj = Map::new();
         obj.insert(key, value);
         return Ok((Value::Object(obj), i + 1));
     }
@@ -2154,7 +2273,7 @@ fn parse_object_or_named_array(
     // Named array
     if first.typ == TokenType::Start && first.text == "- " {
         let (arr, next) = parse_multiline_array(tokens, i, ctx)?;
-        let mut obj = HashMap::new();
+        let mut obj = Map::new();
         obj.insert(key.to_string(), arr);
         return Ok((Value::Object(obj), next));
     }
@@ -2164,7 +2283,7 @@ fn parse_object_or_named_array(
     // Block string
     if first.typ == TokenType::Text && first.text.trim() == "`" {
         let (body, next) = parse_block_string(tokens, i, "")?;
-        let mut obj = HashMap::new();
+        let mut obj = Map::new();
         obj.insert(key.to_string(), body);
         return Ok((Value::Object(obj), next));
     }
@@ -2172,7 +2291,7 @@ fn parse_object_or_named_array(
     // Nested object
     let (nested_obj, next) = parse_nested_object_content(tokens, i, base_indent, ctx)?;
 
-    let mut obj = HashMap::new();
+    let mut obj = Map::new();
     if !nested_obj.is_empty() {
         obj.insert(key.to_string(), Value::Object(nested_obj));
     } else {
@@ -2194,8 +2313,8 @@ fn parse_nested_object_content(
     mut i: usize,
     base_indent: usize,
     ctx: &ParseContext,
-) -> Result<(HashMap<String, Value>, usize)> {
-    let mut obj = HashMap::new();
+) -> Result<(Map, usize)> {
+    let mut obj = Map::new();
 
     while i < tokens.len() {
         let t = &tokens[i];
@@ -2214,7 +2333,7 @@ fn parse_nested_object_content(
                 );
             }
 
-            let colon_idx = match find_colon_outside_quotes(&t.text) {
+            let colon_idx = match find_colon_outside_quotes(t.text) {
                 Some(idx) => idx,
                 None => break,
             };
@@ -2252,7 +2371,7 @@ fn parse_object_property_value(
 ) -> Result<(Value, usize)> {
     // Empty object
     if v_part == "{}" {
-        return Ok((Value::Object(HashMap::new()), i + 1));
+        return Ok((Value::Object(Map::new()), i + 1));
     }
 
     // Block bytes - either just ">" or "> # comment"
@@ -2321,9 +2440,39 @@ fn parse_object_property_value(
 // ============================================================================
 
 /// Parse an object at the document root level.
-fn parse_root_object(tokens: &[Token], mut i: usize, ctx: &ParseContext) -> Result<(Value, usize)> {
-    let mut obj = HashMap::new();
+fn parse_root_object(tokens: &[Token], i: usize, ctx: &ParseContext) -> Result<(Value, usize)> {
+    let mut obj = Map::new();
+    let next = parse_root_object_each(tokens, i, ctx, &mut |k, v| {
+        obj.insert(k, v);
+        Ok(())
+    })?;
+    Ok((Value::Object(obj), next))
+}
 
+/// Parse root object properties one at a time, handing each key/value
+/// pair to the sink. Shared by tree building and validate-only parsing.
+fn parse_root_object_each(
+    tokens: &[Token],
+    mut i: usize,
+    ctx: &ParseContext,
+    sink: &mut dyn FnMut(String, Value) -> Result<()>,
+) -> Result<usize> {
+    while let Some((k, value, next_i)) = parse_root_object_next(tokens, i, ctx)? {
+        sink(k, value)?;
+        i = next_i;
+    }
+    Ok(tokens.len())
+}
+
+/// Parse the next root object property at or after position `i`,
+/// returning its key, value, and the position after it, or None when
+/// the tokens are exhausted. The pull-shaped core under
+/// `parse_root_object_each` and `RootEntries`.
+fn parse_root_object_next(
+    tokens: &[Token],
+    mut i: usize,
+    ctx: &ParseContext,
+) -> Result<Option<(String, Value, usize)>> {
     while i < tokens.len() {
         let t = &tokens[i];
 
@@ -2344,7 +2493,7 @@ fn parse_root_object(tokens: &[Token], mut i: usize, ctx: &ParseContext) -> Resu
             );
         }
 
-        let colon_idx = match find_colon_outside_quotes(&t.text) {
+        let colon_idx = match find_colon_outside_quotes(t.text) {
             Some(idx) => idx,
             None => {
                 i += 1;
@@ -2411,11 +2560,53 @@ fn parse_root_object(tokens: &[Token], mut i: usize, ctx: &ParseContext) -> Resu
         let v_part = after_colon.trim();
 
         let (value, next_i) = parse_root_object_property(tokens, i, t, v_part, value_col, ctx)?;
-        obj.insert(k, value);
-        i = next_i;
+        return Ok(Some((k, value, next_i)));
+    }
+
+    Ok(None)
+}
+
+/// Whether the document root is a `key: value` block object, the shape
+/// `RootEntries` can stream.
+pub fn root_is_object(tokens: &[Token]) -> bool {
+    let i = skip_breaks_and_stops(tokens, 0);
+    i < tokens.len()
+        && tokens[i].typ == TokenType::Text
+        && tokens[i].indent == 0
+        && tokens[i].text.contains(':')
+        && !tokens[i].text.starts_with('{')
+}
+
+/// Streaming iterator over a root object's entries in document order:
+/// the pull-shaped companion to `parse_root_items`. Each call parses
+/// one entry's subtree and hands it over, so a caller holds at most one
+/// entry per document instead of the whole tree. The caller must have
+/// checked `root_is_object` first.
+pub struct RootEntries<'a> {
+    tokens: &'a [Token<'a>],
+    ctx: &'a ParseContext,
+    i: usize,
+}
+
+impl<'a> RootEntries<'a> {
+    pub fn new(tokens: &'a [Token<'a>], ctx: &'a ParseContext) -> Self {
+        RootEntries { tokens, ctx, i: 0 }
     }
 
-    Ok((Value::Object(obj), i))
+    /// Parse and return the next entry, or None at the end of the
+    /// document. Errors match parse_root for the same input.
+    pub fn next_entry(&mut self) -> Result<Option<(String, Value)>> {
+        match parse_root_object_next(self.tokens, self.i, self.ctx)? {
+            Some((key, value, next_i)) => {
+                self.i = next_i;
+                Ok(Some((key, value)))
+            }
+            None => {
+                self.i = self.tokens.len();
+                Ok(None)
+            }
+        }
+    }
 }
 
 /// Parse a single property in a root object.
@@ -2448,7 +2639,7 @@ fn parse_root_object_property(
 
     // Empty object
     if v_part == "{}" {
-        return Ok((Value::Object(HashMap::new()), i + 1));
+        return Ok((Value::Object(Map::new()), i + 1));
     }
 
     // Block string
@@ -2495,7 +2686,7 @@ fn parse_root_block_string(tokens: &[Token], mut i: usize) -> Result<(Value, usi
         } else {
             lines.push(BlockLine {
                 indent: tokens[i].indent,
-                text: tokens[i].text.clone(),
+                text: tokens[i].text.to_string(),
                 is_break: false,
             });
         }
@@ -2517,7 +2708,7 @@ fn parse_root_block_string(tokens: &[Token], mut i: usize) -> Result<(Value, usi
         ));
     }
 
-    Ok((Value::String(body), i))
+    Ok((Value::String(body.into()), i))
 }
 
 /// Remove trailing empty lines.
@@ -2537,7 +2728,7 @@ fn parse_root_nested_content(
     ctx: &ParseContext,
 ) -> Result<(Value, usize)> {
     let t = &tokens[i];
-    let colon_idx = find_colon_outside_quotes(&t.text).unwrap_or(0);
+    let colon_idx = find_colon_outside_quotes(t.text).unwrap_or(0);
 
     let mut j = i + 1;
     j = skip_breaks_and_stops(tokens, j);
@@ -2623,14 +2814,16 @@ fn parse_scalar(s: &str, ctx: &ParseContext, line_num: usize, col: usize) -> Res
 
     // Double-quoted string
     if s.starts_with('"') && s.ends_with('"') {
-        return Ok(Value::String(parse_quoted_string(s, ctx, line_num, col)?));
+        return Ok(Value::String(
+            parse_quoted_string(s, ctx, line_num, col)?.into(),
+        ));
     }
 
     // Single-quoted string
     if s.starts_with('\'') && s.ends_with('\'') {
-        return Ok(Value::String(parse_single_quoted_content(
-            &s[1..s.len() - 1],
-        )));
+        return Ok(Value::String(
+            parse_single_quoted_content(&s[1..s.len() - 1]).into(),
+        ));
     }
 
     // Inline array
@@ -2645,7 +2838,9 @@ fn parse_scalar(s: &str, ctx: &ParseContext, line_num: usize, col: usize) -> Res
 
     // Inline bytes
     if s.starts_with('<') {
-        return Ok(Value::Bytes(parse_angle_bytes(s, ctx, line_num, col)?));
+        return Ok(Value::Bytes(
+            parse_angle_bytes(s, ctx, line_num, col)?.into(),
+        ));
     }
 
     // Bare words are not valid - strings must be quoted
@@ -2720,4 +2915,39 @@ mod tests {
         assert_eq!(find_colon_outside_quotes("\"a:b\": 1"), Some(5));
         assert_eq!(find_colon_outside_quotes("'a:b': 1"), Some(5));
     }
+
+    #[test]
+    fn test_root_entries_pull() {
+        let ctx = crate::error::ParseContext::new(None);
+        let scan = crate::scanner::scan("a: 1\nb:\n  c: 2\n", &ctx).unwrap();
+        let tokens = crate::lexer::outline_lex(&scan);
+        assert!(root_is_object(&tokens));
+        let mut entries = RootEntries::new(&tokens, &ctx);
+        let (key, value) = entries.next_entry().unwrap().unwrap();
+        assert_eq!(key, "a");
+        assert_eq!(value, Value::Integer(1.into()));
+        let (key, value) = entries.next_entry().unwrap().unwrap();
+        assert_eq!(key, "b");
+        assert!(matches!(value, Value::Object(_)));
+        assert!(entries.next_entry().unwrap().is_none());
+    }
+
+    #[test]
+    fn test_root_entries_reports_errors() {
+        let ctx = crate::error::ParseContext::new(None);
+        let scan = crate::scanner::scan("a: [1,\n", &ctx).unwrap();
+        let tokens = crate::lexer::outline_lex(&scan);
+        let mut entries = RootEntries::new(&tokens, &ctx);
+        assert!(entries.next_entry().is_err());
+    }
+
+    #[test]
+    fn test_root_is_object_rejects_other_roots() {
+        let ctx = crate::error::ParseContext::new(None);
+        for source in ["- 1\n- 2\n", "42\n", "{a: 1}\n", ""] {
+            let scan = crate::scanner::scan(source, &ctx).unwrap();
+            let tokens = crate::lexer::outline_lex(&scan);
+            assert!(!root_is_object(&tokens), "source {:?}", source);
+        }
+    }
 }
@@ -9,27 +9,30 @@
 
 use crate::error::{ParseContext, ParseError, Result};
 
-/// A single line after the scanning phase.
+/// A single line after the scanning phase. Borrows from the source text.
 #[derive(Debug, Clone)]
-pub struct ScanLine {
+pub struct ScanLine<'src> {
     /// Content after indent and leader.
-    pub line: String,
+    pub line: &'src str,
     /// Number of leading spaces.
     pub indent: usize,
     /// "- " for list items, "" otherwise.
-    pub leader: String,
+    pub leader: &'static str,
     /// Zero-based line number for error reporting.
     pub line_num: usize,
 }
 
 /// Result of scanning including metadata.
-pub struct ScanResult {
-    pub lines: Vec<ScanLine>,
+pub struct ScanResult<'src> {
+    pub lines: Vec<ScanLine<'src>>,
     pub had_comments: bool,
+    /// Exact number of tokens `outline_lex` will emit for these lines,
+    /// counted while scanning so the token vector allocates once.
+    pub token_count: usize,
 }
 
 /// Scan source text into scan lines with validation.
-pub fn scan(source: &str, ctx: &ParseContext) -> Result<ScanResult> {
+pub fn scan<'src>(source: &'src str, ctx: &ParseContext) -> Result<ScanResult<'src>> {
     // Validate: No BOM allowed
     validate_no_bom(source, ctx)?;
 
@@ -40,6 +43,11 @@ pub fn scan(source: &str, ctx: &ParseContext) -> Result<ScanResult> {
     scan_lines(source, ctx)
 }
 
+/// Low bytes of a word, for SWAR byte tests.
+const SWAR_LO: u64 = 0x0101_0101_0101_0101;
+/// High bits of a word, for SWAR byte tests.
+const SWAR_HI: u64 = 0x8080_8080_8080_8080;
+
 /// Check that the source doesn't start with a UTF-8 BOM.
 fn validate_no_bom(source: &str, ctx: &ParseContext) -> Result<()> {
     if source.starts_with('\u{FEFF}') {
@@ -58,17 +66,79 @@ fn is_allowed_code_point(cp: u32) -> bool {
         || ((0x10000..=0x10FFFF).contains(&cp) && (cp & 0xFFFF) < 0xFFFE)
 }
 
+/// Returns `true` if every byte of the word is printable ASCII
+/// (0x20..=0x7E), i.e. needs no further code-point checks.
+fn word_is_clean(word: u64) -> bool {
+    let high = word & SWAR_HI;
+    let below_space = word.wrapping_sub(SWAR_LO * 0x20) & !word & SWAR_HI;
+    let xor_del = word ^ (SWAR_LO * 0x7F);
+    let del = xor_del.wrapping_sub(SWAR_LO) & !xor_del & SWAR_HI;
+    (high | below_space | del) == 0
+}
+
+/// Find the next occurrence of an ASCII byte, a word at a time.
+fn find_byte(haystack: &[u8], needle: u8) -> Option<usize> {
+    let pattern = SWAR_LO * u64::from(needle);
+    let mut i = 0;
+    while i + 8 <= haystack.len() {
+        let word = u64::from_le_bytes(haystack[i..i + 8].try_into().unwrap());
+        let x = word ^ pattern;
+        let found = x.wrapping_sub(SWAR_LO) & !x & SWAR_HI;
+        if found != 0 {
+            return Some(i + found.trailing_zeros() as usize / 8);
+        }
+        i += 8;
+    }
+    haystack[i..]
+        .iter()
+        .position(|&b| b == needle)
+        .map(|p| i + p)
+}
+
 /// Validate that the source contains no forbidden code points.
+///
+/// Runs of printable ASCII are skipped a word at a time; only the bytes
+/// that fall outside that range (newlines, control bytes, multibyte
+/// sequences) are decoded and checked individually.
 fn validate_code_points(source: &str, ctx: &ParseContext) -> Result<()> {
+    let bytes = source.as_bytes();
     let mut line = 0;
     let mut col = 0;
-    for ch in source.chars() {
-        let cp = ch as u32;
-        if !is_allowed_code_point(cp) {
+    let mut i = 0;
+    while i < bytes.len() {
+        if i + 8 <= bytes.len()
+            && word_is_clean(u64::from_le_bytes(bytes[i..i + 8].try_into().unwrap()))
+        {
+            i += 8;
+            col += 8;
+            continue;
+        }
+        let b = bytes[i];
+        if b == b'\n' {
+            line += 1;
+            col = 0;
+            i += 1;
+            continue;
+        }
+        if (0x20..=0x7E).contains(&b) {
+            col += 1;
+            i += 1;
+            continue;
+        }
+        if b < 0x80 {
             // Tabs get their own specific error message.
-            if cp == 0x0009 {
+            if b == 0x09 {
                 return Err(ParseError::TabNotAllowed(String::new()).with_location(ctx, line, col));
             }
+            return Err(ParseError::ForbiddenCodePoint(u32::from(b), String::new())
+                .with_location(ctx, line, col));
+        }
+        // Multibyte sequence: decode just this code point. The source is
+        // already valid UTF-8 (it is a &str), so only the YAY range
+        // restrictions remain to check.
+        let ch = source[i..].chars().next().unwrap();
+        let cp = ch as u32;
+        if !is_allowed_code_point(cp) {
             // Surrogates get their own specific error message.
             if (0xD800..=0xDFFF).contains(&cp) {
                 return Err(
@@ -79,22 +149,38 @@ fn validate_code_points(source: &str, ctx: &ParseContext) -> Result<()> {
                 ParseError::ForbiddenCodePoint(cp, String::new()).with_location(ctx, line, col)
             );
         }
-        if ch == '\n' {
-            line += 1;
-            col = 0;
-        } else {
-            col += 1;
-        }
+        col += 1;
+        i += ch.len_utf8();
     }
     Ok(())
 }
 
+/// Split the source at the next newline, word-at-a-time.
+/// Returns the line and the remainder after the newline, if any.
+fn split_line(source: &str) -> (&str, Option<&str>) {
+    match find_byte(source.as_bytes(), b'\n') {
+        Some(at) => (&source[..at], Some(&source[at + 1..])),
+        None => (source, None),
+    }
+}
+
 /// Process each line of source, extracting indent and leader.
-fn scan_lines(source: &str, ctx: &ParseContext) -> Result<ScanResult> {
+fn scan_lines<'src>(source: &'src str, ctx: &ParseContext) -> Result<ScanResult<'src>> {
     let mut lines = Vec::new();
     let mut had_comments = false;
+    // Token accounting for the lexer: every list leader costs exactly
+    // two tokens (its start plus the stop that eventually closes it),
+    // every content line one text token, and each run of blank lines
+    // one break token. Tracked here so the count is exact, including
+    // break coalescing, without a second pass.
+    let mut token_count = 0;
+    let mut broken = false;
 
-    for (line_num, line_str) in source.split('\n').enumerate() {
+    let mut rest_source = Some(source);
+    let mut line_num = 0;
+    while let Some(remaining) = rest_source {
+        let (line_str, next) = split_line(remaining);
+        rest_source = next;
         // Validate: No trailing spaces
         if !line_str.is_empty() && line_str.ends_with(' ') {
             return Err(ParseError::TrailingSpace(String::new()).with_location(
@@ -112,23 +198,38 @@ fn scan_lines(source: &str, ctx: &ParseContext) -> Result<ScanResult> {
         // Skip top-level comments but track that we saw them
         if rest.starts_with('#') && indent == 0 {
             had_comments = true;
+            line_num += 1;
             continue;
         }
 
         // Extract leader (list marker) and content
         let (leader, content) = extract_leader(rest, line_num, indent, ctx)?;
 
+        if !leader.is_empty() {
+            token_count += 2;
+            broken = false;
+        }
+        if !content.is_empty() {
+            token_count += 1;
+            broken = false;
+        } else if !broken {
+            token_count += 1;
+            broken = true;
+        }
+
         lines.push(ScanLine {
-            line: content.to_string(),
+            line: content,
             indent,
-            leader: leader.to_string(),
+            leader,
             line_num,
         });
+        line_num += 1;
     }
 
     Ok(ScanResult {
         lines,
         had_comments,
+        token_count,
     })
 }
 
@@ -213,6 +314,15 @@ mod tests {
         assert_eq!(result.lines[0].line, "value");
     }
 
+    #[test]
+    fn test_token_count_exact() {
+        let ctx = ParseContext::new(None);
+        let source = "a: 1\nlist:\n- x\n- y\n\n\nnested:\n  - deep\nb: 2";
+        let result = scan(source, &ctx).unwrap();
+        let tokens = crate::lexer::outline_lex(&result);
+        assert_eq!(tokens.len(), result.token_count);
+    }
+
     #[test]
     fn test_trailing_space_error() {
         let ctx = ParseContext::new(None);
@@ -6,12 +6,11 @@
 //!
 //! See `SHON.md` for the full specification.
 
-use num_bigint::BigInt;
-use std::collections::HashMap;
+use crate::map::Map;
 use std::fs;
 use std::str::FromStr;
 
-use crate::Value;
+use crate::{Int, Value};
 
 /// Error type for SHON parsing.
 #[derive(Debug, Clone, PartialEq)]
@@ -28,13 +27,13 @@ impl std::error::Error for ShonError {}
 /// Parse a SHON compound value from CLI arguments starting with `[`, `[]`, or `[--]`.
 /// The `args` slice should begin with the trigger token.
 /// Returns the parsed value and the number of arguments consumed (including the brackets).
-pub fn parse_shon_bracket(args: &[String]) -> Result<(Value, usize), ShonError> {
+pub fn parse_shon_bracket(args: &[&str]) -> Result<(Value, usize), ShonError> {
     if args.is_empty() {
         return Err(ShonError("Expected '[' to start SHON expression".into()));
     }
-    match args[0].as_str() {
+    match args[0] {
         "[]" => Ok((Value::Array(Vec::new()), 1)),
-        "[--]" => Ok((Value::Object(HashMap::new()), 1)),
+        "[--]" => Ok((Value::Object(Map::new()), 1)),
         "[" => {
             let mut pos = 1; // skip opening [
             let (value, consumed) = parse_bracket_contents(args, &mut pos)?;
@@ -47,56 +46,56 @@ pub fn parse_shon_bracket(args: &[String]) -> Result<(Value, usize), ShonError>
 /// Parse a SHON `-x <hex>` from CLI arguments.
 /// The `args` slice should begin with the `-x` token.
 /// Returns the parsed bytes value and the number of arguments consumed (2).
-pub fn parse_shon_hex(args: &[String]) -> Result<(Value, usize), ShonError> {
+pub fn parse_shon_hex(args: &[&str]) -> Result<(Value, usize), ShonError> {
     if args.is_empty() || args[0] != "-x" {
         return Err(ShonError("Expected '-x' for hex bytes".into()));
     }
     if args.len() < 2 {
         return Err(ShonError("-x requires a hex string argument".into()));
     }
-    let bytes = parse_hex_token(&args[1])?;
-    Ok((Value::Bytes(bytes), 2))
+    let bytes = parse_hex_token(args[1])?;
+    Ok((Value::Bytes(bytes.into()), 2))
 }
 
 /// Parse a SHON `-b <file>` from CLI arguments.
 /// Reads the file as raw bytes.
 /// Returns the parsed bytes value and the number of arguments consumed (2).
-pub fn parse_shon_file_bytes(args: &[String]) -> Result<(Value, usize), ShonError> {
+pub fn parse_shon_file_bytes(args: &[&str]) -> Result<(Value, usize), ShonError> {
     if args.is_empty() || args[0] != "-b" {
         return Err(ShonError("Expected '-b' for file bytes".into()));
     }
     if args.len() < 2 {
         return Err(ShonError("-b requires a file path argument".into()));
     }
-    let bytes = fs::read(&args[1])
+    let bytes = fs::read(args[1])
         .map_err(|e| ShonError(format!("Cannot read file '{}': {}", args[1], e)))?;
-    Ok((Value::Bytes(bytes), 2))
+    Ok((Value::Bytes(bytes.into()), 2))
 }
 
 /// Parse a SHON `-s <file>` from CLI arguments.
 /// Reads the file as a UTF-8 string.
 /// Returns the parsed string value and the number of arguments consumed (2).
-pub fn parse_shon_file_string(args: &[String]) -> Result<(Value, usize), ShonError> {
+pub fn parse_shon_file_string(args: &[&str]) -> Result<(Value, usize), ShonError> {
     if args.is_empty() || args[0] != "-s" {
         return Err(ShonError("Expected '-s' for file string".into()));
     }
     if args.len() < 2 {
         return Err(ShonError("-s requires a file path argument".into()));
     }
-    let content = fs::read_to_string(&args[1])
+    let content = fs::read_to_string(args[1])
         .map_err(|e| ShonError(format!("Cannot read file '{}': {}", args[1], e)))?;
-    Ok((Value::String(content), 2))
+    Ok((Value::String(content.into()), 2))
 }
 
 /// Parse the contents inside `[ ... ]`.
 /// `pos` points to the first token after `[`.
 /// Returns the value and the total number of args consumed from the original slice
 /// (including the opening `[`).
-fn parse_bracket_contents(args: &[String], pos: &mut usize) -> Result<(Value, usize), ShonError> {
+fn parse_bracket_contents(args: &[&str], pos: &mut usize) -> Result<(Value, usize), ShonError> {
     // Check for empty object `[--]`
     if *pos < args.len() && args[*pos] == "--]" {
         *pos += 1;
-        return Ok((Value::Object(HashMap::new()), *pos));
+        return Ok((Value::Object(Map::new()), *pos));
     }
 
     // Check for `[]` (empty array as single token)
@@ -118,11 +117,11 @@ fn parse_bracket_contents(args: &[String], pos: &mut usize) -> Result<(Value, us
 
 /// Look ahead to determine if bracket contents form an object.
 /// An object starts with `--key` (a token starting with `--` followed by at least one char).
-fn peek_is_object(args: &[String], pos: usize) -> bool {
+fn peek_is_object(args: &[&str], pos: usize) -> bool {
     if pos >= args.len() {
         return false;
     }
-    is_object_key(&args[pos])
+    is_object_key(args[pos])
 }
 
 /// Check if a token is an object key (`--word` where word is non-empty).
@@ -131,8 +130,8 @@ fn is_object_key(token: &str) -> bool {
 }
 
 /// Parse object contents: `--key value --key value ... ]`
-fn parse_object_contents(args: &[String], pos: &mut usize) -> Result<(Value, usize), ShonError> {
-    let mut map = HashMap::new();
+fn parse_object_contents(args: &[&str], pos: &mut usize) -> Result<(Value, usize), ShonError> {
+    let mut map = Map::new();
 
     loop {
         if *pos >= args.len() {
@@ -145,7 +144,7 @@ fn parse_object_contents(args: &[String], pos: &mut usize) -> Result<(Value, usi
         }
 
         // Expect --key
-        if !is_object_key(&args[*pos]) {
+        if !is_object_key(args[*pos]) {
             return Err(ShonError(format!(
                 "Expected object key (--key) or ']', got '{}'",
                 args[*pos]
@@ -165,8 +164,8 @@ fn parse_object_contents(args: &[String], pos: &mut usize) -> Result<(Value, usi
 }
 
 /// Parse array contents: `value value ... ]`
-fn parse_array_contents(args: &[String], pos: &mut usize) -> Result<(Value, usize), ShonError> {
-    let mut items = Vec::new();
+fn parse_array_contents(args: &[&str], pos: &mut usize) -> Result<(Value, usize), ShonError> {
+    let mut items = Vec::with_capacity(count_array_items(args, *pos));
 
     loop {
         if *pos >= args.len() {
@@ -183,15 +182,54 @@ fn parse_array_contents(args: &[String], pos: &mut usize) -> Result<(Value, usiz
     }
 }
 
+/// Count the values between `pos` and the matching `]` at this nesting
+/// depth, so arrays can be allocated with exact capacity up front.
+///
+/// Operands of `--`, `-x`, `-b`, and `-s` are skipped at every depth so
+/// an escaped bracket token cannot disturb the count.
+fn count_array_items(args: &[&str], mut pos: usize) -> usize {
+    let mut count = 0;
+    let mut depth = 0usize;
+    while pos < args.len() {
+        match args[pos] {
+            "[" => {
+                if depth == 0 {
+                    count += 1;
+                }
+                depth += 1;
+            }
+            "]" => {
+                if depth == 0 {
+                    return count;
+                }
+                depth -= 1;
+            }
+            "--" | "-x" | "-b" | "-s" => {
+                if depth == 0 {
+                    count += 1;
+                }
+                pos += 1; // skip the operand
+            }
+            _ => {
+                if depth == 0 {
+                    count += 1;
+                }
+            }
+        }
+        pos += 1;
+    }
+    count
+}
+
 /// Parse a single SHON value at `args[*pos]`, advancing `*pos` past it.
-fn parse_value(args: &[String], pos: &mut usize) -> Result<Value, ShonError> {
+fn parse_value(args: &[&str], pos: &mut usize) -> Result<Value, ShonError> {
     if *pos >= args.len() {
         return Err(ShonError("Expected value, got end of arguments".into()));
     }
 
-    let token = &args[*pos];
+    let token = args[*pos];
 
-    match token.as_str() {
+    match token {
         // Nested array/object
         "[" => {
             *pos += 1;
@@ -206,7 +244,7 @@ fn parse_value(args: &[String], pos: &mut usize) -> Result<Value, ShonError> {
         // `[--]` as single token
         "[--]" => {
             *pos += 1;
-            Ok(Value::Object(HashMap::new()))
+            Ok(Value::Object(Map::new()))
         }
         // String escape
         "--" => {
@@ -216,9 +254,9 @@ fn parse_value(args: &[String], pos: &mut usize) -> Result<Value, ShonError> {
                     "'--' requires a following token to escape".into(),
                 ));
             }
-            let s = args[*pos].clone();
+            let s = args[*pos];
             *pos += 1;
-            Ok(Value::String(s))
+            Ok(Value::String(s.into()))
         }
         // Reserved single-char flags
         "-n" => {
@@ -251,9 +289,9 @@ fn parse_value(args: &[String], pos: &mut usize) -> Result<Value, ShonError> {
             if *pos >= args.len() {
                 return Err(ShonError("-x requires a hex string argument".into()));
             }
-            let bytes = parse_hex_token(&args[*pos])?;
+            let bytes = parse_hex_token(args[*pos])?;
             *pos += 1;
-            Ok(Value::Bytes(bytes))
+            Ok(Value::Bytes(bytes.into()))
         }
         // File → bytes
         "-b" => {
@@ -261,11 +299,11 @@ fn parse_value(args: &[String], pos: &mut usize) -> Result<Value, ShonError> {
             if *pos >= args.len() {
                 return Err(ShonError("-b requires a file path argument".into()));
             }
-            let path = &args[*pos];
+            let path = args[*pos];
             let bytes = fs::read(path)
                 .map_err(|e| ShonError(format!("Cannot read file '{}': {}", path, e)))?;
             *pos += 1;
-            Ok(Value::Bytes(bytes))
+            Ok(Value::Bytes(bytes.into()))
         }
         // File → string
         "-s" => {
@@ -273,11 +311,11 @@ fn parse_value(args: &[String], pos: &mut usize) -> Result<Value, ShonError> {
             if *pos >= args.len() {
                 return Err(ShonError("-s requires a file path argument".into()));
             }
-            let path = &args[*pos];
+            let path = args[*pos];
             let content = fs::read_to_string(path)
                 .map_err(|e| ShonError(format!("Cannot read file '{}': {}", path, e)))?;
             *pos += 1;
-            Ok(Value::String(content))
+            Ok(Value::String(content.into()))
         }
         // Unexpected close bracket
         "]" => Err(ShonError("Unexpected ']' without matching '['".into())),
@@ -293,9 +331,9 @@ fn parse_value(args: &[String], pos: &mut usize) -> Result<Value, ShonError> {
 fn parse_atom(token: &str) -> Result<Value, ShonError> {
     // Try integer: /^-?[0-9]+$/
     if is_integer(token) {
-        return match BigInt::from_str(token) {
+        return match Int::from_str(token) {
             Ok(n) => Ok(Value::Integer(n)),
-            Err(_) => Ok(Value::String(token.to_string())),
+            Err(_) => Ok(Value::String(token.into())),
         };
     }
 
@@ -316,7 +354,7 @@ fn parse_atom(token: &str) -> Result<Value, ShonError> {
     }
 
     // Everything else is a string
-    Ok(Value::String(token.to_string()))
+    Ok(Value::String(token.into()))
 }
 
 /// Check if a token matches the integer pattern: /^-?[0-9]+$/
@@ -450,8 +488,8 @@ fn parse_hex_token(token: &str) -> Result<Vec<u8>, ShonError> {
 mod tests {
     use super::*;
 
-    fn args(tokens: &[&str]) -> Vec<String> {
-        tokens.iter().map(|s| s.to_string()).collect()
+    fn args<'a>(tokens: &[&'a str]) -> Vec<&'a str> {
+        tokens.to_vec()
     }
 
     // ---- Scalars inside brackets ----
@@ -584,35 +622,44 @@ mod tests {
     fn test_hex_inside_brackets() {
         let a = args(&["[", "-x", "cafe", "]"]);
         let (val, _) = parse_shon_bracket(&a).unwrap();
-        assert_eq!(val, Value::Array(vec![Value::Bytes(vec![0xca, 0xfe])]));
+        assert_eq!(
+            val,
+            Value::Array(vec![Value::Bytes(vec![0xca, 0xfe].into())])
+        );
     }
 
     #[test]
     fn test_hex_uppercase() {
         let a = args(&["[", "-x", "CAFE", "]"]);
         let (val, _) = parse_shon_bracket(&a).unwrap();
-        assert_eq!(val, Value::Array(vec![Value::Bytes(vec![0xca, 0xfe])]));
+        assert_eq!(
+            val,
+            Value::Array(vec![Value::Bytes(vec![0xca, 0xfe].into())])
+        );
     }
 
     #[test]
     fn test_hex_mixed_case() {
         let a = args(&["[", "-x", "CaFe", "]"]);
         let (val, _) = parse_shon_bracket(&a).unwrap();
-        assert_eq!(val, Value::Array(vec![Value::Bytes(vec![0xca, 0xfe])]));
+        assert_eq!(
+            val,
+            Value::Array(vec![Value::Bytes(vec![0xca, 0xfe].into())])
+        );
     }
 
     #[test]
     fn test_hex_empty() {
         let a = args(&["[", "-x", "", "]"]);
         let (val, _) = parse_shon_bracket(&a).unwrap();
-        assert_eq!(val, Value::Array(vec![Value::Bytes(vec![])]));
+        assert_eq!(val, Value::Array(vec![Value::Bytes(vec![].into())]));
     }
 
     #[test]
     fn test_hex_root() {
         let a = args(&["-x", "b0b5"]);
         let (val, consumed) = parse_shon_hex(&a).unwrap();
-        assert_eq!(val, Value::Bytes(vec![0xb0, 0xb5]));
+        assert_eq!(val, Value::Bytes(vec![0xb0, 0xb5].into()));
         assert_eq!(consumed, 2);
     }
 
@@ -678,7 +725,7 @@ mod tests {
     fn test_empty_object() {
         let a = args(&["[--]"]);
         let (val, _) = parse_shon_bracket(&a).unwrap();
-        assert_eq!(val, Value::Object(HashMap::new()));
+        assert_eq!(val, Value::Object(Map::new()));
     }
 
     #[test]
@@ -787,15 +834,15 @@ mod tests {
 
     #[test]
     fn test_array_with_mixed_types() {
-        let a = args(&["[", "hello", "42", "3.14", "-t", "-n", "-x", "ff", "]"]);
+        let a = args(&["[", "hello", "42", "2.5", "-t", "-n", "-x", "ff", "]"]);
         let (val, _) = parse_shon_bracket(&a).unwrap();
         let arr = val.as_array().unwrap();
         assert_eq!(arr[0], Value::String("hello".into()));
         assert_eq!(arr[1], Value::Integer(42.into()));
-        assert_eq!(arr[2], Value::Float(3.14));
+        assert_eq!(arr[2], Value::Float(2.5));
         assert_eq!(arr[3], Value::Bool(true));
         assert_eq!(arr[4], Value::Null);
-        assert_eq!(arr[5], Value::Bytes(vec![0xff]));
+        assert_eq!(arr[5], Value::Bytes(vec![0xff].into()));
     }
 
     #[test]
@@ -853,7 +900,7 @@ mod tests {
         let arr = val.as_array().unwrap();
         assert_eq!(
             arr[0],
-            Value::Integer(BigInt::from_str("99999999999999999999").unwrap())
+            Value::Integer("99999999999999999999".parse().unwrap())
         );
     }
 
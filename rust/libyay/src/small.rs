@@ -0,0 +1,313 @@
+//! Small-value inline storage for strings and byte arrays.
+//!
+//! Parsed documents are dominated by short strings and tiny byte fields,
+//! so `Value::String` and `Value::Bytes` store payloads of up to 22 bytes
+//! inline, without a heap allocation. Larger payloads spill to a boxed
+//! slice, which is two words instead of `String`/`Vec`'s three since
+//! parsed values are never mutated in place. Both representations fit in
+//! the 24 bytes a `String` would occupy, so `Value` does not grow.
+
+use std::borrow::Borrow;
+use std::fmt;
+use std::ops::Deref;
+
+/// Maximum payload length stored inline.
+const INLINE_CAP: usize = 22;
+
+/// A string with inline storage for up to 22 bytes.
+///
+/// Dereferences to `str`, so read access works like a `String`.
+#[derive(Clone)]
+pub struct SmallString(StrRepr);
+
+#[derive(Clone)]
+enum StrRepr {
+    Inline { len: u8, buf: [u8; INLINE_CAP] },
+    Heap(Box<str>),
+}
+
+impl SmallString {
+    /// Create an empty string.
+    pub fn new() -> Self {
+        SmallString(StrRepr::Inline {
+            len: 0,
+            buf: [0; INLINE_CAP],
+        })
+    }
+
+    /// Returns the string as a `&str`.
+    pub fn as_str(&self) -> &str {
+        match &self.0 {
+            StrRepr::Inline { len, buf } => {
+                // Inline bytes are always copied from a valid &str
+                unsafe { std::str::from_utf8_unchecked(&buf[..*len as usize]) }
+            }
+            StrRepr::Heap(s) => s,
+        }
+    }
+
+    /// Convert into an owned `String`.
+    pub fn into_string(self) -> String {
+        match self.0 {
+            StrRepr::Inline { len, buf } => {
+                // Inline bytes are always copied from a valid &str
+                unsafe { String::from_utf8_unchecked(buf[..len as usize].to_vec()) }
+            }
+            StrRepr::Heap(s) => s.into_string(),
+        }
+    }
+}
+
+impl Default for SmallString {
+    fn default() -> Self {
+        SmallString::new()
+    }
+}
+
+impl From<&str> for SmallString {
+    fn from(s: &str) -> Self {
+        if s.len() <= INLINE_CAP {
+            let mut buf = [0; INLINE_CAP];
+            buf[..s.len()].copy_from_slice(s.as_bytes());
+            SmallString(StrRepr::Inline {
+                len: s.len() as u8,
+                buf,
+            })
+        } else {
+            SmallString(StrRepr::Heap(s.into()))
+        }
+    }
+}
+
+impl From<String> for SmallString {
+    fn from(s: String) -> Self {
+        if s.len() <= INLINE_CAP {
+            SmallString::from(s.as_str())
+        } else {
+            SmallString(StrRepr::Heap(s.into_boxed_str()))
+        }
+    }
+}
+
+impl From<std::borrow::Cow<'_, str>> for SmallString {
+    fn from(s: std::borrow::Cow<'_, str>) -> Self {
+        match s {
+            std::borrow::Cow::Borrowed(s) => SmallString::from(s),
+            std::borrow::Cow::Owned(s) => SmallString::from(s),
+        }
+    }
+}
+
+impl From<SmallString> for String {
+    fn from(s: SmallString) -> Self {
+        s.into_string()
+    }
+}
+
+impl Deref for SmallString {
+    type Target = str;
+
+    fn deref(&self) -> &str {
+        self.as_str()
+    }
+}
+
+impl AsRef<str> for SmallString {
+    fn as_ref(&self) -> &str {
+        self.as_str()
+    }
+}
+
+impl Borrow<str> for SmallString {
+    fn borrow(&self) -> &str {
+        self.as_str()
+    }
+}
+
+impl PartialEq for SmallString {
+    fn eq(&self, other: &Self) -> bool {
+        self.as_str() == other.as_str()
+    }
+}
+
+impl Eq for SmallString {}
+
+impl PartialEq<str> for SmallString {
+    fn eq(&self, other: &str) -> bool {
+        self.as_str() == other
+    }
+}
+
+impl PartialEq<&str> for SmallString {
+    fn eq(&self, other: &&str) -> bool {
+        self.as_str() == *other
+    }
+}
+
+impl fmt::Debug for SmallString {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        fmt::Debug::fmt(self.as_str(), f)
+    }
+}
+
+impl fmt::Display for SmallString {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        fmt::Display::fmt(self.as_str(), f)
+    }
+}
+
+/// A byte array with inline storage for up to 22 bytes.
+///
+/// Dereferences to `[u8]`, so read access works like a `Vec<u8>`.
+#[derive(Clone)]
+pub struct SmallBytes(BytesRepr);
+
+#[derive(Clone)]
+enum BytesRepr {
+    Inline { len: u8, buf: [u8; INLINE_CAP] },
+    Heap(Box<[u8]>),
+}
+
+impl SmallBytes {
+    /// Create an empty byte array.
+    pub fn new() -> Self {
+        SmallBytes(BytesRepr::Inline {
+            len: 0,
+            buf: [0; INLINE_CAP],
+        })
+    }
+
+    /// Returns the bytes as a slice.
+    pub fn as_slice(&self) -> &[u8] {
+        match &self.0 {
+            BytesRepr::Inline { len, buf } => &buf[..*len as usize],
+            BytesRepr::Heap(b) => b,
+        }
+    }
+
+    /// Convert into an owned `Vec<u8>`.
+    pub fn into_vec(self) -> Vec<u8> {
+        match self.0 {
+            BytesRepr::Inline { len, buf } => buf[..len as usize].to_vec(),
+            BytesRepr::Heap(b) => b.into_vec(),
+        }
+    }
+}
+
+impl Default for SmallBytes {
+    fn default() -> Self {
+        SmallBytes::new()
+    }
+}
+
+impl From<&[u8]> for SmallBytes {
+    fn from(b: &[u8]) -> Self {
+        if b.len() <= INLINE_CAP {
+            let mut buf = [0; INLINE_CAP];
+            buf[..b.len()].copy_from_slice(b);
+            SmallBytes(BytesRepr::Inline {
+                len: b.len() as u8,
+                buf,
+            })
+        } else {
+            SmallBytes(BytesRepr::Heap(b.into()))
+        }
+    }
+}
+
+impl From<Vec<u8>> for SmallBytes {
+    fn from(b: Vec<u8>) -> Self {
+        if b.len() <= INLINE_CAP {
+            SmallBytes::from(b.as_slice())
+        } else {
+            SmallBytes(BytesRepr::Heap(b.into_boxed_slice()))
+        }
+    }
+}
+
+impl From<SmallBytes> for Vec<u8> {
+    fn from(b: SmallBytes) -> Self {
+        b.into_vec()
+    }
+}
+
+impl Deref for SmallBytes {
+    type Target = [u8];
+
+    fn deref(&self) -> &[u8] {
+        self.as_slice()
+    }
+}
+
+impl AsRef<[u8]> for SmallBytes {
+    fn as_ref(&self) -> &[u8] {
+        self.as_slice()
+    }
+}
+
+impl PartialEq for SmallBytes {
+    fn eq(&self, other: &Self) -> bool {
+        self.as_slice() == other.as_slice()
+    }
+}
+
+impl Eq for SmallBytes {}
+
+impl PartialEq<[u8]> for SmallBytes {
+    fn eq(&self, other: &[u8]) -> bool {
+        self.as_slice() == other
+    }
+}
+
+impl fmt::Debug for SmallBytes {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_list().entries(self.as_slice()).finish()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_small_string_inline_and_heap() {
+        let short = SmallString::from("hello");
+        assert!(matches!(short.0, StrRepr::Inline { .. }));
+        assert_eq!(short.as_str(), "hello");
+
+        let exact = SmallString::from("abcdefghijklmnopqrstuv"); // 22 bytes
+        assert!(matches!(exact.0, StrRepr::Inline { .. }));
+        assert_eq!(exact.as_str(), "abcdefghijklmnopqrstuv");
+
+        let long = SmallString::from("abcdefghijklmnopqrstuvw"); // 23 bytes
+        assert!(matches!(long.0, StrRepr::Heap(_)));
+        assert_eq!(long.as_str(), "abcdefghijklmnopqrstuvw");
+    }
+
+    #[test]
+    fn test_small_string_roundtrip() {
+        for s in ["", "a", "multi-byte: héllo", "x".repeat(100).as_str()] {
+            let small = SmallString::from(s);
+            assert_eq!(small, *s);
+            assert_eq!(small.clone().into_string(), s);
+        }
+    }
+
+    #[test]
+    fn test_small_bytes_inline_and_heap() {
+        let short = SmallBytes::from(vec![0xca, 0xfe]);
+        assert!(matches!(short.0, BytesRepr::Inline { .. }));
+        assert_eq!(short.as_slice(), &[0xca, 0xfe]);
+
+        let long = SmallBytes::from(vec![0u8; 23]);
+        assert!(matches!(long.0, BytesRepr::Heap(_)));
+        assert_eq!(long.into_vec(), vec![0u8; 23]);
+    }
+
+    #[test]
+    fn test_value_size_unchanged() {
+        // Both payloads must fit in the 24 bytes a String occupies
+        assert!(std::mem::size_of::<SmallString>() <= 24);
+        assert!(std::mem::size_of::<SmallBytes>() <= 24);
+    }
+}
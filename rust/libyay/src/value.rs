@@ -1,8 +1,120 @@
 //! YAY value representation.
 
+use crate::map::Map;
+use crate::small::{SmallBytes, SmallString};
 use num_bigint::BigInt;
-use std::collections::HashMap;
+use num_traits::ToPrimitive;
 use std::fmt;
+use std::str::FromStr;
+
+/// A YAY integer with an inline `i64` fast path.
+///
+/// Numeric scalars are overwhelmingly small, so values that fit in an
+/// `i64` are stored inline without allocating; only integers outside the
+/// `i64` range spill to a boxed `BigInt`. The representation is
+/// normalized: a value in `i64` range is always stored inline, so
+/// equality can compare representations directly.
+#[derive(Clone, PartialEq, Eq)]
+pub struct Int(IntRepr);
+
+#[derive(Clone, PartialEq, Eq)]
+enum IntRepr {
+    Small(i64),
+    Big(Box<BigInt>),
+}
+
+impl Int {
+    /// Returns the value if it fits in an `i64`.
+    pub fn to_i64(&self) -> Option<i64> {
+        match &self.0 {
+            IntRepr::Small(n) => Some(*n),
+            IntRepr::Big(_) => None,
+        }
+    }
+
+    /// Returns the value if it fits in a `u64`.
+    pub fn to_u64(&self) -> Option<u64> {
+        match &self.0 {
+            IntRepr::Small(n) => u64::try_from(*n).ok(),
+            IntRepr::Big(n) => n.to_u64(),
+        }
+    }
+
+    /// Returns the value as a `BigInt`, allocating if necessary.
+    pub fn to_bigint(&self) -> BigInt {
+        match &self.0 {
+            IntRepr::Small(n) => BigInt::from(*n),
+            IntRepr::Big(n) => (**n).clone(),
+        }
+    }
+}
+
+impl From<i64> for Int {
+    fn from(n: i64) -> Self {
+        Int(IntRepr::Small(n))
+    }
+}
+
+impl From<i32> for Int {
+    fn from(n: i32) -> Self {
+        Int(IntRepr::Small(n as i64))
+    }
+}
+
+impl From<u64> for Int {
+    fn from(n: u64) -> Self {
+        match i64::try_from(n) {
+            Ok(small) => Int(IntRepr::Small(small)),
+            Err(_) => Int(IntRepr::Big(Box::new(BigInt::from(n)))),
+        }
+    }
+}
+
+impl From<i128> for Int {
+    fn from(n: i128) -> Self {
+        match i64::try_from(n) {
+            Ok(small) => Int(IntRepr::Small(small)),
+            Err(_) => Int(IntRepr::Big(Box::new(BigInt::from(n)))),
+        }
+    }
+}
+
+impl From<BigInt> for Int {
+    fn from(n: BigInt) -> Self {
+        match n.to_i64() {
+            Some(small) => Int(IntRepr::Small(small)),
+            None => Int(IntRepr::Big(Box::new(n))),
+        }
+    }
+}
+
+impl FromStr for Int {
+    type Err = num_bigint::ParseBigIntError;
+
+    fn from_str(s: &str) -> Result<Self, Self::Err> {
+        // i64 parsing also rejects malformed input cheaply; only strings
+        // that overflow (or fail for other reasons) reach the BigInt parser
+        if let Ok(small) = s.parse::<i64>() {
+            return Ok(Int(IntRepr::Small(small)));
+        }
+        s.parse::<BigInt>().map(Int::from)
+    }
+}
+
+impl fmt::Display for Int {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        match &self.0 {
+            IntRepr::Small(n) => fmt::Display::fmt(n, f),
+            IntRepr::Big(n) => fmt::Display::fmt(n, f),
+        }
+    }
+}
+
+impl fmt::Debug for Int {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        fmt::Display::fmt(self, f)
+    }
+}
 
 /// A YAY value.
 #[derive(Clone, PartialEq)]
@@ -12,17 +124,17 @@ pub enum Value {
     /// Boolean value.
     Bool(bool),
     /// Arbitrary-precision integer.
-    Integer(BigInt),
+    Integer(Int),
     /// 64-bit floating-point number.
     Float(f64),
     /// UTF-8 string.
-    String(String),
+    String(SmallString),
     /// Array of values.
     Array(Vec<Value>),
-    /// Object (key-value map).
-    Object(HashMap<String, Value>),
+    /// Object (key-value map, in document order).
+    Object(Map),
     /// Byte array.
-    Bytes(Vec<u8>),
+    Bytes(SmallBytes),
 }
 
 impl Value {
@@ -40,7 +152,7 @@ impl Value {
     }
 
     /// Returns a reference to the integer if this is an `Integer`.
-    pub fn as_integer(&self) -> Option<&BigInt> {
+    pub fn as_integer(&self) -> Option<&Int> {
         match self {
             Value::Integer(n) => Some(n),
             _ => None,
@@ -72,7 +184,7 @@ impl Value {
     }
 
     /// Returns a reference to the object if this is an `Object`.
-    pub fn as_object(&self) -> Option<&HashMap<String, Value>> {
+    pub fn as_object(&self) -> Option<&Map> {
         match self {
             Value::Object(obj) => Some(obj),
             _ => None,
@@ -80,7 +192,7 @@ impl Value {
     }
 
     /// Returns a reference to the bytes if this is a `Bytes`.
-    pub fn as_bytes(&self) -> Option<&Vec<u8>> {
+    pub fn as_bytes(&self) -> Option<&[u8]> {
         match self {
             Value::Bytes(b) => Some(b),
             _ => None,
@@ -143,7 +255,7 @@ impl fmt::Debug for Value {
             Value::Object(obj) => f.debug_map().entries(obj).finish(),
             Value::Bytes(b) => {
                 write!(f, "<")?;
-                for byte in b {
+                for byte in b.as_slice() {
                     write!(f, "{:02x}", byte)?;
                 }
                 write!(f, ">")
@@ -160,13 +272,13 @@ impl From<bool> for Value {
 
 impl From<BigInt> for Value {
     fn from(n: BigInt) -> Self {
-        Value::Integer(n)
+        Value::Integer(n.into())
     }
 }
 
 impl From<i64> for Value {
     fn from(n: i64) -> Self {
-        Value::Integer(BigInt::from(n))
+        Value::Integer(n.into())
     }
 }
 
@@ -178,13 +290,13 @@ impl From<f64> for Value {
 
 impl From<String> for Value {
     fn from(s: String) -> Self {
-        Value::String(s)
+        Value::String(s.into())
     }
 }
 
 impl From<&str> for Value {
     fn from(s: &str) -> Self {
-        Value::String(s.to_string())
+        Value::String(s.into())
     }
 }
 
@@ -194,14 +306,14 @@ impl From<Vec<Value>> for Value {
     }
 }
 
-impl From<HashMap<String, Value>> for Value {
-    fn from(obj: HashMap<String, Value>) -> Self {
+impl From<Map> for Value {
+    fn from(obj: Map) -> Self {
         Value::Object(obj)
     }
 }
 
 impl From<Vec<u8>> for Value {
     fn from(b: Vec<u8>) -> Self {
-        Value::Bytes(b)
+        Value::Bytes(b.into())
     }
 }
@@ -14,9 +14,55 @@
 //!
 //! Reserved prefixes (ASCII `!` through `/`) are escaped with `!`.
 
-use crate::Value;
-use num_bigint::BigInt;
-use std::collections::HashMap;
+use crate::map::Map;
+use crate::{Int, Value};
+
+/// Parse newline-delimited YSON: one document per non-blank line.
+///
+/// Rows in a line-delimited export are independent, so they are parsed
+/// across a pool of worker threads sized to the machine. Workers claim
+/// rows from a shared counter; results are returned in input order.
+/// Errors are prefixed with the 1-based line number of the bad row.
+pub fn parse_yson_lines(input: &str) -> Result<Vec<Value>, String> {
+    let lines: Vec<(usize, &str)> = input
+        .lines()
+        .enumerate()
+        .filter(|(_, line)| !line.trim().is_empty())
+        .collect();
+
+    let parse_row =
+        |&(n, line): &(usize, &str)| parse_yson(line).map_err(|e| format!("line {}: {}", n + 1, e));
+
+    let jobs = std::thread::available_parallelism()
+        .map(|n| n.get())
+        .unwrap_or(1)
+        .min(lines.len().max(1));
+    if jobs <= 1 {
+        return lines.iter().map(parse_row).collect();
+    }
+
+    let next = std::sync::atomic::AtomicUsize::new(0);
+    let results = std::sync::Mutex::new(vec![None; lines.len()]);
+    std::thread::scope(|scope| {
+        for _ in 0..jobs {
+            scope.spawn(|| loop {
+                let i = next.fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+                if i >= lines.len() {
+                    break;
+                }
+                let outcome = parse_row(&lines[i]);
+                results.lock().unwrap()[i] = Some(outcome);
+            });
+        }
+    });
+
+    results
+        .into_inner()
+        .unwrap()
+        .into_iter()
+        .map(|r| r.expect("worker skipped a row"))
+        .collect()
+}
 
 /// Parse a YSON string into a YAY Value.
 pub fn parse_yson(input: &str) -> Result<Value, String> {
@@ -92,7 +138,7 @@ fn parse_string(input: &str) -> Result<(Value, &str), String> {
                     _ => {}
                 }
                 // BigInt
-                match payload.parse::<BigInt>() {
+                match payload.parse::<Int>() {
                     Ok(n) => return Ok((Value::Integer(n), rest)),
                     Err(e) => return Err(format!("Invalid bigint: {}", e)),
                 }
@@ -101,19 +147,19 @@ fn parse_string(input: &str) -> Result<(Value, &str), String> {
                 // Bytes (hex)
                 let hex = &s[1..];
                 match parse_hex(hex) {
-                    Ok(bytes) => return Ok((Value::Bytes(bytes), rest)),
+                    Ok(bytes) => return Ok((Value::Bytes(bytes.into()), rest)),
                     Err(e) => return Err(format!("Invalid hex: {}", e)),
                 }
             }
             '!' => {
                 // Escaped string - remove the escape prefix
-                return Ok((Value::String(s[1..].to_string()), rest));
+                return Ok((Value::String(s[1..].into()), rest));
             }
             _ => {}
         }
     }
 
-    Ok((Value::String(s), rest))
+    Ok((Value::String(s.into()), rest))
 }
 
 fn parse_json_string(input: &str) -> Result<(String, &str), String> {
@@ -297,7 +343,7 @@ fn parse_object(input: &str) -> Result<(Value, &str), String> {
     }
 
     let mut rest = input[1..].trim_start();
-    let mut obj = HashMap::new();
+    let mut obj = Map::new();
 
     if let Some(stripped) = rest.strip_prefix('}') {
         return Ok((Value::Object(obj), stripped));
@@ -352,7 +398,7 @@ mod tests {
         // YSON is a JSON dialect - all JSON numbers are float64
         assert_eq!(parse_yson("42").unwrap(), Value::Float(42.0));
         assert_eq!(parse_yson("-10").unwrap(), Value::Float(-10.0));
-        assert_eq!(parse_yson("3.14").unwrap(), Value::Float(3.14));
+        assert_eq!(parse_yson("2.5").unwrap(), Value::Float(2.5));
         assert_eq!(parse_yson("-1.5e10").unwrap(), Value::Float(-1.5e10));
     }
 
@@ -380,7 +426,7 @@ mod tests {
     #[test]
     fn test_parse_bytes() {
         let result = parse_yson("\"*cafe\"").unwrap();
-        assert_eq!(result, Value::Bytes(vec![0xca, 0xfe]));
+        assert_eq!(result, Value::Bytes(vec![0xca, 0xfe].into()));
     }
 
     #[test]
@@ -425,13 +471,13 @@ mod tests {
     fn test_roundtrip() {
         use crate::encode::{encode, Format};
 
-        let original = Value::Object(HashMap::from([
+        let original = Value::Object(Map::from([
             ("int".to_string(), Value::Integer(42.into())),
             (
                 "bigint".to_string(),
                 Value::Integer("12345678901234567890".parse().unwrap()),
             ),
-            ("bytes".to_string(), Value::Bytes(vec![0xca, 0xfe])),
+            ("bytes".to_string(), Value::Bytes(vec![0xca, 0xfe].into())),
             ("string".to_string(), Value::String("hello".into())),
             ("escaped".to_string(), Value::String("*world".into())),
         ]));
@@ -580,4 +626,38 @@ mod tests {
         let arr = result.as_array().unwrap();
         assert_eq!(arr.len(), 2);
     }
+
+    #[test]
+    fn test_parse_yson_lines_in_order() {
+        let input = "1\n\n{\"a\": 2}\n[3, 4]\n\"#5\"\n";
+        let values = parse_yson_lines(input).unwrap();
+        assert_eq!(values.len(), 4);
+        assert_eq!(values[0].as_float().unwrap(), 1.0);
+        assert_eq!(values[2].as_array().unwrap().len(), 2);
+        assert_eq!(values[3].as_integer().unwrap().to_i64(), Some(5));
+    }
+
+    #[test]
+    fn test_parse_yson_lines_many_rows() {
+        // Enough rows to exercise the worker pool.
+        let input: String = (0..1000).map(|i| format!("{{\"n\": {}}}\n", i)).collect();
+        let values = parse_yson_lines(&input).unwrap();
+        assert_eq!(values.len(), 1000);
+        for (i, v) in values.iter().enumerate() {
+            let obj = v.as_object().unwrap();
+            assert_eq!(obj["n"].as_float().unwrap(), i as f64);
+        }
+    }
+
+    #[test]
+    fn test_parse_yson_lines_reports_line_number() {
+        let err = parse_yson_lines("1\n:oops\n3\n").unwrap_err();
+        assert!(err.starts_with("line 2:"), "unexpected error: {}", err);
+    }
+
+    #[test]
+    fn test_parse_yson_lines_empty_input() {
+        assert_eq!(parse_yson_lines("").unwrap(), vec![]);
+        assert_eq!(parse_yson_lines("\n\n").unwrap(), vec![]);
+    }
 }
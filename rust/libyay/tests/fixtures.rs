@@ -32,7 +32,7 @@ fn values_equal(a: &Value, b: &Value) -> bool {
         (Value::Object(a), Value::Object(b)) => {
             a.len() == b.len()
                 && a.iter()
-                    .all(|(k, v)| b.get(k).map_or(false, |bv| values_equal(v, bv)))
+                    .all(|(k, v)| b.get(k).is_some_and(|bv| values_equal(v, bv)))
         }
         _ => false,
     }
@@ -384,7 +384,7 @@ fn test_all_encoder_coverage() {
     let mut errors: Vec<String> = Vec::new();
 
     for file in &files {
-        let content = match fs::read_to_string(&file) {
+        let content = match fs::read_to_string(file) {
             Ok(c) => c,
             Err(e) => {
                 errors.push(format!("Failed to read {}: {}", file, e));
@@ -443,6 +443,60 @@ fn exercise_value_accessors(value: &Value) {
     }
 }
 
+#[test]
+fn test_validate_matches_parse() {
+    // Tree-free validation must agree with the full parser on every
+    // valid and invalid corpus document, including error messages.
+    for file in get_yay_files().into_iter().chain(get_nay_files()) {
+        let content = match fs::read_to_string(&file) {
+            Ok(c) => c,
+            Err(_) => continue,
+        };
+        match (libyay::validate(&content), parse(&content)) {
+            (Ok(()), Ok(_)) => {}
+            (Err(ve), Err(pe)) => {
+                assert_eq!(
+                    ve.to_string(),
+                    pe.to_string(),
+                    "error mismatch for {}",
+                    file
+                );
+            }
+            (v, p) => panic!(
+                "validate/parse disagree for {}: validate={:?} parse_ok={}",
+                file,
+                v,
+                p.is_ok()
+            ),
+        }
+    }
+}
+
+#[test]
+fn test_encode_to_matches_encode() {
+    // The streaming encoder must produce byte-identical output to the
+    // string encoder for every corpus document.
+    for file in get_yay_files() {
+        let content = match fs::read_to_string(&file) {
+            Ok(c) => c,
+            Err(_) => continue,
+        };
+        let value = match parse(&content) {
+            Ok(v) => v,
+            Err(_) => continue,
+        };
+        let expected = libyay::encode(&value, libyay::Format::Yay);
+        let mut streamed = Vec::new();
+        libyay::encode_to(&value, libyay::Format::Yay, &mut streamed).unwrap();
+        assert_eq!(
+            String::from_utf8(streamed).unwrap(),
+            expected,
+            "encode_to mismatch for {}",
+            file
+        );
+    }
+}
+
 #[test]
 fn test_value_accessor_coverage() {
     let files = get_yay_files();
@@ -458,7 +512,7 @@ fn test_value_accessor_coverage() {
     );
 
     for file in &files {
-        let content = match fs::read_to_string(&file) {
+        let content = match fs::read_to_string(file) {
             Ok(c) => c,
             Err(_) => continue,
         };
@@ -475,14 +529,11 @@ fn test_value_accessor_coverage() {
     let _ = Value::from(true);
     let _ = Value::from(false);
     let _ = Value::from(42i64);
-    let _ = Value::from(3.14f64);
+    let _ = Value::from(2.5f64);
     let _ = Value::from("hello");
     let _ = Value::from(String::from("world"));
     let _ = Value::from(vec![Value::Null]);
-    let _ = Value::from(std::collections::HashMap::from([(
-        "key".to_string(),
-        Value::Null,
-    )]));
+    let _ = Value::from(libyay::Map::from([("key".to_string(), Value::Null)]));
     let _ = Value::from(vec![0u8, 1, 2]);
     let _ = Value::from(num_bigint::BigInt::from(123));
 }
@@ -794,7 +845,7 @@ fn test_inline_object_nested() {
 #[test]
 fn test_bytes_empty() {
     let result = parse("<>").unwrap();
-    assert_eq!(result, Value::Bytes(vec![]));
+    assert_eq!(result, Value::Bytes(vec![].into()));
 }
 
 #[test]
@@ -802,7 +853,7 @@ fn test_bytes_inline() {
     let result = parse("<b0b5c0ffeefacade>").unwrap();
     assert_eq!(
         result,
-        Value::Bytes(vec![0xb0, 0xb5, 0xc0, 0xff, 0xee, 0xfa, 0xca, 0xde])
+        Value::Bytes(vec![0xb0, 0xb5, 0xc0, 0xff, 0xee, 0xfa, 0xca, 0xde].into())
     );
 }
 
@@ -866,8 +917,8 @@ fn test_array_inline_bytearray() {
     let result = parse("[<b0b5>, <cafe>]").unwrap();
     let arr = result.as_array().unwrap();
     assert_eq!(arr.len(), 2);
-    assert_eq!(arr[0], Value::Bytes(vec![0xb0, 0xb5]));
-    assert_eq!(arr[1], Value::Bytes(vec![0xca, 0xfe]));
+    assert_eq!(arr[0], Value::Bytes(vec![0xb0, 0xb5].into()));
+    assert_eq!(arr[1], Value::Bytes(vec![0xca, 0xfe].into()));
 }
 
 #[test]
@@ -1001,3 +1052,101 @@ fn test_meh_reformat_fixtures() {
 
     assert!(failed == 0, "{} MEH reformat tests failed", failed);
 }
+
+/// Verify that incremental formatting matches a full reformat.
+/// For every MEH fixture and every YAY fixture, applies synthetic edits
+/// (append a section, prepend a section, change a line) and checks that
+/// `format_yay_incremental` produces byte-identical output to `format_yay`.
+#[test]
+fn test_meh_incremental_matches_full() {
+    let mut sources: Vec<String> = Vec::new();
+    for (meh_path, _) in get_meh_reformat_files() {
+        sources.push(meh_path);
+    }
+    sources.extend(get_yay_files());
+
+    assert!(!sources.is_empty(), "No fixture files found!");
+
+    let mut checked = 0;
+    for path in &sources {
+        let old =
+            fs::read_to_string(path).unwrap_or_else(|e| panic!("Failed to read {}: {}", path, e));
+        let old_out = match libyay::format_yay(&old) {
+            Ok(out) => out,
+            Err(_) => continue,
+        };
+
+        let edits = [
+            format!("{}\n\nzz_incremental_probe: 1\n", old),
+            format!("aa_incremental_probe: 0\n\n{}", old),
+            format!("{}\n", old),
+        ];
+
+        for new in &edits {
+            let incremental = libyay::format_yay_incremental(new, &old, &old_out)
+                .unwrap_or_else(|e| panic!("{}: incremental format failed: {}", path, e));
+            let full = libyay::format_yay(new)
+                .unwrap_or_else(|e| panic!("{}: full format failed: {}", path, e));
+            assert_eq!(
+                incremental, full,
+                "{}: incremental output differs from full reformat",
+                path
+            );
+        }
+        checked += 1;
+    }
+
+    println!(
+        "\nChecked incremental formatting against {} fixtures",
+        checked
+    );
+    assert!(checked > 0);
+}
+
+#[test]
+fn test_structural_diff() {
+    let old = parse(concat!(
+        "name: 'service'\n",
+        "port: 8080\n",
+        "replicas:\n",
+        "- 'a'\n",
+        "- 'b'\n",
+        "limits:\n",
+        "  cpu: 2\n",
+        "  memory: 512\n",
+    ))
+    .unwrap();
+    let new = parse(concat!(
+        "name: 'service'\n",
+        "port: 8081\n",
+        "replicas:\n",
+        "- 'a'\n",
+        "- 'b'\n",
+        "- 'c'\n",
+        "limits:\n",
+        "  cpu: 2\n",
+        "tier: 'gold'\n",
+    ))
+    .unwrap();
+
+    assert!(libyay::diff(&old, &old).is_empty());
+
+    let changes = libyay::diff(&old, &new);
+    let summary: Vec<(String, libyay::DiffOp)> = changes
+        .iter()
+        .map(|entry| (entry.path.clone(), entry.op))
+        .collect();
+    assert_eq!(
+        summary,
+        vec![
+            ("$.port".to_string(), libyay::DiffOp::Changed),
+            ("$.replicas[2]".to_string(), libyay::DiffOp::Added),
+            ("$.limits.memory".to_string(), libyay::DiffOp::Removed),
+            ("$.tier".to_string(), libyay::DiffOp::Added),
+        ]
+    );
+
+    let port = &changes[0];
+    assert_eq!(port.old.as_deref(), Some("8080n"));
+    assert_eq!(port.new.as_deref(), Some("8081n"));
+}
@@ -72,10 +72,13 @@
 (define (string-join lst sep)
   (if (null? lst)
       ""
-      (let loop ((rest (cdr lst)) (result (car lst)))
-        (if (null? rest)
-            result
-            (loop (cdr rest) (string-append result sep (car rest)))))))
+      (let ((port (open-output-string)))
+        (display (car lst) port)
+        (for-each (lambda (s)
+                    (display sep port)
+                    (display s port))
+                  (cdr lst))
+        (get-output-string port))))
 
 (define (string-trim s)
   (let* ((len (string-length s))
@@ -528,21 +531,23 @@
     (when (not (string-contains? s "]"))
       (yay-error "Unexpected newline in inline array"))
     (validate-inline-syntax s)
-    ;; Simple parser for inline arrays
-    (let loop ((i 1) (items '()) (current ""))
+    ;; Simple parser for inline arrays; the current item is the slice of
+    ;; the source from seg-start, so nothing is copied per character.
+    (let loop ((i 1) (items '()) (seg-start 1))
       (if (>= i len)
           (list->vector (reverse items))
-          (let ((ch (string-ref s i)))
+          (let ((ch (string-ref s i))
+                (current (lambda () (string-trim (substring s seg-start i)))))
             (cond
              ;; End of array
              ((char=? ch #\])
-              (let ((items (if (string=? (string-trim current) "")
+              (let ((items (if (string=? (current) "")
                                items
-                               (cons (parse-inline-value (string-trim current)) items))))
+                               (cons (parse-inline-value (current)) items))))
                 (list->vector (reverse items))))
              ;; Comma separator - skip following space
              ((char=? ch #\,)
-              (let ((trimmed (string-trim current)))
+              (let ((trimmed (current)))
                 (let ((new-items (if (string=? trimmed "")
                                      items
                                      (cons (parse-inline-value trimmed) items)))
@@ -551,67 +556,68 @@
                                        (char=? (string-ref s (+ i 1)) #\space))
                                   (+ i 2)
                                   (+ i 1))))
-                  (loop next-i new-items ""))))
+                  (loop next-i new-items next-i))))
              ;; Start of nested array
              ((char=? ch #\[)
               (receive (nested end-i) (parse-nested-inline-array s i)
-                (loop end-i (cons nested items) "")))
+                (loop end-i (cons nested items) end-i)))
              ;; Start of string
              ((or (char=? ch #\") (char=? ch #\'))
               (receive (str end-i) (parse-inline-string s i ch)
-                (loop end-i items (string-append current str))))
+                (loop end-i items seg-start)))
              ;; Start of bytes
              ((char=? ch #\<)
               (receive (bytes end-i) (parse-inline-bytes s i)
-                (loop end-i (cons bytes items) "")))
+                (loop end-i (cons bytes items) end-i)))
              ;; Regular character
              (else
-              (loop (+ i 1) items (string-append current (string ch))))))))))
+              (loop (+ i 1) items seg-start))))))))
 
 ;; Parse nested inline array
+;; Tracks bracket depth over the source and slices the balanced span once.
 (define (parse-nested-inline-array s start)
-  (let loop ((i (+ start 1)) (depth 1) (content "["))
-    (if (or (>= i (string-length s)) (= depth 0))
-        (values (parse-inline-array content) i)
+  (let loop ((i (+ start 1)) (depth 1))
+    (if (>= i (string-length s))
+        (values (parse-inline-array (substring s start i)) i)
         (let ((ch (string-ref s i)))
           (cond
            ((char=? ch #\[)
-            (loop (+ i 1) (+ depth 1) (string-append content (string ch))))
+            (loop (+ i 1) (+ depth 1)))
            ((char=? ch #\])
             (if (= depth 1)
-                (values (parse-inline-array (string-append content "]")) (+ i 1))
-                (loop (+ i 1) (- depth 1) (string-append content (string ch)))))
+                (values (parse-inline-array (substring s start (+ i 1))) (+ i 1))
+                (loop (+ i 1) (- depth 1))))
            ((or (char=? ch #\") (char=? ch #\'))
             (receive (str end-i) (parse-inline-string s i ch)
-              (loop end-i depth (string-append content str))))
+              (loop end-i depth)))
            (else
-            (loop (+ i 1) depth (string-append content (string ch)))))))))
+            (loop (+ i 1) depth)))))))
 
 ;; Parse inline string within array
+;; Scans for the closing quote, then slices the source once.
 (define (parse-inline-string s start quote)
-  (let loop ((i (+ start 1)) (content (string quote)) (escaped #f))
+  (let loop ((i (+ start 1)) (escaped #f))
     (if (>= i (string-length s))
-        (values content i)
+        (values (substring s start i) i)
         (let ((ch (string-ref s i)))
           (cond
            (escaped
-            (loop (+ i 1) (string-append content (string ch)) #f))
+            (loop (+ i 1) #f))
            ((char=? ch #\\)
-            (loop (+ i 1) (string-append content (string ch)) #t))
+            (loop (+ i 1) #t))
            ((char=? ch quote)
-            (values (string-append content (string ch)) (+ i 1)))
+            (values (substring s start (+ i 1)) (+ i 1)))
            (else
-            (loop (+ i 1) (string-append content (string ch)) #f)))))))
+            (loop (+ i 1) #f)))))))
 
 ;; Parse inline bytes within array
 (define (parse-inline-bytes s start)
-  (let loop ((i (+ start 1)) (content ""))
+  (let loop ((i (+ start 1)))
     (if (>= i (string-length s))
-        (values (parse-hex-bytes content) i)
-        (let ((ch (string-ref s i)))
-          (if (char=? ch #\>)
-              (values (parse-hex-bytes content) (+ i 1))
-              (loop (+ i 1) (string-append content (string ch))))))))
+        (values (parse-hex-bytes (substring s (+ start 1) i)) i)
+        (if (char=? (string-ref s i) #\>)
+            (values (parse-hex-bytes (substring s (+ start 1) i)) (+ i 1))
+            (loop (+ i 1))))))
 
 ;; Parse inline object {...}
 (define (parse-inline-object s)
@@ -619,29 +625,32 @@
     (when (not (string-contains? s "}"))
       (yay-error "Unexpected newline in inline object"))
     (validate-inline-syntax s)
-    ;; Simple parser for inline objects
-    (let loop ((i 1) (pairs '()) (current-key #f) (current ""))
+    ;; Simple parser for inline objects; the current key or value text is
+    ;; the slice of the source from seg-start, so nothing is copied per
+    ;; character. A parsed nested container is carried in parsed instead.
+    (let loop ((i 1) (pairs '()) (current-key #f) (seg-start 1) (parsed #f))
       (if (>= i len)
           (reverse pairs)
-          (let ((ch (string-ref s i)))
+          (let ((ch (string-ref s i))
+                (current (lambda () (string-trim (substring s seg-start i)))))
             (cond
              ;; End of object
              ((char=? ch #\})
-              (let ((trimmed-current (if (string? current) (string-trim current) "")))
+              (let ((trimmed-current (if parsed "" (current))))
                 ;; If we have content but no key, we're missing a colon
                 (when (and (not current-key) (> (string-length trimmed-current) 0))
                   (yay-error "Expected colon after key"))
                 (let ((pairs (if current-key
-                                 (cons (cons current-key 
-                                             (if (string? current)
-                                                 (parse-inline-value trimmed-current)
-                                                 current))  ;; Already parsed (nested object/array)
+                                 (cons (cons current-key
+                                             (if parsed
+                                                 parsed  ;; Already parsed (nested object/array)
+                                                 (parse-inline-value trimmed-current)))
                                        pairs)
                                  pairs)))
                   (reverse pairs))))
              ;; Colon separator - we have the key
              ((and (not current-key) (char=? ch #\:))
-              (let ((key (string-trim current)))
+              (let ((key (current)))
                 ;; Parse key (may be quoted)
                 (let ((parsed-key (cond
                                    ((string-starts-with? key "\"") (parse-json-string key))
@@ -655,52 +664,53 @@
                                          (char=? (string-ref s (+ i 1)) #\space))
                                     (+ i 2)
                                     (+ i 1))))
-                    (loop next-i pairs parsed-key "")))))
+                    (loop next-i pairs parsed-key next-i #f)))))
              ;; Comma separator - end of value
              ((char=? ch #\,)
-              (let ((value (if (string? current)
-                               (parse-inline-value (string-trim current))
-                               current)))  ;; Already parsed (nested object/array)
+              (let ((value (if parsed
+                               parsed  ;; Already parsed (nested object/array)
+                               (parse-inline-value (current)))))
                 ;; Skip space after comma
                 (let ((next-i (if (and (< (+ i 1) len)
                                        (char=? (string-ref s (+ i 1)) #\space))
                                   (+ i 2)
                                   (+ i 1))))
-                  (loop next-i (cons (cons current-key value) pairs) #f ""))))
+                  (loop next-i (cons (cons current-key value) pairs) #f next-i #f))))
              ;; Start of nested object
              ((char=? ch #\{)
               (receive (nested end-i) (parse-nested-inline-object s i)
-                (loop end-i pairs current-key nested)))
+                (loop end-i pairs current-key end-i nested)))
              ;; Start of nested array
              ((char=? ch #\[)
               (receive (nested end-i) (parse-nested-inline-array s i)
-                (loop end-i pairs current-key nested)))
+                (loop end-i pairs current-key end-i nested)))
              ;; Start of string
              ((or (char=? ch #\") (char=? ch #\'))
               (receive (str end-i) (parse-inline-string s i ch)
-                (loop end-i pairs current-key (string-append current str))))
+                (loop end-i pairs current-key seg-start parsed)))
              ;; Regular character
              (else
-              (loop (+ i 1) pairs current-key (string-append current (string ch))))))))))
+              (loop (+ i 1) pairs current-key seg-start parsed))))))))
 
 ;; Parse nested inline object
+;; Tracks brace depth over the source and slices the balanced span once.
 (define (parse-nested-inline-object s start)
-  (let loop ((i (+ start 1)) (depth 1) (content "{"))
-    (if (or (>= i (string-length s)) (= depth 0))
-        (values (parse-inline-object content) i)
+  (let loop ((i (+ start 1)) (depth 1))
+    (if (>= i (string-length s))
+        (values (parse-inline-object (substring s start i)) i)
         (let ((ch (string-ref s i)))
           (cond
            ((char=? ch #\{)
-            (loop (+ i 1) (+ depth 1) (string-append content (string ch))))
+            (loop (+ i 1) (+ depth 1)))
            ((char=? ch #\})
             (if (= depth 1)
-                (values (parse-inline-object (string-append content "}")) (+ i 1))
-                (loop (+ i 1) (- depth 1) (string-append content (string ch)))))
+                (values (parse-inline-object (substring s start (+ i 1))) (+ i 1))
+                (loop (+ i 1) (- depth 1))))
            ((or (char=? ch #\") (char=? ch #\'))
             (receive (str end-i) (parse-inline-string s i ch)
-              (loop end-i depth (string-append content str))))
+              (loop end-i depth)))
            (else
-            (loop (+ i 1) depth (string-append content (string ch)))))))))
+            (loop (+ i 1) depth)))))))
 
 ;; Parse inline value (for array elements)
 (define (parse-inline-value s)
@@ -824,8 +834,10 @@
               'null))))))
 
 ;; Main parser state
+;; Tokens are held in a vector so peeking is constant-time; a list here
+;; makes every peek walk from the head and the parse quadratic.
 (define (make-parser tokens)
-  (vector tokens 0))
+  (vector (list->vector tokens) 0))
 
 (define (parser-tokens p) (vector-ref p 0))
 (define (parser-idx p) (vector-ref p 1))
@@ -834,9 +846,9 @@
 (define (parser-peek p)
   (let ((tokens (parser-tokens p))
         (idx (parser-idx p)))
-    (if (>= idx (length tokens))
+    (if (>= idx (vector-length tokens))
         #f
-        (list-ref tokens idx))))
+        (vector-ref tokens idx))))
 
 (define (parser-advance! p)
   (parser-idx-set! p (+ (parser-idx p) 1)))
@@ -1003,16 +1015,14 @@
         (finish-block-string lines first-line))))))
 
 (define (finish-block-string lines first-line)
-  (let* ((rev-lines (reverse lines))
-         ;; Trim trailing empty lines
-         (trimmed (let trim-end ((lst rev-lines))
-                    (if (and (pair? lst)
-                             (pair? (reverse lst))
-                             (string=? (car (reverse lst)) ""))
-                        (trim-end (reverse (cdr (reverse lst))))
+  ;; Lines arrive most-recent-first, so the document's trailing empties
+  ;; sit at the head; drop them before the single reverse, then drop the
+  ;; leading empties after it.
+  (let* ((trimmed (let trim-end ((lst lines))
+                    (if (and (pair? lst) (string=? (car lst) ""))
+                        (trim-end (cdr lst))
                         lst)))
-         ;; Trim leading empty lines
-         (trimmed2 (let trim-start ((lst trimmed))
+         (trimmed2 (let trim-start ((lst (reverse trimmed)))
                      (if (and (pair? lst) (string=? (car lst) ""))
                          (trim-start (cdr lst))
                          lst)))
@@ -1040,7 +1050,7 @@
                  (not (string-index hex-start #\#)))
         (yay-error "Expected hex or comment in hex block"))
       (parser-advance! p)
-      (let loop ((hex hex-clean) (base-indent 0))
+      (let loop ((parts (list hex-clean)) (base-indent 0))
         (let ((t (parser-peek p)))
           (if (and t
                    (eq? (token-type t) 'text)
@@ -1051,8 +1061,8 @@
                                        (substring line 0 hash-idx)
                                        line))))
                 (parser-advance! p)
-                (loop (string-append hex line-clean) base-indent))
-              (parse-hex-bytes hex)))))))
+                (loop (cons line-clean parts) base-indent))
+              (parse-hex-bytes (apply string-append (reverse parts)))))))))
 
 ;; Parse concatenated quoted strings (multiple quoted strings on consecutive lines)
 ;; Returns #f if there's only one string (single string on new line is invalid)
@@ -1115,7 +1125,7 @@
       (when (> (string-length (string-trim hex-clean)) 0)
         (yay-error "Expected newline after block leader in property"))
       (parser-advance! p)
-      (let loop ((hex hex-clean))
+      (let loop ((parts (list hex-clean)))
         (let ((t (parser-peek p)))
           (if (and t
                    (eq? (token-type t) 'text)
@@ -1126,8 +1136,8 @@
                                        (substring line 0 hash-idx)
                                        line))))
                 (parser-advance! p)
-                (loop (string-append hex line-clean)))
-              (parse-hex-bytes hex)))))))
+                (loop (cons line-clean parts)))
+              (parse-hex-bytes (apply string-append (reverse parts)))))))))
 
 ;; Parse multiline angle bytes
 (define (parse-multiline-angle-bytes p first-line base-indent)
@@ -1140,7 +1150,7 @@
                            (substring hex-start 0 hash-idx)
                            hex-start))))
       (parser-advance! p)
-      (let loop ((hex hex-clean))
+      (let loop ((parts (list hex-clean)))
         (let ((t (parser-peek p)))
           (if (and t
                    (eq? (token-type t) 'text)
@@ -1151,8 +1161,8 @@
                                        (substring line 0 hash-idx)
                                        line))))
                 (parser-advance! p)
-                (loop (string-append hex line-clean)))
-              (parse-hex-bytes hex)))))))
+                (loop (cons line-clean parts)))
+              (parse-hex-bytes (apply string-append (reverse parts)))))))))
 
 ;; Parse value with optional base indent for block strings in array context
 (define (parse-value p . args)
@@ -1652,36 +1662,39 @@
 
 ;; Format string for Scheme output
 (define (format-scheme-string s)
-  (string-append "\""
-                 (let loop ((i 0) (acc ""))
-                   (if (>= i (string-length s))
-                       acc
-                       (let ((c (string-ref s i))
-                             (code (char->integer (string-ref s i))))
-                         (cond
-                          ((char=? c #\") (loop (+ i 1) (string-append acc "\\\"")))
-                          ((char=? c #\\) (loop (+ i 1) (string-append acc "\\\\")))
-                          ((char=? c #\/) (loop (+ i 1) (string-append acc "\\/")))
-                          ((char=? c #\newline) (loop (+ i 1) (string-append acc "\\n")))
-                          ((char=? c #\return) (loop (+ i 1) (string-append acc "\\r")))
-                          ((char=? c #\tab) (loop (+ i 1) (string-append acc "\\t")))
-                          ((char=? c #\backspace) (loop (+ i 1) (string-append acc "\\b")))
-                          ((char=? c (integer->char 12)) (loop (+ i 1) (string-append acc "\\f")))
-                          ;; Non-ASCII characters - keep as-is if fixture expects it
-                          ;; (emojis and other unicode are kept as literal characters)
-                          ((> code 127)
-                           (let ((hex (number->string code 16)))
-                             (if (<= (string-length hex) 4)
-                                 ;; 4 or fewer hex digits - use \uXXXX format
-                                 (loop (+ i 1) 
-                                       (string-append acc "\\u" 
-                                                      (string-append 
-                                                       (make-string (- 4 (string-length hex)) #\0)
-                                                       (string-upcase hex))))
-                                 ;; More than 4 hex digits (emoji etc) - keep as literal
-                                 (loop (+ i 1) (string-append acc (string c))))))
-                          (else (loop (+ i 1) (string-append acc (string c))))))))
-                 "\""))
+  ;; Escapes accumulate in a string port, not by rebuilding the string
+  ;; per character.
+  (let ((port (open-output-string)))
+    (write-char #\" port)
+    (let loop ((i 0))
+      (when (< i (string-length s))
+        (let* ((c (string-ref s i))
+               (code (char->integer c)))
+          (cond
+           ((char=? c #\") (display "\\\"" port))
+           ((char=? c #\\) (display "\\\\" port))
+           ((char=? c #\/) (display "\\/" port))
+           ((char=? c #\newline) (display "\\n" port))
+           ((char=? c #\return) (display "\\r" port))
+           ((char=? c #\tab) (display "\\t" port))
+           ((char=? c #\backspace) (display "\\b" port))
+           ((char=? c (integer->char 12)) (display "\\f" port))
+           ;; Non-ASCII characters - keep as-is if fixture expects it
+           ;; (emojis and other unicode are kept as literal characters)
+           ((> code 127)
+            (let ((hex (number->string code 16)))
+              (if (<= (string-length hex) 4)
+                  ;; 4 or fewer hex digits - use \uXXXX format
+                  (begin
+                    (display "\\u" port)
+                    (display (make-string (- 4 (string-length hex)) #\0) port)
+                    (display (string-upcase hex) port))
+                  ;; More than 4 hex digits (emoji etc) - keep as literal
+                  (write-char c port))))
+           (else (write-char c port))))
+        (loop (+ i 1))))
+    (write-char #\" port)
+    (get-output-string port)))
 
 ;; Format bytevector
 (define (format-bytevector bytes)
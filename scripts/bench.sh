@@ -0,0 +1,104 @@
+#!/bin/bash
+# Cross-implementation parse throughput harness
+#
+# Runs every available implementation's bench runner over the same
+# corpus and prints a comparable MB/s and peak-RSS table. Each runner
+# parses the corpus REPS times and reports "<bytes> <seconds>" on
+# stdout; peak RSS is read from /usr/bin/time.
+#
+# Usage: scripts/bench.sh [corpus-dir] [reps]
+
+set -ueo pipefail
+
+HERE=$(dirname "${BASH_SOURCE[0]}")
+ROOT=$(cd "$HERE/.." && pwd)
+
+CORPUS="${1:-$ROOT/test/yay}"
+REPS="${2:-200}"
+
+if [[ ! -d "$CORPUS" ]]; then
+  echo "Corpus directory not found: $CORPUS"
+  exit 2
+fi
+
+TIME_BIN=""
+TIME_FLAG=""
+if [[ -x /usr/bin/time ]]; then
+  if /usr/bin/time -v true >/dev/null 2>&1; then
+    TIME_BIN=/usr/bin/time
+    TIME_FLAG=-v
+  elif /usr/bin/time -l true >/dev/null 2>&1; then
+    TIME_BIN=/usr/bin/time
+    TIME_FLAG=-l
+  fi
+fi
+
+printf '%-8s %12s %14s\n' "impl" "MB/s" "peak RSS (MB)"
+
+# measure NAME CMD... - run one bench binary and print its table row.
+measure() {
+  local name="$1"
+  shift
+  local stdout stderr bytes seconds rss_mb
+  stderr=$(mktemp)
+  if [[ -n "$TIME_BIN" ]]; then
+    stdout=$("$TIME_BIN" "$TIME_FLAG" "$@" 2>"$stderr") || {
+      echo "$name: bench run failed" >&2
+      cat "$stderr" >&2
+      rm -f "$stderr"
+      return 1
+    }
+    if [[ "$TIME_FLAG" == -v ]]; then
+      # GNU time reports kbytes
+      rss_mb=$(awk '/Maximum resident set size/ {printf "%.1f", $NF / 1024}' "$stderr")
+    else
+      # BSD time reports bytes
+      rss_mb=$(awk '/maximum resident set size/ {printf "%.1f", $1 / 1048576}' "$stderr")
+    fi
+  else
+    stdout=$("$@" 2>"$stderr") || {
+      echo "$name: bench run failed" >&2
+      cat "$stderr" >&2
+      rm -f "$stderr"
+      return 1
+    }
+    rss_mb="-"
+  fi
+  rm -f "$stderr"
+  bytes=$(echo "$stdout" | awk '{print $1}')
+  seconds=$(echo "$stdout" | awk '{print $2}')
+  awk -v name="$name" -v bytes="$bytes" -v seconds="$seconds" -v rss="$rss_mb" \
+    'BEGIN {printf "%-8s %12.1f %14s\n", name, bytes / seconds / 1e6, rss}'
+}
+
+# C
+if command -v make >/dev/null 2>&1 && command -v cc >/dev/null 2>&1; then
+  make -s -C "$ROOT/c" bench_yay >/dev/null
+  measure c "$ROOT/c/bench_yay" --throughput "$CORPUS" "$REPS"
+else
+  echo "c: skipped (make or cc not installed)" >&2
+fi
+
+# Rust
+if command -v cargo >/dev/null 2>&1; then
+  (cd "$ROOT/rust" && cargo build --quiet --release --bin bench_corpus)
+  measure rust "$ROOT/rust/target/release/bench_corpus" "$CORPUS" "$REPS"
+else
+  echo "rust: skipped (cargo not installed)" >&2
+fi
+
+# Go
+if command -v go >/dev/null 2>&1; then
+  (cd "$ROOT/go" && go build -o /tmp/yay_bench_corpus ./cmd/bench_corpus)
+  measure go /tmp/yay_bench_corpus "$CORPUS" "$REPS"
+  rm -f /tmp/yay_bench_corpus
+else
+  echo "go: skipped (go not installed)" >&2
+fi
+
+# JS
+if command -v node >/dev/null 2>&1; then
+  measure js node "$ROOT/js/libyay/bench.js" "$CORPUS" "$REPS"
+else
+  echo "js: skipped (node not installed)" >&2
+fi
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""
+Generate the synthetic scaling corpus.
+
+The hand-written fixtures in test/yay/ are all small; these documents
+exercise the parser's scaling behavior instead, with one shape per axis:
+flat array length, object width, nesting depth, block string and hex
+block size, and float density. The small scale is checked in under
+test/scaling/ as the standard input set for the benchmark harnesses
+(e.g. scripts/bench.sh test/scaling); the large scale is generated on
+demand into test/scaling-large/, which is gitignored.
+
+Usage: scripts/gen-scaling-corpus.py [--scale small|large] [--out DIR]
+"""
+
+import argparse
+from pathlib import Path
+
+SCALES = {
+    'small': {
+        'flat_array': 1000,
+        'wide_object': 1000,
+        'deep_nesting': 100,
+        'block_string': 4096,
+        'hex_block': 4096,
+        'float_matrix': (32, 8),
+    },
+    'large': {
+        'flat_array': 100000,
+        'wide_object': 100000,
+        'deep_nesting': 1000,
+        'block_string': 1 << 20,
+        'hex_block': 1 << 20,
+        'float_matrix': (1000, 64),
+    },
+}
+
+
+def flat_array(n):
+    """n integers in a block list."""
+    return ''.join(f'- {i}\n' for i in range(n))
+
+
+def wide_object(k):
+    """k short properties in one flat object."""
+    return ''.join(f'key{i:06d}: {i}\n' for i in range(k))
+
+
+def deep_nesting(d):
+    """d levels of nested inline arrays around one integer."""
+    return '[' * d + '1' + ']' * d + '\n'
+
+
+def block_string(m):
+    """A block string of roughly m bytes in 64-character lines."""
+    lines = ['text: `']
+    line = 'the quick brown fox jumps over the lazy dog and keeps running on'
+    total = 0
+    while total < m:
+        lines.append(f'  {line}')
+        total += len(line) + 1
+    return '\n'.join(lines) + '\n'
+
+
+def hex_block(m):
+    """A hex block of m bytes, 16 space-grouped bytes per line."""
+    lines = ['data: >']
+    for offset in range(0, m, 16):
+        pairs = [f'{(offset + i) & 0xff:02x}' for i in range(min(16, m - offset))]
+        grouped = ' '.join(
+            ''.join(pairs[i:i + 2]) for i in range(0, len(pairs), 2)
+        )
+        lines.append(f'  {grouped}')
+    return '\n'.join(lines) + '\n'
+
+
+def float_matrix(shape):
+    """rows x cols floats as a block list of inline arrays."""
+    rows, cols = shape
+    lines = []
+    for r in range(rows):
+        cells = ', '.join(f'{(r * cols + c) * 1.25e-3:.6f}' for c in range(cols))
+        lines.append(f'- [{cells}]')
+    return '\n'.join(lines) + '\n'
+
+
+def generate(scale, out_dir):
+    params = SCALES[scale]
+    out_dir.mkdir(parents=True, exist_ok=True)
+    documents = {
+        f'flat-array-{params["flat_array"]}.yay':
+            flat_array(params['flat_array']),
+        f'wide-object-{params["wide_object"]}.yay':
+            wide_object(params['wide_object']),
+        f'deep-nesting-{params["deep_nesting"]}.yay':
+            deep_nesting(params['deep_nesting']),
+        f'block-string-{params["block_string"]}.yay':
+            block_string(params['block_string']),
+        f'hex-block-{params["hex_block"]}.yay':
+            hex_block(params['hex_block']),
+        'float-matrix-{}x{}.yay'.format(*params['float_matrix']):
+            float_matrix(params['float_matrix']),
+    }
+    for name, content in documents.items():
+        path = out_dir / name
+        path.write_text(content)
+        print(f'wrote {path} ({len(content)} bytes)')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--scale', choices=sorted(SCALES), default='small')
+    parser.add_argument('--out', type=Path, default=None,
+                        help='output directory (default test/scaling or '
+                             'test/scaling-large by scale)')
+    args = parser.parse_args()
+
+    root = Path(__file__).resolve().parent.parent
+    out_dir = args.out
+    if out_dir is None:
+        suffix = '' if args.scale == 'small' else '-large'
+        out_dir = root / 'test' / f'scaling{suffix}'
+    generate(args.scale, out_dir)
+
+
+if __name__ == '__main__':
+    main()
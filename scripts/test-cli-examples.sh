@@ -85,6 +85,20 @@ EOF
   # data.json - JSON input file
   cat >"$TEMP_DIR/data.json" <<'EOF'
 {"a": 1, "b": 2}
+EOF
+
+  # Fragment files for merge examples
+  cat >"$TEMP_DIR/base.yay" <<'EOF'
+name: "example"
+zone: "a"
+EOF
+  cat >"$TEMP_DIR/host.yay" <<'EOF'
+port: 8080
+zone: "b"
+EOF
+  cat >"$TEMP_DIR/unsorted.yay" <<'EOF'
+b: 1
+a: 2
 EOF
 
   # Create a configs directory with some .yay files
@@ -170,6 +184,9 @@ transform_command() {
   # Order matters - replace more specific patterns first
   cmd="${cmd//\.\/configs\//$TEMP_DIR/configs/}"
   cmd="${cmd//config.yay/$TEMP_DIR/config.yay}"
+  cmd="${cmd//base.yay/$TEMP_DIR/base.yay}"
+  cmd="${cmd//host.yay/$TEMP_DIR/host.yay}"
+  cmd="${cmd//unsorted.yay/$TEMP_DIR/unsorted.yay}"
   cmd="${cmd//config.go/$TEMP_DIR/config.go}"
   cmd="${cmd//data.yay/$TEMP_DIR/data.yay}"
   cmd="${cmd//data.yson/$TEMP_DIR/data.yson}"
@@ -184,6 +201,9 @@ transform_command() {
   # Replace 'yay' command with full path (only at word boundaries)
   # Use sed to be more precise - only match 'yay' as a command, not in paths
   cmd=$(echo "$cmd" | sed "s|^yay |$YAY |")
+  # Also match when an environment assignment or a pipe precedes the command
+  cmd=$(echo "$cmd" | sed "s|^\(YAY_WRAP=[0-9]* \)yay |\1$YAY |")
+  cmd=$(echo "$cmd" | sed "s:| yay :| $YAY :")
 
   # Remove output redirections for testing (we capture stdout)
   cmd=$(echo "$cmd" | sed 's/ *> *[^ ]*$//')
@@ -199,7 +219,7 @@ run_example() {
   local line_num="$4"
   local expects_error="$5"
 
-  ((tests_run++))
+  tests_run=$((tests_run + 1))
 
   local cmd
   cmd=$(transform_command "$original_cmd")
@@ -212,7 +232,7 @@ run_example() {
   # For --check commands, we just verify exit code
   if [[ "$original_cmd" =~ --check ]]; then
     if [[ $status -eq 0 ]]; then
-      ((tests_passed++))
+      tests_passed=$((tests_passed + 1))
       echo -e "${GREEN}PASS${NC}: line $line_num: $original_cmd"
       return 0
     else
@@ -230,7 +250,7 @@ run_example() {
       # Command failed as expected, check output if specified
       if [[ "$has_expected" == true ]]; then
         if [[ "$output" == "$expected" ]]; then
-          ((tests_passed++))
+          tests_passed=$((tests_passed + 1))
           echo -e "${GREEN}PASS${NC}: line $line_num: $original_cmd (expected error)"
           return 0
         else
@@ -244,7 +264,7 @@ run_example() {
         fi
       else
         # Just expected to fail, no specific output required
-        ((tests_passed++))
+        tests_passed=$((tests_passed + 1))
         echo -e "${GREEN}PASS${NC}: line $line_num: $original_cmd (expected error)"
         return 0
       fi
@@ -260,7 +280,7 @@ run_example() {
   # For commands with expected output, verify it
   if [[ "$has_expected" == true ]]; then
     if [[ "$output" == "$expected" ]]; then
-      ((tests_passed++))
+      tests_passed=$((tests_passed + 1))
       echo -e "${GREEN}PASS${NC}: line $line_num: $original_cmd"
       return 0
     else
@@ -276,7 +296,7 @@ run_example() {
 
   # For commands without expected output, just verify they succeed
   if [[ $status -eq 0 ]]; then
-    ((tests_passed++))
+    tests_passed=$((tests_passed + 1))
     echo -e "${GREEN}PASS${NC}: line $line_num: $original_cmd"
     return 0
   else
@@ -299,7 +319,7 @@ main() {
   local line_num=0
 
   while IFS= read -r line; do
-    ((line_num++))
+    line_num=$((line_num + 1))
 
     if [[ "$in_code_block" == true ]]; then
       if [[ "$line" == '```' ]]; then
@@ -19,6 +19,16 @@ fi
 
 cd "$DIR"
 
+# With --bench, run the benchmark suite instead of the tests. Profiles
+# come from the standard go test flags via BENCHFLAGS, e.g.
+#   BENCHFLAGS="-cpuprofile cpu.out -memprofile mem.out" test-go.sh --bench
+if [[ "${1:-}" == "--bench" ]]; then
+  echo "Running benchmarks..."
+  # shellcheck disable=SC2086
+  go test -run '^$' -bench . -benchmem ${BENCHFLAGS:-} ./...
+  exit 0
+fi
+
 echo "Running code generation..."
 go generate
 